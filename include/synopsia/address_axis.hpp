@@ -0,0 +1,69 @@
+/// @file address_axis.hpp
+/// @brief Gap-compressed address axis for the minimap (no IDA or Qt dependencies)
+///
+/// Mapped ranges are laid end to end on a continuous axis, and the unmapped
+/// space between two of them shrinks to a marker of bounded size. A binary
+/// with segments at 0x400000 and 0x7FF000000000 thus gets a usable strip for
+/// each instead of two one-pixel slivers. Inside a marker the axis stays
+/// monotone (linear over the real gap), so every offset still maps back to
+/// an address.
+
+#pragma once
+
+#include "minimap_data_interface.hpp"
+
+#include <vector>
+
+namespace synopsia {
+
+/// @class AddressAxis
+/// @brief Piecewise-linear map between addresses and axis offsets
+class AddressAxis {
+public:
+    /// Mapped range and where it starts on the axis
+    struct Span {
+        data_addr_t start;
+        data_addr_t end;
+        data_size_t offset;
+
+        [[nodiscard]] constexpr data_size_t size() const noexcept { return end - start; }
+        [[nodiscard]] constexpr data_size_t offset_end() const noexcept { return offset + size(); }
+    };
+
+    /// Gap markers are at most 1/GAP_MARKER_DIVISOR of the mapped length
+    static constexpr data_size_t GAP_MARKER_DIVISOR = 256;
+
+    /// All markers together are at most 1/GAP_SHARE_DIVISOR of the mapped
+    /// length, however many gaps there are (min_marker included)
+    static constexpr data_size_t GAP_SHARE_DIVISOR = 16;
+
+    /// @brief Lay out ranges (any order; overlapping or touching ones merge)
+    /// @param ranges Mapped ranges
+    /// @param min_marker Preferred lower bound for a gap marker (e.g. one entropy block)
+    void build(std::vector<RegionData> ranges, data_size_t min_marker = 1);
+
+    void clear() noexcept { spans_.clear(); }
+
+    [[nodiscard]] bool empty() const noexcept { return spans_.empty(); }
+    [[nodiscard]] const std::vector<Span>& spans() const noexcept { return spans_; }
+
+    /// Total axis length (mapped bytes plus markers)
+    [[nodiscard]] data_size_t length() const noexcept {
+        return spans_.empty() ? 0 : spans_.back().offset_end();
+    }
+
+    /// First and one-past-last mapped address
+    [[nodiscard]] data_addr_t start_address() const noexcept { return spans_.empty() ? 0 : spans_.front().start; }
+    [[nodiscard]] data_addr_t end_address() const noexcept { return spans_.empty() ? 0 : spans_.back().end; }
+
+    /// Address to axis offset (clamped to [0, length()])
+    [[nodiscard]] data_size_t to_offset(data_addr_t addr) const noexcept;
+
+    /// Axis offset to address (clamped to the mapped range)
+    [[nodiscard]] data_addr_t to_address(data_size_t offset) const noexcept;
+
+private:
+    std::vector<Span> spans_;  // Sorted, disjoint, offsets increasing
+};
+
+} // namespace synopsia
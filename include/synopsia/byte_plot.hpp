@@ -0,0 +1,104 @@
+/// @file byte_plot.hpp
+/// @brief Byte-value heatmap next to the entropy bar (no IDA or Qt dependencies)
+///
+/// Each line of the plot is one span of the address axis and each of its
+/// 256 cells is how often that byte value occurs there: ASCII text, opcode
+/// bytes and zero padding stand out as bands. Lines are aggregated from a
+/// pyramid of per-span histograms. The level is picked so that a pixel line
+/// sums only a few entries, so the cost follows the widget size, not the
+/// database size.
+
+#pragma once
+
+#include "color.hpp"
+#include "minimap_data_interface.hpp"
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace synopsia {
+
+/// Share of each byte value in one address span
+struct ByteHistogram {
+    data_addr_t start_addr = 0;
+    data_addr_t end_addr = 0;
+    std::uint64_t bytes = 0;                  ///< Bytes counted (unreadable ones are not)
+    std::array<std::uint16_t, 256> freq{};    ///< 65535 = every counted byte has this value
+
+    /// @brief Set freq from raw counts
+    void set_counts(const std::array<std::uint64_t, 256>& counts, std::uint64_t total) noexcept;
+};
+
+/// Base-level spans are capped at this count (about 35 MB with the pyramid)
+inline constexpr std::size_t BYTE_HISTOGRAM_MAX_SPANS = 32768;
+
+/// @brief Base span size for a database: power of two, at least min_span
+[[nodiscard]] std::size_t byte_histogram_span(std::uint64_t total_bytes, std::size_t min_span = 4096);
+
+/// @class ByteHistogramPyramid
+/// @brief Per-span histograms with coarser levels made by merging neighbours
+class ByteHistogramPyramid {
+public:
+    /// @brief Take base-level spans (sorted by address) and build the coarser levels
+    void build(std::vector<ByteHistogram> base, std::size_t span_size);
+
+    void clear() noexcept;
+
+    [[nodiscard]] bool empty() const noexcept { return levels_.empty() || levels_.front().empty(); }
+    [[nodiscard]] std::size_t span_size() const noexcept { return span_size_; }
+    [[nodiscard]] std::size_t level_count() const noexcept { return levels_.size(); }
+    [[nodiscard]] std::span<const ByteHistogram> level(std::size_t index) const { return levels_[index]; }
+
+    /// @brief Coarsest level whose spans are at most `bytes` long (level 0 if none is)
+    [[nodiscard]] std::size_t level_for(data_size_t bytes) const noexcept;
+
+    /// @brief Covered address range
+    [[nodiscard]] data_addr_t start_addr() const noexcept;
+    [[nodiscard]] data_addr_t end_addr() const noexcept;
+
+private:
+    std::vector<std::vector<ByteHistogram>> levels_;
+    std::size_t span_size_ = 0;
+};
+
+/// @class BytePlot
+/// @brief Rasterizes a pyramid into pixels; keeps the last lines for tooltips
+///
+/// Colors come from a log-scaled lookup table over the entropy gradient, so
+/// rare byte values stay visible next to dominant ones.
+class BytePlot {
+public:
+    explicit BytePlot(const ColorGradient& gradient);
+
+    void set_gradient(const ColorGradient& gradient);
+
+    /// @brief Paint the source's viewport into a pixel rectangle
+    ///
+    /// With vertical set, addresses run down the rows and byte values across
+    /// the columns; otherwise addresses run across and byte values down.
+    /// Narrow rectangles keep the largest share among the byte values that
+    /// fall into one pixel.
+    /// @param pixels 0xAARRGGBB pixels (QImage::Format_RGB32 layout)
+    /// @param stride Pixels per row
+    void rasterize(const IMinimapDataSource& source, const ByteHistogramPyramid& pyramid, bool vertical,
+                   int width, int height, std::uint32_t* pixels, std::size_t stride);
+
+    /// @brief Share of a byte value in a plotted line (0-1), or -1 if none
+    /// @param line Row (vertical) or column index from the last rasterize()
+    [[nodiscard]] double share_at(int line, int byte_value) const noexcept;
+
+private:
+    [[nodiscard]] std::uint32_t color(float share) const noexcept {
+        return lut_[static_cast<std::size_t>(share * static_cast<float>(LUT_SIZE - 1) + 0.5f)];
+    }
+
+    static constexpr std::size_t LUT_SIZE = 4096;
+    std::array<std::uint32_t, LUT_SIZE> lut_{};
+
+    std::vector<float> lines_;    // 256 shares per line
+    std::vector<float> weights_;  // Bytes summed into each line
+    int line_count_ = 0;
+};
+
+} // namespace synopsia
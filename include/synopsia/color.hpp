@@ -147,6 +147,9 @@ inline constexpr Color RegionBorder{0, 0, 0, 255};             ///< Black segmen
 inline constexpr Color RegionText{220, 220, 220, 255};         ///< Segment name text color (brighter)
 inline constexpr Color RegionTextBg{0, 0, 0, 180};             ///< Semi-transparent background for segment text
 inline constexpr Color HoverHighlight{255, 255, 255, 64};
+inline constexpr Color SelectionFill{96, 160, 255, 72};         ///< Minimap range selection
+inline constexpr Color SelectionEdge{96, 160, 255, 220};        ///< Selection boundary lines
+inline constexpr Color GapMarker{56, 56, 72};                   ///< Collapsed unmapped address space
 
 } // namespace colors
 
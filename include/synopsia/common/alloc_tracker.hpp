@@ -0,0 +1,130 @@
+/// @file alloc_tracker.hpp
+/// @brief Heap allocation counters per feature and phase (no IDA or Qt dependencies)
+///
+/// Counting needs the global operator new replacements in alloc_hooks.cpp.
+/// The standalone viewer always links them. The plugin links them only in a
+/// diagnostics build (-DSYNOPSIA_ALLOCATION_TRACKING=ON), because a plugin
+/// cannot own the allocator of the process it is loaded into. Without the
+/// hooks every counter stays at zero and enabled() is false.
+///
+/// Attribution is thread-local. An AllocationScope charges the allocations
+/// its thread makes to one AllocationSite until it is destroyed. Nested
+/// scopes charge only the innermost site, so a frame site does not also
+/// count the refresh it triggered. Pool workers are not attributed.
+///
+/// @code
+///     static AllocationSite site("function_search", "refresh");
+///     AllocationScope scope(site);
+///     ...
+///     scope.set_items(function_count);  // Enables the per-1k-items figure
+/// @endcode
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace synopsia {
+
+/// @class AllocationCounter
+/// @brief Process-wide heap allocation totals, fed by the operator new hooks
+class AllocationCounter {
+public:
+    /// @brief Record one allocation (called from the hooks; must not allocate)
+    static void note(std::size_t bytes) noexcept;
+
+    [[nodiscard]] static std::uint64_t count() noexcept { return count_.load(std::memory_order_relaxed); }
+    [[nodiscard]] static std::uint64_t bytes() noexcept { return bytes_.load(std::memory_order_relaxed); }
+
+    /// @brief Called once by the hooks; tells panels the numbers are real
+    static void enable() noexcept { enabled_ = true; }
+    [[nodiscard]] static bool enabled() noexcept { return enabled_; }
+
+private:
+    static inline std::atomic<std::uint64_t> count_{0};
+    static inline std::atomic<std::uint64_t> bytes_{0};
+    static inline bool enabled_ = false;
+};
+
+/// @class AllocationSite
+/// @brief One feature/phase pair whose passes are counted
+///
+/// Sites register themselves on construction and unregister on destruction.
+/// Declare them as function-local statics, or as members of the object whose
+/// passes they count.
+class AllocationSite {
+public:
+    /// Totals so far, plus the most recent pass
+    struct Stats {
+        std::string feature;
+        std::string phase;
+        std::uint64_t passes = 0;
+        std::uint64_t allocations = 0;       ///< Summed over all passes
+        std::uint64_t bytes = 0;
+        std::uint64_t last_allocations = 0;  ///< Most recent pass
+        std::uint64_t last_bytes = 0;
+        std::uint64_t last_items = 0;        ///< Items the last pass processed (0 = not reported)
+        std::uint64_t max_allocations = 0;   ///< Worst single pass
+    };
+
+    AllocationSite(std::string feature, std::string phase);
+    ~AllocationSite();
+    AllocationSite(const AllocationSite&) = delete;
+    AllocationSite& operator=(const AllocationSite&) = delete;
+
+    [[nodiscard]] Stats stats() const;
+
+    /// @brief Zero the counters (the site stays registered)
+    void reset() noexcept;
+
+    /// @brief Every registered site, in registration order
+    [[nodiscard]] static std::vector<Stats> snapshot();
+
+    /// @brief Zero the counters of every registered site
+    static void reset_all();
+
+private:
+    friend class AllocationScope;
+    void record(std::uint64_t allocations, std::uint64_t bytes, std::uint64_t items) noexcept;
+
+    const std::string feature_;
+    const std::string phase_;
+    std::atomic<std::uint64_t> passes_{0};
+    std::atomic<std::uint64_t> allocations_{0};
+    std::atomic<std::uint64_t> bytes_{0};
+    std::atomic<std::uint64_t> last_allocations_{0};
+    std::atomic<std::uint64_t> last_bytes_{0};
+    std::atomic<std::uint64_t> last_items_{0};
+    std::atomic<std::uint64_t> max_allocations_{0};
+};
+
+/// @class AllocationScope
+/// @brief Charges this thread's allocations to a site for one pass
+class AllocationScope {
+public:
+    explicit AllocationScope(AllocationSite& site) noexcept;
+    ~AllocationScope();
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    /// @brief Items this pass processed (functions, blocks, ...)
+    void set_items(std::uint64_t items) noexcept { items_ = items; }
+
+    /// @brief Allocations charged to this scope so far (nested scopes excluded)
+    [[nodiscard]] std::uint64_t allocations() const noexcept;
+    [[nodiscard]] std::uint64_t bytes() const noexcept;
+
+private:
+    AllocationSite& site_;
+    AllocationScope* parent_;
+    std::uint64_t start_allocations_;
+    std::uint64_t start_bytes_;
+    std::uint64_t nested_allocations_ = 0;
+    std::uint64_t nested_bytes_ = 0;
+    std::uint64_t items_ = 0;
+};
+
+} // namespace synopsia
@@ -0,0 +1,133 @@
+/// @file call_graph.hpp
+/// @brief Compressed sparse row (CSR) call graph (no IDA dependencies)
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace synopsia {
+
+/// Node index into a CallGraph (position of the function in its node list)
+using graph_index_t = std::uint32_t;
+inline constexpr graph_index_t GRAPH_NO_NODE = static_cast<graph_index_t>(-1);
+inline constexpr std::uint32_t GRAPH_UNREACHED = static_cast<std::uint32_t>(-1);
+
+/// Traversal direction for graph queries
+enum class GraphDirection : std::uint8_t {
+    Callees = 0,  ///< Follow caller -> callee edges
+    Callers = 1,  ///< Follow callee -> caller edges
+};
+
+/// @struct CsrAdjacency
+/// @brief One direction of a CSR adjacency list
+///
+/// Neighbors of node i are targets[offsets[i] .. offsets[i + 1]).
+/// Both arrays are flat and contiguous so they can be handed out as
+/// read-only buffers without copying. They point into the owning
+/// CallGraph, or into memory it borrows (e.g. a mapped snapshot).
+struct CsrAdjacency {
+    std::span<const std::uint32_t> offsets;   // node_count + 1 entries
+    std::span<const graph_index_t> targets;   // edge_count entries
+
+    [[nodiscard]] std::size_t node_count() const noexcept {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    [[nodiscard]] std::span<const graph_index_t> neighbors(graph_index_t node) const noexcept {
+        if (node >= node_count()) return {};
+        return {targets.data() + offsets[node], offsets[node + 1] - offsets[node]};
+    }
+};
+
+/// @class CallGraph
+/// @brief Immutable call graph stored as forward and reverse CSR arrays
+///
+/// Built once from a deduplicated edge list; all queries are read-only and
+/// safe to run concurrently from worker threads.
+class CallGraph {
+public:
+    CallGraph() = default;
+    CallGraph(const CallGraph& other) { *this = other; }
+    CallGraph& operator=(const CallGraph& other);
+    CallGraph(CallGraph&&) noexcept = default;  // Moved vectors keep their buffers, so the spans stay valid
+    CallGraph& operator=(CallGraph&&) noexcept = default;
+
+    /// @brief Build from an edge list of (caller, callee) node indices
+    /// @param node_count Number of nodes
+    /// @param edges Edges; duplicates and out-of-range indices are dropped
+    void build(std::size_t node_count, std::span<const std::pair<graph_index_t, graph_index_t>> edges);
+
+    /// @brief Serve CSR arrays that live elsewhere instead of copying them
+    ///
+    /// The arrays must already be sorted and deduplicated per node, as
+    /// build() leaves them. Without caller arrays the caller direction is
+    /// built from the callees (the only heap copy).
+    /// @param owner Keeps the arrays alive for as long as this graph (or a copy) exists
+    void borrow(std::span<const std::uint32_t> callee_offsets, std::span<const graph_index_t> callee_targets,
+                std::span<const std::uint32_t> caller_offsets, std::span<const graph_index_t> caller_targets,
+                std::shared_ptr<const void> owner);
+
+    /// Release all storage
+    void clear();
+
+    [[nodiscard]] std::size_t node_count() const noexcept { return callees_.node_count(); }
+    [[nodiscard]] std::size_t edge_count() const noexcept { return callees_.targets.size(); }
+    [[nodiscard]] bool empty() const noexcept { return node_count() == 0; }
+
+    /// Adjacency in the requested direction
+    [[nodiscard]] const CsrAdjacency& adjacency(GraphDirection dir) const noexcept {
+        return dir == GraphDirection::Callees ? callees_ : callers_;
+    }
+
+    [[nodiscard]] std::span<const graph_index_t> callees(graph_index_t node) const noexcept {
+        return callees_.neighbors(node);
+    }
+
+    [[nodiscard]] std::span<const graph_index_t> callers(graph_index_t node) const noexcept {
+        return callers_.neighbors(node);
+    }
+
+    /// @brief Multi-source BFS
+    /// @param sources Start nodes (depth 0)
+    /// @param dir Edge direction to follow
+    /// @param max_depth Stop expanding past this depth
+    /// @param depths Output, resized to node_count(); GRAPH_UNREACHED for unvisited nodes
+    /// @return Number of nodes reached
+    std::size_t bfs(std::span<const graph_index_t> sources,
+                    GraphDirection dir,
+                    std::uint32_t max_depth,
+                    std::vector<std::uint32_t>& depths) const;
+
+    /// @brief Shortest (fewest hops) path following callee edges
+    /// @param from Start node
+    /// @param to Destination node
+    /// @param path Output node sequence including both endpoints; empty if unreachable
+    /// @return true if a path exists
+    bool shortest_path(graph_index_t from, graph_index_t to, std::vector<graph_index_t>& path) const;
+
+private:
+    /// Arrays behind one direction when the graph owns them
+    struct Storage {
+        std::vector<std::uint32_t> offsets;
+        std::vector<graph_index_t> targets;
+    };
+
+    /// Point a direction's spans at its own storage
+    static void attach(CsrAdjacency& csr, const Storage& storage) noexcept {
+        csr.offsets = storage.offsets;
+        csr.targets = storage.targets;
+    }
+
+    CsrAdjacency callees_;
+    CsrAdjacency callers_;
+    Storage callee_storage_;
+    Storage caller_storage_;
+    std::shared_ptr<const void> owner_;  // Set while the spans are borrowed
+};
+
+} // namespace synopsia
@@ -0,0 +1,107 @@
+/// @file frame_arena.hpp
+/// @brief Per-frame bump arena for render-path temporaries (no IDA or Qt dependencies)
+///
+/// ImGui hosts call FrameArena::instance().begin_frame() right before
+/// ImGui::NewFrame(). Everything handed out since the previous call is
+/// released at once. Render code takes sort buffers, lowercase copies and
+/// NUL-terminated labels from the arena instead of the heap. When a frame
+/// overflows the first block, the next frame starts with one block big
+/// enough for all of it, so steady-state frames make no heap allocations.
+
+#pragma once
+
+#include "alloc_tracker.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace synopsia {
+
+/// @class FrameArena
+/// @brief Bump allocator reset once per frame (UI thread only)
+class FrameArena {
+public:
+    static constexpr std::size_t INITIAL_BLOCK_SIZE = 64 * 1024;
+
+    /// What the previous frame used
+    struct FrameStats {
+        std::size_t bytes = 0;             ///< Bytes handed out
+        std::size_t blocks = 0;            ///< Blocks in use (1 once steady)
+        std::size_t block_allocations = 0; ///< Blocks the arena had to allocate
+        std::uint64_t heap_allocations = 0;///< All heap allocations (AllocationCounter)
+    };
+
+    /// Arena shared by every ImGui host in the process
+    [[nodiscard]] static FrameArena& instance();
+
+    FrameArena() = default;
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /// @brief Release the previous frame's memory and record its stats
+    void begin_frame();
+
+    /// @brief Uninitialized storage valid until the next begin_frame()
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment);
+
+    template <typename T>
+    [[nodiscard]] T* allocate_array(std::size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /// @brief NUL-terminated copy (for ImGui labels)
+    [[nodiscard]] std::string_view copy(std::string_view text);
+
+    /// @brief NUL-terminated ASCII-lowercase copy
+    [[nodiscard]] std::string_view lowercase(std::string_view text);
+
+    [[nodiscard]] const FrameStats& last_frame() const noexcept { return last_frame_; }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+    };
+
+    void add_block(std::size_t min_size);
+
+    std::vector<Block> blocks_;
+    std::size_t current_ = 0;   // Block being bumped
+    std::size_t offset_ = 0;    // Bump offset within it
+    std::size_t bytes_ = 0;     // Handed out this frame
+    std::size_t block_allocations_ = 0;
+    std::uint64_t heap_mark_ = 0;
+    FrameStats last_frame_;
+};
+
+/// @brief std::allocator over the frame arena; deallocation is a no-op
+template <typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    FrameAllocator() noexcept : arena_(&FrameArena::instance()) {}
+    explicit FrameAllocator(FrameArena& arena) noexcept : arena_(&arena) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) { return arena_->allocate_array<T>(n); }
+    void deallocate(T*, std::size_t) noexcept {}
+
+    [[nodiscard]] FrameArena* arena() const noexcept { return arena_; }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept { return arena_ == other.arena(); }
+
+private:
+    FrameArena* arena_;
+};
+
+/// Vector whose storage lives until the end of the frame
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace synopsia
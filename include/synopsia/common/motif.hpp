@@ -0,0 +1,186 @@
+/// @file motif.hpp
+/// @brief Call-graph motif queries: pattern language, match plan and search (no IDA dependencies)
+///
+/// A motif is a small graph of function variables joined by call edges,
+/// written as comma-separated paths:
+///
+///     (f) -[2]-> (name~socket), (f) -[2]-> (name~createprocess)
+///     (d out>=50 callees:leaf)
+///     (a) -> (b) -> (a), (b) -> (name=closehandle import)
+///
+/// Nodes are `(var terms...)`. The variable is optional, and a name used
+/// twice denotes the same function. Distinct variables always bind distinct
+/// functions. Terms:
+///
+///     name~text  name=text   Case-insensitive substring / exact name
+///     leaf root import lib   Flags; prefix with ! to negate
+///     out>=n in<n ...        Callee / caller count (>= <= > < =)
+///     callees:flag           Every callee has the flag (e.g. callees:leaf)
+///
+/// Edges follow calls: `a -> b` (a calls b), `a <- b` (b calls a),
+/// `a -[n]-> b` (b within n calls of a), `a -[m..n]-> b` (between m and n).
+/// An edge from a variable to itself is rejected: the call graph has no
+/// self-calls, so direct recursion cannot be matched.
+
+#pragma once
+
+#include <synopsia/common/call_graph.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace synopsia {
+
+/// Per-node flags; callers supply import/library, leaf/root come from the graph
+enum MotifFlag : std::uint8_t {
+    MOTIF_IMPORT = 1 << 0,   ///< Import thunk or external symbol
+    MOTIF_LIBRARY = 1 << 1,  ///< Recognized library function
+    MOTIF_LEAF = 1 << 6,     ///< Calls nothing
+    MOTIF_ROOT = 1 << 7,     ///< Called by nothing
+};
+
+/// @struct MotifLabels
+/// @brief Names and flags of a CallGraph's nodes, indexed like it
+struct MotifLabels {
+    std::vector<std::string> names;   // Lowercase
+    std::vector<std::uint8_t> flags;  // MotifFlag bits
+};
+
+/// @class MotifQuery
+/// @brief A parsed motif compiled into a matching plan
+///
+/// The plan binds the most selective variable first (names before flags
+/// before degrees), then walks the motif's edges outward so each further
+/// variable is enumerated from the neighbors of one already bound. Every
+/// other edge that touches it is checked as soon as both ends are bound.
+class MotifQuery {
+public:
+    /// @brief Parse and plan a motif
+    /// @param error Receives the reason on failure
+    bool compile(std::string_view text, std::string& error);
+
+    [[nodiscard]] std::size_t variable_count() const noexcept { return variables_.size(); }
+
+    /// Variable name as written, or "_<n>" for anonymous nodes
+    [[nodiscard]] const std::string& variable_name(std::size_t i) const { return variables_[i].name; }
+
+    /// Plan as one line per step, for display
+    [[nodiscard]] std::string describe() const;
+
+private:
+    friend class MotifSearch;
+
+    struct Variable {
+        std::string name;
+        std::string name_text;  // Lowercase
+        bool name_exact = false;
+        std::uint8_t required = 0;  // MotifFlag bits
+        std::uint8_t forbidden = 0;
+        std::uint8_t callees_required = 0;
+        std::uint32_t min_out = 0;
+        std::uint32_t max_out = UINT32_MAX;
+        std::uint32_t min_in = 0;
+        std::uint32_t max_in = UINT32_MAX;
+    };
+
+    struct Edge {
+        std::uint32_t from;
+        std::uint32_t to;
+        std::uint32_t min_hops;
+        std::uint32_t max_hops;
+    };
+
+    /// Bind plan[k].variable from the neighbors of an already bound anchor
+    struct Step {
+        std::uint32_t variable;
+        std::uint32_t anchor;       // Unused for the first step
+        GraphDirection direction;   // From the anchor towards the variable
+        std::uint32_t min_hops;
+        std::uint32_t max_hops;
+        std::vector<Edge> checks;   // Other edges closed by this step
+    };
+
+    bool plan(std::string& error);
+    [[nodiscard]] int selectivity(const Variable& variable) const;
+
+    std::vector<Variable> variables_;
+    std::vector<Edge> edges_;
+    std::vector<Step> steps_;
+};
+
+/// @class MotifSearch
+/// @brief Runs a MotifQuery on a background thread, streaming matches
+///
+/// Candidate roots are filtered by label and degree, then expanded in
+/// parallel. A new submit() cancels the search in flight.
+class MotifSearch {
+public:
+    MotifSearch() = default;
+    ~MotifSearch();
+
+    // Non-copyable
+    MotifSearch(const MotifSearch&) = delete;
+    MotifSearch& operator=(const MotifSearch&) = delete;
+
+    /// @brief Start a search; cancels the previous one
+    /// @param max_matches Stop after this many matches
+    void submit(std::shared_ptr<const CallGraph> graph, std::shared_ptr<const MotifLabels> labels,
+                std::shared_ptr<const MotifQuery> query, std::size_t max_matches);
+
+    /// Stop the current search and drop its matches
+    void cancel();
+
+    /// @brief Append matches found since the last call
+    /// @param out Node indices, variable_count() per match in variable order
+    /// @return true if any were appended
+    bool poll(std::vector<graph_index_t>& out);
+
+    /// Whether the current search is still running
+    [[nodiscard]] bool is_searching() const;
+
+    /// Fraction of candidate roots expanded [0, 1]
+    [[nodiscard]] float progress() const;
+
+    /// Whether the current search stopped at max_matches
+    [[nodiscard]] bool truncated() const;
+
+private:
+    struct Job {
+        std::shared_ptr<const CallGraph> graph;
+        std::shared_ptr<const MotifLabels> labels;
+        std::shared_ptr<const MotifQuery> query;
+        std::size_t max_matches = 0;
+        std::uint64_t generation = 0;
+    };
+
+    class Matcher;
+
+    void worker_loop();
+    void run(const Job& job);
+
+    /// Hand a worker's matches to poll(); false once the search is cancelled or full
+    bool publish(const Job& job, std::vector<graph_index_t>& matches);
+
+    mutable std::mutex mutex_;  // Guards everything below except the atomics
+    std::condition_variable wake_;
+    std::thread worker_;
+    bool stopping_ = false;
+    std::unique_ptr<Job> queued_;
+    std::vector<graph_index_t> pending_;  // Matches not polled yet
+    std::size_t match_count_ = 0;
+    bool running_ = false;
+    bool truncated_ = false;
+
+    std::atomic<std::uint64_t> generation_{0};  // Bumped per submit/cancel; workers poll it
+    std::atomic<std::size_t> roots_total_{0};
+    std::atomic<std::size_t> roots_done_{0};
+};
+
+} // namespace synopsia
@@ -0,0 +1,72 @@
+/// @file parallel.hpp
+/// @brief Minimal data-parallel helpers (no IDA dependencies)
+///
+/// IDA APIs are main-thread only. Callers must read everything they need from
+/// the database first and only hand plain buffers to these helpers.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace synopsia {
+
+/// Number of worker threads to use (at least 1)
+[[nodiscard]] inline std::size_t worker_count() noexcept {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<std::size_t>(hw);
+}
+
+/// @brief Run fn(begin, end) over [0, count) split into chunks of `grain`
+///
+/// Chunks are handed out dynamically so uneven work still balances.
+/// Blocks until all chunks complete. Runs inline when there is only
+/// one chunk or one worker.
+template <typename Fn>
+void parallel_for_range(std::size_t count, std::size_t grain, Fn&& fn) {
+    if (count == 0) return;
+    grain = std::max<std::size_t>(grain, 1);
+
+    const std::size_t chunks = (count + grain - 1) / grain;
+    const std::size_t threads = std::min(worker_count(), chunks);
+
+    if (threads <= 1) {
+        fn(std::size_t{0}, count);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (;;) {
+            const std::size_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunks) break;
+            const std::size_t begin = chunk * grain;
+            fn(begin, std::min(begin + grain, count));
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
+/// @brief Run fn(i) for every i in [0, count)
+template <typename Fn>
+void parallel_for(std::size_t count, std::size_t grain, Fn&& fn) {
+    parallel_for_range(count, grain, [&fn](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            fn(i);
+        }
+    });
+}
+
+} // namespace synopsia
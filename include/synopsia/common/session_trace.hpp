@@ -0,0 +1,176 @@
+/// @file session_trace.hpp
+/// @brief Compact session trace file: recorded events for offline replay (no IDA dependencies)
+///
+/// Layout (little-endian):
+///
+///   SessionTraceHeader                  24 bytes at offset 0 (16 in version 1)
+///   event records                       until end of file
+///
+/// Each record is a kind byte, a field mask byte, the time since the previous
+/// record and the kind-specific code as LEB128, then only the fields named in
+/// the mask (addresses as zigzag deltas against the previous address). Widget
+/// names are declared once by a Widget record and referred to by id after
+/// that. Records are appended as they happen, so a trace cut short by a crash
+/// or a hang still reads up to the last flushed record.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace synopsia {
+
+inline constexpr std::uint64_t SESSION_TRACE_MAGIC = 0x31434152544E5953ULL;  // 'SYNTRAC1'
+inline constexpr std::uint16_t SESSION_TRACE_VERSION = 2;
+
+/// File extension appended to the IDB path
+inline constexpr const char* SESSION_TRACE_EXTENSION = ".syntrace";
+
+/// Record kinds. Values are part of the file format.
+enum class TraceEventKind : std::uint8_t {
+    Widget = 1,    ///< Declares widget id `code` as `text`
+    Cursor = 2,    ///< Cursor moved to `address`
+    Change = 3,    ///< Database change (TraceChange) at `address`; `text` = new name
+    Input = 4,     ///< UI input (TraceInput) to `widget`
+    Frame = 5,     ///< Widget frame that consumed input; `value` = live render time (us)
+    Response = 6,  ///< Data-source answer (TraceSource); `address` = parameter, `value` = result
+};
+
+/// Database change categories (what the plugin invalidates for them)
+enum class TraceChange : std::uint16_t {
+    Renamed = 1,           ///< Function renamed
+    FunctionsChanged = 2,  ///< Function added, removed or resized
+    BytesChanged = 3,      ///< Bytes patched (`value` = run length) or segments changed
+};
+
+/// UI input events, as fed to ImGui
+enum class TraceInput : std::uint16_t {
+    MousePos = 1,     ///< `x`, `y` in logical pixels
+    MouseButton = 2,  ///< `value` = button | (down << 8)
+    Wheel = 3,        ///< `y` = wheel steps
+    Key = 4,          ///< `value` = ImGuiKey | (down << 16)
+    Char = 5,         ///< `value` = code point
+    Focus = 6,        ///< `value` = focused
+    Resize = 7,       ///< `x`, `y` = widget size in logical pixels; `value` = laid out vertically (minimap)
+};
+
+/// Data sources whose answers are recorded for replay checks
+enum class TraceSource : std::uint16_t {
+    FunctionCount = 1,  ///< Functions loaded by the function browser
+    EntropyBlocks = 2,  ///< Entropy blocks loaded by the minimap; `address` = block size
+};
+
+/// SessionTraceHeader::flags
+inline constexpr std::uint32_t TRACE_FLAG_MINIMAP_VERTICAL = 1u << 0;
+
+#pragma pack(push, 1)
+struct SessionTraceHeader {
+    std::uint64_t magic;
+    std::uint16_t version;
+    std::uint16_t header_size;
+    std::uint32_t flags;
+    float minimap_width;   ///< Minimap size when recording started (0 if never shown)
+    float minimap_height;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SessionTraceHeader) == 24);
+
+/// Minimap geometry; its mouse input only means something relative to it
+struct TraceMinimapLayout {
+    float width = 0.0f;
+    float height = 0.0f;
+    bool vertical = true;
+};
+
+/// One recorded event
+struct TraceEvent {
+    std::uint64_t time_us = 0;  ///< Since recording started
+    TraceEventKind kind = TraceEventKind::Cursor;
+    std::uint16_t code = 0;     ///< TraceChange / TraceInput / TraceSource / widget id
+    std::uint32_t widget = 0;   ///< Widget id for Input and Frame records
+    std::uint64_t address = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+    std::int64_t value = 0;
+    std::string text;
+};
+
+/// @class SessionTraceWriter
+/// @brief Appends events to a trace file
+///
+/// Records are encoded into a small buffer and written out when it fills,
+/// on flush() and on close().
+class SessionTraceWriter {
+public:
+    SessionTraceWriter() = default;
+    ~SessionTraceWriter() { close(); }
+
+    // Non-copyable
+    SessionTraceWriter(const SessionTraceWriter&) = delete;
+    SessionTraceWriter& operator=(const SessionTraceWriter&) = delete;
+
+    /// @brief Create (truncate) a trace file and write its header
+    /// @param minimap Minimap geometry at the start of the recording
+    bool open(const std::string& path, const TraceMinimapLayout& minimap, std::string* error = nullptr);
+
+    /// @brief Flush and close; further writes are ignored
+    void close();
+
+    [[nodiscard]] bool is_open() const noexcept { return file_ != nullptr; }
+
+    /// @brief Id for a widget name, declaring it on first use
+    /// @param time_us Timestamp for the declaration record
+    std::uint32_t widget_id(std::string_view name, std::uint64_t time_us);
+
+    /// @brief Append an event (timestamps must not decrease)
+    void write(const TraceEvent& event);
+
+    /// @brief Write buffered records to the file
+    void flush();
+
+    /// Records written so far
+    [[nodiscard]] std::size_t event_count() const noexcept { return event_count_; }
+
+private:
+    std::FILE* file_ = nullptr;
+    std::vector<std::uint8_t> buffer_;
+    std::unordered_map<std::string, std::uint32_t> widgets_;
+    std::uint64_t last_time_ = 0;
+    std::uint64_t last_address_ = 0;
+    std::size_t event_count_ = 0;
+};
+
+/// @class SessionTrace
+/// @brief Trace file loaded into memory
+class SessionTrace {
+public:
+    /// @brief Read a whole trace; a truncated last record is dropped
+    bool load(const std::string& path, std::string* error = nullptr);
+
+    [[nodiscard]] const std::vector<TraceEvent>& events() const noexcept { return events_; }
+
+    /// File format version the trace was written with
+    [[nodiscard]] std::uint16_t version() const noexcept { return version_; }
+
+    /// Minimap geometry when recording started (version 1 traces: unknown, zero size)
+    [[nodiscard]] const TraceMinimapLayout& minimap() const noexcept { return minimap_; }
+
+    /// Name of a declared widget (empty if unknown)
+    [[nodiscard]] std::string_view widget_name(std::uint32_t id) const noexcept {
+        return id < widgets_.size() ? std::string_view(widgets_[id]) : std::string_view();
+    }
+
+private:
+    std::vector<TraceEvent> events_;
+    std::vector<std::string> widgets_;
+    TraceMinimapLayout minimap_;
+    std::uint16_t version_ = 0;
+};
+
+} // namespace synopsia
@@ -0,0 +1,290 @@
+/// @file snapshot_file.hpp
+/// @brief Sectioned, mmap-able analysis snapshot file (no IDA dependencies)
+///
+/// Layout (little-endian):
+///
+///   SnapshotHeader                      80 bytes at offset 0
+///   section payloads                    each aligned to SNAPSHOT_ALIGNMENT
+///   SnapshotTocEntry[section_count]     at header.toc_offset
+///
+/// Sections are columns: one array of fixed-size items per section, so a
+/// reader maps the file once and hands out typed spans straight into the
+/// mapping. Compressed sections are decoded on first access and cached.
+/// Every section carries a checksum of its stored bytes, verified the first
+/// time the section is touched; the TOC has its own checksum, verified on
+/// open. Nothing is read that the caller does not ask for.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace synopsia {
+
+inline constexpr std::uint64_t SNAPSHOT_MAGIC = 0x3150414E534E5953ULL;  // 'SYNSNAP1'
+inline constexpr std::uint16_t SNAPSHOT_VERSION = 2;
+inline constexpr std::size_t SNAPSHOT_ALIGNMENT = 64;
+
+/// File extension appended to the IDB path
+inline constexpr const char* SNAPSHOT_EXTENSION = ".synsnap";
+
+/// Section identifiers. Values are part of the file format.
+enum class SnapshotSection : std::uint32_t {
+    Metadata = 1,             ///< char: "key=value\0" pairs
+
+    // Function catalog (one entry per function, same order everywhere)
+    FunctionAddress = 16,     ///< u64
+    FunctionEnd = 17,         ///< u64
+    FunctionSize = 18,        ///< u32
+    FunctionDepth = 19,       ///< u32
+    FunctionCallers = 20,     ///< u32
+    FunctionCallees = 21,     ///< u32
+    FunctionComplexity = 22,  ///< f32
+    LayoutX = 23,             ///< f32
+    LayoutY = 24,             ///< f32
+    LayoutZ = 25,             ///< f32
+
+    // String tables (offsets has count + 1 entries into data)
+    NameOffsets = 32,         ///< u32
+    NameData = 33,            ///< char
+    DemangledOffsets = 34,    ///< u32
+    DemangledData = 35,       ///< char
+
+    // Call graph (CSR per direction; the caller direction is optional)
+    CalleeOffsets = 48,       ///< u32
+    CalleeTargets = 49,       ///< u32
+    CallerOffsets = 50,       ///< u32
+    CallerTargets = 51,       ///< u32
+
+    // Entropy pyramid; level k uses EntropyStart0 + k * ENTROPY_STRIDE etc.
+    EntropyStart0 = 64,       ///< u64 block start
+    EntropyEnd0 = 65,         ///< u64 block end
+    EntropyValue0 = 66,       ///< f64 block score
+};
+
+/// Distance between consecutive entropy levels in the section id space
+inline constexpr std::uint32_t SNAPSHOT_ENTROPY_STRIDE = 4;
+
+/// @brief Section id of an entropy column at a pyramid level
+[[nodiscard]] constexpr SnapshotSection snapshot_entropy_section(SnapshotSection column, std::size_t level) noexcept {
+    return static_cast<SnapshotSection>(static_cast<std::uint32_t>(column) +
+                                        static_cast<std::uint32_t>(level) * SNAPSHOT_ENTROPY_STRIDE);
+}
+
+/// Per-section encoding
+enum class SnapshotCodec : std::uint16_t {
+    None = 0,         ///< Stored as-is; served directly from the mapping
+    DeltaVarint = 1,  ///< Unsigned integer column, zigzag deltas as LEB128
+};
+
+#pragma pack(push, 1)
+struct SnapshotHeader {
+    std::uint64_t magic;
+    std::uint16_t version;
+    std::uint16_t header_size;
+    std::uint16_t toc_entry_size;
+    std::uint16_t flags;
+    std::uint32_t section_count;
+    std::uint32_t reserved;
+    std::uint64_t toc_offset;
+    std::uint64_t file_size;
+    std::uint64_t function_signature;  ///< Database state the function sections were built from
+    std::uint64_t bytes_signature;     ///< Database state the entropy sections were built from
+    std::uint64_t name_stamp;          ///< Function-name revision the name tables were built from
+    std::uint64_t bytes_stamp;         ///< Byte-patch revision the entropy sections were built from
+    std::uint64_t toc_checksum;
+};
+
+struct SnapshotTocEntry {
+    std::uint32_t id;
+    std::uint16_t codec;
+    std::uint16_t item_size;
+    std::uint64_t offset;
+    std::uint64_t stored_size;
+    std::uint64_t raw_size;
+    std::uint64_t checksum;   ///< Over the stored bytes
+    std::uint64_t reserved;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SnapshotHeader) == 80);
+static_assert(sizeof(SnapshotTocEntry) == 48);
+
+/// @brief 64-bit checksum used for sections and the TOC
+[[nodiscard]] std::uint64_t snapshot_checksum(const void* data, std::size_t size) noexcept;
+
+/// @struct SnapshotStrings
+/// @brief View over a string table section pair
+struct SnapshotStrings {
+    std::span<const std::uint32_t> offsets;
+    std::span<const char> data;
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    [[nodiscard]] std::string_view operator[](std::size_t i) const noexcept {
+        return {data.data() + offsets[i], offsets[i + 1] - offsets[i]};
+    }
+};
+
+/// @class SnapshotWriter
+/// @brief Collects columns in memory and writes them as one snapshot file
+class SnapshotWriter {
+public:
+    /// @brief Record the database signatures the sections depend on
+    void set_signatures(std::uint64_t functions, std::uint64_t bytes) noexcept {
+        function_signature_ = functions;
+        bytes_signature_ = bytes;
+    }
+
+    /// @brief Record the content revisions (names, byte patches) the sections depend on
+    void set_stamps(std::uint64_t names, std::uint64_t bytes) noexcept {
+        name_stamp_ = names;
+        bytes_stamp_ = bytes;
+    }
+
+    /// @brief Add a metadata key/value pair
+    void add_metadata(std::string_view key, std::string_view value);
+
+    /// @brief Add a column of trivially copyable items
+    ///
+    /// Unsigned integer columns are delta/varint encoded when that saves at
+    /// least a quarter of the space; everything else is stored raw.
+    template <typename T>
+    void add_column(SnapshotSection id, std::span<const T> values, bool allow_compression = true);
+
+    /// @brief Add a string table as an offsets/data section pair
+    void add_strings(SnapshotSection offsets_id, SnapshotSection data_id, const std::vector<std::string>& strings);
+
+    /// @brief Write all sections (to a temporary file, then renamed over path)
+    bool write(const std::string& path, std::string* error = nullptr) const;
+
+private:
+    struct PendingSection {
+        SnapshotTocEntry entry{};
+        std::vector<std::uint8_t> bytes;
+    };
+
+    void add_section(SnapshotSection id, SnapshotCodec codec, std::size_t item_size,
+                     std::size_t raw_size, std::vector<std::uint8_t>&& bytes);
+
+    std::vector<PendingSection> sections_;
+    std::string metadata_;
+    std::uint64_t function_signature_ = 0;
+    std::uint64_t bytes_signature_ = 0;
+    std::uint64_t name_stamp_ = 0;
+    std::uint64_t bytes_stamp_ = 0;
+};
+
+/// @class SnapshotFile
+/// @brief Read-only memory-mapped snapshot with lazy section access
+///
+/// Section accessors are safe to call from several threads. Returned spans
+/// stay valid until close() or destruction.
+class SnapshotFile {
+public:
+    SnapshotFile() = default;
+    ~SnapshotFile() { close(); }
+
+    // Non-copyable
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+    /// @brief Map a file and validate its header and TOC
+    bool open(const std::string& path, std::string* error = nullptr);
+
+    /// @brief Unmap and drop decoded sections
+    void close();
+
+    [[nodiscard]] bool is_open() const noexcept { return base_ != nullptr; }
+    [[nodiscard]] const SnapshotHeader& header() const noexcept { return header_; }
+    [[nodiscard]] const std::vector<SnapshotTocEntry>& toc() const noexcept { return toc_; }
+
+    /// @brief Check whether a section is present
+    [[nodiscard]] bool has(SnapshotSection id) const noexcept { return find(id) != nullptr; }
+
+    /// @brief Raw (decoded) bytes of a section; empty if missing or corrupt
+    [[nodiscard]] std::span<const std::uint8_t> section(SnapshotSection id) const;
+
+    /// @brief Typed view of a column; empty if missing, corrupt or of a different item size
+    template <typename T>
+    [[nodiscard]] std::span<const T> column(SnapshotSection id) const;
+
+    /// @brief String table view; empty if either section is missing or inconsistent
+    [[nodiscard]] SnapshotStrings strings(SnapshotSection offsets_id, SnapshotSection data_id) const;
+
+    /// @brief Metadata value for a key (empty if absent)
+    [[nodiscard]] std::string metadata(std::string_view key) const;
+
+private:
+    struct SectionState {
+        bool loaded = false;
+        bool valid = false;
+        std::vector<std::uint8_t> decoded;  // compressed sections only
+    };
+
+    [[nodiscard]] const SnapshotTocEntry* find(SnapshotSection id) const noexcept;
+
+    const std::uint8_t* base_ = nullptr;
+    std::size_t size_ = 0;
+#if defined(_WIN32)
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#endif
+
+    SnapshotHeader header_{};
+    std::vector<SnapshotTocEntry> toc_;
+    mutable std::unique_ptr<SectionState[]> states_;
+    mutable std::mutex mutex_;
+};
+
+// =============================================================================
+// Template Implementation
+// =============================================================================
+
+namespace snapshot_detail {
+
+/// Delta/zigzag/LEB128 encode an unsigned column; empty result means "not worth it"
+std::vector<std::uint8_t> encode_delta_varint(const void* values, std::size_t count, std::size_t item_size);
+
+} // namespace snapshot_detail
+
+template <typename T>
+void SnapshotWriter::add_column(SnapshotSection id, std::span<const T> values, bool allow_compression) {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshot columns must be trivially copyable");
+
+    const std::size_t raw_size = values.size_bytes();
+    if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) {
+        if (allow_compression) {
+            auto encoded = snapshot_detail::encode_delta_varint(values.data(), values.size(), sizeof(T));
+            if (!encoded.empty()) {
+                add_section(id, SnapshotCodec::DeltaVarint, sizeof(T), raw_size, std::move(encoded));
+                return;
+            }
+        }
+    }
+
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(values.data());
+    add_section(id, SnapshotCodec::None, sizeof(T), raw_size, std::vector<std::uint8_t>(bytes, bytes + raw_size));
+}
+
+template <typename T>
+std::span<const T> SnapshotFile::column(SnapshotSection id) const {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshot columns must be trivially copyable");
+
+    const SnapshotTocEntry* entry = find(id);
+    if (!entry || entry->item_size != sizeof(T)) return {};
+
+    auto bytes = section(id);
+    return {reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T)};
+}
+
+} // namespace synopsia
@@ -0,0 +1,185 @@
+/// @file analysis_cache.hpp
+/// @brief Precomputed analysis results persisted inside the IDB
+
+#pragma once
+
+#include <synopsia/common/types.hpp>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace synopsia {
+
+/// Netnode holding all cached sections
+inline constexpr const char* ANALYSIS_CACHE_NODE = "$ synopsia cache";
+
+/// Netnode holding the content revision counters (survives clear())
+inline constexpr const char* ANALYSIS_STAMP_NODE = "$ synopsia stamps";
+
+/// Bump when any section layout changes; older caches are ignored
+inline constexpr std::uint16_t ANALYSIS_CACHE_VERSION = 2;
+
+/// Number of entropy pyramid levels (DEFAULT_BLOCK_SIZE << level)
+inline constexpr std::size_t ENTROPY_PYRAMID_LEVELS = 5;
+
+/// Cache sections (netnode blob index)
+enum class CacheSection : std::uint32_t {
+    FunctionRecords = 1,   ///< CachedFunctionRecord per function
+    FunctionNames = 2,     ///< NUL-separated names, same order
+    DemangledNames = 3,    ///< NUL-separated demangled names, same order
+    CalleeOffsets = 4,     ///< CSR offsets (uint32)
+    CalleeTargets = 5,     ///< CSR targets (uint32)
+    EntropyLevel0 = 16,    ///< EntropyBlock list; level k at EntropyLevel0 + k
+    ByteHistograms = 32,   ///< ByteHistogram per span (base level; param = span size)
+    FlowLayouts = 48,      ///< Basic-block graph layouts, keyed by function address
+};
+
+/// Which database state a section depends on
+enum class CacheScope : std::uint8_t {
+    Functions,  ///< Function boundaries
+    Names,      ///< Function boundaries and function names
+    Bytes,      ///< Segment layout and contents
+};
+
+/// Per-function metrics and layout persisted by the call-graph pass
+struct CachedFunctionRecord {
+    std::uint64_t address;
+    std::uint64_t end_address;
+    std::uint32_t size;
+    std::uint32_t call_depth;
+    std::uint32_t callee_count;
+    std::uint32_t caller_count;
+    float x;
+    float y;
+    float z;
+    float complexity;
+};
+
+/// @class AnalysisCache
+/// @brief Versioned, signature-checked blob store in an IDB netnode
+///
+/// Each section is written with a header carrying the cache version and a
+/// signature of the database state it was computed from. Reads fail when
+/// either no longer matches, so stale results are never shown. An IDB
+/// listener drops affected sections when functions, names or bytes change.
+class AnalysisCache {
+public:
+    /// Header stored in front of each section payload
+    struct SectionHeader {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t item_size;
+        std::uint64_t count;
+        std::uint64_t signature;
+        std::uint64_t param;
+    };
+
+    /// @brief Signature of the current database state for a scope
+    ///
+    /// Names and Bytes include their content stamp, so a rename or a patch
+    /// changes the signature even though the layout stays the same.
+    [[nodiscard]] static std::uint64_t signature(CacheScope scope);
+
+    /// @brief Content revision of a scope: renames for Names, patches for Bytes
+    ///
+    /// Counters only ever grow and live in their own netnode, so they keep
+    /// counting across clear() and reopening the database. Functions has no
+    /// content beyond its boundaries and always returns 0.
+    [[nodiscard]] static std::uint64_t content_stamp(CacheScope scope);
+
+    /// @brief Advance the content revision of a scope
+    static void bump_content_stamp(CacheScope scope);
+
+    /// @brief Write a section of trivially copyable items
+    template <typename T>
+    static bool write(CacheSection section, CacheScope scope, std::span<const T> items,
+                      std::uint64_t param = 0);
+
+    template <typename T>
+    static bool write(CacheSection section, CacheScope scope, const std::vector<T>& items,
+                      std::uint64_t param = 0) {
+        return write(section, scope, std::span<const T>(items), param);
+    }
+
+    /// @brief Read a section; fails if missing, stale, or of a different item type
+    template <typename T>
+    static bool read(CacheSection section, CacheScope scope, std::vector<T>& items,
+                     std::uint64_t* param = nullptr);
+
+    /// @brief Write a string table (NUL-separated)
+    static bool write_strings(CacheSection section, CacheScope scope, const std::vector<std::string>& strings);
+
+    /// @brief Read a string table
+    static bool read_strings(CacheSection section, CacheScope scope, std::vector<std::string>& strings);
+
+    /// @brief Write one keyed entry of a section (e.g. one function's graph layout)
+    ///
+    /// Keyed entries carry a signature computed by the caller from exactly
+    /// what they depend on, so an edit elsewhere in the database keeps them.
+    static bool write_keyed(CacheSection section, std::uint64_t key, std::uint64_t signature,
+                            const std::vector<std::uint8_t>& payload);
+
+    /// @brief Read a keyed entry; fails if missing or written under another signature
+    static bool read_keyed(CacheSection section, std::uint64_t key, std::uint64_t signature,
+                           std::vector<std::uint8_t>& payload);
+
+    /// @brief Remove a section
+    static void remove(CacheSection section);
+
+    /// @brief Remove all sections depending on a scope
+    static void invalidate(CacheScope scope);
+
+    /// @brief Remove everything
+    static void clear();
+
+    /// @brief Start/stop dropping sections on IDB changes
+    static void hook_invalidation();
+    static void unhook_invalidation();
+
+private:
+    static bool write_raw(CacheSection section, const SectionHeader& header, const void* data, std::size_t size);
+    static bool read_raw(CacheSection section, SectionHeader& header, std::vector<std::uint8_t>& payload);
+
+    static constexpr std::uint32_t SECTION_MAGIC = 0x53594E43;  // 'SYNC'
+};
+
+// =============================================================================
+// Template Implementation
+// =============================================================================
+
+template <typename T>
+bool AnalysisCache::write(CacheSection section, CacheScope scope, std::span<const T> items,
+                          std::uint64_t param) {
+    static_assert(std::is_trivially_copyable_v<T>, "cached items must be trivially copyable");
+
+    SectionHeader header{};
+    header.magic = SECTION_MAGIC;
+    header.version = ANALYSIS_CACHE_VERSION;
+    header.item_size = static_cast<std::uint16_t>(sizeof(T));
+    header.count = items.size();
+    header.signature = signature(scope);
+    header.param = param;
+    return write_raw(section, header, items.data(), items.size() * sizeof(T));
+}
+
+template <typename T>
+bool AnalysisCache::read(CacheSection section, CacheScope scope, std::vector<T>& items,
+                         std::uint64_t* param) {
+    static_assert(std::is_trivially_copyable_v<T>, "cached items must be trivially copyable");
+
+    SectionHeader header{};
+    std::vector<std::uint8_t> payload;
+    if (!read_raw(section, header, payload)) return false;
+    if (header.item_size != sizeof(T) || header.signature != signature(scope)) return false;
+    if (payload.size() != header.count * sizeof(T)) return false;
+
+    items.resize(header.count);
+    if (!payload.empty()) {
+        std::memcpy(items.data(), payload.data(), payload.size());
+    }
+    if (param) *param = header.param;
+    return true;
+}
+
+} // namespace synopsia
@@ -0,0 +1,43 @@
+/// @file analysis_snapshot.hpp
+/// @brief Export and lazy loading of per-IDB snapshot files
+///
+/// A snapshot carries the same results as the in-IDB analysis cache (function
+/// catalog, names, call-graph CSR, metrics, layout, entropy pyramid) in the
+/// columnar SnapshotFile format, so it can be shared without the IDB and read
+/// by offline tools. When present next to the IDB and built from the same
+/// database state, data models load from it instead of recomputing.
+
+#pragma once
+
+#include <synopsia/common/types.hpp>
+#include <synopsia/common/snapshot_file.hpp>
+#include <synopsia/core/analysis_cache.hpp>
+
+namespace synopsia {
+
+/// Plugin option that writes a snapshot next to the IDB once the database is
+/// ready (combine with precompute: -Osynopsia:precompute:snapshot)
+inline constexpr const char* SNAPSHOT_OPTION = "snapshot";
+
+/// @brief Snapshot path for the current IDB (<idb path>.synsnap)
+[[nodiscard]] std::string default_snapshot_path();
+
+/// @brief Write a snapshot of the current database (main thread)
+/// @param path Output path; empty selects default_snapshot_path()
+/// @return true if the file was written
+bool export_snapshot(const std::string& path = {});
+
+/// @brief Snapshot next to the current IDB, mapped on first use
+/// @return nullptr if there is none or it cannot be opened
+[[nodiscard]] std::shared_ptr<const SnapshotFile> database_snapshot();
+
+/// @brief Whether a snapshot's sections for a scope match the current database
+///
+/// Functions also covers the name tables, so a rename rejects it; Bytes
+/// rejects patched bytes.
+[[nodiscard]] bool snapshot_matches(const SnapshotFile& snapshot, CacheScope scope);
+
+/// @brief Unmap the database snapshot (database closed, or about to be rewritten)
+void close_database_snapshot();
+
+} // namespace synopsia
@@ -0,0 +1,36 @@
+/// @file precompute.hpp
+/// @brief Headless precompute pass for batch (idat) runs
+
+#pragma once
+
+#include <synopsia/common/types.hpp>
+
+namespace synopsia {
+
+/// Plugin option that triggers precompute once the database is ready:
+///   idat -A -Osynopsia:precompute -S"save_and_exit.idc" target.i64
+inline constexpr const char* PRECOMPUTE_OPTION = "precompute";
+
+/// Plugin run() argument that triggers precompute
+///   ida_loader.load_and_run_plugin("synopsia", 0x5052)
+inline constexpr std::size_t PRECOMPUTE_RUN_ARG = 0x5052;
+
+/// Summary of a precompute run
+struct PrecomputeStats {
+    std::size_t functions = 0;
+    std::size_t call_edges = 0;
+    std::size_t entropy_blocks = 0;  ///< Across all pyramid levels
+    double seconds = 0.0;
+};
+
+/// @brief Run all expensive analyses and persist them into the IDB
+///
+/// Waits for auto-analysis, then rebuilds the entropy pyramid, call-graph
+/// CSR with metrics and Hilbert layout, and the function name index, and
+/// writes them to the analysis cache. Database reads happen on the calling
+/// (main) thread; block scoring fans out to all cores. Needs no UI.
+/// @param stats Optional output summary
+/// @return true if every section was written
+bool run_precompute(PrecomputeStats* stats = nullptr);
+
+} // namespace synopsia
@@ -0,0 +1,59 @@
+/// @file query_index.hpp
+/// @brief Shared, immutable query snapshot for scripting and external clients
+
+#pragma once
+
+#include <synopsia/features/binary_map_3d/map_data.hpp>
+#include <chrono>
+#include <memory>
+#include <string_view>
+
+namespace synopsia {
+
+/// @struct QuerySnapshot
+/// @brief Function catalog and call graph frozen at one point in time
+///
+/// Snapshots are immutable once published, so any thread may query one it
+/// holds a reference to. Consumers that hand out pointers into a snapshot
+/// keep the shared_ptr alive for as long as those pointers are in use.
+struct QuerySnapshot {
+    features::binary_map_3d::BinaryMapData map;
+    std::vector<std::string> folded_names;  // lowercase, for search
+
+    /// Case-insensitive substring search over function names
+    /// @param max_results Stop after this many matches (0 = unlimited)
+    [[nodiscard]] std::vector<std::uint32_t> search(std::string_view needle, std::uint32_t max_results) const;
+
+    /// Functions whose callee sets overlap the given node's the most (Jaccard)
+    [[nodiscard]] std::vector<std::pair<graph_index_t, float>> similar(graph_index_t node, std::uint32_t top_k) const;
+};
+
+/// @class QueryIndex
+/// @brief Owner of the current QuerySnapshot
+class QueryIndex {
+public:
+    /// Current snapshot or nullptr (any thread)
+    [[nodiscard]] static std::shared_ptr<const QuerySnapshot> current();
+
+    /// Current snapshot, building one if needed (main thread only)
+    [[nodiscard]] static std::shared_ptr<const QuerySnapshot> require();
+
+    /// Rebuild from the database (main thread only)
+    /// @return Number of functions in the new snapshot
+    static std::size_t refresh();
+
+    /// Advance a rebuild by up to budget, starting one if none is under way (main thread only)
+    ///
+    /// The xref walk is spread over calls; the current snapshot stays
+    /// published until the new one replaces it.
+    /// @return true once the rebuild has been published
+    static bool refresh_step(std::chrono::milliseconds budget);
+
+    /// Drop the current snapshot and any rebuild in progress; outstanding references stay valid
+    static void reset();
+};
+
+/// Lowercase ASCII copy used for case-insensitive matching
+[[nodiscard]] std::string fold_case(std::string_view text);
+
+} // namespace synopsia
@@ -0,0 +1,134 @@
+/// @file query_server.hpp
+/// @brief Opt-in local query server (Unix domain socket / Windows named pipe)
+///
+/// Wire format (little-endian, packed):
+///
+///   request  := QueryRequestHeader  payload[length]
+///   response := QueryResponseHeader payload[length]
+///
+/// Responses larger than QUERY_SHM_THRESHOLD are placed in a shared memory
+/// object instead; the response then carries QUERY_FLAG_SHARED_MEMORY and a
+/// QueryShmDescriptor as payload. The client maps the named object, reads
+/// `size` bytes and unlinks it (POSIX shm_unlink); the server releases any
+/// object the client did not claim when the connection closes.
+///
+/// Queries over the published QuerySnapshot are answered on the server
+/// thread. Requests that need IDA (entropy ranges, function lookup by
+/// arbitrary address, snapshot refresh) are marshalled to the main thread
+/// with execute_sync.
+
+#pragma once
+
+#include <synopsia/common/types.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace synopsia {
+
+inline constexpr std::uint32_t QUERY_MAGIC = 0x514E5953;  // 'SYNQ'
+inline constexpr std::uint16_t QUERY_PROTOCOL_VERSION = 1;
+inline constexpr std::uint32_t QUERY_MAX_REQUEST = 1u << 20;
+inline constexpr std::size_t QUERY_SHM_THRESHOLD = 64 * 1024;
+inline constexpr std::uint16_t QUERY_FLAG_SHARED_MEMORY = 0x0001;
+
+/// Most blocks one EntropyRange request may ask for (8 MiB of results)
+inline constexpr std::uint64_t QUERY_MAX_ENTROPY_BLOCKS = 1u << 20;
+
+/// Plugin option that starts the server at load time (-Osynopsia:server)
+inline constexpr const char* QUERY_SERVER_OPTION = "server";
+
+/// Request opcodes; payload layouts in comments (result arrays are packed)
+enum class QueryOp : std::uint16_t {
+    Ping = 1,          ///< -> u32 protocol, u32 reserved, u64 function count (0 = no snapshot)
+    Refresh = 2,       ///< -> u64 function count                               [main thread]
+    Search = 3,        ///< u32 max, char needle[] -> {u64 addr, u32 index, u32 0}[]
+    Reach = 4,         ///< u64 ea, u32 dir, u32 max_depth -> {u64 addr, u32 depth, u32 0}[]
+    Path = 5,          ///< u64 from, u64 to -> u64 addr[]
+    Similar = 6,       ///< u64 ea, u32 top_k, u32 0 -> {u64 addr, f32 score, u32 0}[]
+    EntropyRange = 7,  ///< u64 start, u64 end, u32 block, u32 0 -> f64[]     [main thread]
+    FunctionInfo = 8,  ///< u64 ea -> u64 start, u64 end, u32 callers, u32 callees,
+                       ///<          u32 depth, u32 name_len, char name[]      [main thread]
+};
+
+/// Response status codes
+enum class QueryStatus : std::uint16_t {
+    Ok = 0,
+    BadRequest = 1,
+    NotFound = 2,
+    NotReady = 3,       ///< No snapshot yet; send Refresh first
+    Unsupported = 4,
+    ShuttingDown = 5,
+    TooLarge = 6,       ///< Result does not fit in one response
+};
+
+#pragma pack(push, 1)
+struct QueryRequestHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t opcode;
+    std::uint32_t request_id;
+    std::uint32_t length;
+};
+
+struct QueryResponseHeader {
+    std::uint32_t magic;
+    std::uint16_t status;
+    std::uint16_t flags;
+    std::uint32_t request_id;
+    std::uint32_t length;
+};
+
+struct QueryShmDescriptor {
+    std::uint64_t size;
+    char name[56];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(QueryRequestHeader) == 16);
+static_assert(sizeof(QueryResponseHeader) == 16);
+static_assert(sizeof(QueryShmDescriptor) == 64);
+
+struct MainThreadQueue;
+
+/// @class QueryServer
+/// @brief Serves QueryOp requests to local clients on a background thread
+class QueryServer {
+public:
+    QueryServer() = default;
+    ~QueryServer() { stop(); }
+
+    // Non-copyable
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    /// @brief Start listening (main thread)
+    /// @param endpoint Socket path / pipe name; empty selects a per-process default
+    /// @return true if the server is listening
+    bool start(const std::string& endpoint = {});
+
+    /// @brief Stop listening and join the server thread (main thread)
+    void stop();
+
+    [[nodiscard]] bool is_running() const noexcept { return running_.load(); }
+
+    /// Endpoint clients should connect to
+    [[nodiscard]] const std::string& endpoint() const noexcept { return endpoint_; }
+
+    /// Default per-process endpoint
+    [[nodiscard]] static std::string default_endpoint();
+
+private:
+    void serve();
+
+    std::string endpoint_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<std::intptr_t> listen_handle_{-1};
+
+    /// Main-thread requests in flight; stop() cancels them, ones already running see it stopped
+    std::shared_ptr<MainThreadQueue> main_queue_;
+};
+
+} // namespace synopsia
@@ -0,0 +1,104 @@
+/// @file script_api.hpp
+/// @brief IDC / IDAPython scripting API over the analysis engines
+///
+/// Two entry points share one implementation:
+/// - IDC functions (synopsia_*) registered with add_idc_func. These may read
+///   the database and therefore run on the main thread.
+/// - An exported C ABI (synopsia_api_*) for ctypes. These only touch
+///   snapshots that were already built, never IDA, so they are safe to call
+///   from any thread; ctypes releases the GIL for the duration of the call.
+///
+/// Bulk results are returned as buffer handles. A handle owns a contiguous
+/// array that stays pinned until synopsia_buf_free / synopsia_api_buffer_free,
+/// so Python can wrap the address with ctypes and expose it as a memoryview
+/// (or numpy array) without copying. See python/synopsia_api.py.
+
+#pragma once
+
+#include <synopsia/common/types.hpp>
+#include <synopsia/core/query_server.hpp>
+
+#if defined(_WIN32)
+#define SYNOPSIA_API extern "C" __declspec(dllexport)
+#else
+#define SYNOPSIA_API extern "C" __attribute__((visibility("default")))
+#endif
+
+namespace synopsia {
+
+/// Scripting API version, bumped on incompatible changes
+inline constexpr int SCRIPT_API_VERSION = 1;
+
+/// @class ScriptApi
+/// @brief Registers the IDC bindings and owns the local query server
+class ScriptApi {
+public:
+    ScriptApi() { instance_ = this; }
+    ~ScriptApi() { instance_ = nullptr; }
+
+    // Non-copyable
+    ScriptApi(const ScriptApi&) = delete;
+    ScriptApi& operator=(const ScriptApi&) = delete;
+
+    /// @brief Register IDC functions
+    /// @return true if all functions were registered
+    bool install();
+
+    /// @brief Unregister IDC functions and drop the snapshot
+    void uninstall();
+
+    /// @brief Drop the snapshot (outstanding buffers remain valid)
+    void on_database_closed();
+
+    /// Local query server (started on demand)
+    [[nodiscard]] QueryServer& server() noexcept { return server_; }
+
+    [[nodiscard]] static ScriptApi* instance() noexcept { return instance_; }
+
+private:
+    QueryServer server_;
+    bool installed_ = false;
+
+    static inline ScriptApi* instance_ = nullptr;
+};
+
+} // namespace synopsia
+
+// =============================================================================
+// C ABI (ctypes)
+// =============================================================================
+
+/// Scripting API version
+SYNOPSIA_API int synopsia_api_version();
+
+/// Address of a buffer's first element (nullptr for unknown handles)
+SYNOPSIA_API const void* synopsia_api_buffer_data(std::int64_t handle);
+
+/// Number of elements in a buffer
+SYNOPSIA_API std::uint64_t synopsia_api_buffer_count(std::int64_t handle);
+
+/// struct-module format character of the element type ('d', 'I', 'Q', ...)
+SYNOPSIA_API char synopsia_api_buffer_format(std::int64_t handle);
+
+/// Release a buffer handle
+SYNOPSIA_API void synopsia_api_buffer_free(std::int64_t handle);
+
+/// BFS depths (uint32, UINT32_MAX = unreached) from a function; -1 on error
+SYNOPSIA_API std::int64_t synopsia_api_bfs(std::uint64_t source, int direction, std::uint32_t max_depth);
+
+/// Shortest call path as function addresses (uint64); -1 on error
+SYNOPSIA_API std::int64_t synopsia_api_path(std::uint64_t from, std::uint64_t to);
+
+/// Case-insensitive substring search; matching node indices (uint32); -1 on error
+SYNOPSIA_API std::int64_t synopsia_api_search(const char* needle, std::uint32_t max_results);
+
+/// Block scores for caller-supplied bytes; writes ceil(size / block_size) doubles
+SYNOPSIA_API std::uint64_t synopsia_api_block_scores(const void* data, std::uint64_t size,
+                                                     std::uint32_t block_size, double* out);
+
+/// Byte histogram for caller-supplied bytes; writes 256 uint64 counts
+SYNOPSIA_API void synopsia_api_histogram(const void* data, std::uint64_t size, std::uint64_t* out);
+
+/// Write caller-supplied block scores as a PNG (see ScoreImageLayout); 1 on success
+SYNOPSIA_API int synopsia_api_export_image(const double* scores, std::uint64_t count, std::uint32_t block_size,
+                                           const char* path, int layout, int width, int height);
@@ -0,0 +1,30 @@
+/// @file selection.hpp
+/// @brief Function selection shared between views
+
+#pragma once
+
+#include <pro.h>
+#include <cstdint>
+
+namespace synopsia {
+
+/// @class SelectionChannel
+/// @brief Last function selected in any view, mirrored by the others
+///
+/// Views publish when the user picks a function and poll version() once per
+/// frame, so no view calls into another. UI thread only, like the widgets.
+class SelectionChannel {
+public:
+    /// Publish a function start (no-op if it is already the selection)
+    static void publish(ea_t function);
+
+    [[nodiscard]] static ea_t current() noexcept;
+
+    /// Bumped on every change; compare with the last version seen
+    [[nodiscard]] static std::uint64_t version() noexcept;
+
+    /// Forget the selection and start versions over (database closed)
+    static void reset() noexcept;
+};
+
+} // namespace synopsia
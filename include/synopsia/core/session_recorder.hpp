@@ -0,0 +1,50 @@
+/// @file session_recorder.hpp
+/// @brief Records the event stream the plugin sees into a session trace
+///
+/// Cursor moves, database change notifications, per-widget UI input and the
+/// frames that consumed it, and data-source answers are appended to a
+/// SessionTrace file with microsecond timestamps. The standalone viewer
+/// replays such a trace against a snapshot of the same database
+/// (synopsia_viewer <file.synsnap> --replay <file.syntrace>) and reports
+/// per-event latency, so a field report can be reproduced without the IDB.
+
+#pragma once
+
+#include <synopsia/common/types.hpp>
+#include <synopsia/common/session_trace.hpp>
+
+namespace synopsia {
+
+/// Plugin option that records from startup to <idb>.syntrace:
+///   ida -Osynopsia:trace target.i64
+inline constexpr const char* TRACE_OPTION = "trace";
+
+/// @class SessionRecorder
+/// @brief Process-wide trace recorder (UI thread only, like the events it logs)
+///
+/// Every record_* call is a single branch while nothing is being recorded.
+class SessionRecorder {
+public:
+    /// @brief Start recording (restarts if already recording)
+    /// @param path Output path; empty selects default_trace_path()
+    static bool start(const std::string& path = {});
+
+    /// @brief Stop recording and close the file
+    static void stop();
+
+    [[nodiscard]] static bool is_recording() noexcept;
+
+    static void record_cursor(ea_t addr);
+    static void record_change(TraceChange change, ea_t addr, const char* text = nullptr);
+    static void record_response(TraceSource source, std::uint64_t parameter, std::int64_t value);
+    static void record_input(const char* widget, TraceInput input, float x, float y, std::int64_t value);
+    static void record_frame(const char* widget, std::uint64_t render_us);
+
+    /// @brief Remember the minimap geometry (kept while not recording, for the next header)
+    static void set_minimap_layout(const TraceMinimapLayout& layout) noexcept;
+};
+
+/// @brief Trace path for the current IDB (<idb path>.syntrace)
+[[nodiscard]] std::string default_trace_path();
+
+} // namespace synopsia
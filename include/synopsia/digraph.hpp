@@ -0,0 +1,67 @@
+/// @file digraph.hpp
+/// @brief Byte-pair digraph ("cantor dust") of a byte range (no IDA or Qt dependencies)
+///
+/// Cell (row a, column b) counts how often byte b directly follows byte a.
+/// Instruction sets, text encodings and compressed data each leave a
+/// recognizable texture: ASCII fills a square, UTF-16 a cross, x86 opcode
+/// bytes dense rows, and random data a uniform haze.
+
+#pragma once
+
+#include "color.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace synopsia {
+
+/// @class ByteDigraph
+/// @brief 256x256 pair counts with a log-scaled rendering
+///
+/// Counting splits the buffer across worker threads. Each thread fills its
+/// own partial matrices, and the partials are summed at the end. The kernel
+/// loads eight bytes at a time and forms the pairs by shifting. Two
+/// interleaved matrices per thread keep runs of one pair (zero padding)
+/// from serializing on a single counter.
+class ByteDigraph {
+public:
+    static constexpr int SIDE = 256;
+    static constexpr std::size_t CELLS = static_cast<std::size_t>(SIDE) * SIDE;
+
+    /// @brief Replace the counts with the pairs of a buffer
+    /// @param breaks Offsets where a new run of bytes starts (pieces read
+    /// separately); the pair across each one is not counted
+    void compute(std::span<const std::uint8_t> data, std::span<const std::size_t> breaks = {});
+
+    void clear();
+
+    /// @brief Times `second` directly follows `first`
+    [[nodiscard]] std::uint32_t count(int first, int second) const noexcept {
+        return counts_[static_cast<std::size_t>(second) * SIDE + static_cast<std::size_t>(first)];
+    }
+
+    /// @brief Pairs counted
+    [[nodiscard]] std::uint64_t pairs() const noexcept { return pairs_; }
+
+    /// @brief Largest cell
+    [[nodiscard]] std::uint32_t max_count() const noexcept { return max_; }
+
+    /// @brief Paint the 256x256 matrix, rows = first byte, columns = second byte
+    ///
+    /// Brightness is log(1 + count) / log(1 + max); empty cells get the background.
+    /// @param pixels 0xAARRGGBB pixels
+    /// @param stride Pixels per row
+    void render(const ColorGradient& gradient, std::uint32_t* pixels, std::size_t stride) const;
+
+private:
+    // Indexed second * 256 + first: a little-endian 16-bit load of a pair
+    std::vector<std::uint32_t> counts_ = std::vector<std::uint32_t>(CELLS, 0);
+    std::vector<std::uint32_t> partials_;  // Two matrices per part
+    std::uint64_t pairs_ = 0;
+    std::uint32_t max_ = 0;
+};
+
+} // namespace synopsia
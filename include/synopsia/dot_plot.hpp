@@ -0,0 +1,188 @@
+/// @file dot_plot.hpp
+/// @brief Self-similarity dot-plot from per-block MinHash sketches (no IDA or Qt dependencies)
+///
+/// Pixel (x, y) is lit when some block under column x resembles some block
+/// under row y, so duplicated code, repeated tables and unrolled data show
+/// up as lines and squares off the diagonal. Comparing every pair of blocks
+/// is quadratic; instead each block carries a MinHash sketch of its 4-byte
+/// shingles, sketches are bucketed by locality-sensitive hashing, and only
+/// blocks sharing a bucket are plotted. Sketches merge by taking slot-wise
+/// minimums, so the coarser levels of the pyramid never rehash bytes.
+
+#pragma once
+
+#include "color.hpp"
+#include "minimap_data_interface.hpp"
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace synopsia {
+
+/// MinHash slots per sketch
+inline constexpr std::size_t SKETCH_SLOTS = 32;
+
+/// LSH bands; a pair of blocks with Jaccard similarity J shares one with
+/// probability J^(SKETCH_SLOTS / DOT_PLOT_BANDS)
+inline constexpr std::size_t DOT_PLOT_BANDS = 8;
+
+/// Base-level blocks are capped at this count (about 9 MB with the pyramid)
+inline constexpr std::size_t DOT_PLOT_MAX_BLOCKS = 65536;
+
+/// MinHash sketch of one block
+///
+/// One-permutation MinHash: every shingle is hashed once, the top bits pick
+/// a slot and the slot keeps the smallest low half seen. Empty slots are
+/// filled in only when bands are formed, so merged sketches stay exact.
+struct BlockSketch {
+    static constexpr std::uint32_t EMPTY = 0xFFFFFFFFu;
+
+    data_addr_t start_addr = 0;
+    data_addr_t end_addr = 0;
+    data_size_t position = 0;  ///< Plot axis offset; gaps between segments take no space
+    data_size_t bytes = 0;     ///< Plot axis length (merged blocks may span a gap)
+    bool uniform = false;      ///< Every byte has the same value (padding, zero fill)
+    std::array<std::uint32_t, SKETCH_SLOTS> slots{};
+
+    [[nodiscard]] constexpr data_size_t end_position() const noexcept { return position + bytes; }
+
+    /// @brief Sketch a buffer (addresses and position are left to the caller)
+    void compute(const std::uint8_t* data, std::size_t size) noexcept;
+
+    /// @brief Whether no shingle was hashed (unreadable block)
+    [[nodiscard]] bool empty() const noexcept;
+
+    /// @brief Slots with empty ones filled from their next non-empty neighbour
+    [[nodiscard]] std::array<std::uint32_t, SKETCH_SLOTS> densified() const noexcept;
+
+    /// @brief Estimated Jaccard similarity of the two blocks' shingle sets (0-1)
+    [[nodiscard]] double similarity(const BlockSketch& other) const noexcept;
+};
+
+/// @brief Sketch of the union of two adjacent blocks
+[[nodiscard]] BlockSketch merge_sketches(const BlockSketch& a, const BlockSketch& b) noexcept;
+
+/// @brief Base block size for a database: power of two, at least min_block
+[[nodiscard]] std::size_t dot_plot_block_size(std::uint64_t total_bytes, std::size_t min_block = 4096);
+
+/// @brief Block containing a plot position, or nullptr
+/// @param blocks Blocks sorted by position
+[[nodiscard]] const BlockSketch* sketch_at(std::span<const BlockSketch> blocks, data_size_t position) noexcept;
+
+/// @class SketchPyramid
+/// @brief Base-level sketches with coarser levels made by merging neighbours
+class SketchPyramid {
+public:
+    /// @brief Take base-level sketches and build the coarser levels
+    ///
+    /// Base blocks are sorted, laid end to end by position, and each covers
+    /// contiguous addresses (none straddles a gap between segments).
+    void build(std::vector<BlockSketch> base, std::size_t block_size);
+
+    void clear() noexcept;
+
+    [[nodiscard]] bool empty() const noexcept { return levels_.empty() || levels_.front().empty(); }
+    [[nodiscard]] std::size_t block_size() const noexcept { return block_size_; }
+    [[nodiscard]] std::size_t level_count() const noexcept { return levels_.size(); }
+    [[nodiscard]] std::span<const BlockSketch> level(std::size_t index) const { return levels_[index]; }
+
+    /// @brief Coarsest level whose blocks are at most `bytes` long (level 0 if none is)
+    [[nodiscard]] std::size_t level_for(data_size_t bytes) const noexcept;
+
+    /// @brief Plot axis length (readable bytes)
+    [[nodiscard]] data_size_t total_bytes() const noexcept;
+
+    /// @brief Address at a plot position (DATA_BADADDR outside)
+    [[nodiscard]] data_addr_t address_at(data_size_t position) const noexcept;
+
+    /// @brief Plot position of an address (nearest following position for gaps)
+    [[nodiscard]] data_size_t position_of(data_addr_t addr) const noexcept;
+
+private:
+    std::vector<std::vector<BlockSketch>> levels_;
+    std::size_t block_size_ = 0;
+};
+
+/// Plot window on the plot axis: columns are x, rows are y
+struct DotPlotWindow {
+    data_size_t x_start = 0;
+    data_size_t x_end = 0;
+    data_size_t y_start = 0;
+    data_size_t y_end = 0;
+
+    [[nodiscard]] constexpr data_size_t x_range() const noexcept { return x_end - x_start; }
+    [[nodiscard]] constexpr data_size_t y_range() const noexcept { return y_end - y_start; }
+};
+
+/// @class DotPlot
+/// @brief Buckets sketches by LSH and rasterizes the colliding pairs
+///
+/// Each cell records which bands produced a collision under it; the color
+/// follows the Jaccard similarity that many band hits imply. Bands are
+/// bucketed on worker threads.
+class DotPlot {
+public:
+    /// Counters from the last rasterize()
+    struct Stats {
+        std::size_t blocks = 0;        ///< Blocks inside the window
+        std::size_t buckets = 0;       ///< Buckets holding more than one block
+        std::uint64_t pairs = 0;       ///< Block pairs emitted (x block, y block)
+        std::uint64_t cells = 0;       ///< Lit pixels
+        double milliseconds = 0.0;
+    };
+
+    explicit DotPlot(const ColorGradient& gradient);
+
+    void set_gradient(const ColorGradient& gradient);
+
+    /// @brief Skip blocks of a single repeated byte (large padding squares)
+    void set_skip_uniform(bool skip) noexcept { skip_uniform_ = skip; }
+    [[nodiscard]] bool skip_uniform() const noexcept { return skip_uniform_; }
+
+    /// @brief Paint a window into a pixel rectangle
+    /// @param blocks Sketches sorted by position; blocks about a pixel long or
+    ///        larger keep the cost near pixels * bands
+    /// @param pixels 0xAARRGGBB pixels; unlit cells get the background color
+    /// @param stride Pixels per row
+    void rasterize(std::span<const BlockSketch> blocks, const DotPlotWindow& window,
+                   int width, int height, std::uint32_t* pixels, std::size_t stride);
+
+    /// @brief Bands that collided under a pixel of the last raster (0 if none)
+    [[nodiscard]] int bands_at(int x, int y) const noexcept;
+
+    [[nodiscard]] const Stats& stats() const noexcept { return stats_; }
+
+private:
+    /// Pixel span of a block on one axis; first == last when outside
+    struct Extent {
+        int x_first = 0;
+        int x_last = 0;
+        int y_first = 0;
+        int y_last = 0;
+    };
+
+    /// Per-band bucketing buffers, kept between frames
+    struct BandScratch {
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> entries;  // (band key, candidate)
+        std::vector<std::uint32_t> x_stamp;  // Last bucket that listed each column
+        std::vector<std::uint32_t> y_stamp;
+        std::vector<int> xs;
+        std::vector<int> ys;
+    };
+
+    std::array<std::uint32_t, DOT_PLOT_BANDS + 1> lut_{};
+    bool skip_uniform_ = true;
+
+    std::vector<std::uint8_t> cells_;  // Bit b set: band b collided here
+    std::vector<std::uint32_t> candidates_;  // Block indices inside the window
+    std::vector<Extent> extents_;
+    std::vector<std::uint64_t> keys_;  // Band-major: keys_[band * candidates + c]
+    std::vector<std::uint8_t> usable_;
+    std::array<BandScratch, DOT_PLOT_BANDS> bands_;
+    int width_ = 0;
+    int height_ = 0;
+    Stats stats_;
+};
+
+} // namespace synopsia
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "types.hpp"
+#include "byte_plot.hpp"
 #include <array>
 #include <span>
 
@@ -31,11 +32,30 @@ public:
     /// @return Scaled JS divergence value (0.0 to 8.0)
     [[nodiscard]] static double calculate(std::span<const std::uint8_t> data);
     
+    /// @brief Accumulate byte-value counts for a data buffer
+    /// @param data Pointer to data buffer
+    /// @param size Size of data buffer in bytes
+    /// @param counts Histogram to add into (not cleared)
+    static void accumulate_histogram(const void* data, std::size_t size,
+                                     std::array<std::uint64_t, 256>& counts);
+    
     /// @brief Analyze entire database and compute entropy blocks
     /// @param block_size Size of each analysis block in bytes
     /// @return Vector of entropy blocks covering the database
     [[nodiscard]] std::vector<EntropyBlock> analyze_database(std::size_t block_size = DEFAULT_BLOCK_SIZE) const;
     
+    /// @brief Analyze entire database at several block sizes in one pass
+    ///
+    /// Bytes are read on the calling thread in large windows; block scores are
+    /// computed on worker threads. Level k uses block_size << k.
+    /// @param block_size Block size of level 0
+    /// @param level_count Number of levels to produce
+    /// @return One block vector per level, each sorted by address
+    [[nodiscard]] std::vector<std::vector<EntropyBlock>> analyze_database_levels(
+        std::size_t block_size,
+        std::size_t level_count
+    ) const;
+    
     /// @brief Analyze a specific address range
     /// @param start_ea Start address
     /// @param end_ea End address (exclusive)
@@ -66,6 +86,25 @@ public:
     /// @return Entropy value, or -1.0 if data cannot be read
     [[nodiscard]] double calculate_at_address(ea_t ea, std::size_t size) const;
     
+    /// @brief Byte-value histogram over an address range
+    /// @param start_ea Start address
+    /// @param end_ea End address (exclusive)
+    /// @return Count of each byte value; unreadable bytes are not counted
+    [[nodiscard]] std::array<std::uint64_t, 256> histogram_range(ea_t start_ea, ea_t end_ea) const;
+    
+    /// @brief Byte histograms of consecutive spans over the readable segments in a range
+    ///
+    /// Spans start at each segment start; bytes are read on the calling
+    /// thread in large windows and counted on worker threads.
+    /// @param start_ea Start address
+    /// @param end_ea End address (exclusive)
+    /// @param span_size Bytes per span
+    [[nodiscard]] std::vector<ByteHistogram> histogram_spans(ea_t start_ea, ea_t end_ea, std::size_t span_size) const;
+    
+    /// @brief Byte histograms over the whole database, at the span size for its size
+    /// @param span_size Receives the span size used
+    [[nodiscard]] std::vector<ByteHistogram> histogram_database(std::size_t* span_size) const;
+    
 private:
     /// Internal buffer for reading database bytes
     mutable std::vector<std::uint8_t> read_buffer_;
@@ -137,4 +176,19 @@ inline double EntropyCalculator::calculate(std::span<const std::uint8_t> data) {
     return calculate(data.data(), data.size());
 }
 
+inline void EntropyCalculator::accumulate_histogram(
+    const void* data,
+    std::size_t size,
+    std::array<std::uint64_t, 256>& counts
+) {
+    if (data == nullptr) {
+        return;
+    }
+    
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        ++counts[bytes[i]];
+    }
+}
+
 } // namespace synopsia
@@ -0,0 +1,357 @@
+/// @file exploration.hpp
+/// @brief Persistent exploration states for the locked call graph (no IDA dependencies)
+///
+/// Lock mode starts from the graph on screen and grows it by following
+/// functions. Each step is an immutable ExplorationState whose maps share
+/// every untouched subtree with the step before, so keeping the whole
+/// history costs memory per change, and moving between two steps visits
+/// only the parts of the maps that differ.
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace binary_map_3d {
+
+using explore_addr_t = std::uint64_t;
+
+/// @class PersistentMap
+/// @brief Immutable hash array mapped trie from addresses to values
+///
+/// set() and erase() return a new map that copies only the O(log32 n)
+/// nodes on the path to the key. diff() skips subtrees the two maps share.
+template <typename V>
+class PersistentMap {
+public:
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /// Value for key, or nullptr
+    [[nodiscard]] const V* find(explore_addr_t key) const {
+        const Node* node = root_.get();
+        const std::uint64_t h = hash(key);
+        for (unsigned depth = 0; node; ++depth) {
+            const std::uint32_t bit = 1u << slot(h, depth);
+            if ((node->bitmap & bit) == 0) return nullptr;
+            const Entry& entry = node->entries[index(node->bitmap, bit)];
+            if (!entry.child) return entry.key == key ? &entry.value : nullptr;
+            node = entry.child.get();
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] PersistentMap set(explore_addr_t key, V value) const {
+        PersistentMap out;
+        bool added = false;
+        out.root_ = insert(root_.get(), hash(key), 0, Entry{key, std::move(value), nullptr}, added);
+        out.size_ = size_ + (added ? 1 : 0);
+        return out;
+    }
+
+    [[nodiscard]] PersistentMap erase(explore_addr_t key) const {
+        if (!find(key)) return *this;
+        PersistentMap out;
+        Entry lifted;
+        out.root_ = remove(*root_, hash(key), 0, key, lifted, true);
+        out.size_ = size_ - 1;
+        return out;
+    }
+
+    /// fn(key, value) for every entry, in hash order
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        if (root_) visit(*root_, fn);
+    }
+
+    /// @brief Report what changes from `from` to `to`
+    ///
+    /// removed(key, old) and added(key, value) for keys in only one map,
+    /// changed(key, old, value) for keys whose values differ.
+    template <typename Removed, typename Added, typename Changed>
+    static void diff(const PersistentMap& from, const PersistentMap& to,
+                     Removed&& removed, Added&& added, Changed&& changed) {
+        diff_nodes(from.root_.get(), to.root_.get(), 0, removed, added, changed);
+    }
+
+private:
+    struct Node;
+
+    /// A leaf (child empty) or a subtree
+    struct Entry {
+        explore_addr_t key = 0;
+        V value{};
+        std::shared_ptr<const Node> child;
+    };
+
+    struct Node {
+        std::uint32_t bitmap = 0;     // Occupied slots
+        std::vector<Entry> entries;   // One per set bit, in slot order
+    };
+
+    static constexpr unsigned BITS = 5;
+
+    /// Bijective mix, so distinct keys never share a full hash
+    static std::uint64_t hash(std::uint64_t x) noexcept {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    static unsigned slot(std::uint64_t h, unsigned depth) noexcept {
+        return static_cast<unsigned>((h >> (depth * BITS)) & 31);
+    }
+
+    static std::size_t index(std::uint32_t bitmap, std::uint32_t bit) noexcept {
+        return static_cast<std::size_t>(std::popcount(bitmap & (bit - 1)));
+    }
+
+    /// Subtree holding two leaves whose hashes agree below `depth`
+    static std::shared_ptr<const Node> pair(Entry a, std::uint64_t ha, Entry b, std::uint64_t hb, unsigned depth) {
+        auto node = std::make_shared<Node>();
+        const unsigned sa = slot(ha, depth);
+        const unsigned sb = slot(hb, depth);
+        if (sa == sb) {
+            node->bitmap = 1u << sa;
+            node->entries.push_back(Entry{0, V{}, pair(std::move(a), ha, std::move(b), hb, depth + 1)});
+        } else {
+            node->bitmap = (1u << sa) | (1u << sb);
+            if (sa < sb) {
+                node->entries.push_back(std::move(a));
+                node->entries.push_back(std::move(b));
+            } else {
+                node->entries.push_back(std::move(b));
+                node->entries.push_back(std::move(a));
+            }
+        }
+        return node;
+    }
+
+    static std::shared_ptr<const Node> insert(const Node* node, std::uint64_t h, unsigned depth, Entry leaf,
+                                              bool& added) {
+        auto copy = node ? std::make_shared<Node>(*node) : std::make_shared<Node>();
+        const std::uint32_t bit = 1u << slot(h, depth);
+        const std::size_t i = index(copy->bitmap, bit);
+        if ((copy->bitmap & bit) == 0) {
+            copy->bitmap |= bit;
+            copy->entries.insert(copy->entries.begin() + static_cast<std::ptrdiff_t>(i), std::move(leaf));
+            added = true;
+            return copy;
+        }
+
+        Entry& entry = copy->entries[i];
+        if (entry.child) {
+            entry.child = insert(entry.child.get(), h, depth + 1, std::move(leaf), added);
+        } else if (entry.key == leaf.key) {
+            entry.value = std::move(leaf.value);
+        } else {
+            const std::uint64_t other = hash(entry.key);
+            Entry existing = std::move(entry);
+            entry = Entry{0, V{}, pair(std::move(existing), other, std::move(leaf), h, depth + 1)};
+            added = true;
+        }
+        return copy;
+    }
+
+    /// Remove key (known present). A subtree left with a single leaf is
+    /// returned as nullptr with that leaf in `lifted`, for the parent to inline.
+    static std::shared_ptr<const Node> remove(const Node& node, std::uint64_t h, unsigned depth,
+                                              explore_addr_t key, Entry& lifted, bool is_root) {
+        auto copy = std::make_shared<Node>(node);
+        const std::uint32_t bit = 1u << slot(h, depth);
+        const std::size_t i = index(copy->bitmap, bit);
+        Entry& entry = copy->entries[i];
+
+        if (entry.child) {
+            Entry inner;
+            auto child = remove(*entry.child, h, depth + 1, key, inner, false);
+            if (child) {
+                entry.child = std::move(child);
+            } else {
+                entry = std::move(inner);
+            }
+        } else {
+            copy->bitmap &= ~bit;
+            copy->entries.erase(copy->entries.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+
+        if (copy->entries.empty()) return nullptr;
+        if (!is_root && copy->entries.size() == 1 && !copy->entries[0].child) {
+            lifted = std::move(copy->entries[0]);
+            return nullptr;
+        }
+        return copy;
+    }
+
+    template <typename Fn>
+    static void visit(const Node& node, Fn& fn) {
+        for (const Entry& entry : node.entries) {
+            if (entry.child) {
+                visit(*entry.child, fn);
+            } else {
+                fn(entry.key, entry.value);
+            }
+        }
+    }
+
+    template <typename Removed, typename Added, typename Changed>
+    static void diff_nodes(const Node* a, const Node* b, unsigned depth,
+                           Removed& removed, Added& added, Changed& changed) {
+        if (a == b) return;  // Shared subtree (or both empty)
+        if (!a) {
+            visit(*b, added);
+            return;
+        }
+        if (!b) {
+            visit(*a, removed);
+            return;
+        }
+
+        for (std::uint32_t bits = a->bitmap | b->bitmap; bits != 0; bits &= bits - 1) {
+            const std::uint32_t bit = bits & (~bits + 1);
+            const Entry* ea = (a->bitmap & bit) ? &a->entries[index(a->bitmap, bit)] : nullptr;
+            const Entry* eb = (b->bitmap & bit) ? &b->entries[index(b->bitmap, bit)] : nullptr;
+
+            if (!eb) {
+                diff_entry_removed(*ea, removed);
+            } else if (!ea) {
+                diff_entry_added(*eb, added);
+            } else if (ea->child && eb->child) {
+                diff_nodes(ea->child.get(), eb->child.get(), depth + 1, removed, added, changed);
+            } else if (!ea->child && !eb->child) {
+                if (ea->key == eb->key) {
+                    if (!(ea->value == eb->value)) changed(ea->key, ea->value, eb->value);
+                } else {
+                    removed(ea->key, ea->value);
+                    added(eb->key, eb->value);
+                }
+            } else {
+                // A leaf on one side, a subtree on the other: match the leaf by key
+                const Entry& leaf = ea->child ? *eb : *ea;
+                const Node& tree = ea->child ? *ea->child : *eb->child;
+                bool found = false;
+                visit_entries(tree, [&](const Entry& e) {
+                    if (e.key != leaf.key) {
+                        if (ea->child) {
+                            removed(e.key, e.value);
+                        } else {
+                            added(e.key, e.value);
+                        }
+                        return;
+                    }
+                    found = true;
+                    const V& old_value = ea->child ? e.value : leaf.value;
+                    const V& new_value = ea->child ? leaf.value : e.value;
+                    if (!(old_value == new_value)) changed(e.key, old_value, new_value);
+                });
+                if (!found) {
+                    if (ea->child) {
+                        added(leaf.key, leaf.value);
+                    } else {
+                        removed(leaf.key, leaf.value);
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename Fn>
+    static void visit_entries(const Node& node, Fn&& fn) {
+        for (const Entry& entry : node.entries) {
+            if (entry.child) {
+                visit_entries(*entry.child, fn);
+            } else {
+                fn(entry);
+            }
+        }
+    }
+
+    template <typename Removed>
+    static void diff_entry_removed(const Entry& entry, Removed& removed) {
+        if (entry.child) {
+            visit(*entry.child, removed);
+        } else {
+            removed(entry.key, entry.value);
+        }
+    }
+
+    template <typename Added>
+    static void diff_entry_added(const Entry& entry, Added& added) {
+        if (entry.child) {
+            visit(*entry.child, added);
+        } else {
+            added(entry.key, entry.value);
+        }
+    }
+
+    std::shared_ptr<const Node> root_;
+    std::size_t size_ = 0;
+};
+
+/// Functions a follow brought into the graph (undone by unfollowing)
+using FollowContribution = std::shared_ptr<const std::vector<explore_addr_t>>;
+
+/// @struct ExplorationState
+/// @brief One step of lock-mode exploration
+struct ExplorationState {
+    /// Functions in the graph -> number of contributors (the locked base counts once)
+    PersistentMap<std::uint32_t> present;
+
+    /// Followed functions -> what following them added
+    PersistentMap<FollowContribution> followed;
+
+    /// State holding exactly the given functions, nothing followed
+    [[nodiscard]] static ExplorationState base(const std::vector<explore_addr_t>& functions);
+
+    /// Follow a function: count each neighbor in, adding at most up to max_present functions
+    [[nodiscard]] ExplorationState follow(explore_addr_t function, const std::vector<explore_addr_t>& neighbors,
+                                          std::size_t max_present) const;
+
+    /// Undo a follow; functions nothing else contributes leave the graph
+    [[nodiscard]] ExplorationState unfollow(explore_addr_t function) const;
+};
+
+/// @class ExplorationHistory
+/// @brief Back/forward list of exploration states
+///
+/// Pushing after going back drops the forward steps, like browser history.
+class ExplorationHistory {
+public:
+    /// Start over from a single state
+    void reset(ExplorationState initial);
+
+    /// Append a step after the current one
+    void push(ExplorationState next);
+
+    [[nodiscard]] bool empty() const noexcept { return steps_.empty(); }
+    [[nodiscard]] const ExplorationState& current() const { return steps_[position_]; }
+    [[nodiscard]] const ExplorationState& initial() const { return steps_.front(); }
+
+    [[nodiscard]] bool can_go_back() const noexcept { return position_ > 0; }
+    [[nodiscard]] bool can_go_forward() const noexcept { return position_ + 1 < steps_.size(); }
+    void go_back();
+    void go_forward();
+
+    [[nodiscard]] std::size_t position() const noexcept { return position_; }
+    [[nodiscard]] std::size_t size() const noexcept { return steps_.size(); }
+
+    void clear();
+
+private:
+    static constexpr std::size_t MAX_STEPS = 256;
+
+    std::vector<ExplorationState> steps_;
+    std::size_t position_ = 0;
+};
+
+} // namespace binary_map_3d
+} // namespace features
+} // namespace synopsia
@@ -71,7 +71,6 @@ private:
     bool register_actions();
     void unregister_actions();
 
-    std::unique_ptr<binary_map_3d::BinaryMapData> data_;
     static BinaryMap3DFeature* instance_;
 };
 
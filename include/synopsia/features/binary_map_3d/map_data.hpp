@@ -4,9 +4,13 @@
 #pragma once
 
 #include <synopsia/common/types.hpp>
+#include <synopsia/common/call_graph.hpp>
+#include <chrono>
+#include <deque>
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <memory>
 
 namespace synopsia {
 namespace features {
@@ -54,9 +58,37 @@ public:
     BinaryMapData(const BinaryMapData&) = delete;
     BinaryMapData& operator=(const BinaryMapData&) = delete;
 
-    /// Refresh all data from database
+    /// Refresh all data from database (uses the IDB analysis cache or snapshot when valid)
+    /// Blocks until the call graph is complete.
     bool refresh();
 
+    /// Start a progressive refresh (main thread)
+    ///
+    /// Loads the function catalog and Hilbert layout; the call graph is then
+    /// filled in by scan_step(). Cached or snapshot results complete at once.
+    /// @param focus Address whose call neighborhood is scanned first (BADADDR for none)
+    /// @return true if there are functions to show
+    bool begin_refresh(ea_t focus = BADADDR);
+
+    /// Scan functions for up to budget, publishing a partial CSR periodically (main thread)
+    /// @return true once the call graph is complete
+    bool scan_step(std::chrono::milliseconds budget);
+
+    /// Move a function's neighborhood to the front of the remaining scan
+    void prioritize(ea_t addr);
+
+    /// Whether the call graph scan has finished
+    [[nodiscard]] bool is_complete() const { return complete_; }
+
+    /// Fraction of functions scanned [0, 1]
+    [[nodiscard]] float scan_progress() const;
+
+    /// Incremented whenever edges, counts or depths change (partial or final publish)
+    [[nodiscard]] std::uint64_t generation() const { return generation_; }
+
+    /// Persist nodes, metrics, layout and CSR into the IDB analysis cache
+    bool store_cache() const;
+
     /// Check if data is valid
     [[nodiscard]] bool is_valid() const { return valid_; }
 
@@ -72,12 +104,30 @@ public:
     /// Get node by address
     [[nodiscard]] const FunctionNode* find_node(ea_t addr) const;
 
+    /// Get node index by function start address (GRAPH_NO_NODE if not found)
+    [[nodiscard]] graph_index_t index_of(ea_t addr) const;
+
+    /// Get CSR call graph (node indices match nodes())
+    [[nodiscard]] const CallGraph& graph() const { return graph_; }
+
     /// Get Hilbert curve order used
     [[nodiscard]] int hilbert_order() const { return hilbert_order_; }
 
 private:
-    /// Build call graph from xrefs
-    void build_call_graph();
+    /// Load precomputed results from the IDB analysis cache
+    bool load_cache();
+
+    /// Load precomputed results from the snapshot file next to the IDB
+    bool load_snapshot();
+
+    /// Rebuild edges and graph from a callee CSR over nodes_
+    void adopt_callee_csr(std::span<const std::uint32_t> offsets, std::span<const graph_index_t> targets);
+
+    /// Collect call edges of one function from xrefs, queueing unscanned callees
+    void scan_function(graph_index_t index);
+
+    /// Build CSR, counts and depths from the edges found so far
+    void publish();
 
     /// Compute call depths via BFS from entry points
     void compute_call_depths();
@@ -94,12 +144,27 @@ private:
     std::vector<FunctionNode> nodes_;
     std::vector<CallEdge> edges_;
     std::unordered_map<ea_t, std::size_t> addr_to_index_;
-    std::unordered_map<ea_t, std::vector<ea_t>> callees_;  // func -> functions it calls
-    std::unordered_map<ea_t, std::vector<ea_t>> callers_;  // func -> functions that call it
+    CallGraph graph_;  // callee/caller adjacency over node indices
 
     std::uint32_t max_depth_ = 0;
     int hilbert_order_ = 8;  // 2^8 = 256x256 grid
     bool valid_ = false;
+    bool complete_ = false;
+    std::uint64_t generation_ = 0;
+
+    /// Progressive scan state (released once complete)
+    struct ScanState {
+        std::deque<graph_index_t> priority;     // Cursor neighborhood, then discovered callees
+        std::vector<graph_index_t> remaining;   // Everything else, nearest to the focus last
+        std::vector<std::uint8_t> scanned;
+        std::vector<graph_index_t> seen;        // Callees already recorded for current function
+        std::vector<std::pair<graph_index_t, graph_index_t>> edges;
+        std::size_t scanned_count = 0;
+        std::size_t published_edges = 0;
+        std::chrono::steady_clock::time_point last_publish;
+        std::chrono::steady_clock::duration publish_interval{};  // Grows with the cost of a publish
+    };
+    std::unique_ptr<ScanState> scan_;
 };
 
 } // namespace binary_map_3d
@@ -0,0 +1,163 @@
+/// @file treemap.hpp
+/// @brief Squarified treemap over grouped, weighted items (no IDA dependencies)
+///
+/// Items (functions) hang off a group tree (segment -> namespace -> class).
+/// A group's children are squarified the first time the group is drawn large
+/// enough to show them, and that layout is kept until the tree is rebuilt;
+/// metric changes only re-aggregate colors. Children are placed in strips of
+/// decreasing size, so drawing stops at the first strip that is off screen
+/// or too small and paints the rest of the group as one quad.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace binary_map_3d {
+
+/// Axis-aligned rectangle in treemap (world) coordinates
+struct TreemapRect {
+    float x0 = 0.0f;
+    float y0 = 0.0f;
+    float x1 = 0.0f;
+    float y1 = 0.0f;
+
+    [[nodiscard]] float width() const noexcept { return x1 - x0; }
+    [[nodiscard]] float height() const noexcept { return y1 - y0; }
+    [[nodiscard]] bool contains(float x, float y) const noexcept {
+        return x >= x0 && x < x1 && y >= y0 && y < y1;
+    }
+    [[nodiscard]] bool intersects(const TreemapRect& other) const noexcept {
+        return x0 < other.x1 && other.x0 < x1 && y0 < other.y1 && other.y0 < y1;
+    }
+};
+
+/// One quad to draw, produced by Treemap::collect()
+struct TreemapQuad {
+    enum class Kind : std::uint8_t {
+        Frame,  // Group whose children are drawn on top
+        Group,  // Group too small to open, painted with its aggregate
+        Item,   // Single item
+        Rest,   // Tail of a group's children too small to draw one by one
+    };
+
+    TreemapRect rect;
+    float value = 0.0f;   // Metric in [0, 1]; NaN if unknown
+    std::uint32_t ref = 0;  // Item index for Item, group id otherwise
+    std::uint16_t depth = 0;
+    Kind kind = Kind::Item;
+    std::uint32_t rest_items = 0;   // Rest: items merged into it
+    std::uint64_t rest_weight = 0;  // Rest: their total weight
+};
+
+/// @class Treemap
+/// @brief Group tree with lazily squarified, cached layout
+class Treemap {
+public:
+    using group_id = std::uint32_t;
+    static constexpr group_id ROOT = 0;
+    static constexpr group_id NO_GROUP = static_cast<group_id>(-1);
+    static constexpr std::uint32_t NO_ITEM = static_cast<std::uint32_t>(-1);
+
+    /// Root rectangle is [0, ROOT_ASPECT] x [0, 1]
+    static constexpr float ROOT_ASPECT = 1.6f;
+
+    struct Group {
+        std::string label;
+        group_id parent = NO_GROUP;
+        std::uint32_t depth = 0;
+        std::uint64_t weight = 0;
+        std::uint64_t largest = 0;   // Heaviest direct child
+        std::size_t item_count = 0;  // Items in the subtree
+        float value = std::numeric_limits<float>::quiet_NaN();  // Weighted mean of known values
+        TreemapRect rect;            // Set once the parent is laid out
+        std::vector<group_id> groups;
+        std::vector<std::uint32_t> items;
+    };
+
+    Treemap() { clear(); }
+
+    /// Drop everything but an empty root
+    void clear();
+
+    /// Find or create a child group
+    group_id child(group_id parent, std::string_view label);
+
+    /// Add an item (ids are dense, 0..n-1) to a group; weight 0 counts as 1
+    void add_item(group_id group, std::uint32_t item, std::uint64_t weight);
+
+    /// Set an item's metric in [0, 1] (NaN = unknown); colors only, no relayout
+    void set_value(std::uint32_t item, float value);
+
+    /// Quads for a viewport, parents before children
+    /// @param viewport Visible area in world coordinates
+    /// @param pixels_per_unit Screen pixels per world unit
+    /// @param min_pixels Children smaller than this (side length) are merged
+    void collect(const TreemapRect& viewport, float pixels_per_unit, float min_pixels,
+                 std::vector<TreemapQuad>& out);
+
+    /// Lay out the path down to an item and return its rectangle
+    [[nodiscard]] TreemapRect reveal(std::uint32_t item);
+
+    [[nodiscard]] const Group& group(group_id id) const { return groups_[id]; }
+    [[nodiscard]] std::size_t group_count() const noexcept { return groups_.size(); }
+    [[nodiscard]] std::size_t item_count() const noexcept { return item_group_.size(); }
+    [[nodiscard]] group_id item_group(std::uint32_t item) const { return item_group_[item]; }
+
+private:
+    static constexpr std::uint32_t GROUP_REF = 0x80000000u;
+
+    /// Fraction of a group's shorter side left as padding around its children
+    static constexpr float GROUP_PADDING = 0.02f;
+
+    /// Groups narrower than this many pixels are drawn closed, as are groups
+    /// whose heaviest child would be smaller than the merge size
+    static constexpr float MIN_OPEN_PIXELS = 12.0f;
+
+    /// Run of children laid along one side of the remaining area
+    struct Strip {
+        std::uint32_t first = 0;  // Index into Layout::refs
+        TreemapRect rest;         // Area of this strip and every later one
+        float rest_value = 0.0f;  // Weighted mean over first..end
+        std::uint32_t rest_items = 0;   // Items in first..end, counting group subtrees
+        std::uint64_t rest_weight = 0;  // Weight of first..end
+    };
+
+    struct Layout {
+        std::vector<std::uint32_t> refs;  // Items, or groups tagged with GROUP_REF
+        std::vector<TreemapRect> rects;
+        std::vector<Strip> strips;
+        std::uint64_t values_revision = 0;
+        bool built = false;
+    };
+
+    void layout(group_id id);
+    void update_values();
+    void update_strip_values(group_id id);
+
+    [[nodiscard]] std::uint64_t ref_weight(std::uint32_t ref) const;
+    [[nodiscard]] float ref_value(std::uint32_t ref) const;
+
+    std::vector<Group> groups_;
+    std::vector<Layout> layouts_;  // Per group
+    std::vector<std::unordered_map<std::string, group_id>> lookup_;  // Per group: label -> child
+
+    std::vector<group_id> item_group_;
+    std::vector<std::uint64_t> item_weight_;
+    std::vector<float> item_value_;
+    std::vector<std::uint32_t> item_slot_;  // Index in the group's layout, once built
+
+    bool values_dirty_ = false;
+    std::uint64_t values_revision_ = 1;
+};
+
+} // namespace binary_map_3d
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,135 @@
+/// @file treemap_view.hpp
+/// @brief Function treemap tab of the 3D binary map
+
+#pragma once
+
+#include "map_data.hpp"
+#include "treemap.hpp"
+#include <synopsia/common/color.hpp>
+#include <imgui.h>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace binary_map_3d {
+
+// Motif matches, in every view mode
+inline constexpr ImU32 MOTIF_MATCH_COLOR = IM_COL32(236, 96, 220, 255);
+inline constexpr ImU32 MOTIF_PICKED_COLOR = IM_COL32(255, 190, 250, 255);
+
+/// Per-function metric that colors the treemap
+enum class TreemapMetric : int {
+    Entropy = 0,
+    Complexity,
+    Centrality,
+};
+
+inline constexpr const char* TREEMAP_METRIC_NAMES[] = {
+    "Entropy",
+    "Complexity",
+    "Centrality"
+};
+inline constexpr int TREEMAP_METRIC_COUNT = 3;
+
+/// @class TreemapView
+/// @brief Segment -> namespace/class -> function treemap, area = function size
+///
+/// Covers the whole function catalog, not just the graph's node limit. The
+/// tree is built a slice per frame; entropy and complexity are measured
+/// lazily (visible functions first, then a background sweep) while
+/// centrality follows the call-graph scan.
+class TreemapView {
+public:
+    /// Forget the tree; it is rebuilt from the catalog on the next frame
+    void reset();
+
+    void render_controls();
+
+    /// Draw into the remaining content region
+    /// @param selected Function start to outline (BADADDR for none)
+    /// @param marks Per-function motif marks (0 none, 1 matched, 2 in the picked match)
+    /// @return Function start clicked this frame (BADADDR if none)
+    ea_t render(const BinaryMapData& data, ea_t selected, const std::vector<std::uint8_t>& marks);
+
+private:
+    /// Slice of the catalog grouped per frame, at 60 FPS
+    static constexpr std::chrono::milliseconds BUILD_BUDGET{8};
+
+    /// Entropy/complexity measurement per frame
+    static constexpr std::chrono::milliseconds MEASURE_BUDGET{3};
+
+    /// Measured values reach the treemap's aggregates this often (a full pass each)
+    static constexpr double FLUSH_INTERVAL = 0.25;
+
+    /// Cells smaller than this are merged into their group's remainder
+    static constexpr float MIN_CELL_PIXELS = 3.0f;
+
+    /// Beyond this, float world coordinates start to jitter on screen
+    static constexpr float MAX_ZOOM = 2000.0f;
+
+    static constexpr std::size_t QUADS_PER_BATCH = 8192;
+    static constexpr std::size_t MAX_ENTROPY_BYTES = 64 * 1024;
+    static constexpr double MAX_COMPLEXITY = 100.0;
+    static constexpr int MAX_LABELS = 400;
+    static constexpr std::uint64_t NO_GENERATION = static_cast<std::uint64_t>(-1);
+
+    bool pump_build(const BinaryMapData& data);
+
+    /// Push the selected metric's known values into the treemap
+    void apply_metric();
+
+    void update_metric(const BinaryMapData& data);
+
+    /// Size-weighted mean of the cached level-0 entropy blocks each function overlaps
+    static void load_cached_entropy(const BinaryMapData& data, std::vector<float>& values);
+
+    float measure_entropy(const FunctionNode& node);
+    static float measure_complexity(const FunctionNode& node);
+
+    ImU32 quad_color(const TreemapQuad& quad) const;
+
+    /// All quads through PrimRect in a few large reservations instead of one command per cell
+    template <typename ToScreen>
+    void draw_quads(ImDrawList* draw_list, const ToScreen& to_screen) const;
+
+    /// Outline visible functions that are part of a motif match
+    template <typename ToScreen>
+    void draw_marks(ImDrawList* draw_list, const std::vector<std::uint8_t>& marks, const ToScreen& to_screen) const;
+
+    template <typename ToScreen>
+    void draw_labels(ImDrawList* draw_list, const BinaryMapData& data, const ToScreen& to_screen,
+                     const ImVec2& canvas_min, const ImVec2& canvas_max) const;
+
+    void render_tooltip(const BinaryMapData& data, const TreemapQuad& quad) const;
+
+    Treemap treemap_;
+    std::vector<TreemapQuad> quads_;
+    ColorGradient gradient_ = ColorGradient::create_default();
+    TreemapMetric metric_ = TreemapMetric::Complexity;
+
+    // Progressive build
+    std::size_t build_cursor_ = 0;
+    bool built_ = false;
+    ea_t segment_start_ = BADADDR;
+    ea_t segment_end_ = BADADDR;
+    Treemap::group_id segment_group_ = Treemap::ROOT;
+
+    // Per metric, per function; NaN until measured
+    std::vector<float> values_[TREEMAP_METRIC_COUNT];
+    std::size_t measure_cursor_ = 0;
+    bool entropy_cached_ = false;
+    std::uint64_t centrality_generation_ = NO_GENERATION;
+    double last_flush_ = 0.0;
+    std::vector<std::uint8_t> bytes_;
+
+    // View
+    ImVec2 center_{Treemap::ROOT_ASPECT * 0.5f, 0.5f};
+    float zoom_ = 1.0f;
+    ImVec2 press_pos_{0, 0};
+};
+
+} // namespace binary_map_3d
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,88 @@
+/// @file call_tree.hpp
+/// @brief Lazily expanded callers/callees tree over a CallGraph (no IDA dependencies)
+///
+/// Expanded nodes point straight into the graph's CSR spans and only record
+/// which of their children are expanded in turn. Each node also knows how
+/// many rows its subtree shows, so a row index can be resolved by walking
+/// down the expanded nodes without ever flattening a hub's thousands of
+/// callers. Expanding or collapsing costs O(depth), whatever the fan-out.
+
+#pragma once
+
+#include <synopsia/common/call_graph.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+/// @class CallTree
+/// @brief "Callers" and "Callees" sections rooted at one function
+class CallTree {
+public:
+    using node_id = std::uint32_t;
+    static constexpr node_id NO_NODE = static_cast<node_id>(-1);
+
+    /// One visible row
+    struct Row {
+        graph_index_t function = GRAPH_NO_NODE;  // Section root for headers
+        GraphDirection direction = GraphDirection::Callers;
+        std::uint32_t depth = 0;       // 0 for section headers
+        node_id parent = NO_NODE;      // Expanded node owning this row
+        std::uint32_t slot = 0;        // Position among the parent's neighbors
+        node_id node = NO_NODE;        // Set if the row (or header's section) is expanded
+        std::size_t fan_out = 0;       // Neighbors in the row's direction
+        bool header = false;
+        bool cycle = false;            // Function already on the path from the root
+    };
+
+    /// Show root's callers and callees (O(1); keeps state if unchanged)
+    void set_root(std::shared_ptr<const CallGraph> graph, graph_index_t root);
+
+    [[nodiscard]] graph_index_t root() const noexcept { return root_; }
+    [[nodiscard]] bool empty() const noexcept { return !graph_ || root_ >= graph_->node_count(); }
+
+    /// Total visible rows (headers included)
+    [[nodiscard]] std::size_t row_count() const noexcept;
+
+    /// Resolve a row index; cost grows with depth and expanded siblings, not fan-out
+    [[nodiscard]] Row row(std::size_t index) const;
+
+    /// Expand or collapse the row (cycles and leaves never expand)
+    void toggle(const Row& row);
+
+private:
+    struct Node {
+        graph_index_t function = GRAPH_NO_NODE;
+        GraphDirection direction = GraphDirection::Callers;
+        node_id parent = NO_NODE;
+        std::uint32_t depth = 0;
+        std::span<const graph_index_t> children;             // CSR span, not copied
+        std::vector<std::pair<std::uint32_t, node_id>> expanded;  // (slot, node), sorted by slot
+        std::size_t visible = 0;                             // Rows below this node
+    };
+
+    [[nodiscard]] Row locate(node_id id, std::size_t index) const;
+    void expand(node_id parent, std::uint32_t slot);
+    void collapse(node_id id);
+    void add_visible(node_id id, std::ptrdiff_t delta);
+    [[nodiscard]] bool on_path(node_id id, graph_index_t function) const;
+    [[nodiscard]] Row make_row(node_id parent, std::uint32_t slot, node_id node) const;
+
+    std::shared_ptr<const CallGraph> graph_;
+    graph_index_t root_ = GRAPH_NO_NODE;
+    node_id sections_[2] = {NO_NODE, NO_NODE};  // Callers, Callees
+    bool section_open_[2] = {true, true};
+
+    std::vector<Node> nodes_;
+    std::vector<node_id> free_;
+};
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include "flow_layout.hpp"
+#include <synopsia/common/call_graph.hpp>
 #include <cstdint>
 #include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace synopsia {
@@ -27,6 +31,13 @@ struct FunctionInfo {
     }
 };
 
+/// Basic-block graph of a function without a layout, for thumbnails
+struct FlowOutline {
+    std::vector<std::uint32_t> block_sizes;        // Bytes; block 0 is the entry
+    std::vector<std::uint32_t> successor_offsets;  // CSR over blocks
+    std::vector<std::uint32_t> successors;
+};
+
 /// @class IFunctionDataSource
 /// @brief Abstract interface for function data source
 ///
@@ -45,6 +56,9 @@ public:
     /// Get function at index
     [[nodiscard]] virtual FunctionInfo get_function(std::size_t index) const = 0;
 
+    /// Name of the function at index, without copying (valid until the next refresh)
+    [[nodiscard]] virtual std::string_view function_name(std::size_t index) const = 0;
+
     /// Get disassembly for function at address
     [[nodiscard]] virtual std::string get_disassembly(func_addr_t address) const = 0;
 
@@ -55,13 +69,46 @@ public:
     [[nodiscard]] virtual bool has_decompiler() const = 0;
 
     /// Find function by name (returns FUNC_BADADDR if not found)
-    [[nodiscard]] virtual func_addr_t find_function_by_name(const std::string& name) const = 0;
+    [[nodiscard]] virtual func_addr_t find_function_by_name(std::string_view name) const = 0;
 
     /// Find function containing address (returns FUNC_BADADDR if not in any function)
     [[nodiscard]] virtual func_addr_t find_function_at(func_addr_t address) const = 0;
 
     /// Refresh function list from database
     virtual bool refresh() = 0;
+
+    /// Address of the function at index, without copying its names
+    [[nodiscard]] virtual func_addr_t function_address(std::size_t index) const { return get_function(index).address; }
+
+    /// Size in bytes of the function at index (0 if unknown)
+    [[nodiscard]] virtual std::uint64_t function_size(std::size_t /*index*/) const { return 0; }
+
+    /// Revision counter, bumped by refresh() and by every incremental rename
+    [[nodiscard]] virtual std::uint64_t revision() const { return 0; }
+
+    /// Collect indices of functions renamed after revision `since`
+    /// @return false if the change log does not reach back that far (reload everything)
+    [[nodiscard]] virtual bool renamed_since(std::uint64_t /*since*/, std::vector<std::size_t>& /*out*/) const {
+        return false;
+    }
+
+    /// Caller/callee adjacency over function indices, built once per refresh (nullptr if unavailable)
+    [[nodiscard]] virtual std::shared_ptr<const CallGraph> call_graph() const { return nullptr; }
+
+    /// Whether call_graph() returned nullptr only because it is still being built; poll again on later frames
+    [[nodiscard]] virtual bool call_graph_pending() const { return false; }
+
+    /// Basic-block graph layout of the function at address, computed in the background
+    /// @param out Set once the state is Ready
+    /// @return Pending until the layout is done; poll again on later frames
+    [[nodiscard]] virtual FlowLayoutState flow_layout(func_addr_t /*address*/,
+                                                      std::shared_ptr<const FlowLayout>& /*out*/) const {
+        return FlowLayoutState::Unavailable;
+    }
+
+    /// Blocks and edges of the function at address, read on the calling thread
+    /// @return false if unavailable (no function, or too large to outline quickly)
+    [[nodiscard]] virtual bool flow_outline(func_addr_t /*address*/, FlowOutline& /*out*/) const { return false; }
 };
 
 } // namespace function_search
@@ -53,6 +53,8 @@ public:
     // Feature-specific methods
     void refresh_data();
     void navigate_to(ea_t addr);
+    void on_function_renamed(ea_t addr);
+    void on_function_changed(ea_t addr);
 
     // Singleton accessor
     [[nodiscard]] static FunctionSearchFeature* instance() noexcept { return instance_; }
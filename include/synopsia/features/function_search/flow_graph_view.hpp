@@ -0,0 +1,43 @@
+/// @file flow_graph_view.hpp
+/// @brief Pan/zoom canvas for a FlowLayout (no IDA dependencies)
+
+#pragma once
+
+#include "flow_layout.hpp"
+#include <memory>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+/// @class FlowGraphView
+/// @brief Draws a function's basic-block graph in the binary map's DAG style
+///
+/// Only blocks and edges inside the canvas are submitted, and text and
+/// arrowheads are dropped once they would be unreadable. Zoomed-out graphs
+/// of thousands of blocks therefore stay within a few thousand draw calls.
+class FlowGraphView {
+public:
+    /// @brief Show a layout; pan and zoom are kept if it is the one already shown
+    void set_layout(std::shared_ptr<const FlowLayout> layout);
+
+    /// @brief Drop the layout
+    void reset();
+
+    /// @brief Draw into the remaining content region (drag pans, wheel zooms)
+    void render();
+
+private:
+    /// Zoom to show the whole graph, or its top around the entry if that is too small
+    void fit(float canvas_width, float canvas_height);
+
+    std::shared_ptr<const FlowLayout> layout_;
+    float zoom_ = 1.0f;
+    float origin_x_ = 0.0f;  // Layout point at the canvas' top-left corner
+    float origin_y_ = 0.0f;
+    bool fitted_ = false;
+};
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
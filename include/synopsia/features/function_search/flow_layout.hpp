@@ -0,0 +1,109 @@
+/// @file flow_layout.hpp
+/// @brief Laid-out basic-block graph of one function (no IDA dependencies)
+///
+/// Coordinates are layout pixels at zoom 1, as produced by the layered
+/// layout engine. Blocks are also indexed by their top edge, so a viewport
+/// query only touches the rows on screen, even for graphs with thousands of
+/// blocks.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+/// Progress of a background layout
+enum class FlowLayoutState : std::uint8_t {
+    Unavailable,  ///< No flow graph (no function, no data, or the layout failed)
+    Pending,      ///< Being laid out; poll again
+    Ready,
+};
+
+struct FlowPoint {
+    float x;
+    float y;
+};
+
+/// Basic block and its box
+struct FlowBlock {
+    std::uint64_t start;
+    std::uint64_t end;
+    std::uint32_t instructions;
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+/// Routed edge: points[first_point, first_point + point_count), with its bounds
+struct FlowEdge {
+    std::uint32_t from;
+    std::uint32_t to;
+    std::uint32_t first_point;
+    std::uint32_t point_count;
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+};
+
+/// @struct FlowLayout
+/// @brief Blocks, routed edges and the canvas they span
+struct FlowLayout {
+    std::vector<FlowBlock> blocks;  // blocks[0] is the entry
+    std::vector<FlowEdge> edges;
+    std::vector<FlowPoint> points;
+    float width = 0.0f;
+    float height = 0.0f;
+
+    /// @brief Build the viewport index (call once blocks and edges are final)
+    void finalize() {
+        by_top_.resize(blocks.size());
+        std::iota(by_top_.begin(), by_top_.end(), 0u);
+        std::sort(by_top_.begin(), by_top_.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return blocks[a].y < blocks[b].y;
+        });
+        max_block_height_ = 0.0f;
+        for (const FlowBlock& block : blocks) {
+            max_block_height_ = std::max(max_block_height_, block.height);
+        }
+    }
+
+    /// @brief Call fn(index) for every block overlapping [x0, x1] x [y0, y1]
+    template <typename Fn>
+    void for_each_block_in(float x0, float y0, float x1, float y1, Fn&& fn) const {
+        // Tops below y0 - tallest block cannot reach the viewport
+        auto it = std::lower_bound(by_top_.begin(), by_top_.end(), y0 - max_block_height_,
+                                   [&](std::uint32_t index, float top) { return blocks[index].y < top; });
+        for (; it != by_top_.end() && blocks[*it].y <= y1; ++it) {
+            const FlowBlock& block = blocks[*it];
+            if (block.y + block.height >= y0 && block.x <= x1 && block.x + block.width >= x0) {
+                fn(static_cast<std::size_t>(*it));
+            }
+        }
+    }
+
+    /// @brief Call fn(edge) for every edge whose bounds overlap [x0, x1] x [y0, y1]
+    template <typename Fn>
+    void for_each_edge_in(float x0, float y0, float x1, float y1, Fn&& fn) const {
+        for (const FlowEdge& edge : edges) {
+            if (edge.max_x >= x0 && edge.min_x <= x1 && edge.max_y >= y0 && edge.min_y <= y1) {
+                fn(edge);
+            }
+        }
+    }
+
+private:
+    std::vector<std::uint32_t> by_top_;  // Block indices by y
+    float max_block_height_ = 0.0f;
+};
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
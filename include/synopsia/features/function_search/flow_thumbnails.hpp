@@ -0,0 +1,110 @@
+/// @file flow_thumbnails.hpp
+/// @brief Atlas of tiny basic-block graph silhouettes for function rows (no IDA dependencies)
+
+#pragma once
+
+#include "data_interface.hpp"
+#include <imgui.h>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+/// @brief Uploads rows [first_row, first_row + row_count) of a width x height
+/// 0xAARRGGBB image and returns its texture (the first call uploads all rows)
+using ImageUploader = std::function<ImTextureID(const std::uint32_t* argb, int width, int height,
+                                                int first_row, int row_count)>;
+
+/// @class FlowThumbnails
+/// @brief Lazily generated CFG thumbnails packed into one texture atlas
+///
+/// Rows ask for their thumbnail while drawing. Missing ones are queued in
+/// the order asked, so the rows on screen come first and prefetched rows
+/// after them; the queue is rebuilt every frame, so rows scrolled past drop
+/// out. generate() works through the queue within a time slice and
+/// uploads only the atlas rows it touched. Tiles are recycled least
+/// recently drawn first. A row never waits: until its tile exists it
+/// simply has none.
+class FlowThumbnails {
+public:
+    static constexpr int TILE_WIDTH = 32;
+    static constexpr int TILE_HEIGHT = 16;
+    static constexpr int ATLAS_WIDTH = 512;
+    static constexpr int ATLAS_HEIGHT = 512;
+
+    FlowThumbnails();
+
+    /// @brief Draw the thumbnail of a function as one quad, queueing it if missing
+    /// @return false if it is not ready (nothing drawn)
+    bool draw(ImDrawList* draw_list, func_addr_t address, const ImVec2& min, const ImVec2& max);
+
+    /// @brief Queue a function that may scroll into view soon (after visible rows)
+    void prefetch(func_addr_t address);
+
+    /// @brief Outline and rasterize queued functions until the budget runs out, then upload
+    ///
+    /// At least one function is generated per call, so progress never stalls.
+    void generate(const IFunctionDataSource& data, const ImageUploader& upload, std::chrono::microseconds budget);
+
+    /// @brief Drop every thumbnail (functions changed)
+    void clear();
+
+    /// @brief Drop one function's thumbnail (its flow changed); it is regenerated when drawn
+    void invalidate(func_addr_t address);
+
+    /// @brief Rasterize an outline into a TILE_WIDTH x TILE_HEIGHT tile
+    /// @param stride Pixels per row of the destination
+    static void rasterize(const FlowOutline& outline, std::uint32_t* pixels, std::size_t stride);
+
+private:
+    static constexpr int TILE_COLUMNS = ATLAS_WIDTH / TILE_WIDTH;
+    static constexpr int TILE_COUNT = TILE_COLUMNS * (ATLAS_HEIGHT / TILE_HEIGHT);
+    static constexpr int NO_TILE = -1;
+    static constexpr std::size_t MAX_WANTED = 256;         // Queued per frame
+    static constexpr std::size_t MAX_ENTRIES = 1u << 16;  // Before functions without outlines are forgotten
+
+    /// Generated thumbnail; tile stays NO_TILE if the function has no outline
+    struct Entry {
+        int tile = NO_TILE;
+    };
+
+    /// Tiles form an intrusive LRU list, most recently drawn at the head
+    struct Tile {
+        func_addr_t owner = FUNC_BADADDR;
+        int prev = NO_TILE;
+        int next = NO_TILE;
+    };
+
+    void request(func_addr_t address);
+    void touch(int tile);
+    void unlink(int tile);
+    void push_front(int tile);
+    void push_back(int tile);
+
+    /// Least recently drawn tile, released from its previous owner
+    int take_tile();
+
+    std::unordered_map<func_addr_t, Entry> entries_;
+    std::vector<Tile> tiles_;
+    int head_ = NO_TILE;
+    int tail_ = NO_TILE;
+    int next_free_ = 0;  // Tiles below this have been handed out
+
+    std::vector<func_addr_t> wanted_;  // This frame's misses, visible rows first
+    std::vector<std::uint32_t> pixels_;  // Atlas, 0xAARRGGBB
+    FlowOutline outline_;                // Reused between functions
+    ImTextureID texture_{};
+    int dirty_first_ = ATLAS_HEIGHT;     // Atlas rows to upload
+    int dirty_last_ = 0;
+    bool uploaded_ = false;              // Whole atlas is on the GPU
+};
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
@@ -4,8 +4,11 @@
 #pragma once
 
 #include "data_interface.hpp"
+#include "layout_cache.hpp"
 #include <synopsia/common/types.hpp>
+#include <chrono>
 #include <unordered_map>
+#include <utility>
 
 namespace synopsia {
 namespace features {
@@ -28,29 +31,93 @@ public:
     [[nodiscard]] bool is_valid() const override { return valid_; }
     [[nodiscard]] std::size_t function_count() const override { return functions_.size(); }
     [[nodiscard]] FunctionInfo get_function(std::size_t index) const override;
+    [[nodiscard]] std::string_view function_name(std::size_t index) const override;
     [[nodiscard]] std::string get_disassembly(func_addr_t address) const override;
     [[nodiscard]] std::string get_decompilation(func_addr_t address) const override;
     [[nodiscard]] bool has_decompiler() const override;
-    [[nodiscard]] func_addr_t find_function_by_name(const std::string& name) const override;
+    [[nodiscard]] func_addr_t find_function_by_name(std::string_view name) const override;
     [[nodiscard]] func_addr_t find_function_at(func_addr_t address) const override;
     bool refresh() override;
+    [[nodiscard]] func_addr_t function_address(std::size_t index) const override;
+    [[nodiscard]] std::uint64_t function_size(std::size_t index) const override;
+    [[nodiscard]] std::uint64_t revision() const override { return revision_; }
+    [[nodiscard]] bool renamed_since(std::uint64_t since, std::vector<std::size_t>& out) const override;
+    [[nodiscard]] std::shared_ptr<const CallGraph> call_graph() const override;
+    [[nodiscard]] bool call_graph_pending() const override { return call_graph_pending_; }
+    [[nodiscard]] FlowLayoutState flow_layout(func_addr_t address,
+                                              std::shared_ptr<const FlowLayout>& out) const override;
+    [[nodiscard]] bool flow_outline(func_addr_t address, FlowOutline& out) const override;
+
+    /// Re-read the names of the function starting at address after a rename
+    /// @return true if a listed function was updated
+    bool update_name(ea_t address);
+
+    /// Persist demangled names into the IDB analysis cache
+    /// (addresses and names are shared with the call-graph sections)
+    bool store_cache() const;
 
 private:
+    /// Load function list from the IDB analysis cache
+    bool load_cache();
+
+    /// Load function list from the snapshot file next to the IDB
+    bool load_snapshot();
+
     struct FunctionEntry {
         ea_t address;
         qstring name;
         qstring demangled_name;
+        std::uint64_t size = 0;
+    };
+
+    /// Oldest renames are dropped past this; readers then reload everything
+    static constexpr std::size_t MAX_RENAME_LOG = 4096;
+
+    std::vector<FunctionEntry> functions_;  // Sorted by address
+    /// Transparent hash: lookups by string_view do not build a std::string
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
     };
 
-    std::vector<FunctionEntry> functions_;
-    std::unordered_map<std::string, func_addr_t> name_to_addr_;
+    std::unordered_map<std::string, func_addr_t, NameHash, std::equal_to<>> name_to_addr_;
     bool valid_ = false;
+
+    /// Built on first use after each refresh, from the shared query snapshot
+    mutable std::shared_ptr<const CallGraph> call_graph_;
+    mutable bool call_graph_pending_ = false;  // Query snapshot rebuild under way
+
+    /// Query snapshot rebuild time per call_graph() call
+    static constexpr std::chrono::milliseconds CALL_GRAPH_BUDGET{8};
+
+    /// Basic-block graph layouts, laid out on demand
+    mutable FlowLayoutCache flow_layouts_;
+
+    std::uint64_t revision_ = 0;
+    std::uint64_t log_start_ = 0;  // Renames after this revision are all in renames_
+    std::vector<std::pair<std::uint64_t, std::size_t>> renames_;  // (revision, index)
 };
 
 // =============================================================================
 // Inline Implementation
 // =============================================================================
 
+inline func_addr_t FunctionData::function_address(std::size_t index) const {
+    return index < functions_.size() ? static_cast<func_addr_t>(functions_[index].address) : FUNC_BADADDR;
+}
+
+inline std::uint64_t FunctionData::function_size(std::size_t index) const {
+    return index < functions_.size() ? functions_[index].size : 0;
+}
+
+inline std::string_view FunctionData::function_name(std::size_t index) const {
+    if (index >= functions_.size()) {
+        return {};
+    }
+    const auto& name = functions_[index].name;
+    return {name.c_str(), name.length()};
+}
+
 inline FunctionInfo FunctionData::get_function(std::size_t index) const {
     if (index >= functions_.size()) {
         return {FUNC_BADADDR, "", ""};
@@ -0,0 +1,101 @@
+/// @file layout_cache.hpp
+/// @brief Background basic-block graph layouts, cached per function
+
+#pragma once
+
+#include "flow_layout.hpp"
+#include <synopsia/common/types.hpp>
+#include <funcs.hpp>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+/// @class FlowLayoutCache
+/// @brief Lays out function flow charts on a worker thread, reusing earlier results
+///
+/// The flow chart is read on the main thread. The layered layout (the same
+/// engine the binary map's DAG mode uses) runs on a worker. Results are
+/// keyed by function and stamped with a signature of the chart's blocks and
+/// edges, so an edited function is laid out again while untouched ones are
+/// not. Layouts of large functions are also written to the IDB.
+///
+/// A layout cannot be interrupted once started. Functions are capped in
+/// block count so one layout stays short, and destroying the cache drops
+/// the queue and joins the worker after the layout it is running.
+class FlowLayoutCache {
+public:
+    FlowLayoutCache() = default;
+    ~FlowLayoutCache();
+
+    // Non-copyable
+    FlowLayoutCache(const FlowLayoutCache&) = delete;
+    FlowLayoutCache& operator=(const FlowLayoutCache&) = delete;
+
+    /// @brief Layout of the function containing address (main thread)
+    ///
+    /// Only the latest request waits for the worker; older queued ones are
+    /// dropped, so hovering down a list of functions stays cheap.
+    FlowLayoutState get(ea_t address, std::shared_ptr<const FlowLayout>& out);
+
+    /// @brief Drop the in-memory layouts and any queued or running one (persisted ones stay)
+    void clear();
+
+private:
+    /// Flow chart handed to the worker, and its result
+    struct Job {
+        ea_t function = BADADDR;
+        std::uint64_t generation = 0;                  // clear() count when queued
+        std::uint64_t signature = 0;
+        std::shared_ptr<FlowLayout> layout;           // Blocks sized, not yet placed
+        std::vector<std::uint32_t> successor_offsets;  // CSR over blocks
+        std::vector<std::uint32_t> successors;
+        bool failed = false;
+    };
+
+    struct Entry {
+        std::uint64_t signature = 0;
+        std::shared_ptr<const FlowLayout> layout;  // nullptr if the layout failed
+        std::uint64_t last_used = 0;
+        bool fresh = false;  // Just collected; the next get() skips the signature check
+    };
+
+    /// Read the function's flow chart into a job (main thread)
+    static bool read_chart(func_t* func, Job& job);
+
+    /// Place blocks and route edges (worker)
+    static void lay_out(Job& job);
+
+    /// Queue shared by the cache and its worker thread
+    struct WorkerState {
+        std::mutex mutex;  // Guards everything below
+        std::condition_variable wake;
+        bool cancelled = false;        // Cache destroyed: exit, dropping any result
+        std::uint64_t generation = 0;  // Results from an older generation are dropped
+        std::unique_ptr<Job> queued;   // Latest request
+        ea_t running = BADADDR;
+        std::vector<std::unique_ptr<Job>> finished;
+    };
+
+    /// Move finished jobs into the cache
+    void collect();
+
+    void remember(ea_t function, std::uint64_t signature, std::shared_ptr<const FlowLayout> layout, bool fresh);
+    static void worker_loop(std::shared_ptr<WorkerState> state);
+
+    std::unordered_map<ea_t, Entry> entries_;  // Main thread only
+    std::uint64_t clock_ = 0;
+
+    std::shared_ptr<WorkerState> state_ = std::make_shared<WorkerState>();
+    std::thread worker_;
+};
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,24 @@
+/// @file name_filter.hpp
+/// @brief Case-insensitive substring filter over function names (no IDA dependencies)
+
+#pragma once
+
+#include "data_interface.hpp"
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+/// @brief Whether text contains needle, ignoring ASCII case (needle already lowercase)
+[[nodiscard]] bool contains_lowercase(std::string_view text, std::string_view needle_lower) noexcept;
+
+/// @brief Collect indices of functions whose name contains `filter` (ASCII case-insensitive)
+/// @param out Cleared, then filled in index order
+void filter_functions(const IFunctionDataSource& data, std::string_view filter, std::vector<std::size_t>& out);
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
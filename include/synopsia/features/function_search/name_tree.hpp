@@ -0,0 +1,129 @@
+/// @file name_tree.hpp
+/// @brief Lazily built namespace/class tree over demangled names (no IDA dependencies)
+///
+/// Every function gets a path key from its demangled name ("ns::Class::method"
+/// becomes {"ns", "Class", "method"}). Functions are sorted by key once, so
+/// every tree node is a contiguous range of that order; counts and sizes fall
+/// out of the range and children are only materialized when a node is first
+/// expanded. Visible rows are kept flat for an ImGuiListClipper.
+
+#pragma once
+
+#include "data_interface.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+/// Split a (demangled) name into its qualified path
+/// Return types, calling conventions and parameter lists are dropped;
+/// templates, "(anonymous namespace)" and operators stay within one token.
+/// @param tail Receives the text after the qualified name ("(int) const")
+[[nodiscard]] std::vector<std::string_view> split_qualified_name(std::string_view name,
+                                                                 std::string_view* tail = nullptr);
+
+/// @class NameTree
+/// @brief Namespace -> class -> method tree over an IFunctionDataSource
+class NameTree {
+public:
+    using node_id = std::uint32_t;
+    static constexpr node_id ROOT = 0;
+    static constexpr std::size_t NO_FUNCTION = static_cast<std::size_t>(-1);
+
+    struct Node {
+        std::string label;
+        std::string key;                     // Path tokens joined by KEY_SEPARATOR
+        std::uint32_t begin = 0;             // Range in the sorted order
+        std::uint32_t end = 0;
+        std::uint32_t depth = 0;             // Path tokens consumed (root: 0)
+        std::uint64_t size = 0;              // Summed function sizes
+        std::size_t function = NO_FUNCTION;  // Set on leaves
+        std::vector<node_id> children;       // Valid once materialized
+        bool materialized = false;
+        bool expanded = false;
+
+        [[nodiscard]] std::size_t count() const noexcept { return end - begin; }
+        [[nodiscard]] bool is_leaf() const noexcept { return function != NO_FUNCTION; }
+    };
+
+    /// @param data Name store; must outlive the tree
+    explicit NameTree(const IFunctionDataSource& data) : data_(data) {}
+
+    /// Re-key every function (O(n log n)); only the root is materialized
+    void build();
+
+    /// Catch up with the data source (renames are applied incrementally)
+    /// @return true if the tree changed
+    bool sync();
+
+    [[nodiscard]] bool is_built() const noexcept { return !nodes_.empty(); }
+    [[nodiscard]] const Node& node(node_id id) const { return nodes_[id]; }
+
+    /// Expanded tree, depth first, root excluded
+    [[nodiscard]] const std::vector<node_id>& rows();
+
+    void set_expanded(node_id id, bool expanded);
+    void toggle(node_id id) { set_expanded(id, !nodes_[id].expanded); }
+
+    /// Expand the path down to a function's leaf
+    /// @return Row index of the leaf (-1 if unknown)
+    int reveal(std::size_t function);
+
+private:
+    static constexpr char KEY_SEPARATOR = '\x01';
+
+    /// Renames applied one by one per sync; more than this rebuilds
+    static constexpr std::size_t MAX_INCREMENTAL_RENAMES = 64;
+
+    /// build(), keeping the visible expanded scopes expanded
+    void rebuild();
+
+    /// Expand from the root towards the entry at position; stops at a leaf
+    /// or once a node's key reaches max_key_length
+    node_id descend(std::uint32_t position, std::size_t max_key_length);
+
+    /// Key of a function's path and the label of its leaf
+    void make_key(std::size_t function);
+
+    /// Position of a function in order_ (its key must be current)
+    [[nodiscard]] std::uint32_t position_of(std::size_t function) const;
+
+    /// Children of id from its range; existing children with the same key are kept
+    void materialize(node_id id);
+
+    /// Re-key one function and refresh the materialized nodes along its paths
+    void rename(std::size_t function);
+
+    /// Shift the children's ranges after one entry moved from old_pos to new_pos
+    /// @param new_key Key of the moved entry if it landed inside id
+    void shift_ranges(node_id id, std::uint32_t old_pos, std::uint32_t new_pos, const std::string* new_key);
+
+    /// Fix counts, sizes and labels of the children on a renamed function's
+    /// old/new path, re-materializing id if its set of children changed
+    void update_path_children(node_id id, const std::string* old_key, const std::string* new_key,
+                              std::size_t function, std::uint64_t size);
+
+    node_id allocate();
+    void release(node_id id);
+
+    const IFunctionDataSource& data_;
+    std::uint64_t revision_ = 0;
+
+    std::vector<std::string> keys_;         // Per function
+    std::vector<std::string> leaf_labels_;  // Per function: last token + tail
+    std::vector<std::uint32_t> order_;      // Function indices sorted by key
+
+    std::vector<Node> nodes_;
+    std::vector<node_id> free_;
+    std::vector<node_id> rows_;
+    bool rows_dirty_ = true;
+};
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
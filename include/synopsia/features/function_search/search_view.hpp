@@ -0,0 +1,59 @@
+/// @file search_view.hpp
+/// @brief ImGui function browser over an IFunctionDataSource (no IDA dependencies)
+///
+/// Shared by the in-IDA Function Search widget (backed by FunctionData) and
+/// the standalone snapshot viewer (backed by a mapped snapshot file).
+
+#pragma once
+
+#include "data_interface.hpp"
+#include "flow_thumbnails.hpp"
+#include <functional>
+#include <memory>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+/// @class FunctionSearchView
+/// @brief Filterable function list with disassembly/decompilation details
+class FunctionSearchView {
+public:
+    /// @param data Data source; must outlive the view
+    explicit FunctionSearchView(IFunctionDataSource& data);
+    ~FunctionSearchView();
+
+    // Non-copyable
+    FunctionSearchView(const FunctionSearchView&) = delete;
+    FunctionSearchView& operator=(const FunctionSearchView&) = delete;
+
+    /// Reload the data source and reset cached filter results
+    void refresh();
+
+    /// Forget what is cached about one function's flow (its blocks changed)
+    void invalidate_function(func_addr_t address);
+
+    /// Render as a fullscreen ImGui window (call between NewFrame and Render)
+    void render();
+
+    /// Navigation history
+    void navigate_back();
+    void navigate_forward();
+
+    /// Select the function starting at address (no-op if unknown)
+    void select_function(func_addr_t address);
+
+    /// Called with the address whenever the selected function changes
+    void set_selection_callback(std::function<void(func_addr_t)> callback);
+
+    /// Enables CFG thumbnails in the function list, uploaded through this
+    void set_image_uploader(ImageUploader upload);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,72 @@
+/// @file feature.hpp
+/// @brief Omnibox feature: one search box over names, strings, comments and imports
+
+#pragma once
+
+#include <synopsia/core/feature_base.hpp>
+#include <synopsia/common/types.hpp>
+
+namespace synopsia {
+namespace features {
+
+/// Feature constants
+namespace omnibox {
+inline constexpr const char* FEATURE_ID = "omnibox";
+inline constexpr const char* FEATURE_NAME = "Omnibox";
+inline constexpr const char* FEATURE_DESCRIPTION = "Search names, strings, comments, imports and exports at once";
+inline constexpr const char* FEATURE_HOTKEY = "Alt+Shift+F";
+inline constexpr const char* ACTION_NAME = "synopsia:omnibox";
+inline constexpr const char* ACTION_LABEL = "Omnibox Search";
+inline constexpr const char* WIDGET_TITLE = "Omnibox";
+} // namespace omnibox
+
+/// @class OmniboxFeature
+/// @brief Omnibox feature implementation
+class OmniboxFeature : public FeatureBase {
+public:
+    OmniboxFeature();
+    ~OmniboxFeature() override;
+
+    // IFeature interface
+    [[nodiscard]] const char* id() const noexcept override {
+        return omnibox::FEATURE_ID;
+    }
+    [[nodiscard]] const char* name() const noexcept override {
+        return omnibox::FEATURE_NAME;
+    }
+    [[nodiscard]] const char* description() const noexcept override {
+        return omnibox::FEATURE_DESCRIPTION;
+    }
+    [[nodiscard]] const char* hotkey() const noexcept override {
+        return omnibox::FEATURE_HOTKEY;
+    }
+
+    bool initialize() override;
+    void cleanup() override;
+    void show() override;
+    void hide() override;
+
+    void on_database_closed() override;
+
+    // Singleton accessor
+    [[nodiscard]] static OmniboxFeature* instance() noexcept { return instance_; }
+
+private:
+    bool create_widget();
+    void destroy_widget();
+    bool register_actions();
+    void unregister_actions();
+
+    static OmniboxFeature* instance_;
+};
+
+/// @class OmniboxAction
+/// @brief Action handler for showing the omnibox
+class OmniboxAction : public action_handler_t {
+public:
+    int idaapi activate(action_activation_ctx_t* ctx) override;
+    action_state_t idaapi update(action_update_ctx_t* ctx) override;
+};
+
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,20 @@
+/// @file providers.hpp
+/// @brief IDA database search providers for the omnibox
+
+#pragma once
+
+#include "search_engine.hpp"
+
+namespace synopsia {
+namespace features {
+namespace omnibox {
+
+/// @brief One provider per searchable source in the current database
+///
+/// Function names, demangled names, exports, imports, local labels,
+/// segment names, strings and comments. All collect on the main thread.
+[[nodiscard]] std::vector<std::unique_ptr<ISearchProvider>> create_database_providers();
+
+} // namespace omnibox
+} // namespace features
+} // namespace synopsia
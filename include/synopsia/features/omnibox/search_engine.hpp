@@ -0,0 +1,195 @@
+/// @file search_engine.hpp
+/// @brief Multi-provider search engine for the omnibox (no IDA dependencies)
+///
+/// Each provider contributes one kind of searchable text (function names,
+/// strings, comments, ...). Providers collect raw entries on the main thread
+/// in time-sliced steps; indexing and querying run on worker threads. A new
+/// query cancels the one in flight, and each provider streams its current
+/// top-K into a merged, ranked result list.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace omnibox {
+
+using search_addr_t = std::uint64_t;
+inline constexpr search_addr_t SEARCH_BADADDR = static_cast<search_addr_t>(-1);
+
+/// Source of a search entry (also orders ties between equal matches)
+enum class SearchKind : std::uint8_t {
+    Function,
+    Demangled,
+    Export,
+    Import,
+    Label,
+    Segment,
+    String,
+    Comment,
+};
+
+/// Short display tag for a kind ("func", "str", ...)
+[[nodiscard]] const char* search_kind_tag(SearchKind kind) noexcept;
+
+/// One ranked match
+struct SearchResult {
+    SearchKind kind;
+    search_addr_t address;
+    std::string text;
+    std::int32_t score;
+};
+
+/// @class SearchIndexBuilder
+/// @brief Raw entries collected by a provider
+class SearchIndexBuilder {
+public:
+    void add(search_addr_t address, std::string_view text);
+
+    [[nodiscard]] std::size_t size() const noexcept { return addresses_.size(); }
+    void clear();
+
+private:
+    friend class SearchIndex;
+    std::vector<search_addr_t> addresses_;
+    std::vector<std::uint32_t> offsets_{0};
+    std::string text_;
+};
+
+/// @class SearchIndex
+/// @brief Immutable per-provider index
+///
+/// Text is kept in one arena next to a case-folded copy. Each entry also
+/// carries a 64-bit character-class mask, so entries that cannot contain the
+/// needle are rejected without touching their text.
+class SearchIndex {
+public:
+    /// Build from collected entries (any thread; consumes the builder)
+    explicit SearchIndex(SearchIndexBuilder&& builder);
+
+    [[nodiscard]] std::size_t size() const noexcept { return addresses_.size(); }
+    [[nodiscard]] search_addr_t address(std::size_t i) const noexcept { return addresses_[i]; }
+    [[nodiscard]] std::string_view text(std::size_t i) const noexcept;
+    [[nodiscard]] std::string_view folded(std::size_t i) const noexcept;
+    [[nodiscard]] std::uint64_t mask(std::size_t i) const noexcept { return masks_[i]; }
+
+    /// Character-class mask of a (folded) string
+    [[nodiscard]] static std::uint64_t mask_of(std::string_view folded) noexcept;
+
+private:
+    std::vector<search_addr_t> addresses_;
+    std::vector<std::uint32_t> offsets_;
+    std::vector<std::uint64_t> masks_;
+    std::string text_;
+    std::string folded_;
+};
+
+/// @class ISearchProvider
+/// @brief One searchable source
+class ISearchProvider {
+public:
+    virtual ~ISearchProvider() = default;
+
+    [[nodiscard]] virtual SearchKind kind() const noexcept = 0;
+    [[nodiscard]] virtual const char* name() const noexcept = 0;
+
+    /// Start a new collection pass (main thread)
+    virtual void reset() = 0;
+
+    /// Collect entries until done or past the deadline (main thread)
+    /// @return true once every entry has been added
+    virtual bool collect(SearchIndexBuilder& out, std::chrono::steady_clock::time_point deadline) = 0;
+};
+
+/// @class SearchEngine
+/// @brief Provider indexes, worker pool and cancellable query fan-out
+class SearchEngine {
+public:
+    /// @param providers Search sources
+    /// @param top_k Results kept per provider
+    explicit SearchEngine(std::vector<std::unique_ptr<ISearchProvider>> providers, std::size_t top_k = 256);
+    ~SearchEngine();
+
+    // Non-copyable
+    SearchEngine(const SearchEngine&) = delete;
+    SearchEngine& operator=(const SearchEngine&) = delete;
+
+    /// Drop all indexes and collect them again (main thread)
+    void rebuild();
+
+    /// Advance index collection for up to budget (main thread)
+    /// @return true once every provider has been collected
+    bool pump(std::chrono::milliseconds budget);
+
+    /// Start a query; cancels the previous one. Empty clears the results.
+    void submit(std::string_view query);
+
+    /// Merged results of the current query so far, best first
+    /// @return true if out was updated since the last call
+    bool poll(std::vector<SearchResult>& out);
+
+    /// Whether any provider is still working on the current query
+    [[nodiscard]] bool is_searching() const;
+
+    /// Provider status for display
+    struct ProviderStatus {
+        const char* name;
+        std::size_t entries;  // Collected so far, or indexed once ready
+        bool ready;
+    };
+    [[nodiscard]] std::vector<ProviderStatus> status() const;
+
+private:
+    struct Task {
+        enum class Type { Index, Query } type;
+        std::size_t provider;
+        std::uint64_t generation;  // Query generation or index epoch
+        std::shared_ptr<SearchIndexBuilder> entries;
+    };
+
+    struct Slot {
+        std::unique_ptr<ISearchProvider> provider;
+        SearchIndexBuilder pending;         // Main-thread collection buffer
+        bool collected = false;
+        std::shared_ptr<const SearchIndex> index;
+        std::vector<SearchResult> results;  // Top-K for results_generation
+        std::uint64_t results_generation = 0;
+        bool results_done = true;
+    };
+
+    void worker_loop();
+    void run_index(const Task& task);
+    void run_query(const Task& task);
+    void enqueue(Task task);
+
+    std::vector<Slot> slots_;
+    std::size_t top_k_;
+
+    mutable std::mutex mutex_;  // Guards slots_ index/results, query_, tasks_
+    std::condition_variable wake_;
+    std::deque<Task> tasks_;
+    std::vector<std::thread> workers_;
+    bool stopping_ = false;
+
+    std::string query_;
+    std::atomic<std::uint64_t> generation_{0};  // Bumped per query; workers poll it to cancel
+    std::uint64_t epoch_ = 0;                    // Bumped per rebuild
+    std::uint64_t version_ = 0;                  // Bumped whenever any slot's results change
+    std::uint64_t polled_version_ = 0;
+};
+
+} // namespace omnibox
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,72 @@
+/// @file feature.hpp
+/// @brief Self-similarity feature: dot-plot of which regions repeat which
+
+#pragma once
+
+#include <synopsia/core/feature_base.hpp>
+#include <synopsia/common/types.hpp>
+
+namespace synopsia {
+namespace features {
+
+/// Feature constants
+namespace self_similarity {
+inline constexpr const char* FEATURE_ID = "self_similarity";
+inline constexpr const char* FEATURE_NAME = "Self-Similarity";
+inline constexpr const char* FEATURE_DESCRIPTION = "Dot-plot of duplicated code, repeated tables and unrolled data";
+inline constexpr const char* FEATURE_HOTKEY = "Alt+Shift+D";
+inline constexpr const char* ACTION_NAME = "synopsia:self_similarity";
+inline constexpr const char* ACTION_LABEL = "Self-Similarity Plot";
+inline constexpr const char* WIDGET_TITLE = "Self-Similarity";
+} // namespace self_similarity
+
+/// @class SelfSimilarityFeature
+/// @brief Self-similarity dot-plot feature implementation
+class SelfSimilarityFeature : public FeatureBase {
+public:
+    SelfSimilarityFeature();
+    ~SelfSimilarityFeature() override;
+
+    // IFeature interface
+    [[nodiscard]] const char* id() const noexcept override {
+        return self_similarity::FEATURE_ID;
+    }
+    [[nodiscard]] const char* name() const noexcept override {
+        return self_similarity::FEATURE_NAME;
+    }
+    [[nodiscard]] const char* description() const noexcept override {
+        return self_similarity::FEATURE_DESCRIPTION;
+    }
+    [[nodiscard]] const char* hotkey() const noexcept override {
+        return self_similarity::FEATURE_HOTKEY;
+    }
+
+    bool initialize() override;
+    void cleanup() override;
+    void show() override;
+    void hide() override;
+
+    void on_database_closed() override;
+
+    // Singleton accessor
+    [[nodiscard]] static SelfSimilarityFeature* instance() noexcept { return instance_; }
+
+private:
+    bool create_widget();
+    void destroy_widget();
+    bool register_actions();
+    void unregister_actions();
+
+    static SelfSimilarityFeature* instance_;
+};
+
+/// @class SelfSimilarityAction
+/// @brief Action handler for showing the self-similarity plot
+class SelfSimilarityAction : public action_handler_t {
+public:
+    int idaapi activate(action_activation_ctx_t* ctx) override;
+    action_state_t idaapi update(action_update_ctx_t* ctx) override;
+};
+
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,119 @@
+/// @file similarity_data.hpp
+/// @brief Block sketches of the database for the self-similarity plot
+
+#pragma once
+
+#include <synopsia/common/types.hpp>
+#include <synopsia/dot_plot.hpp>
+
+#include <chrono>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace synopsia {
+namespace features {
+namespace self_similarity {
+
+/// @class SimilarityData
+/// @brief Sketch pyramid over the readable segments, built a few windows per frame
+///
+/// Bytes are read on the main thread (IDA APIs are main-thread only) and
+/// sketched on worker threads. Zooming in needs no new sketches until the
+/// base blocks grow wider than a couple of pixels; from there only the
+/// bytes around the visible window are sketched again, at a finer block
+/// size, within the same per-frame budget.
+class SimilarityData {
+public:
+    SimilarityData() = default;
+    ~SimilarityData() = default;
+
+    // Non-copyable
+    SimilarityData(const SimilarityData&) = delete;
+    SimilarityData& operator=(const SimilarityData&) = delete;
+
+    /// Start sketching the database (main thread)
+    /// @return true if there are readable bytes
+    bool begin_refresh();
+
+    /// Sketch windows of bytes for up to budget, then build the pyramid (main thread)
+    /// @return true once the pyramid is complete
+    bool build_step(std::chrono::milliseconds budget);
+
+    /// Whether the pyramid is built
+    [[nodiscard]] bool is_complete() const { return !build_ && !pyramid_.empty(); }
+
+    /// Fraction of bytes sketched [0, 1]
+    [[nodiscard]] float build_progress() const;
+
+    /// Get the sketch pyramid (empty until complete)
+    [[nodiscard]] const SketchPyramid& pyramid() const { return pyramid_; }
+
+    /// Blocks to rasterize a window with (main thread)
+    ///
+    /// Returns the pyramid level whose blocks are about a pixel long, or
+    /// finer sketches of the window's surroundings once the base blocks
+    /// would span several pixels. Those are sketched for up to budget per
+    /// call; until they are done the base level is returned.
+    [[nodiscard]] std::span<const BlockSketch> blocks_for(const DotPlotWindow& window, int width, int height,
+                                                          std::chrono::milliseconds budget);
+
+    /// Whether the last blocks_for() fell back to the base level while sketching
+    [[nodiscard]] bool detail_pending() const { return detail_build_.active(); }
+
+    /// Block size of the last blocks_for() result
+    [[nodiscard]] data_size_t plotted_block_size() const { return plotted_block_size_; }
+
+    /// Release everything (database closed)
+    void clear();
+
+private:
+    /// Read [ea, ea + size) and append sketches of block-sized pieces
+    void sketch_window(ea_t ea, std::size_t size, std::size_t block_size, data_size_t position,
+                       std::vector<BlockSketch>& out);
+
+    /// Finer sketches of up to two plot ranges, built a few base-block runs per call
+    struct DetailBuild {
+        static constexpr std::size_t NOT_STARTED = static_cast<std::size_t>(-1);
+
+        std::vector<BlockSketch> blocks;
+        std::size_t block_size = 0;  // 0 = idle
+        DotPlotWindow cover;
+        std::pair<data_size_t, data_size_t> ranges[2];
+        std::size_t range_count = 0;
+        std::size_t range = 0;             // Next range to sketch
+        std::size_t next = NOT_STARTED;    // Next base block of that range
+
+        [[nodiscard]] bool active() const { return block_size != 0; }
+    };
+
+    /// Re-sketch the base blocks overlapping the build's ranges at its block size
+    /// @return true once every range is sketched
+    bool sketch_detail(DetailBuild& build, std::chrono::steady_clock::time_point deadline);
+
+    SketchPyramid pyramid_;
+    std::vector<std::uint8_t> buffer_;
+
+    /// Finer sketches around the last deep-zoom window
+    std::vector<BlockSketch> detail_;
+    std::size_t detail_block_size_ = 0;
+    DotPlotWindow detail_cover_;
+    DetailBuild detail_build_;
+    data_size_t plotted_block_size_ = 0;
+
+    /// Progressive build state (released once complete)
+    struct BuildState {
+        std::vector<std::pair<ea_t, ea_t>> segments;  // Readable segments in address order
+        std::size_t segment = 0;
+        ea_t next = BADADDR;
+        data_size_t position = 0;
+        data_size_t total = 0;
+        std::size_t block_size = 0;
+        std::vector<BlockSketch> base;
+    };
+    std::unique_ptr<BuildState> build_;
+};
+
+} // namespace self_similarity
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,16 @@
+/// @file allocation_panel.hpp
+/// @brief ImGui diagnostics window for the allocation tracker (no IDA or Qt dependencies)
+
+#pragma once
+
+namespace synopsia {
+namespace imgui {
+
+/// @brief Draw the allocation table (one row per feature and phase)
+///
+/// Only hosts that link the allocation hooks show it (AllocationCounter::enabled()).
+/// @param open Cleared when the user closes the window
+void render_allocation_panel(bool* open);
+
+} // namespace imgui
+} // namespace synopsia
@@ -5,6 +5,7 @@
 
 #include <imgui.h>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -61,5 +62,36 @@ private:
     RenderCallback render_callback_;
 };
 
+/// @brief Start an offscreen canvas layer in the frame being rendered
+///
+/// Everything drawn into the returned list (screen coordinates) is rasterized
+/// into an offscreen texture at `scale` times the framebuffer density just
+/// before the frame is drawn, and shown stretched over pos..pos+size in the
+/// current window. Lets fill-bound canvases trade sharpness for frame time
+/// while the rest of the UI stays at native resolution. One layer per widget
+/// per frame; falls back to the window draw list outside a QtImGuiWidget
+/// frame or without framebuffer object support.
+/// @param scale Resolution factor in (0, 1]
+ImDrawList* begin_canvas_layer(const ImVec2& pos, const ImVec2& size, float scale);
+
+/// @brief Finish the layer and place its image in the current window
+void end_canvas_layer();
+
+/// @brief Upload 0xAARRGGBB pixels into a texture of the widget being rendered
+///
+/// Each widget keeps up to four image textures, one per slot, resized as
+/// needed and released with the widget. Upload only when the pixels change;
+/// the id stays valid for ImGui::Image in later frames. Returns a null id
+/// outside a QtImGuiWidget frame.
+/// @param slot Texture slot, 0-3
+ImTextureID upload_image(int slot, const std::uint32_t* argb, int width, int height);
+
+/// @brief Re-upload only rows [first_row, first_row + row_count) of an image
+///
+/// For atlases that change a few tiles at a time. Uploads the whole image
+/// if the slot does not hold one of this size yet.
+ImTextureID update_image_rows(int slot, const std::uint32_t* argb, int width, int height,
+                              int first_row, int row_count);
+
 } // namespace imgui
 } // namespace synopsia
@@ -7,6 +7,8 @@
 #include "entropy.hpp"
 #include "color.hpp"
 #include "minimap_data_interface.hpp"
+#include "address_axis.hpp"
+#include <chrono>
 #include <mutex>
 #include <atomic>
 #include <string>
@@ -18,7 +20,8 @@ namespace synopsia {
 ///
 /// This class is responsible for:
 /// - Storing computed entropy blocks
-/// - Mapping between screen coordinates and addresses
+/// - Mapping between screen coordinates and addresses (through a
+///   gap-compressed axis, so sparse 64-bit layouts stay readable)
 /// - Managing viewport (pan/zoom)
 /// - Caching rendered image data
 ///
@@ -114,10 +117,14 @@ public:
         return {
             static_cast<data_addr_t>(viewport_.start_ea),
             static_cast<data_addr_t>(viewport_.end_ea),
-            viewport_.zoom
+            viewport_.zoom,
+            static_cast<data_size_t>(viewport_.start_offset),
+            static_cast<data_size_t>(viewport_.end_offset)
         };
     }
     
+    [[nodiscard]] const AddressAxis& axis() const noexcept override { return axis_; }
+    
     // =========================================================================
     // Viewport Management
     // =========================================================================
@@ -139,7 +146,7 @@ public:
         zoom_ida(factor, static_cast<ea_t>(center));
     }
     
-    /// @brief Pan viewport (IDA types)
+    /// @brief Pan viewport by delta axis units (IDA types)
     void pan_ida(sval_t delta);
     
     /// @brief Pan viewport (interface version)
@@ -147,6 +154,25 @@ public:
         pan_ida(static_cast<sval_t>(delta));
     }
     
+    // =========================================================================
+    // Byte Plot
+    // =========================================================================
+    
+    /// @brief Whole-database histograms, or histograms of the visible window
+    /// once a plotted line is shorter than their spans
+    ///
+    /// Called while painting, so missing histograms are read a slice per call
+    /// (HISTOGRAM_BUDGET). nullptr until the whole-database level is ready;
+    /// it stands in while the window's detail is read.
+    [[nodiscard]] const ByteHistogramPyramid* byte_histograms(data_size_t bytes_per_line) override;
+    
+    [[nodiscard]] bool byte_histograms_pending() const override {
+        return base_build_.active() || detail_build_.active();
+    }
+    
+    /// @brief Bytes of the readable regions in a range (main thread only)
+    data_size_t read_bytes(data_addr_t start, data_size_t size, std::uint8_t* out) override;
+    
     // =========================================================================
     // Coordinate Transformation (Interface implementation)
     // =========================================================================
@@ -198,6 +224,9 @@ private:
     ea_t db_start_ = 0;
     ea_t db_end_ = 0;
     
+    // Segments laid end to end, gaps collapsed
+    AddressAxis axis_;
+    
     // Viewport
     Viewport viewport_;
     
@@ -213,8 +242,45 @@ private:
     // Calculator instance
     EntropyCalculator calculator_;
     
+    /// Histogram reading per byte_histograms() call
+    static constexpr std::chrono::milliseconds HISTOGRAM_BUDGET{4};
+    
+    /// Bytes read and counted between budget checks
+    static constexpr std::size_t HISTOGRAM_CHUNK = 1024 * 1024;
+    
+    /// Span histograms of [start, end) being read a chunk at a time
+    struct HistogramBuild {
+        std::vector<ByteHistogram> spans;
+        std::size_t span_size = 0;   // 0 = idle
+        ea_t start = BADADDR;
+        ea_t end = BADADDR;
+        std::size_t region = 0;      // Next region of regions_ to read
+        ea_t cursor = BADADDR;       // Next address in that region
+        
+        [[nodiscard]] bool active() const noexcept { return span_size != 0; }
+    };
+    
+    // Byte plot histograms
+    ByteHistogramPyramid histograms_;       // Whole database
+    bool histograms_built_ = false;
+    ByteHistogramPyramid detail_;           // Around the viewport, when zoomed in
+    ea_t detail_start_ = BADADDR;           // Window the detail histograms cover
+    ea_t detail_end_ = BADADDR;
+    HistogramBuild base_build_;
+    HistogramBuild detail_build_;
+    
+    /// Start reading span histograms of [start, end), dropping any build in progress
+    void begin_histograms(HistogramBuild& build, ea_t start, ea_t end, std::size_t span_size);
+    
+    /// @brief Read chunks until the deadline (at least one)
+    /// @return true once the build covers its range
+    bool step_histograms(HistogramBuild& build, std::chrono::steady_clock::time_point deadline);
+    
     /// Compute statistics from blocks
     void compute_statistics();
+    
+    /// Show [start_offset, end_offset) of the axis and update edges and zoom
+    void set_window(asize_t start_offset, asize_t end_offset);
 };
 
 // =============================================================================
@@ -228,9 +294,9 @@ inline ea_t MinimapData::y_to_address_ea(int y, int height) const {
     
     const double t = static_cast<double>(y) / static_cast<double>(height);
     const asize_t range = viewport_.range();
-    const ea_t offset = static_cast<ea_t>(t * range);
+    const asize_t offset = static_cast<asize_t>(t * range);
     
-    return viewport_.start_ea + offset;
+    return static_cast<ea_t>(axis_.to_address(viewport_.start_offset + offset));
 }
 
 inline data_addr_t MinimapData::y_to_address(int y, int height) const {
@@ -245,9 +311,9 @@ inline ea_t MinimapData::x_to_address_ea(int x, int width) const {
     
     const double t = static_cast<double>(x) / static_cast<double>(width);
     const asize_t range = viewport_.range();
-    const ea_t offset = static_cast<ea_t>(t * range);
+    const asize_t offset = static_cast<asize_t>(t * range);
     
-    return viewport_.start_ea + offset;
+    return static_cast<ea_t>(axis_.to_address(viewport_.start_offset + offset));
 }
 
 inline data_addr_t MinimapData::x_to_address(int x, int width) const {
@@ -263,7 +329,9 @@ inline int MinimapData::address_to_y_ea(ea_t addr, int height) const {
     const asize_t range = viewport_.range();
     if (range == 0) return 0;
     
-    const double t = static_cast<double>(addr - viewport_.start_ea) / static_cast<double>(range);
+    const asize_t offset = static_cast<asize_t>(axis_.to_offset(addr));
+    if (offset < viewport_.start_offset) return 0;
+    const double t = static_cast<double>(offset - viewport_.start_offset) / static_cast<double>(range);
     return static_cast<int>(t * height);
 }
 
@@ -279,7 +347,9 @@ inline int MinimapData::address_to_x_ea(ea_t addr, int width) const {
     const asize_t range = viewport_.range();
     if (range == 0) return 0;
     
-    const double t = static_cast<double>(addr - viewport_.start_ea) / static_cast<double>(range);
+    const asize_t offset = static_cast<asize_t>(axis_.to_offset(addr));
+    if (offset < viewport_.start_offset) return 0;
+    const double t = static_cast<double>(offset - viewport_.start_offset) / static_cast<double>(range);
     return static_cast<int>(t * width);
 }
 
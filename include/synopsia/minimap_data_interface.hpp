@@ -21,6 +21,9 @@ using data_sval_t = std::int64_t;
 
 inline constexpr data_addr_t DATA_BADADDR = static_cast<data_addr_t>(-1);
 
+class AddressAxis;
+class ByteHistogramPyramid;
+
 /// Entropy block data for Qt (mirrors EntropyBlock without IDA types)
 struct EntropyBlockData {
     data_addr_t start_addr;
@@ -47,13 +50,19 @@ struct RegionData {
 };
 
 /// Viewport data for Qt
+///
+/// The visible window is kept on the gap-compressed address axis; the
+/// addresses are the ones at its edges, for display.
 struct ViewportData {
     data_addr_t start_addr;
     data_addr_t end_addr;
     double zoom;
+    data_size_t start_offset = 0;  ///< Window start on the address axis
+    data_size_t end_offset = 0;    ///< Window end on the address axis
     
+    /// Visible axis length (pan deltas are in the same units)
     [[nodiscard]] constexpr data_size_t range() const noexcept {
-        return end_addr - start_addr;
+        return end_offset - start_offset;
     }
 };
 
@@ -86,6 +95,9 @@ public:
     // Viewport
     [[nodiscard]] virtual ViewportData get_viewport() const = 0;
     
+    /// Address axis the viewport and coordinate transforms are expressed on
+    [[nodiscard]] virtual const AddressAxis& axis() const = 0;
+    
     // Coordinate transformation
     [[nodiscard]] virtual data_addr_t y_to_address(int y, int height) const = 0;
     [[nodiscard]] virtual data_addr_t x_to_address(int x, int width) const = 0;
@@ -97,7 +109,25 @@ public:
     
     // Viewport control
     virtual void zoom(double factor, data_addr_t center) = 0;
+    
+    /// Move the viewport by delta axis units (see ViewportData::range)
     virtual void pan(data_sval_t delta) = 0;
+    
+    /// Byte histograms for the byte plot, fine enough for one plotted line of
+    /// bytes_per_line where the source can read bytes; nullptr without byte data
+    [[nodiscard]] virtual const ByteHistogramPyramid* byte_histograms(data_size_t /*bytes_per_line*/) {
+        return nullptr;
+    }
+    
+    /// True while byte_histograms() is still building what it was last asked
+    /// for a slice per call; ask again on a later frame
+    [[nodiscard]] virtual bool byte_histograms_pending() const { return false; }
+    
+    /// Copy the readable bytes of [start, start + size) into out, skipping
+    /// gaps between regions; returns the bytes written (0 without byte data)
+    virtual data_size_t read_bytes(data_addr_t /*start*/, data_size_t /*size*/, std::uint8_t* /*out*/) {
+        return 0;
+    }
 };
 
 } // namespace synopsia
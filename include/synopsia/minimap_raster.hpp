@@ -0,0 +1,37 @@
+/// @file minimap_raster.hpp
+/// @brief Entropy minimap rasterizer (no IDA or Qt dependencies)
+///
+/// Shared by the Qt minimap widget and the standalone snapshot viewer.
+
+#pragma once
+
+#include "color.hpp"
+#include "minimap_data_interface.hpp"
+
+namespace synopsia {
+
+/// @brief Paint the blocks visible in the source's viewport into a pixel buffer
+///
+/// Blocks must be sorted by address. Only the visible range is visited: the
+/// first visible block is found by binary search. Positions come from the
+/// source's gap-compressed address axis, and collapsed gaps are painted
+/// with colors::GapMarker. Pixels not covered by any block or marker are
+/// left untouched, so callers fill the background first.
+/// @param source Data source (block list and viewport)
+/// @param gradient Entropy color gradient
+/// @param vertical Addresses run top to bottom (rows) instead of left to right
+/// @param width Buffer width in pixels
+/// @param height Buffer height in pixels
+/// @param pixels 0xAARRGGBB pixels (QImage::Format_RGB32 / GL_BGRA layout)
+/// @param stride Pixels per row
+void rasterize_entropy(
+    const IMinimapDataSource& source,
+    const ColorGradient& gradient,
+    bool vertical,
+    int width,
+    int height,
+    std::uint32_t* pixels,
+    std::size_t stride
+);
+
+} // namespace synopsia
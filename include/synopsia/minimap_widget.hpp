@@ -23,11 +23,15 @@
 #include <QWheelEvent>
 #include <QResizeEvent>
 #include <QPaintEvent>
+#include <QKeyEvent>
 #include <QToolTip>
 
 // Include IDA-independent headers
 #include "color.hpp"
 #include "minimap_data_interface.hpp"
+#include "byte_plot.hpp"
+#include "digraph.hpp"
+#include "common/session_trace.hpp"
 
 namespace synopsia {
 
@@ -37,11 +41,42 @@ inline constexpr int QT_MIN_MINIMAP_WIDTH = 60;
 inline constexpr int QT_CURSOR_LINE_HEIGHT = 2;
 inline constexpr int QT_CURSOR_GAP_HEIGHT = 8;        // Gap height for cursor "push" effect
 inline constexpr int QT_MINIMAP_MARGIN = 4;
+inline constexpr int QT_BYTE_PLOT_BAR_WIDTH = 24;     // Entropy bar width while the byte plot is shown
+inline constexpr int QT_BYTE_PLOT_SPACING = 2;
+inline constexpr std::size_t QT_DIGRAPH_MAX_BYTES = 32 * 1024 * 1024;  // Larger selections are sampled
+inline constexpr std::size_t QT_DIGRAPH_SAMPLES = 512;                  // Windows per sampled selection
 
 /// Callback types (using interface types)
 using QtAddressCallback = std::function<void(data_addr_t address)>;
 using QtRefreshCallback = std::function<void()>;
 
+/// @class DigraphWindow
+/// @brief Floating byte-pair plot of the minimap selection
+///
+/// Rows are the first byte of a pair, columns the second; hovering a cell
+/// shows its count.
+class DigraphWindow : public QWidget {
+public:
+    explicit DigraphWindow(QWidget* parent = nullptr);
+    
+    /// @brief Show new counts (the digraph must outlive the window or the next call)
+    void setDigraph(const ByteDigraph* digraph, const ColorGradient& gradient, const QString& caption);
+    
+    [[nodiscard]] QSize sizeHint() const override;
+    
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    
+private:
+    /// Square the matrix is drawn into
+    [[nodiscard]] QRect plotRect() const;
+    
+    const ByteDigraph* digraph_ = nullptr;
+    QImage image_;
+    QString caption_;
+};
+
 /// @class MinimapWidget
 /// @brief Qt widget for rendering the entropy minimap
 ///
@@ -52,6 +87,8 @@ using QtRefreshCallback = std::function<void()>;
 /// - Drag to pan
 /// - Hover to see entropy details
 /// - Current cursor position indicator
+/// - B toggles a byte-value plot beside the bar (where the source has bytes)
+/// - Shift+drag selects a range and plots its byte pairs; Escape clears it
 class MinimapWidget : public QWidget {
     // Note: We avoid Q_OBJECT to prevent moc dependency
     // Use std::function callbacks instead of signals/slots
@@ -109,6 +146,12 @@ public:
     /// When enabled, the minimap content is pushed apart at the cursor position
     void setShowCursorGap(bool show);
     
+    /// @brief Show the byte-value plot next to the entropy bar
+    void setShowBytePlot(bool show);
+    
+    /// @brief Check if the byte plot is requested
+    [[nodiscard]] bool showBytePlot() const noexcept { return show_byte_plot_; }
+    
     // =========================================================================
     // Callbacks (replaces Qt signals to avoid moc)
     // =========================================================================
@@ -139,6 +182,7 @@ protected:
     void mouseMoveEvent(QMouseEvent* event) override;
     void mouseReleaseEvent(QMouseEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
     void enterEvent(QEnterEvent* event) override;
     void leaveEvent(QEvent* event) override;
@@ -166,6 +210,19 @@ private:
     /// Draw cursor gap (split effect at cursor position)
     void drawCursorGap(QPainter& painter);
     
+    /// Draw the selected range
+    void drawSelection(QPainter& painter);
+    
+    // =========================================================================
+    // Selection
+    // =========================================================================
+    
+    /// Count the byte pairs of the selection and show them
+    void updateDigraph();
+    
+    /// Drop the selection and hide its digraph
+    void clearSelection();
+    
     // =========================================================================
     // Coordinate Helpers
     // =========================================================================
@@ -179,6 +236,15 @@ private:
     /// Get the content rectangle (minus margins)
     [[nodiscard]] QRect contentRect() const;
     
+    /// Byte value under a widget position inside the byte plot, or -1
+    [[nodiscard]] int positionToByteValue(const QPoint& pos) const;
+    
+    /// Log input while a session trace is being recorded
+    void traceInput(TraceInput input, float x, float y, std::int64_t value);
+
+    /// Report size and orientation for trace headers, and log them as a Resize
+    void traceLayout();
+    
     // =========================================================================
     // Member Data
     // =========================================================================
@@ -191,6 +257,7 @@ private:
     bool show_cursor_ = true;
     bool show_regions_ = true;
     bool show_cursor_gap_ = true;
+    bool show_byte_plot_ = false;
     data_addr_t current_addr_ = DATA_BADADDR;
     
     // Interaction state
@@ -199,12 +266,28 @@ private:
     bool is_dragging_ = false;
     QPoint drag_start_;
     data_addr_t drag_start_addr_ = 0;
+    bool input_traced_ = false;  // Next paint is logged as a trace frame
     
     // Render cache
     QImage cache_image_;
     bool cache_valid_ = false;
     int cached_width_ = 0;
     int cached_height_ = 0;
+    
+    // Byte plot, drawn into the cache beside the bar
+    BytePlot byte_plot_;
+    int plot_offset_ = 0;  // Plot start across the bar (0 = not drawn)
+    
+    // Shift+drag selection and its byte-pair digraph
+    bool is_selecting_ = false;
+    data_addr_t selection_anchor_ = DATA_BADADDR;
+    data_addr_t selection_end_ = DATA_BADADDR;
+    QTimer digraph_timer_;  // Zero-interval: one count per event-loop pass while dragging
+    QTimer histogram_timer_;  // Repaints while the byte plot's histograms are being read
+    ByteDigraph digraph_;
+    std::vector<std::uint8_t> digraph_bytes_;
+    std::vector<std::size_t> digraph_breaks_;  // Where each separately read run starts
+    DigraphWindow* digraph_window_ = nullptr;  // Child tool window, created on first selection
 };
 
 } // namespace synopsia
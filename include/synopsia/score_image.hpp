@@ -0,0 +1,53 @@
+/// @file score_image.hpp
+/// @brief Streaming export of block scores as large PNG images (no IDA or Qt dependencies)
+///
+/// Renders the whole address range, not a viewport, either as a strip (the
+/// minimap layout) or folded onto a Hilbert curve. Blocks are laid end to
+/// end by size, so unmapped gaps take no space. The image is produced one
+/// band of rows at a time: tiles of a band are colored, filtered and
+/// compressed in parallel, then appended to the file as IDAT chunks. Memory
+/// use is bounded by one band plus the block list, whatever the image size.
+
+#pragma once
+
+#include "color.hpp"
+#include "minimap_data_interface.hpp"
+
+#include <span>
+#include <string>
+
+namespace synopsia {
+
+/// Largest accepted image edge in pixels
+inline constexpr int SCORE_IMAGE_MAX_EDGE = 65536;
+
+/// How addresses map to pixels. Values are part of the scripting API.
+enum class ScoreImageLayout : int {
+    Strip = 0,    ///< Addresses along one axis, like the minimap
+    Hilbert = 1,  ///< Addresses folded onto a Hilbert curve (square, power-of-two edge)
+};
+
+struct ScoreImageOptions {
+    ScoreImageLayout layout = ScoreImageLayout::Hilbert;
+    int width = 4096;      ///< Image width; the edge length for Hilbert
+    int height = 4096;     ///< Image height; ignored for Hilbert
+    bool vertical = true;  ///< Strip: addresses run top to bottom
+    int band_rows = 256;   ///< Rows rendered per band (bounds memory use)
+};
+
+/// @brief Write blocks as an RGB PNG
+/// @param blocks Blocks sorted by address, scores 0-8
+/// @param gradient Score color gradient
+/// @param options Layout and size
+/// @param path Output file
+/// @param error Receives a reason on failure
+/// @return true if the file was written
+bool export_score_image(
+    std::span<const EntropyBlockData> blocks,
+    const ColorGradient& gradient,
+    const ScoreImageOptions& options,
+    const std::string& path,
+    std::string* error = nullptr
+);
+
+} // namespace synopsia
@@ -125,18 +125,23 @@ struct Viewport {
     ea_t start_ea;              ///< Visible range start
     ea_t end_ea;                ///< Visible range end
     double zoom;                ///< Zoom factor (1.0 = fit to view)
+    asize_t start_offset;       ///< Visible range start on the gap-compressed axis
+    asize_t end_offset;         ///< Visible range end on the gap-compressed axis
     
-    Viewport() : start_ea(0), end_ea(0), zoom(1.0) {}
+    Viewport() : start_ea(0), end_ea(0), zoom(1.0), start_offset(0), end_offset(0) {}
     
+    /// Visible length on the address axis
     [[nodiscard]] constexpr asize_t range() const noexcept {
-        return end_ea - start_ea;
+        return end_offset - start_offset;
     }
     
     /// Reset to show entire database
-    void reset(ea_t db_start, ea_t db_end) {
+    void reset(ea_t db_start, ea_t db_end, asize_t axis_length) {
         start_ea = db_start;
         end_ea = db_end;
         zoom = 1.0;
+        start_offset = 0;
+        end_offset = axis_length;
     }
 };
 
@@ -0,0 +1,206 @@
+"""Thin IDAPython wrapper over the Synopsia scripting API.
+
+Bulk results come back as memoryviews over plugin-owned buffers (no copy).
+`numpy.frombuffer(view, dtype=...)` works on them directly. The underlying
+buffer is released when the last view referencing it is garbage collected.
+
+Calls that only query an existing snapshot (bfs, path, search, block_scores_bytes,
+histogram_bytes) go through ctypes, which releases the GIL while they run.
+Calls that read the database go through IDC and run on the main thread.
+"""
+
+import ctypes
+import os
+
+import ida_diskio
+import idc
+
+_LIB_NAMES = ("synopsia.so", "synopsia.dylib", "synopsia.dll")
+
+CALLEES = 0
+CALLERS = 1
+UNREACHED = 0xFFFFFFFF
+
+# Score image layouts
+STRIP = 0
+HILBERT = 1
+
+
+def _load_library():
+    dirs = [
+        os.path.join(ida_diskio.get_user_idadir(), "plugins"),
+        ida_diskio.idadir("plugins"),
+    ]
+    for d in dirs:
+        for name in _LIB_NAMES:
+            path = os.path.join(d, name)
+            if os.path.exists(path):
+                return ctypes.CDLL(path)
+    raise OSError("synopsia plugin library not found")
+
+
+_lib = _load_library()
+_lib.synopsia_api_version.restype = ctypes.c_int
+_lib.synopsia_api_buffer_data.restype = ctypes.c_void_p
+_lib.synopsia_api_buffer_data.argtypes = [ctypes.c_int64]
+_lib.synopsia_api_buffer_count.restype = ctypes.c_uint64
+_lib.synopsia_api_buffer_count.argtypes = [ctypes.c_int64]
+_lib.synopsia_api_buffer_format.restype = ctypes.c_char
+_lib.synopsia_api_buffer_format.argtypes = [ctypes.c_int64]
+_lib.synopsia_api_buffer_free.argtypes = [ctypes.c_int64]
+_lib.synopsia_api_bfs.restype = ctypes.c_int64
+_lib.synopsia_api_bfs.argtypes = [ctypes.c_uint64, ctypes.c_int, ctypes.c_uint32]
+_lib.synopsia_api_path.restype = ctypes.c_int64
+_lib.synopsia_api_path.argtypes = [ctypes.c_uint64, ctypes.c_uint64]
+_lib.synopsia_api_search.restype = ctypes.c_int64
+_lib.synopsia_api_search.argtypes = [ctypes.c_char_p, ctypes.c_uint32]
+_lib.synopsia_api_block_scores.restype = ctypes.c_uint64
+_lib.synopsia_api_block_scores.argtypes = [ctypes.c_void_p, ctypes.c_uint64, ctypes.c_uint32, ctypes.c_void_p]
+_lib.synopsia_api_histogram.argtypes = [ctypes.c_void_p, ctypes.c_uint64, ctypes.c_void_p]
+_lib.synopsia_api_export_image.restype = ctypes.c_int
+_lib.synopsia_api_export_image.argtypes = [ctypes.c_void_p, ctypes.c_uint64, ctypes.c_uint32, ctypes.c_char_p,
+                                           ctypes.c_int, ctypes.c_int, ctypes.c_int]
+
+_ITEM_SIZE = {"B": 1, "I": 4, "Q": 8, "d": 8}
+
+
+class _Handle:
+    """Frees the native buffer when the last view goes away."""
+
+    def __init__(self, handle):
+        self.handle = handle
+
+    def __del__(self):
+        _lib.synopsia_api_buffer_free(self.handle)
+
+
+def _view(handle):
+    if handle < 0:
+        return None
+    fmt = _lib.synopsia_api_buffer_format(handle).decode()
+    count = _lib.synopsia_api_buffer_count(handle)
+    ptr = _lib.synopsia_api_buffer_data(handle)
+    if not ptr or count == 0:
+        _lib.synopsia_api_buffer_free(handle)
+        return memoryview(b"").cast("B").cast(fmt or "B")
+    raw = (ctypes.c_ubyte * (count * _ITEM_SIZE[fmt])).from_address(ptr)
+    raw._synopsia_owner = _Handle(handle)
+    return memoryview(raw).cast("B").cast(fmt)
+
+
+def _idc_str(text):
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+# -- Database-reading calls (main thread, via IDC) ---------------------------
+
+def refresh():
+    """Rebuild the function/call-graph snapshot. Returns function count."""
+    return idc.eval_idc("synopsia_refresh()")
+
+
+def write_snapshot(path=""):
+    """Write a snapshot file (default: <idb>.synsnap). Returns True on success."""
+    return idc.eval_idc("synopsia_snapshot_write(%s)" % _idc_str(path)) == 1
+
+
+def start_trace(path=""):
+    """Record a session trace (default: <idb>.syntrace). Returns True on success."""
+    return idc.eval_idc("synopsia_trace_start(%s)" % _idc_str(path)) == 1
+
+
+def stop_trace():
+    """Stop recording the session trace."""
+    idc.eval_idc("synopsia_trace_stop()")
+
+
+def block_scores(start, end, block_size=256):
+    """Per-block scores (0-8) for [start, end) as a 'd' memoryview."""
+    return _view(idc.eval_idc("synopsia_block_scores(0x%X, 0x%X, %d)" % (start, end, block_size)))
+
+
+def histogram(start, end):
+    """Byte-value counts for [start, end) as a 256-entry 'Q' memoryview."""
+    return _view(idc.eval_idc("synopsia_histogram(0x%X, 0x%X)" % (start, end)))
+
+
+def export_image(path, layout=HILBERT, width=4096, height=4096):
+    """Write the database's block scores as a PNG; Hilbert uses width as the
+    (power-of-two) edge. Returns True on success."""
+    return idc.eval_idc("synopsia_export_image(%s, %d, %d, %d)" % (_idc_str(path), layout, width, height)) == 1
+
+
+def func_count():
+    return idc.eval_idc("synopsia_func_count()")
+
+
+def func_index(ea):
+    """Snapshot index of the function containing ea, or -1."""
+    return idc.eval_idc("synopsia_func_index(0x%X)" % ea)
+
+
+def func_name(index):
+    return idc.eval_idc("synopsia_func_name(%d)" % index)
+
+
+def func_column(name):
+    """Catalog column: address, end (Q) or size, depth, callers, callees (I)."""
+    return _view(idc.eval_idc("synopsia_func_column(%s)" % _idc_str(name)))
+
+
+def csr(direction=CALLEES):
+    """(offsets, targets) CSR arrays over snapshot indices."""
+    offsets = _view(idc.eval_idc("synopsia_csr(%d, 0)" % direction))
+    targets = _view(idc.eval_idc("synopsia_csr(%d, 1)" % direction))
+    return offsets, targets
+
+
+# -- Snapshot queries (ctypes, GIL released) ---------------------------------
+
+def bfs(ea, direction=CALLEES, max_depth=UNREACHED):
+    """Hop distance from function ea to every node ('I'; UNREACHED if none)."""
+    return _view(_lib.synopsia_api_bfs(ea, direction, max_depth))
+
+
+def path(src, dst):
+    """Shortest call path as function addresses ('Q'); empty if unreachable."""
+    return _view(_lib.synopsia_api_path(src, dst))
+
+
+def search(text, max_results=0):
+    """Case-insensitive substring search; returns snapshot indices ('I')."""
+    return _view(_lib.synopsia_api_search(text.encode(), max_results))
+
+
+def _data_size(data):
+    # Bytes, not elements: len() of an 'I' or 'd' memoryview counts items
+    return memoryview(data).nbytes
+
+
+def _data_pointer(data):
+    # bytes pass straight through; writable buffers are wrapped in place
+    if isinstance(data, bytes):
+        return data
+    return (ctypes.c_ubyte * _data_size(data)).from_buffer(data)
+
+
+def block_scores_bytes(data, block_size=256):
+    """Block scores for an in-memory bytes-like object."""
+    size = _data_size(data)
+    out = (ctypes.c_double * ((size + block_size - 1) // block_size))()
+    n = _lib.synopsia_api_block_scores(_data_pointer(data), size, block_size, out)
+    return memoryview(out)[:n]
+
+
+def histogram_bytes(data):
+    """Byte histogram for an in-memory bytes-like object."""
+    out = (ctypes.c_uint64 * 256)()
+    _lib.synopsia_api_histogram(_data_pointer(data), _data_size(data), out)
+    return memoryview(out)
+
+
+def export_image_scores(scores, path, block_size=256, layout=HILBERT, width=4096, height=4096):
+    """Write block scores (e.g. from block_scores_bytes) as a PNG."""
+    data = (ctypes.c_double * len(scores))(*scores)
+    return _lib.synopsia_api_export_image(data, len(scores), block_size, path.encode(),
+                                          layout, width, height) == 1
@@ -0,0 +1,77 @@
+/// @file address_axis.cpp
+/// @brief Gap-compressed address axis implementation
+
+#include <synopsia/address_axis.hpp>
+
+#include <algorithm>
+
+namespace synopsia {
+
+void AddressAxis::build(std::vector<RegionData> ranges, data_size_t min_marker) {
+    spans_.clear();
+
+    std::sort(ranges.begin(), ranges.end(),
+              [](const RegionData& a, const RegionData& b) { return a.start_addr < b.start_addr; });
+
+    data_size_t mapped = 0;
+    for (const RegionData& range : ranges) {
+        if (range.end_addr <= range.start_addr) continue;
+        if (!spans_.empty() && range.start_addr <= spans_.back().end) {
+            if (range.end_addr > spans_.back().end) {
+                mapped += range.end_addr - spans_.back().end;
+                spans_.back().end = range.end_addr;
+            }
+            continue;
+        }
+        spans_.push_back({range.start_addr, range.end_addr, 0});
+        mapped += range.size();
+    }
+
+    // Per-marker size, then shrunk so the gaps share a fixed fraction of the axis
+    const data_size_t gaps = spans_.size() > 1 ? spans_.size() - 1 : 1;
+    const data_size_t share = mapped / GAP_SHARE_DIVISOR / gaps;
+    const data_size_t marker = std::max<data_size_t>(
+        1, std::min(std::max(min_marker, mapped / GAP_MARKER_DIVISOR), share));
+    data_size_t offset = 0;
+    for (std::size_t i = 0; i < spans_.size(); ++i) {
+        if (i > 0) {
+            offset += std::min(spans_[i].start - spans_[i - 1].end, marker);
+        }
+        spans_[i].offset = offset;
+        offset += spans_[i].size();
+    }
+}
+
+data_size_t AddressAxis::to_offset(data_addr_t addr) const noexcept {
+    if (spans_.empty() || addr <= spans_.front().start) return 0;
+
+    // Last span starting at or before addr
+    auto it = std::upper_bound(spans_.begin(), spans_.end(), addr,
+                               [](data_addr_t a, const Span& span) { return a < span.start; });
+    const Span& span = *(it - 1);
+    if (addr < span.end) return span.offset + (addr - span.start);
+    if (it == spans_.end()) return span.offset_end();
+
+    // Inside the gap: scale linearly onto the marker
+    const double t = static_cast<double>(addr - span.end) / static_cast<double>(it->start - span.end);
+    const data_size_t marker = it->offset - span.offset_end();
+    return span.offset_end() + std::min(static_cast<data_size_t>(t * static_cast<double>(marker)), marker);
+}
+
+data_addr_t AddressAxis::to_address(data_size_t offset) const noexcept {
+    if (spans_.empty()) return 0;
+
+    auto it = std::upper_bound(spans_.begin(), spans_.end(), offset,
+                               [](data_size_t o, const Span& span) { return o < span.offset; });
+    if (it == spans_.begin()) return spans_.front().start;
+    const Span& span = *(it - 1);
+    if (offset < span.offset_end()) return span.start + (offset - span.offset);
+    if (it == spans_.end()) return span.end;
+
+    const double t = static_cast<double>(offset - span.offset_end()) /
+                     static_cast<double>(it->offset - span.offset_end());
+    const data_size_t gap = it->start - span.end;
+    return span.end + std::min(static_cast<data_size_t>(t * static_cast<double>(gap)), gap);
+}
+
+} // namespace synopsia
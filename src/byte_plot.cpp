@@ -0,0 +1,185 @@
+/// @file byte_plot.cpp
+/// @brief Byte-value heatmap implementation
+
+#include <synopsia/byte_plot.hpp>
+#include <synopsia/address_axis.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace synopsia {
+
+// =============================================================================
+// ByteHistogram
+// =============================================================================
+
+void ByteHistogram::set_counts(const std::array<std::uint64_t, 256>& counts, std::uint64_t total) noexcept {
+    bytes = total;
+    for (std::size_t v = 0; v < 256; ++v) {
+        freq[v] = total ? static_cast<std::uint16_t>(std::min<std::uint64_t>(65535, counts[v] * 65535 / total)) : 0;
+    }
+}
+
+std::size_t byte_histogram_span(std::uint64_t total_bytes, std::size_t min_span) {
+    std::size_t span = std::max<std::size_t>(min_span, 1);
+    while (total_bytes / span > BYTE_HISTOGRAM_MAX_SPANS) {
+        span *= 2;
+    }
+    return span;
+}
+
+// =============================================================================
+// ByteHistogramPyramid
+// =============================================================================
+
+void ByteHistogramPyramid::build(std::vector<ByteHistogram> base, std::size_t span_size) {
+    levels_.clear();
+    span_size_ = span_size;
+    if (base.empty()) return;
+
+    levels_.push_back(std::move(base));
+    while (levels_.back().size() > 1) {
+        const std::vector<ByteHistogram>& fine = levels_.back();
+        std::vector<ByteHistogram> coarse((fine.size() + 1) / 2);
+        for (std::size_t i = 0; i < coarse.size(); ++i) {
+            const ByteHistogram& a = fine[2 * i];
+            ByteHistogram& out = coarse[i];
+            if (2 * i + 1 == fine.size()) {
+                out = a;
+                continue;
+            }
+            const ByteHistogram& b = fine[2 * i + 1];
+            out.start_addr = a.start_addr;
+            out.end_addr = b.end_addr;
+            out.bytes = a.bytes + b.bytes;
+            if (out.bytes == 0) continue;
+            for (std::size_t v = 0; v < 256; ++v) {
+                out.freq[v] = static_cast<std::uint16_t>(
+                    (static_cast<std::uint64_t>(a.freq[v]) * a.bytes + static_cast<std::uint64_t>(b.freq[v]) * b.bytes) /
+                    out.bytes);
+            }
+        }
+        levels_.push_back(std::move(coarse));
+    }
+}
+
+void ByteHistogramPyramid::clear() noexcept {
+    levels_.clear();
+    span_size_ = 0;
+}
+
+std::size_t ByteHistogramPyramid::level_for(data_size_t bytes) const noexcept {
+    std::size_t level = 0;
+    while (level + 1 < levels_.size() && (static_cast<data_size_t>(span_size_) << (level + 1)) <= bytes) {
+        ++level;
+    }
+    return level;
+}
+
+data_addr_t ByteHistogramPyramid::start_addr() const noexcept {
+    return empty() ? 0 : levels_.front().front().start_addr;
+}
+
+data_addr_t ByteHistogramPyramid::end_addr() const noexcept {
+    return empty() ? 0 : levels_.front().back().end_addr;
+}
+
+// =============================================================================
+// BytePlot
+// =============================================================================
+
+BytePlot::BytePlot(const ColorGradient& gradient) {
+    set_gradient(gradient);
+}
+
+void BytePlot::set_gradient(const ColorGradient& gradient) {
+    // log(1 + gain * share): a value at 1/256 (uniform data) lands near a
+    // quarter of the gradient, a value at half the bytes near the top
+    constexpr double gain = 1024.0;
+    const double norm = std::log1p(gain);
+    lut_[0] = colors::Background.to_argb() | 0xFF000000u;
+    for (std::size_t i = 1; i < LUT_SIZE; ++i) {
+        const double share = static_cast<double>(i) / static_cast<double>(LUT_SIZE - 1);
+        const double t = std::log1p(gain * share) / norm;
+        lut_[i] = gradient.sample_entropy(t * 8.0).to_argb() | 0xFF000000u;
+    }
+}
+
+void BytePlot::rasterize(const IMinimapDataSource& source, const ByteHistogramPyramid& pyramid, bool vertical,
+                         int width, int height, std::uint32_t* pixels, std::size_t stride) {
+    line_count_ = 0;
+    if (width <= 0 || height <= 0 || pyramid.empty() || !source.is_valid()) {
+        return;
+    }
+
+    const ViewportData viewport = source.get_viewport();
+    const data_size_t vp_range = viewport.range();
+    if (vp_range == 0) {
+        return;
+    }
+
+    const AddressAxis& axis = source.axis();
+    const int extent = vertical ? height : width;
+    const std::span<const ByteHistogram> entries = pyramid.level(pyramid.level_for(vp_range / static_cast<data_size_t>(extent)));
+
+    line_count_ = extent;
+    lines_.assign(static_cast<std::size_t>(extent) * 256, 0.0f);
+    weights_.assign(static_cast<std::size_t>(extent), 0.0f);
+
+    // Sum each visible entry into the lines it overlaps
+    auto first = std::partition_point(entries.begin(), entries.end(), [&](const ByteHistogram& entry) {
+        return entry.end_addr <= viewport.start_addr;
+    });
+    for (auto it = first; it != entries.end(); ++it) {
+        const data_size_t start = std::max(axis.to_offset(it->start_addr), viewport.start_offset);
+        const data_size_t end = std::min(axis.to_offset(it->end_addr), viewport.end_offset);
+        if (start >= viewport.end_offset) break;
+        if (start >= end || it->bytes == 0) continue;
+
+        const double t1 = static_cast<double>(start - viewport.start_offset) / static_cast<double>(vp_range);
+        const double t2 = static_cast<double>(end - viewport.start_offset) / static_cast<double>(vp_range);
+        const int line_start = std::clamp(static_cast<int>(t1 * extent), 0, extent - 1);
+        const int line_end = std::clamp(static_cast<int>(std::ceil(t2 * extent)), line_start + 1, extent);
+
+        const float weight = static_cast<float>(it->bytes);
+        for (int line = line_start; line < line_end; ++line) {
+            float* sums = &lines_[static_cast<std::size_t>(line) * 256];
+            for (std::size_t v = 0; v < 256; ++v) {
+                sums[v] += weight * static_cast<float>(it->freq[v]);
+            }
+            weights_[static_cast<std::size_t>(line)] += weight;
+        }
+    }
+
+    // Shares, then pixels; lines with no data keep the caller's background
+    const int cross = vertical ? width : height;
+    for (int line = 0; line < extent; ++line) {
+        const float weight = weights_[static_cast<std::size_t>(line)];
+        if (weight <= 0.0f) continue;
+
+        float* shares = &lines_[static_cast<std::size_t>(line) * 256];
+        const float scale = 1.0f / (weight * 65535.0f);
+        for (std::size_t v = 0; v < 256; ++v) {
+            shares[v] = std::min(1.0f, shares[v] * scale);
+        }
+
+        for (int c = 0; c < cross; ++c) {
+            const int v_start = c * 256 / cross;
+            const int v_end = std::max(v_start + 1, (c + 1) * 256 / cross);
+            const float share = *std::max_element(shares + v_start, shares + v_end);
+            if (vertical) {
+                pixels[static_cast<std::size_t>(line) * stride + static_cast<std::size_t>(c)] = color(share);
+            } else {
+                pixels[static_cast<std::size_t>(c) * stride + static_cast<std::size_t>(line)] = color(share);
+            }
+        }
+    }
+}
+
+double BytePlot::share_at(int line, int byte_value) const noexcept {
+    if (line < 0 || line >= line_count_ || byte_value < 0 || byte_value > 255) return -1.0;
+    if (weights_[static_cast<std::size_t>(line)] <= 0.0f) return -1.0;
+    return lines_[static_cast<std::size_t>(line) * 256 + static_cast<std::size_t>(byte_value)];
+}
+
+} // namespace synopsia
@@ -0,0 +1,44 @@
+/// @file alloc_hooks.cpp
+/// @brief Global operator new/delete replacements that feed AllocationCounter
+///
+/// Link this into a target to count its heap allocations (see
+/// alloc_tracker.hpp). Memory still comes from malloc and goes back through
+/// free, so blocks allocated by code outside the hooks can be freed here and
+/// the other way round.
+///
+/// The standalone viewer owns its process and replaces the allocator for all
+/// of it. In the plugin (diagnostics builds only) the hooks see just the
+/// plugin's own calls: Windows resolves operator new per module, macOS binds
+/// it inside the image, and on Linux the plugin links with -Bsymbolic.
+
+#include <synopsia/common/alloc_tracker.hpp>
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+void* counted_alloc(std::size_t size) {
+    synopsia::AllocationCounter::note(size);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+
+// Hooks linked in means the counters are live
+const bool g_enabled = (synopsia::AllocationCounter::enable(), true);
+
+} // anonymous namespace
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    synopsia::AllocationCounter::note(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
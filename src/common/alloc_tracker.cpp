@@ -0,0 +1,149 @@
+/// @file alloc_tracker.cpp
+/// @brief Heap allocation counters per feature and phase
+
+#include <synopsia/common/alloc_tracker.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace synopsia {
+
+namespace {
+
+// Plain thread-locals: the hooks read and bump these, so no constructors
+thread_local std::uint64_t t_allocations = 0;
+thread_local std::uint64_t t_bytes = 0;
+thread_local AllocationScope* t_scope = nullptr;
+
+struct SiteRegistry {
+    std::mutex mutex;
+    std::vector<AllocationSite*> sites;
+};
+
+SiteRegistry& registry() {
+    static SiteRegistry instance;
+    return instance;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// AllocationCounter
+// =============================================================================
+
+void AllocationCounter::note(std::size_t bytes) noexcept {
+    count_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    ++t_allocations;
+    t_bytes += bytes;
+}
+
+// =============================================================================
+// AllocationSite
+// =============================================================================
+
+AllocationSite::AllocationSite(std::string feature, std::string phase)
+    : feature_(std::move(feature))
+    , phase_(std::move(phase)) {
+    SiteRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.sites.push_back(this);
+}
+
+AllocationSite::~AllocationSite() {
+    SiteRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.sites.erase(std::remove(reg.sites.begin(), reg.sites.end(), this), reg.sites.end());
+}
+
+AllocationSite::Stats AllocationSite::stats() const {
+    Stats out;
+    out.feature = feature_;
+    out.phase = phase_;
+    out.passes = passes_.load(std::memory_order_relaxed);
+    out.allocations = allocations_.load(std::memory_order_relaxed);
+    out.bytes = bytes_.load(std::memory_order_relaxed);
+    out.last_allocations = last_allocations_.load(std::memory_order_relaxed);
+    out.last_bytes = last_bytes_.load(std::memory_order_relaxed);
+    out.last_items = last_items_.load(std::memory_order_relaxed);
+    out.max_allocations = max_allocations_.load(std::memory_order_relaxed);
+    return out;
+}
+
+void AllocationSite::reset() noexcept {
+    passes_.store(0, std::memory_order_relaxed);
+    allocations_.store(0, std::memory_order_relaxed);
+    bytes_.store(0, std::memory_order_relaxed);
+    last_allocations_.store(0, std::memory_order_relaxed);
+    last_bytes_.store(0, std::memory_order_relaxed);
+    last_items_.store(0, std::memory_order_relaxed);
+    max_allocations_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<AllocationSite::Stats> AllocationSite::snapshot() {
+    SiteRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<Stats> out;
+    out.reserve(reg.sites.size());
+    for (const AllocationSite* site : reg.sites) {
+        out.push_back(site->stats());
+    }
+    return out;
+}
+
+void AllocationSite::reset_all() {
+    SiteRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (AllocationSite* site : reg.sites) {
+        site->reset();
+    }
+}
+
+void AllocationSite::record(std::uint64_t allocations, std::uint64_t bytes, std::uint64_t items) noexcept {
+    passes_.fetch_add(1, std::memory_order_relaxed);
+    allocations_.fetch_add(allocations, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    last_allocations_.store(allocations, std::memory_order_relaxed);
+    last_bytes_.store(bytes, std::memory_order_relaxed);
+    last_items_.store(items, std::memory_order_relaxed);
+
+    std::uint64_t worst = max_allocations_.load(std::memory_order_relaxed);
+    while (allocations > worst &&
+           !max_allocations_.compare_exchange_weak(worst, allocations, std::memory_order_relaxed)) {
+    }
+}
+
+// =============================================================================
+// AllocationScope
+// =============================================================================
+
+AllocationScope::AllocationScope(AllocationSite& site) noexcept
+    : site_(site)
+    , parent_(t_scope)
+    , start_allocations_(t_allocations)
+    , start_bytes_(t_bytes) {
+    t_scope = this;
+}
+
+AllocationScope::~AllocationScope() {
+    const std::uint64_t allocations = t_allocations - start_allocations_;
+    const std::uint64_t bytes = t_bytes - start_bytes_;
+    site_.record(allocations - nested_allocations_, bytes - nested_bytes_, items_);
+
+    // The enclosing pass must not count these again
+    if (parent_) {
+        parent_->nested_allocations_ += allocations;
+        parent_->nested_bytes_ += bytes;
+    }
+    t_scope = parent_;
+}
+
+std::uint64_t AllocationScope::allocations() const noexcept {
+    return t_allocations - start_allocations_ - nested_allocations_;
+}
+
+std::uint64_t AllocationScope::bytes() const noexcept {
+    return t_bytes - start_bytes_ - nested_bytes_;
+}
+
+} // namespace synopsia
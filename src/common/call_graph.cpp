@@ -0,0 +1,181 @@
+/// @file call_graph.cpp
+/// @brief CSR call graph construction and traversal
+
+#include <synopsia/common/call_graph.hpp>
+#include <algorithm>
+
+namespace synopsia {
+
+namespace {
+
+/// Counting-sort edges into CSR form; `key` selects the source endpoint
+template <typename Csr, typename KeyFn, typename ValueFn>
+void fill_csr(Csr& csr,
+              std::size_t node_count,
+              std::span<const std::pair<graph_index_t, graph_index_t>> edges,
+              KeyFn key, ValueFn value) {
+    csr.offsets.assign(node_count + 1, 0);
+    for (const auto& e : edges) {
+        ++csr.offsets[key(e) + 1];
+    }
+    for (std::size_t i = 0; i < node_count; ++i) {
+        csr.offsets[i + 1] += csr.offsets[i];
+    }
+
+    csr.targets.resize(edges.size());
+    std::vector<std::uint32_t> cursor(csr.offsets.begin(), csr.offsets.end() - 1);
+    for (const auto& e : edges) {
+        csr.targets[cursor[key(e)]++] = value(e);
+    }
+}
+
+} // anonymous namespace
+
+void CallGraph::build(std::size_t node_count,
+                      std::span<const std::pair<graph_index_t, graph_index_t>> edges) {
+    // Drop invalid edges and duplicates so degrees are exact
+    std::vector<std::pair<graph_index_t, graph_index_t>> clean;
+    clean.reserve(edges.size());
+    for (const auto& e : edges) {
+        if (e.first < node_count && e.second < node_count) {
+            clean.push_back(e);
+        }
+    }
+    std::sort(clean.begin(), clean.end());
+    clean.erase(std::unique(clean.begin(), clean.end()), clean.end());
+
+    const std::span<const std::pair<graph_index_t, graph_index_t>> view(clean);
+    fill_csr(callee_storage_, node_count, view,
+             [](const auto& e) { return e.first; },
+             [](const auto& e) { return e.second; });
+    fill_csr(caller_storage_, node_count, view,
+             [](const auto& e) { return e.second; },
+             [](const auto& e) { return e.first; });
+    owner_.reset();
+    attach(callees_, callee_storage_);
+    attach(callers_, caller_storage_);
+}
+
+void CallGraph::borrow(std::span<const std::uint32_t> callee_offsets, std::span<const graph_index_t> callee_targets,
+                       std::span<const std::uint32_t> caller_offsets, std::span<const graph_index_t> caller_targets,
+                       std::shared_ptr<const void> owner) {
+    callee_storage_ = {};
+    caller_storage_ = {};
+    owner_ = std::move(owner);
+    callees_ = {callee_offsets, callee_targets};
+
+    if (!caller_offsets.empty() && caller_offsets.size() == callee_offsets.size()) {
+        callers_ = {caller_offsets, caller_targets};
+        return;
+    }
+
+    // Transpose; visiting callers in order leaves each list sorted
+    const std::size_t node_count = callees_.node_count();
+    std::vector<std::pair<graph_index_t, graph_index_t>> edges;
+    edges.reserve(callee_targets.size());
+    for (std::size_t i = 0; i < node_count; ++i) {
+        for (graph_index_t callee : callees_.neighbors(static_cast<graph_index_t>(i))) {
+            if (callee < node_count) edges.emplace_back(static_cast<graph_index_t>(i), callee);
+        }
+    }
+    fill_csr(caller_storage_, node_count, edges,
+             [](const auto& e) { return e.second; },
+             [](const auto& e) { return e.first; });
+    attach(callers_, caller_storage_);
+}
+
+CallGraph& CallGraph::operator=(const CallGraph& other) {
+    if (this == &other) return *this;
+    callee_storage_ = other.callee_storage_;
+    caller_storage_ = other.caller_storage_;
+    owner_ = other.owner_;
+
+    // Borrowed spans are shared as is; owned ones follow the copied storage
+    callees_ = other.callees_;
+    callers_ = other.callers_;
+    if (other.callees_.offsets.data() == other.callee_storage_.offsets.data()) attach(callees_, callee_storage_);
+    if (other.callers_.offsets.data() == other.caller_storage_.offsets.data()) attach(callers_, caller_storage_);
+    return *this;
+}
+
+void CallGraph::clear() {
+    callees_ = {};
+    callers_ = {};
+    callee_storage_ = {};
+    caller_storage_ = {};
+    owner_.reset();
+}
+
+std::size_t CallGraph::bfs(std::span<const graph_index_t> sources,
+                           GraphDirection dir,
+                           std::uint32_t max_depth,
+                           std::vector<std::uint32_t>& depths) const {
+    const std::size_t n = node_count();
+    depths.assign(n, GRAPH_UNREACHED);
+
+    const CsrAdjacency& adj = adjacency(dir);
+
+    // Frontier is a flat queue; head advances instead of popping
+    std::vector<graph_index_t> queue;
+    queue.reserve(std::min<std::size_t>(n, 1024));
+
+    for (graph_index_t s : sources) {
+        if (s < n && depths[s] == GRAPH_UNREACHED) {
+            depths[s] = 0;
+            queue.push_back(s);
+        }
+    }
+
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const graph_index_t current = queue[head];
+        const std::uint32_t depth = depths[current];
+        if (depth >= max_depth) continue;
+
+        for (graph_index_t next : adj.neighbors(current)) {
+            if (depths[next] == GRAPH_UNREACHED) {
+                depths[next] = depth + 1;
+                queue.push_back(next);
+            }
+        }
+    }
+
+    return queue.size();
+}
+
+bool CallGraph::shortest_path(graph_index_t from, graph_index_t to,
+                              std::vector<graph_index_t>& path) const {
+    path.clear();
+    const std::size_t n = node_count();
+    if (from >= n || to >= n) return false;
+
+    if (from == to) {
+        path.push_back(from);
+        return true;
+    }
+
+    std::vector<graph_index_t> parent(n, GRAPH_NO_NODE);
+    std::vector<graph_index_t> queue;
+    queue.push_back(from);
+    parent[from] = from;
+
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const graph_index_t current = queue[head];
+        for (graph_index_t next : callees_.neighbors(current)) {
+            if (parent[next] != GRAPH_NO_NODE) continue;
+            parent[next] = current;
+            if (next == to) {
+                for (graph_index_t v = to; v != from; v = parent[v]) {
+                    path.push_back(v);
+                }
+                path.push_back(from);
+                std::reverse(path.begin(), path.end());
+                return true;
+            }
+            queue.push_back(next);
+        }
+    }
+
+    return false;
+}
+
+} // namespace synopsia
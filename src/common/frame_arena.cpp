@@ -0,0 +1,90 @@
+/// @file frame_arena.cpp
+/// @brief Per-frame bump arena implementation
+
+#include <synopsia/common/frame_arena.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace synopsia {
+
+FrameArena& FrameArena::instance() {
+    static FrameArena arena;
+    return arena;
+}
+
+void FrameArena::begin_frame() {
+    const std::uint64_t heap_now = AllocationCounter::count();
+    last_frame_.bytes = bytes_;
+    last_frame_.blocks = blocks_.empty() ? 0 : current_ + 1;
+    last_frame_.block_allocations = block_allocations_;
+    last_frame_.heap_allocations = heap_now - heap_mark_;
+
+    // A frame that spilled over gets one block that holds all of it next time
+    if (blocks_.size() > 1) {
+        std::size_t total = 0;
+        for (const auto& block : blocks_) total += block.size;
+        blocks_.clear();
+        add_block(total);
+    }
+
+    current_ = 0;
+    offset_ = 0;
+    bytes_ = 0;
+    block_allocations_ = 0;
+    heap_mark_ = AllocationCounter::count();
+}
+
+void FrameArena::add_block(std::size_t min_size) {
+    Block block;
+    block.size = std::max(min_size, INITIAL_BLOCK_SIZE);
+    block.data.reset(new std::byte[block.size]);
+    blocks_.push_back(std::move(block));
+    ++block_allocations_;
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment) {
+    size = std::max<std::size_t>(size, 1);
+    for (;;) {
+        if (current_ < blocks_.size()) {
+            Block& block = blocks_[current_];
+            const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+            const std::size_t start = ((base + offset_ + alignment - 1) & ~(alignment - 1)) - base;
+            if (start + size <= block.size) {
+                offset_ = start + size;
+                bytes_ += size;
+                return block.data.get() + start;
+            }
+            if (current_ + 1 < blocks_.size()) {
+                ++current_;
+                offset_ = 0;
+                continue;
+            }
+        }
+
+        // Grow geometrically so a large frame spills only a few times
+        const std::size_t last = blocks_.empty() ? 0 : blocks_.back().size;
+        add_block(std::max(size + alignment, last * 2));
+        current_ = blocks_.size() - 1;
+        offset_ = 0;
+    }
+}
+
+std::string_view FrameArena::copy(std::string_view text) {
+    char* out = allocate_array<char>(text.size() + 1);
+    std::memcpy(out, text.data(), text.size());
+    out[text.size()] = '\0';
+    return {out, text.size()};
+}
+
+std::string_view FrameArena::lowercase(std::string_view text) {
+    char* out = allocate_array<char>(text.size() + 1);
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        out[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+    }
+    out[text.size()] = '\0';
+    return {out, text.size()};
+}
+
+} // namespace synopsia
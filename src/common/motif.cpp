@@ -0,0 +1,870 @@
+/// @file motif.cpp
+/// @brief Motif pattern parsing, planning and parallel subgraph matching
+
+#include <synopsia/common/motif.hpp>
+#include <synopsia/common/parallel.hpp>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <unordered_map>
+
+namespace synopsia {
+
+namespace {
+
+/// Longest hop range an edge may ask for
+constexpr std::uint32_t MAX_HOPS = 8;
+
+/// Roots expanded per parallel chunk, and matches buffered before publishing
+constexpr std::size_t ROOT_GRAIN = 32;
+constexpr std::size_t PUBLISH_BATCH = 64;
+
+struct FlagName {
+    const char* name;
+    std::uint8_t bit;
+};
+
+constexpr FlagName FLAG_NAMES[] = {
+    {"leaf", MOTIF_LEAF},
+    {"root", MOTIF_ROOT},
+    {"import", MOTIF_IMPORT},
+    {"lib", MOTIF_LIBRARY},
+};
+
+/// Recursive-descent reader over the pattern text
+class Parser {
+public:
+    explicit Parser(std::string_view text) : text_(text) {}
+
+    void skip_space() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+    }
+
+    bool at_end() {
+        skip_space();
+        return pos_ >= text_.size();
+    }
+
+    /// Consume token if it comes next (after whitespace)
+    bool accept(std::string_view token) {
+        skip_space();
+        if (text_.substr(pos_, token.size()) != token) return false;
+        pos_ += token.size();
+        return true;
+    }
+
+    [[nodiscard]] char peek() {
+        skip_space();
+        return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    /// Identifier or keyword: letters, digits, '_'
+    std::string_view word() {
+        skip_space();
+        const std::size_t start = pos_;
+        while (pos_ < text_.size() &&
+               (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_')) {
+            ++pos_;
+        }
+        return text_.substr(start, pos_ - start);
+    }
+
+    /// Quoted string, or everything up to whitespace or ')'
+    bool value(std::string& out) {
+        skip_space();
+        out.clear();
+        if (pos_ < text_.size() && text_[pos_] == '"') {
+            const std::size_t close = text_.find('"', pos_ + 1);
+            if (close == std::string_view::npos) return false;
+            out.assign(text_.substr(pos_ + 1, close - pos_ - 1));
+            pos_ = close + 1;
+        } else {
+            while (pos_ < text_.size() && !std::isspace(static_cast<unsigned char>(text_[pos_])) &&
+                   text_[pos_] != ')') {
+                out.push_back(text_[pos_++]);
+            }
+        }
+        for (char& c : out) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return !out.empty();
+    }
+
+    bool number(std::uint32_t& out) {
+        skip_space();
+        const char* begin = text_.data() + pos_;
+        const auto [end, ec] = std::from_chars(begin, text_.data() + text_.size(), out);
+        if (ec != std::errc() || end == begin) return false;
+        pos_ += static_cast<std::size_t>(end - begin);
+        return true;
+    }
+
+    /// Position for error messages (1-based)
+    [[nodiscard]] std::size_t column() const noexcept { return pos_ + 1; }
+
+    /// Next word without consuming it
+    std::string_view peek_word() {
+        const std::size_t saved = pos_;
+        const std::string_view w = word();
+        pos_ = saved;
+        return w;
+    }
+
+    /// Character right after the next word (operator detection)
+    char after_word() {
+        const std::size_t saved = pos_;
+        word();
+        const char c = pos_ < text_.size() ? text_[pos_] : '\0';
+        pos_ = saved;
+        return c;
+    }
+
+private:
+    std::string_view text_;
+    std::size_t pos_ = 0;
+};
+
+bool is_keyword(std::string_view word) {
+    if (word == "name" || word == "out" || word == "in" || word == "callees") return true;
+    for (const auto& flag : FLAG_NAMES) {
+        if (word == flag.name) return true;
+    }
+    return false;
+}
+
+bool parse_flag(std::string_view word, std::uint8_t& bit) {
+    for (const auto& flag : FLAG_NAMES) {
+        if (word == flag.name) {
+            bit = flag.bit;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string at(const Parser& parser, const std::string& what) {
+    return what + " at column " + std::to_string(parser.column());
+}
+
+/// Per-thread BFS marks, reused across roots and searches
+struct Scratch {
+    std::vector<std::uint32_t> stamp;
+    std::uint32_t epoch = 0;
+    std::vector<graph_index_t> frontier;
+    std::vector<graph_index_t> next;
+
+    void begin(std::size_t node_count) {
+        if (stamp.size() != node_count) {
+            stamp.assign(node_count, 0);
+            epoch = 0;
+        }
+        if (++epoch == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    bool visit(graph_index_t node) {
+        if (stamp[node] == epoch) return false;
+        stamp[node] = epoch;
+        return true;
+    }
+};
+
+thread_local Scratch t_scratch;
+
+} // anonymous namespace
+
+// =============================================================================
+// MotifQuery
+// =============================================================================
+
+bool MotifQuery::compile(std::string_view text, std::string& error) {
+    variables_.clear();
+    edges_.clear();
+    steps_.clear();
+
+    Parser parser(text);
+    std::unordered_map<std::string, std::uint32_t> by_name;
+    std::size_t anonymous = 0;
+
+    // One node: (var terms...)
+    const auto parse_node = [&](std::uint32_t& index) -> bool {
+        if (!parser.accept("(")) {
+            error = at(parser, "Expected '('");
+            return false;
+        }
+
+        const std::string_view first = parser.peek_word();
+        const char after = parser.after_word();
+        if (!first.empty() && !std::isdigit(static_cast<unsigned char>(first[0])) && !is_keyword(first) &&
+            after != '~' && after != '=' && after != '<' && after != '>' && after != ':') {
+            const std::string name(parser.word());
+            auto [it, inserted] = by_name.try_emplace(name, static_cast<std::uint32_t>(variables_.size()));
+            if (inserted) {
+                variables_.push_back({});
+                variables_.back().name = name;
+            }
+            index = it->second;
+        } else {
+            index = static_cast<std::uint32_t>(variables_.size());
+            variables_.push_back({});
+            variables_.back().name = "_" + std::to_string(++anonymous);
+        }
+
+        while (!parser.accept(")")) {
+            if (parser.at_end()) {
+                error = at(parser, "Expected ')'");
+                return false;
+            }
+            Variable& variable = variables_[index];
+
+            // Quoted text alone is a name substring
+            if (parser.peek() == '"') {
+                if (!variable.name_text.empty() || !parser.value(variable.name_text)) {
+                    error = at(parser, "Bad or repeated name");
+                    return false;
+                }
+                continue;
+            }
+
+            const bool negate = parser.accept("!");
+            const std::string_view term = parser.word();
+            std::uint8_t bit = 0;
+            if (term.empty()) {
+                error = at(parser, "Expected a term");
+                return false;
+            }
+
+            if (parse_flag(term, bit)) {
+                (negate ? variable.forbidden : variable.required) |= bit;
+            } else if (negate) {
+                error = at(parser, "Only flags can be negated");
+                return false;
+            } else if (term == "name") {
+                const bool exact = parser.accept("=");
+                if (!exact && !parser.accept("~")) {
+                    error = at(parser, "Expected '~' or '=' after name");
+                    return false;
+                }
+                if (!variable.name_text.empty() || !parser.value(variable.name_text)) {
+                    error = at(parser, "Bad or repeated name");
+                    return false;
+                }
+                variable.name_exact = exact;
+            } else if (term == "out" || term == "in") {
+                std::uint32_t& min = term == "out" ? variable.min_out : variable.min_in;
+                std::uint32_t& max = term == "out" ? variable.max_out : variable.max_in;
+                std::uint32_t n = 0;
+                bool ok = true;
+                if (parser.accept(">=")) {
+                    ok = parser.number(n);
+                    min = std::max(min, n);
+                } else if (parser.accept("<=")) {
+                    ok = parser.number(n);
+                    max = std::min(max, n);
+                } else if (parser.accept(">")) {
+                    ok = parser.number(n) && n < UINT32_MAX;
+                    min = std::max(min, n + 1);
+                } else if (parser.accept("<")) {
+                    ok = parser.number(n) && n > 0;
+                    max = std::min(max, n - 1);
+                } else if (parser.accept("=")) {
+                    ok = parser.number(n);
+                    min = std::max(min, n);
+                    max = std::min(max, n);
+                } else {
+                    ok = false;
+                }
+                if (!ok) {
+                    error = at(parser, "Expected a comparison and a count");
+                    return false;
+                }
+            } else if (term == "callees") {
+                if (!parser.accept(":") || !parse_flag(parser.word(), bit)) {
+                    error = at(parser, "Expected callees:<flag>");
+                    return false;
+                }
+                variable.callees_required |= bit;
+            } else {
+                error = at(parser, "Unknown term '" + std::string(term) + "'");
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Edge after a node: ->, <-, -[n]->, -[m..n]->, <-[n]-, <-[m..n]-
+    const auto parse_range = [&](std::uint32_t& min, std::uint32_t& max) -> bool {
+        if (!parser.number(max)) return false;
+        min = 1;
+        if (parser.accept("..")) {
+            min = max;
+            if (!parser.number(max)) return false;
+        }
+        return parser.accept("]") && min >= 1 && min <= max && max <= MAX_HOPS;
+    };
+
+    for (;;) {
+        std::uint32_t from = 0;
+        if (!parse_node(from)) return false;
+
+        for (;;) {
+            bool reverse = false;
+            std::uint32_t min = 1;
+            std::uint32_t max = 1;
+            if (parser.accept("->")) {
+            } else if (parser.accept("<-[")) {
+                reverse = true;
+                if (!parse_range(min, max) || !parser.accept("-")) {
+                    error = at(parser, "Bad hop range (1 to 8)");
+                    return false;
+                }
+            } else if (parser.accept("<-")) {
+                reverse = true;
+            } else if (parser.accept("-[")) {
+                if (!parse_range(min, max) || !parser.accept("->")) {
+                    error = at(parser, "Bad hop range (1 to 8)");
+                    return false;
+                }
+            } else {
+                break;
+            }
+
+            std::uint32_t to = 0;
+            if (!parse_node(to)) return false;
+            if (to == from) {
+                // Self-calls are not in the call graph and a path never revisits its start
+                error = at(parser, "Self-loops are not supported: recursion is not part of the call graph");
+                return false;
+            }
+            edges_.push_back(reverse ? Edge{to, from, min, max} : Edge{from, to, min, max});
+            from = to;
+        }
+
+        if (parser.at_end()) break;
+        if (!parser.accept(",")) {
+            error = at(parser, "Expected an edge, ',' or the end");
+            return false;
+        }
+    }
+
+    return plan(error);
+}
+
+int MotifQuery::selectivity(const Variable& variable) const {
+    if (!variable.name_text.empty()) {
+        if (variable.name_exact) return 0;
+        return variable.name_text.size() >= 4 ? 1 : 2;
+    }
+    if (variable.required & (MOTIF_IMPORT | MOTIF_LIBRARY)) return 3;
+    if (variable.min_out >= 8 || variable.min_in >= 8) return 4;
+    if (variable.required || variable.forbidden || variable.callees_required || variable.min_out ||
+        variable.min_in || variable.max_out != UINT32_MAX || variable.max_in != UINT32_MAX) {
+        return 5;
+    }
+    return 6;
+}
+
+bool MotifQuery::plan(std::string& error) {
+    if (variables_.empty()) {
+        error = "Empty pattern";
+        return false;
+    }
+
+    // Distinct variables joined by direct calls need that many distinct neighbors
+    const std::size_t n = variables_.size();
+    std::vector<std::vector<std::uint32_t>> direct_out(n);
+    std::vector<std::vector<std::uint32_t>> direct_in(n);
+    std::vector<std::uint32_t> incident(n, 0);
+    for (const Edge& e : edges_) {
+        ++incident[e.from];
+        ++incident[e.to];
+        if (e.max_hops != 1) continue;
+        direct_out[e.from].push_back(e.to);
+        direct_in[e.to].push_back(e.from);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        for (auto* list : {&direct_out[i], &direct_in[i]}) {
+            std::sort(list->begin(), list->end());
+            list->erase(std::unique(list->begin(), list->end()), list->end());
+        }
+        Variable& v = variables_[i];
+        v.min_out = std::max(v.min_out, static_cast<std::uint32_t>(direct_out[i].size()));
+        v.min_in = std::max(v.min_in, static_cast<std::uint32_t>(direct_in[i].size()));
+        if (v.min_out > v.max_out || v.min_in > v.max_in || (v.required & v.forbidden)) {
+            error = "Variable " + v.name + " can never match";
+            return false;
+        }
+    }
+
+    // Most selective variable first; more edges break ties
+    const auto better = [&](std::uint32_t a, std::uint32_t b) {
+        const int sa = selectivity(variables_[a]);
+        const int sb = selectivity(variables_[b]);
+        return sa != sb ? sa < sb : incident[a] > incident[b];
+    };
+
+    std::vector<std::uint8_t> bound(n, 0);
+    std::vector<std::uint8_t> used(edges_.size(), 0);
+
+    std::uint32_t root = 0;
+    for (std::uint32_t i = 1; i < n; ++i) {
+        if (better(i, root)) root = i;
+    }
+
+    // Close every unused edge whose ends are now both bound
+    const auto close_edges = [&](Step& step) {
+        for (std::size_t e = 0; e < edges_.size(); ++e) {
+            if (used[e] || !bound[edges_[e].from] || !bound[edges_[e].to]) continue;
+            used[e] = 1;
+            step.checks.push_back(edges_[e]);
+        }
+    };
+
+    Step first{root, root, GraphDirection::Callees, 0, 0, {}};
+    bound[root] = 1;
+    close_edges(first);
+    steps_.push_back(std::move(first));
+
+    for (std::size_t k = 1; k < n; ++k) {
+        // Best unbound variable reachable over one edge, over its shortest edge
+        std::size_t pick = edges_.size();
+        std::uint32_t pick_var = 0;
+        for (std::size_t e = 0; e < edges_.size(); ++e) {
+            if (used[e]) continue;
+            const Edge& edge = edges_[e];
+            std::uint32_t candidate;
+            if (bound[edge.from] && !bound[edge.to]) {
+                candidate = edge.to;
+            } else if (bound[edge.to] && !bound[edge.from]) {
+                candidate = edge.from;
+            } else {
+                continue;
+            }
+            if (pick == edges_.size() || better(candidate, pick_var) ||
+                (candidate == pick_var && edge.max_hops < edges_[pick].max_hops)) {
+                pick = e;
+                pick_var = candidate;
+            }
+        }
+        if (pick == edges_.size()) {
+            error = "All parts of the pattern must be connected";
+            return false;
+        }
+
+        const Edge& edge = edges_[pick];
+        const bool forward = bound[edge.from] != 0;
+        Step step{pick_var, forward ? edge.from : edge.to,
+                  forward ? GraphDirection::Callees : GraphDirection::Callers,
+                  edge.min_hops, edge.max_hops, {}};
+        used[pick] = 1;
+        bound[pick_var] = 1;
+        close_edges(step);
+        steps_.push_back(std::move(step));
+    }
+    return true;
+}
+
+std::string MotifQuery::describe() const {
+    const auto predicate = [this](const Variable& v) {
+        std::string text;
+        const auto add = [&text](const std::string& term) {
+            if (!text.empty()) text += ' ';
+            text += term;
+        };
+        if (!v.name_text.empty()) add("name" + std::string(v.name_exact ? "=" : "~") + v.name_text);
+        for (const auto& flag : FLAG_NAMES) {
+            if (v.required & flag.bit) add(flag.name);
+            if (v.forbidden & flag.bit) add(std::string("!") + flag.name);
+            if (v.callees_required & flag.bit) add(std::string("callees:") + flag.name);
+        }
+        if (v.min_out) add("out>=" + std::to_string(v.min_out));
+        if (v.max_out != UINT32_MAX) add("out<=" + std::to_string(v.max_out));
+        if (v.min_in) add("in>=" + std::to_string(v.min_in));
+        if (v.max_in != UINT32_MAX) add("in<=" + std::to_string(v.max_in));
+        return text.empty() ? std::string("any") : text;
+    };
+    const auto hops = [](std::uint32_t min, std::uint32_t max) {
+        return min == max ? std::to_string(min) : std::to_string(min) + ".." + std::to_string(max);
+    };
+
+    std::string text;
+    for (std::size_t k = 0; k < steps_.size(); ++k) {
+        const Step& step = steps_[k];
+        const Variable& v = variables_[step.variable];
+        if (k == 0) {
+            text += "scan " + v.name + " [" + predicate(v) + "]\n";
+        } else {
+            text += v.name + (step.direction == GraphDirection::Callees ? " <- " : " -> ") +
+                    variables_[step.anchor].name + " in " + hops(step.min_hops, step.max_hops) + " [" +
+                    predicate(v) + "]\n";
+        }
+        for (const Edge& check : step.checks) {
+            text += "  check " + variables_[check.from].name + " -[" + hops(check.min_hops, check.max_hops) +
+                    "]-> " + variables_[check.to].name + "\n";
+        }
+    }
+    return text;
+}
+
+// =============================================================================
+// Matching
+// =============================================================================
+
+/// Backtracking matcher for one thread; expands roots one at a time
+class MotifSearch::Matcher {
+public:
+    using Emit = bool (*)(void* context, std::vector<graph_index_t>& matches);
+
+    Matcher(const CallGraph& graph, const MotifLabels& labels, const MotifQuery& query)
+        : graph_(graph), labels_(labels), query_(query) {}
+
+    /// Give up mid-root once generation moves away from expected or stop is set
+    void set_cancel(const std::atomic<std::uint64_t>* generation, std::uint64_t expected,
+                    const std::atomic<bool>* stop) {
+        generation_ = generation;
+        expected_ = expected;
+        stop_ = stop;
+    }
+
+    std::uint8_t node_flags(graph_index_t node) const {
+        std::uint8_t flags = node < labels_.flags.size() ? labels_.flags[node] : 0;
+        if (graph_.callees(node).empty()) flags |= MOTIF_LEAF;
+        if (graph_.callers(node).empty()) flags |= MOTIF_ROOT;
+        return flags;
+    }
+
+    /// Label and degree predicate of one variable
+    bool accepts(const MotifQuery::Variable& v, graph_index_t node) const {
+        const std::size_t out = graph_.callees(node).size();
+        const std::size_t in = graph_.callers(node).size();
+        if (out < v.min_out || out > v.max_out || in < v.min_in || in > v.max_in) return false;
+
+        const std::uint8_t flags = node_flags(node);
+        if ((flags & v.required) != v.required || (flags & v.forbidden) != 0) return false;
+
+        if (!v.name_text.empty()) {
+            if (node >= labels_.names.size()) return false;
+            const std::string& name = labels_.names[node];
+            if (v.name_exact ? name != v.name_text : name.find(v.name_text) == std::string::npos) return false;
+        }
+
+        if (v.callees_required) {
+            for (graph_index_t callee : graph_.callees(node)) {
+                if ((node_flags(callee) & v.callees_required) != v.callees_required) return false;
+            }
+        }
+        return true;
+    }
+
+    /// Whether `to` is within [min, max] calls of `from` (fewest hops)
+    bool within(graph_index_t from, graph_index_t to, std::uint32_t min, std::uint32_t max) const {
+        if (max == 1) {
+            const auto callees = graph_.callees(from);
+            return std::binary_search(callees.begin(), callees.end(), to);
+        }
+        bool found = false;
+        std::uint32_t depth = 0;
+        bfs(from, GraphDirection::Callees, max, [&](graph_index_t node, std::uint32_t d) {
+            if (node != to) return true;
+            found = true;
+            depth = d;
+            return false;
+        });
+        return found && depth >= min;
+    }
+
+    /// Layered BFS; fn(node, depth) returns false to stop
+    template <typename Fn>
+    void bfs(graph_index_t start, GraphDirection dir, std::uint32_t max_depth, Fn&& fn) const {
+        Scratch& s = t_scratch;
+        s.begin(graph_.node_count());
+        s.visit(start);
+        s.frontier.assign(1, start);
+        const CsrAdjacency& adjacency = graph_.adjacency(dir);
+        for (std::uint32_t depth = 1; depth <= max_depth && !s.frontier.empty(); ++depth) {
+            s.next.clear();
+            for (graph_index_t node : s.frontier) {
+                for (graph_index_t neighbor : adjacency.neighbors(node)) {
+                    if (!s.visit(neighbor)) continue;
+                    if (!fn(neighbor, depth)) return;
+                    s.next.push_back(neighbor);
+                }
+            }
+            s.frontier.swap(s.next);
+        }
+    }
+
+    /// Expand every match rooted at node; false once told to stop
+    bool expand_root(graph_index_t root, void* context, Emit emit) {
+        context_ = context;
+        emit_ = emit;
+        binding_.assign(query_.variable_count(), GRAPH_NO_NODE);
+        if (levels_.size() < query_.steps_.size()) levels_.resize(query_.steps_.size());
+
+        const auto& first = query_.steps_[0];
+        binding_[first.variable] = root;
+        const bool ok = checks_pass(first) ? extend(1) : true;
+        binding_[first.variable] = GRAPH_NO_NODE;
+        return ok && !stopped_;
+    }
+
+    /// Publish buffered matches; false if the search should stop
+    bool flush() {
+        if (matches_.empty() || stopped_) return !stopped_;
+        if (!emit_(context_, matches_)) stopped_ = true;
+        matches_.clear();
+        return !stopped_;
+    }
+
+private:
+    bool checks_pass(const MotifQuery::Step& step) const {
+        for (const auto& check : step.checks) {
+            if (!within(binding_[check.from], binding_[check.to], check.min_hops, check.max_hops)) return false;
+        }
+        return true;
+    }
+
+    bool is_bound(graph_index_t node, std::size_t steps) const {
+        for (std::size_t k = 0; k < steps; ++k) {
+            if (binding_[query_.steps_[k].variable] == node) return true;
+        }
+        return false;
+    }
+
+    bool should_stop() const {
+        if (stop_ && stop_->load(std::memory_order_relaxed)) return true;
+        return generation_ && generation_->load(std::memory_order_relaxed) != expected_;
+    }
+
+    /// Bind steps_[k] and beyond; false once told to stop
+    bool extend(std::size_t k) {
+        // A single root can branch into millions of partial bindings
+        if ((++work_ & CANCEL_CHECK_MASK) == 0 && should_stop()) {
+            stopped_ = true;
+            return false;
+        }
+
+        if (k == query_.steps_.size()) {
+            matches_.insert(matches_.end(), binding_.begin(), binding_.end());
+            if (matches_.size() >= PUBLISH_BATCH * binding_.size()) return flush();
+            return true;
+        }
+
+        const auto& step = query_.steps_[k];
+        const auto& variable = query_.variables_[step.variable];
+        const graph_index_t anchor = binding_[step.anchor];
+
+        const auto try_node = [&](graph_index_t node) {
+            if (is_bound(node, k) || !accepts(variable, node)) return true;
+            binding_[step.variable] = node;
+            const bool ok = checks_pass(step) ? extend(k + 1) : true;
+            binding_[step.variable] = GRAPH_NO_NODE;
+            return ok;
+        };
+
+        if (step.max_hops == 1) {
+            for (graph_index_t node : graph_.adjacency(step.direction).neighbors(anchor)) {
+                if (!try_node(node)) return false;
+            }
+            return true;
+        }
+
+        // The BFS scratch is shared with within(), so collect this level first
+        auto& level = levels_[k];
+        level.clear();
+        bfs(anchor, step.direction, step.max_hops, [&](graph_index_t node, std::uint32_t depth) {
+            if (depth >= step.min_hops) level.push_back(node);
+            return true;
+        });
+        for (graph_index_t node : level) {
+            if (!try_node(node)) return false;
+        }
+        return true;
+    }
+
+    /// extend() calls between cancellation checks, minus one
+    static constexpr std::uint32_t CANCEL_CHECK_MASK = 1023;
+
+    const CallGraph& graph_;
+    const MotifLabels& labels_;
+    const MotifQuery& query_;
+    const std::atomic<std::uint64_t>* generation_ = nullptr;
+    std::uint64_t expected_ = 0;
+    const std::atomic<bool>* stop_ = nullptr;
+    std::uint32_t work_ = 0;
+
+    std::vector<graph_index_t> binding_;               // Per variable
+    std::vector<std::vector<graph_index_t>> levels_;   // Multi-hop candidates per step
+    std::vector<graph_index_t> matches_;                // Buffered, variable_count() each
+    void* context_ = nullptr;
+    Emit emit_ = nullptr;
+    bool stopped_ = false;
+};
+
+// =============================================================================
+// MotifSearch
+// =============================================================================
+
+MotifSearch::~MotifSearch() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        generation_.fetch_add(1, std::memory_order_relaxed);
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void MotifSearch::submit(std::shared_ptr<const CallGraph> graph, std::shared_ptr<const MotifLabels> labels,
+                         std::shared_ptr<const MotifQuery> query, std::size_t max_matches) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto job = std::make_unique<Job>();
+        job->graph = std::move(graph);
+        job->labels = std::move(labels);
+        job->query = std::move(query);
+        job->max_matches = max_matches;
+        job->generation = generation_.fetch_add(1, std::memory_order_relaxed) + 1;
+        queued_ = std::move(job);
+
+        pending_.clear();
+        match_count_ = 0;
+        truncated_ = false;
+        running_ = true;
+        roots_total_.store(0, std::memory_order_relaxed);
+        roots_done_.store(0, std::memory_order_relaxed);
+
+        if (!worker_.joinable()) {
+            worker_ = std::thread([this] { worker_loop(); });
+        }
+    }
+    wake_.notify_one();
+}
+
+void MotifSearch::cancel() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_.fetch_add(1, std::memory_order_relaxed);
+    queued_.reset();
+    pending_.clear();
+    running_ = false;
+}
+
+bool MotifSearch::poll(std::vector<graph_index_t>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.empty()) return false;
+    out.insert(out.end(), pending_.begin(), pending_.end());
+    pending_.clear();
+    return true;
+}
+
+bool MotifSearch::is_searching() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+float MotifSearch::progress() const {
+    const std::size_t total = roots_total_.load(std::memory_order_relaxed);
+    if (total == 0) return 0.0f;
+    return static_cast<float>(roots_done_.load(std::memory_order_relaxed)) / static_cast<float>(total);
+}
+
+bool MotifSearch::truncated() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return truncated_;
+}
+
+void MotifSearch::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] { return stopping_ || queued_; });
+        if (stopping_) return;
+
+        std::unique_ptr<Job> job = std::move(queued_);
+        lock.unlock();
+        run(*job);
+        lock.lock();
+
+        if (job->generation == generation_.load(std::memory_order_relaxed)) {
+            running_ = false;
+        }
+    }
+}
+
+bool MotifSearch::publish(const Job& job, std::vector<graph_index_t>& matches) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (job.generation != generation_.load(std::memory_order_relaxed)) return false;
+
+    const std::size_t stride = job.query->variable_count();
+    const std::size_t room = job.max_matches - match_count_;
+    const std::size_t count = std::min(matches.size() / stride, room);
+    pending_.insert(pending_.end(), matches.begin(), matches.begin() + static_cast<std::ptrdiff_t>(count * stride));
+    match_count_ += count;
+    if (match_count_ >= job.max_matches) {
+        truncated_ = true;
+        return false;
+    }
+    return true;
+}
+
+void MotifSearch::run(const Job& job) {
+    const CallGraph& graph = *job.graph;
+    const MotifLabels& labels = *job.labels;
+    const MotifQuery& query = *job.query;
+    const std::size_t node_count = graph.node_count();
+    const auto cancelled = [&] { return generation_.load(std::memory_order_relaxed) != job.generation; };
+    if (query.steps_.empty() || node_count == 0 || job.max_matches == 0) return;
+
+    // Candidate roots: label and degree pruning over every node
+    const auto& root_variable = query.variables_[query.steps_[0].variable];
+    const Matcher probe(graph, labels, query);
+    std::vector<std::uint8_t> is_root(node_count, 0);
+    parallel_for_range(node_count, 4096, [&](std::size_t begin, std::size_t end) {
+        if (cancelled()) return;
+        for (std::size_t i = begin; i < end; ++i) {
+            is_root[i] = probe.accepts(root_variable, static_cast<graph_index_t>(i)) ? 1 : 0;
+        }
+    });
+    if (cancelled()) return;
+
+    std::vector<graph_index_t> roots;
+    for (std::size_t i = 0; i < node_count; ++i) {
+        if (is_root[i]) roots.push_back(static_cast<graph_index_t>(i));
+    }
+    roots_total_.store(roots.size(), std::memory_order_relaxed);
+
+    // Expand roots in parallel; each chunk streams its matches as it goes
+    struct Context {
+        MotifSearch* search;
+        const Job* job;
+    } context{this, &job};
+    const Matcher::Emit emit = [](void* ctx, std::vector<graph_index_t>& matches) {
+        auto* c = static_cast<Context*>(ctx);
+        return c->search->publish(*c->job, matches);
+    };
+
+    std::atomic<bool> stop{false};
+    parallel_for_range(roots.size(), ROOT_GRAIN, [&](std::size_t begin, std::size_t end) {
+        if (stop.load(std::memory_order_relaxed) || cancelled()) return;
+        Matcher matcher(graph, labels, query);
+        matcher.set_cancel(&generation_, job.generation, &stop);
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!matcher.expand_root(roots[i], &context, emit)) {
+                stop.store(true, std::memory_order_relaxed);
+                return;
+            }
+            if ((i & 7) == 0 && (stop.load(std::memory_order_relaxed) || cancelled())) return;
+        }
+        if (!matcher.flush()) {
+            stop.store(true, std::memory_order_relaxed);
+        }
+        if (!cancelled()) {
+            roots_done_.fetch_add(end - begin, std::memory_order_relaxed);
+        }
+    });
+}
+
+} // namespace synopsia
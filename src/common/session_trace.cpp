@@ -0,0 +1,266 @@
+/// @file session_trace.cpp
+/// @brief Session trace writer and reader
+
+#include <synopsia/common/session_trace.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace synopsia {
+
+namespace {
+
+/// Which optional fields follow a record's header
+enum FieldMask : std::uint8_t {
+    FIELD_ADDRESS = 1 << 0,
+    FIELD_X = 1 << 1,
+    FIELD_Y = 1 << 2,
+    FIELD_VALUE = 1 << 3,
+    FIELD_TEXT = 1 << 4,
+    FIELD_WIDGET = 1 << 5,
+};
+
+/// Buffered bytes that trigger a write to the file
+constexpr std::size_t FLUSH_THRESHOLD = 64 * 1024;
+
+inline std::uint64_t zigzag(std::int64_t v) noexcept {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t v) noexcept {
+    return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+void put_varint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+void put_float(std::vector<std::uint8_t>& out, float v) {
+    std::uint8_t bytes[sizeof(float)];
+    std::memcpy(bytes, &v, sizeof(float));
+    out.insert(out.end(), bytes, bytes + sizeof(float));
+}
+
+/// Cursor over a loaded trace; every read fails once the data runs out
+struct Reader {
+    const std::uint8_t* pos;
+    const std::uint8_t* end;
+    bool ok = true;
+
+    std::uint8_t byte() {
+        if (pos >= end) {
+            ok = false;
+            return 0;
+        }
+        return *pos++;
+    }
+
+    std::uint64_t varint() {
+        std::uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const std::uint8_t b = byte();
+            v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return v;
+    }
+
+    float real() {
+        float v = 0.0f;
+        if (end - pos < static_cast<std::ptrdiff_t>(sizeof(float))) {
+            ok = false;
+            return v;
+        }
+        std::memcpy(&v, pos, sizeof(float));
+        pos += sizeof(float);
+        return v;
+    }
+
+    std::string text() {
+        const std::uint64_t size = varint();
+        if (!ok || static_cast<std::uint64_t>(end - pos) < size) {
+            ok = false;
+            return {};
+        }
+        std::string s(reinterpret_cast<const char*>(pos), static_cast<std::size_t>(size));
+        pos += size;
+        return s;
+    }
+};
+
+} // anonymous namespace
+
+// =============================================================================
+// SessionTraceWriter
+// =============================================================================
+
+bool SessionTraceWriter::open(const std::string& path, const TraceMinimapLayout& minimap, std::string* error) {
+    close();
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        if (error) *error = "cannot create file";
+        return false;
+    }
+
+    SessionTraceHeader header{};
+    header.magic = SESSION_TRACE_MAGIC;
+    header.version = SESSION_TRACE_VERSION;
+    header.header_size = sizeof(SessionTraceHeader);
+    header.flags = minimap.vertical ? TRACE_FLAG_MINIMAP_VERTICAL : 0;
+    header.minimap_width = minimap.width;
+    header.minimap_height = minimap.height;
+    if (std::fwrite(&header, sizeof(header), 1, file_) != 1) {
+        if (error) *error = "write failed";
+        close();
+        return false;
+    }
+
+    widgets_.clear();
+    last_time_ = 0;
+    last_address_ = 0;
+    event_count_ = 0;
+    return true;
+}
+
+void SessionTraceWriter::close() {
+    if (!file_) return;
+    flush();
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+std::uint32_t SessionTraceWriter::widget_id(std::string_view name, std::uint64_t time_us) {
+    auto [it, inserted] = widgets_.try_emplace(std::string(name), static_cast<std::uint32_t>(widgets_.size() + 1));
+    if (inserted) {
+        TraceEvent declaration;
+        declaration.time_us = time_us;
+        declaration.kind = TraceEventKind::Widget;
+        declaration.code = static_cast<std::uint16_t>(it->second);
+        declaration.text = it->first;
+        write(declaration);
+    }
+    return it->second;
+}
+
+void SessionTraceWriter::write(const TraceEvent& event) {
+    if (!file_) return;
+
+    std::uint8_t mask = 0;
+    if (event.address != last_address_) mask |= FIELD_ADDRESS;
+    if (event.x != 0.0f) mask |= FIELD_X;
+    if (event.y != 0.0f) mask |= FIELD_Y;
+    if (event.value != 0) mask |= FIELD_VALUE;
+    if (!event.text.empty()) mask |= FIELD_TEXT;
+    if (event.widget != 0) mask |= FIELD_WIDGET;
+
+    buffer_.push_back(static_cast<std::uint8_t>(event.kind));
+    buffer_.push_back(mask);
+    put_varint(buffer_, event.time_us >= last_time_ ? event.time_us - last_time_ : 0);
+    put_varint(buffer_, event.code);
+    if (mask & FIELD_ADDRESS) {
+        put_varint(buffer_, zigzag(static_cast<std::int64_t>(event.address - last_address_)));
+        last_address_ = event.address;
+    }
+    if (mask & FIELD_X) put_float(buffer_, event.x);
+    if (mask & FIELD_Y) put_float(buffer_, event.y);
+    if (mask & FIELD_VALUE) put_varint(buffer_, zigzag(event.value));
+    if (mask & FIELD_TEXT) {
+        put_varint(buffer_, event.text.size());
+        buffer_.insert(buffer_.end(), event.text.begin(), event.text.end());
+    }
+    if (mask & FIELD_WIDGET) put_varint(buffer_, event.widget);
+
+    last_time_ = std::max(last_time_, event.time_us);
+    ++event_count_;
+    if (buffer_.size() >= FLUSH_THRESHOLD) {
+        flush();
+    }
+}
+
+void SessionTraceWriter::flush() {
+    if (!file_ || buffer_.empty()) return;
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    std::fflush(file_);
+    buffer_.clear();
+}
+
+// =============================================================================
+// SessionTrace
+// =============================================================================
+
+bool SessionTrace::load(const std::string& path, std::string* error) {
+    events_.clear();
+    widgets_.clear();
+    minimap_ = TraceMinimapLayout{};
+    version_ = 0;
+
+    auto fail = [error](const char* what) {
+        if (error) *error = what;
+        return false;
+    };
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return fail("cannot open file");
+
+    std::vector<std::uint8_t> data;
+    std::uint8_t chunk[64 * 1024];
+    std::size_t read = 0;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+    std::fclose(file);
+
+    // Version 1 headers end before the minimap fields
+    constexpr std::size_t V1_HEADER_SIZE = offsetof(SessionTraceHeader, minimap_width);
+    SessionTraceHeader header{};
+    if (data.size() < V1_HEADER_SIZE) return fail("file too small");
+    std::memcpy(&header, data.data(), V1_HEADER_SIZE);
+    if (header.magic != SESSION_TRACE_MAGIC) return fail("not a session trace");
+    if (header.version < 1 || header.version > SESSION_TRACE_VERSION) return fail("unsupported trace version");
+    if (header.header_size < V1_HEADER_SIZE || header.header_size > data.size()) return fail("bad header");
+    version_ = header.version;
+    if (header.version >= 2) {
+        if (header.header_size < sizeof(header)) return fail("bad header");
+        std::memcpy(&header, data.data(), sizeof(header));
+        minimap_.width = header.minimap_width;
+        minimap_.height = header.minimap_height;
+        minimap_.vertical = (header.flags & TRACE_FLAG_MINIMAP_VERTICAL) != 0;
+    }
+
+    Reader in{data.data() + header.header_size, data.data() + data.size()};
+    std::uint64_t time = 0;
+    std::uint64_t address = 0;
+    while (in.pos < in.end) {
+        TraceEvent event;
+        event.kind = static_cast<TraceEventKind>(in.byte());
+        const std::uint8_t mask = in.byte();
+        time += in.varint();
+        event.time_us = time;
+        event.code = static_cast<std::uint16_t>(in.varint());
+        if (mask & FIELD_ADDRESS) address += static_cast<std::uint64_t>(unzigzag(in.varint()));
+        event.address = address;
+        if (mask & FIELD_X) event.x = in.real();
+        if (mask & FIELD_Y) event.y = in.real();
+        if (mask & FIELD_VALUE) event.value = unzigzag(in.varint());
+        if (mask & FIELD_TEXT) event.text = in.text();
+        if (mask & FIELD_WIDGET) event.widget = static_cast<std::uint32_t>(in.varint());
+        if (!in.ok) break;  // Truncated tail
+
+        if (event.kind == TraceEventKind::Widget) {
+            if (event.code >= widgets_.size()) widgets_.resize(event.code + 1);
+            widgets_[event.code] = event.text;
+            continue;
+        }
+        events_.push_back(std::move(event));
+    }
+    return true;
+}
+
+} // namespace synopsia
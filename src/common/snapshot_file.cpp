@@ -0,0 +1,444 @@
+/// @file snapshot_file.cpp
+/// @brief Snapshot file writer and memory-mapped reader
+
+#include <synopsia/common/snapshot_file.hpp>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace synopsia {
+
+namespace {
+
+constexpr std::uint64_t CHECKSUM_PRIME_1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t CHECKSUM_PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+
+inline std::uint64_t rotl64(std::uint64_t x, int r) noexcept {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline std::uint64_t load_u64(const std::uint8_t* p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::size_t align_up(std::size_t value) noexcept {
+    return (value + SNAPSHOT_ALIGNMENT - 1) & ~(SNAPSHOT_ALIGNMENT - 1);
+}
+
+inline std::uint64_t zigzag(std::int64_t v) noexcept {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t v) noexcept {
+    return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+std::uint64_t read_item(const void* values, std::size_t i, std::size_t item_size) noexcept {
+    if (item_size == 4) {
+        std::uint32_t v;
+        std::memcpy(&v, static_cast<const std::uint8_t*>(values) + i * 4, 4);
+        return v;
+    }
+    std::uint64_t v;
+    std::memcpy(&v, static_cast<const std::uint8_t*>(values) + i * 8, 8);
+    return v;
+}
+
+/// Decode a DeltaVarint section into exactly raw_size bytes
+bool decode_delta_varint(std::span<const std::uint8_t> in, std::size_t item_size,
+                         std::size_t raw_size, std::vector<std::uint8_t>& out) {
+    if ((item_size != 4 && item_size != 8) || raw_size % item_size != 0) return false;
+
+    const std::size_t count = raw_size / item_size;
+    out.resize(raw_size);
+
+    std::size_t pos = 0;
+    std::uint64_t previous = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t encoded = 0;
+        int shift = 0;
+        for (;;) {
+            if (pos >= in.size() || shift > 63) return false;
+            const std::uint8_t byte = in[pos++];
+            encoded |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) break;
+            shift += 7;
+        }
+
+        const std::uint64_t value = previous + static_cast<std::uint64_t>(unzigzag(encoded));
+        if (item_size == 4) {
+            const auto v32 = static_cast<std::uint32_t>(value);
+            std::memcpy(out.data() + i * 4, &v32, 4);
+        } else {
+            std::memcpy(out.data() + i * 8, &value, 8);
+        }
+        previous = value;
+    }
+    return pos == in.size();
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Checksum / Codec
+// =============================================================================
+
+std::uint64_t snapshot_checksum(const void* data, std::size_t size) noexcept {
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    const std::uint8_t* const end = p + size;
+
+    // Four independent lanes keep the multiplier pipeline busy
+    std::uint64_t lanes[4] = {
+        CHECKSUM_PRIME_1 + CHECKSUM_PRIME_2, CHECKSUM_PRIME_2, 0, 0 - CHECKSUM_PRIME_1,
+    };
+    while (end - p >= 32) {
+        for (int l = 0; l < 4; ++l) {
+            lanes[l] = rotl64(lanes[l] + load_u64(p + l * 8) * CHECKSUM_PRIME_2, 31) * CHECKSUM_PRIME_1;
+        }
+        p += 32;
+    }
+
+    std::uint64_t h = rotl64(lanes[0], 1) + rotl64(lanes[1], 7) + rotl64(lanes[2], 12) + rotl64(lanes[3], 18);
+    h += static_cast<std::uint64_t>(size);
+    while (end - p >= 8) {
+        h ^= rotl64(load_u64(p) * CHECKSUM_PRIME_2, 31) * CHECKSUM_PRIME_1;
+        h = rotl64(h, 27) * CHECKSUM_PRIME_1 + CHECKSUM_PRIME_2;
+        p += 8;
+    }
+    while (p < end) {
+        h ^= static_cast<std::uint64_t>(*p++) * CHECKSUM_PRIME_1;
+        h = rotl64(h, 11) * CHECKSUM_PRIME_2;
+    }
+
+    h ^= h >> 33;
+    h *= CHECKSUM_PRIME_2;
+    h ^= h >> 29;
+    return h;
+}
+
+namespace snapshot_detail {
+
+std::vector<std::uint8_t> encode_delta_varint(const void* values, std::size_t count, std::size_t item_size) {
+    const std::size_t raw_size = count * item_size;
+    const std::size_t budget = raw_size - raw_size / 4;
+
+    std::vector<std::uint8_t> out;
+    out.reserve(budget);
+
+    std::uint64_t previous = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint64_t value = read_item(values, i, item_size);
+        std::uint64_t encoded = zigzag(static_cast<std::int64_t>(value - previous));
+        previous = value;
+
+        do {
+            std::uint8_t byte = encoded & 0x7F;
+            encoded >>= 7;
+            if (encoded != 0) byte |= 0x80;
+            out.push_back(byte);
+        } while (encoded != 0);
+
+        if (out.size() >= budget) return {};
+    }
+    return out;
+}
+
+} // namespace snapshot_detail
+
+// =============================================================================
+// SnapshotWriter
+// =============================================================================
+
+void SnapshotWriter::add_metadata(std::string_view key, std::string_view value) {
+    metadata_.append(key);
+    metadata_.push_back('=');
+    metadata_.append(value);
+    metadata_.push_back('\0');
+}
+
+void SnapshotWriter::add_strings(SnapshotSection offsets_id, SnapshotSection data_id,
+                                 const std::vector<std::string>& strings) {
+    std::vector<std::uint32_t> offsets;
+    std::vector<char> data;
+    offsets.reserve(strings.size() + 1);
+    offsets.push_back(0);
+    for (const auto& s : strings) {
+        data.insert(data.end(), s.begin(), s.end());
+        offsets.push_back(static_cast<std::uint32_t>(data.size()));
+    }
+    add_column<std::uint32_t>(offsets_id, offsets, false);  // Looked up per string; decoding would copy it all
+    add_column<char>(data_id, data);
+}
+
+void SnapshotWriter::add_section(SnapshotSection id, SnapshotCodec codec, std::size_t item_size,
+                                 std::size_t raw_size, std::vector<std::uint8_t>&& bytes) {
+    // Later additions replace earlier ones
+    std::erase_if(sections_, [id](const PendingSection& s) {
+        return s.entry.id == static_cast<std::uint32_t>(id);
+    });
+
+    PendingSection pending;
+    pending.entry.id = static_cast<std::uint32_t>(id);
+    pending.entry.codec = static_cast<std::uint16_t>(codec);
+    pending.entry.item_size = static_cast<std::uint16_t>(item_size);
+    pending.entry.stored_size = bytes.size();
+    pending.entry.raw_size = raw_size;
+    pending.entry.checksum = snapshot_checksum(bytes.data(), bytes.size());
+    pending.bytes = std::move(bytes);
+    sections_.push_back(std::move(pending));
+}
+
+bool SnapshotWriter::write(const std::string& path, std::string* error) const {
+    auto fail = [error](const char* what) {
+        if (error) *error = what;
+        return false;
+    };
+
+    // Metadata goes first so tools can read it from the head of the file
+    std::vector<const PendingSection*> order;
+    PendingSection metadata;
+    if (!metadata_.empty()) {
+        metadata.entry.id = static_cast<std::uint32_t>(SnapshotSection::Metadata);
+        metadata.entry.item_size = 1;
+        metadata.entry.stored_size = metadata.entry.raw_size = metadata_.size();
+        metadata.bytes.assign(metadata_.begin(), metadata_.end());
+        metadata.entry.checksum = snapshot_checksum(metadata.bytes.data(), metadata.bytes.size());
+        order.push_back(&metadata);
+    }
+    for (const auto& s : sections_) {
+        order.push_back(&s);
+    }
+
+    // Assign offsets
+    std::vector<SnapshotTocEntry> toc;
+    toc.reserve(order.size());
+    std::size_t offset = align_up(sizeof(SnapshotHeader));
+    for (const PendingSection* s : order) {
+        SnapshotTocEntry entry = s->entry;
+        entry.offset = offset;
+        toc.push_back(entry);
+        offset = align_up(offset + s->bytes.size());
+    }
+
+    SnapshotHeader header{};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.header_size = sizeof(SnapshotHeader);
+    header.toc_entry_size = sizeof(SnapshotTocEntry);
+    header.section_count = static_cast<std::uint32_t>(toc.size());
+    header.toc_offset = offset;
+    header.file_size = offset + toc.size() * sizeof(SnapshotTocEntry);
+    header.function_signature = function_signature_;
+    header.bytes_signature = bytes_signature_;
+    header.name_stamp = name_stamp_;
+    header.bytes_stamp = bytes_stamp_;
+    header.toc_checksum = snapshot_checksum(toc.data(), toc.size() * sizeof(SnapshotTocEntry));
+
+    const std::string temp_path = path + ".tmp";
+    std::FILE* file = std::fopen(temp_path.c_str(), "wb");
+    if (!file) return fail("cannot create file");
+
+    static const std::uint8_t padding[SNAPSHOT_ALIGNMENT] = {};
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    std::size_t written = sizeof(header);
+    for (std::size_t i = 0; ok && i < order.size(); ++i) {
+        const std::size_t pad = toc[i].offset - written;
+        ok = (pad == 0 || std::fwrite(padding, 1, pad, file) == pad) &&
+             (order[i]->bytes.empty() ||
+              std::fwrite(order[i]->bytes.data(), 1, order[i]->bytes.size(), file) == order[i]->bytes.size());
+        written = toc[i].offset + order[i]->bytes.size();
+    }
+    if (ok) {
+        const std::size_t pad = header.toc_offset - written;
+        ok = (pad == 0 || std::fwrite(padding, 1, pad, file) == pad) &&
+             (toc.empty() || std::fwrite(toc.data(), sizeof(SnapshotTocEntry), toc.size(), file) == toc.size());
+    }
+    ok = (std::fclose(file) == 0) && ok;
+
+    std::error_code ec;
+    if (ok) {
+        std::filesystem::rename(temp_path, path, ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        std::filesystem::remove(temp_path, ec);
+        return fail("write failed");
+    }
+    return true;
+}
+
+// =============================================================================
+// SnapshotFile
+// =============================================================================
+
+bool SnapshotFile::open(const std::string& path, std::string* error) {
+    close();
+
+    auto fail = [this, error](const char* what) {
+        if (error) *error = what;
+        close();
+        return false;
+    };
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return fail("cannot open file");
+    file_handle_ = file;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) return fail("cannot stat file");
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+    if (size_ < sizeof(SnapshotHeader)) return fail("file too small");
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) return fail("cannot map file");
+    mapping_handle_ = mapping;
+
+    base_ = static_cast<const std::uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!base_) return fail("cannot map file");
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return fail("cannot open file");
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        return fail("file too small");
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    // The mapping keeps the file alive; the descriptor is not needed afterwards
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return fail("cannot map file");
+    base_ = static_cast<const std::uint8_t*>(mapped);
+#endif
+
+    std::memcpy(&header_, base_, sizeof(SnapshotHeader));
+    if (header_.magic != SNAPSHOT_MAGIC) return fail("not a snapshot file");
+    if (header_.version != SNAPSHOT_VERSION) return fail("unsupported snapshot version");
+    if (header_.header_size != sizeof(SnapshotHeader) ||
+        header_.toc_entry_size != sizeof(SnapshotTocEntry)) {
+        return fail("unsupported snapshot layout");
+    }
+    if (header_.file_size != size_ || header_.toc_offset > size_ ||
+        (size_ - header_.toc_offset) / sizeof(SnapshotTocEntry) < header_.section_count) {
+        return fail("truncated snapshot");
+    }
+
+    const std::size_t toc_bytes = header_.section_count * sizeof(SnapshotTocEntry);
+    if (snapshot_checksum(base_ + header_.toc_offset, toc_bytes) != header_.toc_checksum) {
+        return fail("corrupt table of contents");
+    }
+
+    toc_.resize(header_.section_count);
+    std::memcpy(toc_.data(), base_ + header_.toc_offset, toc_bytes);
+    for (const auto& entry : toc_) {
+        if (entry.offset % SNAPSHOT_ALIGNMENT != 0 || entry.offset > header_.toc_offset ||
+            entry.stored_size > header_.toc_offset - entry.offset || entry.item_size == 0) {
+            return fail("corrupt table of contents");
+        }
+        if (entry.codec == static_cast<std::uint16_t>(SnapshotCodec::None) && entry.stored_size != entry.raw_size) {
+            return fail("corrupt table of contents");
+        }
+    }
+
+    states_ = std::make_unique<SectionState[]>(toc_.size());
+    return true;
+}
+
+void SnapshotFile::close() {
+    std::lock_guard lock(mutex_);
+
+#ifdef _WIN32
+    if (base_) UnmapViewOfFile(base_);
+    if (mapping_handle_) CloseHandle(static_cast<HANDLE>(mapping_handle_));
+    if (file_handle_) CloseHandle(static_cast<HANDLE>(file_handle_));
+    mapping_handle_ = nullptr;
+    file_handle_ = nullptr;
+#else
+    if (base_) ::munmap(const_cast<std::uint8_t*>(base_), size_);
+#endif
+
+    base_ = nullptr;
+    size_ = 0;
+    header_ = {};
+    toc_.clear();
+    states_.reset();
+}
+
+const SnapshotTocEntry* SnapshotFile::find(SnapshotSection id) const noexcept {
+    for (const auto& entry : toc_) {
+        if (entry.id == static_cast<std::uint32_t>(id)) return &entry;
+    }
+    return nullptr;
+}
+
+std::span<const std::uint8_t> SnapshotFile::section(SnapshotSection id) const {
+    const SnapshotTocEntry* entry = find(id);
+    if (!entry) return {};
+
+    const std::span<const std::uint8_t> stored(base_ + entry->offset, entry->stored_size);
+    SectionState& state = states_[entry - toc_.data()];
+
+    std::lock_guard lock(mutex_);
+    if (!state.loaded) {
+        state.loaded = true;
+        state.valid = snapshot_checksum(stored.data(), stored.size()) == entry->checksum;
+
+        if (state.valid && entry->codec == static_cast<std::uint16_t>(SnapshotCodec::DeltaVarint)) {
+            state.valid = decode_delta_varint(stored, entry->item_size, entry->raw_size, state.decoded);
+        } else if (state.valid && entry->codec != static_cast<std::uint16_t>(SnapshotCodec::None)) {
+            state.valid = false;
+        }
+        if (!state.valid) {
+            state.decoded.clear();
+        }
+    }
+
+    if (!state.valid) return {};
+    if (entry->codec == static_cast<std::uint16_t>(SnapshotCodec::None)) return stored;
+    return state.decoded;
+}
+
+SnapshotStrings SnapshotFile::strings(SnapshotSection offsets_id, SnapshotSection data_id) const {
+    auto offsets = column<std::uint32_t>(offsets_id);
+    auto data = column<char>(data_id);
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != data.size()) return {};
+
+    for (std::size_t i = 1; i < offsets.size(); ++i) {
+        if (offsets[i] < offsets[i - 1]) return {};
+    }
+    return {offsets, data};
+}
+
+std::string SnapshotFile::metadata(std::string_view key) const {
+    auto bytes = column<char>(SnapshotSection::Metadata);
+    std::string_view all(bytes.data(), bytes.size());
+
+    while (!all.empty()) {
+        const std::size_t end = all.find('\0');
+        const std::string_view pair = all.substr(0, end);
+        const std::size_t eq = pair.find('=');
+        if (eq != std::string_view::npos && pair.substr(0, eq) == key) {
+            return std::string(pair.substr(eq + 1));
+        }
+        if (end == std::string_view::npos) break;
+        all.remove_prefix(end + 1);
+    }
+    return {};
+}
+
+} // namespace synopsia
@@ -0,0 +1,342 @@
+/// @file analysis_cache.cpp
+/// @brief Netnode-backed analysis cache implementation
+
+#include <synopsia/core/analysis_cache.hpp>
+#include <funcs.hpp>
+#include <netnode.hpp>
+
+namespace synopsia {
+
+namespace {
+
+/// All sections share one tag; each starts at its own index range
+constexpr uchar BLOB_TAG = 'B';
+constexpr int SECTION_SHIFT = 24;
+
+nodeidx_t section_index(CacheSection section) {
+    return static_cast<nodeidx_t>(section) << SECTION_SHIFT;
+}
+
+/// Keyed sections live in a netnode of their own: key -> slot directory,
+/// slot count, and one blob per slot
+constexpr uchar DIRECTORY_TAG = 'K';
+constexpr uchar SLOT_COUNT_TAG = 'N';
+constexpr CacheSection KEYED_SECTIONS[] = {CacheSection::FlowLayouts};
+
+netnode keyed_node(CacheSection section, bool create) {
+    qstring name;
+    name.sprnt("%s %u", ANALYSIS_CACHE_NODE, static_cast<unsigned>(section));
+    return netnode(name.c_str(), 0, create);
+}
+
+/// FNV-1a over 64-bit words
+struct SignatureHasher {
+    std::uint64_t value = 14695981039346656037ULL;
+
+    void add(std::uint64_t word) {
+        for (int i = 0; i < 8; ++i) {
+            value ^= (word >> (i * 8)) & 0xFF;
+            value *= 1099511628211ULL;
+        }
+    }
+};
+
+/// Content revision counters in ANALYSIS_STAMP_NODE
+constexpr uchar STAMP_TAG = 'R';
+constexpr nodeidx_t NAME_STAMP_INDEX = 0;
+constexpr nodeidx_t BYTE_STAMP_INDEX = 1;
+
+nodeidx_t stamp_index(CacheScope scope) {
+    return scope == CacheScope::Bytes ? BYTE_STAMP_INDEX : NAME_STAMP_INDEX;
+}
+
+/// Set by byte patches not yet applied to the cache. A patch of n bytes
+/// fires n events, so they are folded into one stamp bump and one
+/// invalidation, done before the cache is next used or the IDB is saved.
+bool g_bytes_dirty = false;
+
+void flush_byte_patches() {
+    if (!g_bytes_dirty) return;
+    g_bytes_dirty = false;
+    AnalysisCache::bump_content_stamp(CacheScope::Bytes);
+    AnalysisCache::invalidate(CacheScope::Bytes);
+}
+
+/// Drops affected sections when the database changes
+class InvalidationListener : public event_listener_t {
+public:
+    ssize_t idaapi on_event(ssize_t code, va_list va) override {
+        switch (code) {
+            case idb_event::renamed: {
+                // Only function names are cached; labels and locals keep everything
+                const ea_t ea = va_arg(va, ea_t);
+                const func_t* func = get_func(ea);
+                if (func && func->start_ea == ea) {
+                    AnalysisCache::bump_content_stamp(CacheScope::Names);
+                    AnalysisCache::invalidate(CacheScope::Names);
+                }
+                break;
+            }
+            case idb_event::func_added:
+            case idb_event::deleting_func:
+            case idb_event::func_updated:
+            case idb_event::set_func_start:
+            case idb_event::set_func_end:
+            case idb_event::func_tail_appended:
+            case idb_event::func_tail_deleted:
+                AnalysisCache::invalidate(CacheScope::Functions);
+                break;
+            case idb_event::byte_patched:
+                g_bytes_dirty = true;
+                break;
+            case idb_event::savebase:
+            case idb_event::closebase:
+                flush_byte_patches();
+                break;
+            case idb_event::segm_added:
+            case idb_event::segm_deleted:
+            case idb_event::segm_moved:
+                AnalysisCache::invalidate(CacheScope::Bytes);
+                break;
+            default:
+                break;
+        }
+        return 0;
+    }
+};
+
+InvalidationListener g_listener;
+bool g_listener_hooked = false;
+
+} // anonymous namespace
+
+std::uint64_t AnalysisCache::signature(CacheScope scope) {
+    flush_byte_patches();
+    SignatureHasher hasher;
+    hasher.add(ANALYSIS_CACHE_VERSION);
+    hasher.add(static_cast<std::uint64_t>(scope));
+
+    if (scope == CacheScope::Bytes) {
+        const int count = get_segm_qty();
+        hasher.add(static_cast<std::uint64_t>(count));
+        for (int i = 0; i < count; ++i) {
+            segment_t* seg = getnseg(i);
+            if (!seg) continue;
+            hasher.add(seg->start_ea);
+            hasher.add(seg->end_ea);
+            hasher.add((static_cast<std::uint64_t>(seg->perm) << 8) | seg->type);
+        }
+    } else {
+        const std::size_t count = get_func_qty();
+        hasher.add(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            func_t* func = getn_func(i);
+            if (!func) continue;
+            hasher.add(func->start_ea);
+            hasher.add(func->end_ea);
+        }
+    }
+
+    hasher.add(content_stamp(scope));
+    return hasher.value;
+}
+
+std::uint64_t AnalysisCache::content_stamp(CacheScope scope) {
+    if (scope == CacheScope::Functions) return 0;
+    flush_byte_patches();
+    netnode node(ANALYSIS_STAMP_NODE);
+    if (node == BADNODE) return 0;
+    return node.altval(stamp_index(scope), STAMP_TAG);
+}
+
+void AnalysisCache::bump_content_stamp(CacheScope scope) {
+    if (scope == CacheScope::Functions) return;
+    netnode node(ANALYSIS_STAMP_NODE, 0, true);
+    if (node == BADNODE) return;
+    node.altset(stamp_index(scope), node.altval(stamp_index(scope), STAMP_TAG) + 1, STAMP_TAG);
+}
+
+bool AnalysisCache::write_raw(CacheSection section, const SectionHeader& header,
+                              const void* data, std::size_t size) {
+    std::vector<std::uint8_t> blob(sizeof(SectionHeader) + size);
+    std::memcpy(blob.data(), &header, sizeof(SectionHeader));
+    if (size > 0) {
+        std::memcpy(blob.data() + sizeof(SectionHeader), data, size);
+    }
+
+    netnode node;
+    if (!node.create(ANALYSIS_CACHE_NODE)) {
+        node = netnode(ANALYSIS_CACHE_NODE);
+    }
+    node.delblob(section_index(section), BLOB_TAG);
+    return node.setblob(blob.data(), blob.size(), section_index(section), BLOB_TAG);
+}
+
+bool AnalysisCache::read_raw(CacheSection section, SectionHeader& header,
+                             std::vector<std::uint8_t>& payload) {
+    flush_byte_patches();
+    netnode node(ANALYSIS_CACHE_NODE);
+    if (node == BADNODE) return false;
+
+    std::size_t size = node.blobsize(section_index(section), BLOB_TAG);
+    if (size < sizeof(SectionHeader)) return false;
+
+    std::vector<std::uint8_t> blob(size);
+    if (node.getblob(blob.data(), &size, section_index(section), BLOB_TAG) == nullptr) {
+        return false;
+    }
+
+    std::memcpy(&header, blob.data(), sizeof(SectionHeader));
+    if (header.magic != SECTION_MAGIC || header.version != ANALYSIS_CACHE_VERSION) {
+        return false;
+    }
+
+    payload.assign(blob.begin() + sizeof(SectionHeader), blob.begin() + size);
+    return true;
+}
+
+bool AnalysisCache::write_strings(CacheSection section, CacheScope scope,
+                                  const std::vector<std::string>& strings) {
+    std::vector<char> table;
+    for (const auto& s : strings) {
+        table.insert(table.end(), s.begin(), s.end());
+        table.push_back('\0');
+    }
+    return write(section, scope, table, strings.size());
+}
+
+bool AnalysisCache::read_strings(CacheSection section, CacheScope scope,
+                                 std::vector<std::string>& strings) {
+    std::vector<char> table;
+    std::uint64_t count = 0;
+    if (!read(section, scope, table, &count)) return false;
+
+    strings.clear();
+    strings.reserve(count);
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        if (table[i] == '\0') {
+            strings.emplace_back(table.data() + start, i - start);
+            start = i + 1;
+        }
+    }
+    return strings.size() == count;
+}
+
+bool AnalysisCache::write_keyed(CacheSection section, std::uint64_t key, std::uint64_t signature,
+                                const std::vector<std::uint8_t>& payload) {
+    netnode node = keyed_node(section, true);
+    if (node == BADNODE) return false;
+
+    // Rewrites reuse the key's slot
+    nodeidx_t slot = node.altval(static_cast<nodeidx_t>(key), DIRECTORY_TAG);
+    if (slot == 0) {
+        slot = node.altval(0, SLOT_COUNT_TAG) + 1;
+        node.altset(0, slot, SLOT_COUNT_TAG);
+        node.altset(static_cast<nodeidx_t>(key), slot, DIRECTORY_TAG);
+    }
+
+    SectionHeader header{};
+    header.magic = SECTION_MAGIC;
+    header.version = ANALYSIS_CACHE_VERSION;
+    header.item_size = 1;
+    header.count = payload.size();
+    header.signature = signature;
+    header.param = key;
+
+    std::vector<std::uint8_t> blob(sizeof(SectionHeader) + payload.size());
+    std::memcpy(blob.data(), &header, sizeof(SectionHeader));
+    if (!payload.empty()) {
+        std::memcpy(blob.data() + sizeof(SectionHeader), payload.data(), payload.size());
+    }
+    node.delblob(slot << SECTION_SHIFT, BLOB_TAG);
+    return node.setblob(blob.data(), blob.size(), slot << SECTION_SHIFT, BLOB_TAG);
+}
+
+bool AnalysisCache::read_keyed(CacheSection section, std::uint64_t key, std::uint64_t signature,
+                               std::vector<std::uint8_t>& payload) {
+    netnode node = keyed_node(section, false);
+    if (node == BADNODE) return false;
+
+    const nodeidx_t slot = node.altval(static_cast<nodeidx_t>(key), DIRECTORY_TAG);
+    if (slot == 0) return false;
+
+    std::size_t size = node.blobsize(slot << SECTION_SHIFT, BLOB_TAG);
+    if (size < sizeof(SectionHeader)) return false;
+
+    std::vector<std::uint8_t> blob(size);
+    if (node.getblob(blob.data(), &size, slot << SECTION_SHIFT, BLOB_TAG) == nullptr) {
+        return false;
+    }
+
+    SectionHeader header{};
+    std::memcpy(&header, blob.data(), sizeof(SectionHeader));
+    if (header.magic != SECTION_MAGIC || header.version != ANALYSIS_CACHE_VERSION ||
+        header.signature != signature || header.param != key ||
+        header.count != size - sizeof(SectionHeader)) {
+        return false;
+    }
+
+    payload.assign(blob.begin() + sizeof(SectionHeader), blob.begin() + size);
+    return true;
+}
+
+void AnalysisCache::remove(CacheSection section) {
+    netnode node(ANALYSIS_CACHE_NODE);
+    if (node == BADNODE) return;
+    node.delblob(section_index(section), BLOB_TAG);
+}
+
+void AnalysisCache::invalidate(CacheScope scope) {
+    const CacheSection name_sections[] = {CacheSection::FunctionNames, CacheSection::DemangledNames};
+    const CacheSection function_sections[] = {
+        CacheSection::FunctionRecords, CacheSection::CalleeOffsets, CacheSection::CalleeTargets,
+    };
+
+    switch (scope) {
+        case CacheScope::Functions:
+            // Names are stored in function order, so boundaries changing drops them too
+            for (CacheSection s : function_sections) {
+                remove(s);
+            }
+            [[fallthrough]];
+        case CacheScope::Names:
+            for (CacheSection s : name_sections) {
+                remove(s);
+            }
+            break;
+        case CacheScope::Bytes:
+            for (std::size_t level = 0; level < ENTROPY_PYRAMID_LEVELS; ++level) {
+                remove(static_cast<CacheSection>(static_cast<std::uint32_t>(CacheSection::EntropyLevel0) + level));
+            }
+            remove(CacheSection::ByteHistograms);
+            break;
+    }
+}
+
+void AnalysisCache::clear() {
+    netnode node(ANALYSIS_CACHE_NODE);
+    if (node != BADNODE) {
+        node.kill();
+    }
+    for (CacheSection section : KEYED_SECTIONS) {
+        netnode keyed = keyed_node(section, false);
+        if (keyed != BADNODE) {
+            keyed.kill();
+        }
+    }
+}
+
+void AnalysisCache::hook_invalidation() {
+    if (g_listener_hooked) return;
+    g_listener_hooked = hook_event_listener(HT_IDB, &g_listener);
+}
+
+void AnalysisCache::unhook_invalidation() {
+    if (!g_listener_hooked) return;
+    flush_byte_patches();
+    unhook_event_listener(HT_IDB, &g_listener);
+    g_listener_hooked = false;
+}
+
+} // namespace synopsia
@@ -0,0 +1,239 @@
+/// @file analysis_snapshot.cpp
+/// @brief Snapshot export and database snapshot mapping
+
+#include <synopsia/core/analysis_snapshot.hpp>
+#include <synopsia/entropy.hpp>
+#include <synopsia/features/binary_map_3d/map_data.hpp>
+#include <synopsia/features/function_search/function_data.hpp>
+#include <nalt.hpp>
+#include <name.hpp>
+#include <chrono>
+#include <mutex>
+
+namespace synopsia {
+
+namespace {
+
+std::mutex g_snapshot_mutex;
+std::shared_ptr<const SnapshotFile> g_snapshot;
+bool g_snapshot_probed = false;
+
+/// Entropy pyramid from the IDB cache, computed only if any level is missing
+std::vector<std::vector<EntropyBlock>> entropy_levels() {
+    std::vector<std::vector<EntropyBlock>> levels(ENTROPY_PYRAMID_LEVELS);
+    for (std::size_t level = 0; level < ENTROPY_PYRAMID_LEVELS; ++level) {
+        const auto section = static_cast<CacheSection>(
+            static_cast<std::uint32_t>(CacheSection::EntropyLevel0) + level);
+        if (!AnalysisCache::read(section, CacheScope::Bytes, levels[level])) {
+            EntropyCalculator calculator;
+            return calculator.analyze_database_levels(DEFAULT_BLOCK_SIZE, ENTROPY_PYRAMID_LEVELS);
+        }
+    }
+    return levels;
+}
+
+void add_metadata(SnapshotWriter& writer, std::size_t function_count) {
+    char buf[QMAXPATH];
+
+    writer.add_metadata("plugin_version", PLUGIN_VERSION);
+    if (get_root_filename(buf, sizeof(buf)) > 0) {
+        writer.add_metadata("input_file", buf);
+    }
+
+    uchar md5[16];
+    if (retrieve_input_file_md5(md5)) {
+        char hex[33];
+        for (int i = 0; i < 16; ++i) {
+            qsnprintf(hex + i * 2, 3, "%02x", md5[i]);
+        }
+        writer.add_metadata("input_md5", hex);
+    }
+
+    qsnprintf(buf, sizeof(buf), "%llx", static_cast<unsigned long long>(get_imagebase()));
+    writer.add_metadata("image_base", buf);
+    qsnprintf(buf, sizeof(buf), "%llx", static_cast<unsigned long long>(inf_get_min_ea()));
+    writer.add_metadata("min_ea", buf);
+    qsnprintf(buf, sizeof(buf), "%llx", static_cast<unsigned long long>(inf_get_max_ea()));
+    writer.add_metadata("max_ea", buf);
+    qsnprintf(buf, sizeof(buf), "%u", get_ptr_size());
+    writer.add_metadata("ptr_size", buf);
+    qsnprintf(buf, sizeof(buf), "%zu", function_count);
+    writer.add_metadata("function_count", buf);
+    qsnprintf(buf, sizeof(buf), "%llu", static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count()));
+    writer.add_metadata("created", buf);
+}
+
+} // anonymous namespace
+
+std::string default_snapshot_path() {
+    const char* idb = get_path(PATH_TYPE_IDB);
+    if (!idb || idb[0] == '\0') return {};
+    return std::string(idb) + SNAPSHOT_EXTENSION;
+}
+
+bool export_snapshot(const std::string& path_arg) {
+    if (!is_database_loaded()) {
+        msg("Synopsia [snapshot]: No database loaded\n");
+        return false;
+    }
+
+    const std::string path = path_arg.empty() ? default_snapshot_path() : path_arg;
+    if (path.empty()) {
+        msg("Synopsia [snapshot]: No output path\n");
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    SnapshotWriter writer;
+    writer.set_signatures(AnalysisCache::signature(CacheScope::Functions),
+                          AnalysisCache::signature(CacheScope::Bytes));
+    writer.set_stamps(AnalysisCache::content_stamp(CacheScope::Names),
+                      AnalysisCache::content_stamp(CacheScope::Bytes));
+
+    // Function catalog, metrics, layout and CSR
+    features::binary_map_3d::BinaryMapData map;
+    if (!map.refresh()) {
+        msg("Synopsia [snapshot]: No functions to export\n");
+        return false;
+    }
+
+    const auto& nodes = map.nodes();
+    const std::size_t count = nodes.size();
+    add_metadata(writer, count);
+    {
+        std::vector<std::uint64_t> address(count), end(count);
+        std::vector<std::uint32_t> size(count), depth(count), callers(count), callees(count);
+        std::vector<float> complexity(count), x(count), y(count), z(count);
+        std::vector<std::string> names(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& n = nodes[i];
+            address[i] = n.address;
+            end[i] = n.end_address;
+            size[i] = n.size;
+            depth[i] = n.call_depth;
+            callers[i] = n.caller_count;
+            callees[i] = n.callee_count;
+            complexity[i] = n.complexity;
+            x[i] = n.x;
+            y[i] = n.y;
+            z[i] = n.z;
+            names[i] = n.name;
+        }
+
+        // Columns the viewer reads stay raw so they are served straight from the mapping
+        writer.add_column<std::uint64_t>(SnapshotSection::FunctionAddress, address, false);
+        writer.add_column<std::uint64_t>(SnapshotSection::FunctionEnd, end, false);
+        writer.add_column<std::uint32_t>(SnapshotSection::FunctionSize, size, false);
+        writer.add_column<std::uint32_t>(SnapshotSection::FunctionDepth, depth, false);
+        writer.add_column<std::uint32_t>(SnapshotSection::FunctionCallers, callers, false);
+        writer.add_column<std::uint32_t>(SnapshotSection::FunctionCallees, callees, false);
+        writer.add_column<float>(SnapshotSection::FunctionComplexity, complexity);
+        writer.add_column<float>(SnapshotSection::LayoutX, x);
+        writer.add_column<float>(SnapshotSection::LayoutY, y);
+        writer.add_column<float>(SnapshotSection::LayoutZ, z);
+        writer.add_strings(SnapshotSection::NameOffsets, SnapshotSection::NameData, names);
+
+        const CsrAdjacency& callee_csr = map.graph().adjacency(GraphDirection::Callees);
+        const CsrAdjacency& caller_csr = map.graph().adjacency(GraphDirection::Callers);
+        writer.add_column<std::uint32_t>(SnapshotSection::CalleeOffsets, callee_csr.offsets, false);
+        writer.add_column<std::uint32_t>(SnapshotSection::CalleeTargets, callee_csr.targets, false);
+        writer.add_column<std::uint32_t>(SnapshotSection::CallerOffsets, caller_csr.offsets, false);
+        writer.add_column<std::uint32_t>(SnapshotSection::CallerTargets, caller_csr.targets, false);
+    }
+
+    // Demangled names (same function order; falls back per entry on mismatch)
+    {
+        features::function_search::FunctionData functions;
+        functions.refresh();
+
+        std::vector<std::string> demangled(count);
+        const bool aligned = functions.function_count() == count;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (aligned) {
+                auto info = functions.get_function(i);
+                if (info.address == static_cast<features::function_search::func_addr_t>(nodes[i].address)) {
+                    demangled[i] = std::move(info.demangled_name);
+                    continue;
+                }
+            }
+            qstring name;
+            if (get_demangled_name(&name, nodes[i].address, 0, 0) > 0) {
+                demangled[i] = name.c_str();
+            }
+        }
+        writer.add_strings(SnapshotSection::DemangledOffsets, SnapshotSection::DemangledData, demangled);
+    }
+
+    // Entropy pyramid
+    std::size_t entropy_blocks = 0;
+    {
+        const auto levels = entropy_levels();
+        for (std::size_t level = 0; level < levels.size(); ++level) {
+            const auto& blocks = levels[level];
+            std::vector<std::uint64_t> starts(blocks.size()), ends(blocks.size());
+            std::vector<double> values(blocks.size());
+            for (std::size_t i = 0; i < blocks.size(); ++i) {
+                starts[i] = blocks[i].start_ea;
+                ends[i] = blocks[i].end_ea;
+                values[i] = blocks[i].entropy;
+            }
+            writer.add_column<std::uint64_t>(snapshot_entropy_section(SnapshotSection::EntropyStart0, level), starts, false);
+            writer.add_column<std::uint64_t>(snapshot_entropy_section(SnapshotSection::EntropyEnd0, level), ends, false);
+            writer.add_column<double>(snapshot_entropy_section(SnapshotSection::EntropyValue0, level), values);
+            entropy_blocks += blocks.size();
+        }
+    }
+
+    // The mapped copy may be the file being replaced
+    close_database_snapshot();
+
+    std::string error;
+    if (!writer.write(path, &error)) {
+        msg("Synopsia [snapshot]: Failed to write %s (%s)\n", path.c_str(), error.c_str());
+        return false;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    msg("Synopsia [snapshot]: Wrote %s (%zu functions, %zu entropy blocks) in %.2fs\n",
+        path.c_str(), count, entropy_blocks, seconds);
+    return true;
+}
+
+std::shared_ptr<const SnapshotFile> database_snapshot() {
+    std::lock_guard lock(g_snapshot_mutex);
+    if (g_snapshot_probed) return g_snapshot;
+    g_snapshot_probed = true;
+
+    const std::string path = default_snapshot_path();
+    if (path.empty() || !qfileexist(path.c_str())) return nullptr;
+
+    auto snapshot = std::make_shared<SnapshotFile>();
+    std::string error;
+    if (!snapshot->open(path, &error)) {
+        msg("Synopsia [snapshot]: Ignoring %s (%s)\n", path.c_str(), error.c_str());
+        return nullptr;
+    }
+    g_snapshot = std::move(snapshot);
+    return g_snapshot;
+}
+
+bool snapshot_matches(const SnapshotFile& snapshot, CacheScope scope) {
+    // Layout signatures miss renames and patches; the content stamps catch them
+    const SnapshotHeader& header = snapshot.header();
+    if (scope == CacheScope::Bytes) {
+        return header.bytes_signature == AnalysisCache::signature(CacheScope::Bytes) &&
+               header.bytes_stamp == AnalysisCache::content_stamp(CacheScope::Bytes);
+    }
+    return header.function_signature == AnalysisCache::signature(CacheScope::Functions) &&
+           header.name_stamp == AnalysisCache::content_stamp(CacheScope::Names);
+}
+
+void close_database_snapshot() {
+    std::lock_guard lock(g_snapshot_mutex);
+    g_snapshot.reset();
+    g_snapshot_probed = false;
+}
+
+} // namespace synopsia
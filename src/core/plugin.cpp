@@ -2,15 +2,41 @@
 /// @brief Main IDA plugin entry point with feature registry
 
 #include <synopsia/core/feature_registry.hpp>
+#include <synopsia/core/script_api.hpp>
+#include <synopsia/core/analysis_cache.hpp>
+#include <synopsia/core/precompute.hpp>
+#include <synopsia/core/analysis_snapshot.hpp>
+#include <synopsia/core/query_index.hpp>
+#include <synopsia/core/session_recorder.hpp>
+#include <synopsia/core/selection.hpp>
 #include <synopsia/common/types.hpp>
 #include <synopsia/features/entropy_minimap/feature.hpp>
 #include <synopsia/features/function_search/feature.hpp>
+#include <synopsia/features/omnibox/feature.hpp>
 #include <synopsia/features/binary_map_3d/feature.hpp>
+#include <synopsia/features/self_similarity/feature.hpp>
+#include <cstring>
 
 namespace synopsia {
 
+class SynopsiaPlugin;
+
+/// @class ViewEventListener
+/// @brief HT_VIEW events, kept apart from the plugin's HT_UI listener
+///
+/// Event codes are only unique within one hook type, so each type gets its
+/// own listener and a view code can never be mistaken for a UI one.
+class ViewEventListener : public event_listener_t {
+public:
+    explicit ViewEventListener(SynopsiaPlugin& plugin) : plugin_(plugin) {}
+    ssize_t idaapi on_event(ssize_t code, va_list va) override;
+
+private:
+    SynopsiaPlugin& plugin_;
+};
+
 /// @class SynopsiaPlugin
-/// @brief Main plugin class managing all features
+/// @brief Main plugin class managing all features (listens to HT_UI)
 class SynopsiaPlugin : public plugmod_t, public event_listener_t {
 public:
     SynopsiaPlugin();
@@ -25,11 +51,16 @@ public:
     // Singleton accessor
     [[nodiscard]] static SynopsiaPlugin* instance() noexcept { return instance_; }
 
+    /// The cursor moved in a disassembly or pseudocode view
+    void on_cursor_changed(ea_t addr);
+
 private:
     bool initialize();
     void cleanup();
 
     FeatureRegistry registry_;
+    ScriptApi script_api_;
+    ViewEventListener view_events_{*this};
     bool initialized_ = false;
 
     static SynopsiaPlugin* instance_;
@@ -53,18 +84,23 @@ SynopsiaPlugin::~SynopsiaPlugin() {
 bool SynopsiaPlugin::initialize() {
     // Hook events
     hook_event_listener(HT_UI, this);
-    hook_event_listener(HT_VIEW, this);
-    hook_event_listener(HT_IDB, this);
+    hook_event_listener(HT_VIEW, &view_events_);
+    AnalysisCache::hook_invalidation();
 
     // Register features
     registry_.register_feature(std::make_unique<features::EntropyMinimapFeature>());
     registry_.register_feature(std::make_unique<features::FunctionSearchFeature>());
     registry_.register_feature(std::make_unique<features::BinaryMap3DFeature>());
+    registry_.register_feature(std::make_unique<features::OmniboxFeature>());
+    registry_.register_feature(std::make_unique<features::SelfSimilarityFeature>());
 
     // Initialize all features
     std::size_t count = registry_.initialize_all();
     msg("Synopsia %s: Plugin initialized with %zu features\n", PLUGIN_VERSION, count);
 
+    // Expose analysis engines to IDC / IDAPython
+    script_api_.install();
+
     initialized_ = true;
     return true;
 }
@@ -72,18 +108,26 @@ bool SynopsiaPlugin::initialize() {
 void SynopsiaPlugin::cleanup() {
     if (!initialized_) return;
 
+    script_api_.uninstall();
+    SessionRecorder::stop();
+
     // Cleanup all features
     registry_.cleanup_all();
 
     // Unhook events
     unhook_event_listener(HT_UI, this);
-    unhook_event_listener(HT_VIEW, this);
-    unhook_event_listener(HT_IDB, this);
+    unhook_event_listener(HT_VIEW, &view_events_);
+    AnalysisCache::unhook_invalidation();
 
     initialized_ = false;
 }
 
 bool SynopsiaPlugin::run(size_t arg) {
+    // Headless precompute (scripts / batch mode)
+    if (arg == PRECOMPUTE_RUN_ARG) {
+        return run_precompute();
+    }
+
     // Run cycles through features, showing the next one
     // For simplicity, just show/toggle based on arg or show first feature
     if (arg < registry_.count()) {
@@ -104,22 +148,51 @@ bool SynopsiaPlugin::run(size_t arg) {
     return true;
 }
 
-ssize_t SynopsiaPlugin::on_event(ssize_t code, va_list va) {
-    // UI events
+ssize_t SynopsiaPlugin::on_event(ssize_t code, va_list /*va*/) {
+    // HT_UI only; view events arrive through view_events_
+    if (code == ui_ready_to_run) {
+        // -Osynopsia:precompute requests a headless precompute pass
+        const char* options = get_plugin_options("synopsia");
+        if (options && std::strstr(options, PRECOMPUTE_OPTION)) {
+            run_precompute();
+        }
+        // -Osynopsia:snapshot writes <idb>.synsnap
+        if (options && std::strstr(options, SNAPSHOT_OPTION)) {
+            export_snapshot();
+        }
+        // -Osynopsia:trace records the session to <idb>.syntrace
+        if (options && std::strstr(options, TRACE_OPTION)) {
+            SessionRecorder::start();
+        }
+        // -Osynopsia:server starts the local query server
+        if (options && std::strstr(options, QUERY_SERVER_OPTION)) {
+            QueryIndex::refresh();
+            script_api_.server().start();
+        }
+        return 0;
+    }
+
     if (code == ui_database_closed) {
+        SessionRecorder::stop();
         registry_.broadcast_database_closed();
+        script_api_.on_database_closed();
+        close_database_snapshot();
+        SelectionChannel::reset();
         return 0;
     }
 
-    // View events
+    return 0;
+}
+
+void SynopsiaPlugin::on_cursor_changed(ea_t addr) {
+    SessionRecorder::record_cursor(addr);
+    registry_.broadcast_cursor_changed(addr);
+}
+
+ssize_t ViewEventListener::on_event(ssize_t code, va_list /*va*/) {
     if (code == view_curpos) {
-        TWidget* view = va_arg(va, TWidget*);
-        (void)view;
-        ea_t addr = get_screen_ea();
-        registry_.broadcast_cursor_changed(addr);
-        return 0;
+        plugin_.on_cursor_changed(get_screen_ea());
     }
-
     return 0;
 }
 
@@ -0,0 +1,76 @@
+/// @file precompute.cpp
+/// @brief Headless precompute pass implementation
+
+#include <synopsia/core/precompute.hpp>
+#include <synopsia/core/analysis_cache.hpp>
+#include <synopsia/entropy.hpp>
+#include <synopsia/features/binary_map_3d/map_data.hpp>
+#include <synopsia/features/function_search/function_data.hpp>
+#include <auto.hpp>
+#include <chrono>
+
+namespace synopsia {
+
+bool run_precompute(PrecomputeStats* stats) {
+    if (!is_database_loaded()) {
+        msg("Synopsia [precompute]: No database loaded\n");
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    PrecomputeStats result;
+    bool ok = true;
+
+    // Results must reflect the final analysis state
+    auto_wait();
+    AnalysisCache::clear();
+
+    // Entropy pyramid
+    {
+        EntropyCalculator calculator;
+        auto levels = calculator.analyze_database_levels(DEFAULT_BLOCK_SIZE, ENTROPY_PYRAMID_LEVELS);
+        for (std::size_t level = 0; level < levels.size(); ++level) {
+            const auto section = static_cast<CacheSection>(
+                static_cast<std::uint32_t>(CacheSection::EntropyLevel0) + level);
+            ok &= AnalysisCache::write(section, CacheScope::Bytes, levels[level],
+                                       DEFAULT_BLOCK_SIZE << level);
+            result.entropy_blocks += levels[level].size();
+        }
+        msg("Synopsia [precompute]: Entropy pyramid, %zu levels, %zu blocks\n",
+            levels.size(), result.entropy_blocks);
+
+        // Byte plot histograms (coarser levels are rebuilt on load)
+        std::size_t span_size = 0;
+        const auto spans = calculator.histogram_database(&span_size);
+        ok &= AnalysisCache::write(CacheSection::ByteHistograms, CacheScope::Bytes, spans, span_size);
+        msg("Synopsia [precompute]: Byte histograms, %zu spans of %zu bytes\n", spans.size(), span_size);
+    }
+
+    // Call graph CSR, metrics and layout
+    {
+        features::binary_map_3d::BinaryMapData map;
+        if (map.refresh()) {
+            ok &= map.store_cache();
+            result.functions = map.nodes().size();
+            result.call_edges = map.graph().edge_count();
+        } else {
+            ok = false;
+        }
+        msg("Synopsia [precompute]: Call graph, %zu functions, %zu edges\n",
+            result.functions, result.call_edges);
+    }
+
+    // Name index (demangled names; names are stored with the call graph)
+    {
+        features::function_search::FunctionData functions;
+        ok &= functions.refresh() && functions.store_cache();
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    msg("Synopsia [precompute]: %s in %.2fs\n", ok ? "Done" : "Finished with errors", result.seconds);
+
+    if (stats) *stats = result;
+    return ok;
+}
+
+} // namespace synopsia
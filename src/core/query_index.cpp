@@ -0,0 +1,131 @@
+/// @file query_index.cpp
+/// @brief Query snapshot implementation
+
+#include <synopsia/core/query_index.hpp>
+#include <cctype>
+#include <mutex>
+
+namespace synopsia {
+
+namespace {
+
+std::mutex g_mutex;
+std::shared_ptr<const QuerySnapshot> g_snapshot;
+
+/// Rebuild advanced by refresh_step (main thread only, so not under g_mutex)
+std::shared_ptr<QuerySnapshot> g_pending;
+
+/// Fold names and make a fully scanned snapshot current
+std::size_t publish(std::shared_ptr<QuerySnapshot> snap) {
+    snap->folded_names.reserve(snap->map.nodes().size());
+    for (const auto& node : snap->map.nodes()) {
+        snap->folded_names.push_back(fold_case(node.name));
+    }
+
+    const std::size_t count = snap->map.nodes().size();
+    std::lock_guard lock(g_mutex);
+    g_snapshot = std::move(snap);
+    return count;
+}
+
+} // anonymous namespace
+
+std::string fold_case(std::string_view text) {
+    std::string out(text);
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+std::vector<std::uint32_t> QuerySnapshot::search(std::string_view needle, std::uint32_t max_results) const {
+    const std::string folded = fold_case(needle);
+
+    std::vector<std::uint32_t> matches;
+    for (std::size_t i = 0; i < folded_names.size(); ++i) {
+        if (max_results != 0 && matches.size() >= max_results) break;
+        if (folded_names[i].find(folded) != std::string::npos) {
+            matches.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    return matches;
+}
+
+std::vector<std::pair<graph_index_t, float>> QuerySnapshot::similar(graph_index_t node, std::uint32_t top_k) const {
+    std::vector<std::pair<graph_index_t, float>> result;
+    const CallGraph& graph = map.graph();
+    if (node >= graph.node_count() || top_k == 0) return result;
+
+    const auto mine = graph.callees(node);
+    if (mine.empty()) return result;
+
+    // Candidates share at least one callee: walk callers of each callee
+    std::unordered_map<graph_index_t, std::uint32_t> shared;
+    for (graph_index_t callee : mine) {
+        for (graph_index_t other : graph.callers(callee)) {
+            if (other != node) ++shared[other];
+        }
+    }
+
+    result.reserve(shared.size());
+    for (const auto& [other, common] : shared) {
+        const std::size_t uni = mine.size() + graph.callees(other).size() - common;
+        result.emplace_back(other, static_cast<float>(common) / static_cast<float>(uni));
+    }
+
+    const std::size_t keep = std::min<std::size_t>(top_k, result.size());
+    std::partial_sort(result.begin(), result.begin() + keep, result.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.second != b.second ? a.second > b.second : a.first < b.first;
+                      });
+    result.resize(keep);
+    return result;
+}
+
+std::shared_ptr<const QuerySnapshot> QueryIndex::current() {
+    std::lock_guard lock(g_mutex);
+    return g_snapshot;
+}
+
+std::shared_ptr<const QuerySnapshot> QueryIndex::require() {
+    auto snap = current();
+    if (!snap) {
+        refresh();
+        snap = current();
+    }
+    return snap;
+}
+
+std::size_t QueryIndex::refresh() {
+    g_pending.reset();
+    auto snap = std::make_shared<QuerySnapshot>();
+    if (!snap->map.refresh()) {
+        reset();
+        return 0;
+    }
+    return publish(std::move(snap));
+}
+
+bool QueryIndex::refresh_step(std::chrono::milliseconds budget) {
+    if (!g_pending) {
+        g_pending = std::make_shared<QuerySnapshot>();
+        if (!g_pending->map.begin_refresh()) {
+            reset();
+            return true;
+        }
+    }
+
+    if (!g_pending->map.scan_step(budget)) {
+        return false;
+    }
+    publish(std::move(g_pending));
+    g_pending.reset();
+    return true;
+}
+
+void QueryIndex::reset() {
+    g_pending.reset();
+    std::lock_guard lock(g_mutex);
+    g_snapshot.reset();
+}
+
+} // namespace synopsia
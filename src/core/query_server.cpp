@@ -0,0 +1,776 @@
+/// @file query_server.cpp
+/// @brief Local query server implementation
+
+#include <synopsia/core/query_server.hpp>
+#include <synopsia/core/query_index.hpp>
+#include <synopsia/entropy.hpp>
+#include <funcs.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <sddl.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace synopsia {
+
+namespace {
+
+// =============================================================================
+// Payload Helpers
+// =============================================================================
+
+class ByteReader {
+public:
+    ByteReader(const std::uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    bool read(T& out) {
+        if (pos_ + sizeof(T) > size_) return false;
+        std::memcpy(&out, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    std::string_view rest() const {
+        return {reinterpret_cast<const char*>(data_ + pos_), size_ - pos_};
+    }
+
+private:
+    const std::uint8_t* data_;
+    std::size_t size_;
+    std::size_t pos_ = 0;
+};
+
+class ByteWriter {
+public:
+    template <typename T>
+    void write(const T& value) {
+        const auto* p = reinterpret_cast<const std::uint8_t*>(&value);
+        bytes.insert(bytes.end(), p, p + sizeof(T));
+    }
+
+    void write_bytes(const void* data, std::size_t size) {
+        const auto* p = static_cast<const std::uint8_t*>(data);
+        bytes.insert(bytes.end(), p, p + size);
+    }
+
+    std::vector<std::uint8_t> bytes;
+};
+
+struct Reply {
+    QueryStatus status = QueryStatus::Ok;
+    std::vector<std::uint8_t> payload;
+};
+
+Reply error_reply(QueryStatus status) {
+    Reply r;
+    r.status = status;
+    return r;
+}
+
+// =============================================================================
+// Main Thread Marshalling
+// =============================================================================
+
+struct MainThreadCall;
+struct MainThreadRequest;
+
+} // anonymous namespace
+
+/// Main-thread requests a server has queued; stop() cancels the ones still waiting
+struct MainThreadQueue {
+    struct Pending {
+        MainThreadRequest* request;          // Owned by the kernel until it runs or is cancelled
+        std::shared_ptr<MainThreadCall> call;
+    };
+
+    std::atomic<bool> alive{true};  // false once the server has stopped
+    std::mutex mutex;
+    std::unordered_map<int, Pending> pending;  // By execute_sync request id
+
+    /// Cancel everything not yet run (main thread, after the server thread has exited)
+    void cancel_all();
+};
+
+namespace {
+
+using QueueRef = std::shared_ptr<MainThreadQueue>;
+
+/// Shared between the server thread and a queued main-thread request.
+/// The request may outlive the waiting server thread (shutdown), so all
+/// inputs and outputs live here rather than on the caller's stack.
+struct MainThreadCall {
+    std::function<Reply()> work;
+    QueueRef queue;
+    Reply reply;
+    bool done = false;
+    bool released = false;  // The request object has been destroyed
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+struct MainThreadRequest : exec_request_t {
+    explicit MainThreadRequest(std::shared_ptr<MainThreadCall> c) : call(std::move(c)) {}
+
+    ~MainThreadRequest() override {
+        std::lock_guard lock(call->mutex);
+        call->released = true;
+    }
+
+    ssize_t idaapi execute() override {
+        // Queued with MFF_NOWAIT, so the server may have stopped since
+        Reply reply = call->queue->alive.load() ? call->work() : error_reply(QueryStatus::ShuttingDown);
+        {
+            std::lock_guard lock(call->mutex);
+            call->reply = std::move(reply);
+            call->done = true;
+        }
+        call->cv.notify_all();
+        return 0;
+    }
+
+    std::shared_ptr<MainThreadCall> call;
+};
+
+/// Run work on the main thread; gives up with ShuttingDown when stopping.
+/// MFF_NOWAIT requests are heap-allocated and owned by the kernel once queued;
+/// the id stays registered until the reply arrives, so stop() can cancel it.
+Reply run_on_main(std::function<Reply()> work, const std::atomic<bool>& stopping, const QueueRef& queue) {
+    auto call = std::make_shared<MainThreadCall>();
+    call->work = std::move(work);
+    call->queue = queue;
+
+    int id;
+    {
+        std::lock_guard lock(queue->mutex);
+        auto* request = new MainThreadRequest(call);
+        id = execute_sync(*request, MFF_READ | MFF_NOWAIT);
+        queue->pending[id] = {request, call};
+    }
+
+    {
+        std::unique_lock lock(call->mutex);
+        while (!call->done) {
+            if (stopping.load()) return error_reply(QueryStatus::ShuttingDown);  // Left for stop() to cancel
+            call->cv.wait_for(lock, std::chrono::milliseconds(100));
+        }
+    }
+
+    std::lock_guard lock(queue->mutex);
+    queue->pending.erase(id);
+    return std::move(call->reply);
+}
+
+// =============================================================================
+// Request Handlers
+// =============================================================================
+
+Reply handle_request(QueryOp op, ByteReader& in, const std::atomic<bool>& stopping, const QueueRef& queue) {
+    ByteWriter out;
+    Reply reply;
+
+    // Requests that need IDA go through the main thread
+    switch (op) {
+        case QueryOp::Refresh:
+            return run_on_main([]() {
+                ByteWriter w;
+                w.write(static_cast<std::uint64_t>(QueryIndex::refresh()));
+                return Reply{QueryStatus::Ok, std::move(w.bytes)};
+            }, stopping, queue);
+
+        case QueryOp::EntropyRange: {
+            std::uint64_t start = 0, end = 0;
+            std::uint32_t block = 0, reserved = 0;
+            if (!in.read(start) || !in.read(end) || !in.read(block) || !in.read(reserved) || start >= end) {
+                return error_reply(QueryStatus::BadRequest);
+            }
+            const std::size_t block_size = std::clamp<std::size_t>(block, MIN_BLOCK_SIZE, MAX_BLOCK_SIZE);
+            if ((end - start) / block_size >= QUERY_MAX_ENTROPY_BLOCKS) {
+                return error_reply(QueryStatus::TooLarge);
+            }
+            return run_on_main([start, end, block_size]() {
+                EntropyCalculator calculator;
+                const auto blocks = calculator.analyze_range(static_cast<ea_t>(start), static_cast<ea_t>(end), block_size);
+                ByteWriter w;
+                for (const auto& b : blocks) w.write(b.entropy);
+                return Reply{QueryStatus::Ok, std::move(w.bytes)};
+            }, stopping, queue);
+        }
+
+        case QueryOp::FunctionInfo: {
+            std::uint64_t ea = 0;
+            if (!in.read(ea)) return error_reply(QueryStatus::BadRequest);
+            return run_on_main([ea]() {
+                func_t* func = get_func(static_cast<ea_t>(ea));
+                if (!func) return error_reply(QueryStatus::NotFound);
+
+                qstring name;
+                get_func_name(&name, func->start_ea);
+
+                std::uint32_t callers = 0, callees = 0, depth = 0;
+                if (auto snap = QueryIndex::current()) {
+                    if (const auto* node = snap->map.find_node(func->start_ea)) {
+                        callers = node->caller_count;
+                        callees = node->callee_count;
+                        depth = node->call_depth;
+                    }
+                }
+
+                ByteWriter w;
+                w.write(static_cast<std::uint64_t>(func->start_ea));
+                w.write(static_cast<std::uint64_t>(func->end_ea));
+                w.write(callers);
+                w.write(callees);
+                w.write(depth);
+                w.write(static_cast<std::uint32_t>(name.length()));
+                w.write_bytes(name.c_str(), name.length());
+                return Reply{QueryStatus::Ok, std::move(w.bytes)};
+            }, stopping, queue);
+        }
+
+        default:
+            break;
+    }
+
+    // Everything else is answered here from the published snapshot
+    auto snap = QueryIndex::current();
+
+    switch (op) {
+        case QueryOp::Ping:
+            out.write(static_cast<std::uint32_t>(QUERY_PROTOCOL_VERSION));
+            out.write(std::uint32_t{0});
+            out.write(static_cast<std::uint64_t>(snap ? snap->map.nodes().size() : 0));
+            break;
+
+        case QueryOp::Search: {
+            if (!snap) return error_reply(QueryStatus::NotReady);
+            std::uint32_t max_results = 0;
+            if (!in.read(max_results)) return error_reply(QueryStatus::BadRequest);
+            for (std::uint32_t idx : snap->search(in.rest(), max_results)) {
+                out.write(static_cast<std::uint64_t>(snap->map.nodes()[idx].address));
+                out.write(idx);
+                out.write(std::uint32_t{0});
+            }
+            break;
+        }
+
+        case QueryOp::Reach: {
+            if (!snap) return error_reply(QueryStatus::NotReady);
+            std::uint64_t ea = 0;
+            std::uint32_t dir = 0, max_depth = 0;
+            if (!in.read(ea) || !in.read(dir) || !in.read(max_depth)) {
+                return error_reply(QueryStatus::BadRequest);
+            }
+            const graph_index_t src = snap->map.index_of(static_cast<ea_t>(ea));
+            if (src == GRAPH_NO_NODE) return error_reply(QueryStatus::NotFound);
+
+            std::vector<std::uint32_t> depths;
+            const graph_index_t sources[] = {src};
+            snap->map.graph().bfs(sources, dir == 0 ? GraphDirection::Callees : GraphDirection::Callers,
+                                  max_depth, depths);
+            for (std::size_t i = 0; i < depths.size(); ++i) {
+                if (depths[i] == GRAPH_UNREACHED) continue;
+                out.write(static_cast<std::uint64_t>(snap->map.nodes()[i].address));
+                out.write(depths[i]);
+                out.write(std::uint32_t{0});
+            }
+            break;
+        }
+
+        case QueryOp::Path: {
+            if (!snap) return error_reply(QueryStatus::NotReady);
+            std::uint64_t from = 0, to = 0;
+            if (!in.read(from) || !in.read(to)) return error_reply(QueryStatus::BadRequest);
+            const graph_index_t a = snap->map.index_of(static_cast<ea_t>(from));
+            const graph_index_t b = snap->map.index_of(static_cast<ea_t>(to));
+            if (a == GRAPH_NO_NODE || b == GRAPH_NO_NODE) return error_reply(QueryStatus::NotFound);
+
+            std::vector<graph_index_t> path;
+            snap->map.graph().shortest_path(a, b, path);
+            for (graph_index_t idx : path) {
+                out.write(static_cast<std::uint64_t>(snap->map.nodes()[idx].address));
+            }
+            break;
+        }
+
+        case QueryOp::Similar: {
+            if (!snap) return error_reply(QueryStatus::NotReady);
+            std::uint64_t ea = 0;
+            std::uint32_t top_k = 0, reserved = 0;
+            if (!in.read(ea) || !in.read(top_k) || !in.read(reserved)) {
+                return error_reply(QueryStatus::BadRequest);
+            }
+            const graph_index_t node = snap->map.index_of(static_cast<ea_t>(ea));
+            if (node == GRAPH_NO_NODE) return error_reply(QueryStatus::NotFound);
+
+            for (const auto& [idx, score] : snap->similar(node, top_k)) {
+                out.write(static_cast<std::uint64_t>(snap->map.nodes()[idx].address));
+                out.write(score);
+                out.write(std::uint32_t{0});
+            }
+            break;
+        }
+
+        default:
+            return error_reply(QueryStatus::Unsupported);
+    }
+
+    reply.payload = std::move(out.bytes);
+    return reply;
+}
+
+// =============================================================================
+// Platform Transport
+// =============================================================================
+
+#ifdef _WIN32
+
+using conn_t = HANDLE;
+
+bool io_read(conn_t conn, void* data, std::size_t size) {
+    auto* p = static_cast<std::uint8_t*>(data);
+    while (size > 0) {
+        DWORD got = 0;
+        if (!ReadFile(conn, p, static_cast<DWORD>(size), &got, nullptr) || got == 0) return false;
+        p += got;
+        size -= got;
+    }
+    return true;
+}
+
+bool io_write(conn_t conn, const void* data, std::size_t size) {
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    while (size > 0) {
+        DWORD put = 0;
+        if (!WriteFile(conn, p, static_cast<DWORD>(size), &put, nullptr) || put == 0) return false;
+        p += put;
+        size -= put;
+    }
+    return true;
+}
+
+/// Shared memory published to one client; released on next request or disconnect
+struct SharedBlock {
+    HANDLE mapping = nullptr;
+
+    void release() {
+        if (mapping) CloseHandle(mapping);
+        mapping = nullptr;
+    }
+};
+
+bool publish_shared(SharedBlock& block, const std::vector<std::uint8_t>& data, QueryShmDescriptor& desc) {
+    static std::atomic<std::uint32_t> counter{0};
+    std::snprintf(desc.name, sizeof(desc.name), "Local\\synopsia-%lu-%u",
+                  static_cast<unsigned long>(GetCurrentProcessId()), counter.fetch_add(1));
+    desc.size = data.size();
+
+    const auto size64 = static_cast<std::uint64_t>(data.size());
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64),
+                                        desc.name);
+    if (!mapping) return false;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, data.size());
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+    std::memcpy(view, data.data(), data.size());
+    UnmapViewOfFile(view);
+
+    block.release();
+    block.mapping = mapping;
+    return true;
+}
+
+/// Security descriptor granting the current user, and nobody else, access
+struct OwnerOnlySecurity {
+    PSECURITY_DESCRIPTOR descriptor = nullptr;
+    SECURITY_ATTRIBUTES attributes{};
+
+    OwnerOnlySecurity() {
+        HANDLE token = nullptr;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &token)) return;
+
+        DWORD size = 0;
+        GetTokenInformation(token, TokenUser, nullptr, 0, &size);
+        std::vector<std::uint8_t> buffer(size);
+        char* sid = nullptr;
+        if (size > 0 && GetTokenInformation(token, TokenUser, buffer.data(), size, &size) &&
+            ConvertSidToStringSidA(reinterpret_cast<TOKEN_USER*>(buffer.data())->User.Sid, &sid)) {
+            // Protected DACL with a single allow entry for the user
+            const std::string sddl = std::string("D:P(A;;GA;;;") + sid + ")";
+            ConvertStringSecurityDescriptorToSecurityDescriptorA(sddl.c_str(), SDDL_REVISION_1, &descriptor, nullptr);
+            LocalFree(sid);
+        }
+        CloseHandle(token);
+
+        attributes.nLength = sizeof(attributes);
+        attributes.lpSecurityDescriptor = descriptor;
+        attributes.bInheritHandle = FALSE;
+    }
+
+    ~OwnerOnlySecurity() {
+        if (descriptor) LocalFree(descriptor);
+    }
+
+    OwnerOnlySecurity(const OwnerOnlySecurity&) = delete;
+    OwnerOnlySecurity& operator=(const OwnerOnlySecurity&) = delete;
+
+    [[nodiscard]] bool valid() const noexcept { return descriptor != nullptr; }
+};
+
+#else
+
+using conn_t = int;
+
+bool io_read(conn_t conn, void* data, std::size_t size) {
+    auto* p = static_cast<std::uint8_t*>(data);
+    while (size > 0) {
+        const ssize_t got = ::recv(conn, p, size, 0);
+        if (got <= 0) return false;
+        p += got;
+        size -= static_cast<std::size_t>(got);
+    }
+    return true;
+}
+
+bool io_write(conn_t conn, const void* data, std::size_t size) {
+#ifdef MSG_NOSIGNAL
+    constexpr int send_flags = MSG_NOSIGNAL;
+#else
+    constexpr int send_flags = 0;
+#endif
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    while (size > 0) {
+        const ssize_t put = ::send(conn, p, size, send_flags);
+        if (put <= 0) return false;
+        p += put;
+        size -= static_cast<std::size_t>(put);
+    }
+    return true;
+}
+
+/// Shared memory published to one client; unlinked if the client didn't
+struct SharedBlock {
+    std::string name;
+
+    void release() {
+        if (!name.empty()) shm_unlink(name.c_str());
+        name.clear();
+    }
+};
+
+bool publish_shared(SharedBlock& block, const std::vector<std::uint8_t>& data, QueryShmDescriptor& desc) {
+    static std::atomic<std::uint32_t> counter{0};
+    std::snprintf(desc.name, sizeof(desc.name), "/synopsia-%ld-%u",
+                  static_cast<long>(getpid()), counter.fetch_add(1));
+    desc.size = data.size();
+
+    const int fd = shm_open(desc.name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return false;
+
+    bool ok = ftruncate(fd, static_cast<off_t>(data.size())) == 0;
+    if (ok) {
+        void* view = mmap(nullptr, data.size(), PROT_WRITE, MAP_SHARED, fd, 0);
+        ok = view != MAP_FAILED;
+        if (ok) {
+            std::memcpy(view, data.data(), data.size());
+            munmap(view, data.size());
+        }
+    }
+    close(fd);
+
+    if (!ok) {
+        shm_unlink(desc.name);
+        return false;
+    }
+
+    block.release();
+    block.name = desc.name;
+    return true;
+}
+
+/// Remove a socket left behind at path; refuses anything that isn't a socket
+bool remove_stale_socket(const std::string& path) {
+    struct stat st {};
+    if (::lstat(path.c_str(), &st) != 0) return errno == ENOENT;
+    if (!S_ISSOCK(st.st_mode)) return false;
+    return ::unlink(path.c_str()) == 0;
+}
+
+#endif
+
+/// Read one request, answer it; false when the connection should close
+bool serve_one(conn_t conn, SharedBlock& shared, const std::atomic<bool>& stopping, const QueueRef& queue) {
+    QueryRequestHeader header{};
+    if (!io_read(conn, &header, sizeof(header))) return false;
+    if (header.magic != QUERY_MAGIC || header.length > QUERY_MAX_REQUEST) return false;
+
+    std::vector<std::uint8_t> payload(header.length);
+    if (header.length > 0 && !io_read(conn, payload.data(), payload.size())) return false;
+
+    // The client has had its chance to claim the previous block
+    shared.release();
+
+    Reply reply;
+    if (header.version != QUERY_PROTOCOL_VERSION) {
+        reply = error_reply(QueryStatus::Unsupported);
+    } else {
+        ByteReader in(payload.data(), payload.size());
+        reply = handle_request(static_cast<QueryOp>(header.opcode), in, stopping, queue);
+    }
+
+
+    QueryResponseHeader response{};
+    response.magic = QUERY_MAGIC;
+    response.status = static_cast<std::uint16_t>(reply.status);
+    response.request_id = header.request_id;
+
+    QueryShmDescriptor desc{};
+    const void* body = reply.payload.data();
+    std::size_t body_size = reply.payload.size();
+
+    if (body_size > QUERY_SHM_THRESHOLD && publish_shared(shared, reply.payload, desc)) {
+        response.flags = QUERY_FLAG_SHARED_MEMORY;
+        body = &desc;
+        body_size = sizeof(desc);
+    } else if (body_size > UINT32_MAX) {
+        // Shared memory failed and the length field can't describe the payload
+        response.status = static_cast<std::uint16_t>(QueryStatus::TooLarge);
+        body_size = 0;
+    }
+    response.length = static_cast<std::uint32_t>(body_size);
+
+    return io_write(conn, &response, sizeof(response)) &&
+           (body_size == 0 || io_write(conn, body, body_size));
+}
+
+} // anonymous namespace
+
+void MainThreadQueue::cancel_all() {
+    std::lock_guard lock(mutex);
+    for (auto& [id, entry] : pending) {
+        if (!cancel_exec_request(id)) continue;  // Already ran; the kernel freed it
+
+        bool released;
+        {
+            std::lock_guard call_lock(entry.call->mutex);
+            released = entry.call->released;
+        }
+        if (!released) delete entry.request;
+    }
+    pending.clear();
+}
+
+// =============================================================================
+// QueryServer
+// =============================================================================
+
+#ifdef _WIN32
+
+std::string QueryServer::default_endpoint() {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "\\\\.\\pipe\\synopsia-%lu", static_cast<unsigned long>(GetCurrentProcessId()));
+    return buf;
+}
+
+bool QueryServer::start(const std::string& endpoint) {
+    if (running_.load()) return true;
+
+    endpoint_ = endpoint.empty() ? default_endpoint() : endpoint;
+    main_queue_ = std::make_shared<MainThreadQueue>();
+    stopping_.store(false);
+    running_.store(true);
+    thread_ = std::thread(&QueryServer::serve, this);
+
+    msg("Synopsia [server]: Listening on %s\n", endpoint_.c_str());
+    return true;
+}
+
+void QueryServer::stop() {
+    if (!running_.load()) return;
+
+    stopping_.store(true);
+    main_queue_->alive.store(false);
+
+    // Unblock ConnectNamedPipe / ReadFile
+    HANDLE pipe = reinterpret_cast<HANDLE>(listen_handle_.load());
+    if (pipe != INVALID_HANDLE_VALUE && pipe != nullptr) {
+        CancelIoEx(pipe, nullptr);
+    }
+    HANDLE wake = CreateFileA(endpoint_.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+    if (wake != INVALID_HANDLE_VALUE) CloseHandle(wake);
+
+    if (thread_.joinable()) thread_.join();
+    main_queue_->cancel_all();  // Nothing queued may run on a stopped server
+    running_.store(false);
+    msg("Synopsia [server]: Stopped\n");
+}
+
+void QueryServer::serve() {
+    const QueueRef queue = main_queue_;
+    OwnerOnlySecurity security;
+    if (!security.valid()) {
+        msg("Synopsia [server]: Failed to build the pipe security descriptor\n");
+        return;
+    }
+
+    // One client at a time; each connection gets a fresh pipe instance. The
+    // first-instance flag fails if someone else already created the name.
+    while (!stopping_.load()) {
+        HANDLE pipe = CreateNamedPipeA(endpoint_.c_str(), PIPE_ACCESS_DUPLEX | FILE_FLAG_FIRST_PIPE_INSTANCE,
+                                       PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                                       1, 64 * 1024, 64 * 1024, 0, &security.attributes);
+        if (pipe == INVALID_HANDLE_VALUE) break;
+        listen_handle_ = reinterpret_cast<std::intptr_t>(pipe);
+
+        const bool connected = ConnectNamedPipe(pipe, nullptr) || GetLastError() == ERROR_PIPE_CONNECTED;
+        SharedBlock shared;
+        if (connected && !stopping_.load()) {
+            while (!stopping_.load() && serve_one(pipe, shared, stopping_, queue)) {
+            }
+        }
+        shared.release();
+
+        listen_handle_ = -1;
+        DisconnectNamedPipe(pipe);
+        CloseHandle(pipe);
+    }
+}
+
+#else
+
+std::string QueryServer::default_endpoint() {
+    const char* dir = std::getenv("TMPDIR");
+    std::string path = (dir && *dir) ? dir : "/tmp";
+    if (path.back() != '/') path += '/';
+    path += "synopsia-" + std::to_string(static_cast<long>(getpid())) + ".sock";
+    return path;
+}
+
+bool QueryServer::start(const std::string& endpoint) {
+    if (running_.load()) return true;
+
+    endpoint_ = endpoint.empty() ? default_endpoint() : endpoint;
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (endpoint_.size() >= sizeof(addr.sun_path)) {
+        msg("Synopsia [server]: Socket path too long: %s\n", endpoint_.c_str());
+        return false;
+    }
+    std::memcpy(addr.sun_path, endpoint_.c_str(), endpoint_.size() + 1);
+
+    if (!remove_stale_socket(endpoint_)) {
+        msg("Synopsia [server]: %s exists and is not a socket\n", endpoint_.c_str());
+        return false;
+    }
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+
+    // Create the socket owner-only from the start, not chmod'ed after the fact
+    const mode_t old_mask = ::umask(077);
+    const bool bound = ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    ::umask(old_mask);
+    if (!bound || ::listen(fd, 8) != 0) {
+        msg("Synopsia [server]: Failed to listen on %s\n", endpoint_.c_str());
+        ::close(fd);
+        return false;
+    }
+
+    listen_handle_ = fd;
+    main_queue_ = std::make_shared<MainThreadQueue>();
+    stopping_.store(false);
+    running_.store(true);
+    thread_ = std::thread(&QueryServer::serve, this);
+
+    msg("Synopsia [server]: Listening on %s\n", endpoint_.c_str());
+    return true;
+}
+
+void QueryServer::stop() {
+    if (!running_.load()) return;
+
+    stopping_.store(true);
+    main_queue_->alive.store(false);
+    if (thread_.joinable()) thread_.join();
+    main_queue_->cancel_all();  // Nothing queued may run on a stopped server
+
+    ::close(static_cast<int>(listen_handle_.load()));
+    remove_stale_socket(endpoint_);
+    listen_handle_ = -1;
+    running_.store(false);
+    msg("Synopsia [server]: Stopped\n");
+}
+
+void QueryServer::serve() {
+    const QueueRef queue = main_queue_;
+
+    struct Client {
+        int fd;
+        SharedBlock shared;
+    };
+    std::vector<Client> clients;
+
+    while (!stopping_.load()) {
+        std::vector<pollfd> fds;
+        fds.push_back({static_cast<int>(listen_handle_.load()), POLLIN, 0});
+        for (const auto& c : clients) {
+            fds.push_back({c.fd, POLLIN, 0});
+        }
+
+        // Short timeout so stop() is noticed promptly
+        if (::poll(fds.data(), fds.size(), 200) <= 0) continue;
+
+        if (fds[0].revents & POLLIN) {
+            const int fd = ::accept(static_cast<int>(listen_handle_.load()), nullptr, nullptr);
+            if (fd >= 0) {
+                // Bound how long a stalled client can hold the thread
+                timeval timeout{2, 0};
+                ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+                clients.push_back({fd, {}});
+            }
+        }
+
+        for (std::size_t i = fds.size() - 1; i >= 1; --i) {
+            if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) == 0) continue;
+
+            Client& client = clients[i - 1];
+            if (!serve_one(client.fd, client.shared, stopping_, queue)) {
+                client.shared.release();
+                ::close(client.fd);
+                clients.erase(clients.begin() + static_cast<std::ptrdiff_t>(i - 1));
+            }
+        }
+    }
+
+    for (auto& c : clients) {
+        c.shared.release();
+        ::close(c.fd);
+    }
+}
+
+#endif
+
+} // namespace synopsia
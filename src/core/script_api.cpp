@@ -0,0 +1,525 @@
+/// @file script_api.cpp
+/// @brief IDC bindings and ctypes C ABI over the analysis engines
+
+#include <synopsia/core/script_api.hpp>
+#include <synopsia/core/precompute.hpp>
+#include <synopsia/core/analysis_snapshot.hpp>
+#include <synopsia/entropy.hpp>
+#include <synopsia/score_image.hpp>
+#include <synopsia/core/query_index.hpp>
+#include <synopsia/core/session_recorder.hpp>
+#include <expr.hpp>
+#include <funcs.hpp>
+#include <kernwin.hpp>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+namespace synopsia {
+
+namespace {
+
+// =============================================================================
+// Result Buffers
+// =============================================================================
+
+/// Pinned result array; `owner` keeps the backing storage alive
+struct ResultBuffer {
+    std::shared_ptr<const void> owner;
+    const void* data = nullptr;
+    std::size_t count = 0;
+    char format = 'B';
+};
+
+template <typename T>
+ResultBuffer make_buffer(std::vector<T>&& values, char format) {
+    auto storage = std::make_shared<const std::vector<T>>(std::move(values));
+    return {storage, storage->data(), storage->size(), format};
+}
+
+/// View into snapshot-owned storage (zero-copy)
+template <typename T>
+ResultBuffer share_buffer(const std::shared_ptr<const QuerySnapshot>& snap, std::span<const T> values, char format) {
+    return {snap, values.data(), values.size(), format};
+}
+
+class ApiState {
+public:
+    std::int64_t add_buffer(ResultBuffer&& buffer) {
+        std::lock_guard lock(mutex_);
+        const std::int64_t handle = next_handle_++;
+        buffers_.emplace(handle, std::move(buffer));
+        return handle;
+    }
+
+    bool get_buffer(std::int64_t handle, ResultBuffer& out) const {
+        std::lock_guard lock(mutex_);
+        auto it = buffers_.find(handle);
+        if (it == buffers_.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    void free_buffer(std::int64_t handle) {
+        std::lock_guard lock(mutex_);
+        buffers_.erase(handle);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::int64_t, ResultBuffer> buffers_;
+    std::int64_t next_handle_ = 1;
+};
+
+ApiState& state() {
+    static ApiState s;
+    return s;
+}
+
+/// Snapshot for C ABI callers, built on first use as the IDC functions do
+std::shared_ptr<const QuerySnapshot> api_snapshot() {
+    if (auto snap = QueryIndex::current()) return snap;
+    if (is_main_thread()) return QueryIndex::require();
+
+    // Building reads the database, which only the main thread may do
+    struct Build : exec_request_t {
+        std::shared_ptr<const QuerySnapshot> snap;
+        ssize_t idaapi execute() override {
+            snap = QueryIndex::require();
+            return 0;
+        }
+    } build;
+    execute_sync(build, MFF_READ);
+    return build.snap;
+}
+
+// =============================================================================
+// Shared Query Implementations (no IDA calls)
+// =============================================================================
+
+std::int64_t query_bfs(const std::shared_ptr<const QuerySnapshot>& snap, std::uint64_t source,
+                       int direction, std::uint32_t max_depth) {
+    if (!snap) return -1;
+    const graph_index_t src = snap->map.index_of(static_cast<ea_t>(source));
+    if (src == GRAPH_NO_NODE) return -1;
+
+    const auto dir = direction == 0 ? GraphDirection::Callees : GraphDirection::Callers;
+    std::vector<std::uint32_t> depths;
+    const graph_index_t sources[] = {src};
+    snap->map.graph().bfs(sources, dir, max_depth, depths);
+    return state().add_buffer(make_buffer(std::move(depths), 'I'));
+}
+
+std::int64_t query_path(const std::shared_ptr<const QuerySnapshot>& snap, std::uint64_t from, std::uint64_t to) {
+    if (!snap) return -1;
+    const graph_index_t a = snap->map.index_of(static_cast<ea_t>(from));
+    const graph_index_t b = snap->map.index_of(static_cast<ea_t>(to));
+    if (a == GRAPH_NO_NODE || b == GRAPH_NO_NODE) return -1;
+
+    std::vector<graph_index_t> path;
+    snap->map.graph().shortest_path(a, b, path);
+
+    std::vector<std::uint64_t> addresses;
+    addresses.reserve(path.size());
+    for (graph_index_t idx : path) {
+        addresses.push_back(static_cast<std::uint64_t>(snap->map.nodes()[idx].address));
+    }
+    return state().add_buffer(make_buffer(std::move(addresses), 'Q'));
+}
+
+/// Write blocks as a score image; logs the reason on failure
+bool write_score_image(std::span<const EntropyBlockData> blocks, const char* path, int layout, int width, int height) {
+    ScoreImageOptions options;
+    options.layout = layout == 0 ? ScoreImageLayout::Strip : ScoreImageLayout::Hilbert;
+    options.width = width;
+    options.height = height;
+
+    std::string error;
+    if (!export_score_image(blocks, ColorGradient::create_default(), options, path, &error)) {
+        msg("Synopsia [export]: %s: %s\n", path, error.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::int64_t query_search(const std::shared_ptr<const QuerySnapshot>& snap, const char* needle,
+                          std::uint32_t max_results) {
+    if (!snap || needle == nullptr) return -1;
+    auto matches = snap->search(needle, max_results);
+    return state().add_buffer(make_buffer(std::move(matches), 'I'));
+}
+
+// =============================================================================
+// IDC Functions
+// =============================================================================
+
+error_t idaapi idc_refresh(idc_value_t* /*argv*/, idc_value_t* res) {
+    res->set_long(static_cast<sval_t>(QueryIndex::refresh()));
+    return eOk;
+}
+
+error_t idaapi idc_precompute(idc_value_t* /*argv*/, idc_value_t* res) {
+    const bool ok = run_precompute();
+    if (ok) {
+        QueryIndex::refresh();
+    }
+    res->set_long(ok ? 1 : 0);
+    return eOk;
+}
+
+error_t idaapi idc_snapshot_write(idc_value_t* argv, idc_value_t* res) {
+    res->set_long(export_snapshot(argv[0].c_str()) ? 1 : 0);
+    return eOk;
+}
+
+error_t idaapi idc_block_scores(idc_value_t* argv, idc_value_t* res) {
+    const ea_t start = static_cast<ea_t>(argv[0].num);
+    const ea_t end = static_cast<ea_t>(argv[1].num);
+    const std::size_t block_size = std::clamp<std::size_t>(
+        static_cast<std::size_t>(argv[2].num), MIN_BLOCK_SIZE, MAX_BLOCK_SIZE);
+
+    EntropyCalculator calculator;
+    const auto blocks = calculator.analyze_range(start, end, block_size);
+
+    std::vector<double> scores;
+    scores.reserve(blocks.size());
+    for (const auto& block : blocks) {
+        scores.push_back(block.entropy);
+    }
+    res->set_long(state().add_buffer(make_buffer(std::move(scores), 'd')));
+    return eOk;
+}
+
+error_t idaapi idc_histogram(idc_value_t* argv, idc_value_t* res) {
+    EntropyCalculator calculator;
+    const auto counts = calculator.histogram_range(static_cast<ea_t>(argv[0].num),
+                                                   static_cast<ea_t>(argv[1].num));
+    std::vector<std::uint64_t> values(counts.begin(), counts.end());
+    res->set_long(state().add_buffer(make_buffer(std::move(values), 'Q')));
+    return eOk;
+}
+
+error_t idaapi idc_export_image(idc_value_t* argv, idc_value_t* res) {
+    // Finest level of the entropy pyramid, as cached or computed fresh
+    std::vector<EntropyBlock> blocks;
+    if (!AnalysisCache::read(CacheSection::EntropyLevel0, CacheScope::Bytes, blocks)) {
+        EntropyCalculator calculator;
+        blocks = calculator.analyze_database(DEFAULT_BLOCK_SIZE);
+    }
+
+    std::vector<EntropyBlockData> data;
+    data.reserve(blocks.size());
+    for (const auto& block : blocks) {
+        data.push_back({static_cast<data_addr_t>(block.start_ea), static_cast<data_addr_t>(block.end_ea), block.entropy});
+    }
+    res->set_long(write_score_image(data, argv[0].c_str(), static_cast<int>(argv[1].num),
+                                    static_cast<int>(argv[2].num), static_cast<int>(argv[3].num)) ? 1 : 0);
+    return eOk;
+}
+
+error_t idaapi idc_func_count(idc_value_t* /*argv*/, idc_value_t* res) {
+    auto snap = QueryIndex::require();
+    res->set_long(snap ? static_cast<sval_t>(snap->map.nodes().size()) : 0);
+    return eOk;
+}
+
+error_t idaapi idc_func_index(idc_value_t* argv, idc_value_t* res) {
+    auto snap = QueryIndex::require();
+    graph_index_t idx = GRAPH_NO_NODE;
+    if (snap) {
+        func_t* func = get_func(static_cast<ea_t>(argv[0].num));
+        if (func) idx = snap->map.index_of(func->start_ea);
+    }
+    res->set_long(idx == GRAPH_NO_NODE ? -1 : static_cast<sval_t>(idx));
+    return eOk;
+}
+
+error_t idaapi idc_func_name(idc_value_t* argv, idc_value_t* res) {
+    auto snap = QueryIndex::require();
+    const auto idx = static_cast<std::size_t>(argv[0].num);
+    if (snap && idx < snap->map.nodes().size()) {
+        res->set_string(snap->map.nodes()[idx].name.c_str());
+    } else {
+        res->set_string("");
+    }
+    return eOk;
+}
+
+error_t idaapi idc_func_column(idc_value_t* argv, idc_value_t* res) {
+    auto snap = QueryIndex::require();
+    if (!snap) {
+        res->set_long(-1);
+        return eOk;
+    }
+
+    const std::string column = argv[0].c_str();
+    const auto& nodes = snap->map.nodes();
+
+    auto collect_u32 = [&nodes](auto field) {
+        std::vector<std::uint32_t> values;
+        values.reserve(nodes.size());
+        for (const auto& node : nodes) values.push_back(field(node));
+        return make_buffer(std::move(values), 'I');
+    };
+
+    ResultBuffer buffer;
+    if (column == "address" || column == "end") {
+        const bool end = column == "end";
+        std::vector<std::uint64_t> values;
+        values.reserve(nodes.size());
+        for (const auto& node : nodes) {
+            values.push_back(static_cast<std::uint64_t>(end ? node.end_address : node.address));
+        }
+        buffer = make_buffer(std::move(values), 'Q');
+    } else if (column == "size") {
+        buffer = collect_u32([](const auto& n) { return n.size; });
+    } else if (column == "depth") {
+        buffer = collect_u32([](const auto& n) { return n.call_depth; });
+    } else if (column == "callers") {
+        buffer = collect_u32([](const auto& n) { return n.caller_count; });
+    } else if (column == "callees") {
+        buffer = collect_u32([](const auto& n) { return n.callee_count; });
+    } else {
+        res->set_long(-1);
+        return eOk;
+    }
+
+    res->set_long(state().add_buffer(std::move(buffer)));
+    return eOk;
+}
+
+error_t idaapi idc_csr(idc_value_t* argv, idc_value_t* res) {
+    auto snap = QueryIndex::require();
+    if (!snap) {
+        res->set_long(-1);
+        return eOk;
+    }
+
+    const auto dir = argv[0].num == 0 ? GraphDirection::Callees : GraphDirection::Callers;
+    const CsrAdjacency& adj = snap->map.graph().adjacency(dir);
+    ResultBuffer buffer = argv[1].num == 0
+        ? share_buffer(snap, adj.offsets, 'I')
+        : share_buffer(snap, adj.targets, 'I');
+    res->set_long(state().add_buffer(std::move(buffer)));
+    return eOk;
+}
+
+error_t idaapi idc_bfs(idc_value_t* argv, idc_value_t* res) {
+    res->set_long(query_bfs(QueryIndex::require(), static_cast<std::uint64_t>(argv[0].num),
+                            static_cast<int>(argv[1].num), static_cast<std::uint32_t>(argv[2].num)));
+    return eOk;
+}
+
+error_t idaapi idc_path(idc_value_t* argv, idc_value_t* res) {
+    res->set_long(query_path(QueryIndex::require(), static_cast<std::uint64_t>(argv[0].num),
+                             static_cast<std::uint64_t>(argv[1].num)));
+    return eOk;
+}
+
+error_t idaapi idc_search(idc_value_t* argv, idc_value_t* res) {
+    res->set_long(query_search(QueryIndex::require(), argv[0].c_str(),
+                               static_cast<std::uint32_t>(argv[1].num)));
+    return eOk;
+}
+
+error_t idaapi idc_server_start(idc_value_t* argv, idc_value_t* res) {
+    ScriptApi* api = ScriptApi::instance();
+    res->set_long(api && api->server().start(argv[0].c_str()) ? 1 : 0);
+    return eOk;
+}
+
+error_t idaapi idc_server_stop(idc_value_t* /*argv*/, idc_value_t* res) {
+    if (ScriptApi* api = ScriptApi::instance()) {
+        api->server().stop();
+    }
+    res->set_long(0);
+    return eOk;
+}
+
+error_t idaapi idc_server_endpoint(idc_value_t* /*argv*/, idc_value_t* res) {
+    ScriptApi* api = ScriptApi::instance();
+    res->set_string(api && api->server().is_running() ? api->server().endpoint().c_str() : "");
+    return eOk;
+}
+
+error_t idaapi idc_trace_start(idc_value_t* argv, idc_value_t* res) {
+    res->set_long(SessionRecorder::start(argv[0].c_str()) ? 1 : 0);
+    return eOk;
+}
+
+error_t idaapi idc_trace_stop(idc_value_t* /*argv*/, idc_value_t* res) {
+    SessionRecorder::stop();
+    res->set_long(0);
+    return eOk;
+}
+
+error_t idaapi idc_buf_ptr(idc_value_t* argv, idc_value_t* res) {
+    res->set_long(static_cast<sval_t>(reinterpret_cast<std::uintptr_t>(
+        synopsia_api_buffer_data(argv[0].num))));
+    return eOk;
+}
+
+error_t idaapi idc_buf_len(idc_value_t* argv, idc_value_t* res) {
+    res->set_long(static_cast<sval_t>(synopsia_api_buffer_count(argv[0].num)));
+    return eOk;
+}
+
+error_t idaapi idc_buf_format(idc_value_t* argv, idc_value_t* res) {
+    const char fmt[2] = {synopsia_api_buffer_format(argv[0].num), '\0'};
+    res->set_string(fmt);
+    return eOk;
+}
+
+error_t idaapi idc_buf_free(idc_value_t* argv, idc_value_t* res) {
+    synopsia_api_buffer_free(argv[0].num);
+    res->set_long(0);
+    return eOk;
+}
+
+// Argument type lists
+const char ARGS_NONE[] = {0};
+const char ARGS_L[] = {VT_LONG, 0};
+const char ARGS_LL[] = {VT_LONG, VT_LONG, 0};
+const char ARGS_LLL[] = {VT_LONG, VT_LONG, VT_LONG, 0};
+const char ARGS_S[] = {VT_STR, 0};
+const char ARGS_SL[] = {VT_STR, VT_LONG, 0};
+const char ARGS_SLLL[] = {VT_STR, VT_LONG, VT_LONG, VT_LONG, 0};
+
+const ext_idcfunc_t IDC_FUNCTIONS[] = {
+    {"synopsia_refresh",      idc_refresh,      ARGS_NONE, nullptr, 0, EXTFUN_BASE},
+    {"synopsia_precompute",   idc_precompute,   ARGS_NONE, nullptr, 0, EXTFUN_BASE},
+    {"synopsia_snapshot_write", idc_snapshot_write, ARGS_S, nullptr, 0, EXTFUN_BASE},
+    {"synopsia_block_scores", idc_block_scores, ARGS_LLL,  nullptr, 0, EXTFUN_BASE},
+    {"synopsia_histogram",    idc_histogram,    ARGS_LL,   nullptr, 0, EXTFUN_BASE},
+    {"synopsia_export_image", idc_export_image, ARGS_SLLL, nullptr, 0, EXTFUN_BASE},
+    {"synopsia_func_count",   idc_func_count,   ARGS_NONE, nullptr, 0, EXTFUN_BASE},
+    {"synopsia_func_index",   idc_func_index,   ARGS_L,    nullptr, 0, EXTFUN_BASE},
+    {"synopsia_func_name",    idc_func_name,    ARGS_L,    nullptr, 0, EXTFUN_BASE},
+    {"synopsia_func_column",  idc_func_column,  ARGS_S,    nullptr, 0, EXTFUN_BASE},
+    {"synopsia_csr",          idc_csr,          ARGS_LL,   nullptr, 0, EXTFUN_BASE},
+    {"synopsia_bfs",          idc_bfs,          ARGS_LLL,  nullptr, 0, EXTFUN_BASE},
+    {"synopsia_path",         idc_path,         ARGS_LL,   nullptr, 0, EXTFUN_BASE},
+    {"synopsia_search",       idc_search,       ARGS_SL,   nullptr, 0, EXTFUN_BASE},
+    {"synopsia_server_start", idc_server_start, ARGS_S,  nullptr, 0, EXTFUN_BASE},
+    {"synopsia_server_stop",  idc_server_stop,  ARGS_NONE, nullptr, 0, EXTFUN_BASE},
+    {"synopsia_server_endpoint", idc_server_endpoint, ARGS_NONE, nullptr, 0, EXTFUN_BASE},
+    {"synopsia_trace_start",  idc_trace_start,  ARGS_S,    nullptr, 0, EXTFUN_BASE},
+    {"synopsia_trace_stop",   idc_trace_stop,   ARGS_NONE, nullptr, 0, EXTFUN_BASE},
+    {"synopsia_buf_ptr",      idc_buf_ptr,      ARGS_L,    nullptr, 0, EXTFUN_BASE},
+    {"synopsia_buf_len",      idc_buf_len,      ARGS_L,    nullptr, 0, EXTFUN_BASE},
+    {"synopsia_buf_format",   idc_buf_format,   ARGS_L,    nullptr, 0, EXTFUN_BASE},
+    {"synopsia_buf_free",     idc_buf_free,     ARGS_L,    nullptr, 0, EXTFUN_BASE},
+};
+
+} // anonymous namespace
+
+// =============================================================================
+// ScriptApi
+// =============================================================================
+
+bool ScriptApi::install() {
+    if (installed_) return true;
+
+    bool ok = true;
+    for (const auto& desc : IDC_FUNCTIONS) {
+        if (!add_idc_func(desc)) {
+            msg("Synopsia: Failed to register IDC function %s\n", desc.name);
+            ok = false;
+        }
+    }
+    installed_ = true;
+    return ok;
+}
+
+void ScriptApi::uninstall() {
+    if (!installed_) return;
+
+    server_.stop();
+    for (const auto& desc : IDC_FUNCTIONS) {
+        del_idc_func(desc.name);
+    }
+    QueryIndex::reset();
+    installed_ = false;
+}
+
+void ScriptApi::on_database_closed() {
+    QueryIndex::reset();
+}
+
+} // namespace synopsia
+
+// =============================================================================
+// C ABI
+// =============================================================================
+
+using synopsia::state;
+
+SYNOPSIA_API int synopsia_api_version() {
+    return synopsia::SCRIPT_API_VERSION;
+}
+
+SYNOPSIA_API const void* synopsia_api_buffer_data(std::int64_t handle) {
+    synopsia::ResultBuffer buffer;
+    return state().get_buffer(handle, buffer) ? buffer.data : nullptr;
+}
+
+SYNOPSIA_API std::uint64_t synopsia_api_buffer_count(std::int64_t handle) {
+    synopsia::ResultBuffer buffer;
+    return state().get_buffer(handle, buffer) ? buffer.count : 0;
+}
+
+SYNOPSIA_API char synopsia_api_buffer_format(std::int64_t handle) {
+    synopsia::ResultBuffer buffer;
+    return state().get_buffer(handle, buffer) ? buffer.format : '\0';
+}
+
+SYNOPSIA_API void synopsia_api_buffer_free(std::int64_t handle) {
+    state().free_buffer(handle);
+}
+
+SYNOPSIA_API std::int64_t synopsia_api_bfs(std::uint64_t source, int direction, std::uint32_t max_depth) {
+    return synopsia::query_bfs(synopsia::api_snapshot(), source, direction, max_depth);
+}
+
+SYNOPSIA_API std::int64_t synopsia_api_path(std::uint64_t from, std::uint64_t to) {
+    return synopsia::query_path(synopsia::api_snapshot(), from, to);
+}
+
+SYNOPSIA_API std::int64_t synopsia_api_search(const char* needle, std::uint32_t max_results) {
+    return synopsia::query_search(synopsia::api_snapshot(), needle, max_results);
+}
+
+SYNOPSIA_API std::uint64_t synopsia_api_block_scores(const void* data, std::uint64_t size,
+                                                     std::uint32_t block_size, double* out) {
+    if (data == nullptr || out == nullptr || block_size == 0) return 0;
+
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    std::uint64_t count = 0;
+    for (std::uint64_t offset = 0; offset < size; offset += block_size) {
+        const std::uint64_t actual = std::min<std::uint64_t>(block_size, size - offset);
+        out[count++] = synopsia::EntropyCalculator::calculate(bytes + offset, actual);
+    }
+    return count;
+}
+
+SYNOPSIA_API void synopsia_api_histogram(const void* data, std::uint64_t size, std::uint64_t* out) {
+    if (out == nullptr) return;
+
+    std::array<std::uint64_t, 256> counts{};
+    synopsia::EntropyCalculator::accumulate_histogram(data, size, counts);
+    std::copy(counts.begin(), counts.end(), out);
+}
+
+SYNOPSIA_API int synopsia_api_export_image(const double* scores, std::uint64_t count, std::uint32_t block_size,
+                                           const char* path, int layout, int width, int height) {
+    if (scores == nullptr || path == nullptr || block_size == 0) return 0;
+
+    std::vector<synopsia::EntropyBlockData> blocks(count);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        blocks[i] = {i * block_size, (i + 1) * block_size, scores[i]};
+    }
+    return synopsia::write_score_image(blocks, path, layout, width, height) ? 1 : 0;
+}
@@ -0,0 +1,34 @@
+/// @file selection.cpp
+/// @brief Shared function selection implementation
+
+#include <synopsia/core/selection.hpp>
+
+namespace synopsia {
+
+namespace {
+
+ea_t g_function = BADADDR;
+std::uint64_t g_version = 0;
+
+} // anonymous namespace
+
+void SelectionChannel::publish(ea_t function) {
+    if (function == g_function) return;
+    g_function = function;
+    ++g_version;
+}
+
+ea_t SelectionChannel::current() noexcept {
+    return g_function;
+}
+
+std::uint64_t SelectionChannel::version() noexcept {
+    return g_version;
+}
+
+void SelectionChannel::reset() noexcept {
+    g_function = BADADDR;
+    g_version = 0;
+}
+
+} // namespace synopsia
@@ -0,0 +1,243 @@
+/// @file session_recorder.cpp
+/// @brief Session trace recorder implementation
+
+#include <synopsia/core/session_recorder.hpp>
+#include <funcs.hpp>
+#include <chrono>
+
+namespace synopsia {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+SessionTraceWriter g_writer;
+Clock::time_point g_started;
+bool g_recording = false;
+TraceMinimapLayout g_minimap;
+
+std::uint64_t now_us() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - g_started).count());
+}
+
+ea_t function_start(func_t* func) {
+    return func ? func->start_ea : BADADDR;
+}
+
+/// Consecutive byte patches, recorded as one range once the run ends
+struct PendingPatch {
+    ea_t start = BADADDR;
+    ea_t end = BADADDR;
+    std::uint64_t time_us = 0;
+};
+
+PendingPatch g_patch;
+
+void write_pending_patch() {
+    if (g_patch.start == BADADDR) return;
+
+    TraceEvent event;
+    event.time_us = g_patch.time_us;
+    event.kind = TraceEventKind::Change;
+    event.code = static_cast<std::uint16_t>(TraceChange::BytesChanged);
+    event.address = g_patch.start;
+    event.value = static_cast<std::int64_t>(g_patch.end - g_patch.start);
+    g_writer.write(event);
+    g_patch = {};
+}
+
+void record_patch(ea_t ea) {
+    if (!g_recording) return;
+
+    if (g_patch.start != BADADDR && ea == g_patch.end) {
+        ++g_patch.end;
+        return;
+    }
+    write_pending_patch();
+    g_patch = {ea, ea + 1, now_us()};
+}
+
+/// Logs database changes in the categories the plugin reacts to
+class ChangeListener : public event_listener_t {
+public:
+    ssize_t idaapi on_event(ssize_t code, va_list va) override {
+        switch (code) {
+            case idb_event::renamed: {
+                const ea_t ea = va_arg(va, ea_t);
+                const char* new_name = va_arg(va, const char*);
+                const bool local_name = va_arg(va, int) != 0;
+                func_t* func = local_name ? nullptr : get_func(ea);
+                if (func && func->start_ea == ea) {
+                    SessionRecorder::record_change(TraceChange::Renamed, ea, new_name);
+                }
+                break;
+            }
+            case idb_event::func_added:
+            case idb_event::deleting_func:
+            case idb_event::func_updated:
+            case idb_event::set_func_start:
+            case idb_event::set_func_end:
+            case idb_event::func_tail_appended:
+            case idb_event::func_tail_deleted:
+                SessionRecorder::record_change(TraceChange::FunctionsChanged, function_start(va_arg(va, func_t*)));
+                break;
+            case idb_event::byte_patched:
+                record_patch(va_arg(va, ea_t));
+                break;
+            case idb_event::segm_deleted:
+            case idb_event::segm_moved:
+                SessionRecorder::record_change(TraceChange::BytesChanged, va_arg(va, ea_t));
+                break;
+            case idb_event::segm_added: {
+                segment_t* seg = va_arg(va, segment_t*);
+                SessionRecorder::record_change(TraceChange::BytesChanged, seg ? seg->start_ea : BADADDR);
+                break;
+            }
+            default:
+                break;
+        }
+        return 0;
+    }
+};
+
+ChangeListener g_listener;
+
+} // anonymous namespace
+
+std::string default_trace_path() {
+    const char* idb = get_path(PATH_TYPE_IDB);
+    if (!idb || idb[0] == '\0') return {};
+    return std::string(idb) + SESSION_TRACE_EXTENSION;
+}
+
+bool SessionRecorder::start(const std::string& path_arg) {
+    stop();
+
+    const std::string path = path_arg.empty() ? default_trace_path() : path_arg;
+    if (path.empty()) {
+        msg("Synopsia [trace]: No output path\n");
+        return false;
+    }
+
+    std::string error;
+    if (!g_writer.open(path, g_minimap, &error)) {
+        msg("Synopsia [trace]: %s: %s\n", path.c_str(), error.c_str());
+        return false;
+    }
+
+    g_started = Clock::now();
+    g_recording = true;
+    hook_event_listener(HT_IDB, &g_listener);
+    msg("Synopsia [trace]: Recording to %s\n", path.c_str());
+    return true;
+}
+
+void SessionRecorder::stop() {
+    if (!g_recording) return;
+
+    unhook_event_listener(HT_IDB, &g_listener);
+    write_pending_patch();
+    g_recording = false;
+    const std::size_t count = g_writer.event_count();
+    g_writer.close();
+    msg("Synopsia [trace]: Stopped (%zu events)\n", count);
+}
+
+bool SessionRecorder::is_recording() noexcept {
+    return g_recording;
+}
+
+void SessionRecorder::record_cursor(ea_t addr) {
+    if (!g_recording) return;
+    write_pending_patch();
+
+    TraceEvent event;
+    event.time_us = now_us();
+    event.kind = TraceEventKind::Cursor;
+    event.address = addr;
+    g_writer.write(event);
+}
+
+void SessionRecorder::record_change(TraceChange change, ea_t addr, const char* text) {
+    if (!g_recording) return;
+    write_pending_patch();
+
+    TraceEvent event;
+    event.time_us = now_us();
+    event.kind = TraceEventKind::Change;
+    event.code = static_cast<std::uint16_t>(change);
+    event.address = addr;
+    if (text) event.text = text;
+    g_writer.write(event);
+}
+
+void SessionRecorder::record_response(TraceSource source, std::uint64_t parameter, std::int64_t value) {
+    if (!g_recording) return;
+    write_pending_patch();
+
+    TraceEvent event;
+    event.time_us = now_us();
+    event.kind = TraceEventKind::Response;
+    event.code = static_cast<std::uint16_t>(source);
+    event.address = parameter;
+    event.value = value;
+    g_writer.write(event);
+}
+
+void SessionRecorder::record_input(const char* widget, TraceInput input, float x, float y, std::int64_t value) {
+    if (!g_recording) return;
+    write_pending_patch();
+
+    TraceEvent event;
+    event.time_us = now_us();
+    event.kind = TraceEventKind::Input;
+    event.code = static_cast<std::uint16_t>(input);
+    event.widget = g_writer.widget_id(widget ? widget : "", event.time_us);
+    event.x = x;
+    event.y = y;
+    event.value = value;
+    g_writer.write(event);
+}
+
+void SessionRecorder::record_frame(const char* widget, std::uint64_t render_us) {
+    if (!g_recording) return;
+    write_pending_patch();
+
+    TraceEvent event;
+    event.time_us = now_us();
+    event.kind = TraceEventKind::Frame;
+    event.widget = g_writer.widget_id(widget ? widget : "", event.time_us);
+    event.value = static_cast<std::int64_t>(render_us);
+    g_writer.write(event);
+}
+
+void SessionRecorder::set_minimap_layout(const TraceMinimapLayout& layout) noexcept {
+    g_minimap = layout;
+}
+
+} // namespace synopsia
+
+// =============================================================================
+// C Linkage Bridge Functions (Qt ImGui host)
+// =============================================================================
+
+extern "C" {
+
+bool synopsia_trace_recording() {
+    return synopsia::SessionRecorder::is_recording();
+}
+
+void synopsia_trace_input(const char* widget, int input, float x, float y, std::int64_t value) {
+    synopsia::SessionRecorder::record_input(widget, static_cast<synopsia::TraceInput>(input), x, y, value);
+}
+
+void synopsia_trace_frame(const char* widget, std::uint64_t render_us) {
+    synopsia::SessionRecorder::record_frame(widget, render_us);
+}
+
+void synopsia_trace_minimap_layout(float width, float height, bool vertical) {
+    synopsia::SessionRecorder::set_minimap_layout(synopsia::TraceMinimapLayout{width, height, vertical});
+}
+
+} // extern "C"
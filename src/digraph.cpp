@@ -0,0 +1,121 @@
+/// @file digraph.cpp
+/// @brief Byte-pair digraph implementation
+
+#include <synopsia/digraph.hpp>
+#include <synopsia/common/parallel.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace synopsia {
+
+namespace {
+
+/// Smallest slice of the buffer worth a thread of its own
+constexpr std::size_t MIN_PART_BYTES = 256 * 1024;
+
+/// Count the pairs starting in data[0, size - 1) into two interleaved matrices
+void count_pairs(const std::uint8_t* data, std::size_t size, std::uint32_t* even, std::uint32_t* odd) {
+    if (size < 2) return;
+    std::size_t i = 0;
+
+    if constexpr (std::endian::native == std::endian::little) {
+        // Pair k of the word is bits 8k..8k+15; the last one borrows the next byte
+        for (; i + 9 <= size; i += 8) {
+            std::uint64_t w;
+            std::memcpy(&w, data + i, sizeof(w));
+            ++even[w & 0xFFFF];
+            ++odd[(w >> 8) & 0xFFFF];
+            ++even[(w >> 16) & 0xFFFF];
+            ++odd[(w >> 24) & 0xFFFF];
+            ++even[(w >> 32) & 0xFFFF];
+            ++odd[(w >> 40) & 0xFFFF];
+            ++even[(w >> 48) & 0xFFFF];
+            ++odd[(w >> 56) | (static_cast<std::uint64_t>(data[i + 8]) << 8)];
+        }
+    }
+    for (; i + 1 < size; ++i) {
+        ++even[data[i] | (static_cast<std::uint32_t>(data[i + 1]) << 8)];
+    }
+}
+
+} // anonymous namespace
+
+void ByteDigraph::compute(std::span<const std::uint8_t> data, std::span<const std::size_t> breaks) {
+    const std::size_t size = data.size();
+    const std::size_t parts = std::clamp<std::size_t>(size / MIN_PART_BYTES, 1, worker_count());
+    partials_.resize(parts * 2 * CELLS);
+
+    // Each part counts the pairs that start inside it (reading one byte past its end)
+    const std::size_t part_size = (size + parts - 1) / parts;
+    parallel_for(parts, 1, [&](std::size_t p) {
+        std::uint32_t* even = partials_.data() + p * 2 * CELLS;
+        std::uint32_t* odd = even + CELLS;
+        std::fill(even, odd + CELLS, 0u);
+
+        const std::size_t begin = std::min(size, p * part_size);
+        const std::size_t end = std::min(size, begin + part_size + 1);
+        count_pairs(data.data() + begin, end - begin, even, odd);
+    });
+
+    // Merge the partials, a slice of the matrix per task
+    constexpr std::size_t slice = CELLS / 16;
+    std::array<std::uint32_t, 16> slice_max{};
+    parallel_for(16, 1, [&](std::size_t s) {
+        std::uint32_t top = 0;
+        for (std::size_t c = s * slice; c < (s + 1) * slice; ++c) {
+            std::uint32_t sum = 0;
+            for (std::size_t p = 0; p < parts * 2; ++p) {
+                sum += partials_[p * CELLS + c];
+            }
+            counts_[c] = sum;
+            top = std::max(top, sum);
+        }
+        slice_max[s] = top;
+    });
+
+    pairs_ = size > 1 ? size - 1 : 0;
+    max_ = *std::max_element(slice_max.begin(), slice_max.end());
+
+    // Bytes on either side of a break were never adjacent
+    std::size_t dropped = 0;
+    for (std::size_t b : breaks) {
+        if (b == 0 || b >= size) continue;
+        --counts_[data[b - 1] | (static_cast<std::size_t>(data[b]) << 8)];
+        ++dropped;
+    }
+    if (dropped > 0) {
+        pairs_ -= dropped;
+        max_ = *std::max_element(counts_.begin(), counts_.end());
+    }
+}
+
+void ByteDigraph::clear() {
+    std::fill(counts_.begin(), counts_.end(), 0u);
+    pairs_ = 0;
+    max_ = 0;
+}
+
+void ByteDigraph::render(const ColorGradient& gradient, std::uint32_t* pixels, std::size_t stride) const {
+    // Counts only reach log(1 + max) in 64 steps; one gradient sample each
+    constexpr int STEPS = 64;
+    std::array<std::uint32_t, STEPS + 1> lut;
+    lut[0] = colors::Background.to_argb() | 0xFF000000u;
+    for (int k = 1; k <= STEPS; ++k) {
+        lut[static_cast<std::size_t>(k)] = gradient.sample(0.15 + 0.85 * k / STEPS).to_argb() | 0xFF000000u;
+    }
+
+    const double scale = max_ > 0 ? STEPS / std::log1p(static_cast<double>(max_)) : 0.0;
+    for (int first = 0; first < SIDE; ++first) {
+        std::uint32_t* row = pixels + static_cast<std::size_t>(first) * stride;
+        for (int second = 0; second < SIDE; ++second) {
+            const std::uint32_t c = count(first, second);
+            const int step = c == 0 ? 0 : std::max(1, static_cast<int>(std::log1p(static_cast<double>(c)) * scale));
+            row[second] = lut[static_cast<std::size_t>(std::min(step, STEPS))];
+        }
+    }
+}
+
+} // namespace synopsia
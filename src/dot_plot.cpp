@@ -0,0 +1,348 @@
+/// @file dot_plot.cpp
+/// @brief Self-similarity dot-plot implementation
+
+#include <synopsia/dot_plot.hpp>
+#include <synopsia/common/parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace synopsia {
+
+namespace {
+
+constexpr std::size_t BAND_ROWS = SKETCH_SLOTS / DOT_PLOT_BANDS;
+static_assert(SKETCH_SLOTS % DOT_PLOT_BANDS == 0, "bands must split the sketch evenly");
+static_assert(DOT_PLOT_BANDS <= 8, "cells keep one bit per band");
+
+/// 64-bit finalizer (murmur3 fmix64); top bits pick the slot, low half is the value
+[[nodiscard]] inline std::uint64_t mix(std::uint64_t x) noexcept {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+[[nodiscard]] inline std::uint64_t band_key(const std::array<std::uint32_t, SKETCH_SLOTS>& slots,
+                                            std::size_t band) noexcept {
+    std::uint64_t key = band;
+    for (std::size_t r = 0; r < BAND_ROWS; ++r) {
+        key = mix(key ^ (static_cast<std::uint64_t>(slots[band * BAND_ROWS + r]) << 16));
+    }
+    return key;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// BlockSketch
+// =============================================================================
+
+void BlockSketch::compute(const std::uint8_t* data, std::size_t size) noexcept {
+    slots.fill(EMPTY);
+    uniform = false;
+    if (data == nullptr || size == 0) return;
+
+    uniform = std::all_of(data + 1, data + size, [first = data[0]](std::uint8_t b) { return b == first; });
+
+    auto add = [this](std::uint32_t shingle) {
+        const std::uint64_t h = mix(shingle);
+        const std::size_t slot = static_cast<std::size_t>(h >> 59);
+        const std::uint32_t value = std::min(static_cast<std::uint32_t>(h), EMPTY - 1);
+        slots[slot] = std::min(slots[slot], value);
+    };
+
+    if (size < 4) {
+        std::uint32_t shingle = 0;
+        std::memcpy(&shingle, data, size);
+        add(shingle);
+        return;
+    }
+    for (std::size_t i = 0; i + 4 <= size; ++i) {
+        std::uint32_t shingle;
+        std::memcpy(&shingle, data + i, 4);
+        add(shingle);
+    }
+}
+
+bool BlockSketch::empty() const noexcept {
+    return std::all_of(slots.begin(), slots.end(), [](std::uint32_t v) { return v == EMPTY; });
+}
+
+std::array<std::uint32_t, SKETCH_SLOTS> BlockSketch::densified() const noexcept {
+    std::array<std::uint32_t, SKETCH_SLOTS> out = slots;
+    if (empty()) return out;
+
+    // Rotation: an empty slot borrows the next filled one, offset by distance
+    for (std::size_t i = 0; i < SKETCH_SLOTS; ++i) {
+        if (slots[i] != EMPTY) continue;
+        std::uint32_t distance = 1;
+        std::size_t j = (i + 1) % SKETCH_SLOTS;
+        while (slots[j] == EMPTY) {
+            j = (j + 1) % SKETCH_SLOTS;
+            ++distance;
+        }
+        out[i] = slots[j] + distance * 0x9E3779B1u;
+    }
+    return out;
+}
+
+double BlockSketch::similarity(const BlockSketch& other) const noexcept {
+    if (empty() || other.empty()) return 0.0;
+    const auto a = densified();
+    const auto b = other.densified();
+    std::size_t equal = 0;
+    for (std::size_t i = 0; i < SKETCH_SLOTS; ++i) {
+        equal += a[i] == b[i];
+    }
+    return static_cast<double>(equal) / static_cast<double>(SKETCH_SLOTS);
+}
+
+BlockSketch merge_sketches(const BlockSketch& a, const BlockSketch& b) noexcept {
+    BlockSketch out;
+    out.start_addr = a.start_addr;
+    out.end_addr = b.end_addr;
+    out.position = a.position;
+    out.bytes = a.bytes + b.bytes;
+    out.uniform = a.uniform && b.uniform && a.slots == b.slots;
+    for (std::size_t i = 0; i < SKETCH_SLOTS; ++i) {
+        out.slots[i] = std::min(a.slots[i], b.slots[i]);
+    }
+    return out;
+}
+
+std::size_t dot_plot_block_size(std::uint64_t total_bytes, std::size_t min_block) {
+    std::size_t block = std::max<std::size_t>(min_block, 1);
+    while (total_bytes / block > DOT_PLOT_MAX_BLOCKS) {
+        block *= 2;
+    }
+    return block;
+}
+
+const BlockSketch* sketch_at(std::span<const BlockSketch> blocks, data_size_t position) noexcept {
+    auto it = std::partition_point(blocks.begin(), blocks.end(), [&](const BlockSketch& block) {
+        return block.end_position() <= position;
+    });
+    if (it == blocks.end() || position < it->position) return nullptr;
+    return &*it;
+}
+
+// =============================================================================
+// SketchPyramid
+// =============================================================================
+
+void SketchPyramid::build(std::vector<BlockSketch> base, std::size_t block_size) {
+    levels_.clear();
+    block_size_ = block_size;
+    if (base.empty()) return;
+
+    levels_.push_back(std::move(base));
+    while (levels_.back().size() > 1) {
+        const std::vector<BlockSketch>& fine = levels_.back();
+        std::vector<BlockSketch> coarse((fine.size() + 1) / 2);
+        parallel_for(coarse.size(), 1024, [&](std::size_t i) {
+            coarse[i] = 2 * i + 1 == fine.size() ? fine[2 * i] : merge_sketches(fine[2 * i], fine[2 * i + 1]);
+        });
+        levels_.push_back(std::move(coarse));
+    }
+}
+
+void SketchPyramid::clear() noexcept {
+    levels_.clear();
+    block_size_ = 0;
+}
+
+std::size_t SketchPyramid::level_for(data_size_t bytes) const noexcept {
+    std::size_t level = 0;
+    while (level + 1 < levels_.size() && (static_cast<data_size_t>(block_size_) << (level + 1)) <= bytes) {
+        ++level;
+    }
+    return level;
+}
+
+data_size_t SketchPyramid::total_bytes() const noexcept {
+    return empty() ? 0 : levels_.front().back().end_position();
+}
+
+data_addr_t SketchPyramid::address_at(data_size_t position) const noexcept {
+    if (empty()) return DATA_BADADDR;
+    const BlockSketch* block = sketch_at(levels_.front(), position);
+    return block ? block->start_addr + (position - block->position) : DATA_BADADDR;
+}
+
+data_size_t SketchPyramid::position_of(data_addr_t addr) const noexcept {
+    if (empty()) return 0;
+    const std::vector<BlockSketch>& base = levels_.front();
+    auto it = std::partition_point(base.begin(), base.end(), [&](const BlockSketch& block) {
+        return block.end_addr <= addr;
+    });
+    if (it == base.end()) return total_bytes();
+    if (addr < it->start_addr) return it->position;
+    return it->position + (addr - it->start_addr);
+}
+
+// =============================================================================
+// DotPlot
+// =============================================================================
+
+DotPlot::DotPlot(const ColorGradient& gradient) {
+    set_gradient(gradient);
+}
+
+void DotPlot::set_gradient(const ColorGradient& gradient) {
+    lut_[0] = colors::Background.to_argb() | 0xFF000000u;
+    for (std::size_t k = 1; k <= DOT_PLOT_BANDS; ++k) {
+        // One band hit is already a likely match; keep it clearly off the background
+        const double t = 0.3 + 0.7 * static_cast<double>(k) / static_cast<double>(DOT_PLOT_BANDS);
+        lut_[k] = gradient.sample(t).to_argb() | 0xFF000000u;
+    }
+}
+
+void DotPlot::rasterize(std::span<const BlockSketch> blocks, const DotPlotWindow& window,
+                        int width, int height, std::uint32_t* pixels, std::size_t stride) {
+    const auto start_time = std::chrono::steady_clock::now();
+    stats_ = {};
+    width_ = std::max(width, 0);
+    height_ = std::max(height, 0);
+    cells_.assign(static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_), 0);
+    if (width_ == 0 || height_ == 0 || window.x_range() == 0 || window.y_range() == 0) {
+        return;
+    }
+
+    // Blocks under the columns and under the rows (one range when they overlap)
+    auto first_at = [&](data_size_t position) {
+        return static_cast<std::size_t>(std::partition_point(blocks.begin(), blocks.end(),
+            [&](const BlockSketch& block) { return block.end_position() <= position; }) - blocks.begin());
+    };
+    auto end_at = [&](data_size_t position) {
+        return static_cast<std::size_t>(std::partition_point(blocks.begin(), blocks.end(),
+            [&](const BlockSketch& block) { return block.position < position; }) - blocks.begin());
+    };
+    std::size_t x_begin = first_at(window.x_start), x_end = end_at(window.x_end);
+    std::size_t y_begin = first_at(window.y_start), y_end = end_at(window.y_end);
+    if (x_begin > y_begin) {
+        std::swap(x_begin, y_begin);
+        std::swap(x_end, y_end);
+    }
+    candidates_.clear();
+    for (std::size_t i = x_begin; i < x_end; ++i) candidates_.push_back(static_cast<std::uint32_t>(i));
+    for (std::size_t i = std::max(y_begin, x_end); i < y_end; ++i) candidates_.push_back(static_cast<std::uint32_t>(i));
+
+    // Pixel extents and band keys, computed once per block
+    const std::size_t count = candidates_.size();
+    extents_.assign(count, Extent{});
+    keys_.assign(count * DOT_PLOT_BANDS, 0);
+    usable_.assign(count, 0);
+    auto span_of = [](data_size_t lo, data_size_t hi, data_size_t start, data_size_t range, int pixels,
+                      int& first, int& last) {
+        const data_size_t end = start + range;
+        if (hi <= start || lo >= end) return;
+        const double scale = static_cast<double>(pixels) / static_cast<double>(range);
+        first = std::clamp(static_cast<int>(static_cast<double>(std::max(lo, start) - start) * scale), 0, pixels - 1);
+        last = std::clamp(static_cast<int>(std::ceil(static_cast<double>(std::min(hi, end) - start) * scale)),
+                          first + 1, pixels);
+    };
+    parallel_for(count, 256, [&](std::size_t c) {
+        const BlockSketch& block = blocks[candidates_[c]];
+        if (block.empty() || (skip_uniform_ && block.uniform)) return;
+
+        Extent& extent = extents_[c];
+        span_of(block.position, block.end_position(), window.x_start, window.x_range(), width_,
+                extent.x_first, extent.x_last);
+        span_of(block.position, block.end_position(), window.y_start, window.y_range(), height_,
+                extent.y_first, extent.y_last);
+
+        const auto slots = block.densified();
+        for (std::size_t b = 0; b < DOT_PLOT_BANDS; ++b) {
+            keys_[b * count + c] = band_key(slots, b);
+        }
+        usable_[c] = 1;
+    });
+    for (std::size_t c = 0; c < count; ++c) stats_.blocks += usable_[c];
+
+    // Bucket each band by sorting its keys; every bucket lights the product
+    // of the columns and rows its blocks cover. A bucket of one block is the
+    // diagonal.
+    std::array<std::size_t, DOT_PLOT_BANDS> band_buckets{};
+    std::array<std::uint64_t, DOT_PLOT_BANDS> band_pairs{};
+    parallel_for(DOT_PLOT_BANDS, 1, [&](std::size_t b) {
+        BandScratch& scratch = bands_[b];
+        scratch.entries.clear();
+        for (std::size_t c = 0; c < count; ++c) {
+            if (usable_[c]) scratch.entries.emplace_back(keys_[b * count + c], static_cast<std::uint32_t>(c));
+        }
+        std::sort(scratch.entries.begin(), scratch.entries.end());
+        scratch.x_stamp.assign(static_cast<std::size_t>(width_), 0);
+        scratch.y_stamp.assign(static_cast<std::size_t>(height_), 0);
+
+        const std::uint8_t bit = static_cast<std::uint8_t>(1u << b);
+        std::uint32_t bucket_id = 0;
+        for (std::size_t r0 = 0; r0 < scratch.entries.size(); ) {
+            std::size_t r1 = r0 + 1;
+            while (r1 < scratch.entries.size() && scratch.entries[r1].first == scratch.entries[r0].first) ++r1;
+            ++bucket_id;
+
+            scratch.xs.clear();
+            scratch.ys.clear();
+            std::uint64_t x_blocks = 0, y_blocks = 0;
+            for (std::size_t r = r0; r < r1; ++r) {
+                const Extent& extent = extents_[scratch.entries[r].second];
+                x_blocks += extent.x_last > extent.x_first;
+                y_blocks += extent.y_last > extent.y_first;
+                for (int x = extent.x_first; x < extent.x_last; ++x) {
+                    if (scratch.x_stamp[static_cast<std::size_t>(x)] == bucket_id) continue;
+                    scratch.x_stamp[static_cast<std::size_t>(x)] = bucket_id;
+                    scratch.xs.push_back(x);
+                }
+                for (int y = extent.y_first; y < extent.y_last; ++y) {
+                    if (scratch.y_stamp[static_cast<std::size_t>(y)] == bucket_id) continue;
+                    scratch.y_stamp[static_cast<std::size_t>(y)] = bucket_id;
+                    scratch.ys.push_back(y);
+                }
+            }
+            band_buckets[b] += r1 - r0 > 1;
+            band_pairs[b] += x_blocks * y_blocks;
+
+            for (int y : scratch.ys) {
+                std::uint8_t* row = cells_.data() + static_cast<std::size_t>(y) * static_cast<std::size_t>(width_);
+                for (int x : scratch.xs) {
+                    std::atomic_ref<std::uint8_t>(row[x]).fetch_or(bit, std::memory_order_relaxed);
+                }
+            }
+            r0 = r1;
+        }
+    });
+    for (std::size_t b = 0; b < DOT_PLOT_BANDS; ++b) {
+        stats_.buckets += band_buckets[b];
+        stats_.pairs += band_pairs[b];
+    }
+
+    // Colors
+    std::atomic<std::uint64_t> lit{0};
+    parallel_for(static_cast<std::size_t>(height_), 64, [&](std::size_t y) {
+        const std::uint8_t* row = cells_.data() + y * static_cast<std::size_t>(width_);
+        std::uint32_t* out = pixels + y * stride;
+        std::uint64_t row_lit = 0;
+        for (int x = 0; x < width_; ++x) {
+            const int hits = std::popcount(row[x]);
+            row_lit += hits != 0;
+            out[x] = lut_[static_cast<std::size_t>(hits)];
+        }
+        lit.fetch_add(row_lit, std::memory_order_relaxed);
+    });
+    stats_.cells = lit.load(std::memory_order_relaxed);
+    stats_.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+int DotPlot::bands_at(int x, int y) const noexcept {
+    if (x < 0 || y < 0 || x >= width_ || y >= height_) return 0;
+    return std::popcount(cells_[static_cast<std::size_t>(y) * static_cast<std::size_t>(width_) + static_cast<std::size_t>(x)]);
+}
+
+} // namespace synopsia
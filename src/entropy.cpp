@@ -2,6 +2,7 @@
 /// @brief Jensen-Shannon divergence calculation implementation
 
 #include <synopsia/entropy.hpp>
+#include <synopsia/common/parallel.hpp>
 
 namespace synopsia {
 
@@ -32,6 +33,105 @@ double EntropyCalculator::calculate_at_address(ea_t ea, std::size_t size) const
     return calculate(read_buffer_.data(), bytes_read);
 }
 
+std::array<std::uint64_t, 256> EntropyCalculator::histogram_range(ea_t start_ea, ea_t end_ea) const {
+    std::array<std::uint64_t, 256> counts{};
+    
+    // Read in fixed-size chunks so large ranges don't allocate the whole range
+    constexpr std::size_t chunk_size = 64 * 1024;
+    
+    for (ea_t ea = start_ea; ea < end_ea; ) {
+        const std::size_t actual_size = std::min<std::size_t>(chunk_size, end_ea - ea);
+        const std::size_t bytes_read = read_bytes(ea, actual_size);
+        accumulate_histogram(read_buffer_.data(), bytes_read, counts);
+        ea += actual_size;
+    }
+    
+    return counts;
+}
+
+std::vector<ByteHistogram> EntropyCalculator::histogram_spans(
+    ea_t start_ea,
+    ea_t end_ea,
+    std::size_t span_size
+) const {
+    std::vector<ByteHistogram> spans;
+    
+    if (start_ea >= end_ea || span_size == 0) {
+        return spans;
+    }
+    
+    constexpr std::size_t target_window = 16 * 1024 * 1024;
+    const std::size_t window_size = std::max<std::size_t>(1, target_window / span_size) * span_size;
+    
+    for (int i = 0; i < get_segm_qty(); ++i) {
+        segment_t* seg = getnseg(i);
+        if (!seg || (seg->perm & SEGPERM_READ) == 0) continue;
+        
+        const ea_t lo = std::max(seg->start_ea, start_ea);
+        const ea_t hi = std::min(seg->end_ea, end_ea);
+        
+        for (ea_t window = lo; window < hi; ) {
+            const std::size_t size = std::min<std::size_t>(window_size, hi - window);
+            const std::size_t count = (size + span_size - 1) / span_size;
+            const std::size_t first = spans.size();
+            spans.resize(first + count);
+            
+            // IDA reads stay on this thread
+            const std::size_t bytes_read = read_bytes(window, size);
+            
+            if (bytes_read == size) {
+                const std::uint8_t* data = read_buffer_.data();
+                parallel_for(count, 16, [&](std::size_t s) {
+                    const std::size_t offset = s * span_size;
+                    const std::size_t actual_size = std::min(span_size, size - offset);
+                    
+                    std::array<std::uint64_t, 256> counts{};
+                    accumulate_histogram(data + offset, actual_size, counts);
+                    
+                    ByteHistogram& span = spans[first + s];
+                    span.start_addr = window + offset;
+                    span.end_addr = window + offset + actual_size;
+                    span.set_counts(counts, actual_size);
+                });
+            } else {
+                // Partially unreadable window: count per span, skipping what fails
+                for (std::size_t s = 0; s < count; ++s) {
+                    const ea_t span_start = window + s * span_size;
+                    const ea_t span_end = std::min<ea_t>(span_start + span_size, window + size);
+                    const auto counts = histogram_range(span_start, span_end);
+                    
+                    std::uint64_t total = 0;
+                    for (std::uint64_t c : counts) total += c;
+                    
+                    ByteHistogram& span = spans[first + s];
+                    span.start_addr = span_start;
+                    span.end_addr = span_end;
+                    span.set_counts(counts, total);
+                }
+            }
+            
+            window += size;
+        }
+    }
+    
+    return spans;
+}
+
+std::vector<ByteHistogram> EntropyCalculator::histogram_database(std::size_t* span_size) const {
+    std::uint64_t total = 0;
+    for (int i = 0; i < get_segm_qty(); ++i) {
+        segment_t* seg = getnseg(i);
+        if (seg && (seg->perm & SEGPERM_READ) != 0) {
+            total += seg->end_ea - seg->start_ea;
+        }
+    }
+    
+    const std::size_t span = byte_histogram_span(total);
+    if (span_size) *span_size = span;
+    const auto [db_min, db_max] = get_database_range();
+    return histogram_spans(db_min, db_max, span);
+}
+
 std::vector<MemoryRegion> EntropyCalculator::get_memory_regions() const {
     std::vector<MemoryRegion> regions;
     
@@ -152,7 +252,24 @@ std::vector<EntropyBlock> EntropyCalculator::analyze_range(
 }
 
 std::vector<EntropyBlock> EntropyCalculator::analyze_database(std::size_t block_size) const {
-    std::vector<EntropyBlock> all_blocks;
+    auto levels = analyze_database_levels(block_size, 1);
+    return levels.empty() ? std::vector<EntropyBlock>{} : std::move(levels.front());
+}
+
+std::vector<std::vector<EntropyBlock>> EntropyCalculator::analyze_database_levels(
+    std::size_t block_size,
+    std::size_t level_count
+) const {
+    std::vector<std::vector<EntropyBlock>> levels(level_count);
+    
+    if (block_size == 0 || level_count == 0) {
+        return levels;
+    }
+    
+    // Window is a multiple of the coarsest block so every level tiles it exactly
+    const std::size_t coarsest = block_size << (level_count - 1);
+    constexpr std::size_t target_window = 16 * 1024 * 1024;
+    const std::size_t window_size = std::max<std::size_t>(1, target_window / coarsest) * coarsest;
     
     // Analyze each segment
     for (int i = 0; i < get_segm_qty(); ++i) {
@@ -164,17 +281,52 @@ std::vector<EntropyBlock> EntropyCalculator::analyze_database(std::size_t block_
             continue;
         }
         
-        auto seg_blocks = analyze_segment(seg, block_size);
-        all_blocks.insert(all_blocks.end(), seg_blocks.begin(), seg_blocks.end());
+        for (ea_t window = seg->start_ea; window < seg->end_ea; ) {
+            const std::size_t size = std::min<std::size_t>(window_size, seg->end_ea - window);
+            
+            // IDA reads stay on this thread
+            const std::size_t bytes_read = read_bytes(window, size);
+            
+            for (std::size_t level = 0; level < level_count; ++level) {
+                const std::size_t level_block = block_size << level;
+                auto& blocks = levels[level];
+                
+                if (bytes_read != size) {
+                    // Partially unreadable window: fall back to per-block reads
+                    auto range_blocks = analyze_range(window, window + size, level_block);
+                    blocks.insert(blocks.end(), range_blocks.begin(), range_blocks.end());
+                    continue;
+                }
+                
+                const std::size_t count = (size + level_block - 1) / level_block;
+                const std::size_t first = blocks.size();
+                blocks.resize(first + count);
+                
+                const std::uint8_t* data = read_buffer_.data();
+                parallel_for(count, 256, [&](std::size_t b) {
+                    const std::size_t offset = b * level_block;
+                    const std::size_t actual_size = std::min(level_block, size - offset);
+                    
+                    EntropyBlock& block = blocks[first + b];
+                    block.start_ea = window + offset;
+                    block.end_ea = window + offset + actual_size;
+                    block.entropy = calculate(data + offset, actual_size);
+                });
+            }
+            
+            window += size;
+        }
     }
     
     // Sort by address (should already be sorted, but ensure it)
-    std::sort(all_blocks.begin(), all_blocks.end(),
-        [](const EntropyBlock& a, const EntropyBlock& b) {
-            return a.start_ea < b.start_ea;
-        });
+    for (auto& blocks : levels) {
+        std::sort(blocks.begin(), blocks.end(),
+            [](const EntropyBlock& a, const EntropyBlock& b) {
+                return a.start_ea < b.start_ea;
+            });
+    }
     
-    return all_blocks;
+    return levels;
 }
 
 } // namespace synopsia
@@ -0,0 +1,91 @@
+/// @file exploration.cpp
+/// @brief Exploration state transitions and history
+
+#include <synopsia/features/binary_map_3d/exploration.hpp>
+
+namespace synopsia {
+namespace features {
+namespace binary_map_3d {
+
+// ============================================================================
+// ExplorationState
+// ============================================================================
+
+ExplorationState ExplorationState::base(const std::vector<explore_addr_t>& functions) {
+    ExplorationState state;
+    for (explore_addr_t function : functions) {
+        state.present = state.present.set(function, 1);
+    }
+    return state;
+}
+
+ExplorationState ExplorationState::follow(explore_addr_t function, const std::vector<explore_addr_t>& neighbors,
+                                          std::size_t max_present) const {
+    if (followed.find(function)) return *this;
+
+    ExplorationState next = *this;
+    auto contribution = std::make_shared<std::vector<explore_addr_t>>();
+    for (explore_addr_t neighbor : neighbors) {
+        if (const std::uint32_t* count = next.present.find(neighbor)) {
+            next.present = next.present.set(neighbor, *count + 1);
+        } else if (next.present.size() < max_present) {
+            next.present = next.present.set(neighbor, 1);
+        } else {
+            continue;
+        }
+        contribution->push_back(neighbor);
+    }
+    next.followed = next.followed.set(function, std::move(contribution));
+    return next;
+}
+
+ExplorationState ExplorationState::unfollow(explore_addr_t function) const {
+    const FollowContribution* contribution = followed.find(function);
+    if (!contribution) return *this;
+
+    ExplorationState next = *this;
+    for (explore_addr_t neighbor : **contribution) {
+        const std::uint32_t* count = next.present.find(neighbor);
+        if (!count) continue;
+        next.present = *count > 1 ? next.present.set(neighbor, *count - 1) : next.present.erase(neighbor);
+    }
+    next.followed = next.followed.erase(function);
+    return next;
+}
+
+// ============================================================================
+// ExplorationHistory
+// ============================================================================
+
+void ExplorationHistory::reset(ExplorationState initial) {
+    steps_.clear();
+    steps_.push_back(std::move(initial));
+    position_ = 0;
+}
+
+void ExplorationHistory::push(ExplorationState next) {
+    steps_.resize(position_ + 1);
+    steps_.push_back(std::move(next));
+    // The initial state stays so unlocking can always return to it
+    if (steps_.size() > MAX_STEPS) {
+        steps_.erase(steps_.begin() + 1);
+    }
+    position_ = steps_.size() - 1;
+}
+
+void ExplorationHistory::go_back() {
+    if (can_go_back()) --position_;
+}
+
+void ExplorationHistory::go_forward() {
+    if (can_go_forward()) ++position_;
+}
+
+void ExplorationHistory::clear() {
+    steps_.clear();
+    position_ = 0;
+}
+
+} // namespace binary_map_3d
+} // namespace features
+} // namespace synopsia
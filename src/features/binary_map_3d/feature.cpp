@@ -21,7 +21,7 @@ namespace features {
 namespace binary_map_3d {
     void init_binary_map_3d_state();
     void cleanup_binary_map_3d_state();
-    void refresh_binary_map_3d_data();
+    const BinaryMapData* refresh_binary_map_3d_data();  // The widget's data, or nullptr
     void render_binary_map_3d();
     void on_binary_map_3d_cursor_changed(ea_t ea);
     void set_binary_map_3d_focused_mode(bool enabled);
@@ -49,7 +49,6 @@ bool BinaryMap3DFeature::initialize() {
         return false;
     }
 
-    data_ = std::make_unique<binary_map_3d::BinaryMapData>();
     initialized_ = true;
 
     msg("Synopsia [%s]: Feature initialized (hotkey: %s)\n",
@@ -63,7 +62,6 @@ void BinaryMap3DFeature::cleanup() {
 
     destroy_widget();
     unregister_actions();
-    data_.reset();
     binary_map_3d::cleanup_binary_map_3d_state();
     initialized_ = false;
 }
@@ -225,13 +223,16 @@ void BinaryMap3DFeature::refresh_data() {
         return;
     }
 
-    // Refresh the ImGui state
-    binary_map_3d::refresh_binary_map_3d_data();
-
-    // Also refresh our local data for info
-    if (data_ && data_->refresh()) {
-        msg("Synopsia [%s]: Loaded %zu functions, %zu edges\n",
-            binary_map_3d::FEATURE_NAME, data_->nodes().size(), data_->edges().size());
+    // Catalog only so far; the widget streams the call graph in
+    const binary_map_3d::BinaryMapData* data = binary_map_3d::refresh_binary_map_3d_data();
+    if (data && data->is_valid()) {
+        if (data->is_complete()) {
+            msg("Synopsia [%s]: Loaded %zu functions, %zu edges\n",
+                binary_map_3d::FEATURE_NAME, data->nodes().size(), data->edges().size());
+        } else {
+            msg("Synopsia [%s]: Loaded %zu functions, scanning call graph\n",
+                binary_map_3d::FEATURE_NAME, data->nodes().size());
+        }
     }
 }
 
@@ -2,9 +2,24 @@
 /// @brief Force-directed 3D call graph visualization
 
 #include <synopsia/features/binary_map_3d/map_data.hpp>
+#include <synopsia/features/binary_map_3d/treemap_view.hpp>
+#include <synopsia/features/binary_map_3d/exploration.hpp>
+#include <synopsia/features/function_search/name_tree.hpp>
+#include <synopsia/features/function_search/name_filter.hpp>
+#include <synopsia/core/analysis_cache.hpp>
+#include <synopsia/common/color.hpp>
+#include <synopsia/common/frame_arena.hpp>
+#include <synopsia/common/motif.hpp>
+#include <synopsia/entropy.hpp>
 #include <synopsia/imgui/qt_imgui_widget.hpp>
+#include <synopsia/core/selection.hpp>
 #include <funcs.hpp>
 #include <xref.hpp>
+#include <bytes.hpp>
+#include <gdl.hpp>
+#include <name.hpp>
+#include <nalt.hpp>
+#include <segment.hpp>
 
 #include <imgui.h>
 #include <imgui_internal.h>
@@ -14,6 +29,7 @@
 #include "core/GraphLayout.h"
 #include "core/PointF.h"
 
+#include <chrono>
 #include <cmath>
 #include <cctype>
 #include <memory>
@@ -176,6 +192,72 @@ struct Camera {
     }
 };
 
+// =============================================================================
+// Adaptive Canvas Resolution
+// =============================================================================
+
+/// Camera state compared frame to frame to detect movement
+struct ViewPose {
+    Vec3 target;
+    Vec3 position;
+    Vec3 pan_2d;
+    float distance = 0.0f;
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    float zoom_2d = 0.0f;
+    float dag_zoom = 0.0f;
+    float dag_pan_x = 0.0f;
+    float dag_pan_y = 0.0f;
+
+    bool operator==(const ViewPose& o) const {
+        return target.x == o.target.x && target.y == o.target.y && target.z == o.target.z &&
+               position.x == o.position.x && position.y == o.position.y && position.z == o.position.z &&
+               pan_2d.x == o.pan_2d.x && pan_2d.y == o.pan_2d.y && distance == o.distance && yaw == o.yaw &&
+               pitch == o.pitch && zoom_2d == o.zoom_2d && dag_zoom == o.dag_zoom && dag_pan_x == o.dag_pan_x &&
+               dag_pan_y == o.dag_pan_y;
+    }
+    bool operator!=(const ViewPose& o) const { return !(*this == o); }
+};
+
+/// Resolution factor for the graph canvas. While the camera moves, the
+/// factor follows the smoothed frame time towards the budget; once the view
+/// has been still for SETTLE_SECONDS the canvas is drawn at full resolution.
+/// The factor reached during the last movement is kept for the next one.
+class CanvasResolution {
+public:
+    static constexpr float MIN_SCALE = 0.35f;
+    static constexpr float FRAME_BUDGET = 1.0f / 45.0f;  // Seconds; the host ticks at ~60 Hz
+    static constexpr float SETTLE_SECONDS = 0.2f;
+    static constexpr float STEP = 0.05f;                 // Output granularity
+
+    float update(bool moving, float frame_seconds) {
+        smoothed_ += (frame_seconds - smoothed_) * 0.2f;
+        if (!moving) {
+            idle_ += frame_seconds;
+            return idle_ >= SETTLE_SECONDS ? 1.0f : quantized();
+        }
+
+        // Frames drawn at full resolution while settled overstate the cost
+        if (idle_ >= SETTLE_SECONDS) {
+            smoothed_ = std::min(smoothed_, FRAME_BUDGET);
+        }
+        idle_ = 0.0f;
+        if (smoothed_ > FRAME_BUDGET) {
+            scale_ = std::max(MIN_SCALE, scale_ * 0.85f);
+        } else if (smoothed_ < FRAME_BUDGET * 0.7f) {
+            scale_ = std::min(1.0f, scale_ * 1.05f);
+        }
+        return quantized();
+    }
+
+private:
+    [[nodiscard]] float quantized() const { return std::round(scale_ / STEP) * STEP; }
+
+    float scale_ = 1.0f;
+    float smoothed_ = 0.0f;
+    float idle_ = 0.0f;
+};
+
 // =============================================================================
 // Force-Directed Graph Node
 // =============================================================================
@@ -188,6 +270,8 @@ struct GraphNode {
     // Position and velocity for physics simulation
     Vec3 pos;
     Vec3 vel;
+    bool asleep = false;      // Settled: exerts forces but is not integrated
+    int calm_steps = 0;       // Consecutive steps below the sleep speed
 
     // Graph properties
     std::uint32_t caller_count = 0;
@@ -203,6 +287,13 @@ struct GraphNode {
     float scale = 1.0f;
 };
 
+// Hash for (from, to) call edge keys
+struct EdgeKeyHash {
+    std::size_t operator()(const std::pair<ea_t, ea_t>& edge) const noexcept {
+        return std::hash<ea_t>{}(edge.first) * 0x9E3779B97F4A7C15ULL ^ std::hash<ea_t>{}(edge.second);
+    }
+};
+
 // Edge polyline for DAG flowchart layout (orthogonal routing)
 struct DAGEdgePolyline {
     ea_t from_addr;
@@ -226,14 +317,24 @@ class ForceGraphState {
 public:
     ForceGraphState() = default;
 
+    [[nodiscard]] const BinaryMapData& data() const noexcept { return data_; }
+
     void refresh_data() {
-        data_.refresh();
+        // A rebuild replaces the edges the exploration steps index into
+        unlock_graph();
 
         // Get current EA from IDA if not established
         if (current_ea_ == BADADDR) {
             current_ea_ = get_screen_ea();
         }
 
+        // Catalog and layout load now; call edges stream in from pump_scan()
+        data_.begin_refresh(current_ea_);
+        treemap_view_.reset();
+        clear_motif();
+        motif_graph_.reset();
+        seen_generation_ = data_.generation();
+
         // In focused mode with valid EA, do targeted load (much faster for large binaries)
         if (only_show_neighbors_ && current_ea_ != BADADDR) {
             func_t* func = get_func(current_ea_);
@@ -255,6 +356,9 @@ public:
 
     void on_ea_changed(ea_t ea) {
         current_ea_ = ea;
+        if (!data_.is_complete()) {
+            data_.prioritize(ea);
+        }
         // In locked mode, don't update the graph
         if (graph_locked_) return;
         if (track_ea_) {
@@ -263,6 +367,7 @@ public:
     }
 
     void set_focused_mode(bool enabled) {
+        unlock_graph();
         track_ea_ = enabled;
         only_show_neighbors_ = enabled;
 
@@ -292,6 +397,10 @@ public:
     }
 
     void render() {
+        pump_scan();
+        pump_motif();
+        sync_selection();
+
         ImGuiIO& io = ImGui::GetIO();
         ImVec2 display_size = io.DisplaySize;
 
@@ -327,6 +436,43 @@ public:
 private:
     static constexpr std::size_t MAX_NODES = 2000;
     static constexpr int HUB_NODE_THRESHOLD = 20;  // Nodes with 20+ connections are "hubs"
+    static constexpr std::chrono::milliseconds SCAN_BUDGET{8};  // Per frame, at 60 FPS
+
+    /// Advance the progressive call-graph scan and merge newly published edges
+    void pump_scan() {
+        // Persist the finished scan so the next open skips the xref walk
+        if (!data_.is_complete() && data_.scan_step(SCAN_BUDGET)) {
+            data_.store_cache();
+        }
+        if (seen_generation_ == data_.generation() || graph_locked_) return;
+
+        // Static layouts are computed once, from the final graph
+        const bool static_layout = mode_2d_ || mode_dag_;
+        if (static_layout && !data_.is_complete()) return;
+        seen_generation_ = data_.generation();
+
+        // Focused mode reads its neighborhood straight from xrefs
+        if (only_show_neighbors_ && selected_addr_ != BADADDR) return;
+
+        // The node set is fixed by the catalog; keep settled positions and
+        // let the simulation pull in the new edges, waking only their ends
+        const auto motion = capture_motion();
+        auto previous_edges = edge_pairs();
+
+        build_full_graph();
+        apply_filter();
+
+        if (static_layout) {
+            restart_simulation();
+        } else {
+            restore_motion(motion);
+            wake_new_edges(std::move(previous_edges));
+            resume_simulation();
+        }
+        if (selected_node_idx_ >= 0) {
+            compute_distances_from_selection();
+        }
+    }
 
     void build_full_graph() {
         all_nodes_.clear();
@@ -658,223 +804,320 @@ private:
         }
     }
 
+    // =========================================================================
+    // Lock Mode Exploration
+    // =========================================================================
+
+    /// A function's call neighborhood, for adding it to the locked graph
+    struct FunctionLinks {
+        GraphNode node;              // Template: name, size, xref counts
+        std::vector<ea_t> callers;   // Sorted, unique
+        std::vector<ea_t> callees;
+        bool valid = false;          // False if no function starts there
+    };
+
     /// Toggle follow on a node (Alt+click in locked mode)
     void toggle_follow_node(ea_t addr) {
-        if (addr == BADADDR) return;
+        if (addr == BADADDR || exploration_.empty()) return;
+        if (addr_to_idx_.find(addr) == addr_to_idx_.end()) return;
 
-        // Check if node exists in our current graph (may be in base or expanded)
-        auto it = addr_to_idx_.find(addr);
-        if (it == addr_to_idx_.end()) {
-            // Node might not be in current graph but could be in base - check base
-            auto base_it = base_addr_to_idx_.find(addr);
-            if (base_it == base_addr_to_idx_.end()) return;
-        }
-
-        if (followed_nodes_.find(addr) != followed_nodes_.end()) {
-            // Unfollow: remove from set and rebuild graph from base + remaining follows
-            followed_nodes_.erase(addr);
-            rebuild_from_base_with_follows();
+        const ExplorationState current = exploration_.current();
+        ExplorationState next;
+        if (current.followed.find(addr)) {
+            next = current.unfollow(addr);
         } else {
-            // Follow: add to set and expand graph with neighbors
-            followed_nodes_.insert(addr);
-            if (it != addr_to_idx_.end()) {
-                nodes_[it->second].is_followed = true;
+            // Neighbors come from the link cache, so refollowing reads no xrefs
+            const FunctionLinks& links = links_of(addr);
+            std::vector<explore_addr_t> neighbors;
+            neighbors.reserve(links.callers.size() + links.callees.size());
+            for (ea_t caller : links.callers) {
+                if (caller != addr) neighbors.push_back(caller);
+            }
+            for (ea_t callee : links.callees) {
+                if (callee != addr && std::find(links.callers.begin(), links.callers.end(), callee) ==
+                                          links.callers.end()) {
+                    neighbors.push_back(callee);
+                }
             }
-            add_neighbors_to_graph(addr);
+            next = current.follow(addr, neighbors, MAX_NODES);
         }
 
-        // Recompute distances and opacity
-        compute_follow_distances();
+        exploration_.push(next);
+        apply_exploration(current, next);
     }
 
-    /// Add immediate neighbors of a node to the current graph (for follow mode)
-    void add_neighbors_to_graph(ea_t center_ea) {
-        if (center_ea == BADADDR) return;
-
-        func_t* func = get_func(center_ea);
-        if (!func) return;
-
-        std::vector<ea_t> new_neighbors;
-
-        // Find callers (xrefs TO this function)
-        xrefblk_t xb;
-        for (bool ok = xb.first_to(func->start_ea, XREF_FAR); ok; ok = xb.next_to()) {
-            if (xb.type != fl_CF && xb.type != fl_CN && xb.type != fl_JF && xb.type != fl_JN)
-                continue;
+    /// Step through the exploration history (back/forward in lock mode)
+    void step_exploration(bool forward) {
+        if (forward ? !exploration_.can_go_forward() : !exploration_.can_go_back()) return;
+        const ExplorationState from = exploration_.current();
+        if (forward) {
+            exploration_.go_forward();
+        } else {
+            exploration_.go_back();
+        }
+        apply_exploration(from, exploration_.current());
+    }
 
-            func_t* caller_func = get_func(xb.from);
-            if (!caller_func) continue;
+    /// Start lock mode from the graph on screen
+    void begin_exploration() {
+        std::vector<explore_addr_t> base;
+        base.reserve(nodes_.size());
+        for (const auto& node : nodes_) {
+            base.push_back(node.address);
+        }
+        exploration_.reset(ExplorationState::base(base));
+        links_cache_.clear();
+        parked_motion_.clear();
 
-            ea_t caller_ea = caller_func->start_ea;
-            if (addr_to_idx_.find(caller_ea) == addr_to_idx_.end()) {
-                new_neighbors.push_back(caller_ea);
+        // Index edges by endpoints so removals are found without a scan
+        edge_slots_.clear();
+        std::vector<CallEdge> unique_edges;
+        unique_edges.reserve(edges_.size());
+        for (const auto& edge : edges_) {
+            if (edge_slots_.emplace(std::make_pair(edge.from, edge.to), unique_edges.size()).second) {
+                unique_edges.push_back(edge);
             }
         }
+        edges_ = std::move(unique_edges);
+    }
 
-        // Find callees (xrefs FROM this function)
-        func_item_iterator_t fii;
-        for (bool ok = fii.set(func); ok; ok = fii.next_code()) {
-            ea_t item_ea = fii.current();
-            xrefblk_t xb2;
-            for (bool ok2 = xb2.first_from(item_ea, XREF_FAR); ok2; ok2 = xb2.next_from()) {
-                if (xb2.type != fl_CF && xb2.type != fl_CN && xb2.type != fl_JF && xb2.type != fl_JN)
-                    continue;
-
-                func_t* callee_func = get_func(xb2.to);
-                if (!callee_func) continue;
+    /// Return to the locked base graph and leave lock mode
+    void end_exploration() {
+        if (!exploration_.empty()) {
+            apply_exploration(exploration_.current(), exploration_.initial());
+        }
+        exploration_.clear();
+        links_cache_.clear();
+        parked_motion_.clear();
+        edge_slots_.clear();
+    }
 
-                ea_t callee_ea = callee_func->start_ea;
-                if (addr_to_idx_.find(callee_ea) == addr_to_idx_.end()) {
-                    new_neighbors.push_back(callee_ea);
-                }
-            }
+    /// Return to the locked graph and drop the follow highlights
+    void release_exploration() {
+        end_exploration();
+        for (auto& node : nodes_) {
+            node.is_followed = false;
+            node.follow_distance = -1;
         }
+        compute_distances_from_selection();
+    }
 
-        // Add new nodes to the graph
-        for (ea_t neighbor_ea : new_neighbors) {
-            func_t* nfunc = get_func(neighbor_ea);
-            if (!nfunc) continue;
+    /// Leave lock mode, if active, before anything rebuilds the graph
+    void unlock_graph() {
+        if (!graph_locked_) return;
+        graph_locked_ = false;
+        release_exploration();
+    }
 
-            // Check MAX_NODES limit
-            if (nodes_.size() >= MAX_NODES) break;
+    /// @brief Move the graph from one exploration state to another
+    ///
+    /// Only functions whose presence differs are touched: the maps share
+    /// their unchanged subtrees, so the diff never visits them.
+    void apply_exploration(const ExplorationState& from, const ExplorationState& to) {
+        std::vector<ea_t> removed;
+        std::vector<ea_t> added;
+        PersistentMap<std::uint32_t>::diff(
+            from.present, to.present,
+            [&](explore_addr_t addr, std::uint32_t) { removed.push_back(static_cast<ea_t>(addr)); },
+            [&](explore_addr_t addr, std::uint32_t) { added.push_back(static_cast<ea_t>(addr)); },
+            [](explore_addr_t, std::uint32_t, std::uint32_t) {});
 
-            GraphNode node;
-            node.address = neighbor_ea;
+        for (ea_t addr : removed) {
+            remove_explored_node(addr);
+        }
+        for (ea_t addr : added) {
+            add_explored_node(addr);
+        }
 
-            // Get function name
-            qstring name;
-            if (get_func_name(&name, neighbor_ea) > 0) {
-                node.name = name.c_str();
-            } else {
-                char buf[32];
-                qsnprintf(buf, sizeof(buf), "sub_%llX", (unsigned long long)neighbor_ea);
-                node.name = buf;
-            }
+        hovered_node_idx_ = -1;
+        if (selected_addr_ != BADADDR) {
+            auto sel_it = addr_to_idx_.find(selected_addr_);
+            selected_node_idx_ = sel_it != addr_to_idx_.end() ? static_cast<int>(sel_it->second) : -1;
+        }
 
-            node.size = static_cast<std::size_t>(nfunc->end_ea - nfunc->start_ea);
+        if (!removed.empty() || !added.empty()) {
+            resume_simulation();
+        }
+        compute_follow_distances();
+    }
 
-            // Random position near the parent
-            auto center_it = addr_to_idx_.find(center_ea);
-            Vec3 parent_pos = (center_it != addr_to_idx_.end()) ? nodes_[center_it->second].pos : Vec3(0, 0, 0);
+    /// Add a function and its edges to present neighbors; it returns where it last was
+    void add_explored_node(ea_t addr) {
+        if (addr_to_idx_.find(addr) != addr_to_idx_.end()) return;
+        const FunctionLinks& links = links_of(addr);
+        if (!links.valid) return;
+
+        GraphNode node = links.node;
+        auto parked = parked_motion_.find(addr);
+        if (parked != parked_motion_.end()) {
+            node.pos = parked->second.pos;
+            node.vel = parked->second.vel;
+        } else {
+            // Random position near the first neighbor already in the graph
+            Vec3 parent_pos(0, 0, 0);
+            for (const auto* list : {&links.callers, &links.callees}) {
+                for (ea_t neighbor : *list) {
+                    auto it = addr_to_idx_.find(neighbor);
+                    if (it != addr_to_idx_.end()) {
+                        parent_pos = nodes_[it->second].pos;
+                        break;
+                    }
+                }
+            }
             std::random_device rd;
             std::mt19937 rng(rd());
             std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
             node.pos = parent_pos + Vec3(dist(rng), dist(rng), dist(rng));
             node.vel = Vec3(0, 0, 0);
+        }
 
-            // Count xrefs
-            int caller_count = 0, callee_count = 0;
-            xrefblk_t xb3;
-            for (bool ok = xb3.first_to(neighbor_ea, XREF_FAR); ok; ok = xb3.next_to()) {
-                if (xb3.type == fl_CF || xb3.type == fl_CN) caller_count++;
-            }
-            for (bool ok = xb3.first_from(neighbor_ea, XREF_FAR); ok; ok = xb3.next_from()) {
-                if (xb3.type == fl_CF || xb3.type == fl_CN) callee_count++;
-            }
-            node.caller_count = caller_count;
-            node.callee_count = callee_count;
-
-            float connectivity = static_cast<float>(caller_count + callee_count);
-            node.scale = 0.8f + std::min(connectivity / 20.0f, 2.0f);
+        addr_to_idx_[addr] = nodes_.size();
+        nodes_.push_back(std::move(node));
 
-            addr_to_idx_[neighbor_ea] = nodes_.size();
-            nodes_.push_back(node);
+        // New nodes start awake; so do the neighbors that must make room
+        for (ea_t callee : links.callees) {
+            auto it = addr_to_idx_.find(callee);
+            if (it == addr_to_idx_.end()) continue;
+            add_explored_edge(addr, callee);
+            wake_node(nodes_[it->second]);
         }
+        for (ea_t caller : links.callers) {
+            auto it = addr_to_idx_.find(caller);
+            if (it == addr_to_idx_.end()) continue;
+            add_explored_edge(caller, addr);
+            wake_node(nodes_[it->second]);
+        }
+    }
 
-        // Add edges for new nodes
-        for (ea_t neighbor_ea : new_neighbors) {
-            if (addr_to_idx_.find(neighbor_ea) == addr_to_idx_.end()) continue;
-
-            func_t* nfunc = get_func(neighbor_ea);
-            if (!nfunc) continue;
+    /// Remove a function and its edges, remembering where it was
+    void remove_explored_node(ea_t addr) {
+        auto it = addr_to_idx_.find(addr);
+        if (it == addr_to_idx_.end()) return;
+        const std::size_t idx = it->second;
+        parked_motion_[addr] = NodeMotion{nodes_[idx].pos, nodes_[idx].vel, false, 0};
+
+        // Its neighbors lose forces and need to move
+        const FunctionLinks& links = links_of(addr);
+        for (ea_t callee : links.callees) {
+            remove_explored_edge(addr, callee);
+            auto neighbor = addr_to_idx_.find(callee);
+            if (neighbor != addr_to_idx_.end()) wake_node(nodes_[neighbor->second]);
+        }
+        for (ea_t caller : links.callers) {
+            remove_explored_edge(caller, addr);
+            auto neighbor = addr_to_idx_.find(caller);
+            if (neighbor != addr_to_idx_.end()) wake_node(nodes_[neighbor->second]);
+        }
+
+        // Swap-remove; the simulation rebuilds its awake list each step
+        if (idx + 1 != nodes_.size()) {
+            nodes_[idx] = std::move(nodes_.back());
+            addr_to_idx_[nodes_[idx].address] = idx;
+        }
+        nodes_.pop_back();
+        addr_to_idx_.erase(addr);
+    }
 
-            // Find calls from this function
-            func_item_iterator_t fii2;
-            for (bool ok = fii2.set(nfunc); ok; ok = fii2.next_code()) {
-                ea_t item_ea = fii2.current();
-                xrefblk_t xb4;
-                for (bool ok2 = xb4.first_from(item_ea, XREF_FAR); ok2; ok2 = xb4.next_from()) {
-                    if (xb4.type != fl_CF && xb4.type != fl_CN && xb4.type != fl_JF && xb4.type != fl_JN)
-                        continue;
+    void add_explored_edge(ea_t from, ea_t to) {
+        if (edge_slots_.emplace(std::make_pair(from, to), edges_.size()).second) {
+            edges_.push_back(CallEdge{from, to});
+        }
+    }
 
-                    func_t* callee_func = get_func(xb4.to);
-                    if (!callee_func) continue;
+    void remove_explored_edge(ea_t from, ea_t to) {
+        auto it = edge_slots_.find(std::make_pair(from, to));
+        if (it == edge_slots_.end()) return;
+        const std::size_t slot = it->second;
+        edge_slots_.erase(it);
+        if (slot + 1 != edges_.size()) {
+            edges_[slot] = edges_.back();
+            edge_slots_[std::make_pair(edges_[slot].from, edges_[slot].to)] = slot;
+        }
+        edges_.pop_back();
+    }
 
-                    ea_t callee_ea = callee_func->start_ea;
-                    if (addr_to_idx_.find(callee_ea) != addr_to_idx_.end()) {
-                        CallEdge edge;
-                        edge.from = neighbor_ea;
-                        edge.to = callee_ea;
-                        edges_.push_back(edge);
-                    }
-                }
-            }
+    /// Callers, callees and node template of a function, read from xrefs once per lock
+    const FunctionLinks& links_of(ea_t addr) {
+        auto [it, inserted] = links_cache_.try_emplace(addr);
+        FunctionLinks& links = it->second;
+        if (!inserted) return links;
 
-            // Find calls to this function (from existing nodes)
-            xrefblk_t xb5;
-            for (bool ok = xb5.first_to(neighbor_ea, XREF_FAR); ok; ok = xb5.next_to()) {
-                if (xb5.type != fl_CF && xb5.type != fl_CN && xb5.type != fl_JF && xb5.type != fl_JN)
-                    continue;
+        func_t* func = get_func(addr);
+        if (!func) return links;
+        links.valid = true;
 
-                func_t* caller_func = get_func(xb5.from);
-                if (!caller_func) continue;
+        auto is_flow = [](uchar type) {
+            return type == fl_CF || type == fl_CN || type == fl_JF || type == fl_JN;
+        };
 
-                ea_t caller_ea = caller_func->start_ea;
-                if (addr_to_idx_.find(caller_ea) != addr_to_idx_.end()) {
-                    CallEdge edge;
-                    edge.from = caller_ea;
-                    edge.to = neighbor_ea;
-                    edges_.push_back(edge);
-                }
+        // Callers (xrefs TO this function)
+        xrefblk_t xb;
+        for (bool ok = xb.first_to(func->start_ea, XREF_FAR); ok; ok = xb.next_to()) {
+            if (!is_flow(xb.type)) continue;
+            if (func_t* caller = get_func(xb.from)) {
+                links.callers.push_back(caller->start_ea);
             }
         }
 
-        // Restart simulation to settle new nodes
-        simulation_running_ = true;
-        simulation_iterations_ = std::max(0, simulation_iterations_ - 100);
-    }
-
-    /// Rebuild graph from base state plus neighbors of all followed nodes
-    /// Called when unfollowing a node to properly remove dynamically added nodes
-    void rebuild_from_base_with_follows() {
-        if (base_nodes_.empty()) return;
-
-        // Start from base state
-        nodes_ = base_nodes_;
-        edges_ = base_edges_;
-        addr_to_idx_ = base_addr_to_idx_;
-
-        // Re-add neighbors for all remaining followed nodes
-        for (ea_t followed_addr : followed_nodes_) {
-            // Mark the followed node
-            auto it = addr_to_idx_.find(followed_addr);
-            if (it != addr_to_idx_.end()) {
-                nodes_[it->second].is_followed = true;
+        // Callees (xrefs FROM this function's code)
+        func_item_iterator_t fii;
+        for (bool ok = fii.set(func); ok; ok = fii.next_code()) {
+            xrefblk_t xb2;
+            for (bool ok2 = xb2.first_from(fii.current(), XREF_FAR); ok2; ok2 = xb2.next_from()) {
+                if (!is_flow(xb2.type)) continue;
+                if (func_t* callee = get_func(xb2.to)) {
+                    links.callees.push_back(callee->start_ea);
+                }
             }
-            // Add its neighbors
-            add_neighbors_to_graph(followed_addr);
         }
 
-        // Update selected_node_idx_ to match new addr_to_idx_
-        if (selected_addr_ != BADADDR) {
-            auto sel_it = addr_to_idx_.find(selected_addr_);
-            if (sel_it != addr_to_idx_.end()) {
-                selected_node_idx_ = static_cast<int>(sel_it->second);
-            } else {
-                selected_node_idx_ = -1;
-            }
+        for (auto* list : {&links.callers, &links.callees}) {
+            std::sort(list->begin(), list->end());
+            list->erase(std::unique(list->begin(), list->end()), list->end());
         }
+
+        GraphNode& node = links.node;
+        node.address = func->start_ea;
+        qstring name;
+        if (get_func_name(&name, func->start_ea) > 0) {
+            node.name = name.c_str();
+        } else {
+            char buf[32];
+            qsnprintf(buf, sizeof(buf), "sub_%llX", (unsigned long long)func->start_ea);
+            node.name = buf;
+        }
+        node.size = static_cast<std::uint32_t>(func->end_ea - func->start_ea);
+
+        // Direct call xrefs size the node
+        int caller_count = 0, callee_count = 0;
+        xrefblk_t xb3;
+        for (bool ok = xb3.first_to(func->start_ea, XREF_FAR); ok; ok = xb3.next_to()) {
+            if (xb3.type == fl_CF || xb3.type == fl_CN) caller_count++;
+        }
+        for (bool ok = xb3.first_from(func->start_ea, XREF_FAR); ok; ok = xb3.next_from()) {
+            if (xb3.type == fl_CF || xb3.type == fl_CN) callee_count++;
+        }
+        node.caller_count = caller_count;
+        node.callee_count = callee_count;
+        const float connectivity = static_cast<float>(caller_count + callee_count);
+        node.scale = 0.8f + std::min(connectivity / 20.0f, 2.0f);
+        return links;
+    }
+
+    [[nodiscard]] bool is_following() const {
+        return !exploration_.empty() && !exploration_.current().followed.empty();
     }
 
     /// Compute distances from all followed nodes (BFS) and update opacity
     void compute_follow_distances() {
         // Reset follow distances
+        const bool following = is_following();
         for (auto& node : nodes_) {
             node.follow_distance = -1;
-            node.is_followed = (followed_nodes_.find(node.address) != followed_nodes_.end());
+            node.is_followed = following && exploration_.current().followed.find(node.address) != nullptr;
         }
 
-        if (followed_nodes_.empty()) {
+        if (!following) {
             // No followed nodes - full opacity for all
             for (auto& node : nodes_) {
                 node.opacity = 1.0f;
@@ -882,6 +1125,15 @@ private:
             return;
         }
 
+        std::vector<std::vector<std::size_t>> adj(nodes_.size());
+        for (const auto& edge : edges_) {
+            auto it_from = addr_to_idx_.find(edge.from);
+            auto it_to = addr_to_idx_.find(edge.to);
+            if (it_from == addr_to_idx_.end() || it_to == addr_to_idx_.end()) continue;
+            adj[it_from->second].push_back(it_to->second);
+            adj[it_to->second].push_back(it_from->second);
+        }
+
         // BFS from all followed nodes simultaneously
         std::vector<std::size_t> queue;
         for (std::size_t i = 0; i < nodes_.size(); ++i) {
@@ -896,20 +1148,9 @@ private:
         while (head < queue.size()) {
             std::size_t current_idx = queue[head++];
             int current_dist = nodes_[current_idx].follow_distance;
-            ea_t current_addr = nodes_[current_idx].address;
-
-            // Find neighbors via edges
-            for (const auto& edge : edges_) {
-                std::size_t neighbor_idx = SIZE_MAX;
-                if (edge.from == current_addr) {
-                    auto it = addr_to_idx_.find(edge.to);
-                    if (it != addr_to_idx_.end()) neighbor_idx = it->second;
-                } else if (edge.to == current_addr) {
-                    auto it = addr_to_idx_.find(edge.from);
-                    if (it != addr_to_idx_.end()) neighbor_idx = it->second;
-                }
 
-                if (neighbor_idx != SIZE_MAX && nodes_[neighbor_idx].follow_distance < 0) {
+            for (std::size_t neighbor_idx : adj[current_idx]) {
+                if (nodes_[neighbor_idx].follow_distance < 0) {
                     int new_dist = current_dist + 1;
                     nodes_[neighbor_idx].follow_distance = new_dist;
                     max_follow_dist = std::max(max_follow_dist, new_dist);
@@ -936,10 +1177,112 @@ private:
 
     void restart_simulation() {
         init_positions();
+        wake_all();
         simulation_running_ = true;
         simulation_iterations_ = 0;
     }
 
+    /// Resume the simulation for nodes that were woken (or added) since it settled
+    void resume_simulation() {
+        simulation_running_ = true;
+        simulation_iterations_ = std::max(0, simulation_iterations_ - 100);
+    }
+
+    // =========================================================================
+    // Node Sleeping
+    // =========================================================================
+
+    /// Motion state carried across graph rebuilds
+    struct NodeMotion {
+        Vec3 pos;
+        Vec3 vel;
+        bool asleep = false;
+        int calm_steps = 0;
+    };
+
+    std::unordered_map<ea_t, NodeMotion> capture_motion() const {
+        std::unordered_map<ea_t, NodeMotion> motion;
+        motion.reserve(nodes_.size());
+        for (const auto& node : nodes_) {
+            motion.emplace(node.address, NodeMotion{node.pos, node.vel, node.asleep, node.calm_steps});
+        }
+        return motion;
+    }
+
+    /// Put surviving nodes back where they were; nodes new to the graph stay awake
+    void restore_motion(const std::unordered_map<ea_t, NodeMotion>& motion) {
+        for (auto& node : nodes_) {
+            auto it = motion.find(node.address);
+            if (it == motion.end()) continue;
+            node.pos = it->second.pos;
+            node.vel = it->second.vel;
+            node.asleep = it->second.asleep;
+            node.calm_steps = it->second.calm_steps;
+        }
+    }
+
+    void wake_node(GraphNode& node) {
+        node.asleep = false;
+        node.calm_steps = 0;
+    }
+
+    void wake_all() {
+        for (auto& node : nodes_) {
+            wake_node(node);
+        }
+    }
+
+    /// Wake a node and everything within `hops` call edges of it
+    void wake_around(ea_t addr, int hops) {
+        auto start = addr_to_idx_.find(addr);
+        if (start == addr_to_idx_.end()) return;
+
+        std::vector<std::vector<std::size_t>> adj(nodes_.size());
+        for (const auto& edge : edges_) {
+            auto it_from = addr_to_idx_.find(edge.from);
+            auto it_to = addr_to_idx_.find(edge.to);
+            if (it_from == addr_to_idx_.end() || it_to == addr_to_idx_.end()) continue;
+            adj[it_from->second].push_back(it_to->second);
+            adj[it_to->second].push_back(it_from->second);
+        }
+
+        std::vector<int> depth(nodes_.size(), -1);
+        std::vector<std::size_t> frontier = {start->second};
+        depth[start->second] = 0;
+        for (std::size_t head = 0; head < frontier.size(); ++head) {
+            const std::size_t idx = frontier[head];
+            wake_node(nodes_[idx]);
+            if (depth[idx] >= hops) continue;
+            for (std::size_t next : adj[idx]) {
+                if (depth[next] < 0) {
+                    depth[next] = depth[idx] + 1;
+                    frontier.push_back(next);
+                }
+            }
+        }
+    }
+
+    /// Wake both ends of edges that were not in `before`
+    void wake_new_edges(std::vector<std::pair<ea_t, ea_t>> before) {
+        std::sort(before.begin(), before.end());
+        for (const auto& edge : edges_) {
+            if (std::binary_search(before.begin(), before.end(), std::make_pair(edge.from, edge.to))) continue;
+            auto it_from = addr_to_idx_.find(edge.from);
+            auto it_to = addr_to_idx_.find(edge.to);
+            if (it_from != addr_to_idx_.end()) wake_node(nodes_[it_from->second]);
+            if (it_to != addr_to_idx_.end()) wake_node(nodes_[it_to->second]);
+        }
+    }
+
+    [[nodiscard]] std::vector<std::pair<ea_t, ea_t>> edge_pairs() const {
+        std::vector<std::pair<ea_t, ea_t>> pairs;
+        pairs.reserve(edges_.size());
+        for (const auto& edge : edges_) {
+            pairs.emplace_back(edge.from, edge.to);
+        }
+        return pairs;
+    }
+
     void init_positions() {
         if (mode_dag_) {
             // DAG mode: use hierarchical flowchart layout
@@ -1355,9 +1698,37 @@ private:
         const float min_dist = 0.5f;
         const float dt = 0.1f;
 
-        // Repulsion between all nodes (use spatial hashing for large graphs)
+        // Only awake nodes are integrated. Sleeping nodes still push and pull
+        // on awake ones, so pairs with at least one awake end are visited:
+        // O(awake * n) instead of O(n^2) once most of the graph has settled.
+        awake_.clear();
         for (std::size_t i = 0; i < nodes_.size(); ++i) {
-            for (std::size_t j = i + 1; j < nodes_.size(); ++j) {
+            if (!nodes_[i].asleep) awake_.push_back(i);
+        }
+        if (awake_.empty()) {
+            simulation_running_ = false;
+            return;
+        }
+
+        speed_.resize(nodes_.size());
+        for (std::size_t i : awake_) {
+            speed_[i] = nodes_[i].vel.length();
+        }
+        to_wake_.clear();
+
+        // A fast node wakes sleeping nodes it passes close to
+        auto disturb = [this](std::size_t mover, std::size_t sleeper, float dist_sq) {
+            if (speed_[mover] > WAKE_SPEED && dist_sq < WAKE_RADIUS * WAKE_RADIUS) {
+                to_wake_.push_back(sleeper);
+            }
+        };
+
+        // Repulsion
+        for (std::size_t i : awake_) {
+            for (std::size_t j = 0; j < nodes_.size(); ++j) {
+                const bool other_awake = !nodes_[j].asleep;
+                if (j == i || (other_awake && j < i)) continue;  // Awake pairs once
+
                 Vec3 delta = nodes_[i].pos - nodes_[j].pos;
                 float dist_sq = delta.length_sq();
                 if (dist_sq < 0.01f) dist_sq = 0.01f;
@@ -1366,7 +1737,11 @@ private:
                 Vec3 dir = delta.normalized();
 
                 nodes_[i].vel += dir * force * dt;
-                nodes_[j].vel += dir * (-force) * dt;
+                if (other_awake) {
+                    nodes_[j].vel += dir * (-force) * dt;
+                } else {
+                    disturb(i, j, dist_sq);
+                }
             }
         }
 
@@ -1378,6 +1753,7 @@ private:
 
             std::size_t i = it_from->second;
             std::size_t j = it_to->second;
+            if (nodes_[i].asleep && nodes_[j].asleep) continue;
 
             Vec3 delta = nodes_[j].pos - nodes_[i].pos;
             float dist = delta.length();
@@ -1386,38 +1762,59 @@ private:
             Vec3 dir = delta.normalized();
             float force = (dist - min_dist) * attraction;
 
-            nodes_[i].vel += dir * force * dt;
-            nodes_[j].vel += dir * (-force) * dt;
+            if (!nodes_[i].asleep) nodes_[i].vel += dir * force * dt;
+            if (!nodes_[j].asleep) nodes_[j].vel += dir * (-force) * dt;
+
+            // Edges reach further than repulsion: a moving end always wakes the other
+            if (nodes_[i].asleep && speed_[j] > WAKE_SPEED) to_wake_.push_back(i);
+            if (nodes_[j].asleep && speed_[i] > WAKE_SPEED) to_wake_.push_back(j);
         }
 
         // Center gravity (pull towards origin)
-        for (auto& node : nodes_) {
-            node.vel += node.pos * (-0.01f) * dt;
+        for (std::size_t i : awake_) {
+            nodes_[i].vel += nodes_[i].pos * (-0.01f) * dt;
         }
 
         // Apply velocities with damping
         // Keep selected node fixed at center
         float max_vel = 0.0f;
-        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        for (std::size_t i : awake_) {
             auto& node = nodes_[i];
             
             // Keep selected node fixed at center
             if (static_cast<int>(i) == selected_node_idx_) {
                 node.pos = Vec3(0, 0, 0);
                 node.vel = Vec3(0, 0, 0);
+                node.asleep = true;
                 continue;
             }
             
             node.vel = node.vel * damping;
             node.pos += node.vel * dt;
-            max_vel = std::max(max_vel, node.vel.length());
+            const float speed = node.vel.length();
+            max_vel = std::max(max_vel, speed);
+
+            node.calm_steps = speed < SLEEP_SPEED ? node.calm_steps + 1 : 0;
+            if (node.calm_steps >= SLEEP_STEPS) {
+                node.asleep = true;
+                node.vel = Vec3(0, 0, 0);
+            }
+        }
+
+        for (std::size_t i : to_wake_) {
+            wake_node(nodes_[i]);
         }
 
         ++simulation_iterations_;
 
         // Stop simulation when stable
-        if (max_vel < 0.01f || simulation_iterations_ > 500) {
+        if ((max_vel < 0.01f && to_wake_.empty()) || simulation_iterations_ > 500) {
             simulation_running_ = false;
+            for (auto& node : nodes_) {
+                node.asleep = true;
+                node.vel = Vec3(0, 0, 0);
+            }
+            awake_.clear();
         }
     }
 
@@ -1505,6 +1902,12 @@ private:
                 bool is_selected = (node_idx == selected_node_idx_);
 
                 if (ImGui::Selectable(node.name.c_str(), is_selected)) {
+                    if (graph_locked_) {
+                        // In locked mode the graph stays put: only navigate
+                        jump_to_node(node_idx);
+                        jumpto(node.address);
+                        continue;
+                    }
                     // Jump to and select this node
                     selected_addr_ = node.address;
                     if (only_show_neighbors_) {
@@ -1524,13 +1927,22 @@ private:
             ImGui::EndChild();
         }
 
+        render_motif_panel();
+
         ImGui::Separator();
 
         ImGui::Text("Functions: %zu", nodes_.size());
         ImGui::Text("Edges: %zu", edges_.size());
 
+        if (!data_.is_complete()) {
+            char overlay[64];
+            qsnprintf(overlay, sizeof(overlay), "Scanning calls %.0f%%", data_.scan_progress() * 100.0f);
+            ImGui::ProgressBar(data_.scan_progress(), ImVec2(-1, 0), overlay);
+        }
+
         if (simulation_running_) {
-            ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "Simulating... (%d)", simulation_iterations_);
+            ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "Simulating... (%d, %zu awake)",
+                               simulation_iterations_, awake_.size());
         } else {
             ImGui::TextDisabled("Simulation complete");
         }
@@ -1539,7 +1951,7 @@ private:
         ImGui::Text("Settings:");
 
         if (ImGui::SliderInt("Max Depth", &max_depth_, 1, 10)) {
-            if (only_show_neighbors_ && selected_addr_ != BADADDR) {
+            if (only_show_neighbors_ && selected_addr_ != BADADDR && !graph_locked_) {
                 // Re-load neighbors with new depth
                 load_neighbors_from_ea(selected_addr_);
                 restart_simulation();
@@ -1557,6 +1969,11 @@ private:
         if (show_labels_) {
             ImGui::SliderFloat("Label Distance", &label_distance_, 5.0f, 100.0f);
         }
+        ImGui::Checkbox("Adaptive Resolution", &adaptive_resolution_);
+        if (adaptive_resolution_ && canvas_scale_ < 1.0f) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(%.0f%%)", canvas_scale_ * 100.0f);
+        }
 
         ImGui::Separator();
         ImGui::Text("EA Tracking:");
@@ -1571,6 +1988,8 @@ private:
             ImGui::TextDisabled("(follows IDA cursor)");
         }
 
+        // Both reload the graph, which would invalidate the exploration steps
+        ImGui::BeginDisabled(graph_locked_);
         bool prev_only_neighbors = only_show_neighbors_;
         ImGui::Checkbox("Only Callers/Callees", &only_show_neighbors_);
         if (only_show_neighbors_ != prev_only_neighbors) {
@@ -1602,6 +2021,7 @@ private:
             ImGui::SameLine();
             ImGui::TextDisabled("(20+ conns)");
         }
+        ImGui::EndDisabled();
 
         ImGui::Separator();
         ImGui::Text("Lock Mode:");
@@ -1610,42 +2030,30 @@ private:
         ImGui::Checkbox("Lock Graph", &graph_locked_);
         if (graph_locked_ != prev_locked) {
             if (graph_locked_) {
-                // Locking: capture current graph as base state for follow mode
-                base_nodes_ = nodes_;
-                base_edges_ = edges_;
-                base_addr_to_idx_ = addr_to_idx_;
+                // Locking: the current graph becomes the first exploration step
+                begin_exploration();
             } else {
-                // Unlocking: clear followed nodes and restore base state
-                followed_nodes_.clear();
-                nodes_ = base_nodes_;
-                edges_ = base_edges_;
-                addr_to_idx_ = base_addr_to_idx_;
-                for (auto& node : nodes_) {
-                    node.is_followed = false;
-                    node.follow_distance = -1;
-                }
-                // Update selected_node_idx_ to match restored addr_to_idx_
-                if (selected_addr_ != BADADDR) {
-                    auto sel_it = addr_to_idx_.find(selected_addr_);
-                    if (sel_it != addr_to_idx_.end()) {
-                        selected_node_idx_ = static_cast<int>(sel_it->second);
-                    } else {
-                        selected_node_idx_ = -1;
-                    }
-                }
-                compute_distances_from_selection();
-                // Clear base state
-                base_nodes_.clear();
-                base_edges_.clear();
-                base_addr_to_idx_.clear();
+                // Unlocking: return to the locked graph
+                release_exploration();
             }
         }
         if (graph_locked_) {
             ImGui::SameLine();
             ImGui::TextDisabled("(Alt+click to follow)");
 
-            if (!followed_nodes_.empty()) {
-                ImGui::Text("Following: %zu nodes", followed_nodes_.size());
+            // Steps share structure, so moving between them costs only what changed
+            ImGui::BeginDisabled(!exploration_.can_go_back());
+            if (ImGui::SmallButton("<")) step_exploration(false);
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+            ImGui::BeginDisabled(!exploration_.can_go_forward());
+            if (ImGui::SmallButton(">")) step_exploration(true);
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+            ImGui::TextDisabled("Step %zu/%zu", exploration_.position() + 1, exploration_.size());
+
+            if (is_following()) {
+                ImGui::Text("Following: %zu nodes", exploration_.current().followed.size());
             } else {
                 ImGui::TextDisabled("Alt+click nodes to follow");
             }
@@ -1657,8 +2065,8 @@ private:
         bool prev_2d = mode_2d_;
         if (ImGui::Checkbox("2D Force Layout", &mode_2d_)) {
             if (mode_2d_ != prev_2d) {
-                // Disable DAG mode when enabling 2D
-                if (mode_2d_) mode_dag_ = false;
+                // Disable DAG and treemap modes when enabling 2D
+                if (mode_2d_) mode_dag_ = mode_treemap_ = false;
                 // Exit free flight when switching to 2D
                 if (mode_2d_ && camera_.free_flight) {
                     camera_.exit_free_flight();
@@ -1675,8 +2083,8 @@ private:
         bool prev_dag = mode_dag_;
         if (ImGui::Checkbox("DAG Flowchart", &mode_dag_)) {
             if (mode_dag_ != prev_dag) {
-                // Disable 2D mode when enabling DAG
-                if (mode_dag_) mode_2d_ = false;
+                // Disable 2D and treemap modes when enabling DAG
+                if (mode_dag_) mode_2d_ = mode_treemap_ = false;
                 // Exit free flight when switching to DAG
                 if (mode_dag_ && camera_.free_flight) {
                     camera_.exit_free_flight();
@@ -1690,8 +2098,21 @@ private:
             ImGui::TextDisabled("(orthogonal)");
         }
 
+        if (ImGui::Checkbox("Treemap", &mode_treemap_)) {
+            // Functions by segment/namespace and size; replaces the graph view
+            if (mode_treemap_) {
+                mode_2d_ = mode_dag_ = false;
+                if (camera_.free_flight) {
+                    camera_.exit_free_flight();
+                }
+            }
+        }
+        if (mode_treemap_) {
+            treemap_view_.render_controls();
+        }
+
         // Free Flight only available in 3D mode
-        if (!mode_2d_ && !mode_dag_) {
+        if (!mode_2d_ && !mode_dag_ && !mode_treemap_) {
             if (ImGui::Checkbox("Free Flight", &camera_.free_flight)) {
                 if (camera_.free_flight) {
                     camera_.enter_free_flight();
@@ -1702,9 +2123,7 @@ private:
         }
 
         if (ImGui::Button("Reset Layout")) {
-            init_positions();
-            simulation_running_ = true;
-            simulation_iterations_ = 0;
+            restart_simulation();
         }
         ImGui::SameLine();
         if (ImGui::Button("Reset View")) {
@@ -1781,20 +2200,247 @@ private:
         search_results_.clear();
         if (search_buffer_[0] == '\0') return;
 
-        std::string query(search_buffer_);
-        // Convert to lowercase for case-insensitive search
-        for (auto& c : query) c = static_cast<char>(std::tolower(c));
-
+        // Case-insensitive: names are folded while matching, not copied
+        const std::string_view query = FrameArena::instance().lowercase(search_buffer_);
         for (std::size_t i = 0; i < nodes_.size(); ++i) {
-            std::string name = nodes_[i].name;
-            for (auto& c : name) c = static_cast<char>(std::tolower(c));
-
-            if (name.find(query) != std::string::npos) {
+            if (function_search::contains_lowercase(nodes_[i].name, query)) {
                 search_results_.push_back(static_cast<int>(i));
             }
         }
     }
 
+    void render_motif_panel() {
+        ImGui::Separator();
+        ImGui::Text("Motif:");
+        ImGui::SameLine();
+        ImGui::TextDisabled("(?)");
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Call-graph shapes, e.g.\n"
+                              "  (f) -[2]-> (name~socket), (f) -[2]-> (name~createprocess)\n"
+                              "  (d out>=50 callees:leaf)\n"
+                              "  (a) -> (b import) -> (a)\n"
+                              "Nodes: (var name~text name=text leaf root import lib !flag\n"
+                              "        out>=n in<n callees:flag)\n"
+                              "Edges: ->  <-  -[n]->  -[m..n]->  <-[n]-\n"
+                              "Press Enter to search.");
+        }
+        ImGui::SetNextItemWidth(-1);
+        if (ImGui::InputText("##motif", motif_buffer_, sizeof(motif_buffer_), ImGuiInputTextFlags_EnterReturnsTrue)) {
+            run_motif();
+        }
+
+        if (!motif_error_.empty()) {
+            ImGui::TextColored(ImVec4(1.0f, 0.45f, 0.45f, 1.0f), "%s", motif_error_.c_str());
+            return;
+        }
+        if (!motif_query_) return;
+
+        const std::size_t stride = motif_query_->variable_count();
+        const std::size_t count = motif_matches_.size() / stride;
+        if (motif_search_.is_searching()) {
+            ImGui::Text("Searching... %.0f%%  %zu matches", motif_search_.progress() * 100.0f, count);
+        } else {
+            ImGui::Text("%zu matches%s", count, motif_search_.truncated() ? " (limit reached)" : "");
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("%s", motif_query_->describe().c_str());
+        }
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Clear##motif")) {
+            clear_motif();
+            return;
+        }
+        if (motif_partial_) {
+            ImGui::TextDisabled("(call graph was still being scanned)");
+        }
+        if (count == 0) return;
+
+        ImGui::BeginChild("##motif-results", ImVec2(-1, 140), true);
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(count));
+        char label[512];
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                // "var=name" per variable, in pattern order
+                std::size_t used = 0;
+                label[0] = '\0';
+                for (std::size_t v = 0; v < stride && used + 1 < sizeof(label); ++v) {
+                    const graph_index_t node = motif_matches_[row * stride + v];
+                    const int written = qsnprintf(label + used, sizeof(label) - used, "%s%s=%s", v ? "  " : "",
+                                                  motif_query_->variable_name(v).c_str(), motif_node_name(node).c_str());
+                    if (written <= 0) break;
+                    used = std::min(sizeof(label) - 1, used + static_cast<std::size_t>(written));
+                }
+                ImGui::PushID(row);
+                if (ImGui::Selectable(label, row == motif_picked_)) {
+                    pick_motif_match(row);
+                }
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndChild();
+    }
+
+    /// Compile the motif text and start searching the catalog's call graph
+    void run_motif() {
+        clear_motif();
+        if (motif_buffer_[0] == '\0') return;
+
+        auto query = std::make_shared<MotifQuery>();
+        if (!query->compile(motif_buffer_, motif_error_)) return;
+
+        // The search thread gets its own copy of the graph; the scan keeps publishing into data_
+        if (!motif_graph_ || motif_generation_ != data_.generation()) {
+            motif_graph_ = build_motif_graph();
+            motif_generation_ = data_.generation();
+        }
+
+        // Labels are read fresh so renames since the last search count
+        motif_query_ = std::move(query);
+        motif_partial_ = !data_.is_complete();
+        motif_marks_.assign(motif_graph_->node_count(), 0);
+        motif_search_.submit(motif_graph_, build_motif_labels(), motif_query_, MAX_MOTIF_MATCHES);
+    }
+
+    /// @brief The catalog's call graph plus a node per imported symbol (main thread)
+    ///
+    /// Imports called through the IAT (`call ds:__imp_X`) are data, not
+    /// functions, so the scan never sees them. Each gets a node after the
+    /// catalog's, with an edge from every function that references its slot.
+    std::shared_ptr<const CallGraph> build_motif_graph() {
+        motif_imports_.clear();
+        for (int module = 0; module < static_cast<int>(get_import_module_qty()); ++module) {
+            enum_import_names(module, [](ea_t ea, const char* name, uval_t ord, void* param) -> int {
+                auto& imports = *static_cast<std::vector<MotifImport>*>(param);
+                imports.push_back({ea, name && name[0] ? std::string(name) : "ord_" + std::to_string(ord)});
+                return 1;
+            }, &motif_imports_);
+        }
+
+        const CsrAdjacency& callees = data_.graph().adjacency(GraphDirection::Callees);
+        std::vector<std::pair<graph_index_t, graph_index_t>> edges;
+        edges.reserve(callees.targets.size());
+        for (graph_index_t i = 0; i < callees.node_count(); ++i) {
+            for (graph_index_t target : callees.neighbors(i)) {
+                edges.emplace_back(i, target);
+            }
+        }
+
+        const std::size_t function_count = data_.nodes().size();
+        motif_function_count_ = function_count;
+        for (std::size_t k = 0; k < motif_imports_.size(); ++k) {
+            const auto import_node = static_cast<graph_index_t>(function_count + k);
+            xrefblk_t xref;
+            for (bool ok = xref.first_to(motif_imports_[k].address, XREF_DATA); ok; ok = xref.next_to()) {
+                func_t* caller = get_func(xref.from);
+                if (!caller) continue;
+                const graph_index_t caller_index = data_.index_of(caller->start_ea);
+                if (caller_index != GRAPH_NO_NODE) edges.emplace_back(caller_index, import_node);
+            }
+        }
+
+        auto graph = std::make_shared<CallGraph>();
+        graph->build(function_count + motif_imports_.size(), edges);
+        return graph;
+    }
+
+    /// Name of a motif graph node (catalog function or import); the catalog may have grown since
+    const std::string& motif_node_name(graph_index_t node) const {
+        static const std::string unknown = "?";
+        if (node < motif_function_count_) return node < data_.nodes().size() ? data_.nodes()[node].name : unknown;
+        const std::size_t k = node - motif_function_count_;
+        return k < motif_imports_.size() ? motif_imports_[k].name : unknown;
+    }
+
+    ea_t motif_node_address(graph_index_t node) const {
+        if (node < motif_function_count_) return node < data_.nodes().size() ? data_.nodes()[node].address : BADADDR;
+        const std::size_t k = node - motif_function_count_;
+        return k < motif_imports_.size() ? motif_imports_[k].address : BADADDR;
+    }
+
+    /// Lowercase names and import/library flags of the motif graph's nodes (main thread)
+    std::shared_ptr<const MotifLabels> build_motif_labels() const {
+        auto labels = std::make_shared<MotifLabels>();
+        const auto& nodes = data_.nodes();
+        labels->names.resize(nodes.size() + motif_imports_.size());
+        labels->flags.assign(nodes.size() + motif_imports_.size(), 0);
+        for (std::size_t k = 0; k < motif_imports_.size(); ++k) {
+            std::string& name = labels->names[nodes.size() + k];
+            name = motif_imports_[k].name;
+            for (char& c : name) {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            labels->flags[nodes.size() + k] = MOTIF_IMPORT;
+        }
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            std::string& name = labels->names[i];
+            name = nodes[i].name;
+            for (char& c : name) {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+
+            func_t* func = get_func(nodes[i].address);
+            if (!func) continue;
+            segment_t* seg = getseg(func->start_ea);
+            if ((func->flags & FUNC_THUNK) != 0 || (seg && seg->type == SEG_XTRN)) {
+                labels->flags[i] |= MOTIF_IMPORT;
+            }
+            if ((func->flags & FUNC_LIB) != 0) {
+                labels->flags[i] |= MOTIF_LIBRARY;
+            }
+        }
+        return labels;
+    }
+
+    /// Take in matches streamed by the search thread
+    void pump_motif() {
+        if (!motif_query_) return;
+        const std::size_t before = motif_matches_.size();
+        if (!motif_search_.poll(motif_matches_)) return;
+        for (std::size_t i = before; i < motif_matches_.size(); ++i) {
+            std::uint8_t& mark = motif_marks_[motif_matches_[i]];
+            mark = std::max<std::uint8_t>(mark, 1);
+        }
+    }
+
+    void clear_motif() {
+        motif_search_.cancel();
+        motif_query_.reset();
+        motif_error_.clear();
+        motif_matches_.clear();
+        motif_marks_.clear();
+        motif_picked_ = -1;
+        motif_partial_ = false;
+    }
+
+    /// Emphasize one match and select its first function
+    void pick_motif_match(int row) {
+        const std::size_t stride = motif_query_->variable_count();
+        const auto mark = [&](int r, std::uint8_t value) {
+            if (r < 0) return;
+            for (std::size_t v = 0; v < stride; ++v) {
+                motif_marks_[motif_matches_[r * stride + v]] = value;
+            }
+        };
+        mark(motif_picked_, 1);
+        motif_picked_ = row;
+        mark(row, 2);
+
+        const ea_t address = motif_node_address(motif_matches_[row * stride]);
+        if (address != BADADDR && !graph_locked_) {
+            select_node_at_ea(address);
+            SelectionChannel::publish(address);
+            selection_version_ = SelectionChannel::version();
+        }
+    }
+
+    /// Motif mark of a graph node (0 if none)
+    std::uint8_t motif_mark(ea_t address) const {
+        if (motif_marks_.empty()) return 0;
+        const graph_index_t index = data_.index_of(address);
+        return index < motif_marks_.size() ? motif_marks_[index] : 0;
+    }
+
     void jump_to_node(int node_idx) {
         if (node_idx < 0 || node_idx >= static_cast<int>(nodes_.size())) return;
 
@@ -1809,6 +2455,15 @@ private:
         }
     }
 
+    /// Follow selections made in other views (e.g. Function Search)
+    void sync_selection() {
+        const std::uint64_t version = SelectionChannel::version();
+        if (version == selection_version_) return;
+        selection_version_ = version;
+        if (graph_locked_) return;
+        select_node_at_ea(SelectionChannel::current());
+    }
+
     void select_node_at_ea(ea_t ea) {
         if (ea == BADADDR) return;
 
@@ -1843,6 +2498,16 @@ private:
     }
 
     void render_graph_view() {
+        if (mode_treemap_) {
+            const ea_t clicked = treemap_view_.render(data_, selected_addr_, motif_marks_);
+            if (clicked != BADADDR && !graph_locked_) {
+                select_node_at_ea(clicked);
+                SelectionChannel::publish(clicked);
+                selection_version_ = SelectionChannel::version();
+            }
+            return;
+        }
+
         // Step physics simulation
         step_simulation();
 
@@ -1897,6 +2562,8 @@ private:
                 } else if (clicked_addr != selected_addr_) {
                     // Normal mode: select node and update graph
                     selected_addr_ = clicked_addr;
+                    SelectionChannel::publish(clicked_addr);
+                    selection_version_ = SelectionChannel::version();
                     if (only_show_neighbors_) {
                         // In focused mode: do targeted load around clicked node
                         load_neighbors_from_ea(clicked_addr);
@@ -1909,8 +2576,28 @@ private:
             }
         }
 
-        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        // Fill-bound while the camera moves: draw offscreen at a lower resolution
+        const ViewPose pose = current_pose();
+        const bool moving = pose != last_pose_;
+        last_pose_ = pose;
+        canvas_scale_ = adaptive_resolution_ ? canvas_resolution_.update(moving, io.DeltaTime) : 1.0f;
+
+        if (canvas_scale_ < 1.0f) {
+            ImDrawList* draw_list = imgui::begin_canvas_layer(canvas_pos, canvas_size, canvas_scale_);
+            draw_canvas(draw_list, canvas_pos, canvas_size);
+            imgui::end_canvas_layer();
+        } else {
+            draw_canvas(ImGui::GetWindowDrawList(), canvas_pos, canvas_size);
+        }
+    }
+
+    /// Everything that moves the picture without the graph changing
+    [[nodiscard]] ViewPose current_pose() const {
+        return {camera_.target, camera_.position, camera_.pan_2d, camera_.distance, camera_.yaw, camera_.pitch,
+                camera_.zoom_2d, dag_zoom_, dag_pan_.x, dag_pan_.y};
+    }
 
+    void draw_canvas(ImDrawList* draw_list, const ImVec2& canvas_pos, const ImVec2& canvas_size) {
         // Background - use SVG color #1e1f22 for DAG mode
         ImU32 bg_color = mode_dag_ ? IM_COL32(30, 31, 34, 255) : IM_COL32(15, 15, 20, 255);
         draw_list->AddRectFilled(canvas_pos,
@@ -2286,9 +2973,13 @@ private:
             // Draw filled rectangle
             draw_list->AddRectFilled(top_left, bottom_right, node_fill);
 
-            // Draw border (highlight if selected/hovered)
+            // Draw border (highlight if selected/hovered, then motif matches)
+            const std::uint8_t mark = motif_mark(rect.address);
             ImU32 stroke = is_selected ? selected_stroke : (is_hovered ? IM_COL32(150, 150, 150, 255) : node_stroke);
-            float stroke_width = (is_selected || is_hovered) ? 2.0f : 1.0f;
+            if (!is_selected && !is_hovered && mark != 0) {
+                stroke = mark == 2 ? MOTIF_PICKED_COLOR : MOTIF_MATCH_COLOR;
+            }
+            float stroke_width = (is_selected || is_hovered || mark != 0) ? 2.0f : 1.0f;
             draw_list->AddRect(top_left, bottom_right, stroke, 0.0f, 0, stroke_width);
 
             // Draw text centered in rectangle
@@ -2320,7 +3011,7 @@ private:
             int idx;
             float depth;
         };
-        std::vector<NodeRender> sorted;
+        FrameVector<NodeRender> sorted;
         sorted.reserve(nodes_.size());
 
         for (std::size_t i = 0; i < nodes_.size(); ++i) {
@@ -2381,7 +3072,7 @@ private:
                 // Hub node (many connections, not traversed) - orange/amber
                 color = IM_COL32(255, 165, 50, alpha);
                 size *= 1.2f;
-            } else if (graph_locked_ && !followed_nodes_.empty() && node.follow_distance >= 0) {
+            } else if (graph_locked_ && is_following() && node.follow_distance >= 0) {
                 // In lock mode with followed nodes: color by distance from followed
                 float max_dist = 10.0f;  // Assume reasonable max
                 float t = 1.0f - std::min(static_cast<float>(node.follow_distance) / max_dist, 1.0f);
@@ -2418,6 +3109,12 @@ private:
                 draw_list->AddCircleFilled(screen_pos, size, color);
             }
 
+            // Motif matches keep a ring even when faded by the selection
+            if (const std::uint8_t mark = motif_mark(node.address)) {
+                draw_list->AddCircle(screen_pos, size + 4, mark == 2 ? MOTIF_PICKED_COLOR : MOTIF_MATCH_COLOR, 0,
+                                     mark == 2 ? 3.0f : 2.0f);
+            }
+
             // Outline for selected/hovered/followed
             if (nr.idx == selected_node_idx_ || nr.idx == hovered_node_idx_) {
                 draw_list->AddCircle(screen_pos, size + 2, IM_COL32(255, 255, 255, alpha), 0, 2.0f);
@@ -2453,6 +3150,7 @@ private:
     }
 
     BinaryMapData data_;
+    std::uint64_t seen_generation_ = 0;  // Last data_ generation merged into the graph
 
     // Full graph (all nodes/edges from the binary)
     std::vector<GraphNode> all_nodes_;
@@ -2469,10 +3167,25 @@ private:
 
     Camera camera_;
 
+    // Adaptive canvas resolution
+    bool adaptive_resolution_ = true;
+    CanvasResolution canvas_resolution_;
+    ViewPose last_pose_;
+    float canvas_scale_ = 1.0f;
+
     // Simulation state
     bool simulation_running_ = false;
     int simulation_iterations_ = 0;
 
+    // Node sleeping: settled nodes drop out of integration until disturbed
+    static constexpr float SLEEP_SPEED = 0.02f;  // Below this a node counts as calm
+    static constexpr int SLEEP_STEPS = 20;       // Calm steps before sleeping
+    static constexpr float WAKE_SPEED = 0.05f;   // A node this fast disturbs sleepers...
+    static constexpr float WAKE_RADIUS = 3.0f;   // ...within this distance, or along an edge
+    std::vector<std::size_t> awake_;
+    std::vector<float> speed_;
+    std::vector<std::size_t> to_wake_;
+
     // Selection state
     int selected_node_idx_ = -1;   // Index into nodes_ (filtered graph)
     ea_t selected_addr_ = BADADDR; // Address of selected node (persistent across filters)
@@ -2487,6 +3200,27 @@ private:
     char search_buffer_[256] = {0};
     std::vector<int> search_results_;
 
+    // Motif search over the whole catalog and its imports; marks are per motif graph node
+    static constexpr std::size_t MAX_MOTIF_MATCHES = 10000;
+    char motif_buffer_[256] = {0};
+    std::string motif_error_;
+    std::shared_ptr<const MotifQuery> motif_query_;
+    MotifSearch motif_search_;
+    std::vector<graph_index_t> motif_matches_;  // variable_count() per match
+    std::vector<std::uint8_t> motif_marks_;     // 0 none, 1 matched, 2 in the picked match
+    int motif_picked_ = -1;
+    bool motif_partial_ = false;                // Searched before the scan completed
+    std::shared_ptr<const CallGraph> motif_graph_;  // data_.graph() at motif_generation_, plus imports
+    std::uint64_t motif_generation_ = 0;
+
+    /// Imported symbol, a motif graph node after the catalog's functions
+    struct MotifImport {
+        ea_t address;      // IAT slot
+        std::string name;
+    };
+    std::vector<MotifImport> motif_imports_;
+    std::size_t motif_function_count_ = 0;  // Catalog nodes before the imports
+
     // Settings
     int max_depth_ = 3;
     float base_node_size_ = 6.0f;
@@ -2498,6 +3232,8 @@ private:
     bool skip_hub_nodes_ = true;  // Don't traverse nodes with 20+ connections
     bool mode_2d_ = false;        // 2D force layout mode
     bool mode_dag_ = false;       // DAG flowchart layout mode
+    bool mode_treemap_ = false;   // Treemap of the whole catalog instead of the graph
+    TreemapView treemap_view_;
 
     // DAG layout data (pixel coordinates from GraphGridLayout)
     std::vector<DAGNodeRect> dag_node_rects_;
@@ -2516,13 +3252,14 @@ private:
 
     // Lock mode - prevents graph from updating, allows following nodes
     bool graph_locked_ = false;
-    std::unordered_set<ea_t> followed_nodes_;  // Nodes being followed (Alt+click to toggle)
-
-    // Base state for follow mode - captured when lock mode is enabled
-    // Used to rebuild graph when unfollowing nodes
-    std::vector<GraphNode> base_nodes_;
-    std::vector<CallEdge> base_edges_;
-    std::unordered_map<ea_t, std::size_t> base_addr_to_idx_;
+    std::uint64_t selection_version_ = SelectionChannel::version();  // Last shared selection applied
+
+    // Lock mode exploration: each follow or unfollow pushes a state that
+    // shares all unchanged structure with the previous one
+    ExplorationHistory exploration_;
+    std::unordered_map<ea_t, FunctionLinks> links_cache_;  // Read from xrefs once per lock
+    std::unordered_map<ea_t, NodeMotion> parked_motion_;   // Where removed nodes were
+    std::unordered_map<std::pair<ea_t, ea_t>, std::size_t, EdgeKeyHash> edge_slots_;  // Edge -> index in edges_
 };
 
 // =============================================================================
@@ -2542,10 +3279,10 @@ void cleanup_binary_map_3d_state() {
     g_state.reset();
 }
 
-void refresh_binary_map_3d_data() {
-    if (g_state) {
-        g_state->refresh_data();
-    }
+const BinaryMapData* refresh_binary_map_3d_data() {
+    if (!g_state) return nullptr;
+    g_state->refresh_data();
+    return &g_state->data();
 }
 
 void render_binary_map_3d() {
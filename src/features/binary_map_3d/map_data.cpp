@@ -2,10 +2,12 @@
 /// @brief 3D Binary map data implementation
 
 #include <synopsia/features/binary_map_3d/map_data.hpp>
+#include <synopsia/core/analysis_cache.hpp>
+#include <synopsia/core/analysis_snapshot.hpp>
+#include <synopsia/common/alloc_tracker.hpp>
 #include <funcs.hpp>
 #include <xref.hpp>
 #include <name.hpp>
-#include <queue>
 #include <cmath>
 #include <algorithm>
 
@@ -13,14 +15,38 @@ namespace synopsia {
 namespace features {
 namespace binary_map_3d {
 
+namespace {
+
+/// Minimum interval between partial CSR publishes during a progressive scan
+constexpr auto PUBLISH_INTERVAL = std::chrono::milliseconds(250);
+
+/// Each publish rebuilds the whole CSR; space them so they take at most
+/// 1/PUBLISH_COST_RATIO of the scan's wall time as the edge count grows
+constexpr int PUBLISH_COST_RATIO = 20;
+
+} // anonymous namespace
+
 bool BinaryMapData::refresh() {
+    if (!begin_refresh()) {
+        return false;
+    }
+    scan_step(std::chrono::milliseconds::max());
+    return valid_;
+}
+
+bool BinaryMapData::begin_refresh(ea_t focus) {
+    static AllocationSite site("binary_map", "refresh");
+    AllocationScope allocations(site);
+
     nodes_.clear();
     edges_.clear();
     addr_to_index_.clear();
-    callees_.clear();
-    callers_.clear();
+    graph_.clear();
+    scan_.reset();
     max_depth_ = 0;
     valid_ = false;
+    complete_ = false;
+    ++generation_;
 
     if (!is_database_loaded()) {
         return false;
@@ -32,6 +58,15 @@ bool BinaryMapData::refresh() {
         return false;
     }
 
+    // Precomputed results (headless precompute, snapshot file) skip the xref walk entirely
+    if (load_cache() || load_snapshot()) {
+        assign_colors();
+        valid_ = true;
+        complete_ = true;
+        allocations.set_items(nodes_.size());
+        return true;
+    }
+
     nodes_.reserve(count);
     addr_to_index_.reserve(count);
 
@@ -60,79 +95,335 @@ bool BinaryMapData::refresh() {
         nodes_.push_back(std::move(node));
     }
 
-    // Build call graph
-    build_call_graph();
+    // Layout depends only on addresses, so it is final before any edge is known
+    compute_hilbert_layout();
+    assign_colors();
+    valid_ = !nodes_.empty();
+
+    // Scan order: cursor neighborhood first, then by address distance from the cursor
+    scan_ = std::make_unique<ScanState>();
+    scan_->scanned.assign(nodes_.size(), 0);
+    scan_->remaining.resize(nodes_.size());
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        scan_->remaining[i] = static_cast<graph_index_t>(i);
+    }
+
+    func_t* focus_func = focus != BADADDR ? get_func(focus) : nullptr;
+    if (focus_func) {
+        const ea_t center = focus_func->start_ea;
+        auto distance = [center](ea_t addr) { return addr > center ? addr - center : center - addr; };
+        std::sort(scan_->remaining.begin(), scan_->remaining.end(), [&](graph_index_t a, graph_index_t b) {
+            return distance(nodes_[a].address) > distance(nodes_[b].address);
+        });
+        prioritize(center);
+    } else {
+        std::reverse(scan_->remaining.begin(), scan_->remaining.end());
+    }
 
-    // Compute depths
-    compute_call_depths();
+    scan_->last_publish = std::chrono::steady_clock::now();
+    scan_->publish_interval = PUBLISH_INTERVAL;
+    allocations.set_items(nodes_.size());
+    return valid_;
+}
 
-    // Compute Hilbert layout
-    compute_hilbert_layout();
+void BinaryMapData::prioritize(ea_t addr) {
+    if (!scan_) return;
+
+    func_t* func = get_func(addr);
+    if (!func) return;
+    const graph_index_t index = index_of(func->start_ea);
+    if (index == GRAPH_NO_NODE) return;
+
+    // Callers are only discoverable through xrefs to the function
+    xrefblk_t xref;
+    for (bool ok = xref.first_to(func->start_ea, XREF_FAR); ok; ok = xref.next_to()) {
+        if (xref.type != fl_CN && xref.type != fl_CF) continue;
+        func_t* caller = get_func(xref.from);
+        if (!caller) continue;
+        const graph_index_t caller_index = index_of(caller->start_ea);
+        if (caller_index != GRAPH_NO_NODE && !scan_->scanned[caller_index]) {
+            scan_->priority.push_front(caller_index);
+        }
+    }
+    if (!scan_->scanned[index]) {
+        scan_->priority.push_front(index);
+    }
+}
 
-    // Assign colors
-    assign_colors();
+bool BinaryMapData::scan_step(std::chrono::milliseconds budget) {
+    if (!scan_) return complete_;
+
+    static AllocationSite site("binary_map", "scan");
+    AllocationScope allocations(site);
+    const std::size_t scanned_before = scan_->scanned_count;
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = budget == std::chrono::milliseconds::max()
+        ? std::chrono::steady_clock::time_point::max()
+        : start + budget;
+
+    std::size_t batch = 0;
+    while (true) {
+        graph_index_t next = GRAPH_NO_NODE;
+        while (!scan_->priority.empty() && next == GRAPH_NO_NODE) {
+            const graph_index_t candidate = scan_->priority.front();
+            scan_->priority.pop_front();
+            if (!scan_->scanned[candidate]) next = candidate;
+        }
+        while (!scan_->remaining.empty() && next == GRAPH_NO_NODE) {
+            const graph_index_t candidate = scan_->remaining.back();
+            scan_->remaining.pop_back();
+            if (!scan_->scanned[candidate]) next = candidate;
+        }
+        if (next == GRAPH_NO_NODE) break;
 
-    valid_ = true;
+        scan_function(next);
+
+        // Clock reads are cheap but not free; check every few functions
+        if ((++batch & 15) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    allocations.set_items(scan_->scanned_count - scanned_before);
+    if (scan_->scanned_count == nodes_.size()) {
+        publish();
+        scan_.reset();
+        complete_ = true;
+        return true;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (scan_->edges.size() != scan_->published_edges && now - scan_->last_publish >= scan_->publish_interval) {
+        publish();
+        scan_->last_publish = std::chrono::steady_clock::now();
+        const auto cost = scan_->last_publish - now;
+        scan_->publish_interval = std::max<std::chrono::steady_clock::duration>(
+            PUBLISH_INTERVAL, cost * PUBLISH_COST_RATIO);
+    }
+    return false;
+}
+
+float BinaryMapData::scan_progress() const {
+    if (complete_ || nodes_.empty()) return 1.0f;
+    if (!scan_) return 0.0f;
+    return static_cast<float>(scan_->scanned_count) / static_cast<float>(nodes_.size());
+}
+
+bool BinaryMapData::load_cache() {
+    std::vector<CachedFunctionRecord> records;
+    std::vector<std::string> names;
+    std::vector<std::uint32_t> offsets;
+    std::vector<graph_index_t> targets;
+
+    if (!AnalysisCache::read(CacheSection::FunctionRecords, CacheScope::Functions, records) ||
+        !AnalysisCache::read_strings(CacheSection::FunctionNames, CacheScope::Names, names) ||
+        !AnalysisCache::read(CacheSection::CalleeOffsets, CacheScope::Functions, offsets) ||
+        !AnalysisCache::read(CacheSection::CalleeTargets, CacheScope::Functions, targets)) {
+        return false;
+    }
+    if (names.size() != records.size() || offsets.size() != records.size() + 1 ||
+        offsets.back() != targets.size()) {
+        return false;
+    }
+
+    nodes_.reserve(records.size());
+    addr_to_index_.reserve(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        const auto& r = records[i];
+        FunctionNode node;
+        node.address = static_cast<ea_t>(r.address);
+        node.end_address = static_cast<ea_t>(r.end_address);
+        node.name = std::move(names[i]);
+        node.x = r.x;
+        node.y = r.y;
+        node.z = r.z;
+        node.size = r.size;
+        node.call_depth = r.call_depth;
+        node.callee_count = r.callee_count;
+        node.caller_count = r.caller_count;
+        node.complexity = r.complexity;
+        max_depth_ = std::max(max_depth_, node.call_depth);
+
+        addr_to_index_[node.address] = nodes_.size();
+        nodes_.push_back(std::move(node));
+    }
+
+    adopt_callee_csr(offsets, targets);
     return true;
 }
 
-void BinaryMapData::build_call_graph() {
-    // For each function, find what it calls via code xrefs
-    for (auto& node : nodes_) {
-        func_t* func = get_func(node.address);
-        if (!func) continue;
+bool BinaryMapData::load_snapshot() {
+    auto snapshot = database_snapshot();
+    if (!snapshot || !snapshot_matches(*snapshot, CacheScope::Functions)) {
+        return false;
+    }
 
-        // Iterate through function and find call xrefs
-        ea_t addr = func->start_ea;
-        while (addr < func->end_ea && addr != BADADDR) {
-            // Check xrefs from this address
-            xrefblk_t xref;
-            for (bool ok = xref.first_from(addr, XREF_FAR); ok; ok = xref.next_from()) {
-                // Only interested in code xrefs (calls)
-                if (xref.type != fl_CN && xref.type != fl_CF) continue;
-
-                // Check if target is a function
-                func_t* target_func = get_func(xref.to);
-                if (target_func && target_func->start_ea != node.address) {
-                    ea_t target = target_func->start_ea;
-
-                    // Add to callees if not already present
-                    auto& callee_list = callees_[node.address];
-                    if (std::find(callee_list.begin(), callee_list.end(), target) == callee_list.end()) {
-                        callee_list.push_back(target);
-                        callers_[target].push_back(node.address);
-
-                        // Add edge
-                        edges_.push_back({node.address, target});
+    const auto address = snapshot->column<std::uint64_t>(SnapshotSection::FunctionAddress);
+    const auto end = snapshot->column<std::uint64_t>(SnapshotSection::FunctionEnd);
+    const auto size = snapshot->column<std::uint32_t>(SnapshotSection::FunctionSize);
+    const auto depth = snapshot->column<std::uint32_t>(SnapshotSection::FunctionDepth);
+    const auto callers = snapshot->column<std::uint32_t>(SnapshotSection::FunctionCallers);
+    const auto callees = snapshot->column<std::uint32_t>(SnapshotSection::FunctionCallees);
+    const auto complexity = snapshot->column<float>(SnapshotSection::FunctionComplexity);
+    const auto x = snapshot->column<float>(SnapshotSection::LayoutX);
+    const auto y = snapshot->column<float>(SnapshotSection::LayoutY);
+    const auto z = snapshot->column<float>(SnapshotSection::LayoutZ);
+    const auto names = snapshot->strings(SnapshotSection::NameOffsets, SnapshotSection::NameData);
+    const auto offsets = snapshot->column<std::uint32_t>(SnapshotSection::CalleeOffsets);
+    const auto targets = snapshot->column<std::uint32_t>(SnapshotSection::CalleeTargets);
+
+    const std::size_t count = address.size();
+    if (count == 0 || end.size() != count || size.size() != count || depth.size() != count ||
+        callers.size() != count || callees.size() != count || complexity.size() != count ||
+        x.size() != count || y.size() != count || z.size() != count || names.size() != count ||
+        offsets.size() != count + 1 || offsets.back() != targets.size()) {
+        return false;
+    }
+
+    nodes_.reserve(count);
+    addr_to_index_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        FunctionNode node;
+        node.address = static_cast<ea_t>(address[i]);
+        node.end_address = static_cast<ea_t>(end[i]);
+        node.name = names[i];
+        node.x = x[i];
+        node.y = y[i];
+        node.z = z[i];
+        node.size = size[i];
+        node.call_depth = depth[i];
+        node.callee_count = callees[i];
+        node.caller_count = callers[i];
+        node.complexity = complexity[i];
+        max_depth_ = std::max(max_depth_, node.call_depth);
+
+        addr_to_index_[node.address] = nodes_.size();
+        nodes_.push_back(std::move(node));
+    }
+
+    adopt_callee_csr(offsets, targets);
+    return true;
+}
+
+void BinaryMapData::adopt_callee_csr(std::span<const std::uint32_t> offsets,
+                                     std::span<const graph_index_t> targets) {
+    // Expand CSR back into edge lists
+    std::vector<std::pair<graph_index_t, graph_index_t>> index_edges;
+    index_edges.reserve(targets.size());
+    edges_.reserve(targets.size());
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+        for (std::uint32_t e = offsets[i]; e < offsets[i + 1] && e < targets.size(); ++e) {
+            if (targets[e] >= nodes_.size()) continue;
+            index_edges.emplace_back(static_cast<graph_index_t>(i), targets[e]);
+            edges_.push_back({nodes_[i].address, nodes_[targets[e]].address});
+        }
+    }
+    graph_.build(nodes_.size(), index_edges);
+}
+
+bool BinaryMapData::store_cache() const {
+    if (!valid_ || !complete_) return false;
+
+    std::vector<CachedFunctionRecord> records;
+    std::vector<std::string> names;
+    records.reserve(nodes_.size());
+    names.reserve(nodes_.size());
+    for (const auto& node : nodes_) {
+        CachedFunctionRecord r{};
+        r.address = node.address;
+        r.end_address = node.end_address;
+        r.size = node.size;
+        r.call_depth = node.call_depth;
+        r.callee_count = node.callee_count;
+        r.caller_count = node.caller_count;
+        r.x = node.x;
+        r.y = node.y;
+        r.z = node.z;
+        r.complexity = node.complexity;
+        records.push_back(r);
+        names.push_back(node.name);
+    }
+
+    const CsrAdjacency& callees = graph_.adjacency(GraphDirection::Callees);
+    return AnalysisCache::write(CacheSection::FunctionRecords, CacheScope::Functions, records) &&
+           AnalysisCache::write_strings(CacheSection::FunctionNames, CacheScope::Names, names) &&
+           AnalysisCache::write(CacheSection::CalleeOffsets, CacheScope::Functions, callees.offsets) &&
+           AnalysisCache::write(CacheSection::CalleeTargets, CacheScope::Functions, callees.targets);
+}
+
+void BinaryMapData::scan_function(graph_index_t index) {
+    scan_->scanned[index] = 1;
+    ++scan_->scanned_count;
+
+    const FunctionNode& node = nodes_[index];
+    func_t* func = get_func(node.address);
+    if (!func) return;
+
+    auto& seen = scan_->seen;
+    seen.clear();
+
+    // Iterate through function and find call xrefs
+    ea_t addr = func->start_ea;
+    while (addr < func->end_ea && addr != BADADDR) {
+        // Check xrefs from this address
+        xrefblk_t xref;
+        for (bool ok = xref.first_from(addr, XREF_FAR); ok; ok = xref.next_from()) {
+            // Only interested in code xrefs (calls)
+            if (xref.type != fl_CN && xref.type != fl_CF) continue;
+
+            // Check if target is a function
+            func_t* target_func = get_func(xref.to);
+            if (target_func && target_func->start_ea != node.address) {
+                const graph_index_t target = index_of(target_func->start_ea);
+                if (target == GRAPH_NO_NODE) continue;
+
+                // Add edge if not already present
+                if (std::find(seen.begin(), seen.end(), target) == seen.end()) {
+                    seen.push_back(target);
+                    scan_->edges.emplace_back(index, target);
+                    edges_.push_back({node.address, target_func->start_ea});
+
+                    // Grow the scanned region outward along the call graph
+                    if (!scan_->scanned[target]) {
+                        scan_->priority.push_back(target);
                     }
                 }
             }
-
-            // Move to next head
-            addr = next_head(addr, func->end_ea);
         }
 
-        // Update callee count
-        node.callee_count = static_cast<std::uint32_t>(callees_[node.address].size());
+        // Move to next head
+        addr = next_head(addr, func->end_ea);
     }
+}
 
-    // Update caller counts
-    for (auto& node : nodes_) {
-        auto it = callers_.find(node.address);
-        if (it != callers_.end()) {
-            node.caller_count = static_cast<std::uint32_t>(it->second.size());
-        }
+void BinaryMapData::publish() {
+    graph_.build(nodes_.size(), scan_->edges);
+    scan_->published_edges = scan_->edges.size();
+
+    // Update caller/callee counts from CSR degrees
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        const auto idx = static_cast<graph_index_t>(i);
+        nodes_[i].callee_count = static_cast<std::uint32_t>(graph_.callees(idx).size());
+        nodes_[i].caller_count = static_cast<std::uint32_t>(graph_.callers(idx).size());
     }
+
+    // Compute depths
+    compute_call_depths();
+
+    // Assign colors
+    assign_colors();
+
+    ++generation_;
 }
 
 void BinaryMapData::compute_call_depths() {
     // Find entry points (functions with no callers or marked as entry)
-    std::vector<ea_t> entry_points;
+    std::vector<graph_index_t> entry_points;
 
-    for (const auto& node : nodes_) {
-        auto it = callers_.find(node.address);
-        if (it == callers_.end() || it->second.empty()) {
-            entry_points.push_back(node.address);
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        if (graph_.callers(static_cast<graph_index_t>(i)).empty()) {
+            entry_points.push_back(static_cast<graph_index_t>(i));
         }
     }
 
@@ -142,47 +433,24 @@ void BinaryMapData::compute_call_depths() {
         if (start != BADADDR) {
             func_t* entry_func = get_func(start);
             if (entry_func) {
-                entry_points.push_back(entry_func->start_ea);
-            }
-        }
-    }
-
-    // BFS from entry points
-    std::unordered_map<ea_t, std::uint32_t> depths;
-    std::queue<ea_t> queue;
-
-    for (ea_t entry : entry_points) {
-        depths[entry] = 0;
-        queue.push(entry);
-    }
-
-    while (!queue.empty()) {
-        ea_t current = queue.front();
-        queue.pop();
-
-        std::uint32_t current_depth = depths[current];
-
-        // Process callees
-        auto it = callees_.find(current);
-        if (it != callees_.end()) {
-            for (ea_t callee : it->second) {
-                auto depth_it = depths.find(callee);
-                if (depth_it == depths.end()) {
-                    // Not visited yet
-                    depths[callee] = current_depth + 1;
-                    queue.push(callee);
+                const graph_index_t idx = index_of(entry_func->start_ea);
+                if (idx != GRAPH_NO_NODE) {
+                    entry_points.push_back(idx);
                 }
-                // Don't update if already visited (keeps shortest path)
             }
         }
     }
 
+    // BFS from entry points (shortest path depth)
+    std::vector<std::uint32_t> depths;
+    graph_.bfs(entry_points, GraphDirection::Callees, GRAPH_UNREACHED, depths);
+
     // Assign depths to nodes
     max_depth_ = 0;
-    for (auto& node : nodes_) {
-        auto it = depths.find(node.address);
-        if (it != depths.end()) {
-            node.call_depth = it->second;
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        auto& node = nodes_[i];
+        if (depths[i] != GRAPH_UNREACHED) {
+            node.call_depth = depths[i];
             max_depth_ = std::max(max_depth_, node.call_depth);
         } else {
             // Unreachable functions get depth based on caller count
@@ -190,11 +458,11 @@ void BinaryMapData::compute_call_depths() {
         }
     }
 
-    // Normalize depths for visualization
-    if (max_depth_ > 0) {
-        for (auto& node : nodes_) {
-            node.z = static_cast<float>(node.call_depth) / static_cast<float>(max_depth_);
-        }
+    // Normalize depths for visualization; every node is written so one that
+    // lost its depth in this publish does not keep the previous height
+    const float depth_scale = max_depth_ > 0 ? 1.0f / static_cast<float>(max_depth_) : 0.0f;
+    for (auto& node : nodes_) {
+        node.z = static_cast<float>(node.call_depth) * depth_scale;
     }
 }
 
@@ -282,6 +550,14 @@ const FunctionNode* BinaryMapData::find_node(ea_t addr) const {
     return nullptr;
 }
 
+graph_index_t BinaryMapData::index_of(ea_t addr) const {
+    auto it = addr_to_index_.find(addr);
+    if (it != addr_to_index_.end() && it->second < nodes_.size()) {
+        return static_cast<graph_index_t>(it->second);
+    }
+    return GRAPH_NO_NODE;
+}
+
 } // namespace binary_map_3d
 } // namespace features
 } // namespace synopsia
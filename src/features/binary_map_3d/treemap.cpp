@@ -0,0 +1,336 @@
+/// @file treemap.cpp
+/// @brief Squarified treemap implementation
+
+#include <synopsia/features/binary_map_3d/treemap.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace synopsia {
+namespace features {
+namespace binary_map_3d {
+
+void Treemap::clear() {
+    groups_.assign(1, Group{});
+    groups_[ROOT].rect = {0.0f, 0.0f, ROOT_ASPECT, 1.0f};
+    layouts_.assign(1, Layout{});
+    lookup_.assign(1, {});
+    item_group_.clear();
+    item_weight_.clear();
+    item_value_.clear();
+    item_slot_.clear();
+    values_dirty_ = false;
+    ++values_revision_;
+}
+
+Treemap::group_id Treemap::child(group_id parent, std::string_view label) {
+    std::string key(label);
+    auto it = lookup_[parent].find(key);
+    if (it != lookup_[parent].end()) return it->second;
+
+    const auto id = static_cast<group_id>(groups_.size());
+    Group& group = groups_.emplace_back();
+    group.label = label;
+    group.parent = parent;
+    group.depth = groups_[parent].depth + 1;
+    layouts_.emplace_back();
+    lookup_.emplace_back();
+
+    groups_[parent].groups.push_back(id);
+    lookup_[parent].emplace(std::move(key), id);
+
+    // A new child invalidates the parent's layout (only happens while building)
+    layouts_[parent] = Layout{};
+    return id;
+}
+
+void Treemap::add_item(group_id group, std::uint32_t item, std::uint64_t weight) {
+    weight = std::max<std::uint64_t>(weight, 1);
+    if (item >= item_group_.size()) {
+        item_group_.resize(item + 1, NO_GROUP);
+        item_weight_.resize(item + 1, 0);
+        item_value_.resize(item + 1, std::numeric_limits<float>::quiet_NaN());
+        item_slot_.resize(item + 1, 0);
+    }
+    item_group_[item] = group;
+    item_weight_[item] = weight;
+    groups_[group].items.push_back(item);
+    layouts_[group] = Layout{};
+
+    groups_[group].largest = std::max(groups_[group].largest, weight);
+    for (group_id id = group; id != NO_GROUP; id = groups_[id].parent) {
+        groups_[id].weight += weight;
+        ++groups_[id].item_count;
+        const group_id parent = groups_[id].parent;
+        if (parent != NO_GROUP) {
+            groups_[parent].largest = std::max(groups_[parent].largest, groups_[id].weight);
+        }
+    }
+    values_dirty_ = true;
+}
+
+void Treemap::set_value(std::uint32_t item, float value) {
+    if (item >= item_value_.size()) return;
+    const float old = item_value_[item];
+    if (old == value || (std::isnan(old) && std::isnan(value))) return;
+    item_value_[item] = value;
+    values_dirty_ = true;
+}
+
+std::uint64_t Treemap::ref_weight(std::uint32_t ref) const {
+    return (ref & GROUP_REF) ? groups_[ref & ~GROUP_REF].weight : item_weight_[ref];
+}
+
+float Treemap::ref_value(std::uint32_t ref) const {
+    return (ref & GROUP_REF) ? groups_[ref & ~GROUP_REF].value : item_value_[ref];
+}
+
+void Treemap::update_values() {
+    // Parents are always created before their children, so one reverse pass aggregates
+    std::vector<double> sums(groups_.size(), 0.0);
+    std::vector<double> known(groups_.size(), 0.0);
+    for (std::size_t item = 0; item < item_value_.size(); ++item) {
+        const float value = item_value_[item];
+        if (std::isnan(value) || item_group_[item] == NO_GROUP) continue;
+        const double weight = static_cast<double>(item_weight_[item]);
+        sums[item_group_[item]] += weight * value;
+        known[item_group_[item]] += weight;
+    }
+    for (std::size_t id = groups_.size(); id-- > 0;) {
+        groups_[id].value = known[id] > 0.0 ? static_cast<float>(sums[id] / known[id])
+                                            : std::numeric_limits<float>::quiet_NaN();
+        if (groups_[id].parent != NO_GROUP) {
+            sums[groups_[id].parent] += sums[id];
+            known[groups_[id].parent] += known[id];
+        }
+    }
+    values_dirty_ = false;
+    ++values_revision_;
+}
+
+void Treemap::update_strip_values(group_id id) {
+    Layout& layout = layouts_[id];
+    if (layout.values_revision == values_revision_) return;
+    layout.values_revision = values_revision_;
+
+    double sum = 0.0;
+    double known = 0.0;
+    std::size_t next = layout.refs.size();
+    for (std::size_t s = layout.strips.size(); s-- > 0;) {
+        Strip& strip = layout.strips[s];
+        for (; next > strip.first; --next) {
+            const std::uint32_t ref = layout.refs[next - 1];
+            const float value = ref_value(ref);
+            if (std::isnan(value)) continue;
+            const double weight = static_cast<double>(ref_weight(ref));
+            sum += weight * value;
+            known += weight;
+        }
+        strip.rest_value = known > 0.0 ? static_cast<float>(sum / known)
+                                        : std::numeric_limits<float>::quiet_NaN();
+    }
+}
+
+void Treemap::layout(group_id id) {
+    Layout& layout = layouts_[id];
+    if (layout.built) return;
+    layout.built = true;
+
+    // Largest first; weights travel with the refs so the sort stays cache friendly
+    const Group& group = groups_[id];
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> weighted;
+    weighted.reserve(group.groups.size() + group.items.size());
+    for (group_id child : group.groups) {
+        weighted.emplace_back(groups_[child].weight, child | GROUP_REF);
+    }
+    for (std::uint32_t item : group.items) {
+        weighted.emplace_back(item_weight_[item], item);
+    }
+    std::sort(weighted.begin(), weighted.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    layout.refs.resize(weighted.size());
+    for (std::size_t k = 0; k < weighted.size(); ++k) {
+        layout.refs[k] = weighted[k].second;
+    }
+
+    const std::size_t n = layout.refs.size();
+    layout.rects.assign(n, TreemapRect{});
+    layout.strips.clear();
+    layout.values_revision = 0;
+    if (n == 0 || group.weight == 0) return;
+
+    // Work in doubles; float edges drift over hundreds of thousands of cells
+    const double pad = id == ROOT ? 0.0
+                                  : GROUP_PADDING * std::min(group.rect.width(), group.rect.height());
+    double x0 = group.rect.x0 + pad;
+    double y0 = group.rect.y0 + pad;
+    const double x1 = group.rect.x1 - pad;
+    const double y1 = group.rect.y1 - pad;
+    const double scale = std::max(0.0, (x1 - x0) * (y1 - y0)) / static_cast<double>(group.weight);
+
+    std::size_t i = 0;
+    while (i < n) {
+        const double width = x1 - x0;
+        const double height = y1 - y0;
+        const bool vertical = width >= height;  // Strip runs along the shorter side
+        const double side = std::max(vertical ? height : width, 1e-30);
+        const double side2 = side * side;
+
+        // Grow the strip while its worst aspect ratio improves
+        const double largest = static_cast<double>(weighted[i].first) * scale;
+        double sum = 0.0;
+        double worst_prev = std::numeric_limits<double>::infinity();
+        std::size_t j = i;
+        while (j < n) {
+            const double area = static_cast<double>(weighted[j].first) * scale;
+            const double next = sum + area;
+            const double worst = std::max(side2 * largest / (next * next), next * next / (side2 * area));
+            if (j > i && worst > worst_prev) break;
+            sum = next;
+            worst_prev = worst;
+            ++j;
+        }
+
+        layout.strips.push_back({static_cast<std::uint32_t>(i),
+                                 {static_cast<float>(x0), static_cast<float>(y0),
+                                  static_cast<float>(x1), static_cast<float>(y1)},
+                                 0.0f, 0, 0});
+
+        // The last strip takes whatever is left so rounding never leaves a gap
+        const double thickness = j == n ? (vertical ? width : height) : sum / side;
+        double along = vertical ? y0 : x0;
+        for (std::size_t k = i; k < j; ++k) {
+            const double area = static_cast<double>(weighted[k].first) * scale;
+            const double end = k + 1 == j ? (vertical ? y1 : x1) : along + (sum > 0.0 ? area / sum * side : 0.0);
+            TreemapRect& rect = layout.rects[k];
+            if (vertical) {
+                rect = {static_cast<float>(x0), static_cast<float>(along),
+                        static_cast<float>(x0 + thickness), static_cast<float>(end)};
+            } else {
+                rect = {static_cast<float>(along), static_cast<float>(y0),
+                        static_cast<float>(end), static_cast<float>(y0 + thickness)};
+            }
+            along = end;
+        }
+        if (vertical) {
+            x0 += thickness;
+        } else {
+            y0 += thickness;
+        }
+        i = j;
+    }
+
+    // What each strip's remainder holds, for the quad that stands in for it
+    std::uint32_t items = 0;
+    std::uint64_t weight = 0;
+    std::size_t next = n;
+    for (std::size_t s = layout.strips.size(); s-- > 0;) {
+        Strip& strip = layout.strips[s];
+        for (; next > strip.first; --next) {
+            const std::uint32_t ref = layout.refs[next - 1];
+            items += (ref & GROUP_REF) ? static_cast<std::uint32_t>(groups_[ref & ~GROUP_REF].item_count) : 1;
+            weight += weighted[next - 1].first;
+        }
+        strip.rest_items = items;
+        strip.rest_weight = weight;
+    }
+
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::uint32_t ref = layout.refs[k];
+        if (ref & GROUP_REF) {
+            const group_id child_id = ref & ~GROUP_REF;
+            groups_[child_id].rect = layout.rects[k];
+            layouts_[child_id] = Layout{};  // Its own children move with it
+        } else {
+            item_slot_[ref] = static_cast<std::uint32_t>(k);
+        }
+    }
+}
+
+void Treemap::collect(const TreemapRect& viewport, float pixels_per_unit, float min_pixels,
+                      std::vector<TreemapQuad>& out) {
+    if (values_dirty_) {
+        update_values();
+    }
+
+    const float min_side = min_pixels / pixels_per_unit;
+    const float min_area = min_side * min_side;
+    const float open_side = MIN_OPEN_PIXELS / pixels_per_unit;
+
+    std::vector<group_id> stack{ROOT};
+    while (!stack.empty()) {
+        const group_id id = stack.back();
+        stack.pop_back();
+
+        const Group& group = groups_[id];
+        if (!group.rect.intersects(viewport) || group.weight == 0) continue;
+
+        const float area = group.rect.width() * group.rect.height();
+        const bool open = id == ROOT ||
+                          (std::min(group.rect.width(), group.rect.height()) >= open_side &&
+                           area * static_cast<float>(group.largest) / static_cast<float>(group.weight) >= min_area);
+        out.push_back({group.rect, group.value, id, static_cast<std::uint16_t>(group.depth),
+                       open ? TreemapQuad::Kind::Frame : TreemapQuad::Kind::Group});
+        if (!open) continue;
+
+        layout(id);
+        update_strip_values(id);
+        const Layout& layout = layouts_[id];
+        const auto child_depth = static_cast<std::uint16_t>(group.depth + 1);
+
+        for (std::size_t s = 0; s < layout.strips.size(); ++s) {
+            const Strip& strip = layout.strips[s];
+            // Later strips all lie inside this one's remaining area
+            if (!strip.rest.intersects(viewport)) break;
+
+            const TreemapRect& largest = layout.rects[strip.first];
+            if (largest.width() * largest.height() < min_area) {
+                out.push_back({strip.rest, strip.rest_value, id, child_depth, TreemapQuad::Kind::Rest,
+                               strip.rest_items, strip.rest_weight});
+                break;
+            }
+
+            // The strip itself is its remaining area minus the next strip's
+            std::size_t end = layout.refs.size();
+            TreemapRect band = strip.rest;
+            if (s + 1 < layout.strips.size()) {
+                const Strip& next = layout.strips[s + 1];
+                end = next.first;
+                if (next.rest.x0 > strip.rest.x0) {
+                    band.x1 = next.rest.x0;
+                } else {
+                    band.y1 = next.rest.y0;
+                }
+            }
+            if (!band.intersects(viewport)) continue;
+
+            for (std::size_t k = strip.first; k < end; ++k) {
+                if (!layout.rects[k].intersects(viewport)) continue;
+                const std::uint32_t ref = layout.refs[k];
+                if (ref & GROUP_REF) {
+                    stack.push_back(ref & ~GROUP_REF);
+                } else {
+                    out.push_back({layout.rects[k], item_value_[ref], ref, child_depth, TreemapQuad::Kind::Item});
+                }
+            }
+        }
+    }
+}
+
+TreemapRect Treemap::reveal(std::uint32_t item) {
+    if (item >= item_group_.size() || item_group_[item] == NO_GROUP) return {};
+
+    std::vector<group_id> path;
+    for (group_id id = item_group_[item]; id != NO_GROUP; id = groups_[id].parent) {
+        path.push_back(id);
+    }
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        layout(*it);
+    }
+    return layouts_[item_group_[item]].rects[item_slot_[item]];
+}
+
+} // namespace binary_map_3d
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,424 @@
+/// @file treemap_view.cpp
+/// @brief Function treemap tab of the 3D binary map
+
+#include <synopsia/features/binary_map_3d/treemap_view.hpp>
+#include <synopsia/features/function_search/name_tree.hpp>
+#include <synopsia/core/analysis_cache.hpp>
+#include <synopsia/entropy.hpp>
+#include <bytes.hpp>
+#include <funcs.hpp>
+#include <gdl.hpp>
+#include <kernwin.hpp>
+#include <name.hpp>
+#include <segment.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace synopsia {
+namespace features {
+namespace binary_map_3d {
+
+void TreemapView::reset() {
+    treemap_.clear();
+    build_cursor_ = 0;
+    built_ = false;
+    segment_start_ = segment_end_ = BADADDR;
+    for (auto& values : values_) {
+        values.clear();
+    }
+    measure_cursor_ = 0;
+    entropy_cached_ = false;
+    centrality_generation_ = NO_GENERATION;
+    center_ = ImVec2(Treemap::ROOT_ASPECT * 0.5f, 0.5f);
+    zoom_ = 1.0f;
+}
+
+void TreemapView::render_controls() {
+    ImGui::SetNextItemWidth(-1);
+    int metric = static_cast<int>(metric_);
+    if (ImGui::Combo("##treemap-metric", &metric, TREEMAP_METRIC_NAMES, TREEMAP_METRIC_COUNT)) {
+        metric_ = static_cast<TreemapMetric>(metric);
+        if (built_) {
+            apply_metric();
+        }
+    }
+    if (built_) {
+        ImGui::TextDisabled("%zu functions, %zu groups", treemap_.item_count(), treemap_.group_count() - 1);
+    }
+}
+
+ea_t TreemapView::render(const BinaryMapData& data, ea_t selected, const std::vector<std::uint8_t>& marks) {
+    ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+    ImVec2 canvas_size = ImGui::GetContentRegionAvail();
+    if (canvas_size.x < 50 || canvas_size.y < 50) return BADADDR;
+
+    ImGui::InvisibleButton("##treemap-canvas", canvas_size,
+                           ImGuiButtonFlags_MouseButtonLeft |
+                           ImGuiButtonFlags_MouseButtonRight);
+    const bool is_hovered = ImGui::IsItemHovered();
+    const bool is_active = ImGui::IsItemActive();
+    const bool was_pressed = ImGui::IsItemActivated();
+    const bool was_released = ImGui::IsItemDeactivated();
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    const ImVec2 canvas_max(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y);
+    draw_list->AddRectFilled(canvas_pos, canvas_max, IM_COL32(30, 31, 34, 255));
+
+    if (!data.is_valid()) {
+        draw_list->AddText(ImVec2(canvas_pos.x + canvas_size.x * 0.5f - 30, canvas_pos.y + canvas_size.y * 0.5f),
+                           IM_COL32(128, 128, 128, 255), "No data");
+        return BADADDR;
+    }
+    if (!built_ && !pump_build(data)) {
+        char progress[64];
+        qsnprintf(progress, sizeof(progress), "Building treemap... %zu%%",
+                  build_cursor_ * 100 / std::max<std::size_t>(1, data.nodes().size()));
+        draw_list->AddText(ImVec2(canvas_pos.x + canvas_size.x * 0.5f - 70, canvas_pos.y + canvas_size.y * 0.5f),
+                           IM_COL32(128, 128, 128, 255), progress);
+        return BADADDR;
+    }
+    update_metric(data);
+
+    // World -> screen: the root fills the canvas at zoom 1
+    ImGuiIO& io = ImGui::GetIO();
+    const float fit = std::min(canvas_size.x / Treemap::ROOT_ASPECT, canvas_size.y);
+    const ImVec2 canvas_center(canvas_pos.x + canvas_size.x * 0.5f, canvas_pos.y + canvas_size.y * 0.5f);
+
+    if (is_active && ImGui::IsMouseDragging(ImGuiMouseButton_Left)) {
+        center_.x -= io.MouseDelta.x / (fit * zoom_);
+        center_.y -= io.MouseDelta.y / (fit * zoom_);
+    }
+    if (is_hovered && std::abs(io.MouseWheel) > 0.01f) {
+        // Zoom towards the mouse, keeping the point under it stationary
+        const float before = fit * zoom_;
+        const float wx = center_.x + (io.MousePos.x - canvas_center.x) / before;
+        const float wy = center_.y + (io.MousePos.y - canvas_center.y) / before;
+        zoom_ = std::clamp(zoom_ * std::pow(1.2f, io.MouseWheel), 0.5f, MAX_ZOOM);
+        const float after = fit * zoom_;
+        center_.x = wx - (io.MousePos.x - canvas_center.x) / after;
+        center_.y = wy - (io.MousePos.y - canvas_center.y) / after;
+    }
+    const float ppu = fit * zoom_;
+
+    const TreemapRect viewport{center_.x - canvas_size.x * 0.5f / ppu, center_.y - canvas_size.y * 0.5f / ppu,
+                               center_.x + canvas_size.x * 0.5f / ppu, center_.y + canvas_size.y * 0.5f / ppu};
+    quads_.clear();
+    treemap_.collect(viewport, ppu, MIN_CELL_PIXELS, quads_);
+
+    const auto to_screen = [&](float x, float y) {
+        return ImVec2(canvas_center.x + (x - center_.x) * ppu, canvas_center.y + (y - center_.y) * ppu);
+    };
+
+    draw_list->PushClipRect(canvas_pos, canvas_max, true);
+    draw_quads(draw_list, to_screen);
+    draw_labels(draw_list, data, to_screen, canvas_pos, canvas_max);
+    draw_marks(draw_list, marks, to_screen);
+
+    // Outline the selection, at least a few pixels wide so it stays findable
+    const graph_index_t selected_index = selected != BADADDR ? data.index_of(selected) : GRAPH_NO_NODE;
+    if (selected_index != GRAPH_NO_NODE && selected_index < treemap_.item_count()) {
+        const TreemapRect rect = treemap_.reveal(selected_index);
+        ImVec2 a = to_screen(rect.x0, rect.y0);
+        ImVec2 b = to_screen(rect.x1, rect.y1);
+        const float grow = std::max(0.0f, 4.0f - std::min(b.x - a.x, b.y - a.y)) * 0.5f;
+        draw_list->AddRect(ImVec2(a.x - grow, a.y - grow), ImVec2(b.x + grow, b.y + grow),
+                           IM_COL32(255, 220, 80, 255), 0.0f, 0, 2.0f);
+    }
+    draw_list->PopClipRect();
+
+    // Topmost drawn quad under the mouse; quads are in painting order
+    const TreemapQuad* hovered = nullptr;
+    if (is_hovered) {
+        const float wx = center_.x + (io.MousePos.x - canvas_center.x) / ppu;
+        const float wy = center_.y + (io.MousePos.y - canvas_center.y) / ppu;
+        for (auto it = quads_.rbegin(); it != quads_.rend(); ++it) {
+            if (it->rect.contains(wx, wy)) {
+                hovered = &*it;
+                break;
+            }
+        }
+    }
+    if (hovered) {
+        render_tooltip(data, *hovered);
+    }
+
+    if (was_pressed) {
+        press_pos_ = io.MousePos;
+    }
+    ea_t clicked = BADADDR;
+    if (hovered && hovered->kind == TreemapQuad::Kind::Item) {
+        const ea_t address = data.nodes()[hovered->ref].address;
+        const float dx = io.MousePos.x - press_pos_.x;
+        const float dy = io.MousePos.y - press_pos_.y;
+        if (was_released && dx * dx + dy * dy < 25.0f) {
+            clicked = address;
+        }
+        if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
+            jumpto(address);
+        }
+    }
+    return clicked;
+}
+
+bool TreemapView::pump_build(const BinaryMapData& data) {
+    const auto& nodes = data.nodes();
+    const auto deadline = std::chrono::steady_clock::now() + BUILD_BUDGET;
+
+    qstring demangled;
+    while (build_cursor_ < nodes.size()) {
+        const FunctionNode& node = nodes[build_cursor_];
+
+        // Functions come in address order, so segments change rarely
+        if (segment_start_ == BADADDR || node.address < segment_start_ || node.address >= segment_end_) {
+            qstring segment_name;
+            segment_t* seg = getseg(node.address);
+            if (seg) {
+                segment_start_ = seg->start_ea;
+                segment_end_ = seg->end_ea;
+                if (get_segm_name(&segment_name, seg) <= 0) {
+                    segment_name = "(unnamed)";
+                }
+            } else {
+                segment_start_ = node.address;
+                segment_end_ = node.address + 1;
+                segment_name = "(no segment)";
+            }
+            segment_group_ = treemap_.child(Treemap::ROOT, segment_name.c_str());
+        }
+
+        std::string_view name = node.name;
+        if (demangle_name(&demangled, node.name.c_str(), 0) > 0) {
+            name = demangled.c_str();
+        }
+        const auto path = function_search::split_qualified_name(name);
+        Treemap::group_id group = segment_group_;
+        for (std::size_t k = 0; k + 1 < path.size(); ++k) {
+            group = treemap_.child(group, path[k]);
+        }
+        treemap_.add_item(group, static_cast<std::uint32_t>(build_cursor_), node.size);
+
+        ++build_cursor_;
+        if ((build_cursor_ & 63) == 0 && std::chrono::steady_clock::now() >= deadline) break;
+    }
+
+    built_ = build_cursor_ >= nodes.size();
+    if (built_) {
+        apply_metric();
+    }
+    return built_;
+}
+
+void TreemapView::apply_metric() {
+    auto& values = values_[static_cast<int>(metric_)];
+    values.resize(treemap_.item_count(), std::numeric_limits<float>::quiet_NaN());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        treemap_.set_value(static_cast<std::uint32_t>(i), values[i]);
+    }
+    measure_cursor_ = 0;
+    last_flush_ = ImGui::GetTime();
+}
+
+void TreemapView::update_metric(const BinaryMapData& data) {
+    auto& values = values_[static_cast<int>(metric_)];
+    const auto& nodes = data.nodes();
+
+    if (metric_ == TreemapMetric::Centrality) {
+        // Degree centrality; recomputed whenever the scan publishes edges
+        if (centrality_generation_ == data.generation()) return;
+        centrality_generation_ = data.generation();
+        std::uint32_t max_degree = 1;
+        for (const auto& node : nodes) {
+            max_degree = std::max(max_degree, node.caller_count + node.callee_count);
+        }
+        const double scale = 1.0 / std::log1p(static_cast<double>(max_degree));
+        for (std::size_t i = 0; i < values.size() && i < nodes.size(); ++i) {
+            values[i] = static_cast<float>(std::log1p(static_cast<double>(nodes[i].caller_count + nodes[i].callee_count)) * scale);
+            treemap_.set_value(static_cast<std::uint32_t>(i), values[i]);
+        }
+        return;
+    }
+
+    if (metric_ == TreemapMetric::Entropy && !entropy_cached_) {
+        entropy_cached_ = true;
+        load_cached_entropy(data, values);
+    }
+
+    // Visible unknown functions first, then a background sweep over the rest
+    const auto deadline = std::chrono::steady_clock::now() + MEASURE_BUDGET;
+    std::size_t measured = 0;
+    const auto measure = [&](std::size_t i) {
+        if (!std::isnan(values[i])) return;
+        values[i] = metric_ == TreemapMetric::Entropy ? measure_entropy(nodes[i]) : measure_complexity(nodes[i]);
+        ++measured;
+    };
+    for (const auto& quad : quads_) {
+        if (quad.kind != TreemapQuad::Kind::Item) continue;
+        measure(quad.ref);
+        if ((measured & 15) == 15 && std::chrono::steady_clock::now() >= deadline) break;
+    }
+    while (measure_cursor_ < values.size() && std::chrono::steady_clock::now() < deadline) {
+        for (std::size_t end = std::min(measure_cursor_ + 16, values.size()); measure_cursor_ < end; ++measure_cursor_) {
+            measure(measure_cursor_);
+        }
+    }
+
+    const double now = ImGui::GetTime();
+    if (now - last_flush_ >= FLUSH_INTERVAL) {
+        last_flush_ = now;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            treemap_.set_value(static_cast<std::uint32_t>(i), values[i]);
+        }
+    }
+}
+
+void TreemapView::load_cached_entropy(const BinaryMapData& data, std::vector<float>& values) {
+    std::vector<EntropyBlock> blocks;
+    if (!AnalysisCache::read(CacheSection::EntropyLevel0, CacheScope::Bytes, blocks) || blocks.empty()) return;
+
+    const auto& nodes = data.nodes();
+    for (std::size_t i = 0; i < values.size() && i < nodes.size(); ++i) {
+        const ea_t start = nodes[i].address;
+        const ea_t end = nodes[i].end_address;
+        auto it = std::upper_bound(blocks.begin(), blocks.end(), start,
+                                   [](ea_t ea, const EntropyBlock& block) { return ea < block.start_ea; });
+        if (it != blocks.begin()) --it;
+
+        double sum = 0.0;
+        double covered = 0.0;
+        for (; it != blocks.end() && it->start_ea < end; ++it) {
+            const ea_t lo = std::max(start, it->start_ea);
+            const ea_t hi = std::min(end, it->end_ea);
+            if (hi <= lo) continue;
+            sum += it->entropy * static_cast<double>(hi - lo);
+            covered += static_cast<double>(hi - lo);
+        }
+        if (covered > 0.0) {
+            values[i] = static_cast<float>(sum / covered / MAX_ENTROPY_VALUE);
+        }
+    }
+}
+
+float TreemapView::measure_entropy(const FunctionNode& node) {
+    const std::size_t size = std::min<std::size_t>(node.end_address - node.address, MAX_ENTROPY_BYTES);
+    bytes_.resize(size);
+    const ssize_t loaded = size > 0 ? get_bytes(bytes_.data(), static_cast<ssize_t>(size), node.address) : 0;
+    if (loaded <= 0) return 0.0f;
+    return static_cast<float>(EntropyCalculator::calculate(bytes_.data(), static_cast<std::size_t>(loaded)) /
+                              MAX_ENTROPY_VALUE);
+}
+
+float TreemapView::measure_complexity(const FunctionNode& node) {
+    double complexity = node.complexity;
+    if (complexity <= 0.0) {
+        // Cyclomatic complexity: edges - blocks + 2
+        func_t* func = get_func(node.address);
+        qflow_chart_t chart;
+        if (!func || !chart.create("", func, BADADDR, BADADDR, FC_NOEXT)) return 0.0f;
+        int edges = 0;
+        for (int block = 0; block < chart.size(); ++block) {
+            edges += chart.nsucc(block);
+        }
+        complexity = std::max(1, edges - chart.size() + 2);
+    }
+    return static_cast<float>(std::min(1.0, std::log1p(complexity) / std::log1p(MAX_COMPLEXITY)));
+}
+
+ImU32 TreemapView::quad_color(const TreemapQuad& quad) const {
+    const Color color = std::isnan(quad.value) ? Color(90, 90, 96) : gradient_.sample(quad.value);
+    float shade = 1.0f;
+    switch (quad.kind) {
+        case TreemapQuad::Kind::Frame: shade = 0.3f; break;   // Backdrop behind children
+        case TreemapQuad::Kind::Group: shade = 0.8f; break;
+        case TreemapQuad::Kind::Rest:  shade = 0.65f; break;
+        case TreemapQuad::Kind::Item:  break;
+    }
+    return IM_COL32(static_cast<int>(color.r * shade), static_cast<int>(color.g * shade),
+                    static_cast<int>(color.b * shade), 255);
+}
+
+template <typename ToScreen>
+void TreemapView::draw_quads(ImDrawList* draw_list, const ToScreen& to_screen) const {
+    for (std::size_t start = 0; start < quads_.size(); start += QUADS_PER_BATCH) {
+        const std::size_t count = std::min(QUADS_PER_BATCH, quads_.size() - start);
+        draw_list->PrimReserve(static_cast<int>(count * 6), static_cast<int>(count * 4));
+        for (std::size_t k = start; k < start + count; ++k) {
+            const TreemapQuad& quad = quads_[k];
+            ImVec2 a = to_screen(quad.rect.x0, quad.rect.y0);
+            ImVec2 b = to_screen(quad.rect.x1, quad.rect.y1);
+            // Leave a hairline gap between cells large enough to afford one
+            if (quad.kind != TreemapQuad::Kind::Frame && b.x - a.x > 4.0f && b.y - a.y > 4.0f) {
+                a.x += 0.5f;
+                a.y += 0.5f;
+                b.x -= 0.5f;
+                b.y -= 0.5f;
+            }
+            draw_list->PrimRect(a, b, quad_color(quad));
+        }
+    }
+}
+
+template <typename ToScreen>
+void TreemapView::draw_marks(ImDrawList* draw_list, const std::vector<std::uint8_t>& marks, const ToScreen& to_screen) const {
+    if (marks.empty()) return;
+    for (const TreemapQuad& quad : quads_) {
+        if (quad.kind != TreemapQuad::Kind::Item || quad.ref >= marks.size() || marks[quad.ref] == 0) continue;
+        const ImVec2 a = to_screen(quad.rect.x0, quad.rect.y0);
+        const ImVec2 b = to_screen(quad.rect.x1, quad.rect.y1);
+        const bool picked = marks[quad.ref] == 2;
+        draw_list->AddRect(a, b, picked ? MOTIF_PICKED_COLOR : MOTIF_MATCH_COLOR, 0.0f, 0, picked ? 2.5f : 1.5f);
+    }
+}
+
+template <typename ToScreen>
+void TreemapView::draw_labels(ImDrawList* draw_list, const BinaryMapData& data, const ToScreen& to_screen,
+                              const ImVec2& canvas_min, const ImVec2& canvas_max) const {
+    const float line = ImGui::GetTextLineHeight();
+    int labels = 0;
+    for (const TreemapQuad& quad : quads_) {
+        if (quad.kind == TreemapQuad::Kind::Rest) continue;
+        const ImVec2 a = to_screen(quad.rect.x0, quad.rect.y0);
+        const ImVec2 b = to_screen(quad.rect.x1, quad.rect.y1);
+        if (b.x - a.x < 60.0f || b.y - a.y < line + 4.0f) continue;
+
+        const char* text = quad.kind == TreemapQuad::Kind::Item ? data.nodes()[quad.ref].name.c_str()
+                                                                : treemap_.group(quad.ref).label.c_str();
+        if (text[0] == '\0') continue;
+        const ImVec4 clip(std::max(a.x, canvas_min.x), std::max(a.y, canvas_min.y),
+                          std::min(b.x, canvas_max.x), std::min(b.y, canvas_max.y));
+        const ImVec2 pos(std::max(a.x, canvas_min.x) + 3.0f, std::max(a.y, canvas_min.y) + 1.0f);
+        draw_list->AddText(nullptr, 0.0f, ImVec2(pos.x + 1.0f, pos.y + 1.0f), IM_COL32(0, 0, 0, 200), text, nullptr, 0.0f, &clip);
+        draw_list->AddText(nullptr, 0.0f, pos, IM_COL32(235, 235, 235, 255), text, nullptr, 0.0f, &clip);
+        if (++labels >= MAX_LABELS) break;
+    }
+}
+
+void TreemapView::render_tooltip(const BinaryMapData& data, const TreemapQuad& quad) const {
+    ImGui::BeginTooltip();
+    if (quad.kind == TreemapQuad::Kind::Item) {
+        const FunctionNode& node = data.nodes()[quad.ref];
+        ImGui::TextUnformatted(node.name.c_str());
+        ImGui::Text("%llX  %u bytes", static_cast<unsigned long long>(node.address), node.size);
+    } else {
+        const Treemap::Group& group = treemap_.group(quad.ref);
+        ImGui::TextUnformatted(group.label.empty() ? "(all)" : group.label.c_str());
+        if (quad.kind == TreemapQuad::Kind::Rest) {
+            // Only the merged tail, not the whole group
+            ImGui::Text("%u functions  %llu bytes  (small ones merged)", quad.rest_items,
+                        static_cast<unsigned long long>(quad.rest_weight));
+        } else {
+            ImGui::Text("%zu functions  %llu bytes", group.item_count, static_cast<unsigned long long>(group.weight));
+        }
+    }
+    if (std::isnan(quad.value)) {
+        ImGui::TextDisabled("%s: not measured yet", TREEMAP_METRIC_NAMES[static_cast<int>(metric_)]);
+    } else {
+        ImGui::Text("%s: %.2f", TREEMAP_METRIC_NAMES[static_cast<int>(metric_)], quad.value);
+    }
+    ImGui::EndTooltip();
+}
+
+} // namespace binary_map_3d
+} // namespace features
+} // namespace synopsia
@@ -2,6 +2,7 @@
 /// @brief Entropy minimap feature implementation
 
 #include <synopsia/features/entropy_minimap/feature.hpp>
+#include <synopsia/core/session_recorder.hpp>
 
 #ifdef SYNOPSIA_USE_QT
 // Forward declarations for bridge functions
@@ -171,6 +172,8 @@ void EntropyMinimapFeature::refresh_data() {
     if (data_->refresh(config_.block_size)) {
         msg("Synopsia [%s]: Analysis complete (%zu blocks, avg entropy: %.2f)\n",
             entropy_minimap::FEATURE_NAME, data_->block_count(), data_->avg_entropy());
+        SessionRecorder::record_response(TraceSource::EntropyBlocks, config_.block_size,
+                                         static_cast<std::int64_t>(data_->block_count()));
 
 #ifdef SYNOPSIA_USE_QT
         if (content_) {
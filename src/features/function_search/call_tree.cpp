@@ -0,0 +1,190 @@
+/// @file call_tree.cpp
+/// @brief Lazily expanded callers/callees tree implementation
+
+#include <synopsia/features/function_search/call_tree.hpp>
+
+#include <algorithm>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+namespace {
+
+/// Section order on screen
+constexpr GraphDirection SECTION_DIRECTIONS[] = {GraphDirection::Callers, GraphDirection::Callees};
+
+} // anonymous namespace
+
+void CallTree::set_root(std::shared_ptr<const CallGraph> graph, graph_index_t root) {
+    if (graph == graph_ && root == root_) return;
+
+    graph_ = std::move(graph);
+    root_ = root;
+    nodes_.clear();
+    free_.clear();
+    sections_[0] = sections_[1] = NO_NODE;
+    if (empty()) return;
+
+    for (int s = 0; s < 2; ++s) {
+        Node& section = nodes_.emplace_back();
+        section.function = root_;
+        section.direction = SECTION_DIRECTIONS[s];
+        section.children = graph_->adjacency(section.direction).neighbors(root_);
+        section.visible = section.children.size();
+        sections_[s] = static_cast<node_id>(nodes_.size() - 1);
+        section_open_[s] = true;
+    }
+}
+
+std::size_t CallTree::row_count() const noexcept {
+    if (empty()) return 0;
+    std::size_t count = 0;
+    for (int s = 0; s < 2; ++s) {
+        count += 1 + (section_open_[s] ? nodes_[sections_[s]].visible : 0);
+    }
+    return count;
+}
+
+CallTree::Row CallTree::row(std::size_t index) const {
+    if (empty()) return {};
+
+    for (int s = 0; s < 2; ++s) {
+        const Node& section = nodes_[sections_[s]];
+        if (index == 0) {
+            Row header;
+            header.function = root_;
+            header.direction = section.direction;
+            header.node = section_open_[s] ? sections_[s] : NO_NODE;
+            header.fan_out = section.children.size();
+            header.header = true;
+            return header;
+        }
+        --index;
+        if (!section_open_[s]) continue;
+        if (index < section.visible) {
+            return locate(sections_[s], index);
+        }
+        index -= section.visible;
+    }
+    return {};
+}
+
+CallTree::Row CallTree::locate(node_id id, std::size_t index) const {
+    for (;;) {
+        // Unexpanded neighbors take one row each; expanded ones add their subtree
+        std::size_t extra = 0;
+        node_id next = NO_NODE;
+        for (const auto& [slot, child] : nodes_[id].expanded) {
+            const std::size_t child_row = slot + extra;
+            if (index < child_row) break;
+            if (index == child_row) return make_row(id, slot, child);
+
+            const std::size_t below = nodes_[child].visible;
+            if (index <= child_row + below) {
+                index -= child_row + 1;
+                next = child;
+                break;
+            }
+            extra += below;
+        }
+        if (next == NO_NODE) {
+            return make_row(id, static_cast<std::uint32_t>(index - extra), NO_NODE);
+        }
+        id = next;
+    }
+}
+
+CallTree::Row CallTree::make_row(node_id parent, std::uint32_t slot, node_id node) const {
+    const Node& owner = nodes_[parent];
+    Row row;
+    row.function = owner.children[slot];
+    row.direction = owner.direction;
+    row.depth = owner.depth + 1;
+    row.parent = parent;
+    row.slot = slot;
+    row.node = node;
+    row.fan_out = graph_->adjacency(owner.direction).neighbors(row.function).size();
+    row.cycle = on_path(parent, row.function);
+    return row;
+}
+
+void CallTree::toggle(const Row& row) {
+    if (empty()) return;
+
+    if (row.header) {
+        const int s = row.direction == SECTION_DIRECTIONS[0] ? 0 : 1;
+        section_open_[s] = !section_open_[s];
+        return;
+    }
+    if (row.node != NO_NODE) {
+        collapse(row.node);
+    } else if (!row.cycle && row.fan_out > 0 && row.parent != NO_NODE) {
+        expand(row.parent, row.slot);
+    }
+}
+
+void CallTree::expand(node_id parent, std::uint32_t slot) {
+    node_id id;
+    if (!free_.empty()) {
+        id = free_.back();
+        free_.pop_back();
+    } else {
+        id = static_cast<node_id>(nodes_.size());
+        nodes_.emplace_back();
+    }
+
+    Node& node = nodes_[id];
+    node.function = nodes_[parent].children[slot];
+    node.direction = nodes_[parent].direction;
+    node.parent = parent;
+    node.depth = nodes_[parent].depth + 1;
+    node.children = graph_->adjacency(node.direction).neighbors(node.function);
+    node.expanded.clear();
+    node.visible = node.children.size();
+
+    auto& siblings = nodes_[parent].expanded;
+    auto at = std::lower_bound(siblings.begin(), siblings.end(), slot,
+                               [](const auto& entry, std::uint32_t s) { return entry.first < s; });
+    siblings.insert(at, {slot, id});
+    add_visible(parent, static_cast<std::ptrdiff_t>(node.visible));
+}
+
+void CallTree::collapse(node_id id) {
+    const node_id parent = nodes_[id].parent;
+    if (parent == NO_NODE) return;
+
+    add_visible(parent, -static_cast<std::ptrdiff_t>(nodes_[id].visible));
+    auto& siblings = nodes_[parent].expanded;
+    siblings.erase(std::find_if(siblings.begin(), siblings.end(),
+                                [id](const auto& entry) { return entry.second == id; }));
+
+    // Release the subtree
+    std::vector<node_id> stack{id};
+    while (!stack.empty()) {
+        const node_id current = stack.back();
+        stack.pop_back();
+        for (const auto& [slot, child] : nodes_[current].expanded) {
+            stack.push_back(child);
+        }
+        nodes_[current].expanded.clear();
+        free_.push_back(current);
+    }
+}
+
+void CallTree::add_visible(node_id id, std::ptrdiff_t delta) {
+    for (; id != NO_NODE; id = nodes_[id].parent) {
+        nodes_[id].visible = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(nodes_[id].visible) + delta);
+    }
+}
+
+bool CallTree::on_path(node_id id, graph_index_t function) const {
+    for (; id != NO_NODE; id = nodes_[id].parent) {
+        if (nodes_[id].function == function) return true;
+    }
+    return false;
+}
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
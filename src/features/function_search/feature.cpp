@@ -2,6 +2,8 @@
 /// @brief Function search feature implementation (ImGui/GPU accelerated)
 
 #include <synopsia/features/function_search/feature.hpp>
+#include <synopsia/core/session_recorder.hpp>
+#include <funcs.hpp>
 
 // Bridge functions for ImGui widget
 extern "C" {
@@ -22,9 +24,56 @@ namespace function_search {
     void init_function_search_state();
     void cleanup_function_search_state();
     void refresh_function_search_data();
+    void rename_function_search_entry(ea_t addr);
+    void invalidate_function_search_entry(ea_t addr);
     void render_function_search();
 }
 
+namespace {
+
+/// Forwards function renames to the loaded name stores, and flow changes to the view's caches
+class FunctionEventListener : public event_listener_t {
+public:
+    ssize_t idaapi on_event(ssize_t code, va_list va) override {
+        switch (code) {
+            case idb_event::func_updated:
+            case idb_event::set_func_start:
+            case idb_event::set_func_end:
+            case idb_event::func_tail_appended:
+            case idb_event::func_tail_deleted:
+            case idb_event::deleting_func: {
+                // Every one of these passes the owning function first
+                const func_t* func = va_arg(va, func_t*);
+                auto* feature = FunctionSearchFeature::instance();
+                if (func && feature) {
+                    feature->on_function_changed(func->start_ea);
+                }
+                return 0;
+            }
+            default:
+                break;
+        }
+        if (code != idb_event::renamed) return 0;
+
+        ea_t ea = va_arg(va, ea_t);
+        (void)va_arg(va, const char*);  // new_name
+        const bool local_name = va_arg(va, int) != 0;
+        if (local_name) return 0;
+
+        func_t* func = get_func(ea);
+        if (func && func->start_ea == ea) {
+            if (auto* feature = FunctionSearchFeature::instance()) {
+                feature->on_function_renamed(ea);
+            }
+        }
+        return 0;
+    }
+};
+
+FunctionEventListener g_function_listener;
+
+} // anonymous namespace
+
 // Static instance pointer
 FunctionSearchFeature* FunctionSearchFeature::instance_ = nullptr;
 
@@ -48,6 +97,7 @@ bool FunctionSearchFeature::initialize() {
     }
 
     data_ = std::make_unique<function_search::FunctionData>();
+    hook_event_listener(HT_IDB, &g_function_listener);
     initialized_ = true;
 
     msg("Synopsia [%s]: Feature initialized (hotkey: %s)\n",
@@ -59,6 +109,7 @@ bool FunctionSearchFeature::initialize() {
 void FunctionSearchFeature::cleanup() {
     if (!initialized_) return;
 
+    unhook_event_listener(HT_IDB, &g_function_listener);
     destroy_widget();
     unregister_actions();
     data_.reset();
@@ -181,9 +232,24 @@ void FunctionSearchFeature::refresh_data() {
     if (data_ && data_->refresh()) {
         msg("Synopsia [%s]: Loaded %zu functions\n",
             function_search::FEATURE_NAME, data_->function_count());
+        SessionRecorder::record_response(TraceSource::FunctionCount, 0,
+                                         static_cast<std::int64_t>(data_->function_count()));
     }
 }
 
+void FunctionSearchFeature::on_function_renamed(ea_t addr) {
+    // Only the renamed entry is re-read; the view picks it up incrementally
+    function_search::rename_function_search_entry(addr);
+    if (data_) {
+        data_->update_name(addr);
+    }
+}
+
+void FunctionSearchFeature::on_function_changed(ea_t addr) {
+    // The thumbnail and details are regenerated the next time they are drawn
+    function_search::invalidate_function_search_entry(addr);
+}
+
 void FunctionSearchFeature::on_database_closed() {
     destroy_widget();
     visible_ = false;
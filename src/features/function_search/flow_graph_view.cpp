@@ -0,0 +1,198 @@
+/// @file flow_graph_view.cpp
+/// @brief Pan/zoom canvas for a FlowLayout
+
+#include <synopsia/features/function_search/flow_graph_view.hpp>
+#include <synopsia/common/frame_arena.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+namespace {
+
+constexpr float MIN_ZOOM = 0.02f;
+constexpr float MAX_ZOOM = 4.0f;
+
+/// Fitted graphs never start smaller than this; larger ones open at their entry
+constexpr float MIN_FIT_ZOOM = 0.25f;
+
+// Below these zooms text and arrowheads are skipped
+constexpr float TEXT_ZOOM = 0.55f;
+constexpr float ARROW_ZOOM = 0.3f;
+
+// Binary map DAG colors
+const ImU32 BACKGROUND = IM_COL32(30, 31, 34, 255);    // #1e1f22
+const ImU32 NODE_FILL = IM_COL32(28, 31, 36, 255);     // #1c1f24
+const ImU32 NODE_STROKE = IM_COL32(100, 100, 100, 255);  // #646464
+const ImU32 HOVER_STROKE = IM_COL32(150, 150, 150, 255);
+const ImU32 ENTRY_STROKE = IM_COL32(186, 230, 126, 255);  // #bae67e
+const ImU32 TEXT_COLOR = IM_COL32(237, 147, 102, 255);    // #ed9366
+const ImU32 EDGE_COLOR = IM_COL32(186, 230, 126, 255);    // #bae67e
+
+} // anonymous namespace
+
+void FlowGraphView::set_layout(std::shared_ptr<const FlowLayout> layout) {
+    if (layout == layout_) return;
+    layout_ = std::move(layout);
+    fitted_ = false;
+}
+
+void FlowGraphView::reset() {
+    layout_.reset();
+    fitted_ = false;
+}
+
+void FlowGraphView::fit(float canvas_width, float canvas_height) {
+    const FlowLayout& layout = *layout_;
+    constexpr float margin = 20.0f;
+    const float fit_zoom = std::min((canvas_width - 2 * margin) / std::max(1.0f, layout.width),
+                                    (canvas_height - 2 * margin) / std::max(1.0f, layout.height));
+    zoom_ = std::clamp(fit_zoom, MIN_FIT_ZOOM, 1.0f);
+
+    // Whole graph centered if it fits, else the entry block centered at the top
+    const float view_width = canvas_width / zoom_;
+    const float view_height = canvas_height / zoom_;
+    if (fit_zoom >= MIN_FIT_ZOOM || layout.blocks.empty()) {
+        origin_x_ = (layout.width - view_width) * 0.5f;
+        origin_y_ = (layout.height - view_height) * 0.5f;
+    } else {
+        const FlowBlock& entry = layout.blocks.front();
+        origin_x_ = entry.x + entry.width * 0.5f - view_width * 0.5f;
+        origin_y_ = entry.y - margin / zoom_;
+    }
+    fitted_ = true;
+}
+
+void FlowGraphView::render() {
+    if (!layout_) return;
+    const FlowLayout& layout = *layout_;
+
+    ImGui::TextDisabled("%zu blocks, %zu edges", layout.blocks.size(), layout.edges.size());
+    ImGui::SameLine();
+    const bool refit = ImGui::SmallButton("Fit");
+
+    const ImVec2 avail = ImGui::GetContentRegionAvail();
+    if (!ImGui::BeginChild("##flow-graph", avail, ImGuiChildFlags_Borders,
+                           ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse)) {
+        ImGui::EndChild();
+        return;
+    }
+
+    const ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+    const ImVec2 canvas_size(std::max(1.0f, ImGui::GetContentRegionAvail().x),
+                             std::max(1.0f, ImGui::GetContentRegionAvail().y));
+    if (!fitted_ || refit) {
+        fit(canvas_size.x, canvas_size.y);
+    }
+
+    // Canvas item captures dragging; the wheel zooms around the cursor
+    ImGui::InvisibleButton("##flow-canvas", canvas_size);
+    const ImGuiIO& io = ImGui::GetIO();
+    if (ImGui::IsItemActive() && ImGui::IsMouseDragging(ImGuiMouseButton_Left)) {
+        origin_x_ -= io.MouseDelta.x / zoom_;
+        origin_y_ -= io.MouseDelta.y / zoom_;
+    }
+    if (ImGui::IsItemHovered() && io.MouseWheel != 0.0f) {
+        const float mx = origin_x_ + (io.MousePos.x - canvas_pos.x) / zoom_;
+        const float my = origin_y_ + (io.MousePos.y - canvas_pos.y) / zoom_;
+        zoom_ = std::clamp(zoom_ * std::pow(1.15f, io.MouseWheel), MIN_ZOOM, MAX_ZOOM);
+        origin_x_ = mx - (io.MousePos.x - canvas_pos.x) / zoom_;
+        origin_y_ = my - (io.MousePos.y - canvas_pos.y) / zoom_;
+    }
+    const bool hovered = ImGui::IsItemHovered();
+
+    auto to_screen = [&](float x, float y) {
+        return ImVec2(canvas_pos.x + (x - origin_x_) * zoom_, canvas_pos.y + (y - origin_y_) * zoom_);
+    };
+
+    // Visible part of the layout
+    const float x0 = origin_x_;
+    const float y0 = origin_y_;
+    const float x1 = origin_x_ + canvas_size.x / zoom_;
+    const float y1 = origin_y_ + canvas_size.y / zoom_;
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(canvas_pos, ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y),
+                             BACKGROUND);
+
+    // Edges under the blocks
+    const bool arrows = zoom_ >= ARROW_ZOOM;
+    FrameVector<ImVec2> polyline;
+    layout.for_each_edge_in(x0, y0, x1, y1, [&](const FlowEdge& edge) {
+        polyline.clear();
+        for (std::uint32_t p = 0; p < edge.point_count; ++p) {
+            const FlowPoint& point = layout.points[edge.first_point + p];
+            polyline.push_back(to_screen(point.x, point.y));
+        }
+        draw_list->AddPolyline(polyline.data(), static_cast<int>(polyline.size()), EDGE_COLOR, ImDrawFlags_None, 1.0f);
+
+        if (!arrows) return;
+        const ImVec2 tip = polyline.back();
+        const ImVec2 prev = polyline[polyline.size() - 2];
+        float dx = tip.x - prev.x;
+        float dy = tip.y - prev.y;
+        const float len = std::sqrt(dx * dx + dy * dy);
+        if (len < 0.1f) return;
+        dx /= len;
+        dy /= len;
+        const float size = 5.0f * zoom_;
+        const float half = 2.5f * zoom_;
+        draw_list->AddTriangleFilled(tip,
+                                     ImVec2(tip.x - dx * size - dy * half, tip.y - dy * size + dx * half),
+                                     ImVec2(tip.x - dx * size + dy * half, tip.y - dy * size - dx * half),
+                                     EDGE_COLOR);
+    });
+
+    // Blocks; the one under the cursor is found among the visible ones
+    const bool text = zoom_ >= TEXT_ZOOM;
+    const float line_height = ImGui::GetTextLineHeight();
+    int hovered_block = -1;
+    char label[64];
+    layout.for_each_block_in(x0, y0, x1, y1, [&](std::size_t i) {
+        const FlowBlock& block = layout.blocks[i];
+        const ImVec2 top_left = to_screen(block.x, block.y);
+        const ImVec2 bottom_right = to_screen(block.x + block.width, block.y + block.height);
+
+        const bool is_hovered = hovered && io.MousePos.x >= top_left.x && io.MousePos.x < bottom_right.x &&
+                                io.MousePos.y >= top_left.y && io.MousePos.y < bottom_right.y;
+        if (is_hovered) {
+            hovered_block = static_cast<int>(i);
+        }
+
+        // A few pixels across: a filled dot is all that reads
+        if (bottom_right.x - top_left.x < 3.0f) {
+            draw_list->AddRectFilled(top_left, bottom_right, i == 0 ? ENTRY_STROKE : NODE_STROKE);
+            return;
+        }
+
+        draw_list->AddRectFilled(top_left, bottom_right, NODE_FILL);
+        const ImU32 stroke = i == 0 ? ENTRY_STROKE : (is_hovered ? HOVER_STROKE : NODE_STROKE);
+        draw_list->AddRect(top_left, bottom_right, stroke, 0.0f, 0, (i == 0 || is_hovered) ? 2.0f : 1.0f);
+
+        if (text && bottom_right.y - top_left.y > line_height) {
+            std::snprintf(label, sizeof(label), "%llX", static_cast<unsigned long long>(block.start));
+            draw_list->AddText(ImVec2(top_left.x + 4.0f, top_left.y + 2.0f), TEXT_COLOR, label);
+        }
+    });
+
+    if (hovered_block >= 0) {
+        const FlowBlock& block = layout.blocks[static_cast<std::size_t>(hovered_block)];
+        ImGui::BeginTooltip();
+        ImGui::Text("%llX - %llX", static_cast<unsigned long long>(block.start),
+                    static_cast<unsigned long long>(block.end));
+        ImGui::TextDisabled("%u instructions", block.instructions);
+        ImGui::EndTooltip();
+    }
+
+    ImGui::EndChild();
+}
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
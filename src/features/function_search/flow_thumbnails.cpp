@@ -0,0 +1,293 @@
+/// @file flow_thumbnails.cpp
+/// @brief CFG thumbnail generation, atlas packing and eviction
+
+#include <synopsia/features/function_search/flow_thumbnails.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+namespace {
+
+// Binary map DAG colors, 0xAARRGGBB
+constexpr std::uint32_t BLOCK_COLOR = 0xFFA0A0A0;
+constexpr std::uint32_t ENTRY_COLOR = 0xFFBAE67E;  // #bae67e
+constexpr std::uint32_t EDGE_COLOR = 0x80BAE67E;
+
+/// Edges past this many are not drawn; the silhouette is already solid
+constexpr std::size_t MAX_EDGES = 2048;
+
+void draw_line(std::uint32_t* pixels, std::size_t stride, int x0, int y0, int x1, int y1) {
+    const int steps = std::max(std::abs(x1 - x0), std::abs(y1 - y0));
+    for (int s = 0; s <= steps; ++s) {
+        const float t = steps == 0 ? 0.0f : static_cast<float>(s) / static_cast<float>(steps);
+        const int x = x0 + static_cast<int>(std::lround(static_cast<float>(x1 - x0) * t));
+        const int y = y0 + static_cast<int>(std::lround(static_cast<float>(y1 - y0) * t));
+        pixels[static_cast<std::size_t>(y) * stride + static_cast<std::size_t>(x)] = EDGE_COLOR;
+    }
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Rasterization
+// ============================================================================
+
+void FlowThumbnails::rasterize(const FlowOutline& outline, std::uint32_t* pixels, std::size_t stride) {
+    const std::size_t count = outline.block_sizes.size();
+    if (count == 0) return;
+
+    // Layers by breadth-first depth from the entry; unreachable blocks go below
+    std::vector<int> layer(count, -1);
+    std::vector<std::uint32_t> queue;
+    queue.reserve(count);
+    int layers = 0;
+    for (std::size_t seed = 0; seed < count; ++seed) {
+        if (layer[seed] >= 0) continue;
+        layer[seed] = layers;
+        queue.push_back(static_cast<std::uint32_t>(seed));
+        for (std::size_t head = queue.size() - 1; head < queue.size(); ++head) {
+            const std::uint32_t block = queue[head];
+            layers = std::max(layers, layer[block] + 1);
+            for (std::uint32_t s = outline.successor_offsets[block]; s < outline.successor_offsets[block + 1]; ++s) {
+                const std::uint32_t next = outline.successors[s];
+                if (layer[next] < 0) {
+                    layer[next] = layer[block] + 1;
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+
+    // Rows spread over the tile with a pixel of margin; bars are 1-2 px tall
+    const int rows = TILE_HEIGHT - 2;
+    const float pitch = layers > 1 ? static_cast<float>(rows - 1) / static_cast<float>(layers - 1) : 0.0f;
+    const int bar_height = pitch >= 3.0f ? 2 : 1;
+    auto row_of = [&](int l) {
+        return layers > 1 ? 1 + static_cast<int>(static_cast<float>(l) * pitch) : TILE_HEIGHT / 2;
+    };
+
+    // Each layer splits the width evenly; bar width grows with block size
+    std::vector<std::uint32_t> in_layer(static_cast<std::size_t>(layers), 0);
+    std::vector<std::uint32_t> slot(count);
+    for (std::uint32_t block : queue) {
+        slot[block] = in_layer[static_cast<std::size_t>(layer[block])]++;
+    }
+    const std::uint32_t largest = *std::max_element(outline.block_sizes.begin(), outline.block_sizes.end());
+    const float inv_largest = 1.0f / std::sqrt(static_cast<float>(std::max(largest, 1u)));
+
+    struct Bar {
+        int x0;
+        int x1;
+        int y;
+    };
+    std::vector<Bar> bars(count);
+    const float span = static_cast<float>(TILE_WIDTH - 2);
+    for (std::size_t b = 0; b < count; ++b) {
+        const float slot_width = span / static_cast<float>(in_layer[static_cast<std::size_t>(layer[b])]);
+        const float weight = 0.4f + 0.6f * std::sqrt(static_cast<float>(outline.block_sizes[b])) * inv_largest;
+        const float width = std::max(1.0f, slot_width * 0.8f * weight);
+        const float center = 1.0f + slot_width * (static_cast<float>(slot[b]) + 0.5f);
+        const int x0 = std::clamp(static_cast<int>(center - width * 0.5f), 1, TILE_WIDTH - 2);
+        const int x1 = std::clamp(static_cast<int>(center + width * 0.5f), x0, TILE_WIDTH - 2);
+        bars[b] = {x0, x1, row_of(layer[b])};
+    }
+
+    // Edges from bar centers underneath the bars
+    std::size_t edges = 0;
+    for (std::size_t b = 0; b < count && edges < MAX_EDGES; ++b) {
+        const Bar& from = bars[b];
+        for (std::uint32_t s = outline.successor_offsets[b]; s < outline.successor_offsets[b + 1] && edges < MAX_EDGES;
+             ++s, ++edges) {
+            const Bar& to = bars[outline.successors[s]];
+            draw_line(pixels, stride, (from.x0 + from.x1) / 2, from.y, (to.x0 + to.x1) / 2, to.y);
+        }
+    }
+
+    for (std::size_t b = 0; b < count; ++b) {
+        const Bar& bar = bars[b];
+        const std::uint32_t color = b == 0 ? ENTRY_COLOR : BLOCK_COLOR;
+        for (int y = bar.y; y < std::min(bar.y + bar_height, TILE_HEIGHT - 1); ++y) {
+            std::fill(pixels + static_cast<std::size_t>(y) * stride + static_cast<std::size_t>(bar.x0),
+                      pixels + static_cast<std::size_t>(y) * stride + static_cast<std::size_t>(bar.x1) + 1, color);
+        }
+    }
+}
+
+// ============================================================================
+// Atlas
+// ============================================================================
+
+FlowThumbnails::FlowThumbnails()
+    : tiles_(TILE_COUNT),
+      pixels_(static_cast<std::size_t>(ATLAS_WIDTH) * ATLAS_HEIGHT, 0) {}
+
+bool FlowThumbnails::draw(ImDrawList* draw_list, func_addr_t address, const ImVec2& min, const ImVec2& max) {
+    auto it = entries_.find(address);
+    if (it == entries_.end()) {
+        request(address);
+        return false;
+    }
+    const int tile = it->second.tile;
+    if (tile == NO_TILE || !texture_) return false;
+
+    touch(tile);
+    const float u = static_cast<float>((tile % TILE_COLUMNS) * TILE_WIDTH) / ATLAS_WIDTH;
+    const float v = static_cast<float>((tile / TILE_COLUMNS) * TILE_HEIGHT) / ATLAS_HEIGHT;
+    draw_list->AddImage(texture_, min, max, ImVec2(u, v),
+                        ImVec2(u + static_cast<float>(TILE_WIDTH) / ATLAS_WIDTH,
+                               v + static_cast<float>(TILE_HEIGHT) / ATLAS_HEIGHT));
+    return true;
+}
+
+void FlowThumbnails::prefetch(func_addr_t address) {
+    if (entries_.find(address) == entries_.end()) {
+        request(address);
+    }
+}
+
+void FlowThumbnails::request(func_addr_t address) {
+    if (wanted_.size() < MAX_WANTED) {
+        wanted_.push_back(address);
+    }
+}
+
+void FlowThumbnails::generate(const IFunctionDataSource& data, const ImageUploader& upload,
+                              std::chrono::microseconds budget) {
+    if (!upload) {
+        wanted_.clear();
+        return;
+    }
+
+    if (entries_.size() > MAX_ENTRIES) {
+        std::erase_if(entries_, [](const auto& entry) { return entry.second.tile == NO_TILE; });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    bool generated = false;
+    for (func_addr_t address : wanted_) {
+        if (generated && std::chrono::steady_clock::now() - start >= budget) break;
+        if (!entries_.try_emplace(address).second) continue;  // Asked twice, or done
+        generated = true;
+
+        if (!data.flow_outline(address, outline_) || outline_.block_sizes.empty()) continue;
+        const int tile = take_tile();
+        entries_[address].tile = tile;
+        tiles_[static_cast<std::size_t>(tile)].owner = address;
+        push_front(tile);
+
+        const int x = (tile % TILE_COLUMNS) * TILE_WIDTH;
+        const int y = (tile / TILE_COLUMNS) * TILE_HEIGHT;
+        std::uint32_t* origin = pixels_.data() + static_cast<std::size_t>(y) * ATLAS_WIDTH + x;
+        for (int row = 0; row < TILE_HEIGHT; ++row) {
+            std::fill(origin + static_cast<std::size_t>(row) * ATLAS_WIDTH,
+                      origin + static_cast<std::size_t>(row) * ATLAS_WIDTH + TILE_WIDTH, 0u);
+        }
+        rasterize(outline_, origin, ATLAS_WIDTH);
+        dirty_first_ = std::min(dirty_first_, y);
+        dirty_last_ = std::max(dirty_last_, y + TILE_HEIGHT - 1);
+    }
+    wanted_.clear();
+
+    // The first upload sends the whole atlas; later ones only the touched rows
+    if (!uploaded_) {
+        texture_ = upload(pixels_.data(), ATLAS_WIDTH, ATLAS_HEIGHT, 0, ATLAS_HEIGHT);
+        uploaded_ = texture_ != ImTextureID{};
+    } else if (dirty_first_ <= dirty_last_) {
+        texture_ = upload(pixels_.data(), ATLAS_WIDTH, ATLAS_HEIGHT, dirty_first_, dirty_last_ - dirty_first_ + 1);
+    } else {
+        return;
+    }
+    dirty_first_ = ATLAS_HEIGHT;
+    dirty_last_ = 0;
+}
+
+void FlowThumbnails::clear() {
+    entries_.clear();
+    tiles_.assign(TILE_COUNT, Tile{});
+    head_ = tail_ = NO_TILE;
+    next_free_ = 0;
+    wanted_.clear();
+}
+
+void FlowThumbnails::invalidate(func_addr_t address) {
+    auto it = entries_.find(address);
+    if (it == entries_.end()) return;
+    const int tile = it->second.tile;
+    entries_.erase(it);
+    if (tile == NO_TILE) return;
+
+    // Ownerless at the LRU tail, so it is the next tile handed out once the atlas is full
+    unlink(tile);
+    tiles_[static_cast<std::size_t>(tile)].owner = FUNC_BADADDR;
+    push_back(tile);
+}
+
+// ============================================================================
+// LRU
+// ============================================================================
+
+int FlowThumbnails::take_tile() {
+    if (next_free_ < TILE_COUNT) return next_free_++;
+
+    const int tile = tail_;
+    unlink(tile);
+    const func_addr_t owner = tiles_[static_cast<std::size_t>(tile)].owner;
+    if (owner != FUNC_BADADDR) entries_.erase(owner);
+    tiles_[static_cast<std::size_t>(tile)].owner = FUNC_BADADDR;
+    return tile;
+}
+
+void FlowThumbnails::touch(int tile) {
+    if (tile == head_) return;
+    unlink(tile);
+    push_front(tile);
+}
+
+void FlowThumbnails::unlink(int tile) {
+    Tile& t = tiles_[static_cast<std::size_t>(tile)];
+    if (t.prev != NO_TILE) {
+        tiles_[static_cast<std::size_t>(t.prev)].next = t.next;
+    } else {
+        head_ = t.next;
+    }
+    if (t.next != NO_TILE) {
+        tiles_[static_cast<std::size_t>(t.next)].prev = t.prev;
+    } else {
+        tail_ = t.prev;
+    }
+    t.prev = t.next = NO_TILE;
+}
+
+void FlowThumbnails::push_front(int tile) {
+    Tile& t = tiles_[static_cast<std::size_t>(tile)];
+    t.prev = NO_TILE;
+    t.next = head_;
+    if (head_ != NO_TILE) {
+        tiles_[static_cast<std::size_t>(head_)].prev = tile;
+    }
+    head_ = tile;
+    if (tail_ == NO_TILE) {
+        tail_ = tile;
+    }
+}
+
+void FlowThumbnails::push_back(int tile) {
+    Tile& t = tiles_[static_cast<std::size_t>(tile)];
+    t.next = NO_TILE;
+    t.prev = tail_;
+    if (tail_ != NO_TILE) {
+        tiles_[static_cast<std::size_t>(tail_)].next = tile;
+    }
+    tail_ = tile;
+    if (head_ == NO_TILE) {
+        head_ = tile;
+    }
+}
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
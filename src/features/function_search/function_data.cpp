@@ -2,18 +2,27 @@
 /// @brief Function data implementation
 
 #include <synopsia/features/function_search/function_data.hpp>
+#include <synopsia/core/analysis_cache.hpp>
+#include <synopsia/core/analysis_snapshot.hpp>
+#include <synopsia/core/query_index.hpp>
+#include <synopsia/common/alloc_tracker.hpp>
 #include <funcs.hpp>
 #include <name.hpp>
 #include <lines.hpp>
 #include <bytes.hpp>
 #include <ua.hpp>
+#include <gdl.hpp>
 #include <hexrays.hpp>
+#include <algorithm>
 
 namespace synopsia {
 namespace features {
 namespace function_search {
 
 // Check if Hex-Rays is available (cached)
+/// Functions larger than this get no outline; charting them would stall a frame
+static constexpr ea_t MAX_OUTLINE_BYTES = 256 * 1024;
+
 static bool g_hexrays_checked = false;
 static bool g_hexrays_available = false;
 
@@ -26,14 +35,28 @@ static bool check_hexrays() {
 }
 
 bool FunctionData::refresh() {
+    static AllocationSite site("function_search", "refresh");
+    AllocationScope allocations(site);
+
     functions_.clear();
     name_to_addr_.clear();
+    renames_.clear();
+    call_graph_.reset();
+    flow_layouts_.clear();
+    log_start_ = ++revision_;
 
     if (!is_database_loaded()) {
         valid_ = false;
         return false;
     }
 
+    // Precomputed names skip demangling every function
+    if (load_cache() || load_snapshot()) {
+        valid_ = true;
+        allocations.set_items(functions_.size());
+        return true;
+    }
+
     // Count functions for reserve
     std::size_t count = 0;
     for (std::size_t i = 0; i < get_func_qty(); ++i) {
@@ -49,6 +72,7 @@ bool FunctionData::refresh() {
 
         FunctionEntry entry;
         entry.address = func->start_ea;
+        entry.size = func->size();
 
         // Get function name
         qstring name;
@@ -74,14 +98,245 @@ bool FunctionData::refresh() {
     }
 
     valid_ = true;
+    allocations.set_items(functions_.size());
+    return true;
+}
+
+bool FunctionData::load_cache() {
+    std::vector<CachedFunctionRecord> records;
+    std::vector<std::string> names;
+    std::vector<std::string> demangled;
+
+    if (!AnalysisCache::read(CacheSection::FunctionRecords, CacheScope::Functions, records) ||
+        !AnalysisCache::read_strings(CacheSection::FunctionNames, CacheScope::Names, names) ||
+        !AnalysisCache::read_strings(CacheSection::DemangledNames, CacheScope::Names, demangled)) {
+        return false;
+    }
+    if (names.size() != records.size() || demangled.size() != records.size()) {
+        return false;
+    }
+
+    functions_.reserve(records.size());
+    name_to_addr_.reserve(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        FunctionEntry entry;
+        entry.address = static_cast<ea_t>(records[i].address);
+        entry.size = records[i].size;
+        entry.name = names[i].c_str();
+        entry.demangled_name = demangled[i].c_str();
+
+        name_to_addr_[names[i]] = static_cast<func_addr_t>(entry.address);
+        if (!demangled[i].empty()) {
+            name_to_addr_[demangled[i]] = static_cast<func_addr_t>(entry.address);
+        }
+
+        functions_.push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool FunctionData::load_snapshot() {
+    auto snapshot = database_snapshot();
+    if (!snapshot || !snapshot_matches(*snapshot, CacheScope::Functions)) {
+        return false;
+    }
+
+    const auto address = snapshot->column<std::uint64_t>(SnapshotSection::FunctionAddress);
+    const auto size = snapshot->column<std::uint32_t>(SnapshotSection::FunctionSize);
+    const auto names = snapshot->strings(SnapshotSection::NameOffsets, SnapshotSection::NameData);
+    const auto demangled = snapshot->strings(SnapshotSection::DemangledOffsets, SnapshotSection::DemangledData);
+    if (address.empty() || size.size() != address.size() ||
+        names.size() != address.size() || demangled.size() != address.size()) {
+        return false;
+    }
+
+    functions_.reserve(address.size());
+    name_to_addr_.reserve(address.size());
+    for (std::size_t i = 0; i < address.size(); ++i) {
+        FunctionEntry entry;
+        entry.address = static_cast<ea_t>(address[i]);
+        entry.size = size[i];
+        entry.name = qstring(names[i].data(), names[i].size());
+        entry.demangled_name = qstring(demangled[i].data(), demangled[i].size());
+
+        name_to_addr_[std::string(names[i])] = static_cast<func_addr_t>(entry.address);
+        if (!demangled[i].empty()) {
+            name_to_addr_[std::string(demangled[i])] = static_cast<func_addr_t>(entry.address);
+        }
+
+        functions_.push_back(std::move(entry));
+    }
     return true;
 }
 
+bool FunctionData::update_name(ea_t address) {
+    auto it = std::lower_bound(functions_.begin(), functions_.end(), address,
+                               [](const FunctionEntry& f, ea_t ea) { return f.address < ea; });
+    if (it == functions_.end() || it->address != address) {
+        return false;
+    }
+
+    // Stale lookups for the old names are dropped; the new ones are added
+    const auto drop = [this, address](const qstring& name) {
+        auto found = name_to_addr_.find(std::string(name.c_str()));
+        if (found != name_to_addr_.end() && found->second == static_cast<func_addr_t>(address)) {
+            name_to_addr_.erase(found);
+        }
+    };
+    drop(it->name);
+    drop(it->demangled_name);
+
+    if (get_func_name(&it->name, address) <= 0) {
+        it->name.sprnt("sub_%llX", static_cast<unsigned long long>(address));
+    }
+    if (get_demangled_name(&it->demangled_name, address, 0, 0) <= 0) {
+        it->demangled_name.clear();
+    }
+    name_to_addr_[std::string(it->name.c_str())] = static_cast<func_addr_t>(address);
+    if (!it->demangled_name.empty()) {
+        name_to_addr_[std::string(it->demangled_name.c_str())] = static_cast<func_addr_t>(address);
+    }
+
+    renames_.emplace_back(++revision_, static_cast<std::size_t>(it - functions_.begin()));
+    if (renames_.size() > MAX_RENAME_LOG) {
+        log_start_ = renames_.front().first;
+        renames_.erase(renames_.begin());
+    }
+    return true;
+}
+
+bool FunctionData::renamed_since(std::uint64_t since, std::vector<std::size_t>& out) const {
+    if (since < log_start_) {
+        return false;
+    }
+    for (const auto& [revision, index] : renames_) {
+        if (revision > since) {
+            out.push_back(index);
+        }
+    }
+    return true;
+}
+
+FlowLayoutState FunctionData::flow_layout(func_addr_t address, std::shared_ptr<const FlowLayout>& out) const {
+    if (!valid_) return FlowLayoutState::Unavailable;
+    return flow_layouts_.get(static_cast<ea_t>(address), out);
+}
+
+bool FunctionData::flow_outline(func_addr_t address, FlowOutline& out) const {
+    if (!valid_) return false;
+    func_t* func = get_func(static_cast<ea_t>(address));
+    if (!func || func->end_ea - func->start_ea > MAX_OUTLINE_BYTES) return false;
+
+    // Predecessors are not needed, which saves the chart half its work
+    qflow_chart_t chart("", func, func->start_ea, func->end_ea, FC_NOEXT | FC_NOPREDS);
+    const int count = chart.size();
+    if (count <= 0) return false;
+
+    // The entry block goes first, swapped with whichever block held index 0
+    int entry = 0;
+    for (int i = 0; i < count; ++i) {
+        if (chart.blocks[i].start_ea == func->start_ea) {
+            entry = i;
+            break;
+        }
+    }
+    auto index_of = [entry](int block) {
+        return static_cast<std::uint32_t>(block == entry ? 0 : (block == 0 ? entry : block));
+    };
+
+    out.block_sizes.assign(static_cast<std::size_t>(count), 0);
+    out.successor_offsets.assign(1, 0);
+    out.successors.clear();
+    for (int i = 0; i < count; ++i) {
+        const int source = i == 0 ? entry : (i == entry ? 0 : i);
+        const qbasic_block_t& bb = chart.blocks[source];
+        out.block_sizes[static_cast<std::size_t>(i)] = static_cast<std::uint32_t>(bb.end_ea - bb.start_ea);
+        for (int s = 0; s < chart.nsucc(source); ++s) {
+            out.successors.push_back(index_of(chart.succ(source, s)));
+        }
+        out.successor_offsets.push_back(static_cast<std::uint32_t>(out.successors.size()));
+    }
+    return true;
+}
+
+std::shared_ptr<const CallGraph> FunctionData::call_graph() const {
+    if (call_graph_ || !valid_) {
+        return call_graph_;
+    }
+
+    // The query snapshot already holds the CSR graph; rebuild it only if it
+    // predates this function list
+    const auto matches = [this](const QuerySnapshot& snapshot) {
+        const auto& nodes = snapshot.map.nodes();
+        if (nodes.size() != functions_.size()) return false;
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            if (nodes[i].address != functions_[i].address) return false;
+        }
+        return true;
+    };
+    // The rebuild walks every xref, so it advances a slice per frame
+    auto snapshot = QueryIndex::current();
+    if (!snapshot || !matches(*snapshot)) {
+        call_graph_pending_ = !QueryIndex::refresh_step(CALL_GRAPH_BUDGET);
+        if (call_graph_pending_) {
+            return nullptr;
+        }
+        snapshot = QueryIndex::current();
+    }
+    if (!snapshot) {
+        return nullptr;
+    }
+
+    if (matches(*snapshot)) {
+        // Same node order: share the snapshot's graph without copying
+        call_graph_ = std::shared_ptr<const CallGraph>(snapshot, &snapshot->map.graph());
+        return call_graph_;
+    }
+
+    // Different function sets: remap edges by address
+    const auto& nodes = snapshot->map.nodes();
+    const CallGraph& source = snapshot->map.graph();
+    std::vector<graph_index_t> remap(nodes.size(), GRAPH_NO_NODE);
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        auto it = std::lower_bound(functions_.begin(), functions_.end(), nodes[i].address,
+                                   [](const FunctionEntry& f, ea_t ea) { return f.address < ea; });
+        if (it != functions_.end() && it->address == nodes[i].address) {
+            remap[i] = static_cast<graph_index_t>(it - functions_.begin());
+        }
+    }
+
+    std::vector<std::pair<graph_index_t, graph_index_t>> edges;
+    edges.reserve(source.edge_count());
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (remap[i] == GRAPH_NO_NODE) continue;
+        for (graph_index_t callee : source.callees(static_cast<graph_index_t>(i))) {
+            if (remap[callee] != GRAPH_NO_NODE) {
+                edges.emplace_back(remap[i], remap[callee]);
+            }
+        }
+    }
+    auto graph = std::make_shared<CallGraph>();
+    graph->build(functions_.size(), edges);
+    call_graph_ = std::move(graph);
+    return call_graph_;
+}
+
+bool FunctionData::store_cache() const {
+    if (!valid_) return false;
+
+    std::vector<std::string> demangled;
+    demangled.reserve(functions_.size());
+    for (const auto& f : functions_) {
+        demangled.emplace_back(f.demangled_name.c_str());
+    }
+    return AnalysisCache::write_strings(CacheSection::DemangledNames, CacheScope::Names, demangled);
+}
+
 bool FunctionData::has_decompiler() const {
     return check_hexrays();
 }
 
-func_addr_t FunctionData::find_function_by_name(const std::string& name) const {
+func_addr_t FunctionData::find_function_by_name(std::string_view name) const {
     auto it = name_to_addr_.find(name);
     if (it != name_to_addr_.end()) {
         return it->second;
@@ -0,0 +1,401 @@
+/// @file layout_cache.cpp
+/// @brief Background basic-block graph layouts
+
+#include <synopsia/features/function_search/layout_cache.hpp>
+#include <synopsia/features/function_search/feature.hpp>
+#include <synopsia/core/analysis_cache.hpp>
+#include <funcs.hpp>
+#include <gdl.hpp>
+#include <bytes.hpp>
+
+// DAG Flowchart layout library
+#include "layout/GraphGridLayout.h"
+#include "core/GraphLayout.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <limits>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+namespace {
+
+/// Bump when block sizing or the layout settings change
+constexpr std::uint64_t LAYOUT_VERSION = 1;
+
+/// Smaller functions lay out faster than they load from the IDB
+constexpr std::size_t PERSIST_MIN_BLOCKS = 64;
+
+/// In-memory layouts kept (least recently used go first)
+constexpr std::size_t MAX_CACHED_LAYOUTS = 64;
+
+/// A layout cannot be interrupted, so its size bounds how long closing waits for one
+constexpr std::size_t MAX_LAYOUT_BLOCKS = 2000;
+
+// Block box: a header line, then a strip per instruction like IDA's graph overview
+constexpr float BLOCK_WIDTH = 120.0f;
+constexpr float BLOCK_HEADER_HEIGHT = 20.0f;
+constexpr float BLOCK_LINE_HEIGHT = 3.0f;
+constexpr std::uint32_t BLOCK_MAX_LINES = 64;
+
+/// FNV-1a over 64-bit words
+struct SignatureHasher {
+    std::uint64_t value = 14695981039346656037ULL;
+
+    void add(std::uint64_t word) {
+        for (int i = 0; i < 8; ++i) {
+            value ^= (word >> (i * 8)) & 0xFF;
+            value *= 1099511628211ULL;
+        }
+    }
+};
+
+/// Counts and canvas size in front of the persisted arrays
+struct LayoutHeader {
+    std::uint32_t blocks;
+    std::uint32_t edges;
+    std::uint32_t points;
+    float width;
+    float height;
+};
+
+template <typename T>
+void append(std::vector<std::uint8_t>& out, const std::vector<T>& items) {
+    const std::size_t offset = out.size();
+    out.resize(offset + items.size() * sizeof(T));
+    if (!items.empty()) {
+        std::memcpy(out.data() + offset, items.data(), items.size() * sizeof(T));
+    }
+}
+
+template <typename T>
+bool extract(const std::vector<std::uint8_t>& in, std::size_t& offset, std::size_t count, std::vector<T>& items) {
+    if (in.size() - offset < count * sizeof(T)) return false;
+    items.resize(count);
+    if (count > 0) {
+        std::memcpy(items.data(), in.data() + offset, count * sizeof(T));
+    }
+    offset += count * sizeof(T);
+    return true;
+}
+
+std::vector<std::uint8_t> serialize(const FlowLayout& layout) {
+    const LayoutHeader header{static_cast<std::uint32_t>(layout.blocks.size()),
+                              static_cast<std::uint32_t>(layout.edges.size()),
+                              static_cast<std::uint32_t>(layout.points.size()),
+                              layout.width, layout.height};
+    std::vector<std::uint8_t> out(sizeof(header));
+    std::memcpy(out.data(), &header, sizeof(header));
+    append(out, layout.blocks);
+    append(out, layout.edges);
+    append(out, layout.points);
+    return out;
+}
+
+std::shared_ptr<FlowLayout> deserialize(const std::vector<std::uint8_t>& in) {
+    LayoutHeader header{};
+    if (in.size() < sizeof(header)) return nullptr;
+    std::memcpy(&header, in.data(), sizeof(header));
+
+    auto layout = std::make_shared<FlowLayout>();
+    std::size_t offset = sizeof(header);
+    if (!extract(in, offset, header.blocks, layout->blocks) ||
+        !extract(in, offset, header.edges, layout->edges) ||
+        !extract(in, offset, header.points, layout->points) || offset != in.size()) {
+        return nullptr;
+    }
+    // The blob comes from the IDB: every index the view follows must be in range
+    const std::size_t block_count = layout->blocks.size();
+    const std::size_t point_count = layout->points.size();
+    for (const FlowEdge& edge : layout->edges) {
+        if (edge.from >= block_count || edge.to >= block_count || edge.point_count < 2 ||
+            edge.first_point > point_count || edge.point_count > point_count - edge.first_point) {
+            return nullptr;
+        }
+    }
+
+    layout->width = header.width;
+    layout->height = header.height;
+    layout->finalize();
+    return layout;
+}
+
+} // anonymous namespace
+
+FlowLayoutCache::~FlowLayoutCache() {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->cancelled = true;
+        state_->queued.reset();
+    }
+    state_->wake.notify_all();
+
+    // The worker runs the module's code, so it must be gone before the plugin
+    // unloads. At most one layout is left to finish, and MAX_LAYOUT_BLOCKS bounds it.
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+FlowLayoutState FlowLayoutCache::get(ea_t address, std::shared_ptr<const FlowLayout>& out) {
+    collect();
+
+    func_t* func = get_func(address);
+    if (!func) return FlowLayoutState::Unavailable;
+    const ea_t function = func->start_ea;
+
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (state_->running == function || (state_->queued && state_->queued->function == function)) {
+            return FlowLayoutState::Pending;
+        }
+    }
+
+    // A layout collected since the last call was made from the current chart
+    auto it = entries_.find(function);
+    if (it != entries_.end() && it->second.fresh) {
+        it->second.fresh = false;
+        it->second.last_used = ++clock_;
+        out = it->second.layout;
+        return out ? FlowLayoutState::Ready : FlowLayoutState::Unavailable;
+    }
+
+    auto job = std::make_unique<Job>();
+    if (!read_chart(func, *job)) return FlowLayoutState::Unavailable;
+    job->function = function;
+    if (job->layout->blocks.size() > MAX_LAYOUT_BLOCKS) return FlowLayoutState::Unavailable;
+
+    // Same chart as the cached or persisted layout: reuse it
+    if (it != entries_.end() && it->second.signature == job->signature) {
+        it->second.last_used = ++clock_;
+        out = it->second.layout;
+        return out ? FlowLayoutState::Ready : FlowLayoutState::Unavailable;
+    }
+    std::vector<std::uint8_t> payload;
+    if (job->layout->blocks.size() >= PERSIST_MIN_BLOCKS &&
+        AnalysisCache::read_keyed(CacheSection::FlowLayouts, function, job->signature, payload)) {
+        if (std::shared_ptr<FlowLayout> loaded = deserialize(payload)) {
+            remember(function, job->signature, loaded, false);
+            out = std::move(loaded);
+            return FlowLayoutState::Ready;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        job->generation = state_->generation;
+        state_->queued = std::move(job);
+        if (!worker_.joinable()) {
+            worker_ = std::thread(&FlowLayoutCache::worker_loop, state_);
+        }
+    }
+    state_->wake.notify_one();
+    return FlowLayoutState::Pending;
+}
+
+void FlowLayoutCache::clear() {
+    entries_.clear();
+
+    // A layout still running finishes, but its result is dropped on arrival
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    ++state_->generation;
+    state_->queued.reset();
+    state_->finished.clear();
+}
+
+bool FlowLayoutCache::read_chart(func_t* func, Job& job) {
+    qflow_chart_t chart("", func, func->start_ea, func->end_ea, FC_NOEXT);
+    const int count = chart.size();
+    if (count <= 0) return false;
+
+    // The entry block goes first; the rest keep the chart's order
+    std::vector<std::uint32_t> order(static_cast<std::size_t>(count));
+    std::vector<std::uint32_t> index_of(static_cast<std::size_t>(count));
+    int entry = 0;
+    for (int i = 0; i < count; ++i) {
+        if (chart.blocks[i].start_ea == func->start_ea) {
+            entry = i;
+            break;
+        }
+    }
+    order[0] = static_cast<std::uint32_t>(entry);
+    for (int i = 0, next = 1; i < count; ++i) {
+        if (i != entry) order[static_cast<std::size_t>(next++)] = static_cast<std::uint32_t>(i);
+    }
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        index_of[order[i]] = static_cast<std::uint32_t>(i);
+    }
+
+    SignatureHasher hasher;
+    hasher.add(LAYOUT_VERSION);
+    hasher.add(static_cast<std::uint64_t>(count));
+
+    job.layout = std::make_shared<FlowLayout>();
+    job.layout->blocks.reserve(order.size());
+    job.successor_offsets.assign(1, 0);
+    std::vector<std::uint32_t> targets;
+    for (std::uint32_t source : order) {
+        const qbasic_block_t& bb = chart.blocks[static_cast<int>(source)];
+
+        std::uint32_t instructions = 0;
+        for (ea_t ea = bb.start_ea; ea < bb.end_ea && ea != BADADDR; ea = next_head(ea, bb.end_ea)) {
+            ++instructions;
+        }
+
+        FlowBlock block{};
+        block.start = bb.start_ea;
+        block.end = bb.end_ea;
+        block.instructions = instructions;
+        block.width = BLOCK_WIDTH;
+        block.height = BLOCK_HEADER_HEIGHT + BLOCK_LINE_HEIGHT * static_cast<float>(std::min(instructions, BLOCK_MAX_LINES));
+        job.layout->blocks.push_back(block);
+
+        // Switches list a target once per case; the layout needs each edge once
+        targets.clear();
+        for (int s = 0; s < chart.nsucc(static_cast<int>(source)); ++s) {
+            targets.push_back(index_of[static_cast<std::size_t>(chart.succ(static_cast<int>(source), s))]);
+        }
+        std::sort(targets.begin(), targets.end());
+        targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+        job.successors.insert(job.successors.end(), targets.begin(), targets.end());
+        job.successor_offsets.push_back(static_cast<std::uint32_t>(job.successors.size()));
+
+        hasher.add(block.start);
+        hasher.add(block.end);
+        hasher.add(instructions);
+        for (std::uint32_t target : targets) {
+            hasher.add(target);
+        }
+    }
+    job.signature = hasher.value;
+    return true;
+}
+
+void FlowLayoutCache::lay_out(Job& job) {
+    FlowLayout& layout = *job.layout;
+
+    GraphLayout::Graph graph;
+    for (std::size_t i = 0; i < layout.blocks.size(); ++i) {
+        GraphLayout::GraphBlock block;
+        block.entry = static_cast<uint64_t>(i);
+        block.width = static_cast<int>(layout.blocks[i].width);
+        block.height = static_cast<int>(layout.blocks[i].height);
+        for (std::uint32_t s = job.successor_offsets[i]; s < job.successor_offsets[i + 1]; ++s) {
+            block.edges.emplace_back(static_cast<uint64_t>(job.successors[s]));
+        }
+        graph[block.entry] = block;
+    }
+
+    int canvas_width = 0;
+    int canvas_height = 0;
+    try {
+        // Same settings as the binary map's DAG mode (Wide: the LP optimizer is off)
+        GraphGridLayout grid(GraphGridLayout::LayoutType::Wide);
+        grid.setLayoutConfig({
+            .blockVerticalSpacing = 40,
+            .blockHorizontalSpacing = 20,
+            .edgeVerticalSpacing = 10,
+            .edgeHorizontalSpacing = 10
+        });
+        grid.CalculateLayout(graph, 0, canvas_width, canvas_height);
+    } catch (const std::exception&) {
+        job.failed = true;
+        return;
+    }
+
+    layout.width = static_cast<float>(canvas_width);
+    layout.height = static_cast<float>(canvas_height);
+    for (std::size_t i = 0; i < layout.blocks.size(); ++i) {
+        const GraphLayout::GraphBlock& placed = graph[static_cast<uint64_t>(i)];
+        layout.blocks[i].x = static_cast<float>(placed.x);
+        layout.blocks[i].y = static_cast<float>(placed.y);
+
+        for (const auto& edge : placed.edges) {
+            if (edge.polyline.size() < 2) continue;
+            FlowEdge routed{};
+            routed.from = static_cast<std::uint32_t>(i);
+            routed.to = static_cast<std::uint32_t>(edge.target);
+            routed.first_point = static_cast<std::uint32_t>(layout.points.size());
+            routed.point_count = static_cast<std::uint32_t>(edge.polyline.size());
+            routed.min_x = routed.min_y = std::numeric_limits<float>::max();
+            routed.max_x = routed.max_y = std::numeric_limits<float>::lowest();
+            for (const auto& pt : edge.polyline) {
+                const FlowPoint point{static_cast<float>(pt.x), static_cast<float>(pt.y)};
+                routed.min_x = std::min(routed.min_x, point.x);
+                routed.min_y = std::min(routed.min_y, point.y);
+                routed.max_x = std::max(routed.max_x, point.x);
+                routed.max_y = std::max(routed.max_y, point.y);
+                layout.points.push_back(point);
+            }
+            layout.edges.push_back(routed);
+        }
+    }
+    layout.finalize();
+}
+
+void FlowLayoutCache::collect() {
+    std::vector<std::unique_ptr<Job>> finished;
+    std::uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        finished.swap(state_->finished);
+        generation = state_->generation;
+    }
+
+    for (const auto& job : finished) {
+        if (job->generation != generation) continue;
+        if (job->failed) {
+            msg("Synopsia [%s]: Graph layout failed for %a (%zu blocks)\n",
+                FEATURE_NAME, job->function, job->layout->blocks.size());
+            remember(job->function, job->signature, nullptr, true);
+            continue;
+        }
+        // IDB writes stay on the main thread
+        if (job->layout->blocks.size() >= PERSIST_MIN_BLOCKS) {
+            AnalysisCache::write_keyed(CacheSection::FlowLayouts, job->function, job->signature,
+                                       serialize(*job->layout));
+        }
+        remember(job->function, job->signature, std::move(job->layout), true);
+    }
+}
+
+void FlowLayoutCache::remember(ea_t function, std::uint64_t signature,
+                               std::shared_ptr<const FlowLayout> layout, bool fresh) {
+    if (entries_.size() >= MAX_CACHED_LAYOUTS && entries_.find(function) == entries_.end()) {
+        auto oldest = std::min_element(entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+            return a.second.last_used < b.second.last_used;
+        });
+        entries_.erase(oldest);
+    }
+    Entry& entry = entries_[function];
+    entry.signature = signature;
+    entry.layout = std::move(layout);
+    entry.last_used = ++clock_;
+    entry.fresh = fresh;
+}
+
+void FlowLayoutCache::worker_loop(std::shared_ptr<WorkerState> state) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    for (;;) {
+        state->wake.wait(lock, [&] { return state->cancelled || state->queued; });
+        if (state->cancelled) return;
+
+        std::unique_ptr<Job> job = std::move(state->queued);
+        state->running = job->function;
+        lock.unlock();
+        lay_out(*job);
+        lock.lock();
+        state->running = BADADDR;
+        if (state->cancelled) return;
+        if (job->generation == state->generation) {
+            state->finished.push_back(std::move(job));
+        }
+    }
+}
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
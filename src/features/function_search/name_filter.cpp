@@ -0,0 +1,53 @@
+/// @file name_filter.cpp
+/// @brief Function name filter implementation
+
+#include <synopsia/features/function_search/name_filter.hpp>
+
+#include <cctype>
+#include <string>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+static char fold(char c) noexcept {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+bool contains_lowercase(std::string_view text, std::string_view needle_lower) noexcept {
+    if (needle_lower.empty()) return true;
+    if (needle_lower.size() > text.size()) return false;
+
+    // Names are folded on the fly instead of copied
+    const std::size_t last = text.size() - needle_lower.size();
+    for (std::size_t i = 0; i <= last; ++i) {
+        if (fold(text[i]) != needle_lower[0]) continue;
+        std::size_t k = 1;
+        while (k < needle_lower.size() && fold(text[i + k]) == needle_lower[k]) ++k;
+        if (k == needle_lower.size()) return true;
+    }
+    return false;
+}
+
+void filter_functions(const IFunctionDataSource& data, std::string_view filter, std::vector<std::size_t>& out) {
+    out.clear();
+    if (filter.empty()) return;
+
+    // Reused per thread, so long queries do not allocate on every keystroke
+    thread_local std::string filter_lower;
+    filter_lower.assign(filter);
+    for (char& c : filter_lower) {
+        c = fold(c);
+    }
+
+    const std::size_t count = data.function_count();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (contains_lowercase(data.function_name(i), filter_lower)) {
+            out.push_back(i);
+        }
+    }
+}
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,489 @@
+/// @file name_tree.cpp
+/// @brief Lazily built namespace/class tree implementation
+
+#include <synopsia/features/function_search/name_tree.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace synopsia {
+namespace features {
+namespace function_search {
+
+namespace {
+
+constexpr std::string_view OPERATOR_KEYWORD = "operator";
+
+[[nodiscard]] bool is_ident_char(char c) noexcept {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '$';
+}
+
+/// Characters that can follow "operator" as part of its symbol
+[[nodiscard]] bool is_operator_char(char c) noexcept {
+    return std::string_view("<>=!+-*/%^&|~[],").find(c) != std::string_view::npos;
+}
+
+/// Whether a bare "operator" keyword starts at i
+[[nodiscard]] bool is_operator_at(std::string_view name, std::size_t i) noexcept {
+    if (name.compare(i, OPERATOR_KEYWORD.size(), OPERATOR_KEYWORD) != 0) return false;
+    const std::size_t after = i + OPERATOR_KEYWORD.size();
+    return (i == 0 || !is_ident_char(name[i - 1])) && (after >= name.size() || !is_ident_char(name[after]));
+}
+
+/// Whether '(' right after this character opens a parameter list
+[[nodiscard]] bool ends_name(char c) noexcept {
+    return is_ident_char(c) || c == '>' || c == ']' || c == '\'';
+}
+
+} // anonymous namespace
+
+std::vector<std::string_view> split_qualified_name(std::string_view name, std::string_view* tail) {
+    const std::size_t n = name.size();
+    std::size_t begin = 0;
+    std::size_t end = n;
+    std::vector<std::size_t> separators;  // Depth-0 "::" inside [begin, end)
+    int depth = 0;
+
+    std::size_t i = 0;
+    while (i < n) {
+        // "operator<", "operator()" etc. would otherwise unbalance the brackets
+        if (depth == 0 && is_operator_at(name, i)) {
+            i += OPERATOR_KEYWORD.size();
+            while (i < n && name[i] == ' ') ++i;
+            if (name.compare(i, 2, "()") == 0) {
+                i += 2;
+            } else {
+                while (i < n && is_operator_char(name[i])) ++i;
+            }
+            if (i < n && name[i] == '(') {
+                end = i;
+                break;
+            }
+            continue;
+        }
+
+        const char c = name[i];
+        if (c == '(' && depth == 0 && i > begin && ends_name(name[i - 1])) {
+            end = i;
+            break;
+        }
+        if (c == '<' || c == '(' || c == '[' || c == '{' || c == '`') {
+            ++depth;
+        } else if ((c == '>' || c == ')' || c == ']' || c == '}' || c == '\'') && depth > 0) {
+            --depth;
+        } else if (depth == 0 && c == ' ') {
+            // Return type, calling convention, access specifier
+            begin = i + 1;
+            separators.clear();
+        } else if (depth == 0 && c == ':' && i + 1 < n && name[i + 1] == ':') {
+            separators.push_back(i);
+            ++i;
+        }
+        ++i;
+    }
+
+    std::vector<std::string_view> tokens;
+    std::size_t start = begin;
+    separators.push_back(end);
+    for (std::size_t sep : separators) {
+        if (sep > start) {
+            tokens.push_back(name.substr(start, sep - start));
+        }
+        start = sep + 2;
+    }
+    if (tokens.empty()) {
+        tokens.push_back(name);
+        end = n;
+    }
+    if (tail) {
+        *tail = name.substr(end);
+    }
+    return tokens;
+}
+
+// =============================================================================
+// NameTree
+// =============================================================================
+
+void NameTree::build() {
+    const std::size_t count = data_.function_count();
+    revision_ = data_.revision();
+
+    keys_.assign(count, {});
+    leaf_labels_.assign(count, {});
+    for (std::size_t f = 0; f < count; ++f) {
+        make_key(f);
+    }
+
+    order_.resize(count);
+    std::iota(order_.begin(), order_.end(), 0u);
+    std::sort(order_.begin(), order_.end(), [this](std::uint32_t a, std::uint32_t b) {
+        const int c = keys_[a].compare(keys_[b]);
+        return c < 0 || (c == 0 && a < b);
+    });
+
+    nodes_.clear();
+    free_.clear();
+    Node& root = nodes_.emplace_back();
+    root.end = static_cast<std::uint32_t>(count);
+    for (std::size_t f = 0; f < count; ++f) {
+        root.size += data_.function_size(f);
+    }
+    materialize(ROOT);
+    nodes_[ROOT].expanded = true;
+    rows_dirty_ = true;
+}
+
+bool NameTree::sync() {
+    if (is_built() && data_.revision() == revision_ && data_.function_count() == keys_.size()) {
+        return false;
+    }
+
+    // Each rename re-scans the expanded nodes on its paths; a large batch is cheaper to rebuild
+    std::vector<std::size_t> renamed;
+    if (!is_built() || data_.function_count() != keys_.size() || !data_.renamed_since(revision_, renamed) ||
+        renamed.size() > MAX_INCREMENTAL_RENAMES) {
+        rebuild();
+        return true;
+    }
+
+    std::sort(renamed.begin(), renamed.end());
+    renamed.erase(std::unique(renamed.begin(), renamed.end()), renamed.end());
+    for (std::size_t f : renamed) {
+        if (f < keys_.size()) {
+            rename(f);
+        }
+    }
+    revision_ = data_.revision();
+    rows_dirty_ = true;
+    return true;
+}
+
+void NameTree::rebuild() {
+    // Scopes expanded on screen are expanded again after the rebuild
+    std::vector<std::string> expanded;
+    if (is_built()) {
+        for (node_id id : rows()) {
+            if (nodes_[id].expanded) expanded.push_back(nodes_[id].key);
+        }
+    }
+    build();
+
+    for (const std::string& scope : expanded) {
+        const auto first = std::lower_bound(order_.begin(), order_.end(), scope,
+                                            [this](std::uint32_t f, const std::string& k) { return keys_[f] < k; });
+        if (first == order_.end()) continue;
+        const node_id id = descend(static_cast<std::uint32_t>(first - order_.begin()), scope.size());
+        if (id != ROOT && nodes_[id].key == scope) {
+            set_expanded(id, true);
+        }
+    }
+}
+
+NameTree::node_id NameTree::descend(std::uint32_t position, std::size_t max_key_length) {
+    node_id id = ROOT;
+    while (!nodes_[id].is_leaf() && nodes_[id].key.size() < max_key_length) {
+        set_expanded(id, true);
+        const auto& children = nodes_[id].children;
+        // Children cover consecutive ranges of the sorted order
+        auto it = std::upper_bound(children.begin(), children.end(), position,
+                                   [this](std::uint32_t p, node_id child) { return p < nodes_[child].begin; });
+        if (it == children.begin() || position >= nodes_[*(it - 1)].end) break;
+        id = *(it - 1);
+    }
+    return id;
+}
+
+const std::vector<NameTree::node_id>& NameTree::rows() {
+    if (!rows_dirty_) return rows_;
+    rows_dirty_ = false;
+    rows_.clear();
+    if (!is_built()) return rows_;
+
+    // Iterative DFS; children are pushed in reverse to keep their order
+    std::vector<node_id> stack(nodes_[ROOT].children.rbegin(), nodes_[ROOT].children.rend());
+    while (!stack.empty()) {
+        const node_id id = stack.back();
+        stack.pop_back();
+        rows_.push_back(id);
+        const Node& node = nodes_[id];
+        if (node.expanded) {
+            stack.insert(stack.end(), node.children.rbegin(), node.children.rend());
+        }
+    }
+    return rows_;
+}
+
+void NameTree::set_expanded(node_id id, bool expanded) {
+    if (id >= nodes_.size() || nodes_[id].is_leaf()) return;
+    if (expanded && !nodes_[id].materialized) {
+        materialize(id);
+    }
+    nodes_[id].expanded = expanded;
+    rows_dirty_ = true;
+}
+
+int NameTree::reveal(std::size_t function) {
+    if (!is_built() || function >= keys_.size()) return -1;
+
+    const node_id id = descend(position_of(function), std::string::npos);
+    if (nodes_[id].function != function) return -1;
+
+    const auto& visible = rows();
+    auto row = std::find(visible.begin(), visible.end(), id);
+    return row == visible.end() ? -1 : static_cast<int>(row - visible.begin());
+}
+
+void NameTree::make_key(std::size_t function) {
+    const FunctionInfo info = data_.get_function(function);
+    const std::string& display = info.demangled_name.empty() ? info.name : info.demangled_name;
+
+    std::string_view tail;
+    const auto tokens = split_qualified_name(display, &tail);
+
+    std::string& key = keys_[function];
+    key.clear();
+    for (std::string_view token : tokens) {
+        if (!key.empty()) key += KEY_SEPARATOR;
+        for (char c : token) {
+            // Control characters would break the separator ordering
+            key += static_cast<unsigned char>(c) < 0x20 ? '?' : c;
+        }
+    }
+    if (key.empty()) key = "?";
+
+    leaf_labels_[function].assign(tokens.back());
+    leaf_labels_[function].append(tail);
+}
+
+std::uint32_t NameTree::position_of(std::size_t function) const {
+    auto it = std::lower_bound(order_.begin(), order_.end(), static_cast<std::uint32_t>(function),
+                               [this](std::uint32_t a, std::uint32_t b) {
+                                   const int c = keys_[a].compare(keys_[b]);
+                                   return c < 0 || (c == 0 && a < b);
+                               });
+    return static_cast<std::uint32_t>(it - order_.begin());
+}
+
+void NameTree::materialize(node_id id) {
+    const std::size_t prefix = nodes_[id].key.size();
+    const std::size_t token_start = id == ROOT ? 0 : prefix + 1;
+    const std::uint32_t end = nodes_[id].end;
+    const std::uint32_t depth = nodes_[id].depth + 1;
+
+    // Previous children are in the same order as the new ones, so they are
+    // matched by a merge: same key (groups) or same function (leaves sharing
+    // the parent's key). Unmatched ones are released with their subtrees.
+    std::vector<node_id> previous = std::move(nodes_[id].children);
+    nodes_[id].children.clear();
+    std::size_t next = 0;
+    const auto reuse = [&](std::string_view key, std::size_t function) -> node_id {
+        while (next < previous.size()) {
+            const Node& old = nodes_[previous[next]];
+            int order = std::string_view(old.key).compare(key);
+            if (order == 0 && function != NO_FUNCTION) {
+                order = old.function < function ? -1 : (old.function > function ? 1 : 0);
+            }
+            if (order > 0) break;
+            const node_id found = previous[next++];
+            if (order == 0) return found;
+            release(found);
+        }
+        return ROOT;
+    };
+
+    std::vector<node_id> children;
+    const auto add_child = [&](node_id reused) -> Node& {
+        const node_id child = reused != ROOT ? reused : allocate();
+        children.push_back(child);
+        Node& node = nodes_[child];
+        node.depth = depth;
+        return node;
+    };
+
+    std::uint32_t pos = nodes_[id].begin;
+
+    // Functions whose path ends here: overloads, or a function named like a scope
+    while (pos < end && keys_[order_[pos]].size() == prefix && id != ROOT) {
+        const std::size_t f = order_[pos];
+        Node& leaf = add_child(reuse(nodes_[id].key, f));
+        leaf.label = leaf_labels_[f];
+        leaf.key = nodes_[id].key;
+        leaf.begin = pos;
+        leaf.end = pos + 1;
+        leaf.size = data_.function_size(f);
+        leaf.function = f;
+        ++pos;
+    }
+
+    // One child per distinct next token
+    while (pos < end) {
+        const std::string& key = keys_[order_[pos]];
+        std::size_t stop = key.find(KEY_SEPARATOR, token_start);
+        if (stop == std::string::npos) stop = key.size();
+        const std::string_view child_key(key.data(), stop);
+
+        std::uint32_t group_end = pos;
+        std::uint64_t size = 0;
+        while (group_end < end) {
+            const std::string& other = keys_[order_[group_end]];
+            if (other.compare(0, stop, child_key) != 0 || (other.size() > stop && other[stop] != KEY_SEPARATOR)) {
+                break;
+            }
+            size += data_.function_size(order_[group_end]);
+            ++group_end;
+        }
+
+        Node& child = add_child(reuse(child_key, NO_FUNCTION));
+        child.key.assign(child_key);
+        child.begin = pos;
+        child.end = group_end;
+        child.size = size;
+
+        const std::size_t first = order_[pos];
+        if (group_end - pos == 1 && keys_[first].size() == stop) {
+            // A single function: the node is its leaf
+            const std::vector<node_id> stale = std::move(child.children);
+            child.children.clear();
+            for (node_id grandchild : stale) release(grandchild);
+            child.materialized = false;
+            child.expanded = false;
+            child.function = first;
+            child.label = leaf_labels_[first];
+        } else {
+            child.function = NO_FUNCTION;
+            child.label.assign(key, token_start, stop - token_start);
+        }
+        pos = group_end;
+    }
+
+    // Children that no longer exist
+    while (next < previous.size()) {
+        release(previous[next++]);
+    }
+
+    nodes_[id].children = std::move(children);
+    nodes_[id].materialized = true;
+    rows_dirty_ = true;
+}
+
+void NameTree::rename(std::size_t function) {
+    const std::string old_key = keys_[function];
+    const std::uint32_t old_pos = position_of(function);
+    order_.erase(order_.begin() + old_pos);
+    make_key(function);
+    const std::uint32_t new_pos = position_of(function);
+    order_.insert(order_.begin() + new_pos, static_cast<std::uint32_t>(function));
+
+    const std::string& new_key = keys_[function];
+    const std::uint64_t size = data_.function_size(function);
+    const auto within = [](const std::string& key, const std::string& scope) {
+        return key.compare(0, scope.size(), scope) == 0 &&
+               (key.size() == scope.size() || key[scope.size()] == KEY_SEPARATOR);
+    };
+
+    // Every materialized range shifts by at most one entry; only nodes on the
+    // old or new path can change shape, and only those are re-scanned when
+    // a child appears, empties or turns between leaf and group
+    std::vector<node_id> stack{ROOT};
+    while (!stack.empty()) {
+        const node_id id = stack.back();
+        stack.pop_back();
+        if (!nodes_[id].materialized) continue;
+
+        const std::string& scope = nodes_[id].key;
+        const bool on_old = id == ROOT || within(old_key, scope);
+        const bool on_new = id == ROOT || within(new_key, scope);
+
+        if ((on_old && old_key.size() == scope.size()) || (on_new && new_key.size() == scope.size())) {
+            // The function ends here: the leaves sharing this key change
+            materialize(id);
+        } else {
+            shift_ranges(id, old_pos, new_pos, on_new ? &new_key : nullptr);
+            if (on_old || on_new) {
+                update_path_children(id, on_old ? &old_key : nullptr, on_new ? &new_key : nullptr, function, size);
+            }
+        }
+
+        for (node_id child : nodes_[id].children) {
+            if (nodes_[child].materialized) stack.push_back(child);
+        }
+    }
+}
+
+void NameTree::shift_ranges(node_id id, std::uint32_t old_pos, std::uint32_t new_pos, const std::string* new_key) {
+    const std::size_t scope = nodes_[id].key.size();
+    for (node_id child : nodes_[id].children) {
+        Node& node = nodes_[child];
+        // The entry left old_pos (whichever node held it) ...
+        node.begin -= node.begin > old_pos;
+        node.end -= node.end > old_pos;
+        // ... and lands at new_pos, inside the node on its new path
+        const bool holds = new_key && node.key.size() > scope &&
+                           new_key->compare(0, node.key.size(), node.key) == 0 &&
+                           (new_key->size() == node.key.size() || (*new_key)[node.key.size()] == KEY_SEPARATOR);
+        node.begin += holds ? node.begin > new_pos : node.begin >= new_pos;
+        node.end += holds ? node.end >= new_pos : node.end > new_pos;
+    }
+}
+
+void NameTree::update_path_children(node_id id, const std::string* old_key, const std::string* new_key,
+                                    std::size_t function, std::uint64_t size) {
+    const std::size_t token_start = id == ROOT ? 0 : nodes_[id].key.size() + 1;
+    const auto& children = nodes_[id].children;
+
+    const auto child_on = [&](const std::string& key) -> node_id {
+        const std::string_view child_key(key.data(), std::min(key.find(KEY_SEPARATOR, token_start), key.size()));
+        auto it = std::lower_bound(children.begin(), children.end(), child_key,
+                                   [this](node_id c, std::string_view k) { return nodes_[c].key < k; });
+        return (it != children.end() && nodes_[*it].key == child_key) ? *it : ROOT;
+    };
+    // Whether a child still matches what materialize() would produce
+    const auto consistent = [this](node_id child) {
+        if (child == ROOT) return false;
+        const Node& node = nodes_[child];
+        if (node.begin >= node.end) return false;  // Emptied
+        const bool leaf = node.count() == 1 && keys_[order_[node.begin]].size() == node.key.size();
+        return leaf == node.is_leaf() && (!leaf || node.function == order_[node.begin]);
+    };
+
+    const node_id old_child = old_key ? child_on(*old_key) : ROOT;
+    const node_id new_child = new_key ? child_on(*new_key) : ROOT;
+    if ((old_key && !consistent(old_child)) || (new_key && !consistent(new_child))) {
+        materialize(id);
+        return;
+    }
+
+    if (old_child != new_child) {
+        if (old_key) nodes_[old_child].size -= size;
+        if (new_key) nodes_[new_child].size += size;
+    }
+    if (new_key && nodes_[new_child].function == function) {
+        nodes_[new_child].label = leaf_labels_[function];
+    }
+}
+
+NameTree::node_id NameTree::allocate() {
+    if (!free_.empty()) {
+        const node_id id = free_.back();
+        free_.pop_back();
+        return id;
+    }
+    nodes_.emplace_back();
+    return static_cast<node_id>(nodes_.size() - 1);
+}
+
+void NameTree::release(node_id id) {
+    std::vector<node_id> stack{id};
+    while (!stack.empty()) {
+        const node_id current = stack.back();
+        stack.pop_back();
+        stack.insert(stack.end(), nodes_[current].children.begin(), nodes_[current].children.end());
+        nodes_[current] = Node{};
+        free_.push_back(current);
+    }
+}
+
+} // namespace function_search
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,185 @@
+/// @file feature.cpp
+/// @brief Omnibox feature implementation (ImGui/GPU accelerated)
+
+#include <synopsia/features/omnibox/feature.hpp>
+
+// Bridge functions for ImGui widget
+extern "C" {
+    void* synopsia_imgui_create_widget(
+        const char* ini_prefix,
+        void (*render_callback)(void* user_data),
+        void* user_data
+    );
+    void synopsia_imgui_destroy_widget(void* widget);
+    void synopsia_add_widget_to_layout(void* parent, void* child);
+}
+
+namespace synopsia {
+namespace features {
+
+// Forward declarations for imgui_widget.cpp functions
+namespace omnibox {
+    void init_omnibox_state();
+    void cleanup_omnibox_state();
+    void render_omnibox();
+}
+
+// Static instance pointer
+OmniboxFeature* OmniboxFeature::instance_ = nullptr;
+
+// Render callback thunk
+static void render_callback(void*) {
+    omnibox::render_omnibox();
+}
+
+OmniboxFeature::OmniboxFeature() {
+    instance_ = this;
+}
+
+OmniboxFeature::~OmniboxFeature() {
+    cleanup();
+    instance_ = nullptr;
+}
+
+bool OmniboxFeature::initialize() {
+    if (!register_actions()) {
+        return false;
+    }
+
+    initialized_ = true;
+
+    msg("Synopsia [%s]: Feature initialized (hotkey: %s)\n",
+        omnibox::FEATURE_NAME, omnibox::FEATURE_HOTKEY);
+
+    return true;
+}
+
+void OmniboxFeature::cleanup() {
+    if (!initialized_) return;
+
+    destroy_widget();
+    unregister_actions();
+    omnibox::cleanup_omnibox_state();
+    initialized_ = false;
+}
+
+bool OmniboxFeature::register_actions() {
+    static OmniboxAction action_handler;
+
+    const action_desc_t action_desc = ACTION_DESC_LITERAL(
+        omnibox::ACTION_NAME,
+        omnibox::ACTION_LABEL,
+        &action_handler,
+        omnibox::FEATURE_HOTKEY,
+        "Search names, strings, comments, imports and exports at once (ImGui/GPU)",
+        -1
+    );
+
+    if (!register_action(action_desc)) {
+        msg("Synopsia [%s]: Failed to register action\n", omnibox::FEATURE_NAME);
+        return false;
+    }
+
+    attach_action_to_menu("View/", omnibox::ACTION_NAME, SETMENU_APP);
+    return true;
+}
+
+void OmniboxFeature::unregister_actions() {
+    detach_action_from_menu("View/", omnibox::ACTION_NAME);
+    unregister_action(omnibox::ACTION_NAME);
+}
+
+void OmniboxFeature::show() {
+    if (visible_) return;
+
+    if (!is_database_loaded()) {
+        msg("Synopsia [%s]: No database loaded\n", omnibox::FEATURE_NAME);
+        return;
+    }
+
+    if (!create_widget()) {
+        msg("Synopsia [%s]: Failed to create widget\n", omnibox::FEATURE_NAME);
+        return;
+    }
+
+    visible_ = true;
+}
+
+void OmniboxFeature::hide() {
+    if (!visible_) return;
+    destroy_widget();
+    visible_ = false;
+}
+
+bool OmniboxFeature::create_widget() {
+#ifdef SYNOPSIA_USE_QT
+    // Initialize ImGui state (indexes are collected while the widget renders)
+    omnibox::init_omnibox_state();
+
+    // Create IDA widget container
+    widget_ = create_empty_widget(omnibox::WIDGET_TITLE);
+    if (!widget_) {
+        return false;
+    }
+
+    // Create ImGui OpenGL widget
+    content_ = synopsia_imgui_create_widget(
+        "synopsia_omnibox",
+        render_callback,
+        nullptr
+    );
+
+    if (!content_) {
+        close_widget(widget_, WCLS_DONT_SAVE_SIZE);
+        widget_ = nullptr;
+        return false;
+    }
+
+    // Add ImGui widget to IDA widget layout
+    synopsia_add_widget_to_layout(widget_, content_);
+
+    // Display as a tabbed window
+    display_widget(widget_, WOPN_DP_TAB | WOPN_PERSIST);
+
+    return true;
+#else
+    msg("Synopsia [%s]: Qt support not available\n", omnibox::FEATURE_NAME);
+    return false;
+#endif
+}
+
+void OmniboxFeature::destroy_widget() {
+#ifdef SYNOPSIA_USE_QT
+    if (content_) {
+        synopsia_imgui_destroy_widget(content_);
+        content_ = nullptr;
+    }
+    if (widget_) {
+        close_widget(widget_, WCLS_SAVE);
+        widget_ = nullptr;
+    }
+#endif
+}
+
+void OmniboxFeature::on_database_closed() {
+    destroy_widget();
+    visible_ = false;
+
+    // Indexes belong to the closed database
+    omnibox::cleanup_omnibox_state();
+}
+
+// Action handler implementation
+int OmniboxAction::activate(action_activation_ctx_t*) {
+    if (auto* feature = OmniboxFeature::instance()) {
+        feature->toggle();
+    }
+    return 1;
+}
+
+action_state_t OmniboxAction::update(action_update_ctx_t*) {
+    return AST_ENABLE_ALWAYS;
+}
+
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,221 @@
+/// @file imgui_widget.cpp
+/// @brief ImGui-based omnibox search widget (GPU accelerated)
+
+#include <synopsia/features/omnibox/providers.hpp>
+#include <synopsia/common/types.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace synopsia {
+namespace features {
+namespace omnibox {
+
+// =============================================================================
+// Omnibox State
+// =============================================================================
+
+class OmniboxState {
+public:
+    OmniboxState() : engine_(create_database_providers()) {}
+
+    void rebuild() {
+        engine_.rebuild();
+        collected_ = false;
+        engine_.submit(query_);
+    }
+
+    void render() {
+        // Index collection is time-sliced on the UI thread (IDA APIs are main-thread only)
+        if (!collected_) {
+            collected_ = engine_.pump(COLLECT_BUDGET);
+        }
+        if (engine_.poll(results_)) {
+            selected_ = std::clamp(selected_, 0, std::max(0, static_cast<int>(results_.size()) - 1));
+        }
+
+        ImGuiIO& io = ImGui::GetIO();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+
+        ImGuiWindowFlags window_flags =
+            ImGuiWindowFlags_NoTitleBar |
+            ImGuiWindowFlags_NoResize |
+            ImGuiWindowFlags_NoMove |
+            ImGuiWindowFlags_NoCollapse |
+            ImGuiWindowFlags_NoBringToFrontOnFocus;
+
+        ImGui::Begin("OmniboxWindow", nullptr, window_flags);
+
+        render_input();
+        render_status();
+        render_results();
+
+        ImGui::End();
+    }
+
+private:
+    static constexpr std::chrono::milliseconds COLLECT_BUDGET{6};
+
+    void render_input() {
+        if (focus_input_) {
+            ImGui::SetKeyboardFocusHere();
+            focus_input_ = false;
+        }
+
+        ImGui::SetNextItemWidth(-80.0f);
+        if (ImGui::InputTextWithHint("##omnibox-query", "names, strings, comments, imports, exports, segments...",
+                                     query_, sizeof(query_))) {
+            // Every keystroke cancels the query in flight
+            engine_.submit(query_);
+            selected_ = 0;
+            scroll_to_selected_ = true;
+        }
+        const bool input_active = ImGui::IsItemActive();
+
+        ImGui::SameLine();
+        if (ImGui::Button("Rebuild", ImVec2(-1, 0))) {
+            rebuild();
+        }
+
+        // Keyboard navigation while typing
+        if (input_active && !results_.empty()) {
+            const int last = static_cast<int>(results_.size()) - 1;
+            if (ImGui::IsKeyPressed(ImGuiKey_DownArrow)) {
+                selected_ = std::min(selected_ + 1, last);
+                scroll_to_selected_ = true;
+            }
+            if (ImGui::IsKeyPressed(ImGuiKey_UpArrow)) {
+                selected_ = std::max(selected_ - 1, 0);
+                scroll_to_selected_ = true;
+            }
+            if (ImGui::IsKeyPressed(ImGuiKey_PageDown)) {
+                selected_ = std::min(selected_ + 20, last);
+                scroll_to_selected_ = true;
+            }
+            if (ImGui::IsKeyPressed(ImGuiKey_PageUp)) {
+                selected_ = std::max(selected_ - 20, 0);
+                scroll_to_selected_ = true;
+            }
+            if (ImGui::IsKeyPressed(ImGuiKey_Enter) || ImGui::IsKeyPressed(ImGuiKey_KeypadEnter)) {
+                navigate(selected_);
+            }
+        }
+    }
+
+    void render_status() {
+        if (query_[0] != '\0') {
+            ImGui::Text("%zu results%s", results_.size(), engine_.is_searching() ? " (searching...)" : "");
+        } else {
+            ImGui::TextDisabled("Type to search");
+        }
+
+        // Per-provider index state
+        for (const auto& status : engine_.status()) {
+            ImGui::SameLine();
+            if (status.ready) {
+                ImGui::TextDisabled("| %s %zu", status.name, status.entries);
+            } else {
+                ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.3f, 1.0f), "| %s indexing %zu", status.name, status.entries);
+            }
+        }
+    }
+
+    void render_results() {
+        ImGuiTableFlags flags =
+            ImGuiTableFlags_ScrollY |
+            ImGuiTableFlags_RowBg |
+            ImGuiTableFlags_BordersInnerV |
+            ImGuiTableFlags_Resizable;
+
+        if (!ImGui::BeginTable("##omnibox-results", 3, flags)) return;
+
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Kind", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Address", ImGuiTableColumnFlags_WidthFixed, 140.0f);
+        ImGui::TableSetupColumn("Match", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+
+        // Virtualized: only visible rows are submitted
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(results_.size()));
+        if (scroll_to_selected_ && selected_ < static_cast<int>(results_.size())) {
+            clipper.IncludeItemByIndex(selected_);
+        }
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const SearchResult& result = results_[row];
+                const bool is_selected = row == selected_;
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::PushID(row);
+                if (ImGui::Selectable(search_kind_tag(result.kind), is_selected,
+                                      ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowDoubleClick)) {
+                    selected_ = row;
+                    if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
+                        navigate(row);
+                    }
+                }
+                ImGui::PopID();
+                if (is_selected && scroll_to_selected_) {
+                    ImGui::SetScrollHereY();
+                    scroll_to_selected_ = false;
+                }
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%llX", static_cast<unsigned long long>(result.address));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(result.text.c_str());
+            }
+        }
+        scroll_to_selected_ = false;
+
+        ImGui::EndTable();
+    }
+
+    void navigate(int row) {
+        if (row < 0 || row >= static_cast<int>(results_.size())) return;
+        const search_addr_t address = results_[row].address;
+        if (address != SEARCH_BADADDR) {
+            jumpto(static_cast<ea_t>(address));
+        }
+    }
+
+    SearchEngine engine_;
+    bool collected_ = false;
+
+    char query_[256] = {0};
+    std::vector<SearchResult> results_;
+    int selected_ = 0;
+    bool focus_input_ = true;
+    bool scroll_to_selected_ = false;
+};
+
+// =============================================================================
+// Global State and Bridge Functions
+// =============================================================================
+
+static std::unique_ptr<OmniboxState> g_state;
+
+void init_omnibox_state() {
+    if (!g_state) {
+        g_state = std::make_unique<OmniboxState>();
+    }
+}
+
+void cleanup_omnibox_state() {
+    g_state.reset();
+}
+
+void render_omnibox() {
+    if (g_state) {
+        g_state->render();
+    }
+}
+
+} // namespace omnibox
+} // namespace features
+} // namespace synopsia
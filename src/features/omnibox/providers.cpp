@@ -0,0 +1,346 @@
+/// @file providers.cpp
+/// @brief IDA database search providers
+
+#include <synopsia/features/omnibox/providers.hpp>
+#include <synopsia/common/types.hpp>
+#include <bytes.hpp>
+#include <entry.hpp>
+#include <funcs.hpp>
+#include <name.hpp>
+#include <nalt.hpp>
+#include <segment.hpp>
+#include <strlist.hpp>
+
+namespace synopsia {
+namespace features {
+namespace omnibox {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Longest text indexed per entry (long strings/comments are truncated)
+constexpr std::size_t MAX_ENTRY_TEXT = 256;
+
+/// Items added between deadline checks
+constexpr std::size_t DEADLINE_STRIDE = 256;
+
+void add_text(SearchIndexBuilder& out, ea_t ea, const qstring& text) {
+    std::string_view view(text.c_str(), text.length());
+    out.add(static_cast<search_addr_t>(ea), view.substr(0, MAX_ENTRY_TEXT));
+}
+
+// =============================================================================
+// ListProvider
+// =============================================================================
+
+/// Provider over a counted IDA list, collected in index order
+class ListProvider : public ISearchProvider {
+public:
+    void reset() override {
+        cursor_ = 0;
+        count_ = 0;
+        started_ = false;
+    }
+
+    bool collect(SearchIndexBuilder& out, Clock::time_point deadline) override {
+        if (!started_) {
+            count_ = begin();
+            started_ = true;
+        }
+        while (cursor_ < count_) {
+            add(out, cursor_++);
+            if (cursor_ % DEADLINE_STRIDE == 0 && Clock::now() >= deadline) {
+                break;
+            }
+        }
+        return cursor_ >= count_;
+    }
+
+protected:
+    /// Prepare a pass and return the number of items
+    virtual std::size_t begin() = 0;
+
+    /// Add entries for item i
+    virtual void add(SearchIndexBuilder& out, std::size_t i) = 0;
+
+private:
+    std::size_t cursor_ = 0;
+    std::size_t count_ = 0;
+    bool started_ = false;
+};
+
+// =============================================================================
+// Providers
+// =============================================================================
+
+class FunctionNameProvider : public ListProvider {
+public:
+    [[nodiscard]] SearchKind kind() const noexcept override { return SearchKind::Function; }
+    [[nodiscard]] const char* name() const noexcept override { return "Functions"; }
+
+protected:
+    std::size_t begin() override { return get_func_qty(); }
+
+    void add(SearchIndexBuilder& out, std::size_t i) override {
+        func_t* func = getn_func(i);
+        if (!func) return;
+        qstring name;
+        if (get_func_name(&name, func->start_ea) > 0) {
+            add_text(out, func->start_ea, name);
+        }
+    }
+};
+
+class DemangledNameProvider : public ListProvider {
+public:
+    [[nodiscard]] SearchKind kind() const noexcept override { return SearchKind::Demangled; }
+    [[nodiscard]] const char* name() const noexcept override { return "Demangled"; }
+
+protected:
+    std::size_t begin() override { return get_func_qty(); }
+
+    void add(SearchIndexBuilder& out, std::size_t i) override {
+        func_t* func = getn_func(i);
+        if (!func) return;
+        qstring demangled;
+        qstring name;
+        if (get_demangled_name(&demangled, func->start_ea, 0, 0) > 0 &&
+            (get_func_name(&name, func->start_ea) <= 0 || demangled != name)) {
+            add_text(out, func->start_ea, demangled);
+        }
+    }
+};
+
+class ExportProvider : public ListProvider {
+public:
+    [[nodiscard]] SearchKind kind() const noexcept override { return SearchKind::Export; }
+    [[nodiscard]] const char* name() const noexcept override { return "Exports"; }
+
+protected:
+    std::size_t begin() override { return get_entry_qty(); }
+
+    void add(SearchIndexBuilder& out, std::size_t i) override {
+        const uval_t ordinal = get_entry_ordinal(i);
+        const ea_t ea = get_entry(ordinal);
+        qstring name;
+        if (ea != BADADDR && get_entry_name(&name, ordinal) > 0) {
+            add_text(out, ea, name);
+        }
+    }
+};
+
+class ImportProvider : public ListProvider {
+public:
+    [[nodiscard]] SearchKind kind() const noexcept override { return SearchKind::Import; }
+    [[nodiscard]] const char* name() const noexcept override { return "Imports"; }
+
+protected:
+    std::size_t begin() override { return get_import_module_qty(); }
+
+    void add(SearchIndexBuilder& out, std::size_t i) override {
+        ImportContext ctx{&out, {}};
+        if (!get_import_module_name(&ctx.module, static_cast<int>(i))) {
+            ctx.module.clear();
+        }
+        enum_import_names(static_cast<int>(i), &ImportProvider::on_import, &ctx);
+    }
+
+private:
+    struct ImportContext {
+        SearchIndexBuilder* out;
+        qstring module;
+    };
+
+    /// "name (module)", or "#ordinal (module)" for ordinal-only imports
+    static int idaapi on_import(ea_t ea, const char* name, uval_t ordinal, void* param) {
+        auto* ctx = static_cast<ImportContext*>(param);
+        qstring text;
+        if (name && name[0] != '\0') {
+            text = name;
+        } else {
+            text.sprnt("#%llu", static_cast<unsigned long long>(ordinal));
+        }
+        if (!ctx->module.empty()) {
+            text.append(" (");
+            text.append(ctx->module);
+            text.append(")");
+        }
+        add_text(*ctx->out, ea, text);
+        return 1;
+    }
+};
+
+/// Named addresses that are not function starts (data and local labels)
+class LabelProvider : public ListProvider {
+public:
+    [[nodiscard]] SearchKind kind() const noexcept override { return SearchKind::Label; }
+    [[nodiscard]] const char* name() const noexcept override { return "Labels"; }
+
+protected:
+    std::size_t begin() override { return get_nlist_size(); }
+
+    void add(SearchIndexBuilder& out, std::size_t i) override {
+        const ea_t ea = get_nlist_ea(i);
+        const char* label = get_nlist_name(i);
+        if (ea == BADADDR || !label || label[0] == '\0') return;
+
+        func_t* func = get_func(ea);
+        if (func && func->start_ea == ea) return;  // Covered by FunctionNameProvider
+        out.add(static_cast<search_addr_t>(ea), std::string_view(label).substr(0, MAX_ENTRY_TEXT));
+    }
+};
+
+class SegmentProvider : public ListProvider {
+public:
+    [[nodiscard]] SearchKind kind() const noexcept override { return SearchKind::Segment; }
+    [[nodiscard]] const char* name() const noexcept override { return "Segments"; }
+
+protected:
+    std::size_t begin() override { return static_cast<std::size_t>(get_segm_qty()); }
+
+    void add(SearchIndexBuilder& out, std::size_t i) override {
+        segment_t* seg = getnseg(static_cast<int>(i));
+        qstring name;
+        if (seg && get_segm_name(&name, seg) > 0) {
+            add_text(out, seg->start_ea, name);
+        }
+    }
+};
+
+/// Strings from the Strings window list when it has been built; otherwise
+/// the string literals defined in the database, walked in time slices.
+/// build_strlist() scans every byte in one call, so it is never run here.
+class StringProvider : public ISearchProvider {
+public:
+    [[nodiscard]] SearchKind kind() const noexcept override { return SearchKind::String; }
+    [[nodiscard]] const char* name() const noexcept override { return "Strings"; }
+
+    void reset() override {
+        use_list_ = get_strlist_qty() > 0;
+        index_ = 0;
+        ea_ = inf_get_min_ea();
+    }
+
+    bool collect(SearchIndexBuilder& out, Clock::time_point deadline) override {
+        std::size_t steps = 0;
+
+        if (use_list_) {
+            const std::size_t count = get_strlist_qty();
+            while (index_ < count) {
+                string_info_t info;
+                if (get_strlist_item(&info, index_++)) {
+                    add_literal(out, info.ea, static_cast<std::size_t>(info.length), info.type);
+                }
+                if (++steps % DEADLINE_STRIDE == 0 && Clock::now() >= deadline) {
+                    return index_ >= count;
+                }
+            }
+            return true;
+        }
+
+        // Defined literals only; next_that skips everything else inside the kernel
+        const ea_t max_ea = inf_get_max_ea();
+        while (ea_ != BADADDR && ea_ < max_ea) {
+            if (is_strlit(get_flags(ea_))) {
+                add_literal(out, ea_, static_cast<std::size_t>(get_item_size(ea_)), get_str_type(ea_));
+            }
+            ea_ = next_that(ea_, max_ea, &StringProvider::is_literal);
+            if (++steps % DEADLINE_STRIDE == 0 && Clock::now() >= deadline) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static bool idaapi is_literal(flags64_t flags, void*) {
+        return is_strlit(flags);
+    }
+
+    static void add_literal(SearchIndexBuilder& out, ea_t ea, std::size_t length, int32 type) {
+        qstring text;
+        length = std::min(length, MAX_ENTRY_TEXT * 4);
+        if (get_strlit_contents(&text, ea, length, type) > 0) {
+            add_text(out, ea, text);
+        }
+    }
+
+    bool use_list_ = false;
+    std::size_t index_ = 0;
+    ea_t ea_ = BADADDR;
+};
+
+/// Regular and repeatable comments on items, then function comments
+class CommentProvider : public ISearchProvider {
+public:
+    [[nodiscard]] SearchKind kind() const noexcept override { return SearchKind::Comment; }
+    [[nodiscard]] const char* name() const noexcept override { return "Comments"; }
+
+    void reset() override {
+        ea_ = inf_get_min_ea();
+        function_ = 0;
+    }
+
+    bool collect(SearchIndexBuilder& out, Clock::time_point deadline) override {
+        const ea_t max_ea = inf_get_max_ea();
+        std::size_t steps = 0;
+
+        // Items flagged as commented; next_that skips the rest inside the kernel
+        while (ea_ != BADADDR && ea_ < max_ea) {
+            add_comments(out, ea_);
+            ea_ = next_that(ea_, max_ea, &CommentProvider::has_comment);
+            if (++steps % DEADLINE_STRIDE == 0 && Clock::now() >= deadline) {
+                return false;
+            }
+        }
+
+        const std::size_t count = get_func_qty();
+        while (function_ < count) {
+            func_t* func = getn_func(function_++);
+            if (func) {
+                qstring cmt;
+                if (get_func_cmt(&cmt, func, false) > 0) add_text(out, func->start_ea, cmt);
+                if (get_func_cmt(&cmt, func, true) > 0) add_text(out, func->start_ea, cmt);
+            }
+            if (++steps % DEADLINE_STRIDE == 0 && Clock::now() >= deadline) {
+                return function_ >= count;
+            }
+        }
+        return true;
+    }
+
+private:
+    static bool idaapi has_comment(flags64_t flags, void*) {
+        return has_cmt(flags);
+    }
+
+    static void add_comments(SearchIndexBuilder& out, ea_t ea) {
+        if (!has_cmt(get_flags(ea))) return;
+        qstring cmt;
+        if (get_cmt(&cmt, ea, false) > 0) add_text(out, ea, cmt);
+        if (get_cmt(&cmt, ea, true) > 0) add_text(out, ea, cmt);
+    }
+
+    ea_t ea_ = BADADDR;
+    std::size_t function_ = 0;
+};
+
+} // anonymous namespace
+
+std::vector<std::unique_ptr<ISearchProvider>> create_database_providers() {
+    std::vector<std::unique_ptr<ISearchProvider>> providers;
+    providers.push_back(std::make_unique<FunctionNameProvider>());
+    providers.push_back(std::make_unique<ExportProvider>());
+    providers.push_back(std::make_unique<ImportProvider>());
+    providers.push_back(std::make_unique<SegmentProvider>());
+    providers.push_back(std::make_unique<LabelProvider>());
+    providers.push_back(std::make_unique<DemangledNameProvider>());
+    providers.push_back(std::make_unique<StringProvider>());
+    providers.push_back(std::make_unique<CommentProvider>());
+    return providers;
+}
+
+} // namespace omnibox
+} // namespace features
+} // namespace synopsia
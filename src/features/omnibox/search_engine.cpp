@@ -0,0 +1,386 @@
+/// @file search_engine.cpp
+/// @brief Multi-provider search engine implementation
+
+#include <synopsia/features/omnibox/search_engine.hpp>
+#include <synopsia/common/parallel.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace synopsia {
+namespace features {
+namespace omnibox {
+
+namespace {
+
+/// Entries scanned between cancellation checks / partial publishes
+constexpr std::size_t QUERY_CHUNK = 16384;
+
+/// Bonus per kind, so e.g. a function name outranks an equal comment match
+constexpr std::int32_t KIND_WEIGHT[] = {
+    600,  // Function
+    550,  // Demangled
+    500,  // Export
+    450,  // Import
+    400,  // Label
+    350,  // Segment
+    200,  // String
+    100,  // Comment
+};
+
+[[nodiscard]] char fold_char(char c) noexcept {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+[[nodiscard]] bool is_word_char(char c) noexcept {
+    return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+}
+
+/// Rank of a folded entry for a folded needle (-1 if it does not match)
+[[nodiscard]] std::int32_t score_match(std::string_view text, std::string_view needle, SearchKind kind) noexcept {
+    const std::size_t pos = text.find(needle);
+    if (pos == std::string_view::npos) return -1;
+
+    std::int32_t score = 10000;
+    if (text.size() == needle.size()) {
+        score += 4000;
+    } else if (pos == 0) {
+        score += 2000;
+    } else if (!is_word_char(text[pos - 1])) {
+        score += 1000;
+    }
+    score -= static_cast<std::int32_t>(std::min<std::size_t>(pos, 500));
+    score -= static_cast<std::int32_t>(std::min<std::size_t>(text.size() - needle.size(), 1000) / 2);
+    score += KIND_WEIGHT[static_cast<std::size_t>(kind)];
+    return score;
+}
+
+} // anonymous namespace
+
+const char* search_kind_tag(SearchKind kind) noexcept {
+    switch (kind) {
+        case SearchKind::Function:  return "func";
+        case SearchKind::Demangled: return "demangled";
+        case SearchKind::Export:    return "export";
+        case SearchKind::Import:    return "import";
+        case SearchKind::Label:     return "label";
+        case SearchKind::Segment:   return "segment";
+        case SearchKind::String:    return "string";
+        case SearchKind::Comment:   return "comment";
+    }
+    return "?";
+}
+
+// =============================================================================
+// SearchIndexBuilder / SearchIndex
+// =============================================================================
+
+void SearchIndexBuilder::add(search_addr_t address, std::string_view text) {
+    if (text.empty()) return;
+    if (text_.size() + text.size() > std::numeric_limits<std::uint32_t>::max()) return;
+
+    addresses_.push_back(address);
+    text_.append(text);
+    offsets_.push_back(static_cast<std::uint32_t>(text_.size()));
+}
+
+void SearchIndexBuilder::clear() {
+    addresses_.clear();
+    offsets_.assign(1, 0);
+    text_.clear();
+}
+
+SearchIndex::SearchIndex(SearchIndexBuilder&& builder)
+    : addresses_(std::move(builder.addresses_)),
+      offsets_(std::move(builder.offsets_)),
+      text_(std::move(builder.text_)) {
+    builder.clear();
+
+    folded_.resize(text_.size());
+    std::transform(text_.begin(), text_.end(), folded_.begin(), fold_char);
+
+    masks_.resize(addresses_.size());
+    for (std::size_t i = 0; i < addresses_.size(); ++i) {
+        masks_[i] = mask_of(folded(i));
+    }
+}
+
+std::string_view SearchIndex::text(std::size_t i) const noexcept {
+    return std::string_view(text_).substr(offsets_[i], offsets_[i + 1] - offsets_[i]);
+}
+
+std::string_view SearchIndex::folded(std::size_t i) const noexcept {
+    return std::string_view(folded_).substr(offsets_[i], offsets_[i + 1] - offsets_[i]);
+}
+
+std::uint64_t SearchIndex::mask_of(std::string_view folded) noexcept {
+    std::uint64_t mask = 0;
+    for (char ch : folded) {
+        const auto c = static_cast<unsigned char>(ch);
+        unsigned bit;
+        if (c >= 'a' && c <= 'z') {
+            bit = c - 'a';
+        } else if (c >= '0' && c <= '9') {
+            bit = 26 + (c - '0');
+        } else {
+            bit = 36 + (c % 28);
+        }
+        mask |= std::uint64_t{1} << bit;
+    }
+    return mask;
+}
+
+// =============================================================================
+// SearchEngine
+// =============================================================================
+
+SearchEngine::SearchEngine(std::vector<std::unique_ptr<ISearchProvider>> providers, std::size_t top_k)
+    : top_k_(std::max<std::size_t>(top_k, 1)) {
+    slots_.resize(providers.size());
+    for (std::size_t i = 0; i < providers.size(); ++i) {
+        slots_[i].provider = std::move(providers[i]);
+        slots_[i].provider->reset();
+    }
+
+    // Leave a core for the UI thread
+    const std::size_t threads = std::clamp<std::size_t>(worker_count() - 1, 1, std::max<std::size_t>(slots_.size(), 1));
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back(&SearchEngine::worker_loop, this);
+    }
+}
+
+SearchEngine::~SearchEngine() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+        tasks_.clear();
+    }
+    generation_.fetch_add(1);  // Cancel queries in flight
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void SearchEngine::rebuild() {
+    std::lock_guard lock(mutex_);
+    ++epoch_;
+    // Queries in flight hold the old index; their results must not land
+    const std::uint64_t generation = generation_.fetch_add(1) + 1;
+    for (auto& slot : slots_) {
+        slot.provider->reset();
+        slot.pending.clear();
+        slot.collected = false;
+        slot.index.reset();
+        slot.results.clear();
+        slot.results_generation = generation;
+        slot.results_done = true;
+    }
+    tasks_.clear();
+    ++version_;
+}
+
+bool SearchEngine::pump(std::chrono::milliseconds budget) {
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+
+    bool all_collected = true;
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        Slot& slot = slots_[i];
+        if (slot.collected) continue;
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            all_collected = false;
+            break;
+        }
+
+        if (!slot.provider->collect(slot.pending, deadline)) {
+            all_collected = false;
+            break;
+        }
+
+        // Hand the collected entries to a worker for indexing
+        slot.collected = true;
+        auto entries = std::make_shared<SearchIndexBuilder>(std::move(slot.pending));
+        slot.pending.clear();
+
+        std::lock_guard lock(mutex_);
+        enqueue({Task::Type::Index, i, epoch_, std::move(entries)});
+    }
+    return all_collected;
+}
+
+void SearchEngine::submit(std::string_view query) {
+    std::lock_guard lock(mutex_);
+
+    query_.resize(query.size());
+    std::transform(query.begin(), query.end(), query_.begin(), fold_char);
+    const std::uint64_t generation = generation_.fetch_add(1) + 1;
+
+    // Queued queries for older generations are dead weight
+    tasks_.erase(std::remove_if(tasks_.begin(), tasks_.end(),
+                                [](const Task& t) { return t.type == Task::Type::Query; }),
+                 tasks_.end());
+
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        Slot& slot = slots_[i];
+        slot.results.clear();
+        slot.results_generation = generation;
+        slot.results_done = query_.empty() || !slot.index;
+        if (!slot.results_done) {
+            enqueue({Task::Type::Query, i, generation, nullptr});
+        }
+    }
+    ++version_;
+}
+
+bool SearchEngine::poll(std::vector<SearchResult>& out) {
+    std::lock_guard lock(mutex_);
+    if (version_ == polled_version_) return false;
+    polled_version_ = version_;
+
+    const std::uint64_t generation = generation_.load();
+    out.clear();
+    for (const auto& slot : slots_) {
+        if (slot.results_generation == generation) {
+            out.insert(out.end(), slot.results.begin(), slot.results.end());
+        }
+    }
+    std::sort(out.begin(), out.end(), [](const SearchResult& a, const SearchResult& b) {
+        if (a.score != b.score) return a.score > b.score;
+        if (a.kind != b.kind) return a.kind < b.kind;
+        return a.address < b.address;
+    });
+    return true;
+}
+
+bool SearchEngine::is_searching() const {
+    std::lock_guard lock(mutex_);
+    return std::any_of(slots_.begin(), slots_.end(), [](const Slot& slot) { return !slot.results_done; });
+}
+
+std::vector<SearchEngine::ProviderStatus> SearchEngine::status() const {
+    std::lock_guard lock(mutex_);
+    std::vector<ProviderStatus> out;
+    out.reserve(slots_.size());
+    for (const auto& slot : slots_) {
+        out.push_back({
+            slot.provider->name(),
+            slot.index ? slot.index->size() : slot.pending.size(),
+            slot.index != nullptr
+        });
+    }
+    return out;
+}
+
+void SearchEngine::enqueue(Task task) {
+    tasks_.push_back(std::move(task));
+    wake_.notify_one();
+}
+
+void SearchEngine::worker_loop() {
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (stopping_) return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        if (task.type == Task::Type::Index) {
+            run_index(task);
+        } else {
+            run_query(task);
+        }
+    }
+}
+
+void SearchEngine::run_index(const Task& task) {
+    auto index = std::make_shared<const SearchIndex>(std::move(*task.entries));
+
+    std::lock_guard lock(mutex_);
+    if (task.generation != epoch_) return;
+
+    Slot& slot = slots_[task.provider];
+    slot.index = std::move(index);
+    ++version_;
+
+    // Catch the new index up with the query already on screen
+    if (!query_.empty()) {
+        slot.results.clear();
+        slot.results_generation = generation_.load();
+        slot.results_done = false;
+        enqueue({Task::Type::Query, task.provider, slot.results_generation, nullptr});
+    }
+}
+
+void SearchEngine::run_query(const Task& task) {
+    std::shared_ptr<const SearchIndex> index;
+    std::string needle;
+    {
+        std::lock_guard lock(mutex_);
+        if (task.generation != generation_.load()) return;
+        index = slots_[task.provider].index;
+        needle = query_;
+    }
+    const SearchKind kind = slots_[task.provider].provider->kind();
+
+    // Min-heap of (score, entry) holding the provider's current top-K
+    using Scored = std::pair<std::int32_t, std::uint32_t>;
+    std::vector<Scored> heap;
+    heap.reserve(top_k_ + 1);
+    const auto worse = [](const Scored& a, const Scored& b) { return a.first > b.first; };
+    bool changed = false;
+
+    const auto publish = [&](bool done) {
+        std::vector<Scored> ranked = heap;
+        std::sort(ranked.begin(), ranked.end(), worse);
+
+        std::vector<SearchResult> results;
+        results.reserve(ranked.size());
+        for (const auto& [score, entry] : ranked) {
+            results.push_back({kind, index->address(entry), std::string(index->text(entry)), score});
+        }
+
+        std::lock_guard lock(mutex_);
+        if (task.generation != generation_.load()) return;
+        Slot& slot = slots_[task.provider];
+        slot.results = std::move(results);
+        slot.results_done = done;
+        ++version_;
+    };
+
+    const std::uint64_t needle_mask = SearchIndex::mask_of(needle);
+    const std::size_t count = index ? index->size() : 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % QUERY_CHUNK == 0 && i != 0) {
+            if (generation_.load(std::memory_order_relaxed) != task.generation) return;
+            if (changed) {
+                publish(false);
+                changed = false;
+            }
+        }
+
+        if ((index->mask(i) & needle_mask) != needle_mask) continue;
+        const std::int32_t score = score_match(index->folded(i), needle, kind);
+        if (score < 0) continue;
+
+        if (heap.size() < top_k_) {
+            heap.emplace_back(score, static_cast<std::uint32_t>(i));
+            std::push_heap(heap.begin(), heap.end(), worse);
+            changed = true;
+        } else if (score > heap.front().first) {
+            std::pop_heap(heap.begin(), heap.end(), worse);
+            heap.back() = {score, static_cast<std::uint32_t>(i)};
+            std::push_heap(heap.begin(), heap.end(), worse);
+            changed = true;
+        }
+    }
+    publish(true);
+}
+
+} // namespace omnibox
+} // namespace features
+} // namespace synopsia
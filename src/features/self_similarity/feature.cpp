@@ -0,0 +1,185 @@
+/// @file feature.cpp
+/// @brief Self-similarity feature implementation (ImGui/GPU accelerated)
+
+#include <synopsia/features/self_similarity/feature.hpp>
+
+// Bridge functions for ImGui widget
+extern "C" {
+    void* synopsia_imgui_create_widget(
+        const char* ini_prefix,
+        void (*render_callback)(void* user_data),
+        void* user_data
+    );
+    void synopsia_imgui_destroy_widget(void* widget);
+    void synopsia_add_widget_to_layout(void* parent, void* child);
+}
+
+namespace synopsia {
+namespace features {
+
+// Forward declarations for imgui_widget.cpp functions
+namespace self_similarity {
+    void init_self_similarity_state();
+    void cleanup_self_similarity_state();
+    void render_self_similarity();
+}
+
+// Static instance pointer
+SelfSimilarityFeature* SelfSimilarityFeature::instance_ = nullptr;
+
+// Render callback thunk
+static void render_callback(void*) {
+    self_similarity::render_self_similarity();
+}
+
+SelfSimilarityFeature::SelfSimilarityFeature() {
+    instance_ = this;
+}
+
+SelfSimilarityFeature::~SelfSimilarityFeature() {
+    cleanup();
+    instance_ = nullptr;
+}
+
+bool SelfSimilarityFeature::initialize() {
+    if (!register_actions()) {
+        return false;
+    }
+
+    initialized_ = true;
+
+    msg("Synopsia [%s]: Feature initialized (hotkey: %s)\n",
+        self_similarity::FEATURE_NAME, self_similarity::FEATURE_HOTKEY);
+
+    return true;
+}
+
+void SelfSimilarityFeature::cleanup() {
+    if (!initialized_) return;
+
+    destroy_widget();
+    unregister_actions();
+    self_similarity::cleanup_self_similarity_state();
+    initialized_ = false;
+}
+
+bool SelfSimilarityFeature::register_actions() {
+    static SelfSimilarityAction action_handler;
+
+    const action_desc_t action_desc = ACTION_DESC_LITERAL(
+        self_similarity::ACTION_NAME,
+        self_similarity::ACTION_LABEL,
+        &action_handler,
+        self_similarity::FEATURE_HOTKEY,
+        "Dot-plot of duplicated code, repeated tables and unrolled data (ImGui/GPU)",
+        -1
+    );
+
+    if (!register_action(action_desc)) {
+        msg("Synopsia [%s]: Failed to register action\n", self_similarity::FEATURE_NAME);
+        return false;
+    }
+
+    attach_action_to_menu("View/", self_similarity::ACTION_NAME, SETMENU_APP);
+    return true;
+}
+
+void SelfSimilarityFeature::unregister_actions() {
+    detach_action_from_menu("View/", self_similarity::ACTION_NAME);
+    unregister_action(self_similarity::ACTION_NAME);
+}
+
+void SelfSimilarityFeature::show() {
+    if (visible_) return;
+
+    if (!is_database_loaded()) {
+        msg("Synopsia [%s]: No database loaded\n", self_similarity::FEATURE_NAME);
+        return;
+    }
+
+    if (!create_widget()) {
+        msg("Synopsia [%s]: Failed to create widget\n", self_similarity::FEATURE_NAME);
+        return;
+    }
+
+    visible_ = true;
+}
+
+void SelfSimilarityFeature::hide() {
+    if (!visible_) return;
+    destroy_widget();
+    visible_ = false;
+}
+
+bool SelfSimilarityFeature::create_widget() {
+#ifdef SYNOPSIA_USE_QT
+    // Initialize ImGui state (the database is sketched while the widget renders)
+    self_similarity::init_self_similarity_state();
+
+    // Create IDA widget container
+    widget_ = create_empty_widget(self_similarity::WIDGET_TITLE);
+    if (!widget_) {
+        return false;
+    }
+
+    // Create ImGui OpenGL widget
+    content_ = synopsia_imgui_create_widget(
+        "synopsia_self_similarity",
+        render_callback,
+        nullptr
+    );
+
+    if (!content_) {
+        close_widget(widget_, WCLS_DONT_SAVE_SIZE);
+        widget_ = nullptr;
+        return false;
+    }
+
+    // Add ImGui widget to IDA widget layout
+    synopsia_add_widget_to_layout(widget_, content_);
+
+    // Display as a tabbed window
+    display_widget(widget_, WOPN_DP_TAB | WOPN_PERSIST);
+
+    return true;
+#else
+    msg("Synopsia [%s]: Qt support not available\n", self_similarity::FEATURE_NAME);
+    return false;
+#endif
+}
+
+void SelfSimilarityFeature::destroy_widget() {
+#ifdef SYNOPSIA_USE_QT
+    if (content_) {
+        synopsia_imgui_destroy_widget(content_);
+        content_ = nullptr;
+    }
+    if (widget_) {
+        close_widget(widget_, WCLS_SAVE);
+        widget_ = nullptr;
+    }
+#endif
+}
+
+void SelfSimilarityFeature::on_database_closed() {
+    destroy_widget();
+    visible_ = false;
+
+    // Sketches belong to the closed database
+    self_similarity::cleanup_self_similarity_state();
+}
+
+// Action handler implementation
+int SelfSimilarityAction::activate(action_activation_ctx_t*) {
+    if (auto* feature = SelfSimilarityFeature::instance()) {
+        feature->toggle();
+    }
+    return 1;
+}
+
+action_state_t SelfSimilarityAction::update(action_update_ctx_t*) {
+    return AST_ENABLE_ALWAYS;
+}
+
+} // namespace features
+} // namespace synopsia
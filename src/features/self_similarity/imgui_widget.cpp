@@ -0,0 +1,268 @@
+/// @file imgui_widget.cpp
+/// @brief ImGui-based self-similarity dot-plot (GPU accelerated)
+
+#include <synopsia/features/self_similarity/similarity_data.hpp>
+#include <synopsia/common/types.hpp>
+#include <synopsia/color.hpp>
+#include <synopsia/imgui/qt_imgui_widget.hpp>
+#include <funcs.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace synopsia {
+namespace features {
+namespace self_similarity {
+
+// =============================================================================
+// Self-Similarity State
+// =============================================================================
+
+class SelfSimilarityState {
+public:
+    SelfSimilarityState() : plot_(ColorGradient::create_fire()) {
+        data_.begin_refresh();
+    }
+
+    void render() {
+        // Bytes are read on the UI thread (IDA APIs are main-thread only), a few windows per frame
+        if (!data_.is_complete() && data_.build_step(BUILD_BUDGET)) {
+            reset_window();
+        }
+
+        ImGuiIO& io = ImGui::GetIO();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+
+        ImGuiWindowFlags window_flags =
+            ImGuiWindowFlags_NoTitleBar |
+            ImGuiWindowFlags_NoResize |
+            ImGuiWindowFlags_NoMove |
+            ImGuiWindowFlags_NoCollapse |
+            ImGuiWindowFlags_NoBringToFrontOnFocus;
+
+        ImGui::Begin("SelfSimilarityWindow", nullptr, window_flags);
+
+        if (data_.is_complete()) {
+            render_controls();
+        }
+        // Rebuild in the controls drops the pyramid
+        if (data_.is_complete()) {
+            render_plot();
+        } else {
+            ImGui::TextUnformatted("Sketching blocks...");
+            ImGui::ProgressBar(data_.build_progress(), ImVec2(-1, 0));
+        }
+
+        ImGui::End();
+    }
+
+    /// The texture belongs to the widget; a new widget needs a new upload
+    void invalidate() {
+        texture_ = ImTextureID{};
+        dirty_ = true;
+    }
+
+private:
+    static constexpr std::chrono::milliseconds BUILD_BUDGET{12};
+
+    /// Smallest visible range, in bytes per pixel
+    static constexpr data_size_t MIN_BYTES_PER_PIXEL = 4;
+
+    void reset_window() {
+        const data_size_t total = data_.pyramid().total_bytes();
+        window_ = {0, total, 0, total};
+        dirty_ = true;
+    }
+
+    void render_controls() {
+        if (ImGui::Button("Reset")) {
+            reset_window();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Rebuild")) {
+            // Sketch the database again (patched bytes, new segments)
+            plotted_ = {};
+            data_.begin_refresh();
+            dirty_ = true;
+            return;
+        }
+        ImGui::SameLine();
+        bool skip_uniform = plot_.skip_uniform();
+        if (ImGui::Checkbox("Hide padding", &skip_uniform)) {
+            plot_.set_skip_uniform(skip_uniform);
+            dirty_ = true;
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Skip blocks of a single repeated byte");
+        }
+
+        const SketchPyramid& pyramid = data_.pyramid();
+        const DotPlot::Stats& stats = plot_.stats();
+        ImGui::SameLine();
+        ImGui::TextDisabled("| X %llX-%llX  Y %llX-%llX",
+                            static_cast<unsigned long long>(pyramid.address_at(window_.x_start)),
+                            static_cast<unsigned long long>(pyramid.address_at(window_.x_end - 1)),
+                            static_cast<unsigned long long>(pyramid.address_at(window_.y_start)),
+                            static_cast<unsigned long long>(pyramid.address_at(window_.y_end - 1)));
+        ImGui::SameLine();
+        ImGui::TextDisabled("| %zu blocks of %llu B, %zu buckets, %llu pairs, %.1f ms",
+                            stats.blocks, static_cast<unsigned long long>(data_.plotted_block_size()),
+                            stats.buckets, static_cast<unsigned long long>(stats.pairs), stats.milliseconds);
+    }
+
+    void render_plot() {
+        const ImVec2 avail = ImGui::GetContentRegionAvail();
+        const int edge = std::max(1, static_cast<int>(std::min(avail.x, avail.y)));
+        if (edge != edge_) {
+            edge_ = edge;
+            dirty_ = true;
+        }
+
+        if (dirty_ || detail_pending_) {
+            // Deep zoom sketches a slice per frame; the base level is drawn once meanwhile
+            const std::span<const BlockSketch> blocks = data_.blocks_for(window_, edge_, edge_, BUILD_BUDGET);
+            const bool finished = detail_pending_ && !data_.detail_pending();
+            detail_pending_ = data_.detail_pending();
+            if (dirty_ || finished) {
+                pixels_.assign(static_cast<std::size_t>(edge_) * static_cast<std::size_t>(edge_),
+                               colors::Background.to_argb());
+                plot_.rasterize(blocks, window_, edge_, edge_, pixels_.data(), static_cast<std::size_t>(edge_));
+                texture_ = imgui::upload_image(0, pixels_.data(), edge_, edge_);
+                plotted_ = blocks;
+            }
+            dirty_ = false;
+        }
+
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        const ImVec2 size(static_cast<float>(edge_), static_cast<float>(edge_));
+        if (texture_) {
+            ImGui::Image(texture_, size);
+        } else {
+            ImGui::Dummy(size);
+        }
+        handle_input(origin);
+    }
+
+    void handle_input(const ImVec2& origin) {
+        if (!ImGui::IsItemHovered()) return;
+
+        const ImGuiIO& io = ImGui::GetIO();
+        const double fx = std::clamp((io.MousePos.x - origin.x) / static_cast<double>(edge_), 0.0, 1.0);
+        const double fy = std::clamp((io.MousePos.y - origin.y) / static_cast<double>(edge_), 0.0, 1.0);
+        const data_size_t x_pos = window_.x_start + static_cast<data_size_t>(fx * static_cast<double>(window_.x_range()));
+        const data_size_t y_pos = window_.y_start + static_cast<data_size_t>(fy * static_cast<double>(window_.y_range()));
+
+        if (io.MouseWheel != 0.0f) {
+            zoom(io.MouseWheel > 0 ? 0.8 : 1.25, fx, fy);
+        }
+        if (ImGui::IsMouseDragging(ImGuiMouseButton_Left) && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f)) {
+            pan(-io.MouseDelta.x / edge_, -io.MouseDelta.y / edge_);
+        }
+
+        // Double-click jumps to the column's block, right-click to the row's
+        const SketchPyramid& pyramid = data_.pyramid();
+        const data_addr_t x_addr = pyramid.address_at(x_pos);
+        const data_addr_t y_addr = pyramid.address_at(y_pos);
+        if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) && x_addr != DATA_BADADDR) {
+            jumpto(static_cast<ea_t>(x_addr));
+        }
+        if (ImGui::IsMouseClicked(ImGuiMouseButton_Right) && y_addr != DATA_BADADDR) {
+            jumpto(static_cast<ea_t>(y_addr));
+        }
+
+        ImGui::BeginTooltip();
+        render_address("X", x_addr);
+        render_address("Y", y_addr);
+        const int bands = plot_.bands_at(static_cast<int>(io.MousePos.x - origin.x),
+                                         static_cast<int>(io.MousePos.y - origin.y));
+        const BlockSketch* x_block = sketch_at(plotted_, x_pos);
+        const BlockSketch* y_block = sketch_at(plotted_, y_pos);
+        if (x_block && y_block) {
+            ImGui::Text("Similarity: %.0f%% (%d/%zu bands)", x_block->similarity(*y_block) * 100.0,
+                        bands, DOT_PLOT_BANDS);
+        }
+        ImGui::EndTooltip();
+    }
+
+    static void render_address(const char* axis, data_addr_t addr) {
+        if (addr == DATA_BADADDR) return;
+        qstring name;
+        if (get_func_name(&name, static_cast<ea_t>(addr)) > 0) {
+            ImGui::Text("%s: %llX  %s", axis, static_cast<unsigned long long>(addr), name.c_str());
+        } else {
+            ImGui::Text("%s: %llX", axis, static_cast<unsigned long long>(addr));
+        }
+    }
+
+    /// Scale both ranges by factor, keeping the point under the cursor in place
+    void zoom(double factor, double fx, double fy) {
+        const data_size_t total = data_.pyramid().total_bytes();
+        const data_size_t min_range = std::min(total, MIN_BYTES_PER_PIXEL * static_cast<data_size_t>(edge_));
+        auto scale = [&](data_size_t& start, data_size_t& end, double f) {
+            const double range = static_cast<double>(end - start);
+            const data_size_t next = std::clamp(static_cast<data_size_t>(range * factor), min_range, total);
+            const double anchor = static_cast<double>(start) + f * range;
+            const double lo = std::clamp(anchor - f * static_cast<double>(next), 0.0, static_cast<double>(total - next));
+            start = static_cast<data_size_t>(lo);
+            end = start + next;
+        };
+        scale(window_.x_start, window_.x_end, fx);
+        scale(window_.y_start, window_.y_end, fy);
+        dirty_ = true;
+    }
+
+    /// Move the window by fractions of its size
+    void pan(double dx, double dy) {
+        const data_size_t total = data_.pyramid().total_bytes();
+        auto shift = [&](data_size_t& start, data_size_t& end, double d) {
+            const data_size_t range = end - start;
+            const double moved = static_cast<double>(start) + d * static_cast<double>(range);
+            start = static_cast<data_size_t>(std::clamp(moved, 0.0, static_cast<double>(total - range)));
+            end = start + range;
+        };
+        shift(window_.x_start, window_.x_end, dx);
+        shift(window_.y_start, window_.y_end, dy);
+        dirty_ = true;
+    }
+
+    SimilarityData data_;
+    DotPlot plot_;
+    DotPlotWindow window_;
+    std::span<const BlockSketch> plotted_;  // Blocks of the last raster (pyramid level or detail)
+    std::vector<std::uint32_t> pixels_;
+    ImTextureID texture_{};
+    int edge_ = 0;
+    bool dirty_ = true;
+    bool detail_pending_ = false;  // Plotting the base level while the detail is sketched
+};
+
+// =============================================================================
+// Global State and Bridge Functions
+// =============================================================================
+
+static std::unique_ptr<SelfSimilarityState> g_state;
+
+void init_self_similarity_state() {
+    if (!g_state) {
+        g_state = std::make_unique<SelfSimilarityState>();
+    } else {
+        g_state->invalidate();
+    }
+}
+
+void cleanup_self_similarity_state() {
+    g_state.reset();
+}
+
+void render_self_similarity() {
+    if (g_state) {
+        g_state->render();
+    }
+}
+
+} // namespace self_similarity
+} // namespace features
+} // namespace synopsia
@@ -0,0 +1,220 @@
+/// @file similarity_data.cpp
+/// @brief Block sketches of the database for the self-similarity plot
+
+#include <synopsia/features/self_similarity/similarity_data.hpp>
+#include <synopsia/common/parallel.hpp>
+
+#include <bit>
+
+namespace synopsia {
+namespace features {
+namespace self_similarity {
+
+namespace {
+
+/// Bytes read per get_bytes call (a multiple of every block size)
+constexpr std::size_t READ_WINDOW = 4 * 1024 * 1024;
+
+/// Finer blocks hash too few shingles to compare reliably
+constexpr std::size_t MIN_DETAIL_BLOCK = 256;
+
+} // anonymous namespace
+
+bool SimilarityData::begin_refresh() {
+    clear();
+
+    auto state = std::make_unique<BuildState>();
+    for (int i = 0; i < get_segm_qty(); ++i) {
+        segment_t* seg = getnseg(i);
+        if (!seg || (seg->perm & SEGPERM_READ) == 0 || seg->end_ea <= seg->start_ea) continue;
+        state->segments.emplace_back(seg->start_ea, seg->end_ea);
+        state->total += seg->end_ea - seg->start_ea;
+    }
+    if (state->segments.empty()) {
+        return false;
+    }
+
+    state->block_size = dot_plot_block_size(state->total);
+    state->next = state->segments.front().first;
+    state->base.reserve(static_cast<std::size_t>(state->total / state->block_size) + state->segments.size());
+    build_ = std::move(state);
+    return true;
+}
+
+bool SimilarityData::build_step(std::chrono::milliseconds budget) {
+    if (!build_) return !pyramid_.empty();
+
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    BuildState& state = *build_;
+    while (state.segment < state.segments.size()) {
+        const ea_t seg_end = state.segments[state.segment].second;
+        const std::size_t size = static_cast<std::size_t>(std::min<ea_t>(READ_WINDOW, seg_end - state.next));
+        sketch_window(state.next, size, state.block_size, state.position, state.base);
+        state.next += size;
+        state.position += size;
+
+        // Blocks restart at each segment, so none straddles a gap
+        if (state.next >= seg_end && ++state.segment < state.segments.size()) {
+            state.next = state.segments[state.segment].first;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+    }
+
+    pyramid_.build(std::move(state.base), state.block_size);
+    msg("Synopsia [Self-Similarity]: Sketched %llu bytes in %zu blocks of %zu bytes\n",
+        static_cast<unsigned long long>(state.total), pyramid_.level(0).size(), state.block_size);
+    build_.reset();
+    return true;
+}
+
+float SimilarityData::build_progress() const {
+    if (!build_) return pyramid_.empty() ? 0.0f : 1.0f;
+    return build_->total ? static_cast<float>(static_cast<double>(build_->position) / build_->total) : 1.0f;
+}
+
+std::span<const BlockSketch> SimilarityData::blocks_for(const DotPlotWindow& window, int width, int height,
+                                                        std::chrono::milliseconds budget) {
+    if (pyramid_.empty() || width <= 0 || height <= 0) return {};
+
+    const data_size_t per_pixel = std::max<data_size_t>(1, std::max(window.x_range() / static_cast<data_size_t>(width),
+                                                                    window.y_range() / static_cast<data_size_t>(height)));
+    const std::size_t base_size = pyramid_.block_size();
+    if (per_pixel * 2 >= base_size) {
+        detail_build_ = {};
+        const std::size_t level = pyramid_.level_for(per_pixel);
+        plotted_block_size_ = static_cast<data_size_t>(base_size) << level;
+        return pyramid_.level(level);
+    }
+
+    // Base blocks would span several pixels: sketch finer blocks around the window
+    const std::size_t block_size = std::max(MIN_DETAIL_BLOCK, static_cast<std::size_t>(std::bit_ceil(per_pixel)));
+    auto covers = [&](std::size_t size, const DotPlotWindow& cover) {
+        return size == block_size &&
+            window.x_start >= cover.x_start && window.x_end <= cover.x_end &&
+            window.y_start >= cover.y_start && window.y_end <= cover.y_end;
+    };
+    if (!covers(detail_block_size_, detail_cover_)) {
+        if (!covers(detail_build_.block_size, detail_build_.cover)) {
+            // Half a window of margin on each side, so small pans reuse the sketches
+            const data_size_t total = pyramid_.total_bytes();
+            const data_size_t x_margin = window.x_range() / 2;
+            const data_size_t y_margin = window.y_range() / 2;
+            DotPlotWindow cover;
+            cover.x_start = window.x_start > x_margin ? window.x_start - x_margin : 0;
+            cover.x_end = std::min(total, window.x_end + x_margin);
+            cover.y_start = window.y_start > y_margin ? window.y_start - y_margin : 0;
+            cover.y_end = std::min(total, window.y_end + y_margin);
+
+            detail_build_ = {};
+            detail_build_.block_size = block_size;
+            detail_build_.cover = cover;
+
+            // Overlapping ranges are sketched once; otherwise the lower one first
+            auto& ranges = detail_build_.ranges;
+            if (cover.x_start <= cover.y_end && cover.y_start <= cover.x_end) {
+                ranges[0] = {std::min(cover.x_start, cover.y_start), std::max(cover.x_end, cover.y_end)};
+                detail_build_.range_count = 1;
+            } else {
+                ranges[0] = {cover.x_start, cover.x_end};
+                ranges[1] = {cover.y_start, cover.y_end};
+                if (cover.y_start < cover.x_start) std::swap(ranges[0], ranges[1]);
+                detail_build_.range_count = 2;
+            }
+        }
+
+        if (!sketch_detail(detail_build_, std::chrono::steady_clock::now() + budget)) {
+            plotted_block_size_ = static_cast<data_size_t>(base_size);
+            return pyramid_.level(0);
+        }
+        detail_ = std::move(detail_build_.blocks);
+        detail_block_size_ = detail_build_.block_size;
+        detail_cover_ = detail_build_.cover;
+        detail_build_ = {};
+    }
+    plotted_block_size_ = detail_block_size_;
+    return detail_;
+}
+
+bool SimilarityData::sketch_detail(DetailBuild& build, std::chrono::steady_clock::time_point deadline) {
+    const std::span<const BlockSketch> base = pyramid_.level(0);
+    for (; build.range < build.range_count; ++build.range, build.next = DetailBuild::NOT_STARTED) {
+        const auto [start, end] = build.ranges[build.range];
+        if (build.next == DetailBuild::NOT_STARTED) {
+            build.next = static_cast<std::size_t>(
+                std::partition_point(base.begin(), base.end(), [&](const BlockSketch& block) {
+                    return block.end_position() <= start;
+                }) - base.begin());
+        }
+
+        // Read runs of address-contiguous base blocks together
+        while (build.next < base.size() && base[build.next].position < end) {
+            const BlockSketch& first = base[build.next];
+            data_size_t bytes = first.bytes;
+            for (++build.next; build.next < base.size() && base[build.next].position < end &&
+                               base[build.next].start_addr == first.start_addr + bytes &&
+                               bytes + base[build.next].bytes <= READ_WINDOW; ++build.next) {
+                bytes += base[build.next].bytes;
+            }
+            sketch_window(static_cast<ea_t>(first.start_addr), static_cast<std::size_t>(bytes), build.block_size,
+                          first.position, build.blocks);
+            if (std::chrono::steady_clock::now() >= deadline) {
+                // The range is done only if that was its last run
+                if (build.next >= base.size() || base[build.next].position >= end) {
+                    ++build.range;
+                    build.next = DetailBuild::NOT_STARTED;
+                }
+                return build.range >= build.range_count;
+            }
+        }
+    }
+    return true;
+}
+
+void SimilarityData::sketch_window(ea_t ea, std::size_t size, std::size_t block_size, data_size_t position,
+                                   std::vector<BlockSketch>& out) {
+    if (size == 0 || block_size == 0) return;
+
+    if (buffer_.size() < size) {
+        buffer_.resize(size);
+    }
+
+    // IDA reads stay on this thread; bytes past a failed read sketch as empty
+    const ssize_t got = get_bytes(buffer_.data(), size, ea);
+    const std::size_t readable = got < 0 ? 0 : static_cast<std::size_t>(got);
+
+    const std::size_t count = (size + block_size - 1) / block_size;
+    const std::size_t first = out.size();
+    out.resize(first + count);
+    const std::uint8_t* data = buffer_.data();
+    parallel_for(count, 16, [&](std::size_t s) {
+        const std::size_t offset = s * block_size;
+        const std::size_t length = std::min(block_size, size - offset);
+        const std::size_t available = readable > offset ? std::min(length, readable - offset) : 0;
+
+        BlockSketch& block = out[first + s];
+        block.compute(data + offset, available);
+        block.start_addr = ea + offset;
+        block.end_addr = ea + offset + length;
+        block.position = position + offset;
+        block.bytes = length;
+    });
+}
+
+void SimilarityData::clear() {
+    build_.reset();
+    pyramid_.clear();
+    detail_.clear();
+    detail_.shrink_to_fit();
+    detail_block_size_ = 0;
+    detail_cover_ = {};
+    detail_build_ = {};
+    plotted_block_size_ = 0;
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+}
+
+} // namespace self_similarity
+} // namespace features
+} // namespace synopsia
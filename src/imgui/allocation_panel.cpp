@@ -0,0 +1,87 @@
+/// @file allocation_panel.cpp
+/// @brief ImGui diagnostics window for the allocation tracker
+
+#include <synopsia/imgui/allocation_panel.hpp>
+
+#include <synopsia/common/alloc_tracker.hpp>
+#include <synopsia/common/frame_arena.hpp>
+
+#include <imgui.h>
+
+namespace synopsia {
+namespace imgui {
+
+namespace {
+
+unsigned long long ull(std::uint64_t value) {
+    return static_cast<unsigned long long>(value);
+}
+
+} // anonymous namespace
+
+void render_allocation_panel(bool* open) {
+    ImGui::SetNextWindowSize(ImVec2(620, 300), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Allocations", open)) {
+        ImGui::End();
+        return;
+    }
+
+    const FrameArena::FrameStats& frame = FrameArena::instance().last_frame();
+    ImGui::Text("Heap: %llu allocations, %.1f MB total", ull(AllocationCounter::count()),
+                static_cast<double>(AllocationCounter::bytes()) / (1024.0 * 1024.0));
+    ImGui::Text("Last frame: %llu heap allocations, %zu arena bytes in %zu block(s)",
+                ull(frame.heap_allocations), frame.bytes, frame.blocks);
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Reset")) {
+        AllocationSite::reset_all();
+    }
+
+    constexpr ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                                      ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("##allocations", 8, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Feature", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Phase");
+        ImGui::TableSetupColumn("Passes");
+        ImGui::TableSetupColumn("Last");
+        ImGui::TableSetupColumn("Last KB");
+        ImGui::TableSetupColumn("Mean");
+        ImGui::TableSetupColumn("Max");
+        ImGui::TableSetupColumn("Per 1k items");
+        ImGui::TableHeadersRow();
+
+        for (const AllocationSite::Stats& site : AllocationSite::snapshot()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(site.feature.c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(site.phase.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", ull(site.passes));
+            ImGui::TableNextColumn();
+            if (site.last_allocations == 0) {
+                ImGui::TextColored(ImVec4(0.4f, 0.8f, 0.4f, 1.0f), "0");
+            } else {
+                ImGui::Text("%llu", ull(site.last_allocations));
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", static_cast<double>(site.last_bytes) / 1024.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", site.passes ? static_cast<double>(site.allocations) / static_cast<double>(site.passes) : 0.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", ull(site.max_allocations));
+            ImGui::TableNextColumn();
+            if (site.last_items > 0) {
+                ImGui::Text("%.1f", 1000.0 * static_cast<double>(site.last_allocations) / static_cast<double>(site.last_items));
+            } else {
+                ImGui::TextDisabled("-");
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+} // namespace imgui
+} // namespace synopsia
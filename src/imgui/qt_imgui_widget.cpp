@@ -6,6 +6,7 @@
 #include <QWidget>
 #include <QVBoxLayout>
 #include <QOpenGLContext>
+#include <QOpenGLFunctions>
 #include <QSurfaceFormat>
 #include <QTimer>
 #include <QMouseEvent>
@@ -24,7 +25,22 @@
 #include <GL/gl.h>
 #endif
 
+// Session trace format (IDA-free)
+#include <synopsia/common/session_trace.hpp>
+#include <synopsia/common/frame_arena.hpp>
+#include <synopsia/common/alloc_tracker.hpp>
+#include <synopsia/imgui/allocation_panel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
 #include <cstdio>
+#include <vector>
+
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
 
 // Forward declarations for navigation functions
 extern "C" {
@@ -32,6 +48,13 @@ extern "C" {
     void synopsia_function_search_navigate_forward();
 }
 
+// Forward declarations for session trace recording
+extern "C" {
+    bool synopsia_trace_recording();
+    void synopsia_trace_input(const char* widget, int input, float x, float y, std::int64_t value);
+    void synopsia_trace_frame(const char* widget, std::uint64_t render_us);
+}
+
 namespace {
 
 // =============================================================================
@@ -176,6 +199,42 @@ private:
     EventHandler event_handler_;
 };
 
+// =============================================================================
+// CanvasLayer - offscreen draw list rendered at reduced resolution
+// =============================================================================
+
+/// The texture is sized for full resolution once; lower scales render into
+/// its lower-left corner, so changing the scale never reallocates.
+struct CanvasLayer {
+    ImDrawList list{nullptr};
+    ImVec2 pos{0.0f, 0.0f};
+    ImVec2 size{0.0f, 0.0f};
+    float framebuffer_scale = 1.0f;  // dpr * scale
+    int texture_width = 0;           // Full resolution
+    int texture_height = 0;
+    bool pending = false;            // Drawn this frame, not yet rasterized
+
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    int allocated_width = 0;
+    int allocated_height = 0;
+    bool failed = false;             // FBO incomplete; stay on the window draw list
+};
+
+/// CPU-rasterized image uploaded by a feature (dot plots, heatmaps)
+struct ImageTexture {
+    GLuint texture = 0;
+    int width = 0;
+    int height = 0;
+};
+
+inline constexpr int IMAGE_SLOTS = 4;
+
+class ImGuiOpenGLWidget;
+
+/// Widget inside its render callback (UI thread only)
+ImGuiOpenGLWidget* g_rendering_widget = nullptr;
+
 // =============================================================================
 // ImGuiOpenGLWidget - Main widget that manages ImGui context and rendering
 // =============================================================================
@@ -187,6 +246,8 @@ public:
     explicit ImGuiOpenGLWidget(const char* ini_prefix, QWidget* parent = nullptr)
         : QWidget(parent)
         , ini_filename_(ini_prefix ? std::string(ini_prefix) + ".ini" : "imgui.ini")
+        , widget_name_(ini_prefix ? ini_prefix : "imgui")
+        , frame_site_(widget_name_, "frame")
     {
         // Create GL window
         gl_window_ = new ImGuiGLWindow();
@@ -253,6 +314,18 @@ public:
     }
 
     ~ImGuiOpenGLWidget() override {
+        const bool has_images = std::any_of(images_.begin(), images_.end(),
+                                            [](const ImageTexture& image) { return image.texture != 0; });
+        if ((layer_.fbo || has_images) && context_->makeCurrent(gl_window_)) {
+            QOpenGLFunctions* gl = context_->functions();
+            if (layer_.fbo) {
+                gl->glDeleteFramebuffers(1, &layer_.fbo);
+                gl->glDeleteTextures(1, &layer_.texture);
+            }
+            for (ImageTexture& image : images_) {
+                if (image.texture) gl->glDeleteTextures(1, &image.texture);
+            }
+        }
         if (imgui_context_) {
             ImGui::SetCurrentContext(imgui_context_);
             if (renderer_initialized_) {
@@ -267,7 +340,101 @@ public:
         render_user_data_ = user_data;
     }
 
+    ImDrawList* beginLayer(const ImVec2& pos, const ImVec2& size, float scale) {
+        if (layer_.failed || layer_.pending || size.x < 1.0f || size.y < 1.0f) return nullptr;
+
+        if (!layer_.list._Data) {
+            layer_.list._Data = ImGui::GetDrawListSharedData();
+        }
+        layer_.list._ResetForNewFrame();
+        layer_.list.PushClipRect(pos, ImVec2(pos.x + size.x, pos.y + size.y));
+        layer_.list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+
+        layer_.pos = pos;
+        layer_.size = size;
+        layer_.framebuffer_scale = dpr_ * std::clamp(scale, 0.1f, 1.0f);
+        layer_.texture_width = static_cast<int>(std::ceil(size.x * dpr_));
+        layer_.texture_height = static_cast<int>(std::ceil(size.y * dpr_));
+        layer_.pending = true;
+        return &layer_.list;
+    }
+
+    void endLayer() {
+        layer_.list.PopTextureID();
+        layer_.list.PopClipRect();
+        layer_.list._PopUnusedDrawCmd();
+
+        // Same truncation the renderer applies to the framebuffer size
+        const float used_width = static_cast<float>(static_cast<int>(layer_.size.x * layer_.framebuffer_scale));
+        const float used_height = static_cast<float>(static_cast<int>(layer_.size.y * layer_.framebuffer_scale));
+        const ImVec2 uv0(0.0f, used_height / static_cast<float>(layer_.texture_height));
+        const ImVec2 uv1(used_width / static_cast<float>(layer_.texture_width), 0.0f);  // GL rows run bottom-up
+        ImGui::GetWindowDrawList()->AddImage(static_cast<ImTextureID>(layer_.texture), layer_.pos,
+                                             ImVec2(layer_.pos.x + layer_.size.x, layer_.pos.y + layer_.size.y),
+                                             uv0, uv1);
+    }
+
+    ImTextureID uploadImage(int slot, const std::uint32_t* argb, int width, int height) {
+        if (slot < 0 || slot >= IMAGE_SLOTS || width <= 0 || height <= 0) return ImTextureID{};
+        QOpenGLFunctions* gl = context_->functions();
+        ImageTexture& image = images_[static_cast<std::size_t>(slot)];
+
+        if (!image.texture) {
+            gl->glGenTextures(1, &image.texture);
+            gl->glBindTexture(GL_TEXTURE_2D, image.texture);
+            gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+
+        swizzle(argb, static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+
+        gl->glBindTexture(GL_TEXTURE_2D, image.texture);
+        gl->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        if (image.width != width || image.height != height) {
+            gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba_.data());
+            image.width = width;
+            image.height = height;
+        } else {
+            gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba_.data());
+        }
+        return static_cast<ImTextureID>(image.texture);
+    }
+
+    ImTextureID updateImageRows(int slot, const std::uint32_t* argb, int width, int height,
+                                int first_row, int row_count) {
+        if (slot < 0 || slot >= IMAGE_SLOTS) return ImTextureID{};
+        ImageTexture& image = images_[static_cast<std::size_t>(slot)];
+        if (!image.texture || image.width != width || image.height != height) {
+            return uploadImage(slot, argb, width, height);
+        }
+
+        first_row = std::clamp(first_row, 0, height);
+        row_count = std::clamp(row_count, 0, height - first_row);
+        if (row_count > 0) {
+            const std::size_t offset = static_cast<std::size_t>(first_row) * static_cast<std::size_t>(width);
+            swizzle(argb + offset, static_cast<std::size_t>(row_count) * static_cast<std::size_t>(width));
+
+            QOpenGLFunctions* gl = context_->functions();
+            gl->glBindTexture(GL_TEXTURE_2D, image.texture);
+            gl->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first_row, width, row_count, GL_RGBA, GL_UNSIGNED_BYTE,
+                                rgba_.data());
+        }
+        return static_cast<ImTextureID>(image.texture);
+    }
+
 private:
+    /// Swizzle 0xAARRGGBB into rgba_ as byte-order RGBA, so only core formats are needed
+    void swizzle(const std::uint32_t* argb, std::size_t count) {
+        rgba_.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::uint32_t p = argb[i];
+            rgba_[i] = ((p >> 16) & 0xFF) | (p & 0xFF00) | ((p & 0xFF) << 16) | (p & 0xFF000000u);
+        }
+    }
+
     void handleEvent(QEvent* event) {
         ImGui::SetCurrentContext(imgui_context_);
         ImGuiIO& io = ImGui::GetIO();
@@ -287,6 +454,7 @@ private:
                 int button = qt_mouse_button_to_imgui(e->button());
                 if (button >= 0) {
                     io.AddMouseButtonEvent(button, true);
+                    trace(synopsia::TraceInput::MouseButton, 0.0f, 0.0f, button | (1 << 8));
                 }
                 break;
             }
@@ -295,6 +463,7 @@ private:
                 int button = qt_mouse_button_to_imgui(e->button());
                 if (button >= 0) {
                     io.AddMouseButtonEvent(button, false);
+                    trace(synopsia::TraceInput::MouseButton, 0.0f, 0.0f, button);
                 }
                 break;
             }
@@ -302,11 +471,13 @@ private:
                 auto* e = static_cast<QMouseEvent*>(event);
                 QPointF pos = e->position();
                 io.AddMousePosEvent(static_cast<float>(pos.x()), static_cast<float>(pos.y()));
+                trace(synopsia::TraceInput::MousePos, static_cast<float>(pos.x()), static_cast<float>(pos.y()), 0);
                 break;
             }
             case QEvent::Wheel: {
                 auto* e = static_cast<QWheelEvent*>(event);
                 io.AddMouseWheelEvent(0.0f, e->angleDelta().y() / 120.0f);
+                trace(synopsia::TraceInput::Wheel, 0.0f, e->angleDelta().y() / 120.0f, 0);
                 break;
             }
             case QEvent::KeyPress: {
@@ -329,6 +500,7 @@ private:
                         io.AddInputCharacter(c.unicode());
                     }
                 }
+                trace_key(mods, key, true, text);
                 break;
             }
             case QEvent::KeyRelease: {
@@ -345,19 +517,49 @@ private:
                 if (key != ImGuiKey_None) {
                     io.AddKeyEvent(key, false);
                 }
+                trace_key(mods, key, false, {});
                 break;
             }
             case QEvent::FocusIn:
                 io.AddFocusEvent(true);
+                trace(synopsia::TraceInput::Focus, 0.0f, 0.0f, 1);
                 break;
             case QEvent::FocusOut:
                 io.AddFocusEvent(false);
+                trace(synopsia::TraceInput::Focus, 0.0f, 0.0f, 0);
                 break;
             default:
                 break;
         }
     }
 
+    /// Log one input event while a session trace is being recorded
+    void trace(synopsia::TraceInput input, float x, float y, std::int64_t value) {
+        if (!synopsia_trace_recording()) return;
+        synopsia_trace_input(widget_name_.c_str(), static_cast<int>(input), x, y, value);
+        input_traced_ = true;
+    }
+
+    /// Log a key event as ImGui sees it: modifiers first, then the key and its text
+    void trace_key(Qt::KeyboardModifiers mods, ImGuiKey key, bool down, const QString& text) {
+        if (!synopsia_trace_recording()) return;
+        const std::pair<ImGuiKey, bool> modifiers[] = {
+            {ImGuiMod_Ctrl, (mods & Qt::ControlModifier) != 0},
+            {ImGuiMod_Shift, (mods & Qt::ShiftModifier) != 0},
+            {ImGuiMod_Alt, (mods & Qt::AltModifier) != 0},
+            {ImGuiMod_Super, (mods & Qt::MetaModifier) != 0},
+        };
+        for (const auto& [mod, active] : modifiers) {
+            trace(synopsia::TraceInput::Key, 0.0f, 0.0f, mod | (static_cast<std::int64_t>(active) << 16));
+        }
+        if (key != ImGuiKey_None) {
+            trace(synopsia::TraceInput::Key, 0.0f, 0.0f, key | (static_cast<std::int64_t>(down) << 16));
+        }
+        for (QChar c : text) {
+            trace(synopsia::TraceInput::Char, 0.0f, 0.0f, c.unicode());
+        }
+    }
+
     void render() {
         if (!gl_window_->isExposed()) return;
         if (!context_->makeCurrent(gl_window_)) return;
@@ -385,29 +587,112 @@ private:
         ImGuiIO& io = ImGui::GetIO();
         io.DisplaySize = ImVec2(static_cast<float>(logical_size.width()), static_cast<float>(logical_size.height()));
 
-        // Start new frame
+        // Replays need the widget size the recorded input refers to
+        if (synopsia_trace_recording() && logical_size != traced_size_) {
+            trace(synopsia::TraceInput::Resize, static_cast<float>(logical_size.width()),
+                  static_cast<float>(logical_size.height()), 0);
+            traced_size_ = logical_size;
+        }
+
+        // Start new frame; render-path temporaries from the last one are released
+        synopsia::FrameArena::instance().begin_frame();
         ImGui_ImplOpenGL3_NewFrame();
         ImGui::NewFrame();
 
         // Call user render callback
+        const auto frame_start = std::chrono::steady_clock::now();
         if (render_callback_) {
+            synopsia::AllocationScope allocations(frame_site_);
+            g_rendering_widget = this;
             render_callback_(render_user_data_);
+            g_rendering_widget = nullptr;
+        }
+
+        // Diagnostics builds: F12 toggles the allocation table over any widget
+        if (synopsia::AllocationCounter::enabled()) {
+            if (ImGui::IsKeyPressed(ImGuiKey_F12, false)) show_allocations_ = !show_allocations_;
+            if (show_allocations_) synopsia::imgui::render_allocation_panel(&show_allocations_);
+        }
+        if (input_traced_) {
+            // Only frames that consumed input are logged; idle frames replay as no-ops
+            const auto elapsed = std::chrono::steady_clock::now() - frame_start;
+            synopsia_trace_frame(widget_name_.c_str(), static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+            input_traced_ = false;
         }
 
         // Render
         ImGui::Render();
+        if (layer_.pending) {
+            renderLayer();
+            glViewport(0, 0, physical_width, physical_height);
+        }
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
         context_->swapBuffers(gl_window_);
     }
 
+    /// Rasterize the canvas layer into its texture (before the frame that shows it)
+    void renderLayer() {
+        layer_.pending = false;
+        QOpenGLFunctions* gl = context_->functions();
+
+        if (!layer_.fbo) {
+            gl->glGenFramebuffers(1, &layer_.fbo);
+            gl->glGenTextures(1, &layer_.texture);
+        }
+        if (layer_.allocated_width != layer_.texture_width || layer_.allocated_height != layer_.texture_height) {
+            gl->glBindTexture(GL_TEXTURE_2D, layer_.texture);
+            gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, layer_.texture_width, layer_.texture_height, 0,
+                             GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            gl->glBindFramebuffer(GL_FRAMEBUFFER, layer_.fbo);
+            gl->glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, layer_.texture, 0);
+            if (gl->glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+                fprintf(stderr, "[Synopsia] Canvas framebuffer incomplete; drawing at native resolution\n");
+                layer_.failed = true;
+            }
+            layer_.allocated_width = layer_.texture_width;
+            layer_.allocated_height = layer_.texture_height;
+        }
+
+        gl->glBindFramebuffer(GL_FRAMEBUFFER, layer_.fbo);
+        if (!layer_.failed) {
+            gl->glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            gl->glClear(GL_COLOR_BUFFER_BIT);
+
+            ImDrawData draw_data;
+            draw_data.Valid = true;
+            draw_data.CmdListsCount = 1;
+            draw_data.CmdLists.push_back(&layer_.list);
+            draw_data.TotalVtxCount = layer_.list.VtxBuffer.Size;
+            draw_data.TotalIdxCount = layer_.list.IdxBuffer.Size;
+            draw_data.DisplayPos = layer_.pos;
+            draw_data.DisplaySize = layer_.size;
+            draw_data.FramebufferScale = ImVec2(layer_.framebuffer_scale, layer_.framebuffer_scale);
+            ImGui_ImplOpenGL3_RenderDrawData(&draw_data);
+        }
+        gl->glBindFramebuffer(GL_FRAMEBUFFER, context_->defaultFramebufferObject());
+    }
+
     ImGuiGLWindow* gl_window_ = nullptr;
     QOpenGLContext* context_ = nullptr;
     QTimer* timer_ = nullptr;
     ImGuiContext* imgui_context_ = nullptr;
     bool renderer_initialized_ = false;
     std::string ini_filename_;
+    std::string widget_name_;  // Trace identity
+    synopsia::AllocationSite frame_site_;  // Heap allocations per rendered frame
+    bool show_allocations_ = false;
     float dpr_ = 1.0f;
+    bool input_traced_ = false;
+    QSize traced_size_;
+    CanvasLayer layer_;
+    std::array<ImageTexture, IMAGE_SLOTS> images_;
+    std::vector<std::uint32_t> rgba_;  // Upload staging
 
     RenderCallback render_callback_ = nullptr;
     void* render_user_data_ = nullptr;
@@ -518,5 +803,31 @@ void QtImGuiWidget::render_thunk(void* user_data) {
     }
 }
 
+// Layer state is per widget; this only remembers whether the open layer is real
+static bool g_layer_open = false;
+
+ImDrawList* begin_canvas_layer(const ImVec2& pos, const ImVec2& size, float scale) {
+    ImDrawList* list = g_rendering_widget ? g_rendering_widget->beginLayer(pos, size, scale) : nullptr;
+    g_layer_open = list != nullptr;
+    return list ? list : ImGui::GetWindowDrawList();
+}
+
+void end_canvas_layer() {
+    if (g_layer_open && g_rendering_widget) {
+        g_rendering_widget->endLayer();
+    }
+    g_layer_open = false;
+}
+
+ImTextureID upload_image(int slot, const std::uint32_t* argb, int width, int height) {
+    return g_rendering_widget ? g_rendering_widget->uploadImage(slot, argb, width, height) : ImTextureID{};
+}
+
+ImTextureID update_image_rows(int slot, const std::uint32_t* argb, int width, int height,
+                              int first_row, int row_count) {
+    return g_rendering_widget ? g_rendering_widget->updateImageRows(slot, argb, width, height, first_row, row_count)
+                              : ImTextureID{};
+}
+
 } // namespace imgui
 } // namespace synopsia
@@ -2,14 +2,61 @@
 /// @brief Minimap data model implementation
 
 #include <synopsia/minimap_data.hpp>
+#include <synopsia/core/analysis_cache.hpp>
+#include <synopsia/core/analysis_snapshot.hpp>
+#include <synopsia/common/alloc_tracker.hpp>
 
 namespace synopsia {
 
+/// Load a precomputed pyramid level matching block_size, if any
+static bool load_cached_blocks(std::size_t block_size, std::vector<EntropyBlock>& blocks) {
+    for (std::size_t level = 0; level < ENTROPY_PYRAMID_LEVELS; ++level) {
+        if ((DEFAULT_BLOCK_SIZE << level) != block_size) continue;
+        
+        const auto section = static_cast<CacheSection>(
+            static_cast<std::uint32_t>(CacheSection::EntropyLevel0) + level);
+        std::uint64_t cached_block_size = 0;
+        return AnalysisCache::read(section, CacheScope::Bytes, blocks, &cached_block_size) &&
+               cached_block_size == block_size;
+    }
+    return false;
+}
+
+/// Load a pyramid level matching block_size from the snapshot file, if any
+static bool load_snapshot_blocks(std::size_t block_size, std::vector<EntropyBlock>& blocks) {
+    auto snapshot = database_snapshot();
+    if (!snapshot || !snapshot_matches(*snapshot, CacheScope::Bytes)) return false;
+    
+    for (std::size_t level = 0; level < ENTROPY_PYRAMID_LEVELS; ++level) {
+        if ((DEFAULT_BLOCK_SIZE << level) != block_size) continue;
+        
+        const auto starts = snapshot->column<std::uint64_t>(
+            snapshot_entropy_section(SnapshotSection::EntropyStart0, level));
+        const auto ends = snapshot->column<std::uint64_t>(
+            snapshot_entropy_section(SnapshotSection::EntropyEnd0, level));
+        const auto values = snapshot->column<double>(
+            snapshot_entropy_section(SnapshotSection::EntropyValue0, level));
+        if (starts.empty() || ends.size() != starts.size() || values.size() != starts.size()) {
+            return false;
+        }
+        
+        blocks.resize(starts.size());
+        for (std::size_t i = 0; i < starts.size(); ++i) {
+            blocks[i] = {static_cast<ea_t>(starts[i]), static_cast<ea_t>(ends[i]), values[i]};
+        }
+        return true;
+    }
+    return false;
+}
+
 MinimapData::MinimapData() {
     // Initialize with empty state
 }
 
 bool MinimapData::refresh(std::size_t block_size) {
+    static AllocationSite site("entropy_minimap", "refresh");
+    AllocationScope allocations(site);
+
     // Check if database is loaded
     if (!is_database_loaded()) {
         valid_.store(false);
@@ -24,18 +71,40 @@ bool MinimapData::refresh(std::size_t block_size) {
     db_start_ = db_min;
     db_end_ = db_max;
     
-    // Analyze entropy
-    blocks_ = calculator_.analyze_database(block_size);
+    // Analyze entropy (precomputed pyramid levels are used when present)
+    if (!load_cached_blocks(block_size, blocks_) && !load_snapshot_blocks(block_size, blocks_)) {
+        blocks_ = calculator_.analyze_database(block_size);
+    }
     
     // Get memory regions
     regions_ = calculator_.get_memory_regions();
     
+    // Lay segments end to end; gaps shrink to markers of at least one block
+    std::vector<RegionData> ranges;
+    ranges.reserve(regions_.size());
+    for (const auto& region : regions_) {
+        ranges.push_back({static_cast<data_addr_t>(region.start_ea), static_cast<data_addr_t>(region.end_ea)});
+    }
+    if (ranges.empty()) {
+        ranges.push_back({static_cast<data_addr_t>(db_start_), static_cast<data_addr_t>(db_end_)});
+    }
+    axis_.build(std::move(ranges), block_size);
+    
     // Compute statistics
     compute_statistics();
     
     // Reset viewport to show entire database
     reset_viewport();
     
+    // Byte plot histograms are rebuilt when next shown
+    histograms_.clear();
+    histograms_built_ = false;
+    detail_.clear();
+    detail_start_ = detail_end_ = BADADDR;
+    base_build_ = HistogramBuild{};
+    detail_build_ = HistogramBuild{};
+    
+    allocations.set_items(blocks_.size());
     valid_.store(true);
     return true;
 }
@@ -62,27 +131,37 @@ void MinimapData::compute_statistics() {
 }
 
 void MinimapData::reset_viewport() {
-    viewport_.reset(db_start_, db_end_);
+    viewport_.reset(static_cast<ea_t>(axis_.start_address()), static_cast<ea_t>(axis_.end_address()),
+                    static_cast<asize_t>(axis_.length()));
 }
 
-void MinimapData::set_viewport(ea_t start, ea_t end) {
-    if (start >= end) return;
-    
-    // Clamp to database bounds
-    viewport_.start_ea = std::max(start, db_start_);
-    viewport_.end_ea = std::min(end, db_end_);
+void MinimapData::set_window(asize_t start_offset, asize_t end_offset) {
+    viewport_.start_offset = start_offset;
+    viewport_.end_offset = end_offset;
+    viewport_.start_ea = static_cast<ea_t>(axis_.to_address(start_offset));
+    viewport_.end_ea = static_cast<ea_t>(axis_.to_address(end_offset));
     
-    // Calculate zoom factor
-    const asize_t db_range = db_end_ - db_start_;
+    // Zoom is relative to the whole axis, not the raw address span
+    const asize_t length = static_cast<asize_t>(axis_.length());
     const asize_t vp_range = viewport_.range();
-    
-    if (db_range > 0) {
-        viewport_.zoom = static_cast<double>(db_range) / static_cast<double>(vp_range);
+    if (length > 0 && vp_range > 0) {
+        viewport_.zoom = static_cast<double>(length) / static_cast<double>(vp_range);
     } else {
         viewport_.zoom = 1.0;
     }
 }
 
+void MinimapData::set_viewport(ea_t start, ea_t end) {
+    if (start >= end) return;
+    
+    // Clamped to the axis by the transform
+    const asize_t start_offset = static_cast<asize_t>(axis_.to_offset(start));
+    const asize_t end_offset = static_cast<asize_t>(axis_.to_offset(end));
+    if (start_offset >= end_offset) return;
+    
+    set_window(start_offset, end_offset);
+}
+
 void MinimapData::zoom_ida(double factor, ea_t center) {
     if (factor <= 0.0) return;
     
@@ -93,56 +172,177 @@ void MinimapData::zoom_ida(double factor, ea_t center) {
     // Minimum range check (at least one block)
     if (new_range < block_size_) return;
     
-    // Maximum range check (entire database)
-    const asize_t db_range = db_end_ - db_start_;
-    const asize_t clamped_range = std::min(new_range, db_range);
+    // Maximum range check (entire axis)
+    const asize_t length = static_cast<asize_t>(axis_.length());
+    const asize_t clamped_range = std::min(new_range, length);
     
-    // Calculate new viewport centered on the given address
-    const double center_ratio = static_cast<double>(center - viewport_.start_ea) / 
-                                static_cast<double>(old_range);
+    // Calculate new window centered on the given address
+    const asize_t center_offset = std::clamp(static_cast<asize_t>(axis_.to_offset(center)),
+                                             viewport_.start_offset, viewport_.end_offset);
+    const double center_ratio = old_range > 0
+        ? static_cast<double>(center_offset - viewport_.start_offset) / static_cast<double>(old_range)
+        : 0.5;
     
     const asize_t offset_before = static_cast<asize_t>(center_ratio * clamped_range);
     
-    ea_t new_start = (center >= offset_before) ? center - offset_before : db_start_;
-    ea_t new_end = new_start + clamped_range;
+    asize_t new_start = (center_offset >= offset_before) ? center_offset - offset_before : 0;
     
-    // Clamp to database bounds
-    if (new_end > db_end_) {
-        new_end = db_end_;
-        new_start = (new_end >= clamped_range) ? new_end - clamped_range : db_start_;
-    }
-    if (new_start < db_start_) {
-        new_start = db_start_;
-        new_end = std::min(new_start + clamped_range, db_end_);
+    // Clamp to axis bounds
+    if (new_start + clamped_range > length) {
+        new_start = length - clamped_range;
     }
     
-    viewport_.start_ea = new_start;
-    viewport_.end_ea = new_end;
-    viewport_.zoom = static_cast<double>(db_range) / static_cast<double>(viewport_.range());
+    set_window(new_start, new_start + clamped_range);
 }
 
 void MinimapData::pan_ida(sval_t delta) {
-    const asize_t range = viewport_.range();
+    const asize_t length = static_cast<asize_t>(axis_.length());
     
-    ea_t new_start = viewport_.start_ea;
-    ea_t new_end = viewport_.end_ea;
+    asize_t new_start = viewport_.start_offset;
+    asize_t new_end = viewport_.end_offset;
     
     if (delta > 0) {
         // Panning towards higher addresses
-        const asize_t max_delta = db_end_ - viewport_.end_ea;
+        const asize_t max_delta = length - viewport_.end_offset;
         const asize_t actual_delta = std::min(static_cast<asize_t>(delta), max_delta);
         new_start += actual_delta;
         new_end += actual_delta;
     } else if (delta < 0) {
         // Panning towards lower addresses
-        const asize_t max_delta = viewport_.start_ea - db_start_;
+        const asize_t max_delta = viewport_.start_offset;
         const asize_t actual_delta = std::min(static_cast<asize_t>(-delta), max_delta);
         new_start -= actual_delta;
         new_end -= actual_delta;
     }
     
-    viewport_.start_ea = new_start;
-    viewport_.end_ea = new_end;
+    set_window(new_start, new_end);
+}
+
+void MinimapData::begin_histograms(HistogramBuild& build, ea_t start, ea_t end, std::size_t span_size) {
+    build.spans.clear();
+    build.span_size = span_size;
+    build.start = start;
+    build.end = end;
+    build.region = 0;
+    build.cursor = BADADDR;
+}
+
+bool MinimapData::step_histograms(HistogramBuild& build, std::chrono::steady_clock::time_point deadline) {
+    // Same spans as histogram_spans over the whole range: each starts at its region's first byte
+    const std::size_t chunk = std::max<std::size_t>(1, HISTOGRAM_CHUNK / build.span_size) * build.span_size;
+    do {
+        while (build.region < regions_.size()) {
+            const MemoryRegion& region = regions_[build.region];
+            const ea_t lo = std::max(region.start_ea, build.start);
+            const ea_t hi = std::min(region.end_ea, build.end);
+            if (!region.readable || lo >= hi) {
+                ++build.region;
+                continue;
+            }
+            if (build.cursor == BADADDR || build.cursor < lo) build.cursor = lo;
+            if (build.cursor >= hi) {
+                ++build.region;
+                build.cursor = BADADDR;
+                continue;
+            }
+            break;
+        }
+        if (build.region >= regions_.size()) return true;
+        
+        const ea_t hi = std::min(regions_[build.region].end_ea, build.end);
+        const ea_t next = build.cursor + std::min<asize_t>(chunk, hi - build.cursor);
+        auto spans = calculator_.histogram_spans(build.cursor, next, build.span_size);
+        build.spans.insert(build.spans.end(), spans.begin(), spans.end());
+        build.cursor = next;
+    } while (std::chrono::steady_clock::now() < deadline);
+    return false;
+}
+
+const ByteHistogramPyramid* MinimapData::byte_histograms(data_size_t bytes_per_line) {
+    if (!valid_.load()) return nullptr;
+    
+    const auto deadline = std::chrono::steady_clock::now() + HISTOGRAM_BUDGET;
+    
+    // Precomputed base level if the bytes have not changed, else one sliced pass over them
+    if (!histograms_built_) {
+        if (!base_build_.active()) {
+            std::vector<ByteHistogram> base;
+            std::uint64_t span_size = 0;
+            if (AnalysisCache::read(CacheSection::ByteHistograms, CacheScope::Bytes, base, &span_size)) {
+                histograms_.build(std::move(base), static_cast<std::size_t>(span_size));
+                histograms_built_ = true;
+            } else {
+                std::uint64_t total = 0;
+                for (const auto& region : regions_) {
+                    if (region.readable) total += region.end_ea - region.start_ea;
+                }
+                begin_histograms(base_build_, db_start_, db_end_, byte_histogram_span(total));
+            }
+        }
+        if (base_build_.active() && step_histograms(base_build_, deadline)) {
+            histograms_.build(std::move(base_build_.spans), base_build_.span_size);
+            base_build_ = HistogramBuild{};
+            histograms_built_ = true;
+        }
+        if (!histograms_built_) return nullptr;
+    }
+    if (histograms_.empty()) return nullptr;
+    
+    // Up to this visible range, zooming past the base spans reads the bytes around the viewport
+    constexpr asize_t detail_max_range = 8 * 1024 * 1024;
+    const asize_t range = viewport_.range();
+    if (bytes_per_line >= histograms_.span_size() || range > detail_max_range) {
+        detail_build_ = HistogramBuild{};
+        return &histograms_;
+    }
+    
+    // Spans a quarter of a line or less, so a few more zoom steps need no rebuild
+    std::size_t span = 16;
+    while (span * 8 <= bytes_per_line) span *= 2;
+    
+    auto covers = [&](ea_t start, ea_t end, std::size_t span_size) {
+        return start != BADADDR && viewport_.start_ea >= start && viewport_.end_ea <= end && span >= span_size;
+    };
+    if (!covers(detail_start_, detail_end_, detail_.span_size())) {
+        if (!covers(detail_build_.start, detail_build_.end, detail_build_.span_size) || !detail_build_.active()) {
+            // One screen of margin on each side keeps panning cheap
+            const asize_t length = static_cast<asize_t>(axis_.length());
+            const asize_t start_offset = viewport_.start_offset - std::min(viewport_.start_offset, range);
+            const asize_t end_offset = std::min(length, viewport_.end_offset + range);
+            begin_histograms(detail_build_, static_cast<ea_t>(axis_.to_address(start_offset)),
+                             static_cast<ea_t>(axis_.to_address(end_offset)), span);
+        }
+        if (!step_histograms(detail_build_, deadline)) {
+            // Until then the previous detail if it still spans the viewport, else the base level
+            const bool stale_fits = !detail_.empty() && viewport_.start_ea >= detail_start_ &&
+                                    viewport_.end_ea <= detail_end_;
+            return stale_fits ? &detail_ : &histograms_;
+        }
+        
+        detail_start_ = detail_build_.start;
+        detail_end_ = detail_build_.end;
+        detail_.build(std::move(detail_build_.spans), detail_build_.span_size);
+        detail_build_ = HistogramBuild{};
+    }
+    return detail_.empty() ? &histograms_ : &detail_;
+}
+
+data_size_t MinimapData::read_bytes(data_addr_t start, data_size_t size, std::uint8_t* out) {
+    if (!valid_.load() || size == 0) return 0;
+    
+    const ea_t lo = static_cast<ea_t>(start);
+    const ea_t hi = static_cast<ea_t>(start + size);
+    data_size_t written = 0;
+    for (const auto& region : regions_) {
+        if (!region.readable || region.end_ea <= lo || region.start_ea >= hi) continue;
+        const ea_t from = std::max(lo, region.start_ea);
+        const ea_t to = std::min(hi, region.end_ea);
+        const ssize_t got = get_bytes(out + written, static_cast<ssize_t>(to - from), from);
+        if (got > 0) {
+            written += static_cast<data_size_t>(got);
+        }
+    }
+    return written;
 }
 
 } // namespace synopsia
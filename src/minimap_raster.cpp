@@ -0,0 +1,94 @@
+/// @file minimap_raster.cpp
+/// @brief Entropy minimap rasterizer implementation
+
+#include <synopsia/minimap_raster.hpp>
+#include <synopsia/address_axis.hpp>
+
+#include <algorithm>
+
+namespace synopsia {
+
+/// First block whose end lies past addr (blocks sorted by address)
+static std::size_t first_visible_block(const IMinimapDataSource& source, data_addr_t addr) {
+    std::size_t lo = 0;
+    std::size_t hi = source.block_count();
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (source.get_block(mid).end_addr <= addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+void rasterize_entropy(
+    const IMinimapDataSource& source,
+    const ColorGradient& gradient,
+    bool vertical,
+    int width,
+    int height,
+    std::uint32_t* pixels,
+    std::size_t stride
+) {
+    if (width <= 0 || height <= 0 || !source.is_valid()) {
+        return;
+    }
+    
+    const ViewportData viewport = source.get_viewport();
+    const data_size_t vp_range = viewport.range();
+    if (vp_range == 0) {
+        return;
+    }
+    
+    const AddressAxis& axis = source.axis();
+    const int extent = vertical ? height : width;
+    
+    // Paint the axis interval [first, last) (clamped to the viewport)
+    auto fill = [&](data_size_t first, data_size_t last, std::uint32_t argb) {
+        first = std::max(first, viewport.start_offset);
+        last = std::min(last, viewport.end_offset);
+        if (first >= last) return;
+        
+        const double t1 = static_cast<double>(first - viewport.start_offset) / static_cast<double>(vp_range);
+        const double t2 = static_cast<double>(last - viewport.start_offset) / static_cast<double>(vp_range);
+        const int start = std::max(0, static_cast<int>(t1 * extent));
+        const int end = std::min(extent, static_cast<int>(t2 * extent) + 1);
+        
+        if (vertical) {
+            // Fill horizontal line for each row
+            for (int y = start; y < end; ++y) {
+                std::uint32_t* line = pixels + static_cast<std::size_t>(y) * stride;
+                std::fill(line, line + width, argb);
+            }
+        } else {
+            // Fill vertical column for each column
+            for (int y = 0; y < height; ++y) {
+                std::uint32_t* line = pixels + static_cast<std::size_t>(y) * stride;
+                std::fill(line + start, line + end, argb);
+            }
+        }
+    };
+    
+    // Collapsed gaps between mapped ranges
+    const auto& spans = axis.spans();
+    const std::uint32_t gap_argb = colors::GapMarker.to_argb() | 0xFF000000u;
+    for (std::size_t i = 1; i < spans.size(); ++i) {
+        if (spans[i - 1].offset_end() >= viewport.end_offset) break;
+        fill(spans[i - 1].offset_end(), spans[i].offset, gap_argb);
+    }
+    
+    const std::size_t num_blocks = source.block_count();
+    for (std::size_t i = first_visible_block(source, viewport.start_addr); i < num_blocks; ++i) {
+        const EntropyBlockData block = source.get_block(i);
+        const data_size_t first = axis.to_offset(block.start_addr);
+        if (first >= viewport.end_offset) {
+            break;
+        }
+        fill(first, axis.to_offset(block.end_addr),
+             gradient.sample_entropy(block.entropy).to_argb() | 0xFF000000u);
+    }
+}
+
+} // namespace synopsia
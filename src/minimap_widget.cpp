@@ -5,6 +5,8 @@
 /// Data access is done through the IMinimapDataSource interface.
 
 #include <synopsia/minimap_widget.hpp>
+#include <synopsia/minimap_raster.hpp>
+#include <synopsia/address_axis.hpp>
 
 #ifdef SYNOPSIA_USE_QT
 
@@ -12,11 +14,161 @@
 #include <QFontMetrics>
 #include <QFont>
 
+#include <algorithm>
+#include <chrono>
+#include <span>
+
+// Session trace recording (implemented on the IDA side)
+extern "C" {
+    bool synopsia_trace_recording();
+    void synopsia_trace_input(const char* widget, int input, float x, float y, std::int64_t value);
+    void synopsia_trace_frame(const char* widget, std::uint64_t render_us);
+    void synopsia_trace_minimap_layout(float width, float height, bool vertical);
+}
+
 namespace synopsia {
 
+/// Widget name in session traces
+static constexpr const char* TRACE_WIDGET = "synopsia_minimap";
+
+/// Read the mapped bytes of [lo, hi) for the digraph: all of them up to
+/// QT_DIGRAPH_MAX_BYTES, else QT_DIGRAPH_SAMPLES evenly spaced windows.
+/// @param mapped Receives the mapped bytes in the range
+/// @param breaks Receives the offsets in out where each piece or window after the first starts
+/// @return Bytes written to out (grown as needed, never shrunk)
+static std::size_t readSelection(IMinimapDataSource& source, data_addr_t lo, data_addr_t hi,
+                                 std::vector<std::uint8_t>& out, data_size_t& mapped,
+                                 std::vector<std::size_t>& breaks) {
+    // Mapped pieces of the range, so gaps cost nothing
+    struct Piece { data_addr_t start; data_size_t size; };
+    std::vector<Piece> pieces;
+    mapped = 0;
+    breaks.clear();
+    for (const AddressAxis::Span& span : source.axis().spans()) {
+        const data_addr_t from = std::max(lo, span.start);
+        const data_addr_t to = std::min(hi, span.end);
+        if (from < to) {
+            pieces.push_back({from, to - from});
+            mapped += to - from;
+        }
+    }
+    
+    const bool sampled = mapped > QT_DIGRAPH_MAX_BYTES;
+    const std::size_t capacity = sampled ? QT_DIGRAPH_MAX_BYTES : static_cast<std::size_t>(mapped);
+    if (out.size() < capacity) {
+        out.resize(capacity);
+    }
+    
+    std::size_t written = 0;
+    if (!sampled) {
+        for (const Piece& piece : pieces) {
+            if (written > 0) breaks.push_back(written);
+            written += static_cast<std::size_t>(source.read_bytes(piece.start, piece.size, out.data() + written));
+        }
+        return written;
+    }
+    
+    // Window k starts k strides into the pieces laid end to end; a window stops at its piece's end
+    const data_size_t window = QT_DIGRAPH_MAX_BYTES / QT_DIGRAPH_SAMPLES;
+    const data_size_t stride = mapped / QT_DIGRAPH_SAMPLES;
+    std::size_t index = 0;
+    data_size_t piece_base = 0;
+    for (std::size_t k = 0; k < QT_DIGRAPH_SAMPLES; ++k) {
+        const data_size_t pos = k * stride;
+        while (pos >= piece_base + pieces[index].size) {
+            piece_base += pieces[index++].size;
+        }
+        const Piece& piece = pieces[index];
+        const data_size_t offset = pos - piece_base;
+        const data_size_t length = std::min(window, piece.size - offset);
+        if (written > 0) breaks.push_back(written);
+        written += static_cast<std::size_t>(source.read_bytes(piece.start + offset, length, out.data() + written));
+    }
+    return written;
+}
+
+// =============================================================================
+// DigraphWindow
+// =============================================================================
+
+DigraphWindow::DigraphWindow(QWidget* parent)
+    : QWidget(parent, Qt::Tool)
+    , image_(ByteDigraph::SIDE, ByteDigraph::SIDE, QImage::Format_ARGB32)
+{
+    setWindowTitle("Byte Digraph");
+    setAttribute(Qt::WA_ShowWithoutActivating);
+    setMouseTracking(true);
+    setMinimumSize(160, 180);
+    image_.fill(QColor(colors::Background.r, colors::Background.g, colors::Background.b));
+}
+
+void DigraphWindow::setDigraph(const ByteDigraph* digraph, const ColorGradient& gradient, const QString& caption) {
+    digraph_ = digraph;
+    caption_ = caption;
+    if (digraph_) {
+        digraph_->render(gradient, reinterpret_cast<std::uint32_t*>(image_.bits()),
+                         static_cast<std::size_t>(image_.bytesPerLine() / 4));
+    }
+    update();
+}
+
+QSize DigraphWindow::sizeHint() const {
+    return QSize(ByteDigraph::SIDE * 2 + 8, ByteDigraph::SIDE * 2 + 28);
+}
+
+QRect DigraphWindow::plotRect() const {
+    const QFontMetrics fm(font());
+    const int side = std::max(1, std::min(width() - 8, height() - fm.height() - 12));
+    return QRect((width() - side) / 2, 4, side, side);
+}
+
+void DigraphWindow::paintEvent(QPaintEvent* /*event*/) {
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(colors::Background.r, colors::Background.g, colors::Background.b));
+    
+    // Nearest-neighbour scaling keeps single cells crisp
+    const QRect plot = plotRect();
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter.drawImage(plot, image_);
+    painter.setPen(QColor(64, 64, 64));
+    painter.drawRect(plot.adjusted(-1, -1, 0, 0));
+    
+    painter.setPen(QColor(colors::RegionText.r, colors::RegionText.g, colors::RegionText.b));
+    painter.drawText(QRect(4, plot.bottom() + 4, width() - 8, height() - plot.bottom() - 4),
+                     Qt::AlignLeft | Qt::AlignTop, caption_);
+}
+
+void DigraphWindow::mouseMoveEvent(QMouseEvent* event) {
+    const QRect plot = plotRect();
+    const QPoint pos = event->pos();
+    if (!digraph_ || !plot.contains(pos)) {
+        QToolTip::hideText();
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+    
+    const int first = std::min(ByteDigraph::SIDE - 1, (pos.y() - plot.top()) * ByteDigraph::SIDE / plot.height());
+    const int second = std::min(ByteDigraph::SIDE - 1, (pos.x() - plot.left()) * ByteDigraph::SIDE / plot.width());
+    const std::uint32_t count = digraph_->count(first, second);
+    const double share = digraph_->pairs() ? 100.0 * count / static_cast<double>(digraph_->pairs()) : 0.0;
+    QToolTip::showText(event->globalPosition().toPoint(),
+                       QString("0x%1 0x%2: %3 (%4%)")
+                           .arg(first, 2, 16, QChar('0'))
+                           .arg(second, 2, 16, QChar('0'))
+                           .arg(count)
+                           .arg(share, 0, 'f', 3),
+                       this);
+    QWidget::mouseMoveEvent(event);
+}
+
+// =============================================================================
+// MinimapWidget
+// =============================================================================
+
 MinimapWidget::MinimapWidget(QWidget* parent)
     : QWidget(parent)
     , gradient_(ColorGradient::create_default())
+    , byte_plot_(gradient_)
 {
     // Enable mouse tracking for hover effects
     setMouseTracking(true);
@@ -36,9 +188,26 @@ MinimapWidget::MinimapWidget(QWidget* parent)
         colors::Background.b
     ));
     setPalette(pal);
+    
+    // Selection changes arrive per mouse move; count once they have drained
+    digraph_timer_.setSingleShot(true);
+    digraph_timer_.setInterval(0);
+    connect(&digraph_timer_, &QTimer::timeout, this, [this] { updateDigraph(); });
+    
+    // Histograms are read a slice per paint; keep painting until they are done
+    histogram_timer_.setSingleShot(true);
+    histogram_timer_.setInterval(16);
+    connect(&histogram_timer_, &QTimer::timeout, this, [this] {
+        invalidateCache();
+        update();
+    });
 }
 
 void MinimapWidget::setDataSource(IMinimapDataSource* source) {
+    // A selection belongs to the old source's addresses
+    if (source != data_source_ && selection_anchor_ != DATA_BADADDR) {
+        clearSelection();
+    }
     data_source_ = source;
     invalidateCache();
     update();
@@ -55,6 +224,7 @@ void MinimapWidget::invalidateCache() {
 
 void MinimapWidget::setGradient(const ColorGradient& gradient) {
     gradient_ = gradient;
+    byte_plot_.set_gradient(gradient);
     invalidateCache();
     update();
 }
@@ -62,6 +232,7 @@ void MinimapWidget::setGradient(const ColorGradient& gradient) {
 void MinimapWidget::setVerticalLayout(bool vertical) {
     if (vertical_layout_ != vertical) {
         vertical_layout_ = vertical;
+        traceLayout();
         invalidateCache();
         update();
     }
@@ -95,6 +266,14 @@ void MinimapWidget::setShowCursorGap(bool show) {
     }
 }
 
+void MinimapWidget::setShowBytePlot(bool show) {
+    if (show_byte_plot_ != show) {
+        show_byte_plot_ = show;
+        invalidateCache();
+        update();
+    }
+}
+
 QSize MinimapWidget::sizeHint() const {
     if (vertical_layout_) {
         return QSize(QT_DEFAULT_MINIMAP_WIDTH, 400);
@@ -225,6 +404,16 @@ int MinimapWidget::addressToPosition(data_addr_t addr) const {
     }
 }
 
+int MinimapWidget::positionToByteValue(const QPoint& pos) const {
+    if (plot_offset_ <= 0 || cache_image_.isNull()) return -1;
+    
+    const QRect content = contentRect();
+    const int across = vertical_layout_ ? pos.x() - content.left() : pos.y() - content.top();
+    const int extent = (vertical_layout_ ? cache_image_.width() : cache_image_.height()) - plot_offset_;
+    if (across < plot_offset_ || extent <= 0) return -1;
+    return std::min(255, (across - plot_offset_) * 256 / extent);
+}
+
 void MinimapWidget::renderToCache() {
     const QRect content = contentRect();
     
@@ -253,71 +442,42 @@ void MinimapWidget::renderToCache() {
         return;
     }
     
-    const ViewportData viewport = data_source_->get_viewport();
-    const std::size_t num_blocks = data_source_->block_count();
-    const data_size_t vp_range = viewport.range();
-    
-    if (vp_range == 0) {
-        cache_valid_ = true;
-        cached_width_ = content.width();
-        cached_height_ = content.height();
-        return;
-    }
-    
-    // Render each block
-    for (std::size_t i = 0; i < num_blocks; ++i) {
-        const EntropyBlockData block = data_source_->get_block(i);
-        
-        // Skip blocks completely outside viewport
-        if (block.end_addr <= viewport.start_addr || block.start_addr >= viewport.end_addr) {
-            continue;
-        }
-        
-        // Clamp block addresses to viewport for proper rendering
-        const data_addr_t clamped_start = std::max(block.start_addr, viewport.start_addr);
-        const data_addr_t clamped_end = std::min(block.end_addr, viewport.end_addr);
-        
-        // Get color for this block's entropy
-        const Color color = gradient_.sample_entropy(block.entropy);
-        const QColor qcolor(color.r, color.g, color.b);
-        
-        if (vertical_layout_) {
-            // Calculate Y positions using direct ratio (avoids -1 return from address_to_y)
-            const double t1 = static_cast<double>(clamped_start - viewport.start_addr) / static_cast<double>(vp_range);
-            const double t2 = static_cast<double>(clamped_end - viewport.start_addr) / static_cast<double>(vp_range);
-            
-            const int y1 = static_cast<int>(t1 * content.height());
-            const int y2 = static_cast<int>(t2 * content.height());
-            
-            const int start_y = std::max(0, std::min(y1, y2));
-            const int end_y = std::min(content.height(), std::max(y1, y2) + 1);
-            
-            // Fill horizontal line for each row
-            for (int y = start_y; y < end_y; ++y) {
-                QRgb* line = reinterpret_cast<QRgb*>(cache_image_.scanLine(y));
-                for (int x = 0; x < content.width(); ++x) {
-                    line[x] = qcolor.rgb();
-                }
-            }
-        } else {
-            // Horizontal layout
-            const double t1 = static_cast<double>(clamped_start - viewport.start_addr) / static_cast<double>(vp_range);
-            const double t2 = static_cast<double>(clamped_end - viewport.start_addr) / static_cast<double>(vp_range);
-            
-            const int x1 = static_cast<int>(t1 * content.width());
-            const int x2 = static_cast<int>(t2 * content.width());
-            
-            const int start_x = std::max(0, std::min(x1, x2));
-            const int end_x = std::min(content.width(), std::max(x1, x2) + 1);
-            
-            // Fill vertical column for each column
-            for (int y = 0; y < content.height(); ++y) {
-                QRgb* line = reinterpret_cast<QRgb*>(cache_image_.scanLine(y));
-                for (int x = start_x; x < end_x; ++x) {
-                    line[x] = qcolor.rgb();
-                }
-            }
-        }
+    // With the byte plot the bar keeps a narrow strip and the plot gets the rest
+    const int across = vertical_layout_ ? content.width() : content.height();
+    const int along = vertical_layout_ ? content.height() : content.width();
+    const ByteHistogramPyramid* histograms = nullptr;
+    if (show_byte_plot_ && across > QT_BYTE_PLOT_BAR_WIDTH + QT_BYTE_PLOT_SPACING + 16) {
+        histograms = data_source_->byte_histograms(data_source_->get_viewport().range() / static_cast<data_size_t>(along));
+        if (data_source_->byte_histograms_pending()) histogram_timer_.start();
+    }
+    plot_offset_ = histograms ? QT_BYTE_PLOT_BAR_WIDTH + QT_BYTE_PLOT_SPACING : 0;
+    const int bar = histograms ? QT_BYTE_PLOT_BAR_WIDTH : across;
+    
+    auto* pixels = reinterpret_cast<std::uint32_t*>(cache_image_.bits());
+    const std::size_t stride = static_cast<std::size_t>(cache_image_.bytesPerLine()) / sizeof(QRgb);
+    rasterize_entropy(
+        *data_source_,
+        gradient_,
+        vertical_layout_,
+        vertical_layout_ ? bar : content.width(),
+        vertical_layout_ ? content.height() : bar,
+        pixels,
+        stride
+    );
+    
+    if (histograms) {
+        std::uint32_t* plot = vertical_layout_
+            ? pixels + plot_offset_
+            : pixels + static_cast<std::size_t>(plot_offset_) * stride;
+        byte_plot_.rasterize(
+            *data_source_,
+            *histograms,
+            vertical_layout_,
+            vertical_layout_ ? content.width() - plot_offset_ : content.width(),
+            vertical_layout_ ? content.height() : content.height() - plot_offset_,
+            plot,
+            stride
+        );
     }
     
     cache_valid_ = true;
@@ -553,7 +713,94 @@ void MinimapWidget::drawCursorGap(QPainter& painter) {
     ));
 }
 
+void MinimapWidget::drawSelection(QPainter& painter) {
+    if (selection_anchor_ == DATA_BADADDR || selection_end_ == DATA_BADADDR || !data_source_) {
+        return;
+    }
+    
+    // Ends outside the viewport clamp to the nearer edge
+    const QRect content = contentRect();
+    const ViewportData viewport = data_source_->get_viewport();
+    auto edge = [&](data_addr_t addr) {
+        const int pos = addressToPosition(addr);
+        if (pos >= 0) return pos;
+        if (addr < viewport.start_addr) return vertical_layout_ ? content.top() : content.left();
+        return vertical_layout_ ? content.bottom() : content.right();
+    };
+    const int a = edge(std::min(selection_anchor_, selection_end_));
+    const int b = edge(std::max(selection_anchor_, selection_end_));
+    
+    const QColor fill(colors::SelectionFill.r, colors::SelectionFill.g,
+                      colors::SelectionFill.b, colors::SelectionFill.a);
+    const QColor line(colors::SelectionEdge.r, colors::SelectionEdge.g,
+                      colors::SelectionEdge.b, colors::SelectionEdge.a);
+    painter.setPen(line);
+    if (vertical_layout_) {
+        painter.fillRect(content.left(), a, content.width(), std::max(1, b - a), fill);
+        painter.drawLine(content.left(), a, content.right(), a);
+        painter.drawLine(content.left(), b, content.right(), b);
+    } else {
+        painter.fillRect(a, content.top(), std::max(1, b - a), content.height(), fill);
+        painter.drawLine(a, content.top(), a, content.bottom());
+        painter.drawLine(b, content.top(), b, content.bottom());
+    }
+}
+
+void MinimapWidget::updateDigraph() {
+    if (!data_source_ || !data_source_->is_valid() ||
+        selection_anchor_ == DATA_BADADDR || selection_end_ == DATA_BADADDR) {
+        return;
+    }
+    const data_addr_t lo = std::min(selection_anchor_, selection_end_);
+    const data_addr_t hi = std::max(selection_anchor_, selection_end_);
+    if (lo == hi) return;
+    
+    // Bytes are read here, on the UI thread; counting fans out to the workers
+    data_size_t mapped = 0;
+    const std::size_t read = readSelection(*data_source_, lo, hi, digraph_bytes_, mapped, digraph_breaks_);
+    digraph_.compute(std::span<const std::uint8_t>(digraph_bytes_.data(), read), digraph_breaks_);
+    
+    QString caption = QString("0x%1 - 0x%2: %3 bytes")
+        .arg(lo, 0, 16).arg(hi, 0, 16).arg(mapped);
+    if (read < mapped) {
+        caption += QString(" (%1 sampled)").arg(read);
+    }
+    
+    if (!digraph_window_) {
+        digraph_window_ = new DigraphWindow(this);
+    }
+    digraph_window_->setDigraph(&digraph_, gradient_, caption);
+    if (!digraph_window_->isVisible()) {
+        digraph_window_->show();
+    }
+}
+
+void MinimapWidget::clearSelection() {
+    is_selecting_ = false;
+    selection_anchor_ = DATA_BADADDR;
+    selection_end_ = DATA_BADADDR;
+    digraph_timer_.stop();
+    if (digraph_window_) {
+        digraph_window_->hide();
+    }
+    update();
+}
+
+void MinimapWidget::traceLayout() {
+    const float w = static_cast<float>(width());
+    const float h = static_cast<float>(height());
+    synopsia_trace_minimap_layout(w, h, vertical_layout_);
+    traceInput(TraceInput::Resize, w, h, vertical_layout_ ? 1 : 0);
+}
+
+void MinimapWidget::traceInput(TraceInput input, float x, float y, std::int64_t value) {
+    if (!synopsia_trace_recording()) return;
+    synopsia_trace_input(TRACE_WIDGET, static_cast<int>(input), x, y, value);
+    input_traced_ = true;
+}
+
 void MinimapWidget::paintEvent(QPaintEvent* event) {
+    const auto paint_start = std::chrono::steady_clock::now();
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing, false);
     
@@ -570,19 +817,35 @@ void MinimapWidget::paintEvent(QPaintEvent* event) {
     // Draw overlays (order matters for visibility)
     drawRegions(painter);       // Faint segment separators
     drawCursorGap(painter);     // Gap background at cursor position
+    drawSelection(painter);     // Shift+drag range
     drawHover(painter);         // Hover highlight
     drawCursor(painter);        // Current cursor position line
     
     // Draw border
     painter.setPen(QColor(64, 64, 64));
     painter.drawRect(contentRect().adjusted(0, 0, -1, -1));
+    
+    if (input_traced_) {
+        const auto elapsed = std::chrono::steady_clock::now() - paint_start;
+        synopsia_trace_frame(TRACE_WIDGET, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+        input_traced_ = false;
+    }
 }
 
 void MinimapWidget::mousePressEvent(QMouseEvent* event) {
     if (event->button() == Qt::LeftButton) {
+        traceInput(TraceInput::MousePos, static_cast<float>(event->pos().x()), static_cast<float>(event->pos().y()), 0);
+        traceInput(TraceInput::MouseButton, 0.0f, 0.0f, 1 << 8);  // Left button down
         const data_addr_t addr = positionToAddress(event->pos());
         
-        if (addr != DATA_BADADDR) {
+        if (addr != DATA_BADADDR && (event->modifiers() & Qt::ShiftModifier)) {
+            // Start a range selection instead of navigating
+            is_selecting_ = true;
+            selection_anchor_ = addr;
+            selection_end_ = addr;
+            update();
+        } else if (addr != DATA_BADADDR) {
             // Start drag for panning
             is_dragging_ = true;
             drag_start_ = event->pos();
@@ -602,9 +865,17 @@ void MinimapWidget::mousePressEvent(QMouseEvent* event) {
 }
 
 void MinimapWidget::mouseMoveEvent(QMouseEvent* event) {
+    traceInput(TraceInput::MousePos, static_cast<float>(event->pos().x()), static_cast<float>(event->pos().y()), 0);
     const data_addr_t addr = positionToAddress(event->pos());
     
-    if (is_dragging_) {
+    if (is_selecting_) {
+        if (addr != DATA_BADADDR && addr != selection_end_) {
+            selection_end_ = addr;
+            digraph_timer_.start();
+            update();
+        }
+        hover_addr_ = addr;
+    } else if (is_dragging_) {
         // Update cursor position immediately while dragging
         if (addr != DATA_BADADDR) {
             setCurrentAddress(addr);
@@ -640,6 +911,20 @@ void MinimapWidget::mouseMoveEvent(QMouseEvent* event) {
                 tooltip += QString("\nJS Divergence: %1").arg(js_value, 0, 'f', 2);
             }
             
+            // Over the byte plot: share of the byte value in this line
+            const int byte_value = positionToByteValue(event->pos());
+            if (byte_value >= 0) {
+                const int line = vertical_layout_
+                    ? data_source_->address_to_y(addr, cache_image_.height())
+                    : data_source_->address_to_x(addr, cache_image_.width());
+                const double share = byte_plot_.share_at(line, byte_value);
+                if (share >= 0.0) {
+                    tooltip += QString("\nByte 0x%1: %2%")
+                        .arg(byte_value, 2, 16, QChar('0'))
+                        .arg(share * 100.0, 0, 'f', 2);
+                }
+            }
+            
             QToolTip::showText(event->globalPosition().toPoint(), tooltip, this);
         }
         
@@ -651,7 +936,9 @@ void MinimapWidget::mouseMoveEvent(QMouseEvent* event) {
 
 void MinimapWidget::mouseReleaseEvent(QMouseEvent* event) {
     if (event->button() == Qt::LeftButton) {
+        traceInput(TraceInput::MouseButton, 0.0f, 0.0f, 0);
         is_dragging_ = false;
+        is_selecting_ = false;
     }
     
     QWidget::mouseReleaseEvent(event);
@@ -670,6 +957,10 @@ void MinimapWidget::wheelEvent(QWheelEvent* event) {
         return;
     }
     
+    const QPoint pos = event->position().toPoint();
+    traceInput(TraceInput::MousePos, static_cast<float>(pos.x()), static_cast<float>(pos.y()), 0);
+    traceInput(TraceInput::Wheel, 0.0f, delta / 120.0f, 0);
+    
     // Calculate zoom factor
     const double factor = (delta > 0) ? 1.2 : (1.0 / 1.2);
     
@@ -685,7 +976,23 @@ void MinimapWidget::wheelEvent(QWheelEvent* event) {
     event->accept();
 }
 
+void MinimapWidget::keyPressEvent(QKeyEvent* event) {
+    if (event->key() == Qt::Key_B && event->modifiers() == Qt::NoModifier) {
+        setShowBytePlot(!show_byte_plot_);
+        event->accept();
+        return;
+    }
+    if (event->key() == Qt::Key_Escape && selection_anchor_ != DATA_BADADDR) {
+        clearSelection();
+        event->accept();
+        return;
+    }
+    
+    QWidget::keyPressEvent(event);
+}
+
 void MinimapWidget::resizeEvent(QResizeEvent* event) {
+    traceLayout();
     invalidateCache();
     QWidget::resizeEvent(event);
 }
@@ -0,0 +1,490 @@
+/// @file score_image.cpp
+/// @brief Streaming score image export implementation
+///
+/// The PNG encoder is self-contained. Rows are filtered with Sub or Up,
+/// whichever leaves more zero bytes, and compressed with fixed-Huffman
+/// deflate that only emits distance-1 runs. Score images are large areas of
+/// flat color, which this reduces to a few bits per row while staying cheap
+/// enough to run per tile. Each tile is an independent deflate block ended
+/// by a sync flush, so tiles compress in parallel and concatenate into one
+/// zlib stream; the Adler-32 of the stream is combined from the tiles'.
+
+#include <synopsia/score_image.hpp>
+#include <synopsia/common/parallel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace synopsia {
+
+namespace {
+
+constexpr int TILE_ROWS = 16;
+constexpr int BYTES_PER_PIXEL = 3;
+
+// =============================================================================
+// Checksums
+// =============================================================================
+
+constexpr std::array<std::uint32_t, 256> make_crc_table() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr auto CRC_TABLE = make_crc_table();
+
+std::uint32_t crc32(const std::uint8_t* data, std::size_t size) {
+    std::uint32_t c = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i) {
+        c = CRC_TABLE[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+constexpr std::uint32_t ADLER_BASE = 65521;
+
+std::uint32_t adler32(const std::uint8_t* data, std::size_t size) {
+    constexpr std::size_t NMAX = 5552;  // Largest run without 32-bit overflow
+    std::uint32_t a = 1;
+    std::uint32_t b = 0;
+    while (size > 0) {
+        const std::size_t n = std::min(size, NMAX);
+        for (std::size_t i = 0; i < n; ++i) {
+            a += data[i];
+            b += a;
+        }
+        a %= ADLER_BASE;
+        b %= ADLER_BASE;
+        data += n;
+        size -= n;
+    }
+    return (b << 16) | a;
+}
+
+/// Adler-32 of A followed by B, from adler(A), adler(B) and |B|
+std::uint32_t adler32_combine(std::uint32_t first, std::uint32_t second, std::size_t second_size) {
+    const std::uint32_t rem = static_cast<std::uint32_t>(second_size % ADLER_BASE);
+    std::uint32_t sum1 = first & 0xFFFF;
+    std::uint32_t sum2 = static_cast<std::uint32_t>((static_cast<std::uint64_t>(rem) * sum1) % ADLER_BASE);
+    sum1 += (second & 0xFFFF) + ADLER_BASE - 1;
+    sum2 += ((first >> 16) & 0xFFFF) + ((second >> 16) & 0xFFFF) + ADLER_BASE - rem;
+    if (sum1 >= ADLER_BASE) sum1 -= ADLER_BASE;
+    if (sum1 >= ADLER_BASE) sum1 -= ADLER_BASE;
+    if (sum2 >= ADLER_BASE * 2) sum2 -= ADLER_BASE * 2;
+    if (sum2 >= ADLER_BASE) sum2 -= ADLER_BASE;
+    return sum1 | (sum2 << 16);
+}
+
+void put_be32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    out.push_back(static_cast<std::uint8_t>(value >> 24));
+    out.push_back(static_cast<std::uint8_t>(value >> 16));
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+// =============================================================================
+// Run-Length Deflate (fixed Huffman codes, RFC 1951 3.2.6)
+// =============================================================================
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::uint8_t>& out) : out_(out) {}
+
+    /// Append `count` bits of value, least significant first
+    void put(std::uint32_t value, int count) {
+        bits_ |= static_cast<std::uint64_t>(value) << pending_;
+        pending_ += count;
+        while (pending_ >= 8) {
+            out_.push_back(static_cast<std::uint8_t>(bits_));
+            bits_ >>= 8;
+            pending_ -= 8;
+        }
+    }
+
+    /// Append a Huffman code (stored most significant bit first)
+    void put_code(std::uint32_t code, int length) {
+        std::uint32_t reversed = 0;
+        for (int i = 0; i < length; ++i) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        put(reversed, length);
+    }
+
+    void align() {
+        if (pending_ > 0) put(0, 8 - pending_);
+    }
+
+private:
+    std::vector<std::uint8_t>& out_;
+    std::uint64_t bits_ = 0;
+    int pending_ = 0;
+};
+
+void put_symbol(BitWriter& w, int symbol) {
+    if (symbol < 144) {
+        w.put_code(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        w.put_code(0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        w.put_code(symbol - 256, 7);
+    } else {
+        w.put_code(0xC0 + symbol - 280, 8);
+    }
+}
+
+constexpr std::array<int, 29> LENGTH_BASE = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<int, 29> LENGTH_EXTRA = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+/// Repeat the previous byte `length` times (3..258)
+void put_run(BitWriter& w, int length) {
+    int code = static_cast<int>(LENGTH_BASE.size()) - 1;
+    while (LENGTH_BASE[code] > length) --code;
+    put_symbol(w, 257 + code);
+    if (LENGTH_EXTRA[code] > 0) {
+        w.put(static_cast<std::uint32_t>(length - LENGTH_BASE[code]), LENGTH_EXTRA[code]);
+    }
+    w.put_code(0, 5);  // Distance 1
+}
+
+/// Compress data as one non-final block followed by a sync flush, so the
+/// output can be concatenated with other such blocks
+void deflate_runs(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out) {
+    constexpr std::size_t MAX_RUN = 258;
+
+    BitWriter w(out);
+    w.put(0, 1);  // BFINAL
+    w.put(1, 2);  // BTYPE = fixed Huffman
+
+    std::size_t i = 0;
+    while (i < size) {
+        const std::uint8_t value = data[i];
+        put_symbol(w, value);
+        ++i;
+
+        std::size_t run = 0;
+        while (i + run < size && data[i + run] == value) ++run;
+        if (run < 3) continue;
+
+        i += run;
+        while (run >= 3) {
+            const std::size_t length = std::min(run, MAX_RUN);
+            put_run(w, static_cast<int>(length));
+            run -= length;
+        }
+        for (; run > 0; --run) put_symbol(w, value);
+    }
+    put_symbol(w, 256);  // End of block
+
+    // Empty stored block: byte-aligns the stream
+    w.put(0, 3);
+    w.align();
+    out.insert(out.end(), {0x00, 0x00, 0xFF, 0xFF});
+}
+
+// =============================================================================
+// Pixel Mapping
+// =============================================================================
+
+/// Hilbert index of cell (x, y) on an n x n grid
+std::uint64_t hilbert_xy2d(std::uint32_t n, std::uint32_t x, std::uint32_t y) {
+    std::uint64_t d = 0;
+    for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+        const std::uint32_t rx = (x & s) ? 1 : 0;
+        const std::uint32_t ry = (y & s) ? 1 : 0;
+        d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/// Blocks laid end to end, with their colors
+class ScoreAxis {
+public:
+    ScoreAxis(std::span<const EntropyBlockData> blocks, const ColorGradient& gradient) {
+        ends_.reserve(blocks.size());
+        colors_.reserve(blocks.size());
+        std::uint64_t total = 0;
+        for (const auto& block : blocks) {
+            total += std::max<data_size_t>(block.size(), 1);
+            ends_.push_back(total);
+            colors_.push_back(gradient.sample_entropy(block.entropy).to_argb());
+        }
+    }
+
+    [[nodiscard]] std::uint64_t total() const noexcept { return ends_.empty() ? 0 : ends_.back(); }
+
+    /// Color at an axis offset; `hint` is the previous answer's block
+    [[nodiscard]] std::uint32_t color_at(std::uint64_t offset, std::size_t& hint) const {
+        const std::uint64_t start = hint == 0 ? 0 : ends_[hint - 1];
+        if (offset < start || offset >= ends_[hint]) {
+            hint = static_cast<std::size_t>(std::upper_bound(ends_.begin(), ends_.end(), offset) - ends_.begin());
+            hint = std::min(hint, ends_.size() - 1);
+        }
+        return colors_[hint];
+    }
+
+private:
+    std::vector<std::uint64_t> ends_;
+    std::vector<std::uint32_t> colors_;
+};
+
+class RowRenderer {
+public:
+    RowRenderer(const ScoreAxis& axis, const ScoreImageOptions& options, int width, int height)
+        : axis_(axis), options_(options), width_(width), height_(height) {}
+
+    /// Fill one row of RGB pixels
+    void render(int y, std::uint8_t* rgb) const {
+        std::size_t hint = 0;
+        auto put = [&rgb](int x, std::uint32_t argb) {
+            std::uint8_t* p = rgb + static_cast<std::size_t>(x) * BYTES_PER_PIXEL;
+            p[0] = static_cast<std::uint8_t>(argb >> 16);
+            p[1] = static_cast<std::uint8_t>(argb >> 8);
+            p[2] = static_cast<std::uint8_t>(argb);
+        };
+
+        if (options_.layout == ScoreImageLayout::Hilbert) {
+            const double cell = static_cast<double>(axis_.total()) /
+                                (static_cast<double>(width_) * static_cast<double>(width_));
+            for (int x = 0; x < width_; ++x) {
+                const std::uint64_t d = hilbert_xy2d(static_cast<std::uint32_t>(width_),
+                                                     static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y));
+                put(x, axis_.color_at(offset(d, cell), hint));
+            }
+            return;
+        }
+
+        if (options_.vertical) {
+            const double line = static_cast<double>(axis_.total()) / height_;
+            const std::uint32_t argb = axis_.color_at(offset(static_cast<std::uint64_t>(y), line), hint);
+            for (int x = 0; x < width_; ++x) put(x, argb);
+        } else {
+            const double line = static_cast<double>(axis_.total()) / width_;
+            for (int x = 0; x < width_; ++x) {
+                put(x, axis_.color_at(offset(static_cast<std::uint64_t>(x), line), hint));
+            }
+        }
+    }
+
+private:
+    /// Axis offset at the center of slot `index` of `slot` bytes each
+    [[nodiscard]] std::uint64_t offset(std::uint64_t index, double slot) const {
+        const double at = (static_cast<double>(index) + 0.5) * slot;
+        return std::min(static_cast<std::uint64_t>(at), axis_.total() - 1);
+    }
+
+    const ScoreAxis& axis_;
+    const ScoreImageOptions& options_;
+    int width_;
+    int height_;
+};
+
+// =============================================================================
+// Tiles
+// =============================================================================
+
+/// Rows [first, first + count) as a ready-to-write IDAT chunk
+struct EncodedTile {
+    std::vector<std::uint8_t> chunk;  // "IDAT" + deflate data
+    std::uint32_t crc = 0;
+    std::uint32_t adler = 1;
+    std::size_t raw_size = 0;
+};
+
+/// Filter a row into out (1 + row bytes): Sub or Up, whichever has more zeros
+void filter_row(const std::uint8_t* row, const std::uint8_t* above, std::size_t size, std::uint8_t* out) {
+    std::size_t sub_zeros = 0;
+    std::size_t up_zeros = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const std::uint8_t left = i >= BYTES_PER_PIXEL ? row[i - BYTES_PER_PIXEL] : 0;
+        sub_zeros += row[i] == left;
+        up_zeros += row[i] == above[i];
+    }
+
+    if (up_zeros > sub_zeros) {
+        out[0] = 2;
+        for (std::size_t i = 0; i < size; ++i) {
+            out[1 + i] = static_cast<std::uint8_t>(row[i] - above[i]);
+        }
+    } else {
+        out[0] = 1;
+        for (std::size_t i = 0; i < size; ++i) {
+            const std::uint8_t left = i >= BYTES_PER_PIXEL ? row[i - BYTES_PER_PIXEL] : 0;
+            out[1 + i] = static_cast<std::uint8_t>(row[i] - left);
+        }
+    }
+}
+
+void encode_tile(const RowRenderer& renderer, int width, int first, int count, EncodedTile& tile) {
+    const std::size_t row_bytes = static_cast<std::size_t>(width) * BYTES_PER_PIXEL;
+    std::vector<std::uint8_t> above(row_bytes, 0);  // The row before the image is all zeros
+    std::vector<std::uint8_t> row(row_bytes);
+    std::vector<std::uint8_t> raw((row_bytes + 1) * static_cast<std::size_t>(count));
+
+    if (first > 0) {
+        renderer.render(first - 1, above.data());
+    }
+    for (int i = 0; i < count; ++i) {
+        renderer.render(first + i, row.data());
+        filter_row(row.data(), above.data(), row_bytes, raw.data() + (row_bytes + 1) * i);
+        std::swap(row, above);
+    }
+
+    tile.chunk.assign({'I', 'D', 'A', 'T'});
+    deflate_runs(raw.data(), raw.size(), tile.chunk);
+    tile.crc = crc32(tile.chunk.data(), tile.chunk.size());
+    tile.adler = adler32(raw.data(), raw.size());
+    tile.raw_size = raw.size();
+}
+
+// =============================================================================
+// PNG File
+// =============================================================================
+
+class PngFile {
+public:
+    ~PngFile() {
+        if (file_) std::fclose(file_);
+    }
+
+    bool open(const std::string& path) {
+        file_ = std::fopen(path.c_str(), "wb");
+        return file_ != nullptr;
+    }
+
+    bool close() {
+        const bool ok = ok_ && std::fclose(file_) == 0;
+        file_ = nullptr;
+        return ok;
+    }
+
+    void write_signature() {
+        static constexpr std::uint8_t SIGNATURE[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        write(SIGNATURE, sizeof(SIGNATURE));
+    }
+
+    /// Chunk from a type and payload (checksum computed here)
+    void write_chunk(const char (&type)[5], const std::vector<std::uint8_t>& payload) {
+        std::vector<std::uint8_t> chunk(type, type + 4);
+        chunk.insert(chunk.end(), payload.begin(), payload.end());
+        write_chunk(chunk, crc32(chunk.data(), chunk.size()));
+    }
+
+    /// Chunk already holding its type tag
+    void write_chunk(const std::vector<std::uint8_t>& chunk, std::uint32_t crc) {
+        std::vector<std::uint8_t> frame;
+        put_be32(frame, static_cast<std::uint32_t>(chunk.size() - 4));
+        write(frame.data(), frame.size());
+        write(chunk.data(), chunk.size());
+        frame.clear();
+        put_be32(frame, crc);
+        write(frame.data(), frame.size());
+    }
+
+    [[nodiscard]] bool ok() const noexcept { return ok_; }
+
+private:
+    void write(const std::uint8_t* data, std::size_t size) {
+        if (ok_ && size > 0) {
+            ok_ = std::fwrite(data, 1, size, file_) == size;
+        }
+    }
+
+    std::FILE* file_ = nullptr;
+    bool ok_ = true;
+};
+
+} // anonymous namespace
+
+bool export_score_image(
+    std::span<const EntropyBlockData> blocks,
+    const ColorGradient& gradient,
+    const ScoreImageOptions& options,
+    const std::string& path,
+    std::string* error
+) {
+    auto fail = [error](const char* what) {
+        if (error) *error = what;
+        return false;
+    };
+
+    const bool hilbert = options.layout == ScoreImageLayout::Hilbert;
+    const int width = options.width;
+    const int height = hilbert ? options.width : options.height;
+    if (width <= 0 || height <= 0 || width > SCORE_IMAGE_MAX_EDGE || height > SCORE_IMAGE_MAX_EDGE) {
+        return fail("image size out of range");
+    }
+    if (hilbert && (width & (width - 1)) != 0) {
+        return fail("Hilbert image edge must be a power of two");
+    }
+    if (blocks.empty()) {
+        return fail("no block scores");
+    }
+
+    const ScoreAxis axis(blocks, gradient);
+    const RowRenderer renderer(axis, options, width, height);
+
+    PngFile png;
+    if (!png.open(path)) {
+        return fail("cannot create file");
+    }
+
+    png.write_signature();
+    std::vector<std::uint8_t> header;
+    put_be32(header, static_cast<std::uint32_t>(width));
+    put_be32(header, static_cast<std::uint32_t>(height));
+    header.insert(header.end(), {8, 2, 0, 0, 0});  // 8-bit RGB, deflate, adaptive filter, no interlace
+    png.write_chunk("IHDR", header);
+    png.write_chunk("IDAT", {0x78, 0x01});  // zlib header: deflate, 32K window
+
+    const int band_rows = std::max(options.band_rows, TILE_ROWS);
+    std::vector<EncodedTile> tiles;
+    std::uint32_t adler = 1;
+    for (int band = 0; band < height && png.ok(); band += band_rows) {
+        const int rows = std::min(band_rows, height - band);
+        tiles.assign(static_cast<std::size_t>((rows + TILE_ROWS - 1) / TILE_ROWS), EncodedTile{});
+
+        parallel_for(tiles.size(), 1, [&](std::size_t i) {
+            const int first = band + static_cast<int>(i) * TILE_ROWS;
+            encode_tile(renderer, width, first, std::min(TILE_ROWS, band + rows - first), tiles[i]);
+        });
+
+        for (const auto& tile : tiles) {
+            png.write_chunk(tile.chunk, tile.crc);
+            adler = adler32_combine(adler, tile.adler, tile.raw_size);
+        }
+    }
+
+    // Empty final block, then the stream checksum
+    std::vector<std::uint8_t> trailer = {0x03, 0x00};
+    put_be32(trailer, adler);
+    png.write_chunk("IDAT", trailer);
+    png.write_chunk("IEND", {});
+
+    if (!png.close()) {
+        return fail("write failed");
+    }
+    return true;
+}
+
+} // namespace synopsia
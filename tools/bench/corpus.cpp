@@ -0,0 +1,350 @@
+/// @file corpus.cpp
+/// @brief Synthetic symbol corpus generator
+
+#include "corpus.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace synopsia {
+namespace bench {
+
+using features::function_search::FUNC_BADADDR;
+
+namespace {
+
+/// splitmix64: small, fast and good enough for picking words
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed) : state_(seed) {}
+
+    std::uint64_t next() noexcept {
+        std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /// Uniform in [0, n)
+    std::size_t below(std::size_t n) noexcept { return static_cast<std::size_t>(next() % n); }
+
+    /// True with probability percent/100
+    bool chance(unsigned percent) noexcept { return below(100) < percent; }
+
+    template <typename T, std::size_t N>
+    const T& pick(const T (&items)[N]) noexcept { return items[below(N)]; }
+
+private:
+    std::uint64_t state_;
+};
+
+constexpr const char* NAMESPACES[] = {
+    "std", "boost", "llvm", "absl", "google", "protobuf", "v8", "base", "net", "mozilla", "icu", "grpc",
+    "detail", "internal", "impl", "util", "io", "json", "crypto", "gfx", "media", "sql", "ui", "ipc",
+};
+
+constexpr const char* CLASSES[] = {
+    "Vector", "HashMap", "Connection", "Parser", "Buffer", "Session", "Request", "Response", "Handler",
+    "Allocator", "Context", "Stream", "Token", "Node", "Visitor", "Thread", "Mutex", "Socket", "Tree",
+    "Builder", "Reader", "Writer", "Channel", "Scheduler", "Cache", "Decoder", "Encoder", "Object",
+};
+
+constexpr const char* METHODS[] = {
+    "create", "destroy", "init", "reset", "read", "write", "parse", "flush", "close", "open", "insert",
+    "erase", "find", "resize", "reserve", "clear", "visit", "handle_event", "get_size", "set_value",
+    "process", "dispatch", "lock", "unlock", "serialize", "deserialize", "encode", "decode", "update",
+};
+
+/// Parameter type: Itanium code, MSVC code, demangled (Itanium, MSVC spelling)
+struct ParamType {
+    const char* itanium;
+    const char* msvc;
+    const char* itanium_text;
+    const char* msvc_text;
+};
+
+constexpr ParamType PARAM_TYPES[] = {
+    {"i", "H", "int", "int"},
+    {"j", "I", "unsigned int", "unsigned int"},
+    {"b", "_N", "bool", "bool"},
+    {"l", "J", "long", "long"},
+    {"m", "K", "unsigned long", "unsigned long"},
+    {"d", "N", "double", "double"},
+    {"PKc", "PEBD", "char const*", "char const *"},
+    {"Pv", "PEAX", "void*", "void *"},
+    {"RKSs", "AEBV?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@",
+     "std::string const&", "class std::basic_string<char,struct std::char_traits<char>,class std::allocator<char> > const &"},
+};
+
+constexpr const char* RUST_CRATES[] = {"core", "alloc", "std", "tokio", "serde", "hyper", "regex", "futures", "mio"};
+constexpr const char* RUST_MODULES[] = {"ptr", "vec", "fmt", "io", "sync", "runtime", "de", "ser", "task", "net", "iter"};
+constexpr const char* RUST_FUNCTIONS[] = {
+    "drop_in_place", "poll", "next", "fmt", "clone", "from_iter", "deserialize_any", "spawn", "read_buf",
+    "call_once", "try_fold", "extend", "with_capacity", "push", "as_str",
+};
+
+constexpr const char* GO_PACKAGES[] = {
+    "runtime", "net/http", "encoding/json", "crypto/tls", "sync", "os", "io", "main", "syscall",
+    "github.com/golang/protobuf/proto", "google.golang.org/grpc", "internal/poll", "reflect",
+};
+constexpr const char* GO_TYPES[] = {"conn", "Server", "Client", "Decoder", "Mutex", "File", "pollDesc", "Value"};
+constexpr const char* GO_FUNCTIONS[] = {
+    "serve", "Read", "Write", "Close", "Lock", "Unlock", "mallocgc", "newobject", "gcDrain", "Marshal",
+    "Unmarshal", "Handshake", "readLoop", "writeLoop", "schedule", "findrunnable", "Call",
+};
+
+void append_length_prefixed(std::string& out, std::string_view part) {
+    out += std::to_string(part.size());
+    out += part;
+}
+
+/// Itanium/MSVC pair from the same qualified name and signature
+void make_cpp(Rng& rng, bool msvc, std::string& name, std::string& demangled) {
+    const std::size_t depth = 1 + rng.below(3);
+    std::vector<const char*> scopes;
+    for (std::size_t i = 0; i < depth; ++i) {
+        scopes.push_back(rng.pick(NAMESPACES));
+    }
+    const char* cls = rng.pick(CLASSES);
+    const bool templated = rng.chance(25);
+    const ParamType& template_arg = rng.pick(PARAM_TYPES);
+    const char* method = rng.pick(METHODS);
+    const bool is_const = rng.chance(30);
+
+    std::vector<const ParamType*> params;
+    const std::size_t param_count = rng.below(4);
+    for (std::size_t i = 0; i < param_count; ++i) {
+        params.push_back(&rng.pick(PARAM_TYPES));
+    }
+
+    if (!msvc) {
+        name = is_const ? "_ZNK" : "_ZN";
+        demangled.clear();
+        for (const char* scope : scopes) {
+            append_length_prefixed(name, scope);
+            demangled += scope;
+            demangled += "::";
+        }
+        append_length_prefixed(name, cls);
+        demangled += cls;
+        if (templated) {
+            name += 'I';
+            name += template_arg.itanium;
+            name += 'E';
+            demangled += '<';
+            demangled += template_arg.itanium_text;
+            demangled += '>';
+        }
+        append_length_prefixed(name, method);
+        name += 'E';
+        demangled += "::";
+        demangled += method;
+        demangled += '(';
+        if (params.empty()) name += 'v';
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            name += params[i]->itanium;
+            if (i > 0) demangled += ", ";
+            demangled += params[i]->itanium_text;
+        }
+        demangled += ')';
+        if (is_const) demangled += " const";
+        return;
+    }
+
+    // ?method@Class@ns@@QEAAX<params>@Z
+    name = "?";
+    name += method;
+    name += '@';
+    if (templated) {
+        name += "?$";
+        name += cls;
+        name += '@';
+        name += template_arg.msvc;
+        name += '@';
+    } else {
+        name += cls;
+        name += '@';
+    }
+    for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+        name += *it;
+        name += '@';
+    }
+    name += '@';
+    name += is_const ? "QEBA" : "QEAA";
+    name += 'X';
+    if (params.empty()) {
+        name += "XZ";
+    } else {
+        for (const ParamType* param : params) name += param->msvc;
+        name += "@Z";
+    }
+
+    demangled = "public: void __cdecl ";
+    for (const char* scope : scopes) {
+        demangled += scope;
+        demangled += "::";
+    }
+    demangled += cls;
+    if (templated) {
+        demangled += '<';
+        demangled += template_arg.msvc_text;
+        demangled += '>';
+    }
+    demangled += "::";
+    demangled += method;
+    demangled += '(';
+    if (params.empty()) demangled += "void";
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        if (i > 0) demangled += ',';
+        demangled += params[i]->msvc_text;
+    }
+    demangled += ')';
+    demangled += is_const ? " const __ptr64" : " __ptr64";
+}
+
+/// Rust legacy mangling: _ZN<crate><module><fn>17h<hash>E
+void make_rust(Rng& rng, std::string& name, std::string& demangled) {
+    const char* crate = rng.pick(RUST_CRATES);
+    const char* module = rng.pick(RUST_MODULES);
+    const char* function = rng.pick(RUST_FUNCTIONS);
+    char hash[20];
+    std::snprintf(hash, sizeof(hash), "h%016llx", static_cast<unsigned long long>(rng.next()));
+
+    name = "_ZN";
+    append_length_prefixed(name, crate);
+    append_length_prefixed(name, module);
+    append_length_prefixed(name, function);
+    append_length_prefixed(name, hash);
+    name += 'E';
+
+    demangled = crate;
+    demangled += "::";
+    demangled += module;
+    demangled += "::";
+    demangled += function;
+    demangled += "::";
+    demangled += hash;
+}
+
+/// Go symbols are not mangled: pkg.Func, pkg.(*Type).Method, pkg.Func.func1
+void make_go(Rng& rng, std::string& name) {
+    name = rng.pick(GO_PACKAGES);
+    name += '.';
+    switch (rng.below(3)) {
+        case 0:
+            name += rng.pick(GO_FUNCTIONS);
+            break;
+        case 1:
+            name += "(*";
+            name += rng.pick(GO_TYPES);
+            name += ").";
+            name += rng.pick(GO_FUNCTIONS);
+            break;
+        default:
+            name += rng.pick(GO_FUNCTIONS);
+            name += ".func";
+            name += std::to_string(1 + rng.below(9));
+            break;
+    }
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Corpus Generation
+// =============================================================================
+
+SymbolCorpus generate_corpus(std::size_t count, std::uint64_t seed) {
+    Rng rng(seed);
+    SymbolCorpus corpus;
+    corpus.addresses.reserve(count);
+    corpus.sizes.reserve(count);
+    corpus.names.resize(count);
+    corpus.demangled.resize(count);
+
+    func_addr_t address = 0x140001000ULL;
+    char auto_name[32];
+    for (std::size_t i = 0; i < count; ++i) {
+        // Sizes skew small, like real function size distributions
+        const std::uint32_t size = static_cast<std::uint32_t>(16 << rng.below(8)) + static_cast<std::uint32_t>(rng.below(16)) * 16;
+        corpus.addresses.push_back(address);
+        corpus.sizes.push_back(size);
+
+        std::string& name = corpus.names[i];
+        std::string& demangled = corpus.demangled[i];
+        const std::size_t kind = rng.below(100);
+        if (kind < 35) {
+            std::snprintf(auto_name, sizeof(auto_name), "sub_%llX", static_cast<unsigned long long>(address));
+            name = auto_name;
+        } else if (kind < 65) {
+            make_cpp(rng, false, name, demangled);
+        } else if (kind < 80) {
+            make_cpp(rng, true, name, demangled);
+        } else if (kind < 90) {
+            make_rust(rng, name, demangled);
+        } else {
+            make_go(rng, name);
+        }
+
+        address += size + 16 * rng.below(4);
+    }
+    return corpus;
+}
+
+// =============================================================================
+// CorpusSource
+// =============================================================================
+
+CorpusSource::CorpusSource(const SymbolCorpus& corpus)
+    : addresses_(corpus.addresses), sizes_(corpus.sizes) {
+    const std::size_t count = corpus.size();
+    std::size_t name_bytes = 0;
+    std::size_t demangled_bytes = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        name_bytes += corpus.names[i].size();
+        demangled_bytes += corpus.demangled[i].size();
+    }
+
+    names_.reserve(name_bytes);
+    demangled_.reserve(demangled_bytes);
+    name_offsets_.reserve(count + 1);
+    demangled_offsets_.reserve(count + 1);
+    name_offsets_.push_back(0);
+    demangled_offsets_.push_back(0);
+    for (std::size_t i = 0; i < count; ++i) {
+        names_ += corpus.names[i];
+        demangled_ += corpus.demangled[i];
+        name_offsets_.push_back(static_cast<std::uint32_t>(names_.size()));
+        demangled_offsets_.push_back(static_cast<std::uint32_t>(demangled_.size()));
+    }
+}
+
+std::string_view CorpusSource::name(std::size_t index) const {
+    return std::string_view(names_).substr(name_offsets_[index], name_offsets_[index + 1] - name_offsets_[index]);
+}
+
+std::string_view CorpusSource::demangled(std::size_t index) const {
+    return std::string_view(demangled_).substr(demangled_offsets_[index],
+                                               demangled_offsets_[index + 1] - demangled_offsets_[index]);
+}
+
+FunctionInfo CorpusSource::get_function(std::size_t index) const {
+    return {addresses_[index], std::string(name(index)), std::string(demangled(index))};
+}
+
+func_addr_t CorpusSource::find_function_by_name(std::string_view name_arg) const {
+    for (std::size_t i = 0; i < addresses_.size(); ++i) {
+        if (name(i) == name_arg) return addresses_[i];
+    }
+    return FUNC_BADADDR;
+}
+
+func_addr_t CorpusSource::find_function_at(func_addr_t address) const {
+    auto it = std::upper_bound(addresses_.begin(), addresses_.end(), address);
+    if (it == addresses_.begin()) return FUNC_BADADDR;
+    const std::size_t index = static_cast<std::size_t>(it - addresses_.begin()) - 1;
+    return address < addresses_[index] + sizes_[index] ? addresses_[index] : FUNC_BADADDR;
+}
+
+} // namespace bench
+} // namespace synopsia
@@ -0,0 +1,77 @@
+/// @file corpus.hpp
+/// @brief Synthetic symbol corpora for the search benchmark (no IDA dependencies)
+///
+/// The mix follows what large stripped-but-partially-symbolized binaries look
+/// like: mostly auto-named sub_XXXX functions and Itanium-mangled C++, with
+/// MSVC-mangled C++, Rust legacy-mangled paths and Go package paths on top.
+/// Mangled names carry their demangled form, built from the same parts, so
+/// the demangled-name paths (namespace tree, omnibox) see realistic input.
+/// Generation is deterministic for a given seed.
+
+#pragma once
+
+#include <synopsia/features/function_search/data_interface.hpp>
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace synopsia {
+namespace bench {
+
+using features::function_search::func_addr_t;
+using features::function_search::FunctionInfo;
+
+/// Generated symbols, in address order
+struct SymbolCorpus {
+    std::vector<func_addr_t> addresses;
+    std::vector<std::uint32_t> sizes;
+    std::vector<std::string> names;
+    std::vector<std::string> demangled;  // Empty where the name is not mangled
+
+    [[nodiscard]] std::size_t size() const noexcept { return addresses.size(); }
+};
+
+/// @brief Generate `count` symbols
+[[nodiscard]] SymbolCorpus generate_corpus(std::size_t count, std::uint64_t seed);
+
+/// @class CorpusSource
+/// @brief In-memory function catalog over a corpus
+///
+/// Names live in one arena with offsets, like the plugin's and the
+/// snapshot's catalogs, so catalog build time and memory per name are
+/// comparable with the real sources.
+class CorpusSource : public features::function_search::IFunctionDataSource {
+public:
+    explicit CorpusSource(const SymbolCorpus& corpus);
+
+    [[nodiscard]] bool is_valid() const override { return true; }
+    [[nodiscard]] std::size_t function_count() const override { return addresses_.size(); }
+    [[nodiscard]] FunctionInfo get_function(std::size_t index) const override;
+    [[nodiscard]] std::string_view function_name(std::size_t index) const override { return name(index); }
+    [[nodiscard]] std::string get_disassembly(func_addr_t) const override { return {}; }
+    [[nodiscard]] std::string get_decompilation(func_addr_t) const override { return {}; }
+    [[nodiscard]] bool has_decompiler() const override { return false; }
+    [[nodiscard]] func_addr_t find_function_by_name(std::string_view name) const override;
+    [[nodiscard]] func_addr_t find_function_at(func_addr_t address) const override;
+    bool refresh() override { return true; }
+    [[nodiscard]] std::uint64_t function_size(std::size_t index) const override { return sizes_[index]; }
+    [[nodiscard]] std::uint64_t revision() const override { return 1; }
+
+    [[nodiscard]] func_addr_t address(std::size_t index) const { return addresses_[index]; }
+    [[nodiscard]] std::string_view name(std::size_t index) const;
+    [[nodiscard]] std::string_view demangled(std::size_t index) const;
+
+private:
+    std::vector<func_addr_t> addresses_;
+    std::vector<std::uint32_t> sizes_;
+    std::vector<std::uint32_t> name_offsets_;       // count + 1
+    std::vector<std::uint32_t> demangled_offsets_;  // count + 1
+    std::string names_;
+    std::string demangled_;
+};
+
+} // namespace bench
+} // namespace synopsia
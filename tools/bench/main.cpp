@@ -0,0 +1,609 @@
+/// @file main.cpp
+/// @brief Synthetic-corpus benchmark for the function search stack
+///
+/// Generates symbol corpora of increasing size (see corpus.hpp), builds the
+/// function catalog and every search index over them, then replays scripted
+/// typing sessions one keystroke at a time and reports per-keystroke latency.
+/// Needs no IDA database, so search regressions show up in CI.
+///
+/// Usage: synopsia_search_bench [--sizes 10000,100000,500000,2000000]
+///                              [--matchers browser,omnibox,fuzzy,regex,trigram]
+///                              [--script <file>] [--seed N]
+///                              [--max-allocs-per-key N] [--max-allocs-per-1k N]
+///
+/// A script has one query per line (blank lines and lines starting with '#'
+/// are skipped); each query is typed character by character, so every prefix
+/// is one measured keystroke.
+///
+/// Matchers:
+///   browser   Function Search list filter (case-insensitive substring over names)
+///   omnibox   Omnibox engine over names and demangled names, submit to final result
+///   fuzzy     Reference: in-order subsequence scan over folded names
+///   regex     Reference: std::regex (ECMAScript, icase) per keystroke
+///   trigram   Reference: trigram posting lists, intersected then verified
+///
+/// The reference matchers have no UI yet; they give the baseline any future
+/// fuzzy/regex/indexed filter mode has to beat.
+///
+/// Allocation budgets (the exit status is 1 when one is exceeded):
+///   --max-allocs-per-key N  Worst keystroke of a second, warm replay of the
+///                           script (0 = steady-state keystrokes never allocate)
+///   --max-allocs-per-1k N   Catalog, name tree and matcher builds, per 1000 names
+
+#include "corpus.hpp"
+
+#include <synopsia/features/function_search/name_filter.hpp>
+#include <synopsia/features/function_search/name_tree.hpp>
+#include <synopsia/features/omnibox/search_engine.hpp>
+#include <synopsia/common/alloc_tracker.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <regex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace synopsia;
+using namespace synopsia::bench;
+
+// =============================================================================
+// Allocation Accounting
+// =============================================================================
+
+// Every allocation carries its size in a header, so live heap bytes can be
+// read before and after a build to get the memory an index keeps. Counts go
+// to AllocationCounter, so AllocationScope works here as in the plugin.
+
+namespace {
+
+std::atomic<std::size_t> g_live_bytes{0};
+
+constexpr std::size_t ALLOC_HEADER = alignof(std::max_align_t);
+
+void* counted_alloc(std::size_t size) {
+    void* block = std::malloc(size + ALLOC_HEADER);
+    if (!block) throw std::bad_alloc();
+    *static_cast<std::size_t*>(block) = size;
+    g_live_bytes.fetch_add(size, std::memory_order_relaxed);
+    AllocationCounter::note(size);
+    return static_cast<char*>(block) + ALLOC_HEADER;
+}
+
+void counted_free(void* ptr) noexcept {
+    if (!ptr) return;
+    void* block = static_cast<char*>(ptr) - ALLOC_HEADER;
+    g_live_bytes.fetch_sub(*static_cast<std::size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+} // anonymous namespace
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return counted_alloc(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+void operator delete(void* ptr) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { counted_free(ptr); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::size_t live_bytes() {
+    return g_live_bytes.load(std::memory_order_relaxed);
+}
+
+char fold(char c) noexcept {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::string folded(std::string_view text) {
+    std::string out(text);
+    for (char& c : out) c = fold(c);
+    return out;
+}
+
+// =============================================================================
+// Matchers
+// =============================================================================
+
+/// One search strategy: build once per corpus, then answer keystrokes
+class Matcher {
+public:
+    virtual ~Matcher() = default;
+    [[nodiscard]] virtual const char* name() const noexcept = 0;
+    virtual void build(const CorpusSource& source) = 0;
+    /// @return Number of matches (or results shown)
+    virtual std::size_t query(std::string_view text) = 0;
+};
+
+/// The Function Search list filter, exactly as the widget runs it
+class BrowserMatcher : public Matcher {
+public:
+    const char* name() const noexcept override { return "browser"; }
+    void build(const CorpusSource& source) override { source_ = &source; }
+    std::size_t query(std::string_view text) override {
+        features::function_search::filter_functions(*source_, text, out_);
+        return out_.size();
+    }
+
+private:
+    const CorpusSource* source_ = nullptr;
+    std::vector<std::size_t> out_;
+};
+
+/// Feeds one corpus column to the omnibox engine
+class CorpusProvider : public features::omnibox::ISearchProvider {
+public:
+    CorpusProvider(const CorpusSource& source, bool demangled) : source_(source), demangled_(demangled) {}
+
+    features::omnibox::SearchKind kind() const noexcept override {
+        return demangled_ ? features::omnibox::SearchKind::Demangled : features::omnibox::SearchKind::Function;
+    }
+    const char* name() const noexcept override { return demangled_ ? "Demangled" : "Functions"; }
+    void reset() override { next_ = 0; }
+
+    bool collect(features::omnibox::SearchIndexBuilder& out, Clock::time_point deadline) override {
+        const std::size_t count = source_.function_count();
+        while (next_ < count) {
+            const std::string_view text = demangled_ ? source_.demangled(next_) : source_.name(next_);
+            if (!text.empty()) out.add(source_.address(next_), text);
+            if (++next_ % 4096 == 0 && Clock::now() >= deadline) return false;
+        }
+        return true;
+    }
+
+private:
+    const CorpusSource& source_;
+    bool demangled_;
+    std::size_t next_ = 0;
+};
+
+/// The omnibox engine end to end: submit, wait for every provider, merge
+class OmniboxMatcher : public Matcher {
+public:
+    const char* name() const noexcept override { return "omnibox"; }
+
+    void build(const CorpusSource& source) override {
+        std::vector<std::unique_ptr<features::omnibox::ISearchProvider>> providers;
+        providers.push_back(std::make_unique<CorpusProvider>(source, false));
+        providers.push_back(std::make_unique<CorpusProvider>(source, true));
+        engine_ = std::make_unique<features::omnibox::SearchEngine>(std::move(providers));
+
+        while (!engine_->pump(std::chrono::milliseconds(16))) {
+        }
+        for (;;) {
+            const auto status = engine_->status();
+            if (std::all_of(status.begin(), status.end(), [](const auto& s) { return s.ready; })) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    std::size_t query(std::string_view text) override {
+        engine_->submit(text);
+        while (engine_->is_searching()) {
+            std::this_thread::yield();
+        }
+        engine_->poll(results_);
+        return results_.size();
+    }
+
+private:
+    std::unique_ptr<features::omnibox::SearchEngine> engine_;
+    std::vector<features::omnibox::SearchResult> results_;
+};
+
+/// Folded copy of every name, shared by the reference matchers
+class FoldedNames {
+public:
+    void build(const CorpusSource& source) {
+        const std::size_t count = source.function_count();
+        text_.clear();
+        offsets_.assign(1, 0);
+        offsets_.reserve(count + 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            for (char c : source.name(i)) text_.push_back(fold(c));
+            offsets_.push_back(static_cast<std::uint32_t>(text_.size()));
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return offsets_.size() - 1; }
+    [[nodiscard]] std::string_view operator[](std::size_t i) const noexcept {
+        return std::string_view(text_).substr(offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+private:
+    std::string text_;
+    std::vector<std::uint32_t> offsets_;
+};
+
+class FuzzyMatcher : public Matcher {
+public:
+    const char* name() const noexcept override { return "fuzzy"; }
+    void build(const CorpusSource& source) override { names_.build(source); }
+
+    std::size_t query(std::string_view text) override {
+        const std::string needle = folded(text);
+        std::size_t matches = 0;
+        for (std::size_t i = 0; i < names_.size(); ++i) {
+            const std::string_view name = names_[i];
+            std::size_t n = 0;
+            for (std::size_t k = 0; k < name.size() && n < needle.size(); ++k) {
+                if (name[k] == needle[n]) ++n;
+            }
+            if (n == needle.size()) ++matches;
+        }
+        return matches;
+    }
+
+private:
+    FoldedNames names_;
+};
+
+class RegexMatcher : public Matcher {
+public:
+    const char* name() const noexcept override { return "regex"; }
+    void build(const CorpusSource& source) override { names_.build(source); }
+
+    std::size_t query(std::string_view text) override {
+        // Half-typed patterns ("foo(") fail to compile; that is a keystroke too
+        std::regex pattern;
+        try {
+            pattern.assign(text.begin(), text.end(), std::regex::ECMAScript | std::regex::icase | std::regex::nosubs);
+        } catch (const std::regex_error&) {
+            return 0;
+        }
+        std::size_t matches = 0;
+        for (std::size_t i = 0; i < names_.size(); ++i) {
+            const std::string_view name = names_[i];
+            if (std::regex_search(name.begin(), name.end(), pattern)) ++matches;
+        }
+        return matches;
+    }
+
+private:
+    FoldedNames names_;
+};
+
+class TrigramMatcher : public Matcher {
+public:
+    const char* name() const noexcept override { return "trigram"; }
+
+    void build(const CorpusSource& source) override {
+        names_.build(source);
+        postings_.clear();
+        std::vector<std::uint32_t> seen;
+        for (std::size_t i = 0; i < names_.size(); ++i) {
+            const std::string_view name = names_[i];
+            seen.clear();
+            for (std::size_t k = 0; k + 3 <= name.size(); ++k) {
+                seen.push_back(key(name.substr(k, 3)));
+            }
+            std::sort(seen.begin(), seen.end());
+            seen.erase(std::unique(seen.begin(), seen.end()), seen.end());
+            for (std::uint32_t gram : seen) {
+                postings_[gram].push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+    }
+
+    std::size_t query(std::string_view text) override {
+        const std::string needle = folded(text);
+        std::size_t matches = 0;
+
+        // Too short for a trigram: scan
+        if (needle.size() < 3) {
+            for (std::size_t i = 0; i < names_.size(); ++i) {
+                if (names_[i].find(needle) != std::string_view::npos) ++matches;
+            }
+            return matches;
+        }
+
+        // Intersect, rarest list first
+        std::vector<const std::vector<std::uint32_t>*> lists;
+        for (std::size_t k = 0; k + 3 <= needle.size(); ++k) {
+            auto it = postings_.find(key(std::string_view(needle).substr(k, 3)));
+            if (it == postings_.end()) return 0;
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](auto* a, auto* b) { return a->size() < b->size(); });
+
+        candidates_ = *lists.front();
+        for (std::size_t l = 1; l < lists.size() && !candidates_.empty(); ++l) {
+            scratch_.clear();
+            std::set_intersection(candidates_.begin(), candidates_.end(), lists[l]->begin(), lists[l]->end(),
+                                  std::back_inserter(scratch_));
+            candidates_.swap(scratch_);
+        }
+
+        // Trigrams only prove the pieces occur; verify the whole needle
+        for (std::uint32_t i : candidates_) {
+            if (names_[i].find(needle) != std::string_view::npos) ++matches;
+        }
+        return matches;
+    }
+
+private:
+    static std::uint32_t key(std::string_view gram) noexcept {
+        return (static_cast<std::uint32_t>(static_cast<unsigned char>(gram[0])) << 16) |
+               (static_cast<std::uint32_t>(static_cast<unsigned char>(gram[1])) << 8) |
+               static_cast<std::uint32_t>(static_cast<unsigned char>(gram[2]));
+    }
+
+    FoldedNames names_;
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> postings_;
+    std::vector<std::uint32_t> candidates_;
+    std::vector<std::uint32_t> scratch_;
+};
+
+std::unique_ptr<Matcher> make_matcher(std::string_view name) {
+    if (name == "browser") return std::make_unique<BrowserMatcher>();
+    if (name == "omnibox") return std::make_unique<OmniboxMatcher>();
+    if (name == "fuzzy") return std::make_unique<FuzzyMatcher>();
+    if (name == "regex") return std::make_unique<RegexMatcher>();
+    if (name == "trigram") return std::make_unique<TrigramMatcher>();
+    return nullptr;
+}
+
+// =============================================================================
+// Typing Sessions
+// =============================================================================
+
+/// Queries typed when no --script is given: auto-names, mangled and
+/// demangled fragments, Rust/Go paths and a query that matches nothing
+const char* const DEFAULT_SCRIPT[] = {
+    "sub_1400",
+    "parse",
+    "Connection::read",
+    "_ZN4core3ptr",
+    "drop_in_place",
+    "?dispatch@",
+    "net/http.(*conn).serve",
+    "std::basic_string",
+    "handle_event",
+    "qqxzzy",
+};
+
+bool load_script(const char* path, std::vector<std::string>& out) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        out.push_back(line);
+    }
+    return true;
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    const std::size_t k = std::min(values.size() - 1, static_cast<std::size_t>(p * (values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(k), values.end());
+    return values[k];
+}
+
+std::vector<std::string> split_list(const char* text) {
+    std::vector<std::string> out;
+    std::string item;
+    for (const char* p = text;; ++p) {
+        if (*p == ',' || *p == '\0') {
+            if (!item.empty()) out.push_back(item);
+            item.clear();
+            if (*p == '\0') break;
+        } else {
+            item.push_back(*p);
+        }
+    }
+    return out;
+}
+
+// =============================================================================
+// Benchmark
+// =============================================================================
+
+/// Allocation limits from the command line; negative = not checked
+struct AllocationBudget {
+    double per_key = -1.0;
+    double per_1k = -1.0;
+};
+
+double per_1k(std::uint64_t allocations, std::size_t count) {
+    return 1000.0 * static_cast<double>(allocations) / static_cast<double>(count);
+}
+
+/// @return false if a build or keystroke went over the budget
+bool run_size(std::size_t count, std::uint64_t seed, const std::vector<std::string>& matchers,
+              const std::vector<std::string>& script, const AllocationBudget& budget) {
+    static AllocationSite build_site("bench", "build");
+    static AllocationSite key_site("bench", "keystroke");
+    bool within_budget = true;
+    auto check_build = [&](const char* what, double allocs_per_1k) {
+        if (budget.per_1k >= 0.0 && allocs_per_1k > budget.per_1k) {
+            std::printf("   !! %s: %.1f allocations per 1k names, budget %.1f\n", what, allocs_per_1k, budget.per_1k);
+            within_budget = false;
+        }
+    };
+
+    auto start = Clock::now();
+    const SymbolCorpus corpus = generate_corpus(count, seed);
+    const double generate_ms = elapsed_ms(start);
+
+    std::size_t before = live_bytes();
+    std::uint64_t catalog_allocs = 0;
+    start = Clock::now();
+    std::optional<const CorpusSource> catalog;
+    {
+        AllocationScope scope(build_site);
+        catalog.emplace(corpus);
+        catalog_allocs = scope.allocations();
+    }
+    const CorpusSource& source = *catalog;
+    const double catalog_ms = elapsed_ms(start);
+    const double catalog_bytes = static_cast<double>(live_bytes() - before) / static_cast<double>(count);
+
+    before = live_bytes();
+    std::uint64_t tree_allocs = 0;
+    start = Clock::now();
+    features::function_search::NameTree tree(source);
+    {
+        AllocationScope scope(build_site);
+        tree.build();
+        tree_allocs = scope.allocations();
+    }
+    const double tree_ms = elapsed_ms(start);
+    const double tree_bytes = static_cast<double>(live_bytes() - before) / static_cast<double>(count);
+
+    std::printf("== %zu symbols (generated in %.0f ms)\n", count, generate_ms);
+    std::printf("   catalog    %9.1f ms  %7.1f B/name  %7.1f allocs/1k\n", catalog_ms, catalog_bytes,
+                per_1k(catalog_allocs, count));
+    std::printf("   name tree  %9.1f ms  %7.1f B/name  %7.1f allocs/1k\n\n", tree_ms, tree_bytes,
+                per_1k(tree_allocs, count));
+    check_build("catalog", per_1k(catalog_allocs, count));
+    check_build("name tree", per_1k(tree_allocs, count));
+    std::printf("   %-9s %10s %9s %9s %6s %9s %9s %9s %9s %9s\n", "matcher", "build ms", "B/name", "allocs/1k", "keys",
+                "p50 ms", "p99 ms", "max ms", "hits/key", "allocs/key");
+
+    for (const std::string& matcher_name : matchers) {
+        std::unique_ptr<Matcher> matcher = make_matcher(matcher_name);
+
+        before = live_bytes();
+        std::uint64_t build_allocs = 0;
+        start = Clock::now();
+        {
+            AllocationScope scope(build_site);
+            matcher->build(source);
+            build_allocs = scope.allocations();
+        }
+        const double build_ms = elapsed_ms(start);
+        const double index_bytes = static_cast<double>(live_bytes() - before) / static_cast<double>(count);
+
+        std::vector<double> latencies;
+        std::size_t hits = 0;  // Summed over keystrokes
+        std::uint64_t key_allocs = 0;
+        for (const std::string& query : script) {
+            for (std::size_t typed = 1; typed <= query.size(); ++typed) {
+                start = Clock::now();
+                AllocationScope scope(key_site);
+                hits += matcher->query(std::string_view(query).substr(0, typed));
+                key_allocs += scope.allocations();
+                latencies.push_back(elapsed_ms(start));
+            }
+        }
+
+        const double max_ms = latencies.empty() ? 0.0 : *std::max_element(latencies.begin(), latencies.end());
+        const double mean_hits = latencies.empty() ? 0.0 : static_cast<double>(hits) / static_cast<double>(latencies.size());
+        const double mean_allocs = latencies.empty() ? 0.0 : static_cast<double>(key_allocs) / static_cast<double>(latencies.size());
+        std::printf("   %-9s %10.1f %9.1f %9.1f %6zu %9.3f %9.3f %9.3f %9.0f %10.1f\n", matcher->name(), build_ms,
+                    index_bytes, per_1k(build_allocs, count), latencies.size(), percentile(latencies, 0.5),
+                    percentile(latencies, 0.99), max_ms, mean_hits, mean_allocs);
+        check_build(matcher->name(), per_1k(build_allocs, count));
+
+        // Steady state: buffers sized by the first replay are reused by the second
+        if (budget.per_key >= 0.0) {
+            std::uint64_t worst = 0;
+            std::string_view worst_query;
+            for (const std::string& query : script) {
+                for (std::size_t typed = 1; typed <= query.size(); ++typed) {
+                    const std::string_view text = std::string_view(query).substr(0, typed);
+                    AllocationScope scope(key_site);
+                    matcher->query(text);
+                    if (scope.allocations() > worst) {
+                        worst = scope.allocations();
+                        worst_query = text;
+                    }
+                }
+            }
+            if (static_cast<double>(worst) > budget.per_key) {
+                std::printf("   !! %s: %llu allocations typing \"%.*s\" (warm), budget %.0f\n", matcher->name(),
+                            static_cast<unsigned long long>(worst), static_cast<int>(worst_query.size()),
+                            worst_query.data(), budget.per_key);
+                within_budget = false;
+            }
+        }
+    }
+    std::printf("\n");
+    return within_budget;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::size_t> sizes = {10000, 100000, 500000, 2000000};
+    std::vector<std::string> matchers = {"browser", "omnibox", "fuzzy", "regex", "trigram"};
+    std::vector<std::string> script(std::begin(DEFAULT_SCRIPT), std::end(DEFAULT_SCRIPT));
+    std::uint64_t seed = 0x53594E4F50534941ULL;
+    AllocationBudget budget;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--sizes") == 0) {
+            sizes.clear();
+            for (const std::string& size : split_list(argv[i + 1])) {
+                sizes.push_back(static_cast<std::size_t>(std::strtoull(size.c_str(), nullptr, 10)));
+            }
+        } else if (std::strcmp(argv[i], "--matchers") == 0) {
+            matchers = split_list(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--script") == 0) {
+            script.clear();
+            if (!load_script(argv[i + 1], script)) {
+                std::fprintf(stderr, "synopsia_search_bench: %s: cannot read script\n", argv[i + 1]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            seed = std::strtoull(argv[i + 1], nullptr, 0);
+        } else if (std::strcmp(argv[i], "--max-allocs-per-key") == 0) {
+            budget.per_key = std::strtod(argv[i + 1], nullptr);
+        } else if (std::strcmp(argv[i], "--max-allocs-per-1k") == 0) {
+            budget.per_1k = std::strtod(argv[i + 1], nullptr);
+        } else {
+            std::fprintf(stderr, "synopsia_search_bench: unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (argc % 2 == 0) {
+        std::fprintf(stderr, "usage: %s [--sizes N,...] [--matchers name,...] [--script file] [--seed N]"
+                             " [--max-allocs-per-key N] [--max-allocs-per-1k N]\n", argv[0]);
+        return 2;
+    }
+
+    for (const std::string& matcher : matchers) {
+        if (!make_matcher(matcher)) {
+            std::fprintf(stderr, "synopsia_search_bench: unknown matcher %s\n", matcher.c_str());
+            return 2;
+        }
+    }
+
+    bool within_budget = true;
+    for (std::size_t size : sizes) {
+        if (size > 0 && !run_size(size, seed, matchers, script, budget)) within_budget = false;
+    }
+    if (!within_budget) {
+        std::fprintf(stderr, "synopsia_search_bench: allocation budget exceeded\n");
+        return 1;
+    }
+    return 0;
+}
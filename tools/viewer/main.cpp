@@ -0,0 +1,958 @@
+/// @file main.cpp
+/// @brief Standalone viewer for synopsia snapshot files
+///
+/// Opens a .synsnap export in its own GLFW/OpenGL window and browses it with
+/// the same ImGui function browser and entropy rasterizer the plugin uses.
+/// All data is served from the mapped file.
+///
+/// Usage: synopsia_viewer <file.synsnap> [--replay <file.syntrace> [--budget-ms N]]
+///   F1 functions, F2 entropy, F3 call-graph layout
+///
+/// With --replay the viewer runs hidden and drives its views with a session
+/// trace recorded in IDA (-Osynopsia:trace), then prints per-event latency.
+/// Exits with 3 if any event took longer than the budget.
+
+#include "snapshot_sources.hpp"
+
+#include <synopsia/color.hpp>
+#include <synopsia/minimap_raster.hpp>
+#include <synopsia/common/session_trace.hpp>
+#include <synopsia/common/frame_arena.hpp>
+#include <synopsia/common/alloc_tracker.hpp>
+#include <synopsia/imgui/allocation_panel.hpp>
+#include <synopsia/features/function_search/search_view.hpp>
+
+#include <imgui.h>
+#include <imgui_impl_glfw.h>
+#include <imgui_impl_opengl3.h>
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace synopsia;
+using namespace synopsia::viewer;
+using features::function_search::FunctionSearchView;
+
+// =============================================================================
+// Texture
+// =============================================================================
+
+/// RGBA texture re-uploaded from an 0xAARRGGBB buffer
+class Texture {
+public:
+    ~Texture() {
+        if (id_) glDeleteTextures(1, &id_);
+    }
+
+    void upload(const std::vector<std::uint32_t>& argb, int width, int height) {
+        if (!id_) {
+            glGenTextures(1, &id_);
+            glBindTexture(GL_TEXTURE_2D, id_);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+
+        // Swizzle to byte-order RGBA so only core formats are needed
+        rgba_.resize(argb.size());
+        for (std::size_t i = 0; i < argb.size(); ++i) {
+            const std::uint32_t p = argb[i];
+            rgba_[i] = ((p >> 16) & 0xFF) | (p & 0xFF00) | ((p & 0xFF) << 16) | (p & 0xFF000000u);
+        }
+
+        glBindTexture(GL_TEXTURE_2D, id_);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba_.data());
+        width_ = width;
+        height_ = height;
+    }
+
+    [[nodiscard]] ImTextureID id() const { return static_cast<ImTextureID>(id_); }
+    [[nodiscard]] int width() const { return width_; }
+    [[nodiscard]] int height() const { return height_; }
+
+private:
+    GLuint id_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<std::uint32_t> rgba_;
+};
+
+constexpr ImGuiWindowFlags FULLSCREEN_FLAGS =
+    ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove |
+    ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoBringToFrontOnFocus;
+
+void begin_fullscreen(const char* name) {
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(viewport->WorkPos);
+    ImGui::SetNextWindowSize(viewport->WorkSize);
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
+    ImGui::Begin(name, nullptr, FULLSCREEN_FLAGS);
+    ImGui::PopStyleVar();
+}
+
+// =============================================================================
+// Entropy View
+// =============================================================================
+
+class EntropyView {
+public:
+    EntropyView(SnapshotMinimapSource& source, const SnapshotFunctionSource& functions)
+        : source_(source), functions_(functions), gradient_(ColorGradient::create_default()) {}
+
+    void render() {
+        begin_fullscreen("Entropy");
+
+        int level = static_cast<int>(source_.level());
+        const int max_level = std::max(0, static_cast<int>(source_.level_count()) - 1);
+        ImGui::SetNextItemWidth(160);
+        if (ImGui::SliderInt("Level", &level, 0, max_level) && source_.set_level(static_cast<std::size_t>(level))) {
+            dirty_ = true;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Reset")) {
+            source_.reset_viewport();
+            dirty_ = true;
+        }
+        const ViewportData vp = source_.get_viewport();
+        ImGui::SameLine();
+        ImGui::Text("%016llX - %016llX  (%.1fx)",
+                    static_cast<unsigned long long>(vp.start_addr),
+                    static_cast<unsigned long long>(vp.end_addr), vp.zoom);
+
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        const ImVec2 avail = ImGui::GetContentRegionAvail();
+        const int width = std::max(1, static_cast<int>(avail.x));
+        const int height = std::max(1, static_cast<int>(avail.y));
+        if (width != texture_.width() || height != texture_.height()) {
+            dirty_ = true;
+        }
+
+        if (dirty_) {
+            pixels_.assign(static_cast<std::size_t>(width) * height, colors::Background.to_argb());
+            rasterize_entropy(source_, gradient_, false, width, height, pixels_.data(), width);
+            texture_.upload(pixels_, width, height);
+            dirty_ = false;
+        }
+
+        ImGui::Image(texture_.id(), ImVec2(static_cast<float>(width), static_cast<float>(height)));
+        image_origin_ = origin;
+        image_size_ = ImVec2(static_cast<float>(width), static_cast<float>(height));
+        handle_input(origin, width);
+
+        ImGui::End();
+    }
+
+    /// Re-rasterize on the next frame
+    void invalidate() { dirty_ = true; }
+
+    /// Screen rectangle of the strip drawn last frame
+    [[nodiscard]] ImVec2 image_origin() const { return image_origin_; }
+    [[nodiscard]] ImVec2 image_size() const { return image_size_; }
+
+private:
+    void handle_input(const ImVec2& origin, int width) {
+        if (!ImGui::IsItemHovered()) return;
+
+        const ImGuiIO& io = ImGui::GetIO();
+        const int x = static_cast<int>(io.MousePos.x - origin.x);
+        const data_addr_t addr = source_.x_to_address(x, width);
+
+        if (io.MouseWheel != 0.0f) {
+            source_.zoom(io.MouseWheel > 0 ? 1.25 : 0.8, addr);
+            dirty_ = true;
+        }
+        if (ImGui::IsMouseDragging(ImGuiMouseButton_Left) && io.MouseDelta.x != 0.0f) {
+            const double per_pixel = static_cast<double>(source_.get_viewport().range()) / width;
+            source_.pan(static_cast<data_sval_t>(-io.MouseDelta.x * per_pixel));
+            dirty_ = true;
+        }
+
+        const double entropy = source_.entropy_at(addr);
+        const func_addr_t func = functions_.find_function_at(addr);
+        const std::size_t index = functions_.index_of(func);
+
+        ImGui::BeginTooltip();
+        ImGui::Text("%016llX", static_cast<unsigned long long>(addr));
+        if (entropy >= 0.0) {
+            ImGui::Text("Entropy: %.3f", entropy);
+        }
+        if (index != SnapshotFunctionSource::npos) {
+            const std::string_view name = functions_.name(index);
+            ImGui::Text("%.*s", static_cast<int>(name.size()), name.data());
+        }
+        ImGui::EndTooltip();
+    }
+
+    SnapshotMinimapSource& source_;
+    const SnapshotFunctionSource& functions_;
+    ColorGradient gradient_;
+    Texture texture_;
+    std::vector<std::uint32_t> pixels_;
+    ImVec2 image_origin_{0.0f, 0.0f};
+    ImVec2 image_size_{0.0f, 0.0f};
+    bool dirty_ = true;
+};
+
+// =============================================================================
+// Layout View
+// =============================================================================
+
+/// Top-down projection of the stored call-graph layout (Hilbert order on X/Y)
+class LayoutView {
+public:
+    LayoutView(const SnapshotFile& snapshot, const SnapshotFunctionSource& functions)
+        : functions_(functions), gradient_(ColorGradient::create_fire()) {
+        x_ = snapshot.column<float>(SnapshotSection::LayoutX);
+        y_ = snapshot.column<float>(SnapshotSection::LayoutY);
+        complexity_ = snapshot.column<float>(SnapshotSection::FunctionComplexity);
+        if (x_.size() != functions_.function_count() || y_.size() != x_.size()) {
+            x_ = {};
+            y_ = {};
+        }
+        if (complexity_.size() != x_.size()) {
+            complexity_ = {};
+        }
+        for (float c : complexity_) {
+            max_complexity_ = std::max(max_complexity_, c);
+        }
+        build_grid();
+    }
+
+    /// Function picked by the last click, if any
+    [[nodiscard]] std::size_t take_selection() {
+        const std::size_t picked = picked_;
+        picked_ = SnapshotFunctionSource::npos;
+        return picked;
+    }
+
+    void render() {
+        begin_fullscreen("Layout");
+
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        const ImVec2 avail = ImGui::GetContentRegionAvail();
+        const int width = std::max(1, static_cast<int>(avail.x));
+        const int height = std::max(1, static_cast<int>(avail.y));
+        if (width != texture_.width() || height != texture_.height()) {
+            dirty_ = true;
+        }
+        if (dirty_) {
+            rasterize(width, height);
+        }
+
+        ImGui::Image(texture_.id(), ImVec2(static_cast<float>(width), static_cast<float>(height)));
+        handle_input(origin, width, height);
+        draw_selection(origin, width, height);
+
+        ImGui::End();
+    }
+
+private:
+    [[nodiscard]] ImVec2 project(std::size_t i, int width, int height) const {
+        const float scale = 0.5f * static_cast<float>(std::min(width, height)) * zoom_;
+        return ImVec2(width * 0.5f + (x_[i] - center_x_) * scale,
+                      height * 0.5f + (y_[i] - center_y_) * scale);
+    }
+
+    void rasterize(int width, int height) {
+        pixels_.assign(static_cast<std::size_t>(width) * height, colors::Background.to_argb());
+        for (std::size_t i = 0; i < x_.size(); ++i) {
+            const ImVec2 p = project(i, width, height);
+            const int px = static_cast<int>(p.x);
+            const int py = static_cast<int>(p.y);
+            if (px < 0 || py < 0 || px + 1 >= width || py + 1 >= height) continue;
+
+            const double t = max_complexity_ > 0.0f && !complexity_.empty()
+                ? std::log1p(complexity_[i]) / std::log1p(max_complexity_)
+                : 0.5;
+            const std::uint32_t color = gradient_.sample_entropy(0.5 + t * 7.5).to_argb();
+            std::uint32_t* row = pixels_.data() + static_cast<std::size_t>(py) * width + px;
+            row[0] = row[1] = color;
+            row[width] = row[width + 1] = color;
+        }
+        texture_.upload(pixels_, width, height);
+        dirty_ = false;
+    }
+
+    /// Bucket functions into a uniform grid over the layout bounds for hover lookups
+    void build_grid() {
+        if (x_.empty()) return;
+        auto [min_x, max_x] = std::minmax_element(x_.begin(), x_.end());
+        auto [min_y, max_y] = std::minmax_element(y_.begin(), y_.end());
+        grid_x_ = *min_x;
+        grid_y_ = *min_y;
+        grid_cell_ = std::max(std::max(*max_x - *min_x, *max_y - *min_y) / GRID_SIZE, 1e-6f);
+
+        cell_start_.assign(GRID_SIZE * GRID_SIZE + 1, 0);
+        for (std::size_t i = 0; i < x_.size(); ++i) {
+            ++cell_start_[cell_of(x_[i], y_[i]) + 1];
+        }
+        for (std::size_t c = 1; c < cell_start_.size(); ++c) {
+            cell_start_[c] += cell_start_[c - 1];
+        }
+        cell_items_.resize(x_.size());
+        std::vector<std::uint32_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+        for (std::size_t i = 0; i < x_.size(); ++i) {
+            cell_items_[fill[cell_of(x_[i], y_[i])]++] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    [[nodiscard]] int grid_coord(float v, float origin) const {
+        return std::clamp(static_cast<int>((v - origin) / grid_cell_), 0, GRID_SIZE - 1);
+    }
+
+    [[nodiscard]] std::size_t cell_of(float x, float y) const {
+        return static_cast<std::size_t>(grid_coord(y, grid_y_)) * GRID_SIZE + grid_coord(x, grid_x_);
+    }
+
+    /// Nearest function within radius screen pixels of (mx, my), visiting only nearby cells
+    [[nodiscard]] std::size_t pick(float mx, float my, float radius, int width, int height) const {
+        if (cell_items_.empty()) return SnapshotFunctionSource::npos;
+        const float scale = 0.5f * static_cast<float>(std::min(width, height)) * zoom_;
+        const float wx = center_x_ + (mx - width * 0.5f) / scale;
+        const float wy = center_y_ + (my - height * 0.5f) / scale;
+        const float r = radius / scale;
+
+        std::size_t best_index = SnapshotFunctionSource::npos;
+        float best = radius * radius;
+        for (int gy = grid_coord(wy - r, grid_y_); gy <= grid_coord(wy + r, grid_y_); ++gy) {
+            for (int gx = grid_coord(wx - r, grid_x_); gx <= grid_coord(wx + r, grid_x_); ++gx) {
+                const std::size_t cell = static_cast<std::size_t>(gy) * GRID_SIZE + gx;
+                for (std::uint32_t k = cell_start_[cell]; k < cell_start_[cell + 1]; ++k) {
+                    const std::uint32_t i = cell_items_[k];
+                    const ImVec2 p = project(i, width, height);
+                    const float dx = p.x - mx;
+                    const float dy = p.y - my;
+                    const float d = dx * dx + dy * dy;
+                    if (d < best) {
+                        best = d;
+                        best_index = i;
+                    }
+                }
+            }
+        }
+        return best_index;
+    }
+
+    void handle_input(const ImVec2& origin, int width, int height) {
+        hovered_ = SnapshotFunctionSource::npos;
+        if (!ImGui::IsItemHovered()) return;
+
+        const ImGuiIO& io = ImGui::GetIO();
+        const float scale = 0.5f * static_cast<float>(std::min(width, height)) * zoom_;
+        const float mx = io.MousePos.x - origin.x;
+        const float my = io.MousePos.y - origin.y;
+
+        if (io.MouseWheel != 0.0f) {
+            // Zoom around the cursor
+            const float wx = center_x_ + (mx - width * 0.5f) / scale;
+            const float wy = center_y_ + (my - height * 0.5f) / scale;
+            zoom_ = std::clamp(zoom_ * (io.MouseWheel > 0 ? 1.25f : 0.8f), 0.5f, 512.0f);
+            const float new_scale = 0.5f * static_cast<float>(std::min(width, height)) * zoom_;
+            center_x_ = wx - (mx - width * 0.5f) / new_scale;
+            center_y_ = wy - (my - height * 0.5f) / new_scale;
+            dirty_ = true;
+        }
+        if (ImGui::IsMouseDragging(ImGuiMouseButton_Left) &&
+            (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f)) {
+            center_x_ -= io.MouseDelta.x / scale;
+            center_y_ -= io.MouseDelta.y / scale;
+            dirty_ = true;
+            return;
+        }
+
+        // Nearest function within a few pixels
+        hovered_ = pick(mx, my, 6.0f, width, height);
+
+        if (hovered_ != SnapshotFunctionSource::npos) {
+            const std::string_view name = functions_.name(hovered_);
+            const auto info = functions_.get_function(hovered_);
+            ImGui::BeginTooltip();
+            ImGui::Text("%.*s", static_cast<int>(name.size()), name.data());
+            ImGui::Text("%016llX", static_cast<unsigned long long>(info.address));
+            ImGui::EndTooltip();
+
+            if (ImGui::IsMouseReleased(ImGuiMouseButton_Left) && ImGui::GetMouseDragDelta().x == 0.0f &&
+                ImGui::GetMouseDragDelta().y == 0.0f) {
+                selected_ = hovered_;
+                picked_ = hovered_;
+            }
+        }
+    }
+
+    void draw_selection(const ImVec2& origin, int width, int height) {
+        if (selected_ >= x_.size()) return;
+
+        ImDrawList* draw = ImGui::GetWindowDrawList();
+        const ImVec2 s = project(selected_, width, height);
+        const ImVec2 from(origin.x + s.x, origin.y + s.y);
+        for (std::uint32_t target : functions_.callees(selected_)) {
+            if (target >= x_.size()) continue;
+            const ImVec2 t = project(target, width, height);
+            draw->AddLine(from, ImVec2(origin.x + t.x, origin.y + t.y), IM_COL32(80, 200, 255, 160));
+        }
+        draw->AddCircle(from, 6.0f, IM_COL32(255, 255, 255, 255));
+    }
+
+    const SnapshotFunctionSource& functions_;
+    ColorGradient gradient_;
+    std::span<const float> x_;
+    std::span<const float> y_;
+    std::span<const float> complexity_;
+    float max_complexity_ = 0.0f;
+
+    // Hover grid: GRID_SIZE^2 cells over the layout bounds, functions per cell in CSR form
+    static constexpr int GRID_SIZE = 256;
+    float grid_x_ = 0.0f;
+    float grid_y_ = 0.0f;
+    float grid_cell_ = 1.0f;
+    std::vector<std::uint32_t> cell_start_;
+    std::vector<std::uint32_t> cell_items_;
+
+    float center_x_ = 0.0f;
+    float center_y_ = 0.0f;
+    float zoom_ = 0.95f;
+
+    std::size_t hovered_ = SnapshotFunctionSource::npos;
+    std::size_t selected_ = SnapshotFunctionSource::npos;
+    std::size_t picked_ = SnapshotFunctionSource::npos;
+
+    Texture texture_;
+    std::vector<std::uint32_t> pixels_;
+    bool dirty_ = true;
+};
+
+// =============================================================================
+// Main Loop
+// =============================================================================
+
+enum class Mode { Functions, Entropy, Layout };
+
+void render_mode_bar(Mode& mode, const std::string& title) {
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - 8.0f,
+                                   viewport->WorkPos.y + viewport->WorkSize.y - 8.0f),
+                            ImGuiCond_Always, ImVec2(1.0f, 1.0f));
+    ImGui::SetNextWindowBgAlpha(0.85f);
+    ImGui::Begin("##modes", nullptr,
+                 ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+                 ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing);
+    ImGui::TextDisabled("%s", title.c_str());
+    ImGui::SameLine();
+    if (ImGui::RadioButton("Functions", mode == Mode::Functions)) mode = Mode::Functions;
+    ImGui::SameLine();
+    if (ImGui::RadioButton("Entropy", mode == Mode::Entropy)) mode = Mode::Entropy;
+    ImGui::SameLine();
+    if (ImGui::RadioButton("Layout", mode == Mode::Layout)) mode = Mode::Layout;
+    ImGui::SameLine();
+    ImGui::TextDisabled("%llu allocs/frame",
+                        static_cast<unsigned long long>(FrameArena::instance().last_frame().heap_allocations));
+    ImGui::End();
+}
+
+/// Everything a frame draws
+struct Views {
+    SnapshotFunctionSource& functions;
+    FunctionSearchView& search;
+    EntropyView& entropy;
+    LayoutView& layout;
+    std::string title;
+    Mode mode = Mode::Functions;
+    bool show_allocations = false;  // F12
+};
+
+void draw_frame(GLFWwindow* window, Views& views) {
+    FrameArena::instance().begin_frame();
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplGlfw_NewFrame();
+    ImGui::NewFrame();
+
+    if (ImGui::IsKeyPressed(ImGuiKey_F1)) views.mode = Mode::Functions;
+    if (ImGui::IsKeyPressed(ImGuiKey_F2)) views.mode = Mode::Entropy;
+    if (ImGui::IsKeyPressed(ImGuiKey_F3)) views.mode = Mode::Layout;
+    if (ImGui::IsKeyPressed(ImGuiKey_F12, false)) views.show_allocations = !views.show_allocations;
+
+    static AllocationSite search_site("function_search", "frame");
+    static AllocationSite entropy_site("entropy_minimap", "frame");
+    static AllocationSite layout_site("layout", "frame");
+    switch (views.mode) {
+        case Mode::Functions: {
+            AllocationScope allocations(search_site);
+            views.search.render();
+            break;
+        }
+        case Mode::Entropy: {
+            AllocationScope allocations(entropy_site);
+            views.entropy.render();
+            break;
+        }
+        case Mode::Layout: {
+            AllocationScope allocations(layout_site);
+            views.layout.render();
+            break;
+        }
+    }
+
+    // Clicking a node in the layout opens it in the browser
+    const std::size_t picked = views.layout.take_selection();
+    if (picked != SnapshotFunctionSource::npos) {
+        views.search.select_function(views.functions.get_function(picked).address);
+        views.mode = Mode::Functions;
+    }
+
+    render_mode_bar(views.mode, views.title);
+    if (views.show_allocations) imgui::render_allocation_panel(&views.show_allocations);
+
+    ImGui::Render();
+    int fb_width = 0, fb_height = 0;
+    glfwGetFramebufferSize(window, &fb_width, &fb_height);
+    glViewport(0, 0, fb_width, fb_height);
+    glClearColor(0.1f, 0.1f, 0.12f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    glfwSwapBuffers(window);
+}
+
+// =============================================================================
+// Session Replay
+// =============================================================================
+
+/// View standing in for a recorded plugin widget
+std::optional<Mode> mode_for_widget(std::string_view widget) {
+    if (widget == "synopsia_function_search") return Mode::Functions;
+    if (widget == "synopsia_minimap") return Mode::Entropy;
+    if (widget == "synopsia_binary_map_3d") return Mode::Layout;
+    return std::nullopt;
+}
+
+/// Latencies of one event category
+struct LatencySeries {
+    std::vector<double> ms;
+    double live_ms = 0.0;     // Sum of recorded render times (frames only)
+    std::size_t live_count = 0;
+};
+
+struct SlowEvent {
+    double ms;
+    std::uint64_t time_us;
+    std::string label;
+};
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    const std::size_t k = std::min(values.size() - 1, static_cast<std::size_t>(p * (values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(k), values.end());
+    return values[k];
+}
+
+/// Replays a trace against the views; the minimap is a Qt widget in IDA, so
+/// its input is mapped along its recorded orientation onto the viewer's
+/// horizontal entropy strip.
+class TraceReplayer {
+public:
+    TraceReplayer(GLFWwindow* window, Views& views, const SnapshotFile& snapshot,
+                  SnapshotMinimapSource& minimap, const SessionTrace& trace)
+        : window_(window), views_(views), snapshot_(snapshot), minimap_(minimap), trace_(trace),
+          minimap_layout_(trace.minimap()) {}
+
+    /// @return Number of events over budget (budget_ms <= 0 disables the check)
+    std::size_t run(double budget_ms) {
+        const auto started = Clock::now();
+        for (const TraceEvent& event : trace_.events()) {
+            replay(event);
+        }
+        if (pending_input_) {
+            timed_frame(pending_mode_, "frame (unterminated)", trace_.events().back().time_us, -1);
+        }
+        const double total_s = std::chrono::duration<double>(Clock::now() - started).count();
+        return report(total_s, budget_ms);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void replay(const TraceEvent& event) {
+        switch (event.kind) {
+            case TraceEventKind::Cursor: {
+                const auto func = views_.functions.find_function_at(event.address);
+                timed_frame(views_.mode, "cursor", event.time_us, -1, [&] {
+                    if (func != features::function_search::FUNC_BADADDR) {
+                        views_.search.select_function(func);
+                    }
+                });
+                break;
+            }
+            case TraceEventKind::Change:
+                replay_change(event);
+                break;
+            case TraceEventKind::Input:
+                replay_input(event);
+                break;
+            case TraceEventKind::Frame: {
+                const auto mode = mode_for_widget(trace_.widget_name(event.widget));
+                if (!mode) {
+                    ++skipped_;
+                    break;
+                }
+                timed_frame(*mode, "frame " + std::string(trace_.widget_name(event.widget)),
+                            event.time_us, event.value);
+                pending_input_ = false;
+                break;
+            }
+            case TraceEventKind::Response:
+                check_response(event);
+                break;
+            default:
+                ++skipped_;
+                break;
+        }
+    }
+
+    void replay_change(const TraceEvent& event) {
+        switch (static_cast<TraceChange>(event.code)) {
+            case TraceChange::Renamed: {
+                const std::size_t index = views_.functions.index_of(event.address);
+                timed_frame(Mode::Functions, "change rename", event.time_us, -1, [&] {
+                    if (index != SnapshotFunctionSource::npos) {
+                        views_.functions.rename(index, event.text);
+                    }
+                });
+                break;
+            }
+            case TraceChange::FunctionsChanged:
+                timed_frame(Mode::Functions, "change functions", event.time_us, -1, [&] {
+                    views_.search.refresh();
+                });
+                break;
+            case TraceChange::BytesChanged:
+                timed_frame(Mode::Entropy, "change bytes", event.time_us, -1, [&] {
+                    views_.entropy.invalidate();
+                });
+                break;
+            default:
+                ++skipped_;
+                break;
+        }
+    }
+
+    void replay_input(const TraceEvent& event) {
+        const std::string_view widget = trace_.widget_name(event.widget);
+        const auto mode = mode_for_widget(widget);
+        if (!mode) {
+            ++skipped_;
+            return;
+        }
+        const bool minimap = *mode == Mode::Entropy;
+        ImGuiIO& io = ImGui::GetIO();
+
+        switch (static_cast<TraceInput>(event.code)) {
+            case TraceInput::MousePos:
+                if (minimap) {
+                    const ImVec2 origin = views_.entropy.image_origin();
+                    const ImVec2 size = views_.entropy.image_size();
+                    const float along = minimap_layout_.vertical ? event.y : event.x;
+                    const float extent = minimap_layout_.vertical ? minimap_layout_.height : minimap_layout_.width;
+                    const float t = extent > 0.0f ? std::clamp(along / extent, 0.0f, 1.0f) : 0.5f;
+                    io.AddMousePosEvent(origin.x + t * size.x, origin.y + size.y * 0.5f);
+                } else {
+                    io.AddMousePosEvent(event.x, event.y);
+                }
+                break;
+            case TraceInput::MouseButton:
+                io.AddMouseButtonEvent(static_cast<int>(event.value & 0xFF), ((event.value >> 8) & 1) != 0);
+                break;
+            case TraceInput::Wheel:
+                io.AddMouseWheelEvent(0.0f, event.y);
+                break;
+            case TraceInput::Key:
+                io.AddKeyEvent(static_cast<ImGuiKey>(event.value & 0xFFFF), ((event.value >> 16) & 1) != 0);
+                break;
+            case TraceInput::Char:
+                io.AddInputCharacter(static_cast<unsigned int>(event.value));
+                break;
+            case TraceInput::Focus:
+                io.AddFocusEvent(event.value != 0);
+                break;
+            case TraceInput::Resize:
+                if (minimap) {
+                    // Version 1 Resize records carry no orientation
+                    const bool vertical = trace_.version() >= 2 ? event.value != 0 : minimap_layout_.vertical;
+                    minimap_layout_ = TraceMinimapLayout{event.x, event.y, vertical};
+                } else {
+                    glfwSetWindowSize(window_, std::max(1, static_cast<int>(event.x)), std::max(1, static_cast<int>(event.y)));
+                    glfwPollEvents();
+                }
+                break;
+            default:
+                ++skipped_;
+                return;
+        }
+        pending_input_ = true;
+        pending_mode_ = *mode;
+    }
+
+    void check_response(const TraceEvent& event) {
+        std::int64_t expected = -1;
+        switch (static_cast<TraceSource>(event.code)) {
+            case TraceSource::FunctionCount:
+                expected = static_cast<std::int64_t>(views_.functions.function_count());
+                break;
+            case TraceSource::EntropyBlocks:
+                for (std::size_t level = 0; level < minimap_.level_count(); ++level) {
+                    const auto starts = snapshot_.column<std::uint64_t>(
+                        snapshot_entropy_section(SnapshotSection::EntropyStart0, level));
+                    const auto ends = snapshot_.column<std::uint64_t>(
+                        snapshot_entropy_section(SnapshotSection::EntropyEnd0, level));
+                    if (!starts.empty() && ends.size() == starts.size() && ends[0] - starts[0] == event.address) {
+                        expected = static_cast<std::int64_t>(starts.size());
+                        break;
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+        if (expected != event.value) {
+            std::fprintf(stderr, "synopsia_viewer: +%.3fs response %u: trace %lld, snapshot %lld "
+                                 "(recorded against a different database state?)\n",
+                         event.time_us / 1e6, event.code, static_cast<long long>(event.value),
+                         static_cast<long long>(expected));
+            ++mismatches_;
+        }
+    }
+
+    /// Apply a change, draw one frame of a view and record how long both took.
+    /// Changes and cursor moves (live_us < 0) redraw the affected view without
+    /// switching to it; recorded frames switch.
+    void timed_frame(Mode mode, const std::string& label, std::uint64_t time_us, std::int64_t live_us,
+                     const std::function<void()>& apply = {}) {
+        const Mode previous = views_.mode;
+        views_.mode = mode;
+
+        const auto start = Clock::now();
+        if (apply) apply();
+        const std::uint64_t heap_before = AllocationCounter::count();
+        draw_frame(window_, views_);
+        frame_allocations_.push_back(static_cast<double>(AllocationCounter::count() - heap_before));
+        glFinish();
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if (live_us < 0) {
+            views_.mode = previous;
+        }
+
+        LatencySeries& series = series_[label];
+        series.ms.push_back(ms);
+        if (live_us >= 0) {
+            series.live_ms += live_us / 1000.0;
+            ++series.live_count;
+        }
+        slowest_.push_back({ms, time_us, label});
+        if (slowest_.size() > 2 * SLOWEST_SHOWN) {
+            trim_slowest();
+        }
+        latencies_.push_back(ms);
+    }
+
+    void trim_slowest() {
+        std::sort(slowest_.begin(), slowest_.end(), [](const SlowEvent& a, const SlowEvent& b) { return a.ms > b.ms; });
+        if (slowest_.size() > SLOWEST_SHOWN) slowest_.resize(SLOWEST_SHOWN);
+    }
+
+    std::size_t report(double total_s, double budget_ms) {
+        const auto& events = trace_.events();
+        const double span_s = events.empty() ? 0.0 : events.back().time_us / 1e6;
+        std::printf("replayed %zu events (%.1f s recorded) in %.2f s; %zu skipped, %zu response mismatches\n\n",
+                    events.size(), span_s, total_s, skipped_, mismatches_);
+
+        std::printf("%-36s %7s %9s %9s %9s %9s %9s\n", "event", "count", "mean ms", "p50 ms", "p95 ms", "max ms", "live ms");
+        for (const auto& [label, series] : series_) {
+            double sum = 0.0;
+            double max = 0.0;
+            for (double ms : series.ms) {
+                sum += ms;
+                max = std::max(max, ms);
+            }
+            char live[32] = "-";
+            if (series.live_count > 0) {
+                std::snprintf(live, sizeof(live), "%.2f", series.live_ms / series.live_count);
+            }
+            std::printf("%-36s %7zu %9.2f %9.2f %9.2f %9.2f %9s\n", label.c_str(), series.ms.size(),
+                        sum / series.ms.size(), percentile(series.ms, 0.5), percentile(series.ms, 0.95), max, live);
+        }
+
+        trim_slowest();
+        if (!slowest_.empty()) {
+            std::printf("\nslowest:\n");
+            for (const SlowEvent& slow : slowest_) {
+                std::printf("  +%10.3fs  %-36s %9.2f ms\n", slow.time_us / 1e6, slow.label.c_str(), slow.ms);
+            }
+        }
+
+        if (!frame_allocations_.empty()) {
+            const auto clean = std::count(frame_allocations_.begin(), frame_allocations_.end(), 0.0);
+            std::printf("\nheap allocations per frame: p50 %.0f, p95 %.0f, max %.0f; %zu of %zu frames allocation-free\n",
+                        percentile(frame_allocations_, 0.5), percentile(frame_allocations_, 0.95),
+                        *std::max_element(frame_allocations_.begin(), frame_allocations_.end()),
+                        static_cast<std::size_t>(clean), frame_allocations_.size());
+        }
+
+        std::size_t over = 0;
+        if (budget_ms > 0.0) {
+            over = static_cast<std::size_t>(std::count_if(latencies_.begin(), latencies_.end(),
+                                                          [budget_ms](double ms) { return ms > budget_ms; }));
+            std::printf("\n%zu events over the %.1f ms budget\n", over, budget_ms);
+        }
+        return over;
+    }
+
+    static constexpr std::size_t SLOWEST_SHOWN = 10;
+
+    GLFWwindow* window_;
+    Views& views_;
+    const SnapshotFile& snapshot_;
+    SnapshotMinimapSource& minimap_;
+    const SessionTrace& trace_;
+
+    std::map<std::string, LatencySeries> series_;
+    std::vector<SlowEvent> slowest_;
+    std::vector<double> latencies_;
+    std::vector<double> frame_allocations_;  // Heap allocations while drawing each frame
+    std::size_t skipped_ = 0;
+    std::size_t mismatches_ = 0;
+
+    bool pending_input_ = false;
+    Mode pending_mode_ = Mode::Functions;
+    TraceMinimapLayout minimap_layout_;  // Header, then the latest Resize
+};
+
+void glfw_error(int code, const char* description) {
+    std::fprintf(stderr, "synopsia_viewer: GLFW error %d: %s\n", code, description);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <file%s> [--replay <file%s> [--budget-ms N]]\n",
+                     argv[0], SNAPSHOT_EXTENSION, SESSION_TRACE_EXTENSION);
+        return 2;
+    }
+
+    const char* replay_path = nullptr;
+    double budget_ms = 0.0;
+    for (int i = 2; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "synopsia_viewer: option %s needs a value\n", argv[i]);
+            return 2;
+        }
+        if (std::strcmp(argv[i], "--replay") == 0) {
+            replay_path = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--budget-ms") == 0) {
+            budget_ms = std::atof(argv[i + 1]);
+        } else {
+            std::fprintf(stderr, "synopsia_viewer: unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    SnapshotFile snapshot;
+    std::string error;
+    if (!snapshot.open(argv[1], &error)) {
+        std::fprintf(stderr, "synopsia_viewer: %s: %s\n", argv[1], error.c_str());
+        return 1;
+    }
+
+    SnapshotFunctionSource functions(snapshot);
+    if (!functions.is_valid()) {
+        std::fprintf(stderr, "synopsia_viewer: %s: no function catalog\n", argv[1]);
+        return 1;
+    }
+    SnapshotMinimapSource minimap(snapshot);
+
+    SessionTrace trace;
+    if (replay_path && !trace.load(replay_path, &error)) {
+        std::fprintf(stderr, "synopsia_viewer: %s: %s\n", replay_path, error.c_str());
+        return 1;
+    }
+
+    glfwSetErrorCallback(glfw_error);
+    if (!glfwInit()) return 1;
+
+#if defined(__APPLE__)
+    const char* glsl_version = "#version 150";
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#else
+    const char* glsl_version = "#version 130";
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+#endif
+    if (replay_path) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
+
+    std::string title = snapshot.metadata("input_file");
+    if (title.empty()) title = argv[1];
+
+    GLFWwindow* window = glfwCreateWindow(1400, 900, ("Synopsia - " + title).c_str(), nullptr, nullptr);
+    if (!window) {
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(replay_path ? 0 : 1);
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGui::GetIO().IniFilename = nullptr;
+    ImGui::StyleColorsDark();
+    // Replays feed recorded input only
+    ImGui_ImplGlfw_InitForOpenGL(window, replay_path == nullptr);
+    ImGui_ImplOpenGL3_Init(glsl_version);
+
+    int status = 0;
+    {
+        FunctionSearchView search(functions);
+        search.refresh();
+        EntropyView entropy(minimap, functions);
+        LayoutView layout(snapshot, functions);
+        Views views{functions, search, entropy, layout, title};
+
+        if (replay_path) {
+            // One frame so views have a size before recorded input arrives
+            draw_frame(window, views);
+            TraceReplayer replayer(window, views, snapshot, minimap, trace);
+            status = replayer.run(budget_ms) > 0 ? 3 : 0;
+        } else {
+            while (!glfwWindowShouldClose(window)) {
+                // Idle until input; the views only change in response to it
+                glfwWaitEventsTimeout(0.25);
+                draw_frame(window, views);
+            }
+        }
+    }
+
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplGlfw_Shutdown();
+    ImGui::DestroyContext();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return status;
+}
@@ -0,0 +1,298 @@
+/// @file snapshot_sources.cpp
+/// @brief Snapshot-backed data sources for the standalone viewer
+
+#include "snapshot_sources.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace synopsia {
+namespace viewer {
+
+using features::function_search::FUNC_BADADDR;
+
+// =============================================================================
+// SnapshotFunctionSource
+// =============================================================================
+
+SnapshotFunctionSource::SnapshotFunctionSource(const SnapshotFile& snapshot) {
+    address_ = snapshot.column<std::uint64_t>(SnapshotSection::FunctionAddress);
+    end_ = snapshot.column<std::uint64_t>(SnapshotSection::FunctionEnd);
+    size_ = snapshot.column<std::uint32_t>(SnapshotSection::FunctionSize);
+    depth_ = snapshot.column<std::uint32_t>(SnapshotSection::FunctionDepth);
+    callers_ = snapshot.column<std::uint32_t>(SnapshotSection::FunctionCallers);
+    callees_ = snapshot.column<std::uint32_t>(SnapshotSection::FunctionCallees);
+    callee_offsets_ = snapshot.column<std::uint32_t>(SnapshotSection::CalleeOffsets);
+    callee_targets_ = snapshot.column<std::uint32_t>(SnapshotSection::CalleeTargets);
+    caller_offsets_ = snapshot.column<std::uint32_t>(SnapshotSection::CallerOffsets);
+    caller_targets_ = snapshot.column<std::uint32_t>(SnapshotSection::CallerTargets);
+    names_ = snapshot.strings(SnapshotSection::NameOffsets, SnapshotSection::NameData);
+    demangled_ = snapshot.strings(SnapshotSection::DemangledOffsets, SnapshotSection::DemangledData);
+
+    const std::size_t count = address_.size();
+    valid_ = count > 0 && end_.size() == count && size_.size() == count && depth_.size() == count &&
+             callers_.size() == count && callees_.size() == count && names_.size() == count &&
+             callee_offsets_.size() == count + 1 && callee_offsets_.back() == callee_targets_.size();
+
+    // Demangled names and the caller CSR are optional
+    if (demangled_.size() != count) {
+        demangled_ = {};
+    }
+    if (caller_offsets_.size() != count + 1 || caller_offsets_.back() != caller_targets_.size()) {
+        caller_offsets_ = {};
+        caller_targets_ = {};
+    }
+    if (!valid_) {
+        address_ = {};
+    }
+}
+
+FunctionInfo SnapshotFunctionSource::get_function(std::size_t index) const {
+    if (index >= address_.size()) {
+        return {FUNC_BADADDR, "", ""};
+    }
+    return {
+        address_[index],
+        std::string(name(index)),
+        demangled_.size() ? std::string(demangled_[index]) : std::string()
+    };
+}
+
+std::shared_ptr<const CallGraph> SnapshotFunctionSource::call_graph() const {
+    if (call_graph_ || !valid_) {
+        return call_graph_;
+    }
+
+    // Served from the mapping; snapshots without the caller CSR get it rebuilt once.
+    // The snapshot outlives every view, so nothing else needs to keep it alive.
+    auto graph = std::make_shared<CallGraph>();
+    graph->borrow(callee_offsets_, callee_targets_, caller_offsets_, caller_targets_, nullptr);
+    call_graph_ = std::move(graph);
+    return call_graph_;
+}
+
+bool SnapshotFunctionSource::renamed_since(std::uint64_t since, std::vector<std::size_t>& out) const {
+    for (const auto& [revision, index] : renames_) {
+        if (revision > since) {
+            out.push_back(index);
+        }
+    }
+    return true;
+}
+
+void SnapshotFunctionSource::rename(std::size_t index, std::string name) {
+    if (index >= address_.size()) return;
+    renamed_[index] = std::move(name);
+    renames_.emplace_back(++revision_, index);
+}
+
+std::span<const std::uint32_t> SnapshotFunctionSource::callees(std::size_t index) const {
+    if (index >= address_.size()) return {};
+    const std::uint32_t begin = callee_offsets_[index];
+    const std::uint32_t end = std::min<std::uint32_t>(callee_offsets_[index + 1],
+                                                      static_cast<std::uint32_t>(callee_targets_.size()));
+    if (begin >= end) return {};
+    return callee_targets_.subspan(begin, end - begin);
+}
+
+std::string SnapshotFunctionSource::get_disassembly(func_addr_t address) const {
+    const std::size_t i = index_of(address);
+    if (i == npos) return {};
+
+    char buf[512];
+    std::string text;
+    std::snprintf(buf, sizeof(buf),
+                  "%016llX ; %.*s\n"
+                  "%016llX ; end      %016llX\n"
+                  "%016llX ; size     %u bytes\n"
+                  "%016llX ; depth    %u\n"
+                  "%016llX ; callers  %u\n"
+                  "%016llX ; callees  %u\n",
+                  static_cast<unsigned long long>(address_[i]),
+                  static_cast<int>(name(i).size()), name(i).data(),
+                  static_cast<unsigned long long>(address_[i]), static_cast<unsigned long long>(end_[i]),
+                  static_cast<unsigned long long>(address_[i]), size_[i],
+                  static_cast<unsigned long long>(address_[i]), depth_[i],
+                  static_cast<unsigned long long>(address_[i]), callers_[i],
+                  static_cast<unsigned long long>(address_[i]), callees_[i]);
+    text += buf;
+    return text;
+}
+
+std::string SnapshotFunctionSource::get_decompilation(func_addr_t address) const {
+    const std::size_t i = index_of(address);
+    if (i == npos) return {};
+
+    std::string text;
+    text += "// ";
+    text += name(i);
+    text += "\n\n// calls\n";
+    for (std::uint32_t target : callees(i)) {
+        if (target >= address_.size()) continue;
+        text += name(target);
+        text += "();\n";
+    }
+
+    // Callers by scanning the callee CSR; one pass per selected function
+    text += "\n// called by\n";
+    for (std::size_t caller = 0; caller < address_.size(); ++caller) {
+        for (std::uint32_t target : callees(caller)) {
+            if (target == i) {
+                text += name(caller);
+                text += "();\n";
+                break;
+            }
+        }
+    }
+    return text;
+}
+
+func_addr_t SnapshotFunctionSource::find_function_by_name(std::string_view name) const {
+    // Replayed renames are few; check them before the stored names
+    for (const auto& [index, renamed] : renamed_) {
+        if (renamed == name) return address_[index];
+    }
+
+    if (!valid_) return FUNC_BADADDR;
+    if (name_index_.empty()) {
+        name_index_.reserve(address_.size() * (demangled_.size() ? 2 : 1));
+        for (std::size_t i = 0; i < address_.size(); ++i) {
+            name_index_.emplace(names_[i], i);
+            if (demangled_.size()) name_index_.emplace(demangled_[i], i);
+        }
+    }
+
+    auto it = name_index_.find(name);
+    if (it == name_index_.end()) return FUNC_BADADDR;
+
+    // A renamed function only still answers to its demangled name
+    const std::size_t i = it->second;
+    if (renamed_.contains(i) && !(demangled_.size() && demangled_[i] == name)) return FUNC_BADADDR;
+    return address_[i];
+}
+
+func_addr_t SnapshotFunctionSource::find_function_at(func_addr_t address) const {
+    auto it = std::upper_bound(address_.begin(), address_.end(), address);
+    if (it == address_.begin()) return FUNC_BADADDR;
+    const std::size_t i = static_cast<std::size_t>(it - address_.begin()) - 1;
+    return address < end_[i] ? address_[i] : FUNC_BADADDR;
+}
+
+std::size_t SnapshotFunctionSource::index_of(func_addr_t address) const {
+    auto it = std::lower_bound(address_.begin(), address_.end(), address);
+    if (it == address_.end() || *it != address) return npos;
+    return static_cast<std::size_t>(it - address_.begin());
+}
+
+// =============================================================================
+// SnapshotMinimapSource
+// =============================================================================
+
+SnapshotMinimapSource::SnapshotMinimapSource(const SnapshotFile& snapshot)
+    : snapshot_(snapshot) {
+    set_level(0);
+}
+
+bool SnapshotMinimapSource::set_level(std::size_t level) {
+    auto starts = snapshot_.column<std::uint64_t>(snapshot_entropy_section(SnapshotSection::EntropyStart0, level));
+    auto ends = snapshot_.column<std::uint64_t>(snapshot_entropy_section(SnapshotSection::EntropyEnd0, level));
+    auto values = snapshot_.column<double>(snapshot_entropy_section(SnapshotSection::EntropyValue0, level));
+    if (starts.empty() || ends.size() != starts.size() || values.size() != starts.size()) {
+        return false;
+    }
+
+    const bool first = starts_.empty();
+    const data_addr_t view_start = viewport_.start_addr;
+    const data_addr_t view_end = viewport_.end_addr;
+    level_ = level;
+    starts_ = starts;
+    ends_ = ends;
+    values_ = values;
+
+    // Contiguous runs of blocks are the mapped ranges
+    std::vector<RegionData> runs;
+    for (std::size_t i = 0; i < starts_.size(); ++i) {
+        if (!runs.empty() && starts_[i] == runs.back().end_addr) {
+            runs.back().end_addr = ends_[i];
+        } else {
+            runs.push_back({starts_[i], ends_[i]});
+        }
+    }
+    axis_.build(std::move(runs), ends_[0] - starts_[0]);
+
+    if (first) {
+        reset_viewport();
+    } else {
+        // Block sizes differ per level, so markers do too: keep the addresses
+        set_window(axis_.to_offset(view_start), std::max(axis_.to_offset(view_end), axis_.to_offset(view_start) + 1));
+    }
+    return true;
+}
+
+std::size_t SnapshotMinimapSource::level_count() const {
+    std::size_t count = 0;
+    while (snapshot_.has(snapshot_entropy_section(SnapshotSection::EntropyStart0, count))) {
+        ++count;
+    }
+    return count;
+}
+
+void SnapshotMinimapSource::reset_viewport() {
+    set_window(0, axis_.length());
+}
+
+void SnapshotMinimapSource::set_window(data_size_t start_offset, data_size_t end_offset) {
+    viewport_.start_offset = std::min(start_offset, axis_.length());
+    viewport_.end_offset = std::clamp(end_offset, viewport_.start_offset, axis_.length());
+    viewport_.start_addr = axis_.to_address(viewport_.start_offset);
+    viewport_.end_addr = axis_.to_address(viewport_.end_offset);
+    viewport_.zoom = viewport_.range() ? static_cast<double>(axis_.length()) / viewport_.range() : 1.0;
+}
+
+data_addr_t SnapshotMinimapSource::y_to_address(int y, int height) const {
+    if (height <= 0) return DATA_BADADDR;
+    const double t = std::clamp(static_cast<double>(y) / height, 0.0, 1.0);
+    return axis_.to_address(viewport_.start_offset + static_cast<data_size_t>(t * static_cast<double>(viewport_.range())));
+}
+
+data_addr_t SnapshotMinimapSource::x_to_address(int x, int width) const {
+    return y_to_address(x, width);
+}
+
+int SnapshotMinimapSource::address_to_y(data_addr_t addr, int height) const {
+    if (addr < viewport_.start_addr || addr >= viewport_.end_addr || viewport_.range() == 0) return -1;
+    const data_size_t offset = std::max(axis_.to_offset(addr), viewport_.start_offset);
+    return static_cast<int>(static_cast<double>(offset - viewport_.start_offset) /
+                            static_cast<double>(viewport_.range()) * height);
+}
+
+int SnapshotMinimapSource::address_to_x(data_addr_t addr, int width) const {
+    return address_to_y(addr, width);
+}
+
+double SnapshotMinimapSource::entropy_at(data_addr_t addr) const {
+    auto it = std::upper_bound(starts_.begin(), starts_.end(), addr);
+    if (it == starts_.begin()) return -1.0;
+    const std::size_t i = static_cast<std::size_t>(it - starts_.begin()) - 1;
+    return addr < ends_[i] ? values_[i] : -1.0;
+}
+
+void SnapshotMinimapSource::zoom(double factor, data_addr_t center) {
+    const double total = static_cast<double>(axis_.length());
+    const double range = std::clamp(static_cast<double>(viewport_.range()) / factor, std::min(256.0, total), total);
+    const double center_offset = static_cast<double>(axis_.to_offset(center));
+    const double t = viewport_.range() ? (center_offset - viewport_.start_offset) / viewport_.range() : 0.5;
+
+    const double start = std::clamp(center_offset - t * range, 0.0, total - range);
+    set_window(static_cast<data_size_t>(start), static_cast<data_size_t>(start) + static_cast<data_size_t>(range));
+}
+
+void SnapshotMinimapSource::pan(data_sval_t delta) {
+    const data_size_t range = viewport_.range();
+    data_sval_t start = static_cast<data_sval_t>(viewport_.start_offset) + delta;
+    start = std::clamp<data_sval_t>(start, 0, static_cast<data_sval_t>(axis_.length() - range));
+    set_window(static_cast<data_size_t>(start), static_cast<data_size_t>(start) + range);
+}
+
+} // namespace viewer
+} // namespace synopsia
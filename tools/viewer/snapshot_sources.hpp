@@ -0,0 +1,141 @@
+/// @file snapshot_sources.hpp
+/// @brief View data sources backed by a mapped snapshot file (no IDA dependencies)
+///
+/// Every accessor reads straight from the snapshot's column spans, and the
+/// call graph borrows the stored CSR arrays, so memory use stays at the
+/// pages the views actually touch. The exceptions: the name index built on
+/// the first lookup, and the caller CSR of older snapshots that lack it.
+
+#pragma once
+
+#include <synopsia/common/snapshot_file.hpp>
+#include <synopsia/features/function_search/data_interface.hpp>
+#include <synopsia/minimap_data_interface.hpp>
+#include <synopsia/address_axis.hpp>
+
+#include <unordered_map>
+
+namespace synopsia {
+namespace viewer {
+
+using features::function_search::func_addr_t;
+using features::function_search::FunctionInfo;
+
+/// @class SnapshotFunctionSource
+/// @brief Function catalog for FunctionSearchView
+///
+/// The "Disassembly" tab shows the stored metrics; the "Decompilation" tab
+/// lists callees and callers as calls, so the view's clickable-call
+/// navigation walks the call graph.
+class SnapshotFunctionSource : public features::function_search::IFunctionDataSource {
+public:
+    explicit SnapshotFunctionSource(const SnapshotFile& snapshot);
+
+    [[nodiscard]] bool is_valid() const override { return valid_; }
+    [[nodiscard]] std::size_t function_count() const override { return address_.size(); }
+    [[nodiscard]] FunctionInfo get_function(std::size_t index) const override;
+    [[nodiscard]] std::string_view function_name(std::size_t index) const override { return name(index); }
+    [[nodiscard]] std::string get_disassembly(func_addr_t address) const override;
+    [[nodiscard]] std::string get_decompilation(func_addr_t address) const override;
+    [[nodiscard]] bool has_decompiler() const override { return valid_; }
+    [[nodiscard]] func_addr_t find_function_by_name(std::string_view name) const override;
+    [[nodiscard]] func_addr_t find_function_at(func_addr_t address) const override;
+    bool refresh() override { return valid_; }
+    [[nodiscard]] std::uint64_t function_size(std::size_t index) const override { return size_[index]; }
+    [[nodiscard]] std::shared_ptr<const CallGraph> call_graph() const override;
+    [[nodiscard]] std::uint64_t revision() const override { return revision_; }
+    [[nodiscard]] bool renamed_since(std::uint64_t since, std::vector<std::size_t>& out) const override;
+
+    /// Override a function's name in memory (replayed renames); views pick it up incrementally
+    void rename(std::size_t index, std::string name);
+
+    /// Index of the function starting at address (npos if none)
+    [[nodiscard]] std::size_t index_of(func_addr_t address) const;
+
+    [[nodiscard]] std::string_view name(std::size_t index) const {
+        if (!renamed_.empty()) {
+            auto it = renamed_.find(index);
+            if (it != renamed_.end()) return it->second;
+        }
+        return names_[index];
+    }
+    [[nodiscard]] std::span<const std::uint32_t> callees(std::size_t index) const;
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+    std::span<const std::uint64_t> address_;
+    std::span<const std::uint64_t> end_;
+    std::span<const std::uint32_t> size_;
+    std::span<const std::uint32_t> depth_;
+    std::span<const std::uint32_t> callers_;
+    std::span<const std::uint32_t> callees_;
+    std::span<const std::uint32_t> callee_offsets_;
+    std::span<const std::uint32_t> callee_targets_;
+    std::span<const std::uint32_t> caller_offsets_;  // Empty in older snapshots
+    std::span<const std::uint32_t> caller_targets_;
+    SnapshotStrings names_;
+    SnapshotStrings demangled_;
+    bool valid_ = false;
+
+    std::unordered_map<std::size_t, std::string> renamed_;
+    std::vector<std::pair<std::uint64_t, std::size_t>> renames_;  // (revision, index)
+    std::uint64_t revision_ = 1;
+
+    mutable std::shared_ptr<const CallGraph> call_graph_;  // Borrows the CSR on first use
+
+    // Stored and demangled names -> first function with that name, built on first lookup
+    mutable std::unordered_map<std::string_view, std::size_t> name_index_;
+};
+
+/// @class SnapshotMinimapSource
+/// @brief One entropy pyramid level for rasterize_entropy
+class SnapshotMinimapSource : public IMinimapDataSource {
+public:
+    explicit SnapshotMinimapSource(const SnapshotFile& snapshot);
+
+    /// Select a pyramid level; returns false if it is missing
+    bool set_level(std::size_t level);
+    [[nodiscard]] std::size_t level() const noexcept { return level_; }
+    [[nodiscard]] std::size_t level_count() const;
+
+    [[nodiscard]] bool is_valid() const override { return !starts_.empty(); }
+    [[nodiscard]] std::size_t block_count() const override { return starts_.size(); }
+    [[nodiscard]] EntropyBlockData get_block(std::size_t index) const override {
+        return {starts_[index], ends_[index], values_[index]};
+    }
+
+    [[nodiscard]] std::size_t region_count() const override { return 0; }
+    [[nodiscard]] RegionData get_region(std::size_t) const override { return {}; }
+    [[nodiscard]] std::string get_region_name_at(std::size_t) const override { return {}; }
+    [[nodiscard]] std::string get_region_name(data_addr_t) const override { return {}; }
+
+    [[nodiscard]] ViewportData get_viewport() const override { return viewport_; }
+    [[nodiscard]] const AddressAxis& axis() const override { return axis_; }
+
+    [[nodiscard]] data_addr_t y_to_address(int y, int height) const override;
+    [[nodiscard]] data_addr_t x_to_address(int x, int width) const override;
+    [[nodiscard]] int address_to_y(data_addr_t addr, int height) const override;
+    [[nodiscard]] int address_to_x(data_addr_t addr, int width) const override;
+
+    [[nodiscard]] double entropy_at(data_addr_t addr) const override;
+
+    void zoom(double factor, data_addr_t center) override;
+    void pan(data_sval_t delta) override;
+    void reset_viewport();
+
+private:
+    const SnapshotFile& snapshot_;
+    std::size_t level_ = 0;
+    std::span<const std::uint64_t> starts_;
+    std::span<const std::uint64_t> ends_;
+    std::span<const double> values_;
+    AddressAxis axis_;  // Runs of contiguous blocks, gaps collapsed
+    ViewportData viewport_{0, 0, 1.0};
+
+    /// Show [start_offset, end_offset) of the axis and update edges and zoom
+    void set_window(data_size_t start_offset, data_size_t end_offset);
+};
+
+} // namespace viewer
+} // namespace synopsia